@@ -22,6 +22,7 @@
 #include "oslib_test_root.h"
 #include "chprintf.h"
 #include "lwipthread.h"
+#include "web/web.h"
 
 /*
  * LED blinker thread, times are in milliseconds.
@@ -82,6 +83,13 @@ int main(void) {
 
   tsSkelsDaemonInit();
 
+  /*
+   * Creates the HTTPS server thread, assets are indexed at startup and
+   * then served directly from the memory-mapped QSPI window.
+   */
+  chThdCreateStatic(wa_https_server, sizeof wa_https_server, NORMALPRIO + 1,
+                    https_server, NULL);
+
   /*
    * Call the dummy secure service
    */
@@ -0,0 +1,220 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    contentstore.c
+ * @brief   Static content store code.
+ * @details The content image layout is a small header followed by a
+ *          record table, all offsets are relative to the image base:
+ *
+ *          offset 0  uint32_t  magic, "CST1"
+ *          offset 4  uint32_t  number of records
+ *          offset 8  records[] {path_off, mime_off, data_off, size}
+ *
+ *          Path and MIME strings are zero-terminated and live inside the
+ *          image together with the asset bodies, so the boot-time scan
+ *          only validates offsets and captures pointers, nothing is
+ *          copied out of the mapped window. When no valid image is found
+ *          a small built-in page is indexed instead so the server stays
+ *          functional on boards with a blank flash.
+ *
+ * @addtogroup CONTENT_STORE
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "contentstore.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   On-flash image header.
+ */
+typedef struct {
+  uint32_t              magic;
+  uint32_t              count;
+} cs_header_t;
+
+/**
+ * @brief   On-flash asset record.
+ */
+typedef struct {
+  uint32_t              path_off;
+  uint32_t              mime_off;
+  uint32_t              data_off;
+  uint32_t              size;
+} cs_record_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Boot-time index, pointers into the mapped window.
+ */
+static cs_entry_t cs_index[CS_MAX_ENTRIES];
+
+/**
+ * @brief   Number of valid entries in the index.
+ */
+static size_t cs_count;
+
+/**
+ * @brief   Built-in fallback page served when no image is found.
+ */
+static const char cs_fallback_body[] =
+  "<html><head><title>ChibiOS HTTPS server</title></head>"
+  "<body><h1>ChibiOS static content engine</h1>"
+  "<p>No content image found in the mapped flash window, this is the "
+  "built-in fallback page. Powered by lwIP + wolfSSL.</p></body></html>";
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Validates a zero-terminated string inside the window.
+ *
+ * @param[in] base      window base
+ * @param[in] off       offset of the string
+ * @param[in] size      window size
+ * @return              The string pointer or @p NULL.
+ */
+static const char *cs_get_string(const uint8_t *base, uint32_t off,
+                                 size_t size) {
+  size_t i;
+
+  if (off >= size) {
+    return NULL;
+  }
+  for (i = off; i < size; i++) {
+    if (base[i] == 0U) {
+      return (const char *)&base[off];
+    }
+  }
+  return NULL;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Builds the content index from a mapped image.
+ * @details The image is scanned once, records with out-of-window offsets
+ *          terminate the scan. If the magic number does not match then
+ *          the built-in fallback page is indexed instead.
+ *
+ * @param[in] basep     base address of the mapped window
+ * @param[in] size      size in bytes of the mapped window
+ * @return              The number of indexed assets.
+ */
+size_t csInit(const void *basep, size_t size) {
+  const uint8_t *base = (const uint8_t *)basep;
+  const cs_header_t *hdr = (const cs_header_t *)basep;
+  const cs_record_t *recs;
+  size_t n, i;
+
+  cs_count = 0U;
+
+  if ((hdr != NULL) && (size > sizeof (cs_header_t)) &&
+      (hdr->magic == CS_IMAGE_MAGIC)) {
+    n = (size_t)hdr->count;
+    if (n > (size_t)CS_MAX_ENTRIES) {
+      n = (size_t)CS_MAX_ENTRIES;
+    }
+    recs = (const cs_record_t *)(const void *)(base + sizeof (cs_header_t));
+    for (i = 0U; i < n; i++) {
+      const char *path = cs_get_string(base, recs[i].path_off, size);
+      const char *mime = cs_get_string(base, recs[i].mime_off, size);
+
+      if ((path == NULL) || (mime == NULL) ||
+          (recs[i].data_off >= size) ||
+          (recs[i].size > size - recs[i].data_off)) {
+        break;
+      }
+      cs_index[cs_count].path = path;
+      cs_index[cs_count].mime = mime;
+      cs_index[cs_count].data = base + recs[i].data_off;
+      cs_index[cs_count].size = recs[i].size;
+      cs_count++;
+    }
+  }
+
+  /* No usable image, falling back on the built-in page.*/
+  if (cs_count == 0U) {
+    cs_index[0].path = "/index.html";
+    cs_index[0].mime = "text/html";
+    cs_index[0].data = (const uint8_t *)cs_fallback_body;
+    cs_index[0].size = (uint32_t)sizeof cs_fallback_body - 1U;
+    cs_count = 1U;
+  }
+
+  return cs_count;
+}
+
+/**
+ * @brief   Retrieves an asset by request path.
+ * @note    The root path "/" is aliased to "/index.html".
+ *
+ * @param[in] path      absolute request path
+ * @return              The entry pointer.
+ * @retval NULL         if the path is not indexed.
+ */
+const cs_entry_t *csFind(const char *path) {
+  size_t i;
+
+  if (strcmp(path, "/") == 0) {
+    path = "/index.html";
+  }
+  for (i = 0U; i < cs_count; i++) {
+    if (strcmp(cs_index[i].path, path) == 0) {
+      return &cs_index[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief   Returns the number of indexed assets.
+ */
+size_t csGetCount(void) {
+
+  return cs_count;
+}
+
+/**
+ * @brief   Returns an indexed asset by position.
+ *
+ * @param[in] i         entry position
+ * @return              The entry pointer.
+ * @retval NULL         if the position is out of range.
+ */
+const cs_entry_t *csGetEntry(size_t i) {
+
+  if (i >= cs_count) {
+    return NULL;
+  }
+  return &cs_index[i];
+}
+
+/** @} */
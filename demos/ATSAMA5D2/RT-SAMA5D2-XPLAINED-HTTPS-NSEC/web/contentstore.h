@@ -0,0 +1,97 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    contentstore.h
+ * @brief   Static content store macros and structures.
+ * @details The content store indexes a read-only content image placed in
+ *          a memory-mapped window, typically the QSPI flash AHB space.
+ *          The index is built once at boot, afterwards every asset is
+ *          described by a pointer straight into the mapped window so the
+ *          serving path never stages content through RAM.
+ *
+ * @addtogroup CONTENT_STORE
+ * @{
+ */
+
+#ifndef CONTENTSTORE_H
+#define CONTENTSTORE_H
+
+/**
+ * @brief   Base address of the content image.
+ * @note    The default is the QSPI0 memory space of the SAMA5D2, the
+ *          image is expected at the beginning of the serial flash.
+ */
+#if !defined(CS_IMAGE_BASE)
+#define CS_IMAGE_BASE                   ((const void *)QSPIMEM0_ADDR)
+#endif
+
+/**
+ * @brief   Size in bytes of the mapped window holding the image.
+ */
+#if !defined(CS_IMAGE_SIZE)
+#define CS_IMAGE_SIZE                   (16 * 1024 * 1024)
+#endif
+
+/**
+ * @brief   Maximum number of indexed assets.
+ */
+#if !defined(CS_MAX_ENTRIES)
+#define CS_MAX_ENTRIES                  64
+#endif
+
+/**
+ * @brief   Magic number identifying a content image, "CST1".
+ */
+#define CS_IMAGE_MAGIC                  0x31545343U
+
+/**
+ * @brief   Type of an indexed asset.
+ * @note    All pointers reference the mapped window directly.
+ */
+typedef struct {
+  /**
+   * @brief   Absolute request path, for example "/index.html".
+   */
+  const char            *path;
+  /**
+   * @brief   MIME type string.
+   */
+  const char            *mime;
+  /**
+   * @brief   Pointer to the asset body in the mapped window.
+   */
+  const uint8_t         *data;
+  /**
+   * @brief   Size in bytes of the asset body.
+   */
+  uint32_t              size;
+} cs_entry_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  size_t csInit(const void *basep, size_t size);
+  const cs_entry_t *csFind(const char *path);
+  size_t csGetCount(void);
+  const cs_entry_t *csGetEntry(size_t i);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTENTSTORE_H */
+
+/** @} */
@@ -0,0 +1,277 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * This file is a modified version of the lwIP web server demo. The original
+ * author is unknown because the file didn't contain any license information.
+ *
+ * The HTTPS version is Copyright (C) 2017 - WolfSSL Inc. and is based on the
+ * demo HTTP code of ChibiOS.
+ */
+
+/**
+ * @file web.c
+ * @brief HTTPS static content server thread code.
+ * @details The server resolves each GET request against the boot-time
+ *          content index and streams the asset body straight from the
+ *          memory-mapped flash window through the TLS layer, the record
+ *          encryption runs on the CRY engine when the hardware crypto
+ *          binding is enabled. No asset byte is ever staged through a
+ *          RAM file buffer.
+ *
+ * @addtogroup WEB_THREAD
+ * @{
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "lwip/opt.h"
+#include "lwip/arch.h"
+#include "lwip/api.h"
+
+#include "wolfssl_chibios.h"
+#include "chprintf.h"
+#include "contentstore.h"
+#include "web.h"
+
+#if LWIP_NETCONN
+
+static char url_buffer[WEB_MAX_PATH_SIZE];
+extern unsigned char server_cert[];
+extern unsigned int server_cert_len;
+extern unsigned char server_key[];
+extern unsigned int server_key_len;
+
+#define HEXTOI(x) (isdigit(x) ? (x) - '0' : (x) - 'a' + 10)
+
+/**
+ * @brief   Decodes an URL sting.
+ * @note    The string is terminated by a zero or a separator.
+ *
+ * @param[in] url       encoded URL string
+ * @param[out] buf      buffer for the processed string
+ * @param[in] max       max number of chars to copy into the buffer
+ * @return              The conversion status.
+ * @retval false        string converted.
+ * @retval true         the string was not valid or the buffer overflowed
+ *
+ * @notapi
+ */
+static bool decode_url(const char *url, char *buf, size_t max) {
+
+  while (true) {
+    int h, l;
+    unsigned c = *url++;
+
+    switch (c) {
+    case 0:
+    case '\r':
+    case '\n':
+    case '\t':
+    case ' ':
+    case '?':
+      *buf = 0;
+      return false;
+    case '.':
+      if (max <= 1)
+        return true;
+
+      h = *(url + 1);
+      if (h == '.')
+        return true;
+
+      break;
+    case '%':
+      if (max <= 1)
+        return true;
+
+      h = tolower((int)*url++);
+      if (h == 0)
+        return true;
+      if (!isxdigit(h))
+        return true;
+
+      l = tolower((int)*url++);
+      if (l == 0)
+        return true;
+      if (!isxdigit(l))
+        return true;
+
+      c = (char)((HEXTOI(h) << 4) | HEXTOI(l));
+      break;
+    default:
+      if (max <= 1)
+        return true;
+
+      if (!isalnum(c) && (c != '_') && (c != '-') && (c != '+') &&
+          (c != '/'))
+        return true;
+
+      break;
+    }
+
+    *buf++ = c;
+    max--;
+  }
+}
+
+#define MAX_HTTPREQ_SIZE 256
+static char inbuf[MAX_HTTPREQ_SIZE];
+static char hdrbuf[128];
+
+static const char http_404[] =
+  "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+/**
+ * @brief   Streams an indexed asset on a TLS connection.
+ * @details The response header is the only dynamically built data, the
+ *          body chunks are handed to @p wolfSSL_write() directly from
+ *          the mapped window.
+ *
+ * @param[in] sc        SSL connection
+ * @param[in] ep        content index entry
+ *
+ * @notapi
+ */
+static void https_send_entry(sslconn *sc, const cs_entry_t *ep) {
+  const uint8_t *p = ep->data;
+  uint32_t remaining = ep->size;
+  int n;
+
+  n = chsnprintf(hdrbuf, sizeof hdrbuf,
+                 "HTTP/1.1 200 OK\r\nContent-type: %s\r\n"
+                 "Content-Length: %u\r\nConnection: close\r\n\r\n",
+                 ep->mime, (unsigned)ep->size);
+  if (wolfSSL_write(sc->ssl, hdrbuf, n) != n) {
+    return;
+  }
+
+  while (remaining > 0U) {
+    uint32_t chunk = remaining;
+
+    if (chunk > (uint32_t)WEB_CHUNK_SIZE) {
+      chunk = (uint32_t)WEB_CHUNK_SIZE;
+    }
+    if (wolfSSL_write(sc->ssl, (const char *)p, (int)chunk) != (int)chunk) {
+      return;
+    }
+    p         += chunk;
+    remaining -= chunk;
+  }
+}
+
+/**
+ * @brief   Serves a single HTTPS request.
+ *
+ * @param[in] sc        SSL connection
+ *
+ * @notapi
+ */
+static void https_server_serve(sslconn *sc) {
+  const cs_entry_t *ep;
+  int ret;
+
+  /* Read the data from the port, blocking if nothing yet there.
+     We assume the request (the part we care about) is in one netbuf.*/
+  ret = wolfSSL_read(sc->ssl, inbuf, MAX_HTTPREQ_SIZE);
+  if (ret >= 5 &&
+          inbuf[0] == 'G' &&
+          inbuf[1] == 'E' &&
+          inbuf[2] == 'T' &&
+          inbuf[3] == ' ' &&
+          inbuf[4] == '/') {
+
+    if (decode_url(inbuf + 4, url_buffer, WEB_MAX_PATH_SIZE)) {
+      /* Invalid URL handling.*/
+      return;
+    }
+
+    /* Resolving the path against the boot-time index, the entry body is
+       served from the mapped window without intermediate copies.*/
+    ep = csFind(url_buffer);
+    if (ep != NULL) {
+      https_send_entry(sc, ep);
+    }
+    else {
+      wolfSSL_write(sc->ssl, http_404, (int)sizeof http_404 - 1);
+    }
+  }
+}
+
+/**
+ * @brief   Stack area for the http thread.
+ */
+THD_WORKING_AREA(wa_https_server, WEB_THREAD_STACK_SIZE);
+
+/**
+ * @brief   HTTPS server thread.
+ */
+THD_FUNCTION(https_server, p) {
+  sslconn *sc, *newsc;
+  (void)p;
+  chRegSetThreadName("https");
+
+  /* Builds the content index over the memory-mapped flash window.*/
+  csInit(CS_IMAGE_BASE, CS_IMAGE_SIZE);
+
+  /* Initialize wolfSSL */
+  wolfSSL_Init();
+
+  /* Create a new SSL connection handle */
+  sc = sslconn_new(NETCONN_TCP, wolfTLSv1_2_server_method());
+  if (!sc) {
+      while(1) {}
+  }
+
+  /* Load certificate file for the HTTPS server */
+  if (wolfSSL_CTX_use_certificate_buffer(sc->ctx, server_cert,
+              server_cert_len, SSL_FILETYPE_ASN1 ) != SSL_SUCCESS)
+      while(1) {}
+
+  /* Load the private key */
+  if (wolfSSL_CTX_use_PrivateKey_buffer(sc->ctx, server_key,
+              server_key_len, SSL_FILETYPE_ASN1 ) != SSL_SUCCESS)
+      while(1) {}
+
+  /* Bind to port 443 (HTTPS) with default IP address */
+  netconn_bind(sc->conn, NULL, WEB_THREAD_PORT);
+
+  /* Put the connection into LISTEN state */
+  netconn_listen(sc->conn);
+
+  /* Goes to the final priority after initialization.*/
+  chThdSetPriority(WEB_THREAD_PRIORITY);
+
+  /* Listening loop */
+  while (true) {
+    newsc = sslconn_accept(sc);
+    if (!newsc) {
+        chThdSleepMilliseconds(500);
+        continue;
+    }
+    /* New connection: a new SSL connector is spawned */
+    https_server_serve(newsc);
+    sslconn_close(newsc);
+  }
+}
+
+#endif /* LWIP_NETCONN */
+
+/** @} */
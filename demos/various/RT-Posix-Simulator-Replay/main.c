@@ -0,0 +1,273 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Scheduler workload replayer.
+ *
+ * The application consumes a scheduling trace captured on a target with
+ * CH_DBG_TRACE_MASK enabled and re-executes the same schedule shape
+ * with synthetic threads, then reports the divergence between the
+ * recorded and the replayed timings. It allows to reproduce scheduling
+ * pathologies observed in the field on a desktop without the original
+ * firmware or hardware.
+ *
+ * The trace file is a text file derived offline from the context switch
+ * records, one event per line:
+ *
+ *   <tick> <tid> <run>
+ *
+ * - tick  activation time of the event in system ticks, relative to
+ *         the first event.
+ * - tid   synthetic thread index in the range 0..REPLAY_MAX_THREADS-1,
+ *         assigned by the extractor to each distinct switched-in
+ *         thread (CH_TRACE_TYPE_SWITCH field u.sw.ntp).
+ * - run   CPU time consumed before the next switch, in system ticks.
+ *
+ * Empty lines and lines starting with '#' are ignored. The file name is
+ * taken from the REPLAY_TRACE environment variable, "trace.txt" by
+ * default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ch.h"
+#include "hal.h"
+
+/*===========================================================================*/
+/* Replayer limits and types.                                                */
+/*===========================================================================*/
+
+#define REPLAY_MAX_EVENTS               4096
+#define REPLAY_MAX_THREADS              16
+#define REPLAY_WORKERS_PRIORITY         (tprio_t)(NORMALPRIO - 1)
+#define REPLAY_MB_SIZE                  16
+
+/*
+ * One trace event, times in system ticks.
+ */
+typedef struct {
+  systime_t             tick;       /* Recorded activation time.        */
+  unsigned              tid;        /* Synthetic thread index.          */
+  sysinterval_t         run;        /* Recorded CPU occupancy.          */
+  systime_t             actual;     /* Replayed activation time.        */
+  bool                  served;     /* Event has been replayed.         */
+} replay_event_t;
+
+/*===========================================================================*/
+/* Replayer data.                                                            */
+/*===========================================================================*/
+
+static replay_event_t events[REPLAY_MAX_EVENTS];
+static unsigned events_n;
+static unsigned threads_n;
+
+/* Replay time base, all actual times are relative to it.*/
+static systime_t replay_base;
+
+/* Per-thread event queues, the replayer posts event indexes.*/
+static mailbox_t worker_mb[REPLAY_MAX_THREADS];
+static msg_t worker_mb_buf[REPLAY_MAX_THREADS][REPLAY_MB_SIZE];
+
+/* Synthetic worker threads.*/
+static THD_WORKING_AREA(worker_wa[REPLAY_MAX_THREADS], 512);
+static thread_t *workers[REPLAY_MAX_THREADS];
+
+/*===========================================================================*/
+/* Replayer implementation.                                                  */
+/*===========================================================================*/
+
+/*
+ * Burns CPU time for the specified number of ticks.
+ */
+static void burn_ticks(sysinterval_t ticks) {
+  systime_t t0 = chVTGetSystemTimeX();
+
+  while ((sysinterval_t)(chVTGetSystemTimeX() - t0) < ticks) {
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  }
+}
+
+/*
+ * Synthetic worker thread, it consumes the CPU occupancy recorded for
+ * the events assigned to its thread index.
+ */
+static THD_FUNCTION(worker_thread, arg) {
+  unsigned me = (unsigned)(uintptr_t)arg;
+  msg_t idx;
+
+  chRegSetThreadName("replay_worker");
+
+  while (true) {
+    if (chMBFetchTimeout(&worker_mb[me], &idx, TIME_INFINITE) != MSG_OK)
+      continue;
+    if (idx < 0)
+      break;
+
+    events[idx].actual = (systime_t)(chVTGetSystemTimeX() - replay_base);
+    events[idx].served = true;
+    burn_ticks(events[idx].run);
+  }
+}
+
+/*
+ * Loads the trace file, returns the number of events or zero on error.
+ */
+static unsigned load_trace(const char *name) {
+  FILE *f;
+  char line[128];
+  unsigned n = 0;
+
+  f = fopen(name, "r");
+  if (f == NULL) {
+    printf("replay: cannot open \"%s\"\r\n", name);
+    return 0;
+  }
+
+  threads_n = 0;
+  while ((fgets(line, sizeof line, f) != NULL) && (n < REPLAY_MAX_EVENTS)) {
+    unsigned long tick, tid, run;
+
+    if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+      continue;
+    if (sscanf(line, "%lu %lu %lu", &tick, &tid, &run) != 3) {
+      printf("replay: malformed line %u\r\n", n + 1);
+      fclose(f);
+      return 0;
+    }
+    if (tid >= REPLAY_MAX_THREADS) {
+      printf("replay: thread index %lu out of range\r\n", tid);
+      fclose(f);
+      return 0;
+    }
+    events[n].tick   = (systime_t)tick;
+    events[n].tid    = (unsigned)tid;
+    events[n].run    = (sysinterval_t)run;
+    events[n].served = false;
+    if ((unsigned)tid >= threads_n)
+      threads_n = (unsigned)tid + 1;
+    n++;
+  }
+  fclose(f);
+
+  return n;
+}
+
+/*
+ * Replays the loaded events then prints the divergence report.
+ */
+static void replay_execute(void) {
+  unsigned i, late = 0, worst_idx = 0;
+  sysinterval_t worst = 0;
+  uint64_t total = 0;
+
+  /* Workers and their queues.*/
+  for (i = 0; i < threads_n; i++) {
+    chMBObjectInit(&worker_mb[i], worker_mb_buf[i], REPLAY_MB_SIZE);
+    workers[i] = chThdCreateStatic(worker_wa[i], sizeof worker_wa[i],
+                                   REPLAY_WORKERS_PRIORITY,
+                                   worker_thread, (void *)(uintptr_t)i);
+  }
+
+  /* Dispatching events at their recorded activation times, the replayer
+     runs above the workers so late dispatches can only be caused by
+     masked sections, not by the synthetic load itself.*/
+  replay_base = chVTGetSystemTime();
+  for (i = 0; i < events_n; i++) {
+    systime_t next = (systime_t)(replay_base + events[i].tick);
+    sysinterval_t delay = (sysinterval_t)(next - chVTGetSystemTime());
+
+    if ((delay > (sysinterval_t)0) &&
+        (delay < ((sysinterval_t)-1 >> 1)))
+      chThdSleep(delay);
+
+    if (chMBPostTimeout(&worker_mb[events[i].tid], (msg_t)i,
+                        TIME_IMMEDIATE) != MSG_OK)
+      printf("replay: queue overflow on thread %u, event %u\r\n",
+             events[i].tid, i);
+  }
+
+  /* Letting the tail of the workload drain.*/
+  chThdSleepMilliseconds(100);
+
+  /* Terminating workers.*/
+  for (i = 0; i < threads_n; i++) {
+    (void) chMBPostTimeout(&worker_mb[i], (msg_t)-1, TIME_INFINITE);
+    chThdWait(workers[i]);
+  }
+
+  /* Divergence statistics, the difference between the recorded and the
+     replayed activation time of each event.*/
+  for (i = 0; i < events_n; i++) {
+    sysinterval_t d;
+
+    if (!events[i].served) {
+      printf("replay: event %u never executed\r\n", i);
+      continue;
+    }
+    d = (sysinterval_t)(events[i].actual - events[i].tick);
+    if (d > (sysinterval_t)0) {
+      late++;
+      total += (uint64_t)d;
+      if (d > worst) {
+        worst = d;
+        worst_idx = i;
+      }
+    }
+  }
+
+  printf("\r\nReplay report\r\n");
+  printf("  events           : %u\r\n", events_n);
+  printf("  threads          : %u\r\n", threads_n);
+  printf("  late activations : %u\r\n", late);
+  if (late > 0) {
+    printf("  avg lateness     : %lu ticks\r\n",
+           (unsigned long)(total / (uint64_t)late));
+    printf("  worst lateness   : %lu ticks at event %u (tid %u, tick %lu)\r\n",
+           (unsigned long)worst, worst_idx, events[worst_idx].tid,
+           (unsigned long)events[worst_idx].tick);
+  }
+  printf("Replay complete\r\n");
+  fflush(stdout);
+}
+
+/*===========================================================================*/
+/* Application entry point.                                                  */
+/*===========================================================================*/
+
+int main(void) {
+  const char *name;
+
+  halInit();
+  chSysInit();
+
+  name = getenv("REPLAY_TRACE");
+  if (name == NULL)
+    name = "trace.txt";
+
+  events_n = load_trace(name);
+  printf("replay: %u events on %u threads from \"%s\"\r\n",
+         events_n, threads_n, name);
+  fflush(stdout);
+
+  if (events_n > 0) {
+    replay_execute();
+  }
+
+  return 0;
+}
@@ -55,6 +55,10 @@ static semaphore_t semaphores[CMSIS_CFG_NUM_SEMAPHORES];
 static memory_pool_t timpool;
 static struct os_timer_cb timers[CMSIS_CFG_NUM_TIMERS];
 
+static memory_pool_t thdpool;
+static THD_WORKING_AREA(threads_wa[CMSIS_CFG_NUM_THREADS],
+                        CMSIS_CFG_DEFAULT_STACK);
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
@@ -94,6 +98,11 @@ osStatus osKernelInitialize(void) {
   chPoolObjectInit(&timpool, sizeof(struct os_timer_cb), chCoreAllocAligned);
   chPoolLoadArray(&timpool, timers, CMSIS_CFG_NUM_TIMERS);
 
+  chPoolObjectInit(&thdpool,
+                   THD_WORKING_AREA_SIZE(CMSIS_CFG_DEFAULT_STACK),
+                   NULL);
+  chPoolLoadArray(&thdpool, threads_wa, CMSIS_CFG_NUM_THREADS);
+
   return osOK;
 }
 
@@ -114,13 +123,29 @@ osStatus osKernelStart(void) {
  */
 osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument) {
   size_t size;
+  thread_t *tp;
 
   size = thread_def->stacksize == 0 ? CMSIS_CFG_DEFAULT_STACK :
                                       thread_def->stacksize;
+
+  /* Threads with a default-sized stack are served from the static pool,
+     both creation and deletion are then constant-time with no heap
+     involvement, the working area returns to the pool on chThdWait().*/
+  if (size <= CMSIS_CFG_DEFAULT_STACK) {
+    tp = chThdCreateFromMemoryPool(&thdpool,
+                                   thread_def->name,
+                                   CMSIS2RT_PRIO(thread_def->tpriority),
+                                   (tfunc_t)thread_def->pthread,
+                                   argument);
+    if (tp != NULL)
+      return (osThreadId)tp;
+  }
+
+  /* Oversized stack or pool exhausted, falling back to the heap.*/
   return (osThreadId)chThdCreateFromHeap(0,
                                          THD_WORKING_AREA_SIZE(size),
                                          thread_def->name,
-                                         NORMALPRIO+thread_def->tpriority,
+                                         CMSIS2RT_PRIO(thread_def->tpriority),
                                          (tfunc_t)thread_def->pthread,
                                          argument);
 }
@@ -149,16 +174,22 @@ osStatus osThreadTerminate(osThreadId thread_id) {
  */
 osStatus osThreadSetPriority(osThreadId thread_id, osPriority newprio) {
   thread_t * tp = (thread_t *)thread_id;
+  tprio_t prio;
+
+  if ((newprio < osPriorityIdle) || (newprio > osPriorityRealtime))
+    return osErrorPriority;
+
+  prio = CMSIS2RT_PRIO(newprio);
 
   chSysLock();
 
   /* Changing priority.*/
 #if CH_CFG_USE_MUTEXES
-  if ((tp->prio == tp->realprio) || ((tprio_t)newprio > tp->prio))
-    tp->prio = (tprio_t)newprio;
-  tp->realprio = (tprio_t)newprio;
+  if ((tp->prio == tp->realprio) || (prio > tp->prio))
+    tp->prio = prio;
+  tp->realprio = prio;
 #else
-  tp->prio = (tprio_t)newprio;
+  tp->prio = prio;
 #endif
 
   /* The following states need priority queues reordering.*/
@@ -190,7 +221,7 @@ osStatus osThreadSetPriority(osThreadId thread_id, osPriority newprio) {
     tp->state = CH_STATE_CURRENT;
 #endif
     /* Re-enqueues tp with its new priority on the ready list.*/
-    chSchReadyI(queue_dequeue(tp));
+    chSchReadyI(sch_ready_dequeue(tp));
     break;
   }
 
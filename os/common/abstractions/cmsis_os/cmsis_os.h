@@ -83,12 +83,22 @@
 /*===========================================================================*/
 
 /**
- * @brief   Number of pre-allocated static semaphores/mutexes.
+ * @brief   Default thread working area size.
  */
 #if !defined(CMSIS_CFG_DEFAULT_STACK)
 #define CMSIS_CFG_DEFAULT_STACK     256
 #endif
 
+/**
+ * @brief   Number of pre-allocated static thread working areas.
+ * @details Threads with a stack requirement not exceeding
+ *          @p CMSIS_CFG_DEFAULT_STACK are served from this static pool,
+ *          larger ones fall back to the heap.
+ */
+#if !defined(CMSIS_CFG_NUM_THREADS)
+#define CMSIS_CFG_NUM_THREADS       4
+#endif
+
 /**
  * @brief   Number of pre-allocated static semaphores/mutexes.
  */
@@ -291,6 +301,24 @@ typedef struct os_messageQ_def {
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @name    Priority conversion macros
+ * @details The conversion is plain arithmetic so, when the argument is a
+ *          compile-time constant, the resulting priority is a constant
+ *          too and no translation cost is paid at runtime.
+ * @{
+ */
+/**
+ * @brief   Converts a CMSIS priority to a ChibiOS priority.
+ */
+#define CMSIS2RT_PRIO(prio) ((tprio_t)((int)NORMALPRIO + (int)(prio)))
+
+/**
+ * @brief   Converts a ChibiOS priority to a CMSIS priority.
+ */
+#define RT2CMSIS_PRIO(prio) ((osPriority)((int)(prio) - (int)NORMALPRIO))
+/** @} */
+
 /**
  * @brief   Convert a microseconds value to a RTOS kernel system timer value.
  */
@@ -504,7 +532,7 @@ static inline osStatus osThreadYield(void) {
  */
 static inline osPriority osThreadGetPriority(osThreadId thread_id) {
 
-  return (osPriority)(NORMALPRIO - thread_id->prio);
+  return RT2CMSIS_PRIO(thread_id->prio);
 }
 
 /**
@@ -79,6 +79,22 @@
 #define MIN_QUEUE_DEPTH     1
 #define MAX_QUEUE_DEPTH     16384
 
+/**
+ * @name    Direct-mapped object IDs
+ * @details Timer and queue IDs encode the table index in the upper half
+ *          and a per-entry generation counter in the lower half, lookup
+ *          is a single table access and validation is O(1). The counter
+ *          is odd while the entry is in use and is incremented on both
+ *          creation and deletion so stale IDs of deleted or recycled
+ *          entries are rejected.
+ * @{
+ */
+#define ID_INDEX_SHIFT      16U
+#define ID_GEN_MASK         0xFFFFU
+#define MAKE_ID(i, gen)     ((((uint32)(i) + 1U) << ID_INDEX_SHIFT) |       \
+                             ((uint32)(gen) & ID_GEN_MASK))
+/** @} */
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -96,7 +112,9 @@ typedef void (*funcptr_t)(void);
  * @brief   Type of OSAL timer.
  */
 typedef struct {
-  uint32                is_free;
+  void                  *free_link;     /* Pool free list slot, must be
+                                           first, not used for validation.*/
+  uint32                gen;
   char                  name[OS_MAX_API_NAME];
   OS_TimerCallback_t    callback_ptr;
   uint32                start_time;
@@ -108,7 +126,9 @@ typedef struct {
  * @brief   Type of an OSAL queue.
  */
 typedef struct {
-  uint32                is_free;
+  void                  *free_link;     /* Pool free list slot, must be
+                                           first, not used for validation.*/
+  uint32                gen;
   char                  name[OS_MAX_API_NAME];
   semaphore_t           free_msgs;
   memory_pool_t         messages;
@@ -179,8 +199,8 @@ static void systime_update(void *p) {
 static void timer_handler(void *p) {
   osal_timer_t *otp = (osal_timer_t *)p;
 
-  /* Real callback.*/
-  otp->callback_ptr((uint32)p);
+  /* Real callback, invoked with the encoded timer ID.*/
+  otp->callback_ptr(MAKE_ID(otp - &osal.timers[0], otp->gen));
 
   /* Timer restart if an interval is defined.*/
   if (otp->interval_time != 0) {
@@ -190,6 +210,42 @@ static void timer_handler(void *p) {
   }
 }
 
+/**
+ * @brief   Translates a queue ID into a table entry pointer.
+ * @details The index and generation encoded in the ID are checked against
+ *          the table entry, IDs of deleted or recycled entries are
+ *          rejected in constant time.
+ */
+static osal_queue_t *queue_decode(uint32 queue_id) {
+  uint32 i = (queue_id >> ID_INDEX_SHIFT) - 1U;
+
+  if ((i >= OS_MAX_QUEUES) ||
+      (osal.queues[i].gen != (queue_id & ID_GEN_MASK)) ||
+      ((osal.queues[i].gen & 1U) == 0U)) {
+    return NULL;
+  }
+
+  return &osal.queues[i];
+}
+
+/**
+ * @brief   Translates a timer ID into a table entry pointer.
+ * @details The index and generation encoded in the ID are checked against
+ *          the table entry, IDs of deleted or recycled entries are
+ *          rejected in constant time.
+ */
+static osal_timer_t *timer_decode(uint32 timer_id) {
+  uint32 i = (timer_id >> ID_INDEX_SHIFT) - 1U;
+
+  if ((i >= OS_MAX_TIMERS) ||
+      (osal.timers[i].gen != (timer_id & ID_GEN_MASK)) ||
+      ((osal.timers[i].gen & 1U) == 0U)) {
+    return NULL;
+  }
+
+  return &osal.timers[i];
+}
+
 /**
  * @brief   Finds a queue by name.
  */
@@ -201,11 +257,11 @@ uint32 queue_find(const char *queue_name) {
     /* Entering a reentrant critical zone.*/
     syssts_t sts = chSysGetStatusAndLockX();
 
-    if (!oqp->is_free &&
+    if (((oqp->gen & 1U) != 0U) &&
         (strncmp(oqp->name, queue_name, OS_MAX_API_NAME - 1) == 0)) {
       /* Leaving the critical zone.*/
       chSysRestoreStatusX(sts);
-      return (uint32)oqp;
+      return MAKE_ID(oqp - &osal.queues[0], oqp->gen);
     }
 
     /* Leaving the critical zone.*/
@@ -226,11 +282,11 @@ uint32 timer_find(const char *timer_name) {
     /* Entering a reentrant critical zone.*/
     syssts_t sts = chSysGetStatusAndLockX();
 
-    if (!otp->is_free &&
+    if (((otp->gen & 1U) != 0U) &&
         (strncmp(otp->name, timer_name, OS_MAX_API_NAME - 1) == 0)) {
       /* Leaving the critical zone.*/
       chSysRestoreStatusX(sts);
-      return (uint32)otp;
+      return MAKE_ID(otp - &osal.timers[0], otp->gen);
     }
 
     /* Leaving the critical zone.*/
@@ -485,9 +541,9 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name,
   otp->start_time    = 0;
   otp->interval_time = 0;
   otp->callback_ptr  = callback_ptr;
-  otp->is_free       = 0;   /* Note, last.*/
+  otp->gen = (otp->gen + 1U) & ID_GEN_MASK; /* Note, last, odd while in use.*/
 
-  *timer_id = (uint32)otp;
+  *timer_id = MAKE_ID(otp - &osal.timers[0], otp->gen);
   *clock_accuracy = (uint32)(1000000 / CH_CFG_ST_FREQUENCY);
 
   return OS_SUCCESS;
@@ -502,19 +558,17 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name,
  * @api
  */
 int32 OS_TimerDelete(uint32 timer_id) {
-  osal_timer_t *otp = (osal_timer_t *)timer_id;
+  osal_timer_t *otp = timer_decode(timer_id);
 
-  /* Range check.*/
-  if ((otp < &osal.timers[0]) ||
-      (otp >= &osal.timers[OS_MAX_TIMERS]) ||
-      (otp->is_free)) {
+  /* ID validity check.*/
+  if (otp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
   chSysLock();
 
-  /* Marking as no more free, will be overwritten by the pool pointer.*/
-  otp->is_free = 1;
+  /* Invalidating the generation, stale IDs are rejected from here on.*/
+  otp->gen = (otp->gen + 1U) & ID_GEN_MASK;
 
   /* Resetting the timer.*/
   chVTResetI(&otp->vt);
@@ -542,12 +596,10 @@ int32 OS_TimerDelete(uint32 timer_id) {
  */
 int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time) {
   syssts_t sts;
-  osal_timer_t *otp = (osal_timer_t *)timer_id;
+  osal_timer_t *otp = timer_decode(timer_id);
 
-  /* Range check.*/
-  if ((otp < &osal.timers[0]) ||
-      (otp >= &osal.timers[OS_MAX_TIMERS]) ||
-      (otp->is_free)) {
+  /* ID validity check.*/
+  if (otp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
@@ -560,7 +612,7 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time) {
   else {
     otp->start_time    = start_time;
     otp->interval_time = interval_time;
-    chVTSetI(&otp->vt, TIME_US2I(start_time), timer_handler, (void *)timer_id);
+    chVTSetI(&otp->vt, TIME_US2I(start_time), timer_handler, (void *)otp);
   }
 
   /* Leaving the critical zone.*/
@@ -611,25 +663,23 @@ int32 OS_TimerGetIdByName(uint32 *timer_id, const char *timer_name) {
  */
 int32 OS_TimerGetInfo(uint32 timer_id, OS_timer_prop_t *timer_prop) {
   syssts_t sts;
-  osal_timer_t *otp = (osal_timer_t *)timer_id;
+  osal_timer_t *otp = timer_decode(timer_id);
 
   /* NULL pointer checks.*/
   if (timer_prop == NULL) {
     return OS_INVALID_POINTER;
   }
 
-  /* Range check.*/
-  if ((otp < &osal.timers[0]) ||
-      (otp >= &osal.timers[OS_MAX_TIMERS]) ||
-      (otp->is_free)) {
+  /* ID validity check.*/
+  if (otp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
   /* Entering a reentrant critical zone.*/
   sts = chSysGetStatusAndLockX();
 
-  /* If the timer is not in use then error.*/
-  if (otp->is_free) {
+  /* If the timer has been deleted in the meanwhile then error.*/
+  if (otp->gen != (timer_id & ID_GEN_MASK)) {
     /* Leaving the critical zone.*/
     chSysRestoreStatusX(sts);
     return OS_ERR_INVALID_ID;
@@ -727,8 +777,8 @@ int32 OS_QueueCreate(uint32 *queue_id, const char *queue_name,
   chPoolLoadArray(&oqp->messages, oqp->mb_buffer, (size_t)queue_depth);
   oqp->depth   = queue_depth;
   oqp->size    = data_size;
-  oqp->is_free = 0;   /* Note, last.*/
-  *queue_id = (uint32)oqp;
+  oqp->gen = (oqp->gen + 1U) & ID_GEN_MASK; /* Note, last, odd while in use.*/
+  *queue_id = MAKE_ID(oqp - &osal.queues[0], oqp->gen);
 
   return OS_SUCCESS;
 }
@@ -742,21 +792,19 @@ int32 OS_QueueCreate(uint32 *queue_id, const char *queue_name,
  * @api
  */
 int32 OS_QueueDelete(uint32 queue_id) {
-  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_queue_t *oqp = queue_decode(queue_id);
   void *q_buffer, *mb_buffer;
 
-  /* Range check.*/
-  if ((oqp < &osal.queues[0]) ||
-      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
-      (oqp->is_free)) {
+  /* ID validity check.*/
+  if (oqp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
   /* Critical zone.*/
   chSysLock();
 
-  /* Marking as no more free, will be overwritten by the pool pointer.*/
-  oqp->is_free = 1;
+  /* Invalidating the generation, stale IDs are rejected from here on.*/
+  oqp->gen = (oqp->gen + 1U) & ID_GEN_MASK;
 
   /* Pointers to areas to be freed.*/
   q_buffer  = oqp->q_buffer;
@@ -796,7 +844,7 @@ int32 OS_QueueDelete(uint32 queue_id) {
  */
 int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
                   uint32 *size_copied, int32 timeout) {
-  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_queue_t *oqp = queue_decode(queue_id);
   msg_t msg, msgsts;
   void *body;
 
@@ -805,10 +853,8 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
     return OS_INVALID_POINTER;
   }
 
-  /* Range check.*/
-  if ((oqp < &osal.queues[0]) ||
-      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
-      (oqp->is_free)) {
+  /* ID validity check.*/
+  if (oqp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
@@ -817,7 +863,8 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
     return OS_QUEUE_INVALID_SIZE;
   }
 
-  /* Special time handling.*/
+  /* Fetching the message buffer pointer from the mailbox, the special
+     timeout values are translated.*/
   if (timeout == OS_PEND) {
     msgsts = chMBFetchTimeout(&oqp->mb, &msg, TIME_INFINITE);
     if (msgsts < MSG_OK) {
@@ -844,12 +891,18 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
   *size_copied = ((osal_message_t *)msg)->size;
   body  = (void *)((osal_message_t *)msg)->buf;
 
-  /* Copying the message body.*/
+  /* Copying the message body straight from the pooled buffer into the
+     destination, this is the only copy performed on the receive path.*/
   memcpy(data, body, *size_copied);
 
-  /* Freeing the message buffer.*/
-  chPoolFree(&oqp->messages, (void *)msg);
-  chSemSignal(&oqp->free_msgs);
+  /* Returning the buffer and crediting the producers side in a single
+     critical zone instead of paying separate pool and semaphore lock
+     round trips.*/
+  chSysLock();
+  chPoolFreeI(&oqp->messages, (void *)msg);
+  chSemSignalI(&oqp->free_msgs);
+  chSchRescheduleS();
+  chSysUnlock();
 
   return OS_SUCCESS;
 }
@@ -866,7 +919,7 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
  * @api
  */
 int32 OS_QueuePut(uint32 queue_id, void *data, uint32 size, uint32 flags) {
-  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_queue_t *oqp = queue_decode(queue_id);
   msg_t msgsts;
   osal_message_t *omsg;
 
@@ -877,10 +930,8 @@ int32 OS_QueuePut(uint32 queue_id, void *data, uint32 size, uint32 flags) {
     return OS_INVALID_POINTER;
   }
 
-  /* Range check.*/
-  if ((oqp < &osal.queues[0]) ||
-      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
-      (oqp->is_free)) {
+  /* ID validity check.*/
+  if (oqp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
@@ -889,12 +940,16 @@ int32 OS_QueuePut(uint32 queue_id, void *data, uint32 size, uint32 flags) {
     return OS_QUEUE_INVALID_SIZE;
   }
 
-  /* Getting a message buffer from the pool.*/
-  msgsts = chSemWait(&oqp->free_msgs);
+  /* Getting a message buffer from the pool, the counter semaphore wait
+     and the pool extraction share a single critical zone.*/
+  chSysLock();
+  msgsts = chSemWaitS(&oqp->free_msgs);
   if (msgsts < MSG_OK) {
+    chSysUnlock();
     return OS_ERROR;
   }
-  omsg = chPoolAlloc(&oqp->messages);
+  omsg = chPoolAllocI(&oqp->messages);
+  chSysUnlock();
 
   /* Filling message size and data.*/
   omsg->size = (size_t)size;
@@ -950,7 +1005,7 @@ int32 OS_QueueGetIdByName(uint32 *queue_id, const char *queue_name) {
  * @api
  */
 int32 OS_QueueGetInfo (uint32 queue_id, OS_queue_prop_t *queue_prop) {
-  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_queue_t *oqp = queue_decode(queue_id);
   syssts_t sts;
 
   /* NULL pointer checks.*/
@@ -958,18 +1013,16 @@ int32 OS_QueueGetInfo (uint32 queue_id, OS_queue_prop_t *queue_prop) {
     return OS_INVALID_POINTER;
   }
 
-  /* Range check.*/
-  if ((oqp < &osal.queues[0]) ||
-      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
-      (oqp->is_free)) {
+  /* ID validity check.*/
+  if (oqp == NULL) {
     return OS_ERR_INVALID_ID;
   }
 
   /* Entering a reentrant critical zone.*/
   sts = chSysGetStatusAndLockX();
 
-  /* If the queue is not in use then error.*/
-  if (oqp->is_free) {
+  /* If the queue has been deleted in the meanwhile then error.*/
+  if (oqp->gen != (queue_id & ID_GEN_MASK)) {
     /* Leaving the critical zone.*/
     chSysRestoreStatusX(sts);
     return OS_ERR_INVALID_ID;
@@ -2030,7 +2083,7 @@ int32 OS_TaskSetPriority(uint32 task_id, uint32 new_priority) {
     tp->state = CH_STATE_CURRENT;
 #endif
     /* Re-enqueues tp with its new priority on the ready list.*/
-    chSchReadyI(queue_dequeue(tp));
+    chSchReadyI(sch_ready_dequeue(tp));
     break;
   }
 
@@ -175,6 +175,68 @@ int64_t smcEntry(ts_state_t *svc_handle, ts_params_area_t svc_data,
         return LOWORD(SMC_SVC_NOENT);
       return LOWORD((int32_t)tssp);
     }
+    else if (svc_handle == TS_HND_FASTCALL) {
+
+      /* Internal fast call ring doorbell service.*/
+      ts_fc_ring_t *rp = (ts_fc_ring_t *)svc_data;
+      uint32_t served = 0;
+
+      /* The ring header and the declared number of entries must fit the
+         shared memory area.*/
+      if ((svc_datalen < sizeof (ts_fc_ring_t)) ||
+          (rp->fc_nent == 0) ||
+          (((svc_datalen - sizeof (ts_fc_ring_t)) / sizeof (ts_fc_entry_t)) <
+           rp->fc_nent))
+        return LOWORD(SMC_SVC_INVALID);
+
+#if (CH_DBG_SYSTEM_STATE_CHECK == TRUE)
+      _dbg_check_lock();
+#endif
+
+      /* Limit the max timeout interval.*/
+      if (svc_timeout > TS_MAX_TMO)
+        svc_timeout = TS_MAX_TMO;
+
+      /* Draining the ring. All the pending requests are served in this
+         same monitor transition, the world-switch cost is so amortized
+         across them.*/
+      for (;;) {
+        ts_fc_entry_t *ep = &rp->fc_entries[rp->fc_rdidx % rp->fc_nent];
+
+        if (ep->fc_state != TS_FC_ENT_PENDING)
+          break;
+        if (!isHndlValid(ep->fc_handle))
+          ep->fc_status = SMC_SVC_BADH;
+        else if (!isAddrSpaceValid(ep->fc_datap, ep->fc_datalen))
+          ep->fc_status = SMC_SVC_INVALID;
+        else if (ep->fc_handle->ts_thdp == NULL)
+          ep->fc_status = SMC_SVC_BUSY;
+        else {
+          tssp = ep->fc_handle;
+          tssp->ts_datap = ep->fc_datap;
+          tssp->ts_datalen = ep->fc_datalen;
+          chThdResumeS(&tssp->ts_thdp, MSG_OK);
+          ep->fc_status = chThdSuspendTimeoutS(&_ns_thread,
+                                               TIME_US2I(svc_timeout));
+        }
+        ep->fc_state = TS_FC_ENT_DONE;
+        rp->fc_rdidx++;
+        served++;
+
+        /* An interrupted service is left to be queried via TS_HND_STQRY,
+           the remaining entries stay pending for the next doorbell.*/
+        if (ep->fc_status == SMC_SVC_INTR)
+          break;
+      }
+
+      /* Get and clear any pending event flags.*/
+      eventflags_t fcf = chEvtGetAndClearFlagsI(&tsEventListener);
+
+#if (CH_DBG_SYSTEM_STATE_CHECK == TRUE)
+      _dbg_check_unlock();
+#endif
+      return LOWORD((int32_t)served) | ((int64_t)fcf << 32);
+    }
     else {
 
       /* User service.*/
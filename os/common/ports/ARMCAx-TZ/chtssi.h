@@ -56,6 +56,13 @@
 #define TS_HND_STQRY          ((ts_state_t *)2)  /* Query status service handle.*/
 #define TS_HND_IDLE           ((ts_state_t *)3)  /* Idle service handle.*/
 #define TS_HND_VERSION        ((ts_state_t *)4)  /* Get version service handle.*/
+#define TS_HND_FASTCALL       ((ts_state_t *)5)  /* Fast call ring doorbell
+                                                    service handle.*/
+
+/* Fast call ring entry states.*/
+#define TS_FC_ENT_FREE        0             /* Entry available to the client.*/
+#define TS_FC_ENT_PENDING     1             /* Request waiting to be served.*/
+#define TS_FC_ENT_DONE        2             /* Request served, status valid.*/
 
 /* Services events event mask.*/
 #define EVT_DAEMON_REQ_ATN    EVENT_MASK(0)
@@ -116,6 +123,35 @@ typedef struct tssi_service_state {
   uint32_t            ts_datalen;
 } ts_state_t;
 
+/**
+ * @brief   Fast call ring entry.
+ * @note    The client fills the request fields then sets @p fc_state to
+ *          @p TS_FC_ENT_PENDING as last operation.
+ */
+typedef struct tssi_fc_entry {
+  ts_state_t          *fc_handle;     /* Handle of the target service.*/
+  ts_params_area_t    fc_datap;       /* Request data area.*/
+  uint32_t            fc_datalen;     /* Size of the request data area.*/
+  volatile uint32_t   fc_state;       /* One of the TS_FC_ENT_xxx states.*/
+  volatile msg_t      fc_status;      /* Request status, valid when the
+                                         entry state is TS_FC_ENT_DONE.*/
+} ts_fc_entry_t;
+
+/**
+ * @brief   Fast call ring header.
+ * @details The ring is allocated by the client in the non secure memory
+ *          space, the entries immediately follow the header. A doorbell
+ *          smc invocation on @p TS_HND_FASTCALL is only required when the
+ *          ring becomes non-empty, entries queued while the ring is being
+ *          drained are served in the same monitor transition.
+ */
+typedef struct tssi_fc_ring {
+  volatile uint32_t   fc_rdidx;       /* Consumer index, advanced by the
+                                         secure world.*/
+  uint32_t            fc_nent;        /* Number of entries in the ring.*/
+  ts_fc_entry_t       fc_entries[];   /* The ring entries.*/
+} ts_fc_ring_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
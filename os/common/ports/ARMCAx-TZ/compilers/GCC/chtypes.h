@@ -98,6 +98,55 @@ typedef uint32_t            ucnt_t;         /**< Generic unsigned counter.  */
  */
 #define ALIGNED_VAR(n)      __attribute__((aligned(n)))
 
+/**
+ * @brief   Section for time critical code.
+ * @details Defaults to ".ramtext", merged into the data segment by the
+ *          provided linker scripts. On this port all code already runs
+ *          from RAM, the section exists for placement symmetry with the
+ *          Cortex-M ports.
+ */
+#if !defined(PORT_FAST_CODE_SECTION) || defined(__DOXYGEN__)
+#define PORT_FAST_CODE_SECTION      ".ramtext"
+#endif
+
+/**
+ * @brief   Section for non cache-able data.
+ * @details The ".nocache" section groups the buffers in a contiguous
+ *          range delimited by @p __nocache_base__ and @p __nocache_end__
+ *          so the MMU table can map it non cache-able.
+ */
+#if !defined(PORT_NOCACHE_DATA_SECTION) || defined(__DOXYGEN__)
+#define PORT_NOCACHE_DATA_SECTION   ".nocache"
+#endif
+
+/**
+ * @brief   Section for DMA buffers.
+ * @details Defaults to the ".nocache" section, DMA buffers must not be
+ *          cached on this port.
+ */
+#if !defined(PORT_DMA_RAM_SECTION) || defined(__DOXYGEN__)
+#define PORT_DMA_RAM_SECTION        ".nocache"
+#endif
+
+/**
+ * @brief   Time critical code placement attribute.
+ */
+#define PORT_FAST_CODE      __attribute__((section(PORT_FAST_CODE_SECTION)))
+
+/**
+ * @brief   Non cache-able data placement attribute.
+ * @note    The section is not initialized, the placed variables must not
+ *          have initializers.
+ */
+#define PORT_NOCACHE_DATA   __attribute__((section(PORT_NOCACHE_DATA_SECTION)))
+
+/**
+ * @brief   DMA buffers placement attribute.
+ * @note    The section is not initialized, the placed variables must not
+ *          have initializers.
+ */
+#define PORT_DMA_RAM        __attribute__((section(PORT_DMA_RAM_SECTION)))
+
 /**
  * @brief   Size of a pointer.
  * @note    To be used where the sizeof operator cannot be used, preprocessor
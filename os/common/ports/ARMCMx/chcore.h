@@ -41,6 +41,15 @@
  */
 #define PORT_ARCHITECTURE_ARM
 
+/**
+ * @brief   Port-optimized bulk memory operations available.
+ * @details The port provides @p __port_memcpy() and @p __port_memfill()
+ *          implementations dispatching on the operands alignment and
+ *          moving data in multi-word bursts, layers moving byte streams
+ *          use them in place of the C library routines.
+ */
+#define PORT_SUPPORTS_MEMOPS
+
 /* The following code is not processed when the file is included from an
    asm module because those intrinsic macros are not necessarily defined
    by the assembler too.*/
@@ -83,10 +92,49 @@
 #define PORT_USE_ALT_TIMER              FALSE
 #endif
 
+/**
+ * @brief   Per-thread MPU regions.
+ * @details If enabled then each thread carries a private set of MPU region
+ *          descriptors which is made active while the thread is running,
+ *          this allows to sandbox untrusted threads without a full process
+ *          model. The context switch code reprograms only the regions that
+ *          differ between the outgoing and the incoming thread.
+ * @note    This option is only available on the ARMv7-M sub-architecture.
+ */
+#if !defined(PORT_USE_MPU_REGIONS)
+#define PORT_USE_MPU_REGIONS            FALSE
+#endif
+
+/**
+ * @brief   First hardware MPU region assigned to threads.
+ * @details Threads use the hardware regions from @p PORT_MPU_REGIONS_BASE to
+ *          @p PORT_MPU_REGIONS_BASE + @p PORT_MPU_REGIONS_NUMBER - 1. Higher
+ *          region numbers take precedence, the default leaves the lower
+ *          regions free for a static system-wide setup and for the stack
+ *          guard page used by @p PORT_ENABLE_GUARD_PAGES.
+ */
+#if !defined(PORT_MPU_REGIONS_BASE)
+#define PORT_MPU_REGIONS_BASE           4U
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of MPU regions carried by each thread.
+ */
+#define PORT_MPU_REGIONS_NUMBER         4U
+
+#if (PORT_USE_MPU_REGIONS == TRUE) &&                                       \
+    ((CORTEX_MODEL == 0) || (CORTEX_MODEL == 1))
+#error "PORT_USE_MPU_REGIONS not supported on this architecture"
+#endif
+
+#if (PORT_MPU_REGIONS_BASE + PORT_MPU_REGIONS_NUMBER) > 8U
+#error "invalid PORT_MPU_REGIONS_BASE value specified"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -128,6 +176,19 @@ struct port_extctx {};
 struct port_intctx {};
 #endif /* defined(__DOXYGEN__) */
 
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an MPU region descriptor.
+ * @details The descriptor holds the raw values to be written into the
+ *          @p MPU_RBAR and @p MPU_RASR registers, the region number and
+ *          VALID fields of @p rbar must be left to zero.
+ */
+typedef struct {
+  uint32_t              rbar;       /**< @brief MPU_RBAR register value.    */
+  uint32_t              rasr;       /**< @brief MPU_RASR register value.    */
+} port_mpu_region_t;
+#endif
+
 /**
  * @brief   Platform dependent part of the @p thread_t structure.
  * @details In this port the structure just holds a pointer to the
@@ -136,6 +197,13 @@ struct port_intctx {};
  */
 struct port_context {
   struct port_intctx *sp;
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   MPU regions to be made active while the thread is running.
+   * @details All-zero descriptors represent disabled regions.
+   */
+  port_mpu_region_t     regions[PORT_MPU_REGIONS_NUMBER];
+#endif
 };
 
 #endif /* !defined(_FROM_ASM_) */
@@ -184,6 +252,19 @@ struct port_context {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if !defined(_FROM_ASM_)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void *__port_memcpy(void *dp, const void *sp, size_t n);
+  void *__port_memfill(void *dp, int v, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(_FROM_ASM_) */
+
 /*===========================================================================*/
 /* Module inline functions.                                                  */
 /*===========================================================================*/
@@ -31,10 +31,31 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Stack fill pattern.
+ * @note    It must match the @p CRT0_STACKS_FILL_PATTERN value used by
+ *          the startup code.
+ */
+#define PORT_STACK_FILL_PATTERN         0x55555555U
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
 
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Cycles spent in the most recent @p _port_irq_epilogue().
+ */
+rtcnt_t _port_irq_epilogue_last;
+
+/**
+ * @brief   Worst-case cycles spent in @p _port_irq_epilogue().
+ */
+rtcnt_t _port_irq_epilogue_worst;
+#endif
+
 /*===========================================================================*/
 /* Module local types.                                                       */
 /*===========================================================================*/
@@ -47,6 +68,24 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Updates the IRQ epilogue cycle measurements.
+ *
+ * @param[in] start     DWT counter value sampled on epilogue entry
+ *
+ * @notapi
+ */
+static inline void irq_epilogue_measure(rtcnt_t start) {
+  rtcnt_t cycles = (rtcnt_t)DWT->CYCCNT - start;
+
+  _port_irq_epilogue_last = cycles;
+  if (cycles > _port_irq_epilogue_worst) {
+    _port_irq_epilogue_worst = cycles;
+  }
+}
+#endif
+
 /*===========================================================================*/
 /* Module interrupt handlers.                                                */
 /*===========================================================================*/
@@ -63,17 +102,30 @@ void SVC_Handler(void) {
 /*lint -restore*/
   struct port_extctx *ctxp;
 
-#if CORTEX_USE_FPU
-  /* Enforcing unstacking of the FP part of the context.*/
-  FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
-#endif
-
   /* The port_extctx structure is pointed by the PSP register.*/
   ctxp = (struct port_extctx *)__get_PSP();
 
   /* Discarding the current exception context and positioning the stack to
      point to the real one.*/
+#if CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY
+  /* In lazy mode the discarded frame contains an FP area only if the
+     thread owns an FP context, in this case the lazy state preservation
+     is still pending for it.*/
+  if ((FPU->FPCCR & FPU_FPCCR_LSPACT_Msk) != 0U) {
+    /* Enforcing unstacking of the FP part of the context.*/
+    FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
+    ctxp++;
+  }
+  else {
+    ctxp = (struct port_extctx *)((uint32_t)ctxp + 32U);
+  }
+#else
+#if CORTEX_USE_FPU
+  /* Enforcing unstacking of the FP part of the context.*/
+  FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
+#endif
   ctxp++;
+#endif
 
   /* Restoring real position of the original stack frame.*/
   __set_PSP((uint32_t)ctxp);
@@ -95,17 +147,30 @@ void PendSV_Handler(void) {
 /*lint -restore*/
   struct port_extctx *ctxp;
 
-#if CORTEX_USE_FPU
-  /* Enforcing unstacking of the FP part of the context.*/
-  FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
-#endif
-
   /* The port_extctx structure is pointed by the PSP register.*/
   ctxp = (struct port_extctx *)__get_PSP();
 
   /* Discarding the current exception context and positioning the stack to
      point to the real one.*/
+#if CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY
+  /* In lazy mode the discarded frame contains an FP area only if the
+     thread owns an FP context, in this case the lazy state preservation
+     is still pending for it.*/
+  if ((FPU->FPCCR & FPU_FPCCR_LSPACT_Msk) != 0U) {
+    /* Enforcing unstacking of the FP part of the context.*/
+    FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
+    ctxp++;
+  }
+  else {
+    ctxp = (struct port_extctx *)((uint32_t)ctxp + 32U);
+  }
+#else
+#if CORTEX_USE_FPU
+  /* Enforcing unstacking of the FP part of the context.*/
+  FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
+#endif
   ctxp++;
+#endif
 
   /* Writing back the modified PSP value.*/
   __set_PSP((uint32_t)ctxp);
@@ -120,11 +185,43 @@ void PendSV_Handler(void) {
  * @brief   Exception exit redirection to _port_switch_from_isr().
  */
 void _port_irq_epilogue(void) {
+#if PORT_IRQ_INSTRUMENTATION == TRUE
+  rtcnt_t start = (rtcnt_t)DWT->CYCCNT;
+#endif
 
   port_lock_from_isr();
   if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) != 0U) {
     struct port_extctx *ctxp;
 
+#if CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY
+    /* In lazy mode the interrupted thread has an FP area in its frame only
+       if it owns an FP context, in this case the lazy state preservation
+       is still pending because interrupt handlers are not allowed to use
+       the FPU.*/
+    bool fpctx = (FPU->FPCCR & FPU_FPCCR_LSPACT_Msk) != 0U;
+
+    if (fpctx) {
+      /* Enforcing a lazy FPU state save by accessing the FPCSR register.*/
+      (void) __get_FPSCR();
+    }
+
+    /* The port_extctx structure is pointed by the PSP register.*/
+    ctxp = (struct port_extctx *)__get_PSP();
+
+    /* Adding an artificial exception return context matching the size of
+       the interrupted thread frame, there is no need to populate it
+       fully.*/
+    if (fpctx) {
+      ctxp--;
+      ctxp->fpscr = (regarm_t)FPU->FPDSCR;
+    }
+    else {
+      ctxp = (struct port_extctx *)((uint32_t)ctxp - 32U);
+    }
+
+    /* Setting up a fake XPSR register value.*/
+    ctxp->xpsr = (regarm_t)0x01000000;
+#else /* !(CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY) */
 #if CORTEX_USE_FPU == TRUE
       /* Enforcing a lazy FPU state save by accessing the FPCSR register.*/
       (void) __get_FPSCR();
@@ -142,6 +239,7 @@ void _port_irq_epilogue(void) {
 #if CORTEX_USE_FPU == TRUE
     ctxp->fpscr = (regarm_t)FPU->FPDSCR;
 #endif
+#endif /* !(CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY) */
 
     /* Writing back the modified PSP value.*/
     __set_PSP((uint32_t)ctxp);
@@ -158,11 +256,115 @@ void _port_irq_epilogue(void) {
       ctxp->pc = (regarm_t)_port_exit_from_isr;
     }
 
+#if PORT_IRQ_INSTRUMENTATION == TRUE
+    irq_epilogue_measure(start);
+#endif
+
     /* Note, returning without unlocking is intentional, this is done in
        order to keep the rest of the context switch atomic.*/
     return;
   }
   port_unlock_from_isr();
+#if PORT_IRQ_INSTRUMENTATION == TRUE
+  irq_epilogue_measure(start);
+#endif
+}
+
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the unused portion of the IRQ (main) stack.
+ * @details The main stack area is scanned upward from its base for the
+ *          fill pattern written by the startup code, the returned value
+ *          is the amount of stack never touched by interrupt handlers.
+ * @pre     The @p CRT0_INIT_STACKS option must be enabled in the startup
+ *          code, otherwise the result is meaningless.
+ *
+ * @return              The unused IRQ stack size in bytes.
+ */
+size_t port_irq_stack_unused(void) {
+  extern uint32_t __main_stack_base__;
+  extern uint32_t __main_stack_end__;
+  const uint32_t *p = &__main_stack_base__;
+  size_t n = (size_t)0;
+
+  while ((p < &__main_stack_end__) && (*p == PORT_STACK_FILL_PATTERN)) {
+    n += sizeof (uint32_t);
+    p++;
+  }
+
+  return n;
+}
+#endif /* PORT_IRQ_INSTRUMENTATION == TRUE */
+
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reprograms the per-thread MPU regions on context switch.
+ * @details Only the regions differing between the outgoing and the incoming
+ *          thread are written to the MPU, consecutive switches between
+ *          threads sharing the same region set cost just the compare loop.
+ *
+ * @param[in] ntp       the thread to be switched in
+ * @param[in] otp       the thread to be switched out
+ *
+ * @notapi
+ */
+void _port_mpu_update(thread_t *ntp, thread_t *otp) {
+  uint32_t i;
+  bool written = false;
+
+  for (i = 0U; i < PORT_MPU_REGIONS_NUMBER; i++) {
+    const port_mpu_region_t *nrp = &ntp->ctx.regions[i];
+    const port_mpu_region_t *orp = &otp->ctx.regions[i];
+
+    if ((nrp->rbar != orp->rbar) || (nrp->rasr != orp->rasr)) {
+      /* Disabling the region before changing its base address.*/
+      MPU->RNR  = PORT_MPU_REGIONS_BASE + i;
+      MPU->RASR = 0U;
+      MPU->RBAR = nrp->rbar;
+      MPU->RASR = nrp->rasr;
+      written = true;
+    }
+  }
+
+  if (written) {
+    __DSB();
+    __ISB();
+  }
+}
+
+/**
+ * @brief   Changes the MPU regions associated to a thread.
+ * @details The descriptors are copied into the thread context, if the
+ *          thread is the current one then the new regions are made
+ *          effective immediately.
+ * @note    The descriptors hold raw @p MPU_RBAR and @p MPU_RASR values,
+ *          the region number and VALID fields of @p rbar must be zero.
+ *          All-zero descriptors represent disabled regions.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] regions   array of @p PORT_MPU_REGIONS_NUMBER region
+ *                      descriptors
+ *
+ * @xclass
+ */
+void chThdSetMemoryRegionsX(thread_t *tp, const port_mpu_region_t *regions) {
+  uint32_t i;
+
+  for (i = 0U; i < PORT_MPU_REGIONS_NUMBER; i++) {
+    tp->ctx.regions[i] = regions[i];
+  }
+
+  if (tp == chThdGetSelfX()) {
+    for (i = 0U; i < PORT_MPU_REGIONS_NUMBER; i++) {
+      MPU->RNR  = PORT_MPU_REGIONS_BASE + i;
+      MPU->RASR = 0U;
+      MPU->RBAR = tp->ctx.regions[i].rbar;
+      MPU->RASR = tp->ctx.regions[i].rasr;
+    }
+    __DSB();
+    __ISB();
+  }
 }
+#endif /* PORT_USE_MPU_REGIONS == TRUE */
 
 /** @} */
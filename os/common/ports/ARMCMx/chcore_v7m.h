@@ -126,6 +126,37 @@
 #error "the selected core does not have an FPU"
 #endif
 
+/**
+ * @brief   Lazy FPU context switching.
+ * @details If enabled then the callee-saved FPU registers are saved and
+ *          restored only for threads owning an active FP context, the
+ *          ownership is tracked through the CONTROL.FPCA flag maintained
+ *          by the hardware. Integer-only threads do not pay the FP
+ *          registers save/restore cost on context switch.
+ * @note    This option requires @p CORTEX_USE_FPU.
+ */
+#if !defined(CORTEX_USE_FPU_LAZY)
+#define CORTEX_USE_FPU_LAZY             FALSE
+#endif
+
+/**
+ * @brief   Interrupts instrumentation.
+ * @details If enabled then the port measures the execution cycles spent
+ *          in @p _port_irq_epilogue() using the DWT cycle counter and
+ *          provides the @p port_irq_stack_unused() function returning
+ *          the never-used portion of the IRQ (main) stack.
+ * @note    The stack measurement relies on the fill pattern written by
+ *          the startup code, the @p CRT0_INIT_STACKS option must be
+ *          enabled (it is the default).
+ */
+#if !defined(PORT_IRQ_INSTRUMENTATION)
+#define PORT_IRQ_INSTRUMENTATION        FALSE
+#endif
+
+#if (CORTEX_USE_FPU_LAZY == TRUE) && (CORTEX_USE_FPU == FALSE)
+#error "CORTEX_USE_FPU_LAZY requires CORTEX_USE_FPU"
+#endif
+
 /**
  * @brief   Simplified priority handling flag.
  * @details Activating this option makes the Kernel work in compact mode.
@@ -343,7 +374,15 @@ struct port_extctx {
 };
 
 struct port_intctx {
-#if CORTEX_USE_FPU
+#if CORTEX_USE_FPU && CORTEX_USE_FPU_LAZY
+  /**
+   * Saved CONTROL.FPCA state of the thread. This structure describes the
+   * integer-only frame, which is also the initial frame of new threads,
+   * the callee-saved FP registers are stacked between this field and
+   * @p r4 only when this field is not zero.
+   */
+  regarm_t      fpca;
+#elif CORTEX_USE_FPU
   regarm_t      s16;
   regarm_t      s17;
   regarm_t      s18;
@@ -377,18 +416,57 @@ struct port_intctx {
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   MPU-related part of the @p PORT_SETUP_CONTEXT() macro.
+ * @details New threads start with all private regions disabled.
+ */
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+#define PORT_SETUP_CONTEXT_MPU(tp) {                                        \
+  unsigned i;                                                               \
+  for (i = 0U; i < PORT_MPU_REGIONS_NUMBER; i++) {                          \
+    (tp)->ctx.regions[i].rbar = 0U;                                         \
+    (tp)->ctx.regions[i].rasr = 0U;                                         \
+  }                                                                         \
+}
+#else
+#define PORT_SETUP_CONTEXT_MPU(tp)
+#endif
+
 /**
  * @brief   Platform dependent part of the @p chThdCreateI() API.
  * @details This code usually setup the context switching frame represented
  *          by an @p port_intctx structure.
  */
+#if (CORTEX_USE_FPU == TRUE) && (CORTEX_USE_FPU_LAZY == TRUE)
 #define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
   (tp)->ctx.sp = (struct port_intctx *)((uint8_t *)(wtop) -                 \
                                         sizeof (struct port_intctx));       \
+  (tp)->ctx.sp->fpca = (regarm_t)0;                                         \
   (tp)->ctx.sp->r4 = (regarm_t)(pf);                                        \
   (tp)->ctx.sp->r5 = (regarm_t)(arg);                                       \
   (tp)->ctx.sp->lr = (regarm_t)_port_thread_start;                          \
+  PORT_SETUP_CONTEXT_MPU(tp);                                               \
 }
+#else
+#define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
+  (tp)->ctx.sp = (struct port_intctx *)((uint8_t *)(wtop) -                 \
+                                        sizeof (struct port_intctx));       \
+  (tp)->ctx.sp->r4 = (regarm_t)(pf);                                        \
+  (tp)->ctx.sp->r5 = (regarm_t)(arg);                                       \
+  (tp)->ctx.sp->lr = (regarm_t)_port_thread_start;                          \
+  PORT_SETUP_CONTEXT_MPU(tp);                                               \
+}
+#endif
+
+/**
+ * @brief   Size of the callee-saved FP area not accounted by the
+ *          integer-only @p port_intctx in lazy FPU mode.
+ */
+#if (CORTEX_USE_FPU == TRUE) && (CORTEX_USE_FPU_LAZY == TRUE)
+#define PORT_FPU_CTX_SIZE       64U
+#else
+#define PORT_FPU_CTX_SIZE       0U
+#endif
 
 /**
  * @brief   Computes the thread working area global size.
@@ -396,6 +474,7 @@ struct port_intctx {
  */
 #define PORT_WA_SIZE(n) ((size_t)PORT_GUARD_PAGE_SIZE +                     \
                          sizeof (struct port_intctx) +                      \
+                         (size_t)PORT_FPU_CTX_SIZE +                        \
                          sizeof (struct port_extctx) +                      \
                          (size_t)(n) +                                      \
                          (size_t)PORT_INT_REQUIRED_STACK)
@@ -444,6 +523,17 @@ struct port_intctx {
  */
 #define PORT_FAST_IRQ_HANDLER(id) void id(void)
 
+/**
+ * @brief   MPU-related part of the @p port_switch() macro.
+ * @details The regions differing between the two threads are reprogrammed
+ *          before switching in the new context.
+ */
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+#define PORT_MPU_UPDATE(ntp, otp) _port_mpu_update(ntp, otp)
+#else
+#define PORT_MPU_UPDATE(ntp, otp)
+#endif
+
 /**
  * @brief   Performs a context switch between two threads.
  * @details This is the most critical code in any port, this function
@@ -455,7 +545,10 @@ struct port_intctx {
  * @param[in] otp       the thread to be switched out
  */
 #if (CH_DBG_ENABLE_STACK_CHECK == FALSE) || defined(__DOXYGEN__)
-#define port_switch(ntp, otp) _port_switch(ntp, otp)
+#define port_switch(ntp, otp) {                                             \
+  PORT_MPU_UPDATE(ntp, otp);                                                \
+  _port_switch(ntp, otp);                                                   \
+}
 #else
 #if PORT_ENABLE_GUARD_PAGES == FALSE
 #define port_switch(ntp, otp) {                                             \
@@ -463,10 +556,12 @@ struct port_intctx {
   if ((stkalign_t *)(r13 - 1) < (otp)->wabase) {                            \
     chSysHalt("stack overflow");                                            \
   }                                                                         \
+  PORT_MPU_UPDATE(ntp, otp);                                                \
   _port_switch(ntp, otp);                                                   \
 }
 #else
 #define port_switch(ntp, otp) {                                             \
+  PORT_MPU_UPDATE(ntp, otp);                                                \
   _port_switch(ntp, otp);                                                   \
                                                                             \
   /* Setting up the guard page for the switched-in thread.*/                \
@@ -484,6 +579,11 @@ struct port_intctx {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) && !defined(__DOXYGEN__)
+extern rtcnt_t _port_irq_epilogue_last;
+extern rtcnt_t _port_irq_epilogue_worst;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -492,6 +592,13 @@ extern "C" {
   void _port_thread_start(void);
   void _port_switch_from_isr(void);
   void _port_exit_from_isr(void);
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+  size_t port_irq_stack_unused(void);
+#endif
+#if (PORT_USE_MPU_REGIONS == TRUE) || defined(__DOXYGEN__)
+  void _port_mpu_update(thread_t *ntp, thread_t *otp);
+  void chThdSetMemoryRegionsX(thread_t *tp, const port_mpu_region_t *regions);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -538,6 +645,12 @@ static inline void port_init(void) {
     mpuEnable(MPU_CTRL_PRIVDEFENA);
   }
 #endif
+
+#if (PORT_USE_MPU_REGIONS == TRUE) && (PORT_ENABLE_GUARD_PAGES == FALSE)
+  /* MPU is enabled, the default map remains accessible to privileged
+     code where not overridden by the per-thread regions.*/
+  mpuEnable(MPU_CTRL_PRIVDEFENA);
+#endif
 }
 
 /**
@@ -708,6 +821,38 @@ static inline rtcnt_t port_rt_get_counter_value(void) {
   return DWT->CYCCNT;
 }
 
+#if (PORT_IRQ_INSTRUMENTATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the duration of the most recent IRQ epilogue.
+ *
+ * @return              The cycles spent in @p _port_irq_epilogue().
+ */
+static inline rtcnt_t port_get_irq_epilogue_last(void) {
+
+  return _port_irq_epilogue_last;
+}
+
+/**
+ * @brief   Returns the duration of the longest measured IRQ epilogue.
+ *
+ * @return              The worst-case cycles spent in
+ *                      @p _port_irq_epilogue().
+ */
+static inline rtcnt_t port_get_irq_epilogue_worst(void) {
+
+  return _port_irq_epilogue_worst;
+}
+
+/**
+ * @brief   Resets the IRQ epilogue measurements.
+ */
+static inline void port_reset_irq_epilogue_stats(void) {
+
+  _port_irq_epilogue_last  = (rtcnt_t)0;
+  _port_irq_epilogue_worst = (rtcnt_t)0;
+}
+#endif /* PORT_IRQ_INSTRUMENTATION == TRUE */
+
 #endif /* !defined(_FROM_ASM_) */
 
 #endif /* CHCORE_V7M_H */
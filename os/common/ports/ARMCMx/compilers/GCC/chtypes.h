@@ -98,6 +98,58 @@ typedef uint32_t            ucnt_t;         /**< Generic unsigned counter.  */
  */
 #define ALIGNED_VAR(n)      __attribute__((aligned(n)))
 
+/**
+ * @brief   Section for time critical code.
+ * @details Defaults to ".ramtext" which the provided linker scripts map
+ *          into the data RAM, already faster than wait-stated flash. It
+ *          can be overridden where a dedicated code memory exists, for
+ *          example ".ram6_init" is the ITCM RAM on STM32H7.
+ */
+#if !defined(PORT_FAST_CODE_SECTION) || defined(__DOXYGEN__)
+#define PORT_FAST_CODE_SECTION      ".ramtext"
+#endif
+
+/**
+ * @brief   Section for non cache-able data.
+ * @details The ".nocache" section is provided by the STM32F7 and
+ *          STM32H7 linker scripts, on other devices the section must be
+ *          added to the linker script or this setting overridden.
+ */
+#if !defined(PORT_NOCACHE_DATA_SECTION) || defined(__DOXYGEN__)
+#define PORT_NOCACHE_DATA_SECTION   ".nocache"
+#endif
+
+/**
+ * @brief   Section for DMA buffers.
+ * @details Defaults to ".ram0" which all the provided linker scripts
+ *          map into the main DMA-reachable RAM, excluding core-coupled
+ *          memories such as the CCM on STM32F4. On cached devices it
+ *          should be overridden with @p PORT_NOCACHE_DATA_SECTION or a
+ *          TCM section.
+ */
+#if !defined(PORT_DMA_RAM_SECTION) || defined(__DOXYGEN__)
+#define PORT_DMA_RAM_SECTION        ".ram0"
+#endif
+
+/**
+ * @brief   Time critical code placement attribute.
+ */
+#define PORT_FAST_CODE      __attribute__((section(PORT_FAST_CODE_SECTION)))
+
+/**
+ * @brief   Non cache-able data placement attribute.
+ * @note    The section is not initialized, the placed variables must not
+ *          have initializers.
+ */
+#define PORT_NOCACHE_DATA   __attribute__((section(PORT_NOCACHE_DATA_SECTION)))
+
+/**
+ * @brief   DMA buffers placement attribute.
+ * @note    The section is not initialized, the placed variables must not
+ *          have initializers.
+ */
+#define PORT_DMA_RAM        __attribute__((section(PORT_DMA_RAM_SECTION)))
+
 /**
  * @brief   Size of a pointer.
  * @note    To be used where the sizeof operator cannot be used, preprocessor
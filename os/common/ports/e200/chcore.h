@@ -169,6 +169,32 @@
 #define PPC_ENABLE_WFI_IDLE             FALSE
 #endif
 
+/**
+ * @brief   Saves the SPE context on switch.
+ * @details If enabled then the context switch code saves and restores the
+ *          whole 64 bits of the callee-saved registers, threads can so
+ *          freely use the SPE/EFPU instruction sets. When disabled only
+ *          the lower 32 bits are preserved, integer-only systems keep the
+ *          smaller context and the faster switch.
+ * @note    The SPE unit must be enabled in the MSR by the startup code.
+ * @note    Only supported by the GCC compiler port.
+ */
+#if !defined(PPC_USE_SPE) || defined(__DOXYGEN__)
+#define PPC_USE_SPE                     FALSE
+#endif
+
+/**
+ * @brief   Enables a prefetch of the incoming thread context.
+ * @details If enabled then the context switch code issues a @p dcbt hint
+ *          on the incoming thread context block before storing the
+ *          outgoing one, the cache miss latency is so overlapped with
+ *          useful work. It only makes sense on cores with a data cache.
+ * @note    Only supported by the GCC compiler port.
+ */
+#if !defined(PPC_ENABLE_CONTEXT_PREFETCH) || defined(__DOXYGEN__)
+#define PPC_ENABLE_CONTEXT_PREFETCH     FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -181,6 +207,15 @@
 #error "the selected MCU does not support BookE instructions set"
 #endif
 
+#if PPC_USE_SPE && ((PPC_VARIANT == PPC_VARIANT_e200z0) ||                  \
+                    (PPC_VARIANT == PPC_VARIANT_e200z2))
+#error "the selected core does not implement the SPE unit"
+#endif
+
+#if PPC_USE_SPE && (defined(__ghs__) || defined(__MWERKS__))
+#error "PPC_USE_SPE is only supported by the GCC compiler port"
+#endif
+
 /**
  * @brief   Name of the architecture variant.
  */
@@ -264,6 +299,14 @@ typedef uint64_t stkalign_t;
  */
 typedef void *regppc_t;
 
+#if (PPC_USE_SPE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   SPE-extended PPC register.
+ * @details The whole 64 bits GPR including the SPE upper word.
+ */
+typedef uint64_t regspe_t;
+#endif
+
 /**
  * @brief   Mandatory part of a stack frame.
  */
@@ -313,6 +356,7 @@ struct port_extctx {
  * @note    LR is stored in the caller context so it is not present in this
  *          structure.
  */
+#if (PPC_USE_SPE == FALSE) || defined(__DOXYGEN__)
 struct port_intctx {
   regppc_t      cr;                 /* Part of it is not volatile...        */
   regppc_t      r14;
@@ -335,6 +379,30 @@ struct port_intctx {
   regppc_t      r31;
   regppc_t      padding;
 };
+#else /* PPC_USE_SPE == TRUE */
+struct port_intctx {
+  regppc_t      cr;                 /* Part of it is not volatile...        */
+  regppc_t      padding;
+  regspe_t      r14;
+  regspe_t      r15;
+  regspe_t      r16;
+  regspe_t      r17;
+  regspe_t      r18;
+  regspe_t      r19;
+  regspe_t      r20;
+  regspe_t      r21;
+  regspe_t      r22;
+  regspe_t      r23;
+  regspe_t      r24;
+  regspe_t      r25;
+  regspe_t      r26;
+  regspe_t      r27;
+  regspe_t      r28;
+  regspe_t      r29;
+  regspe_t      r30;
+  regspe_t      r31;
+};
+#endif /* PPC_USE_SPE == TRUE */
 
 /**
  * @brief   Platform dependent part of the @p thread_t structure.
@@ -356,6 +424,7 @@ struct port_context {
  * @details This code usually setup the context switching frame represented
  *          by an @p port_intctx structure.
  */
+#if (PPC_USE_SPE == FALSE) || defined(__DOXYGEN__)
 #define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
   uint8_t *sp = (uint8_t *)(wtop) - sizeof(struct port_eabi_frame);         \
   ((struct port_eabi_frame *)sp)->slink = 0;                                \
@@ -364,6 +433,16 @@ struct port_context {
   (tp)->ctx.sp->r31 = (regppc_t)(arg);                                      \
   (tp)->ctx.sp->r30 = (regppc_t)(pf);                                       \
 }
+#else /* PPC_USE_SPE == TRUE */
+#define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
+  uint8_t *sp = (uint8_t *)(wtop) - sizeof(struct port_eabi_frame);         \
+  ((struct port_eabi_frame *)sp)->slink = 0;                                \
+  ((struct port_eabi_frame *)sp)->shole = (uint32_t)_port_thread_start;     \
+  (tp)->ctx.sp = (struct port_intctx *)(sp - sizeof(struct port_intctx));   \
+  (tp)->ctx.sp->r31 = (regspe_t)(uint32_t)(arg);                            \
+  (tp)->ctx.sp->r30 = (regspe_t)(uint32_t)(pf);                             \
+}
+#endif /* PPC_USE_SPE == TRUE */
 
 /**
  * @brief   Computes the thread working area global size.
@@ -156,6 +156,24 @@ __attribute__((weak))
 void __early_init(void) {}
 /*lint -restore*/
 
+/**
+ * @brief   Clock settling hook.
+ * @details This hook is invoked after the DATA and BSS segments
+ *          initialization and before @p __late_init(). Boards splitting
+ *          the clock bring-up can program the flash wait states and
+ *          start the PLL in @p __early_init(), then wait for the lock
+ *          and switch the system clock here: the lock time is spent
+ *          initializing the RAM segments instead of busy waiting. The
+ *          default behavior is to do nothing.
+ * @note    This function is a weak symbol.
+ */
+#if !defined(__DOXYGEN__)
+__attribute__((weak))
+#endif
+/*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+void __late_clock_init(void) {}
+/*lint -restore*/
+
 /**
  * @brief   Late initialization.
  * @details This hook is invoked after the DATA and BSS segments
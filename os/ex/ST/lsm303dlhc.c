@@ -816,6 +816,259 @@ static msg_t comp_set_full_scale(LSM303DLHCDriver *devp,
   return msg;
 }
 
+
+#if (LSM303DLHC_ACC_USE_FIFO == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Return the accelerometer FIFO depth in sample sets.
+ *
+ * @param[in] ip        pointer to @p BaseBatchSensor interface.
+ *
+ * @return              the FIFO depth.
+ */
+static size_t batch_get_size(void *ip) {
+  (void)ip;
+
+  return LSM303DLHC_ACC_FIFO_DEPTH;
+}
+
+/**
+ * @brief   Reads up to @p n sample sets from the accelerometer FIFO.
+ * @note    All the accumulated samples are returned with a single I2C
+ *          transaction, the samples are stamped with the drain time and
+ *          their spacing is the configured output data rate.
+ *
+ * @param[in] ip        pointer to @p BaseBatchSensor interface.
+ * @param[out] samples  pointer to a @p sensor_sample_t array.
+ * @param[in] n         size of the array in sample sets.
+ * @param[out] np       number of sample sets actually read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t batch_read_batch(void *ip, sensor_sample_t samples[],
+                              size_t n, size_t *np) {
+  LSM303DLHCDriver* devp;
+  uint8_t buff[LSM303DLHC_ACC_FIFO_DEPTH * LSM303DLHC_ACC_NUMBER_OF_AXES * 2];
+  uint8_t src;
+  size_t count, i, j;
+  int16_t tmp;
+  systime_t now;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL) &&
+               (n > 0U));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM303DLHCDriver*, (BaseBatchSensor*)ip);
+
+  osalDbgAssert((devp->state == LSM303DLHC_READY),
+                "batch_read_batch(), invalid state");
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "batch_read_batch(), channel not ready");
+
+#if LSM303DLHC_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM303DLHC_SHARED_I2C */
+
+  /* Getting the number of unread sample sets, the level field saturates
+     one below the depth when an overrun occurred.*/
+  msg = lsm303dlhcI2CReadRegister(devp->config->i2cp, LSM303DLHC_SAD_ACC,
+                                  LSM303DLHC_AD_ACC_FIFO_SRC_REG, &src, 1);
+  count = 0;
+  if(msg == MSG_OK) {
+    count = (size_t)(src & LSM303DLHC_FIFO_SRC_REG_A_FSS_MASK);
+    if(src & LSM303DLHC_FIFO_SRC_REG_A_OVRN)
+      count = LSM303DLHC_ACC_FIFO_DEPTH;
+    if(count > n)
+      count = n;
+    if(count > 0)
+      msg = lsm303dlhcI2CReadRegister(devp->config->i2cp, LSM303DLHC_SAD_ACC,
+                                      LSM303DLHC_AD_ACC_OUT_X_L, buff,
+                                      count * LSM303DLHC_ACC_NUMBER_OF_AXES * 2);
+  }
+
+#if LSM303DLHC_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM303DLHC_SHARED_I2C */
+
+  if(msg == MSG_OK) {
+    now = osalOsGetSystemTimeX();
+    for(i = 0; i < count; i++) {
+      samples[i].t = now;
+      for(j = 0; j < LSM303DLHC_ACC_NUMBER_OF_AXES; j++) {
+        tmp = buff[2 * (i * LSM303DLHC_ACC_NUMBER_OF_AXES + j)] +
+              (buff[2 * (i * LSM303DLHC_ACC_NUMBER_OF_AXES + j) + 1] << 8);
+        samples[i].axes[j] = (int32_t)tmp;
+      }
+    }
+    *np = count;
+  }
+  return msg;
+}
+
+#if (SENSOR_USE_DELIVERY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Writes the accelerometer FIFO related control registers.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ * @param[in] reg5      CTRL_REG5_A value.
+ * @param[in] fifoctrl  FIFO_CTRL_REG_A value.
+ * @param[in] reg3      CTRL_REG3_A value.
+ *
+ * @return              the operation status.
+ */
+static msg_t batch_write_fifo_regs(LSM303DLHCDriver *devp, uint8_t reg5,
+                                   uint8_t fifoctrl, uint8_t reg3) {
+  uint8_t cr[2];
+  msg_t msg;
+
+#if LSM303DLHC_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM303DLHC_SHARED_I2C */
+
+  cr[0] = LSM303DLHC_AD_ACC_CTRL_REG5;
+  cr[1] = reg5;
+  msg = lsm303dlhcI2CWriteRegister(devp->config->i2cp, LSM303DLHC_SAD_ACC,
+                                   cr, 1);
+  if(msg == MSG_OK) {
+    cr[0] = LSM303DLHC_AD_ACC_FIFO_CTRL_REG;
+    cr[1] = fifoctrl;
+    msg = lsm303dlhcI2CWriteRegister(devp->config->i2cp, LSM303DLHC_SAD_ACC,
+                                     cr, 1);
+  }
+  if(msg == MSG_OK) {
+    cr[0] = LSM303DLHC_AD_ACC_CTRL_REG3;
+    cr[1] = reg3;
+    msg = lsm303dlhcI2CWriteRegister(devp->config->i2cp, LSM303DLHC_SAD_ACC,
+                                     cr, 1);
+  }
+
+#if LSM303DLHC_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM303DLHC_SHARED_I2C */
+
+  return msg;
+}
+
+/**
+ * @brief   Starts accelerometer delivery into an objects FIFO.
+ * @details The accelerometer FIFO is enabled in stream mode and the
+ *          watermark interrupt is routed to INT1.
+ *
+ * @param[in] ip        pointer to @p BaseBatchSensor interface.
+ * @param[in] ofp       pointer to the destination @p objects_fifo_t.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t batch_start_delivery(void *ip, objects_fifo_t *ofp) {
+  LSM303DLHCDriver* devp;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (ofp != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM303DLHCDriver*, (BaseBatchSensor*)ip);
+
+  osalDbgAssert((devp->state == LSM303DLHC_READY),
+                "batch_start_delivery(), invalid state");
+
+  devp->accfifop = ofp;
+  msg = batch_write_fifo_regs(devp,
+                              LSM303DLHC_CTRL_REG5_A_FIFO_EN,
+                              LSM303DLHC_FIFO_CTRL_REG_A_FM1 |
+                              LSM303DLHC_ACC_FIFO_WATERMARK,
+                              LSM303DLHC_CTRL_REG3_A_I1_WTM);
+  if(msg != MSG_OK)
+    devp->accfifop = NULL;
+  return msg;
+}
+
+/**
+ * @brief   Stops accelerometer delivery and disables the FIFO.
+ *
+ * @param[in] ip        pointer to @p BaseBatchSensor interface.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t batch_stop_delivery(void *ip) {
+  LSM303DLHCDriver* devp;
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM303DLHCDriver*, (BaseBatchSensor*)ip);
+
+  osalDbgAssert((devp->state == LSM303DLHC_READY),
+                "batch_stop_delivery(), invalid state");
+
+  msg = batch_write_fifo_regs(devp, 0, 0, 0);
+  devp->accfifop = NULL;
+  return msg;
+}
+
+/**
+ * @brief   Drains the accelerometer FIFO into the objects FIFO.
+ * @details To be called from a thread woken by the INT1 watermark
+ *          interrupt, samples are dropped when the objects FIFO has no
+ *          free objects.
+ *
+ * @param[in] ip        pointer to @p BaseBatchSensor interface.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t batch_deliver(void *ip) {
+  LSM303DLHCDriver* devp;
+  sensor_sample_t chunk[8];
+  size_t got, i;
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM303DLHCDriver*, (BaseBatchSensor*)ip);
+
+  osalDbgAssert((devp->accfifop != NULL),
+                "batch_deliver(), delivery not started");
+
+  do {
+    got = 0;
+    msg = batch_read_batch(ip, chunk, 8, &got);
+    if(msg != MSG_OK)
+      return msg;
+    for(i = 0; i < got; i++) {
+      sensor_sample_t *objp = chFifoTakeObjectTimeout(devp->accfifop,
+                                                      TIME_IMMEDIATE);
+      if(objp == NULL)
+        return MSG_OK;
+      *objp = chunk[i];
+      chFifoSendObject(devp->accfifop, objp);
+    }
+  } while(got == 8);
+  return MSG_OK;
+}
+#endif /* SENSOR_USE_DELIVERY == TRUE */
+#endif /* LSM303DLHC_ACC_USE_FIFO == TRUE */
+
 static const struct LSM303DLHCVMT vmt_device = {
   (size_t)0,
   acc_set_full_scale, comp_set_full_scale
@@ -833,6 +1086,17 @@ static const struct BaseCompassVMT vmt_compass = {
   comp_set_bias, comp_reset_bias, comp_set_sensivity, comp_reset_sensivity
 };
 
+#if (LSM303DLHC_ACC_USE_FIFO == TRUE) || defined(__DOXYGEN__)
+static const struct BaseBatchSensorVMT vmt_batch = {
+  sizeof(struct LSM303DLHCVMT*) + sizeof(BaseAccelerometer) +
+  sizeof(BaseCompass),
+  batch_get_size, batch_read_batch
+#if (SENSOR_USE_DELIVERY == TRUE) || defined(__DOXYGEN__)
+  , batch_start_delivery, batch_stop_delivery, batch_deliver
+#endif
+};
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -848,6 +1112,12 @@ void lsm303dlhcObjectInit(LSM303DLHCDriver *devp) {
   devp->vmt = &vmt_device;
   devp->acc_if.vmt = &vmt_accelerometer;
   devp->comp_if.vmt = &vmt_compass;
+#if LSM303DLHC_ACC_USE_FIFO == TRUE
+  devp->batch_if.vmt = &vmt_batch;
+#if SENSOR_USE_DELIVERY == TRUE
+  devp->accfifop = NULL;
+#endif
+#endif
 
   devp->config = NULL;
 
@@ -71,6 +71,8 @@
  */
 #define LSM303DLHC_ACC_NUMBER_OF_AXES       3U
 
+#define LSM303DLHC_ACC_FIFO_DEPTH           32U
+
 #define LSM303DLHC_ACC_2G                   2.0f
 #define LSM303DLHC_ACC_4G                   4.0f
 #define LSM303DLHC_ACC_8G                   8.0f
@@ -266,6 +268,27 @@
 #define LSM303DLHC_CTRL_REG6_A_I2_CLICKEN   (1 << 7)
 /** @} */
 
+/**
+ * @name    LSM303DLHC_FIFO_CTRL_REG_A register bits definitions
+ * @{
+ */
+#define LSM303DLHC_FIFO_CTRL_REG_A_MASK     0xFF
+#define LSM303DLHC_FIFO_CTRL_REG_A_FTH_MASK 0x1F
+#define LSM303DLHC_FIFO_CTRL_REG_A_TR       (1 << 5)
+#define LSM303DLHC_FIFO_CTRL_REG_A_FM0      (1 << 6)
+#define LSM303DLHC_FIFO_CTRL_REG_A_FM1      (1 << 7)
+/** @} */
+
+/**
+ * @name    LSM303DLHC_FIFO_SRC_REG_A register bits definitions
+ * @{
+ */
+#define LSM303DLHC_FIFO_SRC_REG_A_FSS_MASK  0x1F
+#define LSM303DLHC_FIFO_SRC_REG_A_EMPTY     (1 << 5)
+#define LSM303DLHC_FIFO_SRC_REG_A_OVRN      (1 << 6)
+#define LSM303DLHC_FIFO_SRC_REG_A_WTM       (1 << 7)
+/** @} */
+
 /**
  * @name    LSM303DLHC_CRA_REG_M register bits definitions
  * @{
@@ -361,6 +384,28 @@
 #if !defined(LSM303DLHC_COMP_USE_ADVANCED) || defined(__DOXYGEN__)
 #define LSM303DLHC_COMP_USE_ADVANCED        FALSE
 #endif
+
+/**
+ * @brief   LSM303DLHC accelerometer subsystem FIFO switch.
+ * @details If set to @p TRUE the @p BaseBatchSensor interface is
+ *          implemented on the accelerometer internal FIFO: a single I2C
+ *          transaction returns up to a full FIFO of sample sets and, on
+ *          kernels providing objects FIFOs, the accumulated samples can
+ *          be delivered on the watermark interrupt.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(LSM303DLHC_ACC_USE_FIFO) || defined(__DOXYGEN__)
+#define LSM303DLHC_ACC_USE_FIFO             FALSE
+#endif
+
+/**
+ * @brief   LSM303DLHC accelerometer FIFO watermark level.
+ * @details Number of sample sets accumulated before the watermark
+ *          interrupt is raised on INT1 when delivery is active.
+ */
+#if !defined(LSM303DLHC_ACC_FIFO_WATERMARK) || defined(__DOXYGEN__)
+#define LSM303DLHC_ACC_FIFO_WATERMARK       16
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -387,6 +432,12 @@
 #error "LSM303DLHC_SHARED_I2C requires I2C_USE_MUTUAL_EXCLUSION"
 #endif
 
+#if LSM303DLHC_ACC_USE_FIFO &&                                              \
+    ((LSM303DLHC_ACC_FIFO_WATERMARK < 1) ||                                 \
+     (LSM303DLHC_ACC_FIFO_WATERMARK > 31))
+#error "invalid LSM303DLHC_ACC_FIFO_WATERMARK value"
+#endif
+
 /**
  * @todo    Add support for LSM303DLHC over SPI.
  */
@@ -653,7 +704,19 @@ struct LSM303DLHCVMT {
   /* Compass subsystem current bias.*/                                      \
   float                     compbias[LSM303DLHC_COMP_NUMBER_OF_AXES];       \
   /* Compass subsystem current full scale value.*/                          \
-  float                     compfullscale;
+  float                     compfullscale;                                  \
+  _lsm303dlhc_fifo_data
+
+#if (LSM303DLHC_ACC_USE_FIFO == TRUE) && (SENSOR_USE_DELIVERY == TRUE)
+/**
+ * @brief @p LSM303DLHCDriver delivery specific data.
+ */
+#define _lsm303dlhc_fifo_data                                               \
+  /* Destination objects FIFO of the accelerometer delivery.*/              \
+  objects_fifo_t            *accfifop;
+#else
+#define _lsm303dlhc_fifo_data
+#endif
 
 /**
  * @brief LSM303DLHC 6-axis accelerometer/compass class.
@@ -665,6 +728,10 @@ struct LSM303DLHCDriver {
   BaseAccelerometer           acc_if;
   /** @brief Base compass interface.*/
   BaseCompass                 comp_if;
+#if (LSM303DLHC_ACC_USE_FIFO == TRUE) || defined(__DOXYGEN__)
+  /** @brief Base batch sensor interface on the accelerometer FIFO.*/
+  BaseBatchSensor             batch_if;
+#endif
   _lsm303dlhc_data
 };
 /** @} */
@@ -810,6 +877,94 @@ struct LSM303DLHCDriver {
 #define lsm303dlhcAccelerometerSetFullScale(devp, fs)                       \
         (devp)->vmt->acc_set_full_scale(devp, fs)
 
+#if (LSM303DLHC_ACC_USE_FIFO == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Return the accelerometer FIFO depth in sample sets.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ *
+ * @return              the FIFO depth.
+ *
+ * @api
+ */
+#define lsm303dlhcAccelerometerGetBatchSize(devp)                           \
+        sensorGetBatchSize(&((devp)->batch_if))
+
+/**
+ * @brief   Reads up to @p n sample sets from the accelerometer FIFO.
+ * @details All the accumulated samples are returned with a single I2C
+ *          transaction.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ * @param[out] sp       pointer to a @p sensor_sample_t array.
+ * @param[in] n         size of the array in sample sets.
+ * @param[out] np       number of sample sets actually read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ *
+ * @api
+ */
+#define lsm303dlhcAccelerometerReadBatch(devp, sp, n, np)                   \
+        sensorReadBatch(&((devp)->batch_if), sp, n, np)
+
+#if (SENSOR_USE_DELIVERY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts accelerometer delivery into an objects FIFO.
+ * @details The accelerometer FIFO is enabled in stream mode and the
+ *          watermark interrupt is routed to INT1, the objects FIFO must
+ *          be initialized with objects of type @p sensor_sample_t.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ * @param[in] ofp       pointer to the destination @p objects_fifo_t.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ *
+ * @api
+ */
+#define lsm303dlhcAccelerometerStartDelivery(devp, ofp)                     \
+        sensorStartDelivery(&((devp)->batch_if), ofp)
+
+/**
+ * @brief   Stops accelerometer delivery and disables the FIFO.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ *
+ * @api
+ */
+#define lsm303dlhcAccelerometerStopDelivery(devp)                           \
+        sensorStopDelivery(&((devp)->batch_if))
+
+/**
+ * @brief   Drains the accelerometer FIFO into the objects FIFO.
+ * @details To be called from a thread woken by the INT1 watermark
+ *          interrupt, samples are dropped when the objects FIFO has no
+ *          free objects.
+ *
+ * @param[in] devp      pointer to @p LSM303DLHCDriver.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ *
+ * @api
+ */
+#define lsm303dlhcAccelerometerDeliver(devp)                                \
+        sensorDeliver(&((devp)->batch_if))
+#endif /* SENSOR_USE_DELIVERY == TRUE */
+#endif /* LSM303DLHC_ACC_USE_FIFO == TRUE */
+
 /**
  * @brief   Return the number of axes of the BaseCompass.
  *
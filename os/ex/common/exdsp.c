@@ -0,0 +1,274 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    exdsp.c
+ * @brief   EX fixed-point DSP primitives module code.
+ *
+ * @addtogroup EXDSP
+ * @ingroup EX
+ * @{
+ */
+
+#include "hal.h"
+#include "exdsp.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+#if (EXDSP_USE_DSP_INTRINSICS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Packs two consecutive Q15 values into a SIMD register image.
+ * @note    The expression compiles into a single word load when the
+ *          source is naturally aligned.
+ *
+ * @param[in] p         pointer to the first of the two values
+ * @return              The packed pair.
+ *
+ * @notapi
+ */
+static inline uint32_t exdsp_pack2(const int16_t *p) {
+
+  return (uint32_t)(uint16_t)p[0] | ((uint32_t)(uint16_t)p[1] << 16);
+}
+
+/**
+ * @brief   Saturates a Q15 accumulator to the 16 bits range.
+ *
+ * @param[in] x         value to be saturated
+ * @return              The saturated value.
+ *
+ * @notapi
+ */
+static inline int16_t exdsp_sat16(int32_t x) {
+
+  return (int16_t)__SSAT(x, 16);
+}
+#else /* EXDSP_USE_DSP_INTRINSICS == FALSE */
+static inline int16_t exdsp_sat16(int32_t x) {
+
+  if (x > 32767) {
+    return (int16_t)32767;
+  }
+  if (x < -32768) {
+    return (int16_t)-32768;
+  }
+  return (int16_t)x;
+}
+#endif /* EXDSP_USE_DSP_INTRINSICS == FALSE */
+
+/**
+ * @brief   Dot product of two 3-elements Q15 vectors.
+ *
+ * @param[in] ap        first vector
+ * @param[in] bp        second vector
+ * @return              The accumulated products in Q30 format.
+ *
+ * @notapi
+ */
+static inline int32_t exdsp_dot3(const int16_t *ap, const int16_t *bp) {
+
+#if EXDSP_USE_DSP_INTRINSICS == TRUE
+  int32_t acc;
+
+  acc = (int32_t)__SMUAD(exdsp_pack2(ap), exdsp_pack2(bp));
+  return acc + ((int32_t)ap[2] * (int32_t)bp[2]);
+#else
+  return ((int32_t)ap[0] * (int32_t)bp[0]) +
+         ((int32_t)ap[1] * (int32_t)bp[1]) +
+         ((int32_t)ap[2] * (int32_t)bp[2]);
+#endif
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Dot product of two Q15 vectors.
+ * @details The products are accumulated without intermediate scaling,
+ *          the result is in Q30 format. The 32 bits accumulator does
+ *          not overflow for vectors of up to 65536 full-scale elements.
+ *
+ * @param[in] ap        pointer to the first vector
+ * @param[in] bp        pointer to the second vector
+ * @param[in] n         number of elements
+ * @return              The accumulated products in Q30 format.
+ *
+ * @api
+ */
+int32_t exdspDotQ15(const int16_t *ap, const int16_t *bp, size_t n) {
+  int32_t acc = 0;
+
+#if EXDSP_USE_DSP_INTRINSICS == TRUE
+  while (n >= 2U) {
+    acc = (int32_t)__SMLAD(exdsp_pack2(ap), exdsp_pack2(bp), (uint32_t)acc);
+    ap += 2;
+    bp += 2;
+    n  -= 2U;
+  }
+  if (n > 0U) {
+    acc += (int32_t)*ap * (int32_t)*bp;
+  }
+#else
+  while (n > 0U) {
+    acc += (int32_t)*ap++ * (int32_t)*bp++;
+    n--;
+  }
+#endif
+
+  return acc;
+}
+
+/**
+ * @brief   Multiplies a 3-elements Q15 vector by a 3x3 Q15 matrix.
+ * @details Typical uses are rotating raw samples into the board frame
+ *          and applying a soft-iron correction matrix, the results are
+ *          saturated to the Q15 range.
+ * @note    The matrix is stored by rows, the result storage can alias
+ *          neither the matrix nor the input vector.
+ *
+ * @param[in] mp        pointer to the matrix, 9 elements by rows
+ * @param[in] vp        pointer to the input vector
+ * @param[out] rp       pointer to the result vector
+ *
+ * @api
+ */
+void exdspMat3VecQ15(const int16_t mp[9], const int16_t vp[3],
+                     int16_t rp[3]) {
+  unsigned i;
+
+  for (i = 0U; i < 3U; i++) {
+    rp[i] = exdsp_sat16(exdsp_dot3(&mp[i * 3U], vp) >> 15);
+  }
+}
+
+/**
+ * @brief   Multiplies two 3x3 Q15 matrices.
+ * @note    The matrices are stored by rows, the result storage can alias
+ *          neither of the operands.
+ *
+ * @param[in] ap        pointer to the first matrix, 9 elements by rows
+ * @param[in] bp        pointer to the second matrix, 9 elements by rows
+ * @param[out] rp       pointer to the result matrix
+ *
+ * @api
+ */
+void exdspMat3MulQ15(const int16_t ap[9], const int16_t bp[9],
+                     int16_t rp[9]) {
+  unsigned i, j;
+
+  for (i = 0U; i < 3U; i++) {
+    for (j = 0U; j < 3U; j++) {
+      int32_t acc;
+
+      acc = ((int32_t)ap[i * 3U]      * (int32_t)bp[j]) +
+            ((int32_t)ap[i * 3U + 1U] * (int32_t)bp[j + 3U]) +
+            ((int32_t)ap[i * 3U + 2U] * (int32_t)bp[j + 6U]);
+      rp[i * 3U + j] = exdsp_sat16(acc >> 15);
+    }
+  }
+}
+
+/**
+ * @brief   Initializes a Q15 biquad section.
+ * @details The internal state is zeroed, feeding a constant input then
+ *          settles from zero as for a freshly powered filter.
+ *
+ * @param[out] bqp      pointer to the @p exdsp_biquad_t structure
+ * @param[in] coeffs    pointer to the coefficients in the order
+ *                      b0, b1, b2, a1, a2
+ * @param[in] shift     output left shift compensating the coefficients
+ *                      scaling, zero for coefficients within the Q15
+ *                      range
+ *
+ * @api
+ */
+void exdspBiquadInit(exdsp_biquad_t *bqp, const int16_t *coeffs,
+                     int8_t shift) {
+
+  osalDbgCheck((bqp != NULL) && (coeffs != NULL) && (shift >= 0));
+
+  bqp->b[0]  = coeffs[0];
+  bqp->b[1]  = coeffs[1];
+  bqp->b[2]  = coeffs[2];
+  bqp->a[0]  = coeffs[3];
+  bqp->a[1]  = coeffs[4];
+  bqp->shift = shift;
+  bqp->s1    = 0;
+  bqp->s2    = 0;
+}
+
+/**
+ * @brief   Filters one Q15 sample through a biquad section.
+ *
+ * @param[in,out] bqp   pointer to the @p exdsp_biquad_t structure
+ * @param[in] x         input sample in Q15 format
+ * @return              The filtered sample in Q15 format.
+ *
+ * @api
+ */
+int16_t exdspBiquadStepQ15(exdsp_biquad_t *bqp, int16_t x) {
+  int32_t acc, y;
+
+  acc = ((int32_t)bqp->b[0] * (int32_t)x) + bqp->s1;
+  y   = exdsp_sat16(acc >> (15 - bqp->shift));
+  bqp->s1 = ((int32_t)bqp->b[1] * (int32_t)x) -
+            ((int32_t)bqp->a[0] * y) + bqp->s2;
+  bqp->s2 = ((int32_t)bqp->b[2] * (int32_t)x) -
+            ((int32_t)bqp->a[1] * y);
+
+  return (int16_t)y;
+}
+
+/**
+ * @brief   Filters a block of Q15 samples through a biquad section.
+ * @note    In-place operation is allowed, the output storage can be the
+ *          same as the input storage.
+ *
+ * @param[in,out] bqp   pointer to the @p exdsp_biquad_t structure
+ * @param[in] xp        pointer to the input samples
+ * @param[out] yp       pointer to the output samples
+ * @param[in] n         number of samples
+ *
+ * @api
+ */
+void exdspBiquadRunQ15(exdsp_biquad_t *bqp, const int16_t *xp,
+                       int16_t *yp, size_t n) {
+
+  while (n > 0U) {
+    *yp++ = exdspBiquadStepQ15(bqp, *xp++);
+    n--;
+  }
+}
+
+/** @} */
@@ -0,0 +1,160 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    exdsp.h
+ * @brief   EX fixed-point DSP primitives module header.
+ * @details This module provides the small set of Q15 fixed-point vector
+ *          operations recurring in sensor fusion chains built on the EX
+ *          drivers: dot products, 3x3 matrix operations for axes
+ *          rotation and soft-iron correction, and biquad IIR sections
+ *          for sample rate filtering. On cores implementing the ARMv7E-M
+ *          DSP extension (Cortex-M4/M7) the inner loops use the packed
+ *          16-bit multiply-accumulate and saturation intrinsics from the
+ *          CMSIS headers, other targets fall back to portable C with the
+ *          same numerical behavior.
+ *
+ * @addtogroup EXDSP
+ * @ingroup EX
+ * @{
+ */
+
+#ifndef EXDSP_H
+#define EXDSP_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Version identification
+ * @{
+ */
+/**
+ * @brief   EX DSP primitives version string.
+ */
+#define EX_DSP_VERSION                      "1.0.0"
+
+/**
+ * @brief   EX DSP primitives version major number.
+ */
+#define EX_DSP_MAJOR                        1
+
+/**
+ * @brief   EX DSP primitives version minor number.
+ */
+#define EX_DSP_MINOR                        0
+
+/**
+ * @brief   EX DSP primitives version patch number.
+ */
+#define EX_DSP_PATCH                        0
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                        */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the DSP extension intrinsics.
+ * @details When enabled the inner loops use the @p __SMLAD and @p __SSAT
+ *          intrinsics, the default follows the compiler-advertised
+ *          availability of the ARMv7E-M DSP extension.
+ */
+#if !defined(EXDSP_USE_DSP_INTRINSICS) || defined(__DOXYGEN__)
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define EXDSP_USE_DSP_INTRINSICS            TRUE
+#else
+#define EXDSP_USE_DSP_INTRINSICS            FALSE
+#endif
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a Q15 biquad IIR section.
+ * @details The section implements the transposed direct form II of the
+ *          difference equation
+ *          y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ *          with Q15 coefficients and a Q30 internal state. Coefficients
+ *          with magnitude above one must be scaled down by a power of two
+ *          and the scaling returned through the @p shift field.
+ */
+typedef struct {
+  /**
+   * @brief   Numerator coefficients b0, b1, b2 in Q15 format.
+   */
+  int16_t                   b[3];
+  /**
+   * @brief   Denominator coefficients a1, a2 in Q15 format.
+   */
+  int16_t                   a[2];
+  /**
+   * @brief   Output left shift compensating the coefficients scaling.
+   */
+  int8_t                    shift;
+  /**
+   * @brief   First state accumulator in Q30 format.
+   */
+  int32_t                   s1;
+  /**
+   * @brief   Second state accumulator in Q30 format.
+   */
+  int32_t                   s2;
+} exdsp_biquad_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  int32_t exdspDotQ15(const int16_t *ap, const int16_t *bp, size_t n);
+  void exdspMat3VecQ15(const int16_t mp[9], const int16_t vp[3],
+                       int16_t rp[3]);
+  void exdspMat3MulQ15(const int16_t ap[9], const int16_t bp[9],
+                       int16_t rp[9]);
+  void exdspBiquadInit(exdsp_biquad_t *bqp, const int16_t *coeffs,
+                       int8_t shift);
+  int16_t exdspBiquadStepQ15(exdsp_biquad_t *bqp, int16_t x);
+  void exdspBiquadRunQ15(exdsp_biquad_t *bqp, const int16_t *xp,
+                         int16_t *yp, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXDSP_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the EX DSP primitives files.
+EXDSPSRC := $(CHIBIOS)/os/ex/common/exdsp.c
+
+# Required include directories
+EXDSPINC := $(CHIBIOS)/os/ex/common
+
+# Shared variables
+ALLCSRC += $(EXDSPSRC)
+ALLINC  += $(EXDSPINC)
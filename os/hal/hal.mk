@@ -77,6 +77,9 @@ endif
 ifneq ($(findstring HAL_USE_USB TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_usb.c
 endif
+ifneq ($(findstring HAL_USE_USB_MSC TRUE,$(HALCONF)),)
+HALSRC += $(CHIBIOS)/os/hal/src/hal_usb_msc.c
+endif
 ifneq ($(findstring HAL_USE_WDG TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_wdg.c
 endif
@@ -107,6 +110,7 @@ HALSRC = $(CHIBIOS)/os/hal/src/hal.c \
          $(CHIBIOS)/os/hal/src/hal_st.c \
          $(CHIBIOS)/os/hal/src/hal_uart.c \
          $(CHIBIOS)/os/hal/src/hal_usb.c \
+         $(CHIBIOS)/os/hal/src/hal_usb_msc.c \
          $(CHIBIOS)/os/hal/src/hal_wdg.c
 endif
 
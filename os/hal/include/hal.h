@@ -158,6 +158,7 @@
 /* Complex drivers.*/
 #include "hal_mmc_spi.h"
 #include "hal_serial_usb.h"
+#include "hal_usb_msc.h"
 
 /* Community drivers.*/
 #if defined(HAL_USE_COMMUNITY) || defined(__DOXYGEN__)
@@ -217,14 +218,160 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Enables the staged initialization support.
+ * @details When enabled the initialization phases are timestamped into a
+ *          queryable record table and a deferred initialization stage,
+ *          meant to be executed by a low priority thread after the
+ *          scheduler is up, becomes available.
+ */
+#if !defined(HAL_USE_STAGED_INIT) || defined(__DOXYGEN__)
+#define HAL_USE_STAGED_INIT                 FALSE
+#endif
+
+/**
+ * @brief   Maximum number of initialization records.
+ */
+#if !defined(HAL_INIT_MAX_RECORDS) || defined(__DOXYGEN__)
+#define HAL_INIT_MAX_RECORDS                16
+#endif
+
+/**
+ * @brief   Enables the runtime clocks reconfiguration support.
+ * @details When enabled the clock tree can be switched at runtime between
+ *          port-defined configurations, registered drivers are notified
+ *          around the switch so they can recompute their dividers.
+ * @note    Requires a port with dynamic clocks support.
+ */
+#if !defined(HAL_USE_CLOCK_MANAGEMENT) || defined(__DOXYGEN__)
+#define HAL_USE_CLOCK_MANAGEMENT            FALSE
+#endif
+
+/**
+ * @brief   Initialization timestamps source.
+ * @details The default implementation reads the DWT cycle counter where
+ *          one is available, boards without it can redefine this macro
+ *          to any free running counter.
+ */
+#if !defined(HAL_INIT_GET_TIMESTAMP) || defined(__DOXYGEN__)
+#if defined(DWT) || defined(__DOXYGEN__)
+#define HAL_INIT_GET_TIMESTAMP()            (DWT->CYCCNT)
+#else
+#define HAL_INIT_GET_TIMESTAMP()            0U
+#endif
+#endif
+
+/**
+ * @brief   Initialization timestamps source startup.
+ * @details The default implementation starts the DWT cycle counter where
+ *          one is available.
+ */
+#if !defined(HAL_INIT_TIMESTAMP_INIT) || defined(__DOXYGEN__)
+#if defined(DWT) || defined(__DOXYGEN__)
+#define HAL_INIT_TIMESTAMP_INIT() do {                                      \
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                           \
+  DWT->CYCCNT      = 0U;                                                    \
+  DWT->CTRL       |= DWT_CTRL_CYCCNTENA_Msk;                                \
+} while (false)
+#else
+#define HAL_INIT_TIMESTAMP_INIT()
+#endif
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) &&                                   \
+    !defined(HAL_LLD_USE_CLOCK_MANAGEMENT)
+#error "HAL_USE_CLOCK_MANAGEMENT is not supported by the current port"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a clocks reconfiguration event.
+ */
+typedef enum {
+  HAL_CLOCKEVENT_PRE_SWITCH  = 0,   /**< Notified before the transition,
+                                         drivers quiesce ongoing
+                                         operations.                       */
+  HAL_CLOCKEVENT_POST_SWITCH = 1    /**< Notified after the transition,
+                                         drivers recompute their
+                                         dividers.                         */
+} halclockevent_t;
+
+/**
+ * @brief   Type of a clocks reconfiguration callback.
+ *
+ * @param[in] event     notified event
+ * @param[in] param     parameter specified at registration time
+ */
+typedef void (*halclockcb_t)(halclockevent_t event, void *param);
+
+/**
+ * @brief   Type of a clocks reconfiguration listener.
+ */
+typedef struct hal_clock_listener {
+  /**
+   * @brief   Next listener in the list.
+   */
+  struct hal_clock_listener *next;
+  /**
+   * @brief   Listener callback.
+   */
+  halclockcb_t              cb;
+  /**
+   * @brief   Parameter passed to the callback.
+   */
+  void                      *param;
+} hal_clock_listener_t;
+#endif /* HAL_USE_CLOCK_MANAGEMENT == TRUE */
+
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an initialization function.
+ */
+typedef void (*halinitfunc_t)(void);
+
+/**
+ * @brief   Type of a deferred initialization table entry.
+ * @details Tables are terminated by an entry with a @p NULL function
+ *          pointer.
+ */
+typedef struct {
+  /**
+   * @brief   Name shown in the initialization records.
+   */
+  const char                *name;
+  /**
+   * @brief   Function performing the initialization.
+   */
+  halinitfunc_t             func;
+} halinitentry_t;
+
+/**
+ * @brief   Type of an initialization record.
+ */
+typedef struct {
+  /**
+   * @brief   Name of the recorded phase or entry.
+   */
+  const char                *name;
+  /**
+   * @brief   Timestamp taken on phase entry.
+   */
+  uint32_t                  start;
+  /**
+   * @brief   Timestamp taken on phase exit.
+   */
+  uint32_t                  end;
+} halinitrecord_t;
+#endif /* HAL_USE_STAGED_INIT == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -237,6 +384,16 @@
 extern "C" {
 #endif
   void halInit(void);
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+  void halDeferredInit(const halinitentry_t *eip);
+  const halinitrecord_t *halGetInitRecords(unsigned *np);
+#endif
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+  void halAddClockListener(hal_clock_listener_t *hclp,
+                           halclockcb_t cb, void *param);
+  bool halClockSwitch(const halclkcfg_t *ccp);
+  uint32_t halClockGetPointX(halclkpt_t pt);
+#endif
 #ifdef __cplusplus
 }
 #endif
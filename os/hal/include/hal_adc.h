@@ -54,6 +54,35 @@
 #if !defined(ADC_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
 #define ADC_USE_MUTUAL_EXCLUSION    TRUE
 #endif
+
+/**
+ * @brief   Enables the in-driver decimation stage.
+ * @details Oversampled buffers are accumulated and shifted per channel
+ *          inside the buffer callbacks, the application callback then
+ *          receives decimated samples.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(ADC_USE_DECIMATION) || defined(__DOXYGEN__)
+#define ADC_USE_DECIMATION          FALSE
+#endif
+
+/**
+ * @brief   Enables the synchronized multi-driver start API.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(ADC_USE_SYNCHRONIZATION) || defined(__DOXYGEN__)
+#define ADC_USE_SYNCHRONIZATION     FALSE
+#endif
+
+/**
+ * @brief   Enables buffer timestamping.
+ * @details Each buffer event records the system time in the driver
+ *          structure before invoking the callback.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(ADC_USE_TIMESTAMP) || defined(__DOXYGEN__)
+#define ADC_USE_TIMESTAMP           FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -82,6 +111,27 @@ typedef enum {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @name    Macro Functions
+ * @{
+ */
+#if (ADC_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the timestamp of the latest buffer event.
+ * @details The returned time is the system time recorded when the buffer
+ *          associated to the last half/full buffer callback was completed
+ *          by the DMA.
+ * @note    The timestamp is only valid after the first buffer event.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @return              The buffer completion time.
+ *
+ * @xclass
+ */
+#define adcGetTimestampX(adcp) ((adcp)->timestamp)
+#endif /* ADC_USE_TIMESTAMP == TRUE */
+/** @} */
+
 /**
  * @name    Low level driver helper macros
  * @{
@@ -140,6 +190,53 @@ typedef enum {
 #define _adc_timeout_isr(adcp)
 #endif /* !ADC_USE_WAIT */
 
+/**
+ * @brief   Buffer event timestamping.
+ * @details When timestamping is enabled the current system time is stored
+ *          in the driver structure, it is retrievable using
+ *          @p adcGetTimestampX().
+ * @note    This macro is meant to be used in the ISR macros below only.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ *
+ * @notapi
+ */
+#if (ADC_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+#define _adc_timestamp(adcp) {                                              \
+  (adcp)->timestamp = osalOsGetSystemTimeX();                               \
+}
+#else /* ADC_USE_TIMESTAMP == FALSE */
+#define _adc_timestamp(adcp)
+#endif /* ADC_USE_TIMESTAMP == FALSE */
+
+/**
+ * @brief   End-of-buffer callback invocation.
+ * @details When the decimation stage is enabled and armed the buffer is
+ *          decimated and the callback receives the decimated samples,
+ *          else the callback receives the raw buffer.
+ * @note    This macro is meant to be used in the ISR macros below only.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] buffer    pointer to the first sample row of the buffer
+ * @param[in] n         number of sample rows in the buffer
+ *
+ * @notapi
+ */
+#if (ADC_USE_DECIMATION == TRUE) || defined(__DOXYGEN__)
+#define _adc_invoke_end_cb(adcp, buffer, n) {                               \
+  if ((adcp)->dshift > 0U) {                                                \
+    _adc_decimate(adcp, buffer, n);                                         \
+  }                                                                         \
+  else {                                                                    \
+    (adcp)->grpp->end_cb(adcp, buffer, n);                                  \
+  }                                                                         \
+}
+#else /* ADC_USE_DECIMATION == FALSE */
+#define _adc_invoke_end_cb(adcp, buffer, n) {                               \
+  (adcp)->grpp->end_cb(adcp, buffer, n);                                    \
+}
+#endif /* ADC_USE_DECIMATION == FALSE */
+
 /**
  * @brief   Common ISR code, half buffer event.
  * @details This code handles the portable part of the ISR code:
@@ -153,8 +250,9 @@ typedef enum {
  * @notapi
  */
 #define _adc_isr_half_code(adcp) {                                          \
+  _adc_timestamp(adcp);                                                     \
   if ((adcp)->grpp->end_cb != NULL) {                                       \
-    (adcp)->grpp->end_cb(adcp, (adcp)->samples, (adcp)->depth / 2);         \
+    _adc_invoke_end_cb(adcp, (adcp)->samples, (adcp)->depth / 2);           \
   }                                                                         \
 }
 
@@ -173,6 +271,7 @@ typedef enum {
  * @notapi
  */
 #define _adc_isr_full_code(adcp) {                                          \
+  _adc_timestamp(adcp);                                                     \
   if ((adcp)->grpp->circular) {                                             \
     /* Callback handling.*/                                                 \
     if ((adcp)->grpp->end_cb != NULL) {                                     \
@@ -180,11 +279,11 @@ typedef enum {
         /* Invokes the callback passing the 2nd half of the buffer.*/       \
         size_t half = (adcp)->depth / 2;                                    \
         size_t half_index = half * (adcp)->grpp->num_channels;              \
-        (adcp)->grpp->end_cb(adcp, (adcp)->samples + half_index, half);     \
+        _adc_invoke_end_cb(adcp, (adcp)->samples + half_index, half);       \
       }                                                                     \
       else {                                                                \
         /* Invokes the callback passing the whole buffer.*/                 \
-        (adcp)->grpp->end_cb(adcp, (adcp)->samples, (adcp)->depth);         \
+        _adc_invoke_end_cb(adcp, (adcp)->samples, (adcp)->depth);           \
       }                                                                     \
     }                                                                       \
   }                                                                         \
@@ -194,7 +293,7 @@ typedef enum {
     if ((adcp)->grpp->end_cb != NULL) {                                     \
       (adcp)->state = ADC_COMPLETE;                                         \
       /* Invoke the callback passing the whole buffer.*/                    \
-      (adcp)->grpp->end_cb(adcp, (adcp)->samples, (adcp)->depth);           \
+      _adc_invoke_end_cb(adcp, (adcp)->samples, (adcp)->depth);             \
       if ((adcp)->state == ADC_COMPLETE) {                                  \
         (adcp)->state = ADC_READY;                                          \
         (adcp)->grpp = NULL;                                                \
@@ -261,6 +360,22 @@ extern "C" {
                            size_t depth);
   void adcStopConversion(ADCDriver *adcp);
   void adcStopConversionI(ADCDriver *adcp);
+#if ADC_USE_DECIMATION == TRUE
+  void adcSetDecimation(ADCDriver *adcp, uint8_t dshift, adcsample_t *dbuf);
+  void _adc_decimate(ADCDriver *adcp, adcsample_t *buffer, size_t n);
+#endif
+#if ADC_USE_SYNCHRONIZATION == TRUE
+  void adcStartConversionSynchronized(ADCDriver * const adcps[],
+                                      const ADCConversionGroup * const grpps[],
+                                      adcsample_t * const samples[],
+                                      size_t depth,
+                                      size_t n);
+  void adcStartConversionSynchronizedI(ADCDriver * const adcps[],
+                                       const ADCConversionGroup * const grpps[],
+                                       adcsample_t * const samples[],
+                                       size_t depth,
+                                       size_t n);
+#endif
 #if ADC_USE_WAIT == TRUE
   msg_t adcConvert(ADCDriver *adcp,
                    const ADCConversionGroup *grpp,
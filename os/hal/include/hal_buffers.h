@@ -33,6 +33,30 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Enables cache maintenance at buffer hand-off boundaries.
+ * @details If enabled then the queues invalidate/flush the data cache
+ *          lines overlapping a buffer when it crosses the CPU/DMA
+ *          boundary: input buffers are invalidated when posted by the
+ *          driver and when released back for refilling, output buffers
+ *          are flushed when posted by the application.
+ * @note    This option requires the platform-provided
+ *          @p cacheBufferInvalidate() and @p cacheBufferFlush() macros.
+ * @note    The buffers memory must be aligned to @p BQ_CACHE_LINE_SIZE
+ *          and sized with the @p BQ_BUFFER_SIZE_ALIGNED() macro, else
+ *          data sharing cache lines with the buffers can be corrupted.
+ */
+#if !defined(BQ_USE_CACHE_MAINTENANCE) || defined(__DOXYGEN__)
+#define BQ_USE_CACHE_MAINTENANCE    FALSE
+#endif
+
+/**
+ * @brief   Data cache line size used by the alignment helpers.
+ */
+#if !defined(BQ_CACHE_LINE_SIZE) || defined(__DOXYGEN__)
+#define BQ_CACHE_LINE_SIZE          32U
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -138,6 +162,32 @@ typedef io_buffers_queue_t output_buffers_queue_t;
 #define BQ_BUFFER_SIZE(n, size)                                             \
   (((size_t)(size) + sizeof (size_t)) * (size_t)(n))
 
+/**
+ * @brief   Rounds a buffer size up for cache-friendly slots.
+ * @details The returned payload size is the smallest one making each queue
+ *          slot, the payload plus the leading size field, span an integer
+ *          number of cache lines so that no line is shared between two
+ *          buffers or with unrelated data.
+ *
+ * @param[in] size      required size of the buffers
+ */
+#define BQ_BUFFER_SIZE_ALIGN(size)                                          \
+  (((((size_t)(size) + sizeof (size_t)) +                                   \
+     ((size_t)BQ_CACHE_LINE_SIZE - 1U)) &                                   \
+    ~((size_t)BQ_CACHE_LINE_SIZE - 1U)) - sizeof (size_t))
+
+/**
+ * @brief   Computes the total size of a cache-aligned buffers queue memory.
+ * @note    The buffers memory itself must additionally be aligned to a
+ *          @p BQ_CACHE_LINE_SIZE boundary, for example using the compiler
+ *          alignment attribute.
+ *
+ * @param[in] n         number of buffers in the queue
+ * @param[in] size      required size of the buffers
+ */
+#define BQ_BUFFER_SIZE_ALIGNED(n, size)                                     \
+  BQ_BUFFER_SIZE((n), BQ_BUFFER_SIZE_ALIGN(size))
+
 /**
  * @name    Macro Functions
  * @{
@@ -283,10 +333,17 @@ extern "C" {
   void ibqResetI(input_buffers_queue_t *ibqp);
   uint8_t *ibqGetEmptyBufferI(input_buffers_queue_t *ibqp);
   void ibqPostFullBufferI(input_buffers_queue_t *ibqp, size_t size);
+  uint8_t *ibqGetFullBufferI(input_buffers_queue_t *ibqp,
+                             size_t *sizep);
+  void ibqReleaseEmptyBufferI(input_buffers_queue_t *ibqp);
   msg_t ibqGetFullBufferTimeout(input_buffers_queue_t *ibqp,
                                 sysinterval_t timeout);
   msg_t ibqGetFullBufferTimeoutS(input_buffers_queue_t *ibqp,
                                  sysinterval_t timeout);
+  msg_t ibqGetLatestFullBufferTimeout(input_buffers_queue_t *ibqp,
+                                      sysinterval_t timeout);
+  msg_t ibqGetLatestFullBufferTimeoutS(input_buffers_queue_t *ibqp,
+                                       sysinterval_t timeout);
   void ibqReleaseEmptyBuffer(input_buffers_queue_t *ibqp);
   void ibqReleaseEmptyBufferS(input_buffers_queue_t *ibqp);
   msg_t ibqGetTimeout(input_buffers_queue_t *ibqp, sysinterval_t timeout);
@@ -298,6 +355,8 @@ extern "C" {
   uint8_t *obqGetFullBufferI(output_buffers_queue_t *obqp,
                              size_t *sizep);
   void obqReleaseEmptyBufferI(output_buffers_queue_t *obqp);
+  uint8_t *obqGetEmptyBufferI(output_buffers_queue_t *obqp);
+  void obqPostFullBufferI(output_buffers_queue_t *obqp, size_t size);
   msg_t obqGetEmptyBufferTimeout(output_buffers_queue_t *obqp,
                                  sysinterval_t timeout);
   msg_t obqGetEmptyBufferTimeoutS(output_buffers_queue_t *obqp,
@@ -86,6 +86,31 @@
 #if !defined(CAN_ENFORCE_USE_CALLBACKS) || defined(__DOXYGEN__)
 #define CAN_ENFORCE_USE_CALLBACKS   FALSE
 #endif
+
+/**
+ * @brief   Enables the software TX priority queue.
+ * @details Frames posted with @p canTryTransmitI() when all hardware
+ *          mailboxes are full are stored in a queue sorted by arbitration
+ *          priority and fed to the hardware one at a time from the
+ *          TX-empty ISR, avoiding the priority inversion possible when
+ *          multiple occupied mailboxes are reloaded in submission order.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(CAN_USE_TX_QUEUE) || defined(__DOXYGEN__)
+#define CAN_USE_TX_QUEUE            FALSE
+#endif
+
+/**
+ * @brief   Enables the error monitor and the bus-off recovery engine.
+ * @details Bus error events are accounted in a per-driver set of
+ *          counters and, when enabled with @p canEnableAutoRecovery(),
+ *          the bus-off state is exited autonomously without application
+ *          intervention.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(CAN_USE_ERROR_MONITOR) || defined(__DOXYGEN__)
+#define CAN_USE_ERROR_MONITOR       FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -107,8 +132,72 @@ typedef enum {
   CAN_SLEEP = 4                             /**< Sleep state.               */
 } canstate_t;
 
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a software TX queue slot.
+ */
+typedef struct can_tx_slot can_tx_slot_t;
+#endif
+
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of the CAN error statistics.
+ * @details All the counters are incremented from the ISR context, a
+ *          coherent snapshot can be fetched, and the counters cleared,
+ *          using @p canGetAndClearStats().
+ */
+typedef struct {
+  /**
+   * @brief   Frames with form, stuff, CRC or acknowledge errors.
+   */
+  uint32_t                  error_frames;
+  /**
+   * @brief   Transmissions which lost the bus arbitration.
+   */
+  uint32_t                  arb_losses;
+  /**
+   * @brief   Receive queue overruns.
+   */
+  uint32_t                  overruns;
+  /**
+   * @brief   Transitions into the error-warning state.
+   */
+  uint32_t                  warnings;
+  /**
+   * @brief   Transitions into the error-passive state.
+   */
+  uint32_t                  passives;
+  /**
+   * @brief   Transitions into the bus-off state.
+   */
+  uint32_t                  bus_offs;
+  /**
+   * @brief   Automatic bus-off recoveries performed.
+   */
+  uint32_t                  recoveries;
+} can_stats_t;
+#endif
+
 #include "hal_can_lld.h"
 
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Software TX queue slot structure.
+ * @details The slots are provided by the application using
+ *          @p canSetTxQueue() and are owned by the driver afterward.
+ */
+struct can_tx_slot {
+  /**
+   * @brief   Queued frame.
+   */
+  CANTxFrame                frame;
+  /**
+   * @brief   Next slot in the free or transmit list.
+   */
+  can_tx_slot_t             *next;
+};
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -122,6 +211,40 @@ typedef enum {
  */
 #define CAN_MAILBOX_TO_MASK(mbx) (1U << ((mbx) - 1U))
 
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Arbitration ordering key of a TX frame.
+ * @details Standard identifiers are aligned to the most significant bits
+ *          of the 29-bit identifier space so that the key ordering
+ *          approximates the on-wire arbitration, lower keys win.
+ */
+#define CAN_TX_FRAME_KEY(ctfp)                                              \
+  (((ctfp)->IDE != 0U) ? (uint32_t)(ctfp)->EID                              \
+                       : ((uint32_t)(ctfp)->SID << 18U))
+#endif
+
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Samples the transmit error counter (TEC).
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @return              The transmit error counter value.
+ *
+ * @xclass
+ */
+#define canGetTransmitErrorsX(canp) can_lld_get_transmit_errors(canp)
+
+/**
+ * @brief   Samples the receive error counter (REC).
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @return              The receive error counter value.
+ *
+ * @xclass
+ */
+#define canGetReceiveErrorsX(canp) can_lld_get_receive_errors(canp)
+#endif
+
 /**
  * @brief   Legacy name for @p canTransmitTimeout().
  *
@@ -143,12 +266,76 @@ typedef enum {
  * @name    Low level driver helper macros
  * @{
  */
+/**
+ * @brief   Software TX queue feed.
+ * @details When the software TX queue is enabled the highest priority
+ *          queued frame, if any, is moved into the freed hardware
+ *          mailbox.
+ * @note    This macro is meant to be used in the TX-empty ISR macros
+ *          below only, within the system critical zone.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+#define _can_txq_feed_code(canp) {                                          \
+  _can_txq_feed(canp);                                                      \
+}
+#else /* CAN_USE_TX_QUEUE == FALSE */
+#define _can_txq_feed_code(canp)
+#endif /* CAN_USE_TX_QUEUE == FALSE */
+
+/**
+ * @brief   Error monitor feed.
+ * @details When the error monitor is enabled the error flags are
+ *          accounted and the bus-off recovery engine is advanced.
+ * @note    This macro is meant to be used in the error ISR macros below
+ *          only, within the system critical zone. The ISR variant takes
+ *          the critical zone by itself.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] flags     error flags
+ *
+ * @notapi
+ */
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+#define _can_monitor_code(canp, flags) {                                    \
+  _can_monitor_error(canp, flags);                                          \
+}
+
+#define _can_monitor_isr_code(canp, flags) {                                \
+  osalSysLockFromISR();                                                     \
+  _can_monitor_error(canp, flags);                                          \
+  osalSysUnlockFromISR();                                                   \
+}
+#else /* CAN_USE_ERROR_MONITOR == FALSE */
+#define _can_monitor_code(canp, flags)
+#define _can_monitor_isr_code(canp, flags)
+#endif /* CAN_USE_ERROR_MONITOR == FALSE */
+
+/**
+ * @brief   Arbitration loss accounting.
+ * @note    This macro is meant to be used in the low level TX ISR
+ *          handlers, one invocation per lost arbitration.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+#define _can_monitor_arb_lost(canp) ((canp)->stats.arb_losses++)
+#else
+#define _can_monitor_arb_lost(canp)
+#endif
+
 #if (CAN_ENFORCE_USE_CALLBACKS == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   TX mailbox empty event.
  */
 #define _can_tx_empty_isr(canp, flags) {                                    \
   osalSysLockFromISR();                                                     \
+  _can_txq_feed_code(canp);                                                 \
   osalThreadDequeueAllI(&(canp)->txqueue, MSG_OK);                          \
   osalEventBroadcastFlagsI(&(canp)->txempty_event, flags);                  \
   osalSysUnlockFromISR();                                                   \
@@ -178,6 +365,7 @@ typedef enum {
  */
 #define _can_error_isr(canp, flags) {                                       \
   osalSysLockFromISR();                                                     \
+  _can_monitor_code(canp, flags);                                           \
   osalEventBroadcastFlagsI(&(canp)->error_event, flags);                    \
   osalSysUnlockFromISR();                                                   \
 }
@@ -187,6 +375,7 @@ typedef enum {
     (canp)->txempty_cb(canp, flags);                                        \
   }                                                                         \
   osalSysLockFromISR();                                                     \
+  _can_txq_feed_code(canp);                                                 \
   osalThreadDequeueAllI(&(canp)->txqueue, MSG_OK);                          \
   osalSysUnlockFromISR();                                                   \
 }
@@ -210,6 +399,7 @@ typedef enum {
   if ((canp)->error_cb != NULL) {                                           \
     (canp)->error_cb(canp, flags);                                          \
   }                                                                         \
+  _can_monitor_isr_code(canp, flags);                                       \
 }
 #endif /* CAN_ENFORCE_USE_CALLBACKS == TRUE */
 /** @} */
@@ -231,6 +421,17 @@ extern "C" {
   bool canTryReceiveI(CANDriver *canp,
                       canmbx_t mailbox,
                       CANRxFrame *crfp);
+#if CAN_USE_TX_QUEUE == TRUE
+  void canSetTxQueue(CANDriver *canp, can_tx_slot_t slots[], size_t n);
+  void _can_txq_feed(CANDriver *canp);
+#endif
+#if CAN_USE_ERROR_MONITOR == TRUE
+  void canEnableAutoRecovery(CANDriver *canp, uint32_t limit,
+                             sysinterval_t window);
+  void canDisableAutoRecovery(CANDriver *canp);
+  void canGetAndClearStats(CANDriver *canp, can_stats_t *csp);
+  void _can_monitor_error(CANDriver *canp, eventflags_t flags);
+#endif
   msg_t canTransmitTimeout(CANDriver *canp,
                            canmbx_t mailbox,
                            const CANTxFrame *ctfp,
@@ -241,11 +241,59 @@ typedef struct {
 #define CHN_TRANSMISSION_END    (eventflags_t)16
 /** @} */
 
+/**
+ * @brief   Type of an asynchronous transfer descriptor.
+ */
+typedef struct chn_async_descriptor chn_async_descriptor_t;
+
+/**
+ * @brief   Asynchronous transfer completion callback type.
+ * @note    The callback is invoked from ISR or locked context, it must
+ *          only perform I-class operations.
+ *
+ * @param[in] instance  pointer to the channel that completed the transfer
+ * @param[in] adp       pointer to the completed transfer descriptor
+ */
+typedef void (*chnasync_cb_t)(void *instance, chn_async_descriptor_t *adp);
+
+/**
+ * @brief   Asynchronous transfer descriptor.
+ * @details The descriptor must remain accessible and unchanged for the
+ *          whole duration of the transfer, its completion is notified
+ *          through the @p callback field.
+ */
+struct chn_async_descriptor {
+  /**
+   * @brief   Pointer to the data buffer.
+   */
+  uint8_t               *buffer;
+  /**
+   * @brief   Requested transfer size.
+   */
+  size_t                size;
+  /**
+   * @brief   Number of bytes transferred so far.
+   */
+  size_t                offset;
+  /**
+   * @brief   Completion callback, cannot be @p NULL.
+   */
+  chnasync_cb_t         callback;
+  /**
+   * @brief   Application defined field.
+   */
+  void                  *link;
+};
+
 /**
  * @brief   @p BaseAsynchronousChannel specific methods.
  */
 #define _base_asynchronous_channel_methods                                  \
   _base_channel_methods                                                     \
+  /* Channel asynchronous read start method.*/                              \
+  msg_t (*startread)(void *instance, chn_async_descriptor_t *adp);          \
+  /* Channel asynchronous write start method.*/                             \
+  msg_t (*startwrite)(void *instance, chn_async_descriptor_t *adp);
 
 /**
  * @brief   @p BaseAsynchronousChannel specific data.
@@ -253,7 +301,11 @@ typedef struct {
 #define _base_asynchronous_channel_data                                     \
   _base_channel_data                                                        \
   /* I/O condition event source.*/                                          \
-  event_source_t        event;
+  event_source_t        event;                                              \
+  /* Active asynchronous read descriptor or @p NULL.*/                      \
+  chn_async_descriptor_t *rxasync;                                          \
+  /* Active asynchronous write descriptor or @p NULL.*/                     \
+  chn_async_descriptor_t *txasync;
 
 /**
  * @extends BaseChannelVMT
@@ -308,6 +360,53 @@ typedef struct {
 #define chnAddFlagsI(ip, flags) {                                           \
   osalEventBroadcastFlagsI(&(ip)->event, flags);                            \
 }
+
+/**
+ * @brief   Starts an asynchronous read on the channel.
+ * @details The function returns immediately, the descriptor callback is
+ *          invoked, from ISR or locked context, when @p size bytes have
+ *          been received. If enough data is already buffered then the
+ *          callback can be invoked before this function returns.
+ * @note    Only one asynchronous read can be active at a time on a channel,
+ *          mixing asynchronous and blocking read operations on the same
+ *          channel is not allowed.
+ *
+ * @param[in] ip        pointer to a @p BaseAsynchronousChannel or derived
+ *                      class
+ * @param[in] adp       pointer to a @p chn_async_descriptor_t with the
+ *                      @p buffer, @p size and @p callback fields filled,
+ *                      the @p offset field is reset by this function
+ * @return              The operation status.
+ * @retval MSG_OK       if the transfer has been started or completed.
+ * @retval MSG_RESET    if the channel is not in the ready state.
+ *
+ * @api
+ */
+#define chnStartReadAsync(ip, adp) ((ip)->vmt->startread(ip, adp))
+
+/**
+ * @brief   Starts an asynchronous write on the channel.
+ * @details The function returns immediately, the descriptor callback is
+ *          invoked, from ISR or locked context, when @p size bytes have
+ *          been delivered to the driver. If enough buffer space is
+ *          available then the callback can be invoked before this function
+ *          returns.
+ * @note    Only one asynchronous write can be active at a time on a
+ *          channel, mixing asynchronous and blocking write operations on
+ *          the same channel is not allowed.
+ *
+ * @param[in] ip        pointer to a @p BaseAsynchronousChannel or derived
+ *                      class
+ * @param[in] adp       pointer to a @p chn_async_descriptor_t with the
+ *                      @p buffer, @p size and @p callback fields filled,
+ *                      the @p offset field is reset by this function
+ * @return              The operation status.
+ * @retval MSG_OK       if the transfer has been started or completed.
+ * @retval MSG_RESET    if the channel is not in the ready state.
+ *
+ * @api
+ */
+#define chnStartWriteAsync(ip, adp) ((ip)->vmt->startwrite(ip, adp))
 /** @} */
 
 #endif /* HAL_CHANNELS_H */
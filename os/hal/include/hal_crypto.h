@@ -109,6 +109,27 @@ typedef enum {
   cry_algo_des                              /**< DES 56, TDES 112, 168 bits.*/
 } cryalgorithm_t;
 
+/**
+ * @brief   Type of a scatter/gather segment descriptor.
+ * @details An array of segments describes a message stored in non-contiguous
+ *          buffers, such as chained network buffers. In-place operation is
+ *          possible by making @p out point to the same buffer as @p in.
+ */
+typedef struct {
+  /**
+   * @brief   Input buffer of the segment.
+   */
+  const uint8_t             *in;
+  /**
+   * @brief   Output buffer of the segment.
+   */
+  uint8_t                   *out;
+  /**
+   * @brief   Size of the segment in bytes, it must be a multiple of 16.
+   */
+  size_t                    size;
+} cry_sge_t;
+
 #if HAL_CRY_ENFORCE_FALLBACK == FALSE
 /* Use the defined low level driver.*/
 #include "hal_crypto_lld.h"
@@ -271,6 +292,26 @@ extern "C" {
                                const uint8_t *in,
                                uint8_t *out,
                                const uint8_t *iv);
+  cryerror_t cryEncryptAES_CBC_SG(CRYDriver *cryp,
+                                  crykey_t key_id,
+                                  size_t n,
+                                  const cry_sge_t *sges,
+                                  const uint8_t *iv);
+  cryerror_t cryDecryptAES_CBC_SG(CRYDriver *cryp,
+                                  crykey_t key_id,
+                                  size_t n,
+                                  const cry_sge_t *sges,
+                                  const uint8_t *iv);
+  cryerror_t cryEncryptAES_CTR_SG(CRYDriver *cryp,
+                                  crykey_t key_id,
+                                  size_t n,
+                                  const cry_sge_t *sges,
+                                  const uint8_t *iv);
+  cryerror_t cryDecryptAES_CTR_SG(CRYDriver *cryp,
+                                  crykey_t key_id,
+                                  size_t n,
+                                  const cry_sge_t *sges,
+                                  const uint8_t *iv);
   cryerror_t cryEncryptAES_GCM(CRYDriver *cryp,
                                crykey_t key_id,
                                size_t size,
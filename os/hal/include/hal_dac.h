@@ -54,6 +54,17 @@
 #if !defined(DAC_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
 #define DAC_USE_MUTUAL_EXCLUSION    TRUE
 #endif
+
+/**
+ * @brief   Enables the streaming APIs.
+ * @details If enabled then the circular conversion buffer can be fed
+ *          gaplessly from a chain of application buffers with automatic
+ *          idle pattern insertion on underrun.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(DAC_USE_STREAMING) || defined(__DOXYGEN__)
+#define DAC_USE_STREAMING           FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -82,6 +93,24 @@ typedef enum {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @name    Macro Functions
+ * @{
+ */
+/**
+ * @brief   Returns the streaming underrun events counter.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @return              The number of underrun events since the streaming
+ *                      operation started.
+ *
+ * @xclass
+ */
+#define dacStreamGetUnderrunsX(dacp) ((dacp)->sb_underruns)
+/** @} */
+#endif /* DAC_USE_STREAMING == TRUE */
+
 /**
  * @name    Low level driver helper macros
  * @{
@@ -165,11 +194,22 @@ typedef enum {
  *
  * @notapi
  */
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+#define _dac_isr_half_code(dacp) {                                          \
+  if ((dacp)->sb_active) {                                                  \
+    _dac_stream_refill(dacp, (dacp)->samples, (dacp)->depth / 2);           \
+  }                                                                         \
+  else if ((dacp)->grpp->end_cb != NULL) {                                  \
+    (dacp)->grpp->end_cb(dacp, (dacp)->samples, (dacp)->depth / 2);         \
+  }                                                                         \
+}
+#else /* DAC_USE_STREAMING == FALSE */
 #define _dac_isr_half_code(dacp) {                                          \
   if ((dacp)->grpp->end_cb != NULL) {                                       \
     (dacp)->grpp->end_cb(dacp, (dacp)->samples, (dacp)->depth / 2);         \
   }                                                                         \
 }
+#endif /* DAC_USE_STREAMING == FALSE */
 
 /**
  * @brief   Common ISR code, full buffer event.
@@ -185,6 +225,27 @@ typedef enum {
  *
  * @notapi
  */
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+#define _dac_isr_full_code(dacp) {                                          \
+  if ((dacp)->sb_active) {                                                  \
+    size_t half = (dacp)->depth / 2;                                        \
+    size_t half_index = half * (dacp)->grpp->num_channels;                  \
+    _dac_stream_refill(dacp, (dacp)->samples + half_index, half);           \
+  }                                                                         \
+  else if ((dacp)->grpp->end_cb != NULL) {                                  \
+    if ((dacp)->depth > 1) {                                                \
+      /* Invokes the callback passing the 2nd half of the buffer.*/         \
+      size_t half = (dacp)->depth / 2;                                      \
+      size_t half_index = half * (dacp)->grpp->num_channels;                \
+      (dacp)->grpp->end_cb(dacp, (dacp)->samples + half_index, half);       \
+    }                                                                       \
+    else {                                                                  \
+      /* Invokes the callback passing the whole buffer.*/                   \
+      (dacp)->grpp->end_cb(dacp, (dacp)->samples, (dacp)->depth);           \
+    }                                                                       \
+  }                                                                         \
+}
+#else /* DAC_USE_STREAMING == FALSE */
 #define _dac_isr_full_code(dacp) {                                          \
   if ((dacp)->grpp->end_cb != NULL) {                                       \
     if ((dacp)->depth > 1) {                                                \
@@ -199,6 +260,7 @@ typedef enum {
     }                                                                       \
   }                                                                         \
 }
+#endif /* DAC_USE_STREAMING == FALSE */
 
 /**
  * @brief   Common ISR code, error event.
@@ -215,8 +277,15 @@ typedef enum {
  *
  * @notapi
  */
+#if DAC_USE_STREAMING == TRUE
+#define _dac_stream_deactivate(dacp) ((dacp)->sb_active = false)
+#else
+#define _dac_stream_deactivate(dacp)
+#endif
+
 #define _dac_isr_error_code(dacp, err) {                                    \
   dac_lld_stop_conversion(dacp);                                            \
+  _dac_stream_deactivate(dacp);                                             \
   if ((dacp)->grpp->error_cb != NULL) {                                     \
     (dacp)->state = DAC_ERROR;                                              \
     (dacp)->grpp->error_cb(dacp, err);                                      \
@@ -252,6 +321,19 @@ extern "C" {
   msg_t dacConvert(DACDriver *dacp, const DACConversionGroup *grpp,
                    dacsample_t *samples, size_t depth);
 #endif
+#if DAC_USE_STREAMING
+  void dacStartStreaming(DACDriver *dacp, const DACConversionGroup *grpp,
+                         dacsample_t *samples, size_t depth,
+                         dacsample_t idle,
+                         dacstreamcallback_t scb, dacstreamcallback_t ucb);
+  void dacStartStreamingI(DACDriver *dacp, const DACConversionGroup *grpp,
+                          dacsample_t *samples, size_t depth,
+                          dacsample_t idle,
+                          dacstreamcallback_t scb, dacstreamcallback_t ucb);
+  void dacStreamPost(DACDriver *dacp, dacstreambuf_t *sbp);
+  void dacStreamPostI(DACDriver *dacp, dacstreambuf_t *sbp);
+  void _dac_stream_refill(DACDriver *dacp, dacsample_t *buffer, size_t n);
+#endif
 #if DAC_USE_MUTUAL_EXCLUSION
   void dacAcquireBus(DACDriver *dacp);
   void dacReleaseBus(DACDriver *dacp);
@@ -35,6 +35,24 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    GPT configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the 64-bit counter extension.
+ * @details In continuous mode each overflow event is accumulated in the
+ *          driver structure, @p gptGetCounter64X() composes the
+ *          accumulator with the hardware counter into a monotonic 64-bit
+ *          timestamp, a cheap high resolution time source for tracing
+ *          and sensor timestamping.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(GPT_USE_COUNTER64) || defined(__DOXYGEN__)
+#define GPT_USE_COUNTER64           FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -111,6 +129,25 @@ typedef void (*gptcallback_t)(GPTDriver *gptp);
  */
 #define gptGetCounterX(gptp) gpt_lld_get_counter(gptp)
 
+/**
+ * @brief   Counter overflow accounting.
+ * @details When the 64-bit counter extension is enabled the overflow
+ *          accumulator in the driver structure is advanced.
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only, in the update event ISR.
+ *
+ * @param[in] gptp      pointer to a @p GPTDriver object
+ *
+ * @notapi
+ */
+#if (GPT_USE_COUNTER64 == TRUE) || defined(__DOXYGEN__)
+#define _gpt_isr_wrap_code(gptp) {                                          \
+  (gptp)->wraps++;                                                          \
+}
+#else /* GPT_USE_COUNTER64 == FALSE */
+#define _gpt_isr_wrap_code(gptp)
+#endif /* GPT_USE_COUNTER64 == FALSE */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -134,6 +171,44 @@ extern "C" {
 }
 #endif
 
+/*===========================================================================*/
+/* Driver inline functions.                                                  */
+/*===========================================================================*/
+
+#if (GPT_USE_COUNTER64 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the 64-bit extended counter value.
+ * @details The overflow accumulator and the hardware counter are composed
+ *          into a monotonic 64-bit tick count using a lock-free double
+ *          read, no critical zone is required.
+ * @pre     The GPT unit must be running in continuous mode and the
+ *          underlying counter must count upward from zero to the
+ *          programmed interval.
+ * @note    The calling context must not delay the timer update interrupt
+ *          for a whole timer period else overflows can be lost and the
+ *          returned value can move backward.
+ *
+ * @param[in] gptp      pointer to a @p GPTDriver object
+ * @return              The extended counter value in timer ticks.
+ *
+ * @xclass
+ */
+static inline uint64_t gptGetCounter64X(GPTDriver *gptp) {
+  uint32_t w;
+  gptcnt_t cnt;
+
+  /* Retrying until the overflow accumulator is stable across the counter
+     read.*/
+  do {
+    w   = gptp->wraps;
+    cnt = gptGetCounterX(gptp);
+  } while (w != gptp->wraps);
+
+  return ((uint64_t)w * ((uint64_t)gptGetIntervalX(gptp) + 1ULL)) +
+         (uint64_t)cnt;
+}
+#endif /* GPT_USE_COUNTER64 == TRUE */
+
 #endif /* HAL_USE_GPT == TRUE */
 
 #endif /* HAL_GPT_H */
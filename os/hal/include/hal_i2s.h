@@ -43,6 +43,23 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    I2S configuration options
+ * @{
+ */
+/**
+ * @brief   Enables buffer timestamping.
+ * @details Each buffer event records the system time in the driver
+ *          structure before invoking the callback, allowing the
+ *          application to estimate the effective codec rate for drift
+ *          compensation, for example feeding an asynchronous resampler.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(I2S_USE_TIMESTAMP) || defined(__DOXYGEN__)
+#define I2S_USE_TIMESTAMP           FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -98,6 +115,42 @@ typedef enum {
   (i2sp)->state = I2S_READY;                                                \
 }
 
+#if (I2S_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the timestamp of the latest buffer event.
+ * @details The returned time is the system time recorded when the buffer
+ *          half associated to the last callback was completed by the DMA.
+ *          Reading it from the callback and correlating it with a
+ *          reference clock allows to measure the effective codec rate.
+ * @note    The timestamp is only valid after the first buffer event.
+ *
+ * @param[in] i2sp      pointer to the @p I2SDriver object
+ * @return              The buffer completion time.
+ *
+ * @xclass
+ */
+#define i2sGetTimestampX(i2sp) ((i2sp)->timestamp)
+#endif /* I2S_USE_TIMESTAMP == TRUE */
+
+/**
+ * @brief   Buffer event timestamping.
+ * @details When timestamping is enabled the current system time is stored
+ *          in the driver structure, it is retrievable using
+ *          @p i2sGetTimestampX().
+ * @note    This macro is meant to be used in the ISR macros below only.
+ *
+ * @param[in] i2sp      pointer to the @p I2SDriver object
+ *
+ * @notapi
+ */
+#if (I2S_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+#define _i2s_timestamp(i2sp) {                                              \
+  (i2sp)->timestamp = osalOsGetSystemTimeX();                               \
+}
+#else /* I2S_USE_TIMESTAMP == FALSE */
+#define _i2s_timestamp(i2sp)
+#endif /* I2S_USE_TIMESTAMP == FALSE */
+
 /**
  * @brief   Common ISR code, half buffer event.
  * @details This code handles the portable part of the ISR code:
@@ -111,6 +164,7 @@ typedef enum {
  * @notapi
  */
 #define _i2s_isr_half_code(i2sp) {                                          \
+  _i2s_timestamp(i2sp);                                                     \
   if ((i2sp)->config->end_cb != NULL) {                                     \
     (i2sp)->config->end_cb(i2sp, 0, (i2sp)->config->size / 2);              \
   }                                                                         \
@@ -129,7 +183,8 @@ typedef enum {
  *
  * @notapi
  */
-#define _i2s_isr_full_code(i2sp) {                                               \
+#define _i2s_isr_full_code(i2sp) {                                          \
+  _i2s_timestamp(i2sp);                                                     \
   if ((i2sp)->config->end_cb) {                                             \
     (i2sp)->state = I2S_COMPLETE;                                           \
     (i2sp)->config->end_cb(i2sp,                                            \
@@ -35,6 +35,22 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    ICU configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the buffered capture APIs.
+ * @details If enabled then the captured values can be transferred by the
+ *          low level driver into a memory ring with one notification per
+ *          half ring instead of one callback per capture.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(ICU_USE_BUFFERED_CAPTURE) || defined(__DOXYGEN__)
+#define ICU_USE_BUFFERED_CAPTURE    FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -229,6 +245,11 @@ extern "C" {
   void icuStopCapture(ICUDriver *icup);
   void icuEnableNotifications(ICUDriver *icup);
   void icuDisableNotifications(ICUDriver *icup);
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  void icuStartBufferedCapture(ICUDriver *icup, icucnt_t *buffer,
+                               size_t depth, icubufcallback_t cb);
+  void icuStopBufferedCapture(ICUDriver *icup);
+#endif
 #ifdef __cplusplus
 }
 #endif
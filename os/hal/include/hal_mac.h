@@ -51,6 +51,43 @@
 #if !defined(MAC_USE_EVENTS) || defined(__DOXYGEN__)
 #define MAC_USE_EVENTS              TRUE
 #endif
+
+/**
+ * @brief   Enables the RX interrupts mitigation.
+ * @details When enabled the receive interrupt is masked by the ISR on the
+ *          first frame of a burst and re-enabled by
+ *          @p macWaitReceiveDescriptor() only after the receive ring has
+ *          been found empty, the whole burst is then served with a single
+ *          wakeup of the reader thread.
+ * @note    This option is only usable on those low level drivers setting
+ *          the @p MAC_SUPPORTS_RX_MITIGATION switch.
+ */
+#if !defined(MAC_USE_RX_MITIGATION) || defined(__DOXYGEN__)
+#define MAC_USE_RX_MITIGATION       FALSE
+#endif
+
+/**
+ * @brief   Enables the scatter-gather transmit API.
+ * @details Frames composed of multiple non-contiguous segments are
+ *          transmitted by chaining descriptors pointing into the segments
+ *          in place, without assembling the frame into a single buffer.
+ * @note    This option is only usable on those low level drivers setting
+ *          the @p MAC_SUPPORTS_TX_GATHER switch.
+ */
+#if !defined(MAC_USE_TX_GATHER) || defined(__DOXYGEN__)
+#define MAC_USE_TX_GATHER           FALSE
+#endif
+
+/**
+ * @brief   Enables the statistics counters.
+ * @details A set of global counters is maintained by the driver and by the
+ *          network bindings: dropped frames, pool exhaustion, descriptor
+ *          shortage and interrupt coalescing figures can be sampled at
+ *          runtime through @p macGetStats() without a debugger attached.
+ */
+#if !defined(MAC_USE_STATS) || defined(__DOXYGEN__)
+#define MAC_USE_STATS               FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -75,6 +112,63 @@ typedef enum {
  */
 typedef struct MACDriver MACDriver;
 
+/**
+ * @brief   Type of a transmit frame segment.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the segment data.
+   */
+  const uint8_t             *data;
+  /**
+   * @brief   Segment size in bytes.
+   */
+  size_t                    size;
+} macsegment_t;
+
+#if (MAC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of the MAC statistics counters.
+ * @note    The counters are updated without atomicity guarantees, each one
+ *          has a single writer thread, @p macGetStats() takes a consistent
+ *          snapshot.
+ */
+typedef struct {
+  /**
+   * @brief   Frames delivered to the upper layer.
+   */
+  uint32_t                  rx_frames;
+  /**
+   * @brief   Reader thread wakeups, each one drains a batch of frames.
+   */
+  uint32_t                  rx_wakeups;
+  /**
+   * @brief   Largest number of frames drained in a single wakeup.
+   */
+  uint32_t                  rx_batch_max;
+  /**
+   * @brief   Received frames dropped by the upper layer.
+   */
+  uint32_t                  rx_overruns;
+  /**
+   * @brief   Buffer or wrapper pool allocation failures on receive.
+   */
+  uint32_t                  rx_pool_exhausted;
+  /**
+   * @brief   Frames queued for transmission.
+   */
+  uint32_t                  tx_frames;
+  /**
+   * @brief   Waits caused by no transmit descriptor being available.
+   */
+  uint32_t                  tx_desc_unavail;
+  /**
+   * @brief   Transmit hand-off ring full events.
+   */
+  uint32_t                  tx_ring_full;
+} mac_stats_t;
+#endif /* MAC_USE_STATS */
+
 #include "hal_mac_lld.h"
 
 /*===========================================================================*/
@@ -168,12 +262,49 @@ typedef struct MACDriver MACDriver;
 #define macGetNextReceiveBuffer(rdp, sizep)                                 \
   mac_lld_get_next_receive_buffer(rdp, sizep)
 #endif /* MAC_USE_ZERO_COPY */
+
+#if (MAC_USE_TX_GATHER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Evaluates whether a gather frame has been transmitted.
+ * @details The frame segments must remain valid and unmodified until this
+ *          macro evaluates to true.
+ *
+ * @param[in] tdp       pointer to the @p MACTransmitDescriptor structure
+ *                      returned by @p macWaitTransmitGather()
+ * @return              The frame status.
+ * @retval true         if the frame has been fully transmitted.
+ * @retval false        if the frame is still owned by the DMA.
+ *
+ * @api
+ */
+#define macIsFrameTransmitted(tdp)                                          \
+  mac_lld_is_frame_transmitted(tdp)
+#endif /* MAC_USE_TX_GATHER */
+
+/**
+ * @brief   Increments one of the statistics counters.
+ * @details The macro expands to nothing when @p MAC_USE_STATS is disabled
+ *          so it can be used unconditionally at the instrumentation points.
+ *
+ * @param[in] field     name of a @p mac_stats_t field
+ *
+ * @api
+ */
+#if (MAC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+#define macStatsIncrement(field)    (mac_stats.field)++
+#else
+#define macStatsIncrement(field)
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (MAC_USE_STATS == TRUE) && !defined(__DOXYGEN__)
+extern mac_stats_t mac_stats;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -186,11 +317,22 @@ extern "C" {
                                   MACTransmitDescriptor *tdp,
                                   sysinterval_t timeout);
   void macReleaseTransmitDescriptor(MACTransmitDescriptor *tdp);
+#if MAC_USE_TX_GATHER == TRUE
+  msg_t macWaitTransmitGather(MACDriver *macp,
+                              MACTransmitDescriptor *tdp,
+                              const macsegment_t segs[],
+                              size_t n,
+                              sysinterval_t timeout);
+#endif
   msg_t macWaitReceiveDescriptor(MACDriver *macp,
                                  MACReceiveDescriptor *rdp,
                                  sysinterval_t timeout);
   void macReleaseReceiveDescriptor(MACReceiveDescriptor *rdp);
   bool macPollLinkStatus(MACDriver *macp);
+#if MAC_USE_STATS == TRUE
+  void macGetStats(mac_stats_t *msp);
+  void macResetStats(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
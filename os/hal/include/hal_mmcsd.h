@@ -419,6 +419,45 @@ typedef struct {
   uint8_t   crc;
 } unpacked_mmc_csd_t;
 
+/**
+ * @brief   Type of the state of a sequential stream.
+ */
+typedef enum {
+  MMCSD_STREAM_IDLE = 0,
+  MMCSD_STREAM_READING = 1,
+  MMCSD_STREAM_WRITING = 2
+} mmcsd_stream_state_t;
+
+/**
+ * @brief   Type of a sequential stream over a block device.
+ * @details The stream maintains a block cursor and a one-block staging
+ *          buffer so that data can be pulled or pushed in chunks of
+ *          arbitrary size, block spanning and multi-block continuation
+ *          are handled internally.
+ */
+typedef struct {
+  /**
+   * @brief   Stream state.
+   */
+  mmcsd_stream_state_t      state;
+  /**
+   * @brief   Block device backing the stream.
+   */
+  BaseBlockDevice           *blkp;
+  /**
+   * @brief   Next block to be transferred.
+   */
+  uint32_t                  startblk;
+  /**
+   * @brief   Number of staged bytes, zero if the staging buffer is empty.
+   */
+  uint32_t                  offset;
+  /**
+   * @brief   Staging buffer for partial blocks.
+   */
+  uint8_t                   buffer[MMCSD_BLOCK_SIZE];
+} MMCSDStream;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -487,6 +526,12 @@ extern "C" {
                              unpacked_sdc_csd_10_t *csd10);
   void _mmcsd_unpack_csd_v20(const MMCSDBlockDevice *sdcp,
                              unpacked_sdc_csd_20_t *csd20);
+  void mmcsdStreamObjectInit(MMCSDStream *msp, BaseBlockDevice *blkp);
+  bool mmcsdStreamOpenRead(MMCSDStream *msp, uint32_t startblk);
+  bool mmcsdStreamOpenWrite(MMCSDStream *msp, uint32_t startblk);
+  bool mmcsdStreamRead(MMCSDStream *msp, uint8_t *buf, size_t n);
+  bool mmcsdStreamWrite(MMCSDStream *msp, const uint8_t *buf, size_t n);
+  bool mmcsdStreamClose(MMCSDStream *msp);
 #ifdef __cplusplus
 }
 #endif
@@ -132,12 +132,67 @@
 #if !defined(PAL_USE_WAIT) || defined(__DOXYGEN__)
 #define PAL_USE_WAIT                TRUE
 #endif
+
+/**
+ * @brief   Enables event timestamping.
+ * @details When enabled a timestamp is captured on entry in the event
+ *          dispatch code, before the callback is invoked, and stored in
+ *          the event record where it can be retrieved using
+ *          @p palGetPadEventTimestampX() or @p palGetLineEventTimestampX().
+ *          The captured value is not affected by the callback execution
+ *          time so edge-to-edge measurements only suffer the constant
+ *          part of the ISR latency.
+ */
+#if !defined(PAL_USE_TIMESTAMPS) || defined(__DOXYGEN__)
+#define PAL_USE_TIMESTAMPS          FALSE
+#endif
+
+/**
+ * @brief   Timestamp source for PAL events.
+ * @details The default implementation returns the system time, for
+ *          sub-microsecond resolution it can be redefined, in the board
+ *          or configuration files, to read a free running counter, for
+ *          example @p chSysGetRealtimeCounterX() on ports supporting the
+ *          realtime counter.
+ */
+#if !defined(PAL_TIMESTAMP_NOW) || defined(__DOXYGEN__)
+#define PAL_TIMESTAMP_NOW() ((rtcnt_t)osalOsGetSystemTimeX())
+#endif
+
+/**
+ * @brief   Enables port-group events.
+ * @details When enabled a single callback can be associated to a group
+ *          of lines on the same port using @p palEnableGroupEvent(), the
+ *          callback receives the mask of the lines that triggered and an
+ *          atomic snapshot of the whole port input register, replacing
+ *          multiple per-line activations with a single one.
+ */
+#if !defined(PAL_USE_GROUP_EVENTS) || defined(__DOXYGEN__)
+#define PAL_USE_GROUP_EVENTS        FALSE
+#endif
+
+/**
+ * @brief   Maximum number of simultaneously registered port groups.
+ */
+#if !defined(PAL_GROUP_EVENTS_MAX) || defined(__DOXYGEN__)
+#define PAL_GROUP_EVENTS_MAX        4
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (PAL_USE_TIMESTAMPS == TRUE) &&                                         \
+    (PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == FALSE)
+#error "PAL_USE_TIMESTAMPS requires PAL_USE_CALLBACKS or PAL_USE_WAIT"
+#endif
+
+#if (PAL_USE_GROUP_EVENTS == TRUE) &&                                       \
+    (PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == FALSE)
+#error "PAL_USE_GROUP_EVENTS requires PAL_USE_CALLBACKS or PAL_USE_WAIT"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -167,6 +222,12 @@ typedef struct {
    */
   void                  *arg;
 #endif
+#if (PAL_USE_TIMESTAMPS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timestamp of the last event.
+   */
+  volatile rtcnt_t      timestamp;
+#endif
 } palevent_t;
 
 #include "hal_pal_lld.h"
@@ -195,6 +256,40 @@ typedef struct {
   uint_fast8_t          offset;
 } IOBus;
 
+#if (PAL_USE_GROUP_EVENTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a PAL group event callback.
+ * @details The callback receives the mask of the group lines that
+ *          triggered the event and a snapshot of the whole port input
+ *          register taken atomically on dispatch.
+ */
+typedef void (*palgroupcb_t)(void *arg,
+                             ioportmask_t changed,
+                             ioportmask_t snapshot);
+
+/**
+ * @brief   Type of a PAL group event record.
+ */
+typedef struct {
+  /**
+   * @brief   Port identifier.
+   */
+  ioportid_t            port;
+  /**
+   * @brief   Mask of the lines belonging to the group.
+   */
+  ioportmask_t          mask;
+  /**
+   * @brief   Group event callback, @p NULL marks a free record.
+   */
+  palgroupcb_t          cb;
+  /**
+   * @brief   Group callback argument.
+   */
+  void                  *arg;
+} palgroupevent_t;
+#endif /* PAL_USE_GROUP_EVENTS == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -251,6 +346,30 @@ typedef struct {
  * @name    Low level driver helper macros
  * @{
  */
+#if (PAL_USE_TIMESTAMPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes the timestamp of a PAL event object.
+ *
+ * @param[in] e         event index
+ *
+ * @notapi
+ */
+#define _pal_init_timestamp(e) (_pal_events[e].timestamp = (rtcnt_t)0)
+
+/**
+ * @brief   Captures the timestamp of a PAL event.
+ *
+ * @param[in] e         event index
+ *
+ * @notapi
+ */
+#define _pal_capture_timestamp(e)                                           \
+  (_pal_events[e].timestamp = PAL_TIMESTAMP_NOW())
+#else
+#define _pal_init_timestamp(e)
+#define _pal_capture_timestamp(e)
+#endif /* PAL_USE_TIMESTAMPS == FALSE */
+
 #if ((PAL_USE_CALLBACKS == TRUE) && (PAL_USE_WAIT == TRUE)) ||              \
     defined(__DOXYGEN__)
 /**
@@ -265,6 +384,7 @@ typedef struct {
     osalThreadQueueObjectInit(&_pal_events[e].threads);                     \
     _pal_events[e].cb = NULL;                                               \
     _pal_events[e].arg = NULL;                                              \
+    _pal_init_timestamp(e);                                                 \
   } while (false)
 #endif /* (PAL_USE_CALLBACKS == TRUE) && (PAL_USE_WAIT == TRUE) */
 
@@ -273,6 +393,7 @@ typedef struct {
   do {                                                                      \
     _pal_events[e].cb = NULL;                                               \
     _pal_events[e].arg = NULL;                                              \
+    _pal_init_timestamp(e);                                                 \
   } while (false)
 #endif /* (PAL_USE_CALLBACKS == TRUE) && (PAL_USE_WAIT == FALSE) */
 
@@ -280,6 +401,7 @@ typedef struct {
 #define _pal_init_event(e)                                                  \
   do {                                                                      \
     osalThreadQueueObjectInit(&_pal_events[e].threads);                     \
+    _pal_init_timestamp(e);                                                 \
   } while (false)
 #endif /* (PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == TRUE) */
 
@@ -326,6 +448,7 @@ typedef struct {
 #if ((PAL_USE_CALLBACKS == TRUE) && (PAL_USE_WAIT == TRUE)) ||              \
     defined(__DOXYGEN__)
 #define _pal_isr_code(e) do {                                               \
+  _pal_capture_timestamp(e);                                                \
   if (_pal_events[e].cb != NULL) {                                          \
     _pal_events[e].cb(_pal_events[e].arg);                                  \
   }                                                                         \
@@ -337,6 +460,7 @@ typedef struct {
 
 #if (PAL_USE_CALLBACKS == TRUE) && (PAL_USE_WAIT == FALSE)
 #define _pal_isr_code(e) do {                                               \
+  _pal_capture_timestamp(e);                                                \
   if (_pal_events[e].cb != NULL) {                                          \
     _pal_events[e].cb(_pal_events[e].arg);                                  \
   }                                                                         \
@@ -346,6 +470,7 @@ typedef struct {
 #if ((PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == TRUE)) ||             \
     defined(__DOXYGEN__)
 #define _pal_isr_code(e) do {                                               \
+  _pal_capture_timestamp(e);                                                \
   osalSysLockFromISR();                                                     \
   osalThreadDequeueAllI(&_pal_events[e].threads, MSG_OK);                   \
   osalSysUnlockFromISR();                                                   \
@@ -524,6 +649,43 @@ typedef struct {
   pal_lld_writegroup(port, mask, offset, bits)
 #endif
 
+/**
+ * @brief   Reads an I/O bus, inline fast variant.
+ * @details Unlike @p palReadBus() this macro expands in place without
+ *          parameters checks, when the bus descriptor is a compile-time
+ *          constant the operation reduces to a single port access.
+ * @note    The function can be called from any context.
+ *
+ * @param[in] bus       the I/O bus, pointer to a @p IOBus structure
+ * @return              The bus logic states.
+ *
+ * @special
+ */
+#define palReadBusX(bus)                                                    \
+  palReadGroup((bus)->portid, (bus)->mask, (bus)->offset)
+
+/**
+ * @brief   Writes an I/O bus, inline fast variant.
+ * @details Unlike @p palWriteBus() this macro expands in place without
+ *          parameters checks, when the bus descriptor is a compile-time
+ *          constant and the port supports atomic group writes the
+ *          operation reduces to a single port store.
+ * @note    The operation is not guaranteed to be atomic on all the
+ *          architectures, for atomicity and/or portability reasons you may
+ *          need to enclose port I/O operations between @p osalSysLock() and
+ *          @p osalSysUnlock().
+ * @note    The function can be called from any context.
+ *
+ * @param[in] bus       the I/O bus, pointer to a @p IOBus structure
+ * @param[in] bits      bits to be written on the I/O bus. Values exceeding
+ *                      the bus width are masked so most significant bits
+ *                      are lost.
+ *
+ * @special
+ */
+#define palWriteBusX(bus, bits)                                             \
+  palWriteGroup((bus)->portid, (bus)->mask, (bus)->offset, bits)
+
 /**
  * @brief   Pads group mode setup.
  * @details This function programs a pads group belonging to the same port
@@ -960,12 +1122,24 @@ extern "C" {
 #endif
   ioportmask_t palReadBus(const IOBus *bus);
   void palWriteBus(const IOBus *bus, ioportmask_t bits);
+  void palWriteBusBurst(const IOBus *bus, ioline_t strobe,
+                        const uint8_t buffer[], size_t n);
   void palSetBusMode(const IOBus *bus, iomode_t mode);
 #if (PAL_USE_CALLBACKS == TRUE) || defined(__DOXYGEN__)
   void palSetPadCallbackI(ioportid_t port, iopadid_t pad,
                           palcallback_t cb, void *arg);
   void palSetLineCallbackI(ioline_t line, palcallback_t cb, void *arg);
 #endif /* PAL_USE_CALLBACKS == TRUE */
+#if (PAL_USE_TIMESTAMPS == TRUE) || defined(__DOXYGEN__)
+  rtcnt_t palGetPadEventTimestampX(ioportid_t port, iopadid_t pad);
+  rtcnt_t palGetLineEventTimestampX(ioline_t line);
+#endif /* PAL_USE_TIMESTAMPS == TRUE */
+#if (PAL_USE_GROUP_EVENTS == TRUE) || defined(__DOXYGEN__)
+  void palEnableGroupEvent(ioportid_t port, ioportmask_t mask,
+                           ioeventmode_t mode, palgroupcb_t cb, void *arg);
+  void palDisableGroupEvent(ioportid_t port, ioportmask_t mask);
+  ioportmask_t _pal_serve_group_events(ioportmask_t lines);
+#endif /* PAL_USE_GROUP_EVENTS == TRUE */
 #if (PAL_USE_WAIT == TRUE) || defined(__DOXYGEN__)
   msg_t palWaitPadTimeoutS(ioportid_t port, iopadid_t pad,
                            sysinterval_t timeout);
@@ -91,6 +91,12 @@ typedef void (*pwmcallback_t)(PWMDriver *pwmp);
 
 #include "hal_pwm_lld.h"
 
+/* Some more checks, must happen after inclusion of the LLD header, this is
+   why are placed here.*/
+#if !defined(PWM_SUPPORTS_GROUP_UPDATE)
+#define PWM_SUPPORTS_GROUP_UPDATE           FALSE
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -293,6 +299,12 @@ extern "C" {
                         pwmchannel_t channel,
                         pwmcnt_t width);
   void pwmDisableChannel(PWMDriver *pwmp, pwmchannel_t channel);
+  void pwmSetChannels(PWMDriver *pwmp,
+                      pwmchnmsk_t mask,
+                      const pwmcnt_t widths[]);
+  void pwmSetChannelsI(PWMDriver *pwmp,
+                       pwmchnmsk_t mask,
+                       const pwmcnt_t widths[]);
   void pwmEnablePeriodicNotification(PWMDriver *pwmp);
   void pwmDisablePeriodicNotification(PWMDriver *pwmp);
   void pwmEnableChannelNotification(PWMDriver *pwmp, pwmchannel_t channel);
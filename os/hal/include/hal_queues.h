@@ -44,6 +44,19 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Queues occupancy statistics.
+ * @details If enabled then each I/O queue tracks the peak number of
+ *          buffered bytes, a single compare and store on the filling
+ *          paths, and all queues can be enumerated using @p qGetNextX().
+ *          The high watermarks allow to size the buffers on measured
+ *          worst cases instead of guesses.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(HAL_QUEUES_STATS) || defined(__DOXYGEN__)
+#define HAL_QUEUES_STATS            FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -82,6 +95,12 @@ struct io_queue {
   uint8_t               *q_rdptr;   /**< @brief Read pointer.               */
   qnotify_t             q_notify;   /**< @brief Data notification callback. */
   void                  *q_link;    /**< @brief Application defined field.  */
+#if (HAL_QUEUES_STATS == TRUE) || defined(__DOXYGEN__)
+  volatile size_t       q_hwm;      /**< @brief Peak number of buffered
+                                         bytes.                             */
+  io_queue_t            *q_next;    /**< @brief Next in the queues
+                                         enumeration list.                  */
+#endif
 };
 
 /**
@@ -152,6 +171,20 @@ typedef io_queue_t output_queue_t;
  */
 #define qGetLink(qp) ((qp)->q_link)
 
+#if (HAL_QUEUES_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the peak number of bytes buffered into a queue.
+ * @note    The returned value is a fill level for both input and output
+ *          queues.
+ *
+ * @param[in] qp        pointer to a @p io_queue_t structure
+ * @return              The queue high watermark.
+ *
+ * @xclass
+ */
+#define qGetHighWatermarkX(qp) ((qp)->q_hwm)
+#endif
+
 /**
  * @brief   Returns the filled space into an input queue.
  *
@@ -293,11 +326,14 @@ extern "C" {
                     qnotify_t infy, void *link);
   void iqResetI(input_queue_t *iqp);
   msg_t iqPutI(input_queue_t *iqp, uint8_t b);
+  size_t iqWriteI(input_queue_t *iqp, const uint8_t *bp, size_t n);
   msg_t iqGetI(input_queue_t *iqp);
   msg_t iqGetTimeout(input_queue_t *iqp, sysinterval_t timeout);
   size_t iqReadI(input_queue_t *iqp, uint8_t *bp, size_t n);
   size_t iqReadTimeout(input_queue_t *iqp, uint8_t *bp,
                        size_t n, sysinterval_t timeout);
+  size_t iqReadVTimeout(input_queue_t *iqp, const stm_iovec_t iov[],
+                        size_t iovcnt, sysinterval_t timeout);
 
   void oqObjectInit(output_queue_t *oqp, uint8_t *bp, size_t size,
                     qnotify_t onfy, void *link);
@@ -305,9 +341,15 @@ extern "C" {
   msg_t oqPutI(output_queue_t *oqp, uint8_t b);
   msg_t oqPutTimeout(output_queue_t *oqp, uint8_t b, sysinterval_t timeout);
   msg_t oqGetI(output_queue_t *oqp);
+  size_t oqReadI(output_queue_t *oqp, uint8_t *bp, size_t n);
   size_t oqWriteI(output_queue_t *oqp, const uint8_t *bp, size_t n);
   size_t oqWriteTimeout(output_queue_t *oqp, const uint8_t *bp,
                         size_t n, sysinterval_t timeout);
+  size_t oqWriteVTimeout(output_queue_t *oqp, const stm_iovec_t iov[],
+                         size_t iovcnt, sysinterval_t timeout);
+#if HAL_QUEUES_STATS == TRUE
+  io_queue_t *qGetNextX(io_queue_t *qp);
+#endif
 #ifdef __cplusplus
 }
 #endif
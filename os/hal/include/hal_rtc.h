@@ -101,6 +101,23 @@ typedef struct {
   /*lint -restore*/
 } RTCDateTime;
 
+/**
+ * @brief   Type of a correlated RTC/system time sample.
+ * @details The two samples are taken in the same instant, within one
+ *          system tick, so timestamps can be translated between the two
+ *          time domains without estimating a drifting offset.
+ */
+typedef struct {
+  /**
+   * @brief   RTC date/time stamp.
+   */
+  RTCDateTime   rtctime;
+  /**
+   * @brief   System time taken in the same instant.
+   */
+  systime_t     systime;
+} RTCCorrelation;
+
 #include "hal_rtc_lld.h"
 
 /*===========================================================================*/
@@ -118,6 +135,7 @@ extern "C" {
   void rtcObjectInit(RTCDriver *rtcp);
   void rtcSetTime(RTCDriver *rtcp, const RTCDateTime *timespec);
   void rtcGetTime(RTCDriver *rtcp, RTCDateTime *timespec);
+  void rtcGetCorrelation(RTCDriver *rtcp, RTCCorrelation *corp);
 #if RTC_ALARMS > 0
   void rtcSetAlarm(RTCDriver *rtcp,
                    rtcalarm_t alarm,
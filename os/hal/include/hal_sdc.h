@@ -106,6 +106,32 @@
 #if !defined(SDC_INIT_OCR) || defined(__DOXYGEN__)
 #define SDC_INIT_OCR                        0x80100000U
 #endif
+
+/**
+ * @brief   Enables the asynchronous transfer API.
+ * @details When enabled @p sdcStartRead() and @p sdcStartWrite() start a
+ *          DMA transfer and return immediately, the invoking thread can
+ *          overlap the card busy time with other activities and collect
+ *          the result with @p sdcFinishTransfer() afterwards.
+ * @note    This option is only usable on those low level drivers setting
+ *          the @p SDC_SUPPORTS_ASYNC switch.
+ */
+#if !defined(SDC_USE_ASYNC) || defined(__DOXYGEN__)
+#define SDC_USE_ASYNC                       FALSE
+#endif
+
+/**
+ * @brief   Enables the service time statistics.
+ * @details When enabled the driver accumulates the service time of data
+ *          operations and of the card busy waits into min/max/cumulative
+ *          accumulators, the counters can be retrieved with
+ *          @p sdcGetStats() for diagnosing slow or degrading cards.
+ * @note    Times are measured in system ticks, the resolution depends on
+ *          the @p CH_CFG_ST_FREQUENCY setting.
+ */
+#if !defined(SDC_USE_STATS) || defined(__DOXYGEN__)
+#define SDC_USE_STATS                       FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -127,14 +153,94 @@ typedef enum {
 
 /**
  * @brief   Max supported clock.
+ * @note    The values are ordered by increasing throughput, modes above
+ *          @p SDC_CLK_50MHz are only attempted when the LLD advertises
+ *          them through @p SDC_LLD_MAX_BUS_CLOCK.
  */
 typedef enum {
   SDC_CLK_25MHz = 0,
-  SDC_CLK_50MHz
+  SDC_CLK_50MHz,
+  SDC_CLK_100MHz,                   /**< SDR50 switched mode.              */
+  SDC_CLK_DDR50                     /**< DDR mode at 50MHz clock.          */
 } sdcbusclk_t;
 
+/**
+ * @brief   Type of an SDC notification callback.
+ * @details Invoked in ISR context when the data phase of an asynchronous
+ *          transfer ends, the transfer must then be completed by calling
+ *          @p sdcFinishTransfer() from thread context.
+ */
+typedef void (*sdccallback_t)(struct SDCDriver *sdcp);
+
+/**
+ * @brief   Type of a service time accumulator.
+ * @note    All times are expressed in system ticks.
+ */
+typedef struct {
+  /**
+   * @brief   Number of accumulated measurements.
+   */
+  uint32_t                  n;
+  /**
+   * @brief   Last measured service time.
+   */
+  systime_t                 last;
+  /**
+   * @brief   Best measured service time.
+   */
+  systime_t                 best;
+  /**
+   * @brief   Worst measured service time.
+   */
+  systime_t                 worst;
+  /**
+   * @brief   Cumulative service time.
+   */
+  uint32_t                  cumulative;
+} sdc_time_measurement_t;
+
+/**
+ * @brief   Type of the SDC statistics, see @p SDC_USE_STATS.
+ */
+typedef struct {
+  /**
+   * @brief   Service time of read operations.
+   */
+  sdc_time_measurement_t    read;
+  /**
+   * @brief   Service time of write operations.
+   */
+  sdc_time_measurement_t    write;
+  /**
+   * @brief   Duration of the card busy waits.
+   */
+  sdc_time_measurement_t    busy;
+  /**
+   * @brief   Status polling commands sent while waiting for the card.
+   */
+  uint32_t                  busy_polls;
+  /**
+   * @brief   Failed read operations.
+   */
+  uint32_t                  read_errors;
+  /**
+   * @brief   Failed write operations.
+   */
+  uint32_t                  write_errors;
+} sdc_stats_t;
+
 #include "hal_sdc_lld.h"
 
+/**
+ * @brief   Fastest bus mode supported by the LLD.
+ * @details LLDs able to clock the switched SDR50 or DDR modes advertise
+ *          it by defining this macro, the negotiation ladder never
+ *          attempts modes above it.
+ */
+#if !defined(SDC_LLD_MAX_BUS_CLOCK) || defined(__DOXYGEN__)
+#define SDC_LLD_MAX_BUS_CLOCK               SDC_CLK_50MHz
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -180,6 +286,10 @@ typedef enum {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (SDC_USE_STATS == TRUE) && !defined(__DOXYGEN__)
+extern sdc_stats_t sdc_stats;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -193,10 +303,21 @@ extern "C" {
                uint8_t *buf, uint32_t n);
   bool sdcWrite(SDCDriver *sdcp, uint32_t startblk,
                 const uint8_t *buf, uint32_t n);
+#if SDC_USE_ASYNC == TRUE
+  bool sdcStartRead(SDCDriver *sdcp, uint32_t startblk,
+                    uint8_t *buf, uint32_t n);
+  bool sdcStartWrite(SDCDriver *sdcp, uint32_t startblk,
+                     const uint8_t *buf, uint32_t n);
+  bool sdcFinishTransfer(SDCDriver *sdcp);
+#endif
   sdcflags_t sdcGetAndClearErrors(SDCDriver *sdcp);
   bool sdcSync(SDCDriver *sdcp);
   bool sdcGetInfo(SDCDriver *sdcp, BlockDeviceInfo *bdip);
   bool sdcErase(SDCDriver *sdcp, uint32_t startblk, uint32_t endblk);
+#if SDC_USE_STATS == TRUE
+  void sdcGetStats(sdc_stats_t *ssp);
+  void sdcResetStats(void);
+#endif
   bool _sdc_wait_for_transfer_state(SDCDriver *sdcp);
 #ifdef __cplusplus
 }
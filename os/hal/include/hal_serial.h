@@ -298,6 +298,8 @@ extern "C" {
   void sdStop(SerialDriver *sdp);
   void sdIncomingDataI(SerialDriver *sdp, uint8_t b);
   msg_t sdRequestDataI(SerialDriver *sdp);
+  size_t sdIncomingDataBulkI(SerialDriver *sdp, const uint8_t *bp, size_t n);
+  size_t sdRequestDataBulkI(SerialDriver *sdp, uint8_t *bp, size_t n);
   bool sdPutWouldBlock(SerialDriver *sdp);
   bool sdGetWouldBlock(SerialDriver *sdp);
   msg_t sdControl(SerialDriver *sdp, unsigned int operation, void *arg);
@@ -59,6 +59,29 @@
 #if !defined(SERIAL_USB_BUFFERS_NUMBER) || defined(__DOXYGEN__)
 #define SERIAL_USB_BUFFERS_NUMBER   2
 #endif
+
+/**
+ * @brief   Enables the shared buffers pool.
+ * @details When enabled the queue buffers are not embedded in the driver
+ *          structures but reserved from a single shared pool at the first
+ *          @p sduStart(), each instance takes exactly the geometry
+ *          specified in its configuration so low-rate instances no longer
+ *          pay for the geometry of the largest one.
+ */
+#if !defined(SERIAL_USB_USE_SHARED_POOL) || defined(__DOXYGEN__)
+#define SERIAL_USB_USE_SHARED_POOL  FALSE
+#endif
+
+/**
+ * @brief   Size in bytes of the shared buffers pool.
+ * @note    The default fits one instance at the default geometry, devices
+ *          with multiple instances must size it for the sum of all the
+ *          per-instance reservations.
+ */
+#if !defined(SERIAL_USB_POOL_SIZE) || defined(__DOXYGEN__)
+#define SERIAL_USB_POOL_SIZE        (2 * BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER, \
+                                                        SERIAL_USB_BUFFERS_SIZE))
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -111,8 +134,65 @@ typedef struct {
    *          present, USB descriptors must be changed accordingly.
    */
   usbep_t                   int_in;
+  /**
+   * @brief   Number of USB frames a partially filled buffer is allowed to
+   *          age before being flushed, zero flushes at every frame.
+   * @details Coalescing small writes into larger transfers reduces the
+   *          per-transfer overhead at the cost of added latency.
+   */
+  uint16_t                  coalesce_frames;
+  /**
+   * @brief   Fill level in bytes at which a partially filled buffer is
+   *          flushed regardless of its age, zero disables the threshold.
+   */
+  size_t                    coalesce_threshold;
+  /**
+   * @brief   Size of the queue buffers, zero selects
+   *          @p SERIAL_USB_BUFFERS_SIZE.
+   * @note    The size must be a multiple of the USB data endpoint maximum
+   *          packet size.
+   */
+  size_t                    buffers_size;
+  /**
+   * @brief   Number of input queue buffers, zero selects
+   *          @p SERIAL_USB_BUFFERS_NUMBER.
+   */
+  size_t                    in_buffers_number;
+  /**
+   * @brief   Number of output queue buffers, zero selects
+   *          @p SERIAL_USB_BUFFERS_NUMBER.
+   */
+  size_t                    out_buffers_number;
 } SerialUSBConfig;
 
+#if (SERIAL_USB_USE_SHARED_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   @p SerialUSBDriver buffers storage, pool mode.
+ * @details The storage is reserved from the shared pool at the first
+ *          @p sduStart() and retained across stop/start cycles.
+ */
+#define _serial_usb_driver_buffers                                          \
+  /* Input buffer.*/                                                        \
+  uint8_t                   *ib;                                            \
+  /* Output buffer.*/                                                       \
+  uint8_t                   *ob;                                            \
+  /* Size of the input buffers reservation.*/                               \
+  size_t                    ibsize;                                         \
+  /* Size of the output buffers reservation.*/                              \
+  size_t                    obsize;
+#else
+/**
+ * @brief   @p SerialUSBDriver buffers storage, embedded mode.
+ */
+#define _serial_usb_driver_buffers                                          \
+  /* Input buffer.*/                                                        \
+  uint8_t                   ib[BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER,    \
+                                              SERIAL_USB_BUFFERS_SIZE)];    \
+  /* Output buffer.*/                                                       \
+  uint8_t                   ob[BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER,    \
+                                              SERIAL_USB_BUFFERS_SIZE)];
+#endif
+
 /**
  * @brief   @p SerialDriver specific data.
  */
@@ -124,12 +204,10 @@ typedef struct {
   input_buffers_queue_t     ibqueue;                                        \
   /* Output queue.*/                                                        \
   output_buffers_queue_t    obqueue;                                        \
-  /* Input buffer.*/                                                        \
-  uint8_t                   ib[BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER,    \
-                                              SERIAL_USB_BUFFERS_SIZE)];    \
-  /* Output buffer.*/                                                       \
-  uint8_t                   ob[BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER,    \
-                                              SERIAL_USB_BUFFERS_SIZE)];    \
+  /* Queue buffers storage.*/                                               \
+  _serial_usb_driver_buffers                                                \
+  /* Age in USB frames of the pending partially filled buffer.*/            \
+  uint16_t                  obcoalesce;                                     \
   /* End of the mandatory fields.*/                                         \
   /* Current configuration data.*/                                          \
   const SerialUSBConfig     *config;
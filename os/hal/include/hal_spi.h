@@ -76,6 +76,17 @@
 #define SPI_USE_MUTUAL_EXCLUSION            TRUE
 #endif
 
+/**
+ * @brief   Enables the queued transactions APIs.
+ * @details Chains of transaction descriptors are executed back-to-back from
+ *          ISR context, the bus does not idle between transactions waiting
+ *          for a thread to resubmit.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_TRANSACTIONS) || defined(__DOXYGEN__)
+#define SPI_USE_TRANSACTIONS                FALSE
+#endif
+
 /**
  * @brief   Handling method for SPI CS line.
  * @note    Disabling this option saves both code and data space.
@@ -112,6 +123,65 @@ typedef enum {
   SPI_COMPLETE = 4                  /**< Asynchronous operation complete.   */
 } spistate_t;
 
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Forward declaration of the driver structure.
+ */
+struct SPIDriver;
+
+/**
+ * @brief   Type of a queued transaction descriptor.
+ */
+typedef struct spi_transaction spi_transaction_t;
+
+/**
+ * @brief   Type of a transaction completion callback.
+ * @note    The callback is invoked from ISR context while the system is in
+ *          the ISR-locked state, the next queued transaction, if any, has
+ *          already been started when the callback runs.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] stp       pointer to the completed transaction descriptor
+ */
+typedef void (*spitxncallback_t)(struct SPIDriver *spip,
+                                 spi_transaction_t *stp);
+
+/**
+ * @brief   Queued transaction descriptor.
+ * @details The descriptor is owned by the driver from submission until the
+ *          completion callback has been invoked, it must not be modified
+ *          or reused in this interval.
+ */
+struct spi_transaction {
+  /**
+   * @brief   If @p true then the slave select signal is asserted before
+   *          the transfer and released at its end.
+   */
+  bool                      select;
+  /**
+   * @brief   Transmit buffer, @p NULL in order to send idle words.
+   */
+  const void                *txbuf;
+  /**
+   * @brief   Receive buffer, @p NULL in order to discard received data.
+   */
+  void                      *rxbuf;
+  /**
+   * @brief   Number of words to be transferred.
+   */
+  size_t                    n;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  spitxncallback_t          callback;
+  /**
+   * @brief   Next descriptor in the chain or @p NULL, also used as queue
+   *          link by the driver.
+   */
+  spi_transaction_t         *next;
+};
+#endif /* SPI_USE_TRANSACTIONS == TRUE */
+
 #include "hal_spi_lld.h"
 
 /* Some more checks, must happen after inclusion of the LLD header, this is
@@ -120,6 +190,10 @@ typedef enum {
 #define SPI_SUPPORTS_CIRCULAR               FALSE
 #endif
 
+#if !defined(SPI_SUPPORTS_SLAVE_MODE)
+#define SPI_SUPPORTS_SLAVE_MODE             FALSE
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -324,6 +398,26 @@ do {                                                                        \
  *
  * @notapi
  */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+#define _spi_isr_code(spip) {                                               \
+  if ((spip)->txnhead != NULL) {                                            \
+    osalSysLockFromISR();                                                   \
+    _spi_txn_advance(spip);                                                 \
+    osalSysUnlockFromISR();                                                 \
+  }                                                                         \
+  else {                                                                    \
+    if ((spip)->config->end_cb) {                                           \
+      (spip)->state = SPI_COMPLETE;                                         \
+      (spip)->config->end_cb(spip);                                         \
+      if ((spip)->state == SPI_COMPLETE)                                    \
+        (spip)->state = SPI_READY;                                          \
+    }                                                                       \
+    else                                                                    \
+      (spip)->state = SPI_READY;                                            \
+    _spi_wakeup_isr(spip);                                                  \
+  }                                                                         \
+}
+#else /* SPI_USE_TRANSACTIONS == FALSE */
 #define _spi_isr_code(spip) {                                               \
   if ((spip)->config->end_cb) {                                             \
     (spip)->state = SPI_COMPLETE;                                           \
@@ -335,6 +429,7 @@ do {                                                                        \
     (spip)->state = SPI_READY;                                              \
   _spi_wakeup_isr(spip);                                                    \
 }
+#endif /* SPI_USE_TRANSACTIONS == FALSE */
 
 /**
  * @brief   Common ISR code in circular mode.
@@ -395,6 +490,11 @@ extern "C" {
                         const void *txbuf, void *rxbuf);
   void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf);
   void spiStartReceive(SPIDriver *spip, size_t n, void *rxbuf);
+#if SPI_USE_TRANSACTIONS == TRUE
+  void spiPostTransactionI(SPIDriver *spip, spi_transaction_t *stp);
+  void spiPostTransaction(SPIDriver *spip, spi_transaction_t *stp);
+  void _spi_txn_advance(SPIDriver *spip);
+#endif
 #if SPI_SUPPORTS_CIRCULAR == TRUE
   void spiAbortI(SPIDriver *spip);
   void spiAbort(SPIDriver *spip);
@@ -45,6 +45,27 @@
 
 #include "hal_st_lld.h"
 
+/**
+ * @brief   Number of alarms available in the low level driver.
+ * @details Alarm zero is reserved for the OS tick, the additional alarms,
+ *          if any, are available to the application through the
+ *          @p stStartAlarmN() interface.
+ */
+#if !defined(ST_LLD_NUM_ALARMS) || defined(__DOXYGEN__)
+#define ST_LLD_NUM_ALARMS                   1
+#endif
+
+#if (ST_LLD_NUM_ALARMS > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an additional alarm callback.
+ * @note    The callback is invoked in ISR context, no system APIs other
+ *          than the I-class functions enclosed in
+ *          @p osalSysLockFromISR() / @p osalSysUnlockFromISR() can be
+ *          used.
+ */
+typedef void (*st_callback_t)(unsigned alarm);
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -74,12 +95,54 @@
  * @api
  */
 #define stIsAlarmActive() st_lld_is_alarm_active()
+
+#if (ST_LLD_NUM_ALARMS > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Sets the time of an additional alarm.
+ * @note    This functionality is only available in free running mode, the
+ *          behaviour in periodic mode is undefined.
+ *
+ * @param[in] alarm     alarm channel number, greater than zero
+ * @param[in] abstime   the time to be set for the next alarm
+ *
+ * @api
+ */
+#define stSetAlarmN(alarm, abstime) st_lld_set_alarm_n(alarm, abstime)
+
+/**
+ * @brief   Returns the current time of an additional alarm.
+ * @note    This functionality is only available in free running mode, the
+ *          behaviour in periodic mode is undefined.
+ *
+ * @param[in] alarm     alarm channel number, greater than zero
+ * @return              The currently set alarm time.
+ *
+ * @api
+ */
+#define stGetAlarmN(alarm) st_lld_get_alarm_n(alarm)
+
+/**
+ * @brief   Determines if an additional alarm is active.
+ *
+ * @param[in] alarm     alarm channel number, greater than zero
+ * @return              The alarm status.
+ * @retval false        if the alarm is not active.
+ * @retval true         is the alarm is active
+ *
+ * @api
+ */
+#define stIsAlarmActiveN(alarm) st_lld_is_alarm_active_n(alarm)
+#endif /* ST_LLD_NUM_ALARMS > 1 */
 /** @} */
 
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (ST_LLD_NUM_ALARMS > 1) && !defined(__DOXYGEN__)
+extern st_callback_t st_callbacks[ST_LLD_NUM_ALARMS - 1];
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -88,6 +151,10 @@ extern "C" {
   void stStopAlarm(void);
   void stSetAlarm(systime_t abstime);
   systime_t stGetAlarm(void);
+#if ST_LLD_NUM_ALARMS > 1
+  void stStartAlarmN(unsigned alarm, systime_t abstime, st_callback_t cb);
+  void stStopAlarmN(unsigned alarm);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,21 @@
 #define STM_RESET            MSG_RESET
 /** @} */
 
+/**
+ * @brief   Type of a stream data segment descriptor.
+ * @details An array of segment descriptors can be transferred over a
+ *          stream in a single operation using @p streamWriteV() and
+ *          @p streamReadV().
+ * @note    The segment data is not modified by write operations, the
+ *          pointer is not const-qualified so that the same descriptor
+ *          type can be used in both directions.
+ */
+typedef struct {
+  void                  *base;          /**< @brief Pointer to the segment
+                                                    data.                   */
+  size_t                len;            /**< @brief Segment length.         */
+} stm_iovec_t;
+
 /**
  * @brief   BaseSequentialStream specific methods.
  */
@@ -53,6 +68,10 @@
   size_t (*write)(void *instance, const uint8_t *bp, size_t n);             \
   /* Stream read buffer method.*/                                           \
   size_t (*read)(void *instance, uint8_t *bp, size_t n);                    \
+  /* Stream vectored write method.*/                                        \
+  size_t (*writev)(void *instance, const stm_iovec_t iov[], size_t iovcnt); \
+  /* Stream vectored read method.*/                                         \
+  size_t (*readv)(void *instance, const stm_iovec_t iov[], size_t iovcnt);  \
   /* Channel put method, blocking.*/                                        \
   msg_t (*put)(void *instance, uint8_t b);                                  \
   /* Channel get method, blocking.*/                                        \
@@ -120,6 +139,42 @@ typedef struct {
  */
 #define streamRead(ip, bp, n) ((ip)->vmt->read(ip, bp, n))
 
+/**
+ * @brief   Sequential Stream vectored write.
+ * @details The function writes the data segments described by an array of
+ *          segment descriptors to a stream in a single operation, implying
+ *          a single synchronization point for multi-segment frames.
+ *
+ * @param[in] ip        pointer to a @p BaseSequentialStream or derived class
+ * @param[in] iov       pointer to an array of @p stm_iovec_t segment
+ *                      descriptors
+ * @param[in] iovcnt    number of segment descriptors
+ * @return              The number of bytes transferred. The return value can
+ *                      be less than the sum of the segment lengths if an
+ *                      end-of-file condition has been met.
+ *
+ * @api
+ */
+#define streamWriteV(ip, iov, iovcnt) ((ip)->vmt->writev(ip, iov, iovcnt))
+
+/**
+ * @brief   Sequential Stream vectored read.
+ * @details The function reads data from a stream into the data segments
+ *          described by an array of segment descriptors in a single
+ *          operation.
+ *
+ * @param[in] ip        pointer to a @p BaseSequentialStream or derived class
+ * @param[in] iov       pointer to an array of @p stm_iovec_t segment
+ *                      descriptors
+ * @param[in] iovcnt    number of segment descriptors
+ * @return              The number of bytes transferred. The return value can
+ *                      be less than the sum of the segment lengths if an
+ *                      end-of-file condition has been met.
+ *
+ * @api
+ */
+#define streamReadV(ip, iov, iovcnt) ((ip)->vmt->readv(ip, iov, iovcnt))
+
 /**
  * @brief   Sequential Stream blocking byte write.
  * @details This function writes a byte value to a channel. If the channel
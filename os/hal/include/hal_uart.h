@@ -66,6 +66,16 @@
 #if !defined(UART_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
 #define UART_USE_MUTUAL_EXCLUSION           FALSE
 #endif
+
+/**
+ * @brief   Enables the receive buffer chaining APIs.
+ * @details A second receive buffer can be armed while the current one is
+ *          being filled, on completion the chained buffer is started from
+ *          within the ISR for zero-gap reception.
+ */
+#if !defined(UART_USE_RX_CHAIN) || defined(__DOXYGEN__)
+#define UART_USE_RX_CHAIN                   FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -202,6 +212,28 @@ typedef enum {
 #define _uart_wakeup_rx_timeout_isr(uartp)
 #endif /* !UART_USE_WAIT */
 
+#if (UART_USE_RX_CHAIN == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the chained receive buffer, if one is armed.
+ * @note    The chained buffer is started before the completion callback is
+ *          invoked so there is no reception gap.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @notapi
+ */
+#define _uart_rx_chain_isr(uartp) {                                         \
+  if (((uartp)->rxstate == UART_RX_COMPLETE) &&                             \
+      ((uartp)->rxchainbuf != NULL)) {                                      \
+    uart_lld_start_receive(uartp, (uartp)->rxchainn, (uartp)->rxchainbuf);  \
+    (uartp)->rxchainbuf = NULL;                                             \
+    (uartp)->rxstate = UART_RX_ACTIVE;                                      \
+  }                                                                         \
+}
+#else /* !UART_USE_RX_CHAIN */
+#define _uart_rx_chain_isr(uartp)
+#endif /* !UART_USE_RX_CHAIN */
+
 /**
  * @brief   Common ISR code for early TX.
  * @details This code handles the portable part of the ISR code:
@@ -264,6 +296,7 @@ typedef enum {
  */
 #define _uart_rx_complete_isr_code(uartp) {                                 \
   (uartp)->rxstate = UART_RX_COMPLETE;                                      \
+  _uart_rx_chain_isr(uartp);                                                \
   if ((uartp)->config->rxend_cb != NULL) {                                  \
     (uartp)->config->rxend_cb(uartp);                                       \
   }                                                                         \
@@ -357,6 +390,10 @@ extern "C" {
   void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf);
   size_t uartStopReceive(UARTDriver *uartp);
   size_t uartStopReceiveI(UARTDriver *uartp);
+#if UART_USE_RX_CHAIN == TRUE
+  void uartStartReceiveChainI(UARTDriver *uartp, size_t n, void *rxbuf);
+  size_t uartFinishReceiveI(UARTDriver *uartp);
+#endif
 #if UART_USE_WAIT == TRUE
   msg_t uartSendTimeout(UARTDriver *uartp, size_t *np,
                         const void *txbuf, sysinterval_t timeout);
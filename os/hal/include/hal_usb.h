@@ -245,6 +245,29 @@
 #define USB_USE_WAIT                        FALSE
 #endif
 
+/**
+ * @brief   Enables the isochronous transfers helper API.
+ * @details When enabled a small pump object is available that keeps an
+ *          isochronous endpoint armed with double buffered per-frame
+ *          transfers and notifies each completed frame through a
+ *          callback.
+ */
+#if !defined(USB_USE_ISOCHRONOUS) || defined(__DOXYGEN__)
+#define USB_USE_ISOCHRONOUS                 FALSE
+#endif
+
+/**
+ * @brief   Enables queuing of pending transfers on endpoints.
+ * @details When enabled @p usbStartTransmitI() and @p usbStartReceiveI()
+ *          accept one more transfer while the endpoint is active, the
+ *          queued transfer is started back-to-back from the ISR when the
+ *          active one completes, removing the bus-idle gap caused by
+ *          re-arming from the completion callback.
+ */
+#if !defined(USB_USE_TRANSFER_QUEUE) || defined(__DOXYGEN__)
+#define USB_USE_TRANSFER_QUEUE              FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -370,6 +393,67 @@ typedef const USBDescriptor * (*usbgetdescriptor_t)(USBDriver *usbp,
                                                     uint8_t dindex,
                                                     uint16_t lang);
 
+/**
+ * @brief   Type of an isochronous frame callback.
+ * @details Invoked in ISR context after each completed frame, the
+ *          transfer of the other buffer has already been started. For
+ *          IN endpoints the buffer must be refilled, for OUT endpoints
+ *          the buffer contains the received frame data.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object triggering the
+ *                      callback
+ * @param[in] ep        endpoint number
+ * @param[in] buf       frame buffer to be consumed or refilled
+ * @param[in] n         for OUT endpoints the number of received bytes,
+ *                      for IN endpoints the buffer size
+ */
+typedef void (*usbisocallback_t)(USBDriver *usbp, usbep_t ep,
+                                 uint8_t *buf, size_t n);
+
+/**
+ * @brief   Type of an isochronous transfer pump, see @p USB_USE_ISOCHRONOUS.
+ * @details The pump keeps an isochronous endpoint armed with frame
+ *          scheduled double buffered transfers: while one buffer is
+ *          transferred on the bus the other one is made available to
+ *          the application through the per-frame callback.
+ */
+typedef struct {
+  /**
+   * @brief   USB driver associated to this pump.
+   */
+  USBDriver                     *usbp;
+  /**
+   * @brief   Endpoint to be kept armed.
+   */
+  usbep_t                       ep;
+  /**
+   * @brief   Endpoint direction, @p true for an IN endpoint.
+   */
+  bool                          in;
+  /**
+   * @brief   The two frame buffers.
+   */
+  uint8_t                       *buf[2];
+  /**
+   * @brief   Frame buffer size in bytes.
+   * @note    One packet is transferred per frame, the size must not
+   *          exceed the endpoint maximum packet size.
+   */
+  size_t                        size;
+  /**
+   * @brief   Index of the buffer currently on the bus.
+   */
+  unsigned                      active;
+  /**
+   * @brief   Pump activity flag.
+   */
+  bool                          running;
+  /**
+   * @brief   Per-frame callback.
+   */
+  usbisocallback_t              cb;
+} USBIsochronousTransfer;
+
 #include "hal_usb_lld.h"
 
 /*===========================================================================*/
@@ -547,7 +631,9 @@ typedef const USBDescriptor * (*usbgetdescriptor_t)(USBDriver *usbp,
  *
  * @notapi
  */
-#if (USB_USE_WAIT == TRUE) || defined(__DOXYGEN__)
+#if USB_USE_TRANSFER_QUEUE == TRUE
+#define _usb_isr_invoke_in_cb(usbp, ep) _usb_in_complete(usbp, ep)
+#elif (USB_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 #define _usb_isr_invoke_in_cb(usbp, ep) {                                   \
   (usbp)->transmitting &= ~(1 << (ep));                                     \
   if ((usbp)->epc[ep]->in_cb != NULL) {                                     \
@@ -574,7 +660,9 @@ typedef const USBDescriptor * (*usbgetdescriptor_t)(USBDriver *usbp,
  *
  * @notapi
  */
-#if (USB_USE_WAIT == TRUE) || defined(__DOXYGEN__)
+#if USB_USE_TRANSFER_QUEUE == TRUE
+#define _usb_isr_invoke_out_cb(usbp, ep) _usb_out_complete(usbp, ep)
+#elif (USB_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 #define _usb_isr_invoke_out_cb(usbp, ep) {                                  \
   (usbp)->receiving &= ~(1 << (ep));                                        \
   if ((usbp)->epc[ep]->out_cb != NULL) {                                    \
@@ -620,7 +708,20 @@ extern "C" {
 #endif
   bool usbStallReceiveI(USBDriver *usbp, usbep_t ep);
   bool usbStallTransmitI(USBDriver *usbp, usbep_t ep);
+#if USB_USE_ISOCHRONOUS == TRUE
+  void usbIsoObjectInit(USBIsochronousTransfer *itp, USBDriver *usbp,
+                        usbep_t ep, bool in, uint8_t *buf0, uint8_t *buf1,
+                        size_t size, usbisocallback_t cb);
+  void usbIsoStartI(USBIsochronousTransfer *itp);
+  void usbIsoStopI(USBIsochronousTransfer *itp);
+  void usbIsoInCallback(USBDriver *usbp, usbep_t ep);
+  void usbIsoOutCallback(USBDriver *usbp, usbep_t ep);
+#endif
   void usbWakeupHost(USBDriver *usbp);
+#if USB_USE_TRANSFER_QUEUE == TRUE
+  void _usb_in_complete(USBDriver *usbp, usbep_t ep);
+  void _usb_out_complete(USBDriver *usbp, usbep_t ep);
+#endif
   void _usb_reset(USBDriver *usbp);
   void _usb_suspend(USBDriver *usbp);
   void _usb_wakeup(USBDriver *usbp);
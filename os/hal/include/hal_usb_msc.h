@@ -0,0 +1,281 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_msc.h
+ * @brief   USB Mass Storage Class Driver macros and structures.
+ *
+ * @addtogroup USB_MSC
+ * @{
+ */
+
+#ifndef HAL_USB_MSC_H
+#define HAL_USB_MSC_H
+
+#if (HAL_USE_USB_MSC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    MSC specific messages
+ * @{
+ */
+#define MSC_REQ_RESET                   0xFFU
+#define MSC_REQ_GET_MAX_LUN             0xFEU
+/** @} */
+
+/**
+ * @name    Bulk-Only Transport structures
+ * @{
+ */
+#define MSC_CBW_SIGNATURE               0x43425355U
+#define MSC_CSW_SIGNATURE               0x53425355U
+#define MSC_CBW_SIZE                    31U
+#define MSC_CSW_SIZE                    13U
+#define MSC_CBW_FLAGS_DIR_IN            0x80U
+/** @} */
+
+/**
+ * @name    CSW status codes
+ * @{
+ */
+#define MSC_CSW_STATUS_PASSED           0U
+#define MSC_CSW_STATUS_FAILED           1U
+#define MSC_CSW_STATUS_PHASE_ERROR      2U
+/** @} */
+
+/**
+ * @name    SCSI commands
+ * @{
+ */
+#define SCSI_CMD_TEST_UNIT_READY        0x00U
+#define SCSI_CMD_REQUEST_SENSE          0x03U
+#define SCSI_CMD_INQUIRY                0x12U
+#define SCSI_CMD_MODE_SENSE_6           0x1AU
+#define SCSI_CMD_START_STOP_UNIT        0x1BU
+#define SCSI_CMD_PREVENT_ALLOW_REMOVAL  0x1EU
+#define SCSI_CMD_READ_FORMAT_CAPACITIES 0x23U
+#define SCSI_CMD_READ_CAPACITY_10       0x25U
+#define SCSI_CMD_READ_10                0x28U
+#define SCSI_CMD_WRITE_10               0x2AU
+#define SCSI_CMD_VERIFY_10              0x2FU
+/** @} */
+
+/**
+ * @name    SCSI sense keys and additional codes
+ * @{
+ */
+#define SCSI_SENSE_KEY_NO_SENSE         0x00U
+#define SCSI_SENSE_KEY_NOT_READY        0x02U
+#define SCSI_SENSE_KEY_MEDIUM_ERROR     0x03U
+#define SCSI_SENSE_KEY_ILLEGAL_REQUEST  0x05U
+#define SCSI_SENSE_KEY_DATA_PROTECT     0x07U
+#define SCSI_ASC_INVALID_COMMAND        0x20U
+#define SCSI_ASC_LBA_OUT_OF_RANGE       0x21U
+#define SCSI_ASC_INVALID_FIELD_IN_CDB   0x24U
+#define SCSI_ASC_MEDIUM_NOT_PRESENT     0x3AU
+#define SCSI_ASC_UNRECOVERED_READ_ERROR 0x11U
+#define SCSI_ASC_WRITE_FAULT            0x03U
+#define SCSI_ASC_WRITE_PROTECTED        0x27U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    USB_MSC configuration options
+ * @{
+ */
+/**
+ * @brief   USB MSC data buffers size.
+ * @details Size in bytes of each of the two pipelined transfer buffers,
+ *          it must be a multiple of the block size of the exposed block
+ *          device.
+ * @note    Larger buffers improve throughput because the storage access
+ *          and the USB streaming of the previous chunk are overlapped
+ *          in chunks of this size.
+ */
+#if !defined(USB_MSC_BUFFERS_SIZE) || defined(__DOXYGEN__)
+#define USB_MSC_BUFFERS_SIZE            2048
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_USB == FALSE
+#error "USB Mass Storage Driver requires HAL_USE_USB"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  MSC_UNINIT = 0,                   /**< Not initialized.                   */
+  MSC_STOP = 1,                     /**< Stopped.                           */
+  MSC_READY = 2                     /**< Ready.                             */
+} mscstate_t;
+
+/**
+ * @brief   Type of a Command Block Wrapper structure.
+ * @note    The structure has no internal padding, it is transferred over
+ *          the bulk OUT endpoint with size @p MSC_CBW_SIZE.
+ */
+typedef struct {
+  uint32_t                  signature;
+  uint32_t                  tag;
+  uint32_t                  data_len;
+  uint8_t                   flags;
+  uint8_t                   lun;
+  uint8_t                   cmd_len;
+  uint8_t                   cmd[16];
+} msc_cbw_t;
+
+/**
+ * @brief   Type of a Command Status Wrapper structure.
+ * @note    The structure has no internal padding, it is transferred over
+ *          the bulk IN endpoint with size @p MSC_CSW_SIZE.
+ */
+typedef struct {
+  uint32_t                  signature;
+  uint32_t                  tag;
+  uint32_t                  data_residue;
+  uint8_t                   status;
+} msc_csw_t;
+
+/**
+ * @brief   Structure representing a USB mass storage driver.
+ */
+typedef struct USBMassStorageDriver USBMassStorageDriver;
+
+/**
+ * @brief   USB mass storage driver configuration structure.
+ * @details An instance of this structure must be passed to @p mscStart()
+ *          in order to configure and start the driver operations.
+ */
+typedef struct {
+  /**
+   * @brief   USB driver to use.
+   */
+  USBDriver                 *usbp;
+  /**
+   * @brief   Bulk IN endpoint used for outgoing data transfer.
+   */
+  usbep_t                   bulk_in;
+  /**
+   * @brief   Bulk OUT endpoint used for incoming data transfer.
+   */
+  usbep_t                   bulk_out;
+  /**
+   * @brief   Block device exposed to the host.
+   */
+  BaseBlockDevice           *blkp;
+  /**
+   * @brief   Vendor identification string, 8 characters padded with
+   *          spaces, returned in the INQUIRY response.
+   */
+  const char                *vendor_id;
+  /**
+   * @brief   Product identification string, 16 characters padded with
+   *          spaces, returned in the INQUIRY response.
+   */
+  const char                *product_id;
+  /**
+   * @brief   Product revision string, 4 characters padded with spaces,
+   *          returned in the INQUIRY response.
+   */
+  const char                *product_rev;
+} USBMassStorageConfig;
+
+/**
+ * @brief   Structure representing a USB mass storage driver.
+ */
+struct USBMassStorageDriver {
+  /**
+   * @brief   Driver state.
+   */
+  mscstate_t                state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const USBMassStorageConfig *config;
+  /**
+   * @brief   Queue of threads waiting for endpoint events.
+   */
+  threads_queue_t           waiting;
+  /**
+   * @brief   Bulk IN transaction finished flag.
+   */
+  bool                      in_done;
+  /**
+   * @brief   Bulk OUT transaction finished flag.
+   */
+  bool                      out_done;
+  /**
+   * @brief   Current Command Block Wrapper.
+   */
+  msc_cbw_t                 cbw;
+  /**
+   * @brief   Current Command Status Wrapper.
+   */
+  msc_csw_t                 csw;
+  /**
+   * @brief   Fixed format sense data returned by REQUEST SENSE.
+   */
+  uint8_t                   sense[18];
+  /**
+   * @brief   Pipelined transfer buffers.
+   */
+  uint8_t                   buf[2][USB_MSC_BUFFERS_SIZE];
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void mscObjectInit(USBMassStorageDriver *mscp);
+  void mscStart(USBMassStorageDriver *mscp, const USBMassStorageConfig *config);
+  void mscStop(USBMassStorageDriver *mscp);
+  bool mscPerformTransaction(USBMassStorageDriver *mscp);
+  void mscConfigureHookI(USBMassStorageDriver *mscp);
+  void mscSuspendHookI(USBMassStorageDriver *mscp);
+  bool mscRequestsHook(USBDriver *usbp);
+  void mscDataTransmitted(USBDriver *usbp, usbep_t ep);
+  void mscDataReceived(USBDriver *usbp, usbep_t ep);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_USB_MSC == TRUE */
+
+#endif /* HAL_USB_MSC_H */
+
+/** @} */
@@ -66,6 +66,95 @@ static const struct M25QDriverVMT m25q_vmt = {
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if JESD216_BUS_MODE != JESD216_BUS_MODE_SPI
+#if QSPI_SUPPORTS_MEMMAP == TRUE
+/**
+ * @brief   Activates the memory mapped mode.
+ * @note    The bus must be in the acquired state.
+ *
+ * @param[in] devp      pointer to the @p M25QDriver object
+ * @param[out] addrp    pointer to the memory start address of the mapped
+ *                      flash or @p NULL
+ */
+static void m25q_start_memmap(M25QDriver *devp, uint8_t **addrp) {
+  qspi_command_t cmd;
+
+  /* Activating XIP mode in the device.*/
+  m25q_activate_xip(devp);
+
+  /* Putting the QSPI driver in memory mapped mode.*/
+  cmd.cfg = QSPI_CFG_CMD(M25Q_CMD_FAST_READ) |
+            QSPI_CFG_ADDR_SIZE_24 |
+#if JESD216_BUS_MODE == JESD216_BUS_MODE_QSPI1L
+            QSPI_CFG_CMD_MODE_ONE_LINE |
+            QSPI_CFG_ADDR_MODE_ONE_LINE |
+            QSPI_CFG_DATA_MODE_ONE_LINE |
+#elif JESD216_BUS_MODE == JESD216_BUS_MODE_QSPI2L
+            QSPI_CFG_CMD_MODE_TWO_LINES |
+            QSPI_CFG_ADDR_MODE_TWO_LINES |
+            QSPI_CFG_DATA_MODE_TWO_LINES |
+#else
+            QSPI_CFG_CMD_MODE_FOUR_LINES |
+            QSPI_CFG_ADDR_MODE_FOUR_LINES |
+            QSPI_CFG_DATA_MODE_FOUR_LINES |
+#endif
+            QSPI_CFG_ALT_MODE_FOUR_LINES |  /* Always 4 lines, note.*/
+            QSPI_CFG_ALT_SIZE_8 |
+            QSPI_CFG_SIOO |
+            QSPI_CFG_DUMMY_CYCLES(M25Q_READ_DUMMY_CYCLES - 2);
+
+  /* Starting QSPI memory mapped mode.*/
+  qspiMapFlash(devp->config->busp, &cmd, addrp);
+}
+
+/**
+ * @brief   Deactivates the memory mapped mode.
+ * @note    The bus must be in the acquired state.
+ *
+ * @param[in] devp      pointer to the @p M25QDriver object
+ */
+static void m25q_stop_memmap(M25QDriver *devp) {
+
+  /* Stopping QSPI memory mapped mode.*/
+  qspiUnmapFlash(devp->config->busp);
+
+  m25q_reset_xip(devp);
+}
+
+/**
+ * @brief   Suspends the memory mapped mode around a command operation.
+ * @note    The bus must be in the acquired state.
+ *
+ * @param[in] devp      pointer to the @p M25QDriver object
+ */
+static void m25q_memmap_suspend(M25QDriver *devp) {
+
+  if (devp->mapped && (devp->config->busp->state == QSPI_MEMMAP)) {
+    m25q_stop_memmap(devp);
+  }
+}
+
+/**
+ * @brief   Resumes the memory mapped mode after a command operation.
+ * @note    The bus must be in the acquired state.
+ *
+ * @param[in] devp      pointer to the @p M25QDriver object
+ */
+static void m25q_memmap_resume(M25QDriver *devp) {
+
+  if (devp->mapped && (devp->config->busp->state != QSPI_MEMMAP)) {
+    m25q_start_memmap(devp, NULL);
+  }
+}
+#else /* QSPI_SUPPORTS_MEMMAP == FALSE */
+#define m25q_memmap_suspend(devp)
+#define m25q_memmap_resume(devp)
+#endif /* QSPI_SUPPORTS_MEMMAP == FALSE */
+#else /* JESD216_BUS_MODE == JESD216_BUS_MODE_SPI */
+#define m25q_memmap_suspend(devp)
+#define m25q_memmap_resume(devp)
+#endif /* JESD216_BUS_MODE == JESD216_BUS_MODE_SPI */
+
 static flash_error_t m25q_read(void *instance, flash_offset_t offset,
                                size_t n, uint8_t *rp) {
   M25QDriver *devp = (M25QDriver *)instance;
@@ -87,9 +176,15 @@ static flash_error_t m25q_read(void *instance, flash_offset_t offset,
   /* FLASH_READY state while the operation is performed.*/
   devp->state = FLASH_READ;
 
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
   /* Actual read implementation.*/
   err = m25q_device_read(devp, offset, n, rp);
 
+  /* Memory mapped mode is restored if it was active.*/
+  m25q_memmap_resume(devp);
+
   /* Ready state again.*/
   devp->state = FLASH_READY;
 
@@ -120,9 +215,15 @@ static flash_error_t m25q_program(void *instance, flash_offset_t offset,
   /* FLASH_PGM state while the operation is performed.*/
   devp->state = FLASH_PGM;
 
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
   /* Actual program implementation.*/
   err = m25q_device_program(devp, offset, n, pp);
 
+  /* Memory mapped mode is restored if it was active.*/
+  m25q_memmap_resume(devp);
+
   /* Ready state again.*/
   devp->state = FLASH_READY;
 
@@ -150,7 +251,12 @@ static flash_error_t m25q_start_erase_all(void *instance) {
   /* FLASH_ERASE state while the operation is performed.*/
   devp->state = FLASH_ERASE;
 
-  /* Actual erase implementation.*/
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
+  /* Actual erase implementation, the memory mapped mode is restored by
+     m25q_query_erase() or m25q_verify_erase() when the erase operation
+     has completed.*/
   err = m25q_device_start_erase_all(devp);
 
   /* Ready state again.*/
@@ -182,7 +288,12 @@ static flash_error_t m25q_start_erase_sector(void *instance,
   /* FLASH_ERASE state while the operation is performed.*/
   devp->state = FLASH_ERASE;
 
-  /* Actual erase implementation.*/
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
+  /* Actual erase implementation, the memory mapped mode is restored by
+     m25q_query_erase() or m25q_verify_erase() when the erase operation
+     has completed.*/
   err = m25q_device_start_erase_sector(devp, sector);
 
   /* Bus released.*/
@@ -211,9 +322,15 @@ static flash_error_t m25q_verify_erase(void *instance,
   /* FLASH_READY state while the operation is performed.*/
   devp->state = FLASH_READ;
 
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
   /* Actual verify erase implementation.*/
   err = m25q_device_verify_erase(devp, sector);
 
+  /* Memory mapped mode is restored if it was active.*/
+  m25q_memmap_resume(devp);
+
   /* Ready state again.*/
   devp->state = FLASH_READY;
 
@@ -243,6 +360,9 @@ static flash_error_t m25q_query_erase(void *instance, uint32_t *msec) {
     /* The device is ready to accept commands.*/
     if (err == FLASH_NO_ERROR) {
       devp->state = FLASH_READY;
+
+      /* Memory mapped mode is restored if it was active.*/
+      m25q_memmap_resume(devp);
     }
 
     /* Bus released.*/
@@ -271,9 +391,15 @@ static flash_error_t m25q_read_sfdp(void *instance, flash_offset_t offset,
   /* Bus acquired.*/
   jesd216_bus_acquire(devp->config->busp, devp->config->buscfg);
 
+  /* Memory mapped mode is suspended during the command phase.*/
+  m25q_memmap_suspend(devp);
+
   /* Actual read SFDP implementation.*/
   err = m25q_device_read_sfdp(devp, offset, n, rp);
 
+  /* Memory mapped mode is restored if it was active.*/
+  m25q_memmap_resume(devp);
+
   /* The device is ready to accept commands.*/
   if (err == FLASH_NO_ERROR) {
     devp->state = FLASH_READY;
@@ -303,6 +429,11 @@ void m25qObjectInit(M25QDriver *devp) {
   devp->vmt         = &m25q_vmt;
   devp->state       = FLASH_STOP;
   devp->config      = NULL;
+#if JESD216_BUS_MODE != JESD216_BUS_MODE_SPI
+#if QSPI_SUPPORTS_MEMMAP == TRUE
+  devp->mapped      = false;
+#endif
+#endif
 }
 
 /**
@@ -374,6 +505,11 @@ void m25qStop(M25QDriver *devp) {
  * @details The memory mapping mode is only available when the QSPI mode
  *          is selected and the underlying QSPI controller supports the
  *          feature.
+ * @note    While the device is mapped the flash operations remain usable,
+ *          the mapping is transparently suspended during the command
+ *          phase and resumed afterwards. The mapped window must not be
+ *          accessed while an erase or program operation is in progress,
+ *          the mapping is restored when the operation completes.
  *
  * @param[in] devp      pointer to the @p M25QDriver object
  * @param[out] addrp    pointer to the memory start address of the mapped
@@ -382,37 +518,16 @@ void m25qStop(M25QDriver *devp) {
  * @api
  */
 void m25qMemoryMap(M25QDriver *devp, uint8_t **addrp) {
-  qspi_command_t cmd;
 
   /* Bus acquisition.*/
   jesd216_bus_acquire(devp->config->busp, devp->config->buscfg);
 
-  /* Activating XIP mode in the device.*/
-  m25q_activate_xip(devp);
-
-  /* Putting the QSPI driver in memory mapped mode.*/
-  cmd.cfg = QSPI_CFG_CMD(M25Q_CMD_FAST_READ) |
-            QSPI_CFG_ADDR_SIZE_24 |
-#if JESD216_BUS_MODE == JESD216_BUS_MODE_QSPI1L
-            QSPI_CFG_CMD_MODE_ONE_LINE |
-            QSPI_CFG_ADDR_MODE_ONE_LINE |
-            QSPI_CFG_DATA_MODE_ONE_LINE |
-#elif JESD216_BUS_MODE == JESD216_BUS_MODE_QSPI2L
-            QSPI_CFG_CMD_MODE_TWO_LINES |
-            QSPI_CFG_ADDR_MODE_TWO_LINES |
-            QSPI_CFG_DATA_MODE_TWO_LINES |
-#else
-            QSPI_CFG_CMD_MODE_FOUR_LINES |
-            QSPI_CFG_ADDR_MODE_FOUR_LINES |
-            QSPI_CFG_DATA_MODE_FOUR_LINES |
-#endif
-            QSPI_CFG_ALT_MODE_FOUR_LINES |  /* Always 4 lines, note.*/
-            QSPI_CFG_ALT_SIZE_8 |
-            QSPI_CFG_SIOO |
-            QSPI_CFG_DUMMY_CYCLES(M25Q_READ_DUMMY_CYCLES - 2);
-
   /* Starting QSPI memory mapped mode.*/
-  qspiMapFlash(devp->config->busp, &cmd, addrp);
+  m25q_start_memmap(devp, addrp);
+
+  /* The mapping is now transparently suspended and resumed by the
+     flash operations.*/
+  devp->mapped = true;
 
   /* Bus release.*/
   jesd216_bus_release(devp->config->busp);
@@ -430,10 +545,12 @@ void m25qMemoryUnmap(M25QDriver *devp) {
   /* Bus acquisition.*/
   jesd216_bus_acquire(devp->config->busp, devp->config->buscfg);
 
-  /* Stopping QSPI memory mapped mode.*/
-  qspiUnmapFlash(devp->config->busp);
-
-  m25q_reset_xip(devp);
+  /* Stopping QSPI memory mapped mode, unless an erase operation has
+     already suspended it.*/
+  devp->mapped = false;
+  if (devp->config->busp->state == QSPI_MEMMAP) {
+    m25q_stop_memmap(devp);
+  }
 
   /* Bus release.*/
   jesd216_bus_release(devp->config->busp);
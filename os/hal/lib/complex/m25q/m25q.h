@@ -147,6 +147,14 @@ typedef struct {
    * @brief   Device ID and unique ID.
    */
   uint8_t                       device_id[20];
+#if (JESD216_BUS_MODE != JESD216_BUS_MODE_SPI) || defined(__DOXYGEN__)
+#if (QSPI_SUPPORTS_MEMMAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Set while the device is kept in memory mapped mode.
+   */
+  bool                          mapped;
+#endif
+#endif
 } M25QDriver;
 
 /*===========================================================================*/
@@ -121,6 +121,11 @@ static void mfs_state_reset(MFSDriver *mfsp) {
   mfsp->current_counter = 0U;
   mfsp->next_offset     = 0U;
   mfsp->used_space      = 0U;
+  mfsp->gc_state        = MFS_GC_IDLE;
+  mfsp->gc_next         = 0U;
+  mfsp->gc_dest_offset  = 0U;
+  mfsp->gc_sector       = 0U;
+  mfsp->gc_end_sector   = 0U;
 
   for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
     mfsp->descriptors[i].offset = 0U;
@@ -246,6 +251,9 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
 
 /**
  * @brief   Verifies integrity of a record.
+ * @note    If the option @p MFS_CFG_STRONG_CHECKING is enabled then the
+ *          record payload is read back and its CRC is verified, the
+ *          transient buffer is clobbered in the process.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] dhdrp     pointer to the header to be checked
@@ -274,13 +282,32 @@ static mfs_error_t mfs_record_check(MFSDriver *mfsp,
         return MFS_NO_ERROR;
       }
 #if MFS_CFG_STRONG_CHECKING == TRUE
-      {
-        /* TODO: Checking the CRC while reading the record data.*/
-        (void)mfsp;
+      /* Checking the CRC while reading the record data, zero-sized
+         records are erase markers and carry no payload to verify.*/
+      if (dhdrp->fields.size > 0U) {
+        flash_offset_t doffset = offset + sizeof (mfs_data_header_t);
+        uint32_t size = dhdrp->fields.size;
+        uint16_t crc = 0xFFFFU;
+
+        while (size > 0U) {
+          size_t chunk = size <= MFS_CFG_BUFFER_SIZE ? size :
+                                                       MFS_CFG_BUFFER_SIZE;
+          RET_ON_ERROR(mfs_flash_read(mfsp, doffset, chunk,
+                                      mfsp->buffer.data8));
+          crc = crc16(crc, mfsp->buffer.data8, chunk);
+          doffset += (flash_offset_t)chunk;
+          size    -= (uint32_t)chunk;
+        }
+        if (crc != dhdrp->fields.crc) {
+          *sts = MFS_RECORD_CRC;
+          return MFS_NO_ERROR;
+        }
       }
 #else
       (void)mfsp;
 #endif
+      *sts = MFS_RECORD_OK;
+      return MFS_NO_ERROR;
     }
   }
 
@@ -289,6 +316,37 @@ static mfs_error_t mfs_record_check(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+/**
+ * @brief   Erases and verifies a single sector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] sector    sector to be erased
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_sector_erase(MFSDriver *mfsp, flash_sector_t sector) {
+  flash_error_t ferr;
+
+  ferr = flashStartEraseSector(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashWaitErase(mfsp->config->flashp);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashVerifyErase(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
+  return MFS_NO_ERROR;
+}
+
 /**
  * @brief   Erases and verifies all sectors belonging to a bank.
  *
@@ -311,24 +369,7 @@ static mfs_error_t mfs_bank_erase(MFSDriver *mfsp, mfs_bank_t bank) {
   }
 
   while (sector < end) {
-    flash_error_t ferr;
-
-    ferr = flashStartEraseSector(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashWaitErase(mfsp->config->flashp);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashVerifyErase(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-
+    RET_ON_ERROR(mfs_sector_erase(mfsp, sector));
     sector++;
   }
 
@@ -430,22 +471,24 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
                                          mfs_bank_t bank,
                                          mfs_bank_state_t *statep) {
   flash_offset_t hdr_offset, start_offset, end_offset;
+  mfs_data_header_t dhdr;
   mfs_record_state_t sts;
   bool warning = false;
 
   start_offset = mfs_flash_get_bank_offset(mfsp, bank);
   end_offset   = start_offset + mfsp->config->bank_size;
 
-  /* Scanning records.*/
+  /* Scanning records. The header is kept in a local copy because the
+     record check can use the transient buffer for data verification.*/
   hdr_offset = start_offset + (flash_offset_t)sizeof(mfs_bank_header_t);
   while (hdr_offset < end_offset) {
     /* Reading the current record header.*/
     RET_ON_ERROR(mfs_flash_read(mfsp, hdr_offset,
                                 sizeof (mfs_data_header_t),
-                                (void *)&mfsp->buffer.dhdr));
+                                (void *)&dhdr));
 
     /* Checking header/data integrity.*/
-    RET_ON_ERROR(mfs_record_check(mfsp, &mfsp->buffer.dhdr,
+    RET_ON_ERROR(mfs_record_check(mfsp, &dhdr,
                                   hdr_offset, end_offset, &sts));
     if (sts == MFS_RECORD_ERASED) {
       /* Record area fully erased, stopping scan.*/
@@ -453,16 +496,16 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
     }
     else if (sts == MFS_RECORD_OK) {
       /* Record OK.*/
-      uint32_t size = mfsp->buffer.dhdr.fields.size;
+      uint32_t size = dhdr.fields.size;
 
       /* Zero-sized records are erase markers.*/
       if (size == 0U) {
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].offset = 0U;
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].size   = 0U;
+        mfsp->descriptors[dhdr.fields.id - 1U].offset = 0U;
+        mfsp->descriptors[dhdr.fields.id - 1U].size   = 0U;
       }
       else {
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].offset = hdr_offset;
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].size   = size;
+        mfsp->descriptors[dhdr.fields.id - 1U].offset = hdr_offset;
+        mfsp->descriptors[dhdr.fields.id - 1U].size   = size;
       }
     }
     else if (sts == MFS_RECORD_CRC) {
@@ -475,6 +518,10 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
       warning = true;
       break;
     }
+
+    /* On the next header.*/
+    hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                  (flash_offset_t)dhdr.fields.size;
   }
 
   if (hdr_offset > end_offset) {
@@ -604,53 +651,126 @@ static mfs_error_t mfs_bank_mount(MFSDriver *mfsp,
 }
 
 /**
- * @brief   Enforces a garbage collection.
- * @details Storage data is compacted into a single bank.
+ * @brief   Starts an incremental garbage collection.
+ * @details The collection is advanced by @p mfs_gc_step() calls until the
+ *          state machine returns to @p MFS_GC_IDLE.
  *
- * @param[out] mfsp     pointer to the @p MFSDriver object
- * @return              The operation status.
+ * @param[in] mfsp      pointer to the @p MFSDriver object
  *
  * @notapi
  */
-static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
-  unsigned i;
-  mfs_bank_t sbank, dbank;
-  flash_offset_t dest_offset;
+static void mfs_gc_start(MFSDriver *mfsp) {
+  mfs_bank_t dbank;
 
-  sbank = mfsp->current_bank;
-  if (sbank == MFS_BANK_0) {
+  if (mfsp->current_bank == MFS_BANK_0) {
     dbank = MFS_BANK_1;
   }
   else {
     dbank = MFS_BANK_0;
   }
 
-  /* Write address.*/
-  dest_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
-                sizeof (mfs_bank_header_t);
+  mfsp->gc_next        = 0U;
+  mfsp->gc_dest_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
+                         sizeof (mfs_bank_header_t);
+  mfsp->gc_state       = MFS_GC_COPYING;
+}
 
-  /* Copying the most recent record instances only.*/
-  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
-    uint32_t totsize = mfsp->descriptors[i].size + sizeof (mfs_data_header_t);
-    if (mfsp->descriptors[i].offset != 0) {
-      RET_ON_ERROR(mfs_flash_copy(mfsp, dest_offset,
-                                  mfsp->descriptors[i].offset,
+/**
+ * @brief   Advances an incremental garbage collection by one step.
+ * @details A step is either the copy of one record to the destination
+ *          bank or the erasure of one source bank sector, the two most
+ *          expensive units of work. The bank swap happens atomically at
+ *          the copy/erase phase transition when the destination header
+ *          is written, an interrupted collection is recovered at mount
+ *          like an interrupted @p mfs_garbage_collect().
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_step(MFSDriver *mfsp) {
+
+  switch (mfsp->gc_state) {
+  case MFS_GC_COPYING:
+    /* Empty descriptors are skipped without consuming the step.*/
+    while ((mfsp->gc_next < (unsigned)MFS_CFG_MAX_RECORDS) &&
+           (mfsp->descriptors[mfsp->gc_next].offset == 0U)) {
+      mfsp->gc_next++;
+    }
+
+    if (mfsp->gc_next < (unsigned)MFS_CFG_MAX_RECORDS) {
+      /* Copying the most recent instance of one record.*/
+      uint32_t totsize = mfsp->descriptors[mfsp->gc_next].size +
+                         sizeof (mfs_data_header_t);
+
+      RET_ON_ERROR(mfs_flash_copy(mfsp, mfsp->gc_dest_offset,
+                                  mfsp->descriptors[mfsp->gc_next].offset,
                                   totsize));
-      mfsp->descriptors[i].offset = dest_offset;
-      dest_offset += totsize;
+      mfsp->descriptors[mfsp->gc_next].offset = mfsp->gc_dest_offset;
+      mfsp->gc_dest_offset += totsize;
+      mfsp->gc_next++;
+    }
+    else {
+      /* Copy phase complete, the bank swap is sealed by writing the
+         destination header, the source bank is erased afterward.*/
+      mfs_bank_t sbank = mfsp->current_bank;
+
+      if (sbank == MFS_BANK_0) {
+        mfsp->current_bank = MFS_BANK_1;
+        mfsp->gc_sector     = mfsp->config->bank0_start;
+        mfsp->gc_end_sector = mfsp->config->bank0_start +
+                              mfsp->config->bank0_sectors;
+      }
+      else {
+        mfsp->current_bank = MFS_BANK_0;
+        mfsp->gc_sector     = mfsp->config->bank1_start;
+        mfsp->gc_end_sector = mfsp->config->bank1_start +
+                              mfsp->config->bank1_sectors;
+      }
+      mfsp->current_counter += 1U;
+      mfsp->next_offset = mfsp->gc_dest_offset;
+
+      RET_ON_ERROR(mfs_bank_write_header(mfsp, mfsp->current_bank,
+                                         mfsp->current_counter));
+      mfsp->gc_state = MFS_GC_ERASING;
     }
+    break;
+
+  case MFS_GC_ERASING:
+    /* One source bank sector erased per step.*/
+    RET_ON_ERROR(mfs_sector_erase(mfsp, mfsp->gc_sector));
+    mfsp->gc_sector++;
+    if (mfsp->gc_sector >= mfsp->gc_end_sector) {
+      mfsp->gc_state = MFS_GC_IDLE;
+    }
+    break;
+
+  default:
+    return MFS_ERR_INTERNAL;
   }
 
-  /* New current bank.*/
-  mfsp->current_bank = dbank;
-  mfsp->current_counter += 1U;
-  mfsp->next_offset = dest_offset;
+  return MFS_NO_ERROR;
+}
 
-  /* The header is written after the data.*/
-  RET_ON_ERROR(mfs_bank_write_header(mfsp, dbank, mfsp->current_counter));
+/**
+ * @brief   Enforces a garbage collection.
+ * @details Storage data is compacted into a single bank, a collection
+ *          already in progress is completed.
+ *
+ * @param[out] mfsp     pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
 
-  /* The source bank is erased last.*/
-  RET_ON_ERROR(mfs_bank_erase(mfsp, sbank));
+  if (mfsp->gc_state == MFS_GC_IDLE) {
+    mfs_gc_start(mfsp);
+  }
+  while (mfsp->gc_state != MFS_GC_IDLE) {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+  }
 
   return MFS_NO_ERROR;
 }
@@ -999,6 +1119,13 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
     return MFS_ERR_INV_STATE;
   }
 
+  /* A partially performed incremental collection must be completed
+     before the bank content can be modified.*/
+  if (mfsp->gc_state != MFS_GC_IDLE) {
+    warning = true;
+    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+  }
+
   /* If the required space is beyond the available (compacted) block
      size then an error is returned.
      NOTE: The space for one extra header is reserved in order to allow
@@ -1090,6 +1217,13 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
     return MFS_ERR_NOT_FOUND;
   }
 
+  /* A partially performed incremental collection must be completed
+     before the bank content can be modified.*/
+  if (mfsp->gc_state != MFS_GC_IDLE) {
+    warning = true;
+    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+  }
+
   /* If the required space is beyond the available (compacted) block
      size then an internal error is returned, it should never happen.*/
   required = (flash_offset_t)sizeof (mfs_data_header_t);
@@ -1154,4 +1288,49 @@ mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp) {
   return mfs_garbage_collect(mfsp);
 }
 
+/**
+ * @brief   Advances a garbage collection by a bounded amount of work.
+ * @details Each step is either the copy of one record or the erasure of
+ *          one source bank sector, the longest indivisible operations
+ *          involved in a collection. The function can be invoked
+ *          periodically from a low priority thread in order to spread
+ *          the collection cost over time instead of paying it at once
+ *          inside a write operation. Records remain readable at any
+ *          point of the collection, a write or erase operation occurring
+ *          while a collection is in progress completes it first.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] steps     maximum number of steps to be performed, must be
+ *                      greater than zero
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if the collection has been completed.
+ * @retval MFS_WARN_GC  if the collection is still in progress, more calls
+ *                      are required to complete it.
+ * @retval MFS_ERR_INV_STATE if the driver is in not in @p MSG_READY state.
+ * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
+ *                      failures. Makes the driver enter the @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsPerformGarbageCollectionSteps(MFSDriver *mfsp,
+                                             unsigned steps) {
+
+  osalDbgCheck((mfsp != NULL) && (steps > 0U));
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  if (mfsp->gc_state == MFS_GC_IDLE) {
+    mfs_gc_start(mfsp);
+  }
+  while ((steps > 0U) && (mfsp->gc_state != MFS_GC_IDLE)) {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+    steps--;
+  }
+
+  return (mfsp->gc_state == MFS_GC_IDLE) ? MFS_NO_ERROR : MFS_WARN_GC;
+}
+
 /** @} */
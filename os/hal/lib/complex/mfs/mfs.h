@@ -170,6 +170,15 @@ typedef enum {
   MFS_RECORD_GARBAGE = 3
 } mfs_record_state_t;
 
+/**
+ * @brief   Type of an incremental garbage collection state.
+ */
+typedef enum {
+  MFS_GC_IDLE = 0,
+  MFS_GC_COPYING = 1,
+  MFS_GC_ERASING = 2
+} mfs_gc_state_t;
+
 /**
  * @brief   Type of a record identifier.
  */
@@ -319,6 +328,26 @@ typedef struct {
    * @note    Zero means that there is not a record with that id.
    */
   mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+  /**
+   * @brief   State of the incremental garbage collection.
+   */
+  mfs_gc_state_t            gc_state;
+  /**
+   * @brief   Next record descriptor to be copied by the collector.
+   */
+  unsigned                  gc_next;
+  /**
+   * @brief   Write position in the destination bank during collection.
+   */
+  flash_offset_t            gc_dest_offset;
+  /**
+   * @brief   Next source bank sector to be erased by the collector.
+   */
+  flash_sector_t            gc_sector;
+  /**
+   * @brief   First sector past the source bank erase range.
+   */
+  flash_sector_t            gc_end_sector;
   /**
    * @brief   Transient buffer.
    */
@@ -360,6 +389,8 @@ extern "C" {
                              size_t n, const uint8_t *buffer);
   mfs_error_t mfsEraseRecord(MFSDriver *devp, mfs_id_t id);
   mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp);
+  mfs_error_t mfsPerformGarbageCollectionSteps(MFSDriver *mfsp,
+                                               unsigned steps);
 #ifdef __cplusplus
 }
 #endif
@@ -33,10 +33,31 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Maximum number of axes in a @p sensor_sample_t.
+ */
+#if !defined(SENSOR_SAMPLE_MAX_AXES) || defined(__DOXYGEN__)
+#define SENSOR_SAMPLE_MAX_AXES      6
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+/**
+ * @brief   Data-ready delivery support.
+ * @details Delivery into an objects FIFO is only available when the
+ *          underlying kernel provides the objects FIFOs object.
+ */
+#if !defined(SENSOR_USE_DELIVERY) || defined(__DOXYGEN__)
+#if (defined(CH_CFG_USE_OBJ_FIFOS) && (CH_CFG_USE_OBJ_FIFOS == TRUE)) ||    \
+    defined(__DOXYGEN__)
+#define SENSOR_USE_DELIVERY         TRUE
+#else
+#define SENSOR_USE_DELIVERY         FALSE
+#endif
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -87,6 +108,86 @@ typedef struct {
   _base_sensor_data
 } BaseSensor;
 
+/**
+ * @brief   Type of a timestamped sensor sample set.
+ * @details Used by the batch read and delivery interfaces, only the
+ *          first @p get_channels_number() axes are significant.
+ */
+typedef struct {
+  /** @brief Acquisition system time.*/
+  systime_t             t;
+  /** @brief Sample raw data.*/
+  int32_t               axes[SENSOR_SAMPLE_MAX_AXES];
+} sensor_sample_t;
+
+#if (SENSOR_USE_DELIVERY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   BaseBatchSensor delivery methods.
+ */
+#define _base_batch_sensor_delivery_methods                                 \
+  /* Enables the device FIFO and registers the destination FIFO.*/          \
+  msg_t (*start_delivery)(void *instance, objects_fifo_t *ofp);             \
+  /* Disables the device FIFO and unregisters the destination FIFO.*/       \
+  msg_t (*stop_delivery)(void *instance);                                   \
+  /* Drains the device FIFO into the registered objects FIFO.*/             \
+  msg_t (*deliver)(void *instance);
+#else
+#define _base_batch_sensor_delivery_methods
+#endif
+
+/**
+ * @brief   BaseBatchSensor specific methods.
+ */
+#define _base_batch_sensor_methods_alone                                    \
+  /* Get the device FIFO depth in sample sets.*/                            \
+  size_t (*get_batch_size)(void *instance);                                 \
+  /* Reads up to n sample sets from the device FIFO in one bus
+     transaction.*/                                                         \
+  msg_t (*read_batch)(void *instance, sensor_sample_t samples[],            \
+                      size_t n, size_t *np);                                \
+  _base_batch_sensor_delivery_methods
+
+/**
+ * @brief   BaseBatchSensor specific methods with inherited ones.
+ */
+#define _base_batch_sensor_methods                                          \
+  _base_object_methods                                                      \
+  _base_batch_sensor_methods_alone
+
+/**
+ * @brief   @p BaseBatchSensor virtual methods table.
+ */
+struct BaseBatchSensorVMT {
+  _base_batch_sensor_methods
+};
+
+/**
+ * @brief   @p BaseBatchSensor specific data.
+ * @note    It is empty because @p BaseBatchSensor is only an interface
+ *          without implementation.
+ */
+#define _base_batch_sensor_data                                             \
+  _base_object_data
+
+/**
+ * @extends BaseObject
+ *
+ * @brief   Base batch sensor class.
+ * @details This optional interface gives access to the internal FIFO of
+ *          sensors supporting one: a single bus transaction returns up
+ *          to a full FIFO of timestamped sample sets instead of one
+ *          register-sized read per sample. On kernels providing objects
+ *          FIFOs the interface also supports interrupt-driven delivery,
+ *          the @p deliver() method is invoked from a thread woken by the
+ *          data-ready/watermark interrupt and moves the accumulated
+ *          samples into the registered objects FIFO.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct BaseBatchSensorVMT *vmt;
+  _base_batch_sensor_data
+} BaseBatchSensor;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -134,6 +235,87 @@ typedef struct {
 #define sensorReadCooked(ip, dp) (ip)->vmt->read_cooked(ip, dp)
 /** @} */
 
+/**
+ * @name    Macro Functions (BaseBatchSensor)
+ * @{
+ */
+/**
+ * @brief   Returns the device FIFO depth in sample sets.
+ *
+ * @param[in] ip        pointer to a @p BaseBatchSensor or derived class.
+ * @return              The device FIFO depth.
+ *
+ * @api
+ */
+#define sensorGetBatchSize(ip) (ip)->vmt->get_batch_size(ip)
+
+/**
+ * @brief   Reads up to @p n sample sets from the device FIFO.
+ * @details All the accumulated samples are returned with a single bus
+ *          transaction.
+ *
+ * @param[in] ip        pointer to a @p BaseBatchSensor or derived class.
+ * @param[out] sp       pointer to a @p sensor_sample_t array.
+ * @param[in] n         size of the array in sample sets.
+ * @param[out] np       number of sample sets actually read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorReadBatch(ip, sp, n, np) (ip)->vmt->read_batch(ip, sp, n, np)
+
+#if (SENSOR_USE_DELIVERY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts delivery into an objects FIFO.
+ * @details The device FIFO and its watermark interrupt are enabled, the
+ *          objects FIFO must be initialized with objects of type
+ *          @p sensor_sample_t.
+ *
+ * @param[in] ip        pointer to a @p BaseBatchSensor or derived class.
+ * @param[in] ofp       pointer to the destination @p objects_fifo_t.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorStartDelivery(ip, ofp) (ip)->vmt->start_delivery(ip, ofp)
+
+/**
+ * @brief   Stops delivery and disables the device FIFO.
+ *
+ * @param[in] ip        pointer to a @p BaseBatchSensor or derived class.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorStopDelivery(ip) (ip)->vmt->stop_delivery(ip)
+
+/**
+ * @brief   Drains the device FIFO into the registered objects FIFO.
+ * @details To be called from a thread woken by the data-ready/watermark
+ *          interrupt, samples are dropped when the objects FIFO has no
+ *          free objects.
+ *
+ * @param[in] ip        pointer to a @p BaseBatchSensor or derived class.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorDeliver(ip) (ip)->vmt->deliver(ip)
+#endif /* SENSOR_USE_DELIVERY == TRUE */
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -0,0 +1,174 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    bufstreams.c
+ * @brief   Buffered streams code.
+ *
+ * @addtogroup buffered_streams
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "bufstreams.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static size_t _writes(void *ip, const uint8_t *bp, size_t n) {
+  BufferedStream *bsp = ip;
+  size_t wr = 0;
+
+  while (n > 0) {
+    size_t cnt = bsp->size - bsp->offset;
+
+    /* Oversized chunks are forwarded directly, bypassing the buffer.*/
+    if ((bsp->offset == 0) && (n >= bsp->size)) {
+      return wr + streamWrite(bsp->stream, bp, n);
+    }
+
+    if (cnt > n)
+      cnt = n;
+    memcpy(bsp->buffer + bsp->offset, bp, cnt);
+    bsp->offset += cnt;
+    wr += cnt;
+    bp += cnt;
+    n -= cnt;
+    if (bsp->offset >= bsp->size)
+      bsFlush(bsp);
+  }
+
+  /* Newline-triggered flush, checked once per chunk.*/
+  if (bsp->flushnl && (bsp->offset > 0) &&
+      (memchr(bsp->buffer, '\n', bsp->offset) != NULL))
+    bsFlush(bsp);
+
+  return wr;
+}
+
+static size_t _reads(void *ip, uint8_t *bp, size_t n) {
+  BufferedStream *bsp = ip;
+
+  bsFlush(bsp);
+  return streamRead(bsp->stream, bp, n);
+}
+
+static msg_t _put(void *ip, uint8_t b) {
+  BufferedStream *bsp = ip;
+
+  bsp->buffer[bsp->offset++] = b;
+  if ((bsp->offset >= bsp->size) || (bsp->flushnl && (b == (uint8_t)'\n')))
+    bsFlush(bsp);
+  return MSG_OK;
+}
+
+static msg_t _get(void *ip) {
+  BufferedStream *bsp = ip;
+  uint8_t b;
+
+  bsFlush(bsp);
+  if (streamRead(bsp->stream, &b, 1) != 1)
+    return MSG_RESET;
+  return b;
+}
+
+static size_t _writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  while (iovcnt > 0) {
+    size_t done = _writes(ip, iov->base, iov->len);
+    wr += done;
+    if (done < iov->len)
+      break;
+    iov++;
+    iovcnt--;
+  }
+  return wr;
+}
+
+static size_t _readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  BufferedStream *bsp = ip;
+
+  bsFlush(bsp);
+  return streamReadV(bsp->stream, iov, iovcnt);
+}
+
+static const struct BufferedStreamVMT vmt = {(size_t)0, _writes, _reads,
+                                             _writev, _readv, _put, _get};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Buffered stream object initialization.
+ *
+ * @param[out] bsp      pointer to the @p BufferedStream object to be
+ *                      initialized
+ * @param[in] stream    pointer to the stream to be wrapped
+ * @param[in] buffer    pointer to the accumulation buffer
+ * @param[in] size      size of the accumulation buffer
+ * @param[in] flushnl   if @p true then writing a newline character also
+ *                      flushes the buffer, line-oriented logging is
+ *                      delivered promptly
+ */
+void bsObjectInit(BufferedStream *bsp, BaseSequentialStream *stream,
+                  uint8_t *buffer, size_t size, bool flushnl) {
+
+  osalDbgCheck((stream != NULL) && (buffer != NULL) && (size > 0U));
+
+  bsp->vmt     = &vmt;
+  bsp->stream  = stream;
+  bsp->buffer  = buffer;
+  bsp->size    = size;
+  bsp->offset  = 0;
+  bsp->flushnl = flushnl;
+}
+
+/**
+ * @brief   Flushes the accumulated data to the wrapped stream.
+ *
+ * @param[in] bsp       pointer to an initialized @p BufferedStream object
+ * @return              The number of bytes effectively written to the
+ *                      wrapped stream, a short count indicates that the
+ *                      wrapped stream rejected part of the data.
+ */
+size_t bsFlush(BufferedStream *bsp) {
+  size_t wr = 0;
+
+  if (bsp->offset > 0) {
+    wr = streamWrite(bsp->stream, bsp->buffer, bsp->offset);
+    bsp->offset = 0;
+  }
+  return wr;
+}
+
+/** @} */
@@ -0,0 +1,106 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    bufstreams.h
+ * @brief   Buffered streams structures and macros.
+
+ * @addtogroup buffered_streams
+ * @{
+ */
+
+#ifndef BUFSTREAMS_H
+#define BUFSTREAMS_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   @p BufferedStream specific data.
+ */
+#define _buffered_stream_data                                               \
+  _base_sequential_stream_data                                              \
+  /* Wrapped stream.*/                                                      \
+  BaseSequentialStream  *stream;                                            \
+  /* Pointer to the accumulation buffer.*/                                  \
+  uint8_t               *buffer;                                            \
+  /* Size of the accumulation buffer.*/                                     \
+  size_t                size;                                               \
+  /* Current fill level of the accumulation buffer.*/                       \
+  size_t                offset;                                             \
+  /* Flush when a newline character is written.*/                           \
+  bool                  flushnl;
+
+/**
+ * @brief   @p BufferedStream virtual methods table.
+ */
+struct BufferedStreamVMT {
+  _base_sequential_stream_methods
+};
+
+/**
+ * @extends BaseSequentialStream
+ *
+ * @brief   Buffered stream object.
+ * @details This class wraps another @p BaseSequentialStream and accumulates
+ *          written data into an application-supplied buffer, the buffer is
+ *          forwarded to the wrapped stream in a single write when it fills
+ *          up, when a newline is written if so configured, or when
+ *          @p bsFlush() is explicitly invoked. Write-heavy users such as
+ *          @p chprintf() thus perform few large writes instead of one VMT
+ *          call per character. Read operations flush the pending data then
+ *          are delegated to the wrapped stream.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct BufferedStreamVMT *vmt;
+  _buffered_stream_data
+} BufferedStream;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void bsObjectInit(BufferedStream *bsp, BaseSequentialStream *stream,
+                    uint8_t *buffer, size_t size, bool flushnl);
+  size_t bsFlush(BufferedStream *bsp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFSTREAMS_H */
+
+/** @} */
@@ -27,13 +27,43 @@
  * @{
  */
 
+#include <float.h>
+
 #include "hal.h"
 #include "chprintf.h"
 #include "memstreams.h"
 
 #define MAX_FILLER 11
+#define MAX_LL_FILLER 22
 #define FLOAT_PRECISION 9
 
+/*
+ * Output accumulator, formatted characters are collected here and
+ * flushed with bulk stream writes.
+ */
+typedef struct {
+  BaseSequentialStream  *chp;
+  int                   n;
+  size_t                fill;
+  uint8_t               buf[CHPRINTF_BUFFER_SIZE];
+} outbuf_t;
+
+static void ob_flush(outbuf_t *ob) {
+
+  if (ob->fill > 0U) {
+    streamWrite(ob->chp, ob->buf, ob->fill);
+    ob->fill = 0;
+  }
+}
+
+static void ob_put(outbuf_t *ob, char c) {
+
+  ob->buf[ob->fill++] = (uint8_t)c;
+  ob->n++;
+  if (ob->fill >= sizeof ob->buf)
+    ob_flush(ob);
+}
+
 static char *long_to_string_with_divisor(char *p,
                                          long num,
                                          unsigned radix,
@@ -72,14 +102,59 @@ static char *ch_ltoa(char *p, long num, unsigned radix) {
   return long_to_string_with_divisor(p, num, radix, 0);
 }
 
+#if CHPRINTF_USE_LONGLONG
+static char *ch_lltoa(char *p, unsigned long long num, unsigned radix) {
+  int i;
+  char *q;
+
+  q = p + MAX_LL_FILLER;
+  do {
+    i = (int)(num % radix);
+    i += '0';
+    if (i > '9')
+      i += 'A' - '0' - 10;
+    *--q = i;
+    num /= radix;
+  } while (num != 0);
+
+  i = (int)(p + MAX_LL_FILLER - q);
+  do
+    *p++ = *q++;
+  while (--i);
+
+  return p;
+}
+#endif
+
 #if CHPRINTF_USE_FLOAT
 static const long pow10[FLOAT_PRECISION] = {
     10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
 };
 
+/*
+ * Emits a symbolic form for values that cannot be converted, the sign
+ * has already been handled by the caller.
+ */
+static char *fnonfin(char *p, double num) {
+  const char *s = (num != num) ? "nan" : "inf";
+
+  while (*s != '\0') {
+    *p++ = *s++;
+  }
+
+  return p;
+}
+
 static char *ftoa(char *p, double num, unsigned long precision) {
   long l;
 
+  /* Non-finite values cannot be converted to integers, NaN is detected
+     by being not equal to itself, infinities by exceeding any finite
+     double.*/
+  if ((num != num) || (num > DBL_MAX)) {
+    return fnonfin(p, num);
+  }
+
   if ((precision == 0) || (precision > FLOAT_PRECISION))
     precision = FLOAT_PRECISION;
   precision = pow10[precision - 1];
@@ -90,6 +165,44 @@ static char *ftoa(char *p, double num, unsigned long precision) {
   l = (long)((num - l) * precision);
   return long_to_string_with_divisor(p, l, 10, precision / 10);
 }
+
+static char *etoa(char *p, double num, unsigned long precision) {
+  int exp = 0;
+
+  /* Non-finite values would never leave the normalization loops.*/
+  if ((num != num) || (num > DBL_MAX)) {
+    return fnonfin(p, num);
+  }
+
+  /* Normalizing the mantissa into [1, 10).*/
+  if (num != 0.0) {
+    while (num >= 10.0) {
+      num /= 10.0;
+      exp++;
+    }
+    while (num < 1.0) {
+      num *= 10.0;
+      exp--;
+    }
+  }
+
+  p = ftoa(p, num, precision);
+  *p++ = 'e';
+  if (exp < 0) {
+    *p++ = '-';
+    exp = -exp;
+  }
+  else
+    *p++ = '+';
+  if (exp >= 100) {
+    *p++ = (char)('0' + (exp / 100));
+    exp %= 100;
+  }
+  *p++ = (char)('0' + (exp / 10));
+  *p++ = (char)('0' + (exp % 10));
+
+  return p;
+}
 #endif
 
 /**
@@ -108,7 +221,18 @@ static char *ftoa(char *p, double num, unsigned long precision) {
  *          - <b>U</b> decimal unsigned long.
  *          - <b>c</b> character.
  *          - <b>s</b> string.
+ *          - <b>f</b> floating point in fixed notation, when
+ *            @p CHPRINTF_USE_FLOAT is enabled, precision selects the
+ *            fractional digits.
+ *          - <b>e</b> floating point in scientific notation, when
+ *            @p CHPRINTF_USE_FLOAT is enabled.
  *          .
+ *          When @p CHPRINTF_USE_LONGLONG is enabled the <b>ll</b>
+ *          modifier selects 64 bits arguments for the integer
+ *          conversions.
+ * @note    The output is accumulated in a stack buffer and written with
+ *          bulk stream operations, one flush per
+ *          @p CHPRINTF_BUFFER_SIZE characters plus a final one.
  *
  * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
  * @param[in] fmt       formatting string
@@ -121,23 +245,34 @@ static char *ftoa(char *p, double num, unsigned long precision) {
 int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
   char *p, *s, c, filler;
   int i, precision, width;
-  int n = 0;
   bool is_long, left_align;
   long l;
-#if CHPRINTF_USE_FLOAT
-  float f;
-  char tmpbuf[2*MAX_FILLER + 1];
+  outbuf_t ob;
+#if CHPRINTF_USE_LONGLONG
+  bool is_ll;
+  unsigned long long ll;
+#endif
+#if CHPRINTF_USE_FLOAT || CHPRINTF_USE_LONGLONG
+  char tmpbuf[MAX_LL_FILLER + MAX_FILLER + 1];
 #else
   char tmpbuf[MAX_FILLER + 1];
 #endif
+#if CHPRINTF_USE_FLOAT
+  float f;
+#endif
+
+  ob.chp = chp;
+  ob.n = 0;
+  ob.fill = 0;
 
   while (true) {
     c = *fmt++;
-    if (c == 0)
-      return n;
+    if (c == 0) {
+      ob_flush(&ob);
+      return ob.n;
+    }
     if (c != '%') {
-      streamPut(chp, (uint8_t)c);
-      n++;
+      ob_put(&ob, c);
       continue;
     }
     p = tmpbuf;
@@ -178,10 +313,20 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       }
     }
     /* Long modifier.*/
+#if CHPRINTF_USE_LONGLONG
+    is_ll = FALSE;
+#endif
     if (c == 'l' || c == 'L') {
       is_long = TRUE;
       if (*fmt)
         c = *fmt++;
+#if CHPRINTF_USE_LONGLONG
+      if (c == 'l' || c == 'L') {
+        is_ll = TRUE;
+        if (*fmt)
+          c = *fmt++;
+      }
+#endif
     }
     else
       is_long = (c >= 'A') && (c <= 'Z');
@@ -205,6 +350,18 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
     case 'd':
     case 'I':
     case 'i':
+#if CHPRINTF_USE_LONGLONG
+      if (is_ll) {
+        long long sll = va_arg(ap, long long);
+
+        if (sll < 0) {
+          *p++ = '-';
+          sll = -sll;
+        }
+        p = ch_lltoa(p, (unsigned long long)sll, 10);
+        break;
+      }
+#endif
       if (is_long)
         l = va_arg(ap, long);
       else
@@ -224,6 +381,15 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       }
       p = ftoa(p, f, precision);
       break;
+    case 'E':
+    case 'e':
+      f = (float) va_arg(ap, double);
+      if (f < 0) {
+        *p++ = '-';
+        f = -f;
+      }
+      p = etoa(p, f, precision);
+      break;
 #endif
     case 'X':
     case 'x':
@@ -237,6 +403,13 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
     case 'o':
       c = 8;
 unsigned_common:
+#if CHPRINTF_USE_LONGLONG
+      if (is_ll) {
+        ll = va_arg(ap, unsigned long long);
+        p = ch_lltoa(p, ll, c);
+        break;
+      }
+#endif
       if (is_long)
         l = va_arg(ap, unsigned long);
       else
@@ -254,23 +427,19 @@ unsigned_common:
       width = -width;
     if (width < 0) {
       if (*s == '-' && filler == '0') {
-        streamPut(chp, (uint8_t)*s++);
-        n++;
+        ob_put(&ob, *s++);
         i--;
       }
       do {
-        streamPut(chp, (uint8_t)filler);
-        n++;
+        ob_put(&ob, filler);
       } while (++width != 0);
     }
     while (--i >= 0) {
-      streamPut(chp, (uint8_t)*s++);
-      n++;
+      ob_put(&ob, *s++);
     }
 
     while (width) {
-      streamPut(chp, (uint8_t)filler);
-      n++;
+      ob_put(&ob, filler);
       width--;
     }
   }
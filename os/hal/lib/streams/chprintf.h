@@ -34,6 +34,25 @@
 #define CHPRINTF_USE_FLOAT          FALSE
 #endif
 
+/**
+ * @brief   Long long type support.
+ * @details When enabled the <b>ll</b> modifier is recognized and 64 bits
+ *          integers can be printed with the d/i/u/x/o conversions.
+ */
+#if !defined(CHPRINTF_USE_LONGLONG) || defined(__DOXYGEN__)
+#define CHPRINTF_USE_LONGLONG       FALSE
+#endif
+
+/**
+ * @brief   Output buffer size.
+ * @details Formatted output is accumulated in a stack buffer of this size
+ *          and flushed with bulk stream writes instead of one
+ *          @p streamPut() per character.
+ */
+#if !defined(CHPRINTF_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CHPRINTF_BUFFER_SIZE        32
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -0,0 +1,158 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    itmstreams.c
+ * @brief   ITM streams code.
+ *
+ * @addtogroup itm_streams
+ * @{
+ */
+
+#include "hal.h"
+#include "itmstreams.h"
+
+#if defined(ITM) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Checks if the stimulus port can accept data.
+ *
+ * @param[in] port      stimulus port number
+ * @return              The port status.
+ */
+static bool itm_enabled(uint32_t port) {
+
+  return ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U) &&
+         ((ITM->TER & (1UL << port)) != 0U);
+}
+
+/**
+ * @brief   Sends a byte through the stimulus port.
+ * @details Spins while the port FIFO is busy, the wait is a few cycles
+ *          at typical trace clock speeds.
+ *
+ * @param[in] port      stimulus port number
+ * @param[in] b         byte to be sent
+ */
+static void itm_put(uint32_t port, uint8_t b) {
+
+  while (ITM->PORT[port].u32 == 0UL) {
+  }
+  ITM->PORT[port].u8 = b;
+}
+
+static size_t writes(void *ip, const uint8_t *bp, size_t n) {
+  ITMStream *isp = ip;
+  size_t i;
+
+  if (!itm_enabled(isp->port)) {
+    /* Sink semantics, data is discarded while the probe has the ITM or
+       the port disabled.*/
+    return n;
+  }
+  for (i = 0; i < n; i++) {
+    itm_put(isp->port, bp[i]);
+  }
+  return n;
+}
+
+static size_t reads(void *ip, uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+  (void)n;
+
+  return 0;
+}
+
+static msg_t put(void *ip, uint8_t b) {
+  ITMStream *isp = ip;
+
+  if (itm_enabled(isp->port)) {
+    itm_put(isp->port, b);
+  }
+  return MSG_OK;
+}
+
+static msg_t get(void *ip) {
+
+  (void)ip;
+
+  return MSG_RESET;
+}
+
+static size_t writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  while (iovcnt > 0) {
+    wr += writes(ip, iov->base, iov->len);
+    iov++;
+    iovcnt--;
+  }
+  return wr;
+}
+
+static size_t readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+
+  (void)ip;
+  (void)iov;
+  (void)iovcnt;
+
+  return 0;
+}
+
+static const struct ITMStreamVMT vmt = {(size_t)0, writes, reads,
+                                        writev, readv, put, get};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   ITM stream object initialization.
+ * @note    The ITM itself is enabled by the debug probe, the stream does
+ *          not touch the trace configuration registers.
+ *
+ * @param[out] isp      pointer to the @p ITMStream object to be initialized
+ * @param[in] port      stimulus port to be used, 0..31
+ */
+void itmObjectInit(ITMStream *isp, uint32_t port) {
+
+  osalDbgCheck((isp != NULL) && (port < 32U));
+
+  isp->vmt  = &vmt;
+  isp->port = port;
+}
+
+#endif /* defined(ITM) */
+
+/** @} */
@@ -0,0 +1,96 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    itmstreams.h
+ * @brief   ITM streams structures and macros.
+
+ * @addtogroup itm_streams
+ * @{
+ */
+
+#ifndef ITMSTREAMS_H
+#define ITMSTREAMS_H
+
+#if defined(ITM) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   @p ITMStream specific data.
+ */
+#define _itm_stream_data                                                    \
+  _base_sequential_stream_data                                              \
+  /* Stimulus port number.*/                                                \
+  uint32_t              port;
+
+/**
+ * @brief   @p ITMStream virtual methods table.
+ */
+struct ITMStreamVMT {
+  _base_sequential_stream_methods
+};
+
+/**
+ * @extends BaseSequentialStream
+ *
+ * @brief   ITM stream object.
+ * @details Write-only stream sending the data through an ITM stimulus
+ *          port. Data is silently discarded while the ITM or the port
+ *          are disabled by the debug probe, so the stream can stay in
+ *          production code at near-zero cost when no probe is attached.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct ITMStreamVMT *vmt;
+  _itm_stream_data
+} ITMStream;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void itmObjectInit(ITMStream *isp, uint32_t port);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* defined(ITM) */
+
+#endif /* ITMSTREAMS_H */
+
+/** @} */
@@ -84,7 +84,36 @@ static msg_t _get(void *ip) {
   return b;
 }
 
-static const struct MemStreamVMT vmt = {(size_t)0, _writes, _reads, _put, _get};
+static size_t _writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  while (iovcnt > 0) {
+    size_t done = _writes(ip, iov->base, iov->len);
+    wr += done;
+    if (done < iov->len)
+      break;
+    iov++;
+    iovcnt--;
+  }
+  return wr;
+}
+
+static size_t _readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t rd = 0;
+
+  while (iovcnt > 0) {
+    size_t done = _reads(ip, iov->base, iov->len);
+    rd += done;
+    if (done < iov->len)
+      break;
+    iov++;
+    iovcnt--;
+  }
+  return rd;
+}
+
+static const struct MemStreamVMT vmt = {(size_t)0, _writes, _reads,
+                                        _writev, _readv, _put, _get};
 
 /*===========================================================================*/
 /* Driver exported functions.                                                */
@@ -73,7 +73,30 @@ static msg_t get(void *ip) {
   return 4;
 }
 
-static const struct NullStreamVMT vmt = {(size_t)0, writes, reads, put, get};
+static size_t writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  (void)ip;
+
+  while (iovcnt > 0) {
+    wr += iov->len;
+    iov++;
+    iovcnt--;
+  }
+  return wr;
+}
+
+static size_t readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+
+  (void)ip;
+  (void)iov;
+  (void)iovcnt;
+
+  return 0;
+}
+
+static const struct NullStreamVMT vmt = {(size_t)0, writes, reads,
+                                         writev, readv, put, get};
 
 /*===========================================================================*/
 /* Driver exported functions.                                                */
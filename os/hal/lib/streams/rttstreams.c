@@ -0,0 +1,191 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    rttstreams.c
+ * @brief   RTT streams code.
+ *
+ * @addtogroup rtt_streams
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "rttstreams.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   The RTT control block.
+ * @note    Located by the host probe by scanning the RAM for the
+ *          identifier string, which is assembled at run time so it
+ *          cannot be matched in the flash image by mistake.
+ */
+rtt_control_t rtt_control;
+
+/*===========================================================================*/
+/* Driver local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Storage of the up buffer.
+ */
+static uint8_t rtt_up_buffer[RTT_STREAM_BUFFER_SIZE];
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Copies data into the ring, non blocking.
+ * @details Data in excess of the free space is discarded, one slot is
+ *          kept empty in order to distinguish the full condition.
+ *
+ * @param[in] up        pointer to the up buffer descriptor
+ * @param[in] bp        pointer to the data to be written
+ * @param[in] n         number of bytes to be written
+ * @return              The number of bytes effectively stored.
+ */
+static size_t rtt_write(rtt_buffer_t *up, const uint8_t *bp, size_t n) {
+  uint32_t wroff = up->wroff;
+  uint32_t rdoff = up->rdoff;
+  uint32_t free = (rdoff + up->size - wroff - 1U) % up->size;
+  size_t stored;
+
+  if (n > (size_t)free) {
+    n = (size_t)free;
+  }
+  stored = n;
+
+  while (n > 0U) {
+    uint32_t chunk = up->size - wroff;
+
+    if ((size_t)chunk > n) {
+      chunk = (uint32_t)n;
+    }
+    memcpy(&up->buffer[wroff], bp, (size_t)chunk);
+    bp    += chunk;
+    n     -= (size_t)chunk;
+    wroff  = (wroff + chunk) % up->size;
+  }
+
+  /* The offset is published after the data, the probe reads it first.*/
+  up->wroff = wroff;
+
+  return stored;
+}
+
+static size_t writes(void *ip, const uint8_t *bp, size_t n) {
+  RTTStream *rsp = ip;
+  size_t stored;
+
+  stored = rtt_write(rsp->up, bp, n);
+  rsp->dropped += (uint32_t)(n - stored);
+
+  /* Sink semantics, discarded data is accounted but the write never
+     fails nor blocks.*/
+  return n;
+}
+
+static size_t reads(void *ip, uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+  (void)n;
+
+  return 0;
+}
+
+static msg_t put(void *ip, uint8_t b) {
+
+  (void) writes(ip, &b, 1);
+  return MSG_OK;
+}
+
+static msg_t get(void *ip) {
+
+  (void)ip;
+
+  return MSG_RESET;
+}
+
+static size_t writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  while (iovcnt > 0) {
+    wr += writes(ip, iov->base, iov->len);
+    iov++;
+    iovcnt--;
+  }
+  return wr;
+}
+
+static size_t readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+
+  (void)ip;
+  (void)iov;
+  (void)iovcnt;
+
+  return 0;
+}
+
+static const struct RTTStreamVMT vmt = {(size_t)0, writes, reads,
+                                        writev, readv, put, get};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   RTT stream object initialization.
+ * @details The shared control block is initialized on the first call,
+ *          further streams attach to the same up buffer.
+ *
+ * @param[out] rsp      pointer to the @p RTTStream object to be initialized
+ */
+void rttObjectInit(RTTStream *rsp) {
+
+  osalDbgCheck(rsp != NULL);
+
+  if (rtt_control.up.buffer == NULL) {
+    rtt_control.nup       = 1;
+    rtt_control.ndown     = 0;
+    rtt_control.up.name   = RTT_STREAM_BUFFER_NAME;
+    rtt_control.up.buffer = rtt_up_buffer;
+    rtt_control.up.size   = (uint32_t)RTT_STREAM_BUFFER_SIZE;
+    rtt_control.up.wroff  = 0U;
+    rtt_control.up.rdoff  = 0U;
+    rtt_control.up.flags  = 0U;
+
+    /* The identifier is written last and assembled in two pieces so the
+       probe cannot match a copy of it residing in flash.*/
+    strncpy(rtt_control.id, "SEGGER", sizeof rtt_control.id);
+    strncat(rtt_control.id, " RTT", (sizeof rtt_control.id) - 7U);
+  }
+
+  rsp->vmt     = &vmt;
+  rsp->up      = &rtt_control.up;
+  rsp->dropped = 0U;
+}
+
+/** @} */
@@ -0,0 +1,165 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    rttstreams.h
+ * @brief   RTT streams structures and macros.
+
+ * @addtogroup rtt_streams
+ * @{
+ */
+
+#ifndef RTTSTREAMS_H
+#define RTTSTREAMS_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the RTT up buffer.
+ */
+#if !defined(RTT_STREAM_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define RTT_STREAM_BUFFER_SIZE      1024
+#endif
+
+/**
+ * @brief   Name of the RTT up buffer.
+ */
+#if !defined(RTT_STREAM_BUFFER_NAME) || defined(__DOXYGEN__)
+#define RTT_STREAM_BUFFER_NAME      "Terminal"
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an RTT ring buffer descriptor.
+ * @note    The layout matches the descriptors expected by the RTT host
+ *          tools, it must not be changed.
+ */
+typedef struct {
+  /**
+   * @brief   Buffer name shown by the host tools.
+   */
+  const char            *name;
+  /**
+   * @brief   Pointer to the data buffer.
+   */
+  uint8_t               *buffer;
+  /**
+   * @brief   Size of the data buffer.
+   */
+  uint32_t              size;
+  /**
+   * @brief   Write offset, written by the target.
+   */
+  volatile uint32_t     wroff;
+  /**
+   * @brief   Read offset, written by the host probe.
+   */
+  volatile uint32_t     rdoff;
+  /**
+   * @brief   Buffer flags.
+   */
+  uint32_t              flags;
+} rtt_buffer_t;
+
+/**
+ * @brief   Type of the RTT control block.
+ * @note    The host probe locates this structure in RAM by scanning for
+ *          its identifier string, the layout must not be changed.
+ */
+typedef struct {
+  /**
+   * @brief   Identifier string, filled at run time.
+   */
+  char                  id[16];
+  /**
+   * @brief   Number of up (target to host) buffers.
+   */
+  int32_t               nup;
+  /**
+   * @brief   Number of down (host to target) buffers.
+   */
+  int32_t               ndown;
+  /**
+   * @brief   The up buffer descriptor.
+   */
+  rtt_buffer_t          up;
+} rtt_control_t;
+
+/**
+ * @brief   @p RTTStream specific data.
+ */
+#define _rtt_stream_data                                                    \
+  _base_sequential_stream_data                                              \
+  /* Pointer to the up buffer descriptor.*/                                 \
+  rtt_buffer_t          *up;                                                \
+  /* Bytes discarded because the buffer was full.*/                         \
+  uint32_t              dropped;
+
+/**
+ * @brief   @p RTTStream virtual methods table.
+ */
+struct RTTStreamVMT {
+  _base_sequential_stream_methods
+};
+
+/**
+ * @extends BaseSequentialStream
+ *
+ * @brief   RTT stream object.
+ * @details Write-only stream storing the data into a shared-memory ring
+ *          read by the debug probe through the memory access port,
+ *          without involving the CPU. Writes never block, data in excess
+ *          of the free space is discarded and accounted in a counter so
+ *          the stream cannot perturb the timing of the traced code.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct RTTStreamVMT *vmt;
+  _rtt_stream_data
+} RTTStream;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void rttObjectInit(RTTStream *rsp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTTSTREAMS_H */
+
+/** @} */
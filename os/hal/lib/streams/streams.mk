@@ -1,7 +1,10 @@
 # RT Shell files.
-STREAMSSRC = $(CHIBIOS)/os/hal/lib/streams/chprintf.c \
+STREAMSSRC = $(CHIBIOS)/os/hal/lib/streams/bufstreams.c \
+             $(CHIBIOS)/os/hal/lib/streams/chprintf.c \
+             $(CHIBIOS)/os/hal/lib/streams/itmstreams.c \
              $(CHIBIOS)/os/hal/lib/streams/memstreams.c \
-             $(CHIBIOS)/os/hal/lib/streams/nullstreams.c
+             $(CHIBIOS)/os/hal/lib/streams/nullstreams.c \
+             $(CHIBIOS)/os/hal/lib/streams/rttstreams.c
 
 STREAMSINC = $(CHIBIOS)/os/hal/lib/streams
 
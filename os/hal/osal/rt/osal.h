@@ -256,7 +256,8 @@ typedef struct {
  *
  * @api
  */
-#define osalDbgAssert(c, remark) chDbgAssert(c, remark)
+#define osalDbgAssert(c, remark) chDbgAssertClassed(CH_DBG_CLASS_HAL,  \
+                                                    c, remark)
 
 /**
  * @brief   Function parameters check.
@@ -268,7 +269,7 @@ typedef struct {
  *
  * @api
  */
-#define osalDbgCheck(c) chDbgCheck(c)
+#define osalDbgCheck(c) chDbgCheckClassed(CH_DBG_CLASS_HAL, c)
 
 /**
  * @brief   I-Class state check.
@@ -157,6 +157,22 @@ struct ADCDriver {
   Semaphore                 semaphore;
 #endif
 #endif /* ADC_USE_MUTUAL_EXCLUSION */
+#if (ADC_USE_DECIMATION == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Decimation shift, zero if the decimation stage is disabled.
+   */
+  uint8_t                   dshift;
+  /**
+   * @brief   Buffer receiving the decimated samples.
+   */
+  adcsample_t               *dbuf;
+#endif /* ADC_USE_DECIMATION */
+#if (ADC_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timestamp of the latest buffer event.
+   */
+  systime_t                 timestamp;
+#endif /* ADC_USE_TIMESTAMP */
 #if defined(ADC_DRIVER_EXT_FIELDS)
   ADC_DRIVER_EXT_FIELDS
 #endif
@@ -137,6 +137,12 @@ struct GPTDriver {
    */
   const GPTConfig           *config;
 
+#if (GPT_USE_COUNTER64 == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Counter overflows accumulator.
+   */
+  volatile uint32_t         wraps;
+#endif /* GPT_USE_COUNTER64 */
 #if defined(GPT_DRIVER_EXT_FIELDS)
   GPT_DRIVER_EXT_FIELDS
 #endif
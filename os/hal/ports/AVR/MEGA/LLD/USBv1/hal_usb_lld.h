@@ -119,6 +119,20 @@ typedef struct {
    * @brief   Waiting thread.
    */
   thread_reference_t            thread;
+#endif
+#if (USB_USE_TRANSFER_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Queued transfer buffer pointer.
+   */
+  usbbufptr_t                   next_txbuf;
+  /**
+   * @brief   Queued transfer size.
+   */
+  size_t                        next_txsize;
+  /**
+   * @brief   Queued transfer pending flag.
+   */
+  bool                          next_pending;
 #endif
   /* End of the mandatory fields. */
   /**
@@ -148,6 +162,20 @@ typedef struct {
    * @brief   Waiting thread.
    */
   thread_reference_t            thread;
+#endif
+#if (USB_USE_TRANSFER_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Queued transfer buffer pointer.
+   */
+  uint8_t                       *next_rxbuf;
+  /**
+   * @brief   Queued transfer size.
+   */
+  size_t                        next_rxsize;
+  /**
+   * @brief   Queued transfer pending flag.
+   */
+  bool                          next_pending;
 #endif
   /* End of the mandatory fields.*/
   uint8_t                      rxpkts;
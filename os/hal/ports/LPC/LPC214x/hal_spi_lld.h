@@ -162,6 +162,16 @@ struct SPIDriver {
   Semaphore             semaphore;
 #endif
 #endif /* SPI_USE_MUTUAL_EXCLUSION */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the queued transactions list.
+   */
+  spi_transaction_t         *txnhead;
+  /**
+   * @brief   Tail of the queued transactions list.
+   */
+  spi_transaction_t         *txntail;
+#endif /* SPI_USE_TRANSACTIONS */
 #if defined(SPI_DRIVER_EXT_FIELDS)
   SPI_DRIVER_EXT_FIELDS
 #endif
@@ -246,6 +246,10 @@ cryerror_t sama_aes_lld_process_dma(CRYDriver *cryp,  aesparams *params,
 
 	}
 
+	//dma buffers cache is cleaned/invalidated before the transfer
+	cacheCleanRegion((uint8_t *)in, indata_len);
+	cacheCleanInvalidateRegion(out, indata_len);
+
 	osalSysLock();
 
 	dmaChannelEnable(cryp->dmarx);
@@ -255,6 +259,9 @@ cryerror_t sama_aes_lld_process_dma(CRYDriver *cryp,  aesparams *params,
 
 	osalSysUnlock();
 
+	//dma buffer invalidation because data read through the cache
+	cacheInvalidateRegion(out, indata_len);
+
 	osalMutexUnlock(&cryp->mutex);
 #endif //#if defined(SAMA_DMA_REQUIRED)
 	return CRY_NOERROR;
@@ -95,6 +95,10 @@ static cryerror_t sama_gcm_lld_process_dma(CRYDriver *cryp,cgmcontext * cxt)
 	//Enable aes interrupt
 	AES->AES_IER = AES_IER_DATRDY;
 
+	//dma buffers cache is cleaned/invalidated before the transfer
+	cacheCleanRegion(cxt->in, cxt->c_size);
+	cacheCleanInvalidateRegion(cxt->out, cxt->c_size);
+
 	osalSysLock();
 
 	dmaChannelEnable(cryp->dmarx);
@@ -104,6 +108,9 @@ static cryerror_t sama_gcm_lld_process_dma(CRYDriver *cryp,cgmcontext * cxt)
 
 	osalSysUnlock();
 
+	//dma buffer invalidation because data read through the cache
+	cacheInvalidateRegion(cxt->out, cxt->c_size);
+
 
 #endif //#if defined(SAMA_DMA_REQUIRED)
 	return CRY_NOERROR;
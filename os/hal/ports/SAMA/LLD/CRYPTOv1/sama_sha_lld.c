@@ -326,25 +326,77 @@ static uint32_t processBlockPolling(const uint8_t *data,uint32_t len, uint32_t b
 static uint32_t processBlockDMA(CRYDriver *cryp, const uint8_t *data,uint32_t len, uint32_t block_size)
 {
 	uint32_t processed = 0;
+	uint32_t nblocks = len / block_size;
 
-	while ((len - processed) >= block_size) {
+	while (nblocks > 0) {
+		lld_view0 *list;
+		uint32_t count, i;
+
+		// the whole run of blocks is described by a descriptor chain,
+		// one interrupt per chain instead of one per block
+		count = nblocks;
+		if (count > SAMA_DMA_DESC_POOL_SIZE)
+			count = SAMA_DMA_DESC_POOL_SIZE;
+		while (((list = dmaDescAllocate(count)) == NULL) && (count > 1))
+			count /= 2;
+
+		if (list == NULL) {
+			// descriptors pool exhausted, programming a single block directly
+			dmaChannelSetSource(cryp->dmatx, &data[processed]);
+			dmaChannelSetDestination(cryp->dmatx, SHA->SHA_IDATAR);
+			dmaChannelSetTransactionSize(cryp->dmatx,
+					(block_size / DMA_DATA_WIDTH_TO_BYTE(cryp->dmawith)));
+
+			//dma buffer cache is cleaned before the transfer
+			cacheCleanRegion((uint8_t *)&data[processed], block_size);
+
+			osalSysLock();
+
+			dmaChannelEnable(cryp->dmatx);
+
+			osalThreadSuspendS(&cryp->thread);
+
+			osalSysUnlock();
+
+			processed += block_size;
+			nblocks--;
+			continue;
+		}
+
+		for (i = 0; i < count; i++) {
+			dmaDescSetup(&list[i],
+					(i == (count - 1)) ? NULL : &list[i + 1],
+					XDMA_UBC_NSEN_UPDATED |
+					XDMA_UBC_UBLEN(block_size /
+							DMA_DATA_WIDTH_TO_BYTE(cryp->dmawith)),
+					&data[processed + (i * block_size)]);
+		}
 
-		// load data in the sha input registers
-		// Writing channel
-		dmaChannelSetSource(cryp->dmatx, &data[processed]);
 		dmaChannelSetDestination(cryp->dmatx, SHA->SHA_IDATAR);
-		dmaChannelSetTransactionSize(cryp->dmatx,
-				(block_size / DMA_DATA_WIDTH_TO_BYTE(cryp->dmawith)));
+
+		//dma buffer cache is cleaned before the transfer
+		cacheCleanRegion((uint8_t *)&data[processed], count * block_size);
 
 		osalSysLock();
 
-		dmaChannelEnable(cryp->dmatx);
+		dmaChannelStartList(cryp->dmatx, cryp->txdmamode,
+				XDMAC_CNDC_NDSUP_SRC_PARAMS_UPDATED |
+				XDMAC_CNDC_NDVIEW_NDV0,
+				list, count);
 
 		osalThreadSuspendS(&cryp->thread);
 
 		osalSysUnlock();
 
-		processed += block_size;
+		dmaDescRelease(list, count);
+
+		// restore block interrupts for the single-transfer paths sharing
+		// the channel
+		dmaChannelDisableInt(cryp->dmatx, XDMAC_CID_LID);
+		dmaChannelEnableInt(cryp->dmatx, XDMAC_CIE_BIE);
+
+		processed += count * block_size;
+		nblocks -= count;
 	}
 
 	return processed;
@@ -257,6 +257,10 @@ cryerror_t sama_tdes_lld_dma(CRYDriver *cryp, tdes_config_t *params,
 //enable interrutps
 	TDES->TDES_IER = TDES_IER_DATRDY;
 
+	//dma buffers cache is cleaned/invalidated before the transfer
+	cacheCleanRegion((uint8_t *)data, data_len);
+	cacheCleanInvalidateRegion(out, data_len);
+
 	osalSysLock();
 
 	dmaChannelEnable(cryp->dmarx);
@@ -265,6 +269,9 @@ cryerror_t sama_tdes_lld_dma(CRYDriver *cryp, tdes_config_t *params,
 	osalThreadSuspendS(&cryp->thread);
 	osalSysUnlock();
 
+	//dma buffer invalidation because data read through the cache
+	cacheInvalidateRegion(out, data_len);
+
 	osalMutexUnlock(&cryp->mutex);
 
 	return CRY_NOERROR;
@@ -44,6 +44,16 @@ sama_dma_channel_t _sama_dma_channel_t[XDMAC_CHANNELS];
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Pool of view0 linked list descriptors shared by all channels.
+ */
+ALIGNED_VAR(4) static lld_view0 dma_desc_pool[SAMA_DMA_DESC_POOL_SIZE];
+
+/**
+ * @brief   Allocation state of the descriptors pool.
+ */
+static uint8_t dma_desc_state[SAMA_DMA_DESC_POOL_SIZE];
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -298,6 +308,111 @@ void dmaChannelRelease(sama_dma_channel_t *dmachp) {
   (dmachp)->state = SAMA_DMA_FREE;
 }
 
+/**
+ * @brief   Allocates a chain of linked list descriptors.
+ * @details A contiguous run of @p n descriptors is taken from the shared
+ *          pool, the descriptors are not initialized.
+ * @note    This function can be invoked in both ISR or thread context.
+ * @post    After use the chain must be returned using @p dmaDescRelease().
+ *
+ * @param[in] n         number of descriptors to be allocated
+ * @return              A pointer to the first descriptor of the chain or
+ *                      @p NULL if the pool cannot satisfy the request.
+ *
+ * @special
+ */
+lld_view0 *dmaDescAllocate(size_t n) {
+
+  size_t i, run = 0;
+
+  osalDbgCheck((n > 0U) && (n <= SAMA_DMA_DESC_POOL_SIZE));
+
+  for (i = 0; i < SAMA_DMA_DESC_POOL_SIZE; i++) {
+    if (dma_desc_state[i] != SAMA_DMA_FREE) {
+      run = 0;
+      continue;
+    }
+    if (++run == n) {
+      size_t first = i - n + 1, j;
+
+      /* Marks the whole run as allocated.*/
+      for (j = first; j <= i; j++)
+        dma_desc_state[j] = SAMA_DMA_NOT_FREE;
+      return &dma_desc_pool[first];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief   Releases a chain of linked list descriptors.
+ * @pre     The chain must have been allocated using @p dmaDescAllocate().
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @param[in] listp     pointer to the first descriptor of the chain
+ * @param[in] n         number of descriptors in the chain
+ *
+ * @special
+ */
+void dmaDescRelease(lld_view0 *listp, size_t n) {
+
+  size_t first = (size_t)(listp - dma_desc_pool), i;
+
+  osalDbgCheck((listp != NULL) && (first + n <= SAMA_DMA_DESC_POOL_SIZE));
+
+  for (i = first; i < first + n; i++) {
+    osalDbgAssert(dma_desc_state[i] != SAMA_DMA_FREE, "not allocated");
+    dma_desc_state[i] = SAMA_DMA_FREE;
+  }
+}
+
+/**
+ * @brief   Starts a transfer described by a linked list of descriptors.
+ * @details The channel fetches and executes the whole chain autonomously,
+ *          a single interrupt is generated at the end of the list instead
+ *          of one per block. The end-of-block interrupt cause is disabled
+ *          while the chain runs, drivers mixing list and single-transfer
+ *          operations on the same channel must re-enable it using
+ *          @p dmaChannelEnableInt() after completion.
+ * @note    The descriptors are fetched by the DMA through memory, the
+ *          function cleans the data cache over the chain before enabling
+ *          the channel.
+ * @pre     The channel must have been allocated using @p dmaChannelAllocate().
+ *
+ * @param[in] dmachp    pointer to a sama_dma_channel_t structure
+ * @param[in] mode      value to be written in the XDMAC_CC register
+ * @param[in] cndc      next descriptor control flags, the update flags
+ *                      @p XDMAC_CNDC_NDSUP/NDDUP and the view, the fetch
+ *                      enable bit is implicitly added
+ * @param[in] listp     pointer to the first descriptor of the chain
+ * @param[in] n         number of descriptors in the chain
+ *
+ * @special
+ */
+void dmaChannelStartList(sama_dma_channel_t *dmachp, uint32_t mode,
+                         uint32_t cndc, lld_view0 *listp, size_t n) {
+
+  osalDbgCheck((listp != NULL) && (n > 0U));
+
+  /* Descriptors are fetched through the memory interface, the cache must
+     be cleaned up to the point of coherency.*/
+  cacheCleanRegion(listp, n * sizeof (lld_view0));
+
+  dmaChannelSetMode(dmachp, mode);
+
+  /* Interrupting at the end of the list only.*/
+  dmaChannelDisableInt(dmachp, XDMAC_CID_BID);
+  dmaChannelEnableInt(dmachp, XDMAC_CIE_LIE);
+
+  /* Programming the first descriptor fetch.*/
+  dmachp->xdmac->XDMAC_CHID[dmachp->chid].XDMAC_CNDA =
+                                         ((uint32_t)listp) & 0xFFFFFFFCU;
+  dmachp->xdmac->XDMAC_CHID[dmachp->chid].XDMAC_CNDC =
+                                         cndc | XDMAC_CNDC_NDE_DSCR_FETCH_EN;
+
+  dmaChannelEnable(dmachp);
+}
+
 #endif /* SAMA_DMA_REQUIRED */
 
 /** @} */
@@ -64,6 +64,15 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Size of the linked list descriptors pool.
+ * @details Number of @p lld_view0 descriptors shared by all the channels
+ *          for linked list operations.
+ */
+#if !defined(SAMA_DMA_DESC_POOL_SIZE) || defined(__DOXYGEN__)
+#define SAMA_DMA_DESC_POOL_SIZE    64
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -270,6 +279,55 @@ typedef struct {
   dmaChannelEnable(dmachp);                                                       \
 }
 
+/**
+ * @brief   Enables channel interrupt causes.
+ * @note    This function can be invoked in both ISR or thread context.
+ * @pre     The channel must have been allocated using @p dmaChannelAllocate().
+ *
+ * @param[in] dmachp    pointer to a sama_dma_channel_t structure
+ * @param[in] causes    mask of XDMAC_CIE bits to be enabled
+ *
+ * @special
+ */
+#define dmaChannelEnableInt(dmachp, causes) {                           \
+  (dmachp)->xdmac->XDMAC_CHID[(dmachp)->chid].XDMAC_CIE = (causes);     \
+}
+
+/**
+ * @brief   Disables channel interrupt causes.
+ * @note    This function can be invoked in both ISR or thread context.
+ * @pre     The channel must have been allocated using @p dmaChannelAllocate().
+ *
+ * @param[in] dmachp    pointer to a sama_dma_channel_t structure
+ * @param[in] causes    mask of XDMAC_CID bits to be disabled
+ *
+ * @special
+ */
+#define dmaChannelDisableInt(dmachp, causes) {                          \
+  (dmachp)->xdmac->XDMAC_CHID[(dmachp)->chid].XDMAC_CID = (causes);     \
+}
+
+/**
+ * @brief   Fills a view0 linked list descriptor.
+ * @details The NDE bit of the microblock control word is derived from the
+ *          @p nextp parameter, the chain is terminated by passing @p NULL.
+ *
+ * @param[in] descp     pointer to the @p lld_view0 descriptor to be filled
+ * @param[in] nextp     pointer to the next descriptor or @p NULL
+ * @param[in] ubc       microblock control word, the caller provides the
+ *                      @p XDMA_UBC_UBLEN() length and the update flags
+ * @param[in] addr      value for the transfer address member
+ *
+ * @special
+ */
+#define dmaDescSetup(descp, nextp, ubc, addr) {                         \
+  (descp)->mbr_nda = (void *)(nextp);                                   \
+  (descp)->mbr_ubc = (ubc) | XDMA_UBC_NVIEW_NDV0 |                      \
+                     (((void *)(nextp) == NULL) ? XDMA_UBC_NDE_FETCH_DIS\
+                                                : XDMA_UBC_NDE_FETCH_EN);\
+  (descp)->mbr_ta  = (void *)(addr);                                    \
+}
+
 /**
  * @brief   Polled wait for DMA transfer end.
  * @pre     The channel must have been allocated using @p dmaChannelAllocate().
@@ -302,6 +360,10 @@ extern "C" {
                                          sama_dmaisr_t func,
                                          void *param);
   void dmaChannelRelease(sama_dma_channel_t *dmachp);
+  lld_view0 *dmaDescAllocate(size_t n);
+  void dmaDescRelease(lld_view0 *listp, size_t n);
+  void dmaChannelStartList(sama_dma_channel_t *dmachp, uint32_t mode,
+                           uint32_t cndc, lld_view0 *listp, size_t n);
 #ifdef __cplusplus
 }
 #endif
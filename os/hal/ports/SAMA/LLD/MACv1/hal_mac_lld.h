@@ -36,6 +36,16 @@
  */
 #define MAC_SUPPORTS_ZERO_COPY      FALSE
 
+/**
+ * @brief   This implementation supports the RX interrupts mitigation.
+ */
+#define MAC_SUPPORTS_RX_MITIGATION  FALSE
+
+/**
+ * @brief   This implementation supports the scatter-gather transmit API.
+ */
+#define MAC_SUPPORTS_TX_GATHER      FALSE
+
 /**
  * @name    RDES0 constants
  * @{
@@ -182,6 +182,12 @@ bool sdmmc_device_initialize(SdmmcDriver *driver)
 
 	driver->use_set_blk_cnt = false;
 
+	/* Invalidate any previously prepared ADMA descriptor table */
+	driver->dma_tbl_addr = 0;
+	driver->dma_tbl_len = 0;
+	driver->dma_tbl_blocks = 0;
+	driver->dma_tbl_rc = SDMMC_OK;
+
 	val = (driver->regs->SDMMC_CA0R & SDMMC_CA0R_MAXBLKL_Msk) >> SDMMC_CA0R_MAXBLKL_Pos;
 
 	driver->blk_size = (val <= 0x2 ? (512 << val) : 512);
@@ -1536,6 +1542,19 @@ static uint8_t sdmmc_build_dma_table( SdmmcDriver *driver )
 	/* Verify that cmd->pData is word-aligned */
 	if ((uint32_t)cmd->pData & 0x3)
 		return SDMMC_PARAM;
+	/* Reuse the descriptor table prepared by a previous call when the
+	 * transfer refers to the same buffer and length, e.g. repeated
+	 * multiblock transfers from a fixed logging buffer. The table is
+	 * write-only from the CPU side, hence it is still intact and the
+	 * rebuild loop and the cache clean operation can be skipped. */
+	if (driver->dma_tbl_blocks != 0 && ram_addr == driver->dma_tbl_addr
+	    && data_len == driver->dma_tbl_len) {
+		cmd->wNbBlocks = driver->dma_tbl_blocks;
+		return driver->dma_tbl_rc;
+	}
+	driver->dma_tbl_addr = ram_addr;
+	driver->dma_tbl_len = data_len;
+	driver->dma_tbl_blocks = 0;
 	/* Compute the size of the descriptor table for this transfer */
 	line_cnt = (data_len - 1 + SDMMC_DMADL_TRAN_LEN_MAX)/ SDMMC_DMADL_TRAN_LEN_MAX;
 	/* If it won't fit into the allocated buffer, resize the transfer */
@@ -1581,6 +1600,10 @@ static uint8_t sdmmc_build_dma_table( SdmmcDriver *driver )
 	 * only, hence there is no need to invalidate. */
 	cacheCleanRegion(driver->config->dma_table, (uint32_t)line - (uint32_t)driver->config->dma_table);
 
+	/* Remember what the table describes so the next call may reuse it */
+	driver->dma_tbl_blocks = cmd->wNbBlocks;
+	driver->dma_tbl_rc = rc;
+
 	return rc;
 }
 
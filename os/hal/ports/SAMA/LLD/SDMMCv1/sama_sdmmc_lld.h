@@ -117,6 +117,15 @@ struct SamaSDMMCDriver
 	bool expect_auto_end;         /* waiting for completion of Auto CMD12 */
 	bool use_set_blk_cnt;         /* implicit SET_BLOCK_COUNT command */
 
+	uint32_t dma_tbl_addr;        /* buffer address the prepared ADMA
+				       * descriptor table refers to */
+	uint32_t dma_tbl_len;         /* requested data length the prepared
+				       * ADMA descriptor table refers to */
+	uint16_t dma_tbl_blocks;      /* block count the prepared table
+				       * resolved to, possibly reduced to fit
+				       * the table, zero when invalid */
+	uint8_t dma_tbl_rc;           /* return code of the table build */
+
 	uint32_t control_param;
 	uint32_t timeout_ticks;
 	int8_t  timeout_elapsed;
@@ -34,6 +34,9 @@
 
 /**
  * @brief   Invalidate D-Cache Region
+ * @note    To be invoked on a DMA receive buffer after the peripheral has
+ *          written it, the outer cache is invalidated before the inner one
+ *          so that no stale outer line can be refilled into L1.
  *
  * @param[in] start      Pointer to beginning of memory region.
  * @param[in] length     Length of the memory location.
@@ -44,22 +47,25 @@ void cacheInvalidateRegion(void *start, uint32_t length) {
   uint32_t end_addr = start_addr + length;
   uint32_t mva;
 
-  /* Invalidate L1 D-Cache */
-  for (mva = start_addr & ~L1_CACHE_BYTES; mva < end_addr; mva += L1_CACHE_BYTES) {
-    L1C_InvalidateDCacheMVA((uint32_t *)mva);
-  }
 #if ARM_SUPPORTS_L2CC
 #if SAMA_L2CC_ASSUME_ENABLED || SAMA_L2CC_ENABLE
   /* Invalidate L2 Cache */
-  for (mva = start_addr & ~L2_CACHE_BYTES; mva < end_addr; mva += L2_CACHE_BYTES) {
+  for (mva = start_addr & ~(L2_CACHE_BYTES - 1u); mva < end_addr; mva += L2_CACHE_BYTES) {
     L2C_InvPa((uint32_t *)mva);
   }
 #endif
 #endif
+  /* Invalidate L1 D-Cache */
+  for (mva = start_addr & ~(L1_CACHE_BYTES - 1u); mva < end_addr; mva += L1_CACHE_BYTES) {
+    L1C_InvalidateDCacheMVA((uint32_t *)mva);
+  }
 }
 
 /**
  * @brief   Clean D-Cache Region
+ * @note    To be invoked on a DMA transmit buffer before enabling the
+ *          channel, dirty lines are written back from the inner cache to
+ *          the outer one and then to memory.
  *
  * @param[in] start      Pointer to beginning of memory region.
  * @param[in] length     Length of the memory location.
@@ -71,17 +77,47 @@ void cacheCleanRegion(void *start, uint32_t length) {
   uint32_t mva;
 
   /* Clean L1 D-Cache */
-  for (mva = start_addr & ~L1_CACHE_BYTES; mva < end_addr; mva += L1_CACHE_BYTES) {
+  for (mva = start_addr & ~(L1_CACHE_BYTES - 1u); mva < end_addr; mva += L1_CACHE_BYTES) {
     L1C_CleanDCacheMVA((uint32_t *)mva);
   }
 #if ARM_SUPPORTS_L2CC
 #if SAMA_L2CC_ASSUME_ENABLED || SAMA_L2CC_ENABLE
-  /* Invalidate L2 Cache */
-  for (mva = start_addr & ~L2_CACHE_BYTES; mva < end_addr; mva += L2_CACHE_BYTES) {
+  /* Clean L2 Cache */
+  for (mva = start_addr & ~(L2_CACHE_BYTES - 1u); mva < end_addr; mva += L2_CACHE_BYTES) {
     L2C_CleanPa((uint32_t *)mva);
   }
 #endif
 #endif
 }
 
+/**
+ * @brief   Clean and Invalidate D-Cache Region
+ * @note    To be invoked on a DMA receive buffer before enabling the
+ *          channel when the buffer is not line aligned, dirty lines
+ *          sharing the boundary lines are written back and the whole
+ *          region is evicted from both cache levels.
+ *
+ * @param[in] start      Pointer to beginning of memory region.
+ * @param[in] length     Length of the memory location.
+ */
+void cacheCleanInvalidateRegion(void *start, uint32_t length) {
+
+  uint32_t start_addr = (uint32_t)start;
+  uint32_t end_addr = start_addr + length;
+  uint32_t mva;
+
+  /* Clean and invalidate L1 D-Cache */
+  for (mva = start_addr & ~(L1_CACHE_BYTES - 1u); mva < end_addr; mva += L1_CACHE_BYTES) {
+    L1C_CleanInvalidateDCacheMVA((uint32_t *)mva);
+  }
+#if ARM_SUPPORTS_L2CC
+#if SAMA_L2CC_ASSUME_ENABLED || SAMA_L2CC_ENABLE
+  /* Clean and invalidate L2 Cache */
+  for (mva = start_addr & ~(L2_CACHE_BYTES - 1u); mva < end_addr; mva += L2_CACHE_BYTES) {
+    L2C_CleanInvPa((uint32_t *)mva);
+  }
+#endif
+#endif
+}
+
 /** @} */
@@ -35,6 +35,7 @@ extern "C" {
 #endif
   extern void cacheInvalidateRegion(void *start, uint32_t length);
   extern void cacheCleanRegion(void *start, uint32_t length);
+  extern void cacheCleanInvalidateRegion(void *start, uint32_t length);
 #ifdef __cplusplus
 }
 #endif
@@ -859,6 +859,12 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
 #endif /* !STM32_ADC_DUAL_MODE */
 
   /* ADC configuration.*/
+#if STM32_ADC_SUPPORTS_OVERSAMPLING == TRUE
+  adcp->adcm->CFGR2 = grpp->cfgr2;
+#if STM32_ADC_DUAL_MODE
+  adcp->adcs->CFGR2 = grpp->cfgr2;
+#endif
+#endif
   adcp->adcm->CFGR  = cfgr;
 
   /* Starting conversion.*/
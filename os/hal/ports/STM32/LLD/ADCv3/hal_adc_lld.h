@@ -131,6 +131,28 @@
 #define ADC_CFGR_AWD1_SINGLE(n)         (((n) << 26) | (1 << 23) | (1 << 22))
 /** @} */
 
+#if defined(ADC_CFGR2_ROVSE) || defined(__DOXYGEN__)
+/**
+ * @name    CFGR2 register configuration helpers
+ * @note    Only the L4 members of the ADCv3 family implement the hardware
+ *          oversampler.
+ * @{
+ */
+#define ADC_CFGR2_OVSR_MASK             (7 << 2)
+#define ADC_CFGR2_OVSR_2X               (0 << 2)
+#define ADC_CFGR2_OVSR_4X               (1 << 2)
+#define ADC_CFGR2_OVSR_8X               (2 << 2)
+#define ADC_CFGR2_OVSR_16X              (3 << 2)
+#define ADC_CFGR2_OVSR_32X              (4 << 2)
+#define ADC_CFGR2_OVSR_64X              (5 << 2)
+#define ADC_CFGR2_OVSR_128X             (6 << 2)
+#define ADC_CFGR2_OVSR_256X             (7 << 2)
+
+#define ADC_CFGR2_OVSS_MASK             (15 << 5)
+#define ADC_CFGR2_OVSS_SHIFT(n)         ((n) << 5)
+/** @} */
+#endif /* defined(ADC_CFGR2_ROVSE) */
+
 /**
  * @name    CCR register configuration helpers
  * @{
@@ -574,6 +596,19 @@
 #endif
 #endif /* defined(STM32L4XX) */
 
+/**
+ * @brief   Presence of the hardware oversampler.
+ * @note    Derived from the device headers, among the ADCv3 devices only
+ *          the STM32L4 implements the CFGR2 oversampler.
+ */
+#if !defined(STM32_ADC_SUPPORTS_OVERSAMPLING) || defined(__DOXYGEN__)
+#if defined(ADC_CFGR2_ROVSE) || defined(__DOXYGEN__)
+#define STM32_ADC_SUPPORTS_OVERSAMPLING     TRUE
+#else
+#define STM32_ADC_SUPPORTS_OVERSAMPLING     FALSE
+#endif
+#endif
+
 #if !defined(STM32_DMA_REQUIRED)
 #define STM32_DMA_REQUIRED
 #endif
@@ -668,6 +703,21 @@ typedef struct {
    *          greater than one.
    */
   uint32_t                  cfgr;
+#if (STM32_ADC_SUPPORTS_OVERSAMPLING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   ADC CFGR2 register initialization data.
+   * @details This field gives access to the hardware oversampler, the
+   *          ratio and output shift are programmed here using the
+   *          @p ADC_CFGR2_OVSR_nX and @p ADC_CFGR2_OVSS_SHIFT() helpers
+   *          together with the @p ADC_CFGR2_ROVSE, @p ADC_CFGR2_JOVSE,
+   *          @p ADC_CFGR2_TROVS and @p ADC_CFGR2_ROVSM device bits.
+   * @note    This field is only present on devices implementing the
+   *          hardware oversampler.
+   * @note    In dual mode the same oversampler setting is applied to both
+   *          the master and the slave ADC.
+   */
+  uint32_t                  cfgr2;
+#endif
   /**
    * @brief   ADC TR1 register initialization data.
    */
@@ -749,6 +799,22 @@ struct ADCDriver {
    */
   mutex_t                   mutex;
 #endif /* ADC_USE_MUTUAL_EXCLUSION */
+#if (ADC_USE_DECIMATION == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Decimation shift, zero if the decimation stage is disabled.
+   */
+  uint8_t                   dshift;
+  /**
+   * @brief   Buffer receiving the decimated samples.
+   */
+  adcsample_t               *dbuf;
+#endif /* ADC_USE_DECIMATION */
+#if (ADC_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timestamp of the latest buffer event.
+   */
+  systime_t                 timestamp;
+#endif /* ADC_USE_TIMESTAMP */
 #if defined(ADC_DRIVER_EXT_FIELDS)
   ADC_DRIVER_EXT_FIELDS
 #endif
@@ -578,6 +578,10 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
 #endif /* !STM32_ADC_DUAL_MODE */
 
   /* ADC configuration.*/
+  adcp->adcm->CFGR2 = grpp->cfgr2;
+#if STM32_ADC_DUAL_MODE
+  adcp->adcs->CFGR2 = grpp->cfgr2;
+#endif
   adcp->adcm->CFGR  = cfgr;
 
   /* Starting conversion.*/
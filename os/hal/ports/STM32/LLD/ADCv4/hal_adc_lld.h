@@ -106,6 +106,20 @@
 #define ADC_CFGR_DISCNUM_VAL(n)         ((n) << 17U)
 /** @} */
 
+/**
+ * @name    CFGR2 register configuration helpers
+ * @{
+ */
+#define ADC_CFGR2_OVSS_MASK             (15U << 5U)
+#define ADC_CFGR2_OVSS_SHIFT(n)         ((n) << 5U)
+
+#define ADC_CFGR2_OSR_MASK              (1023U << 16U)
+#define ADC_CFGR2_OSR_RATIO(n)          (((n) - 1U) << 16U)
+
+#define ADC_CFGR2_LSHIFT_MASK           (15U << 28U)
+#define ADC_CFGR2_LSHIFT_VAL(n)         ((n) << 28U)
+/** @} */
+
 /**
  * @name    CCR register configuration helpers
  * @{
@@ -462,6 +476,18 @@ typedef struct {
    *          greater than one.
    */
   uint32_t                  cfgr;
+  /**
+   * @brief   ADC CFGR2 register initialization data.
+   * @details This field gives access to the hardware oversampler, the
+   *          oversampling ratio, output shift and the regular/injected
+   *          scopes are programmed here using the @p ADC_CFGR2_OSR_RATIO(),
+   *          @p ADC_CFGR2_OVSS_SHIFT() helpers together with the
+   *          @p ADC_CFGR2_ROVSE, @p ADC_CFGR2_JOVSE, @p ADC_CFGR2_TROVS
+   *          and @p ADC_CFGR2_ROVSM device bits.
+   * @note    In dual mode the same oversampler setting is applied to both
+   *          the master and the slave ADC.
+   */
+  uint32_t                  cfgr2;
 #if STM32_ADC_DUAL_MODE || defined(__DOXYGEN__)
   /**
    * @brief   ADC CCR register initialization data.
@@ -595,6 +621,22 @@ struct ADCDriver {
    */
   mutex_t                   mutex;
 #endif /* ADC_USE_MUTUAL_EXCLUSION */
+#if (ADC_USE_DECIMATION == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Decimation shift, zero if the decimation stage is disabled.
+   */
+  uint8_t                   dshift;
+  /**
+   * @brief   Buffer receiving the decimated samples.
+   */
+  adcsample_t               *dbuf;
+#endif /* ADC_USE_DECIMATION */
+#if (ADC_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timestamp of the latest buffer event.
+   */
+  systime_t                 timestamp;
+#endif /* ADC_USE_TIMESTAMP */
 #if defined(ADC_DRIVER_EXT_FIELDS)
   ADC_DRIVER_EXT_FIELDS
 #endif
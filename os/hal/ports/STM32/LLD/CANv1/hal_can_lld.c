@@ -235,6 +235,20 @@ static void can_lld_tx_handler(CANDriver *canp) {
     }
   }
 
+#if CAN_USE_ERROR_MONITOR == TRUE
+  /* Arbitration losses are accounted separately from the generic TX
+     error flags.*/
+  if ((tsr & CAN_TSR_ALST0) != 0U) {
+    _can_monitor_arb_lost(canp);
+  }
+  if ((tsr & CAN_TSR_ALST1) != 0U) {
+    _can_monitor_arb_lost(canp);
+  }
+  if ((tsr & CAN_TSR_ALST2) != 0U) {
+    _can_monitor_arb_lost(canp);
+  }
+#endif
+
   /* Signaling flags and waking up threads waiting for a transmission slot.*/
   _can_tx_empty_isr(canp, flags);
 }
@@ -312,7 +326,7 @@ static void can_lld_sce_handler(CANDriver *canp) {
     eventflags_t flags;
     uint32_t esr = canp->can->ESR;
 
-#if STM32_CAN_REPORT_ALL_ERRORS
+#if STM32_CAN_REPORT_ALL_ERRORS || (CAN_USE_ERROR_MONITOR == TRUE)
     flags = (eventflags_t)(esr & 7);
     if ((esr & CAN_ESR_LEC) > 0)
       flags |= CAN_FRAMING_ERROR;
@@ -962,6 +976,27 @@ void can_lld_wakeup(CANDriver *canp) {
 }
 #endif /* CAN_USE_SLEEP_MODE */
 
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the bus-off recovery sequence.
+ * @details The controller is requested to enter and leave the
+ *          initialization mode, the fault confinement rules then keep
+ *          the node off the bus until 128 occurrences of 11 consecutive
+ *          recessive bits have been monitored.
+ * @note    The hardware ABOM feature is not used so the recovery policy
+ *          stays under software control.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_recover(CANDriver *canp) {
+
+  canp->can->MCR |= CAN_MCR_INRQ;
+  canp->can->MCR &= ~CAN_MCR_INRQ;
+}
+#endif /* CAN_USE_ERROR_MONITOR */
+
 /**
  * @brief   Programs the filters.
  * @note    This is an STM32-specific API.
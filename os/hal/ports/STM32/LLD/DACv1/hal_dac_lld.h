@@ -316,6 +316,41 @@ typedef void (*daccallback_t)(DACDriver *dacp, dacsample_t *buffer, size_t n);
  */
 typedef void (*dacerrorcallback_t)(DACDriver *dacp, dacerror_t err);
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a streaming chain buffer descriptor.
+ */
+typedef struct dacstreambuf dacstreambuf_t;
+
+/**
+ * @brief   DAC streaming notification callback type.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object triggering the
+ *                      callback
+ * @param[in] sbp       pointer to the fully consumed buffer descriptor or
+ *                      @p NULL for an underrun event
+ */
+typedef void (*dacstreamcallback_t)(DACDriver *dacp, dacstreambuf_t *sbp);
+
+/**
+ * @brief   Streaming chain buffer descriptor.
+ */
+struct dacstreambuf {
+  /**
+   * @brief   Pointer to the samples, organized as the conversion buffer.
+   */
+  const dacsample_t         *buffer;
+  /**
+   * @brief   Buffer depth (matrix rows number).
+   */
+  size_t                    depth;
+  /**
+   * @brief   Next buffer in the chain.
+   */
+  dacstreambuf_t            *next;
+};
+#endif /* DAC_USE_STREAMING == TRUE */
+
 /**
  * @brief   Samples alignment and size mode.
  */
@@ -411,6 +446,40 @@ struct DACDriver {
    */
   mutex_t                   mutex;
 #endif /* DAC_USE_MUTUAL_EXCLUSION */
+#if DAC_USE_STREAMING || defined(__DOXYGEN__)
+  /**
+   * @brief   Streaming mode activity flag.
+   */
+  bool                      sb_active;
+  /**
+   * @brief   Head of the pending buffers chain.
+   */
+  dacstreambuf_t            *sb_head;
+  /**
+   * @brief   Tail of the pending buffers chain.
+   */
+  dacstreambuf_t            *sb_tail;
+  /**
+   * @brief   Sample rows already consumed from the head buffer.
+   */
+  size_t                    sb_offset;
+  /**
+   * @brief   Sample inserted on all channels during an underrun.
+   */
+  dacsample_t               sb_idle;
+  /**
+   * @brief   Buffer consumed callback or @p NULL.
+   */
+  dacstreamcallback_t       sb_cb;
+  /**
+   * @brief   Underrun callback or @p NULL.
+   */
+  dacstreamcallback_t       sb_ucb;
+  /**
+   * @brief   Underrun events counter.
+   */
+  volatile uint32_t         sb_underruns;
+#endif /* DAC_USE_STREAMING */
 #if defined(DAC_DRIVER_EXT_FIELDS)
   DAC_DRIVER_EXT_FIELDS
 #endif
@@ -481,6 +481,80 @@ bool dmaStreamAllocate(const stm32_dma_stream_t *dmastp,
   return false;
 }
 
+/**
+ * @brief   Allocates a DMA stream from a set of candidates.
+ * @details The candidates mask describes the streams the peripheral
+ *          request can be routed to, it is built by combining
+ *          @p STM32_DMA_STREAM_ID_MSK() values according to the request
+ *          mapping table of the device. Among the free candidates the
+ *          stream on the least loaded DMA controller is chosen, so
+ *          frequently used peripherals spread over both controllers
+ *          instead of serializing on one, the stream with the lowest
+ *          identifier wins ties.
+ * @pre     The stream set must not be empty.
+ * @post    The stream is allocated as if @p dmaStreamAllocate() had been
+ *          called on it and must eventually be released using
+ *          @p dmaStreamRelease().
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @param[in] candidates  mask of acceptable stream identifiers
+ * @param[in] priority    IRQ priority for the DMA stream
+ * @param[in] func        handling function pointer, can be @p NULL
+ * @param[in] param       a parameter to be passed to the handling function
+ * @return                Pointer to the allocated @p stm32_dma_stream_t
+ *                        structure.
+ * @retval NULL           if all the candidate streams are already taken.
+ *
+ * @special
+ */
+const stm32_dma_stream_t *dmaStreamAllocFromMask(uint32_t candidates,
+                                                 uint32_t priority,
+                                                 stm32_dmaisr_t func,
+                                                 void *param) {
+  uint32_t free, load1, load2, bestload, mask;
+  unsigned id, best;
+
+  osalDbgCheck(candidates != 0U);
+
+  /* Candidate streams not yet taken.*/
+  free = candidates & ~dma_streams_mask;
+  if (free == 0U) {
+    return NULL;
+  }
+
+  /* Number of streams already allocated on each controller.*/
+  load1 = load2 = 0U;
+  for (mask = dma_streams_mask & STM32_DMA1_STREAMS_MASK;
+       mask != 0U;
+       mask &= mask - 1U) {
+    load1++;
+  }
+  for (mask = dma_streams_mask & STM32_DMA2_STREAMS_MASK;
+       mask != 0U;
+       mask &= mask - 1U) {
+    load2++;
+  }
+
+  /* Preferring the least loaded controller, the lowest identifier
+     wins ties.*/
+  best = STM32_DMA_STREAMS;
+  bestload = 0U;
+  for (id = 0U; id < (unsigned)STM32_DMA_STREAMS; id++) {
+    if ((free & (1U << id)) != 0U) {
+      uint32_t load = (id < 8U) ? load1 : load2;
+
+      if ((best == (unsigned)STM32_DMA_STREAMS) || (load < bestload)) {
+        best = id;
+        bestload = load;
+      }
+    }
+  }
+
+  (void) dmaStreamAllocate(STM32_DMA_STREAM(best), priority, func, param);
+
+  return STM32_DMA_STREAM(best);
+}
+
 /**
  * @brief   Releases a DMA stream.
  * @details The stream is freed and, if required, the DMA clock disabled.
@@ -517,6 +591,111 @@ void dmaStreamRelease(const stm32_dma_stream_t *dmastp) {
   }
 }
 
+/**
+ * @brief   Starts a chained multi-segment transfer.
+ * @details The transfer runs through the segments array back-to-back,
+ *          each transfer complete interrupt programs the next segment
+ *          from its prepared register images, three register stores and
+ *          no recomputation, so the inter-segment gap reduces to the
+ *          interrupt latency. The completion callback, if any, is
+ *          invoked after the last segment.
+ * @pre     The stream must have been allocated using
+ *          @p dmaStreamAllocate() with @p dmaChainServeInterrupt() as
+ *          handling function and the chain descriptor as parameter.
+ * @pre     The peripheral address and, if needed, the FIFO control
+ *          register must be programmed by the caller, they are common to
+ *          all segments.
+ * @note    The mode must not include the enable bit, the transfer
+ *          complete interrupt enable is added implicitly.
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @param[out] chainp   pointer to a @p stm32_dma_chain_t descriptor, it
+ *                      must remain valid for the whole transfer
+ * @param[in] dmastp    pointer to a stm32_dma_stream_t structure
+ * @param[in] segments  segments array, it must remain valid for the
+ *                      whole transfer
+ * @param[in] n         number of segments, must be greater than zero
+ * @param[in] mode      value to be written in the CR register
+ * @param[in] endfunc   chain completion callback, can be @p NULL
+ * @param[in] endparam  parameter of the completion callback
+ *
+ * @special
+ */
+void dmaChainStart(stm32_dma_chain_t *chainp,
+                   const stm32_dma_stream_t *dmastp,
+                   const stm32_dma_segment_t segments[],
+                   unsigned n,
+                   uint32_t mode,
+                   stm32_dmaisr_t endfunc,
+                   void *endparam) {
+
+  osalDbgCheck((chainp != NULL) && (dmastp != NULL) &&
+               (segments != NULL) && (n > 0U));
+
+  chainp->dmastp   = dmastp;
+  chainp->segments = segments;
+  chainp->next     = 1U;
+  chainp->n        = n;
+  chainp->cr       = mode | STM32_DMA_CR_TCIE | STM32_DMA_CR_EN;
+  chainp->endfunc  = endfunc;
+  chainp->endparam = endparam;
+
+  /* Programming and starting the first segment.*/
+  dmastp->stream->M0AR = segments[0].m0ar;
+  dmastp->stream->NDTR = segments[0].ndtr;
+  dmastp->stream->CR   = chainp->cr;
+}
+
+/**
+ * @brief   Chained transfer interrupt handler.
+ * @details This function must be registered as handling function of the
+ *          stream carrying the chained transfer, with the chain
+ *          descriptor as parameter.
+ *
+ * @param[in] p         pointer to the @p stm32_dma_chain_t descriptor
+ * @param[in] flags     pre-shifted content of the xISR register
+ *
+ * @special
+ */
+void dmaChainServeInterrupt(void *p, uint32_t flags) {
+  stm32_dma_chain_t *chainp = (stm32_dma_chain_t *)p;
+
+  if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+    if (chainp->next < chainp->n) {
+      const stm32_dma_segment_t *segp = &chainp->segments[chainp->next];
+      DMA_Stream_TypeDef *stream = chainp->dmastp->stream;
+
+      chainp->next++;
+
+      /* Restarting the stream on the next segment, the enable bit has
+         been cleared by hardware on completion of the previous one.*/
+      stream->M0AR = segp->m0ar;
+      stream->NDTR = segp->ndtr;
+      stream->CR   = chainp->cr;
+    }
+    else if (chainp->endfunc != NULL) {
+      chainp->endfunc(chainp->endparam, flags);
+    }
+  }
+}
+
+/**
+ * @brief   Returns the mask of the allocated streams.
+ * @details Each set bit corresponds to a taken stream, bit positions are
+ *          the @p STM32_DMA_STREAM_ID() identifiers. The mask is meant
+ *          for reporting the final stream assignments when allocations
+ *          are performed at runtime.
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @return              The allocated streams mask.
+ *
+ * @special
+ */
+uint32_t dmaGetAllocatedMask(void) {
+
+  return dma_streams_mask;
+}
+
 #endif /* STM32_DMA_REQUIRED */
 
 /** @} */
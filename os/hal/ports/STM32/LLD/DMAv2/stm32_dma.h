@@ -377,6 +377,55 @@ typedef struct {
  */
 typedef void (*stm32_dmaisr_t)(void *p, uint32_t flags);
 
+/**
+ * @brief   STM32 DMA transfer segment.
+ * @details Prepared register images of one segment of a chained transfer,
+ *          the restart ISR copies them to the stream registers without
+ *          any recomputation.
+ */
+typedef struct {
+  uint32_t              m0ar;           /**< @brief Memory address image.   */
+  uint32_t              ndtr;           /**< @brief Counter register image. */
+} stm32_dma_segment_t;
+
+/**
+ * @brief   STM32 DMA chained transfer descriptor.
+ * @details Emulates linked-list scatter/gather on streams without
+ *          hardware descriptor support, the next segment is programmed
+ *          from the transfer complete ISR using prepared register
+ *          images.
+ */
+typedef struct {
+  /**
+   * @brief   Associated DMA stream.
+   */
+  const stm32_dma_stream_t *dmastp;
+  /**
+   * @brief   Segments array.
+   */
+  const stm32_dma_segment_t *segments;
+  /**
+   * @brief   Index of the next segment to be programmed.
+   */
+  unsigned              next;
+  /**
+   * @brief   Number of segments in the array.
+   */
+  unsigned              n;
+  /**
+   * @brief   Prepared CR register image, including the enable bit.
+   */
+  uint32_t              cr;
+  /**
+   * @brief   Chain completion callback or @p NULL.
+   */
+  stm32_dmaisr_t        endfunc;
+  /**
+   * @brief   Parameter of the completion callback.
+   */
+  void                  *endparam;
+} stm32_dma_chain_t;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -612,7 +661,20 @@ extern "C" {
                          uint32_t priority,
                          stm32_dmaisr_t func,
                          void *param);
+  const stm32_dma_stream_t *dmaStreamAllocFromMask(uint32_t candidates,
+                                                   uint32_t priority,
+                                                   stm32_dmaisr_t func,
+                                                   void *param);
   void dmaStreamRelease(const stm32_dma_stream_t *dmastp);
+  uint32_t dmaGetAllocatedMask(void);
+  void dmaChainStart(stm32_dma_chain_t *chainp,
+                     const stm32_dma_stream_t *dmastp,
+                     const stm32_dma_segment_t segments[],
+                     unsigned n,
+                     uint32_t mode,
+                     stm32_dmaisr_t endfunc,
+                     void *endparam);
+  void dmaChainServeInterrupt(void *p, uint32_t flags);
 #ifdef __cplusplus
 }
 #endif
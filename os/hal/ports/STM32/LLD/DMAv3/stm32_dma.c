@@ -542,6 +542,123 @@ void dmaStreamRelease(const stm32_dma_stream_t *stp) {
   }
 }
 
+/**
+ * @brief   Starts a free-running peripheral-to-peripheral pipeline.
+ * @details The producer stream fills a circular buffer from the source
+ *          peripheral, the consumer stream drains the same buffer into
+ *          the destination peripheral. The producer DMAMUX channel
+ *          generates an event each completed block of @p blksize data
+ *          units, the consumer DMAMUX channel is synchronized on that
+ *          event and releases exactly one block of requests per event,
+ *          so the consumer trails the producer by one block and no data
+ *          unit is ever moved by the CPU. Once started the pipeline
+ *          runs until @p dmaPipelineStop() is invoked.
+ * @pre     Both streams must have been allocated using
+ *          @p dmaStreamAllocate(), no callbacks are required because the
+ *          pipeline does not generate interrupts by itself.
+ * @pre     The producer stream must be placed on a DMAMUX channel whose
+ *          event output is routed to a synchronization input, the
+ *          mapping is in the "DMAMUX: assignment of synchronization
+ *          inputs" table of the reference manual.
+ * @note    The buffer must be large enough to absorb the latency of the
+ *          destination peripheral, if the producer laps the consumer
+ *          data is silently overwritten, increase @p nblks to add
+ *          margin. A synchronization overrun can be detected by adding
+ *          @p STM32_DMAMUX_CCR_SOIE to the consumer channel afterwards.
+ * @note    The modes must not include the direction, circular, memory
+ *          increment and enable bits, they are added implicitly.
+ *
+ * @param[out] plp      pointer to a @p stm32_dma_pipeline_t descriptor
+ * @param[in] prodp     pointer to the producer stream
+ * @param[in] consp     pointer to the consumer stream
+ * @param[in] prodreq   DMAMUX request source of the producer peripheral
+ * @param[in] consreq   DMAMUX request source of the consumer peripheral
+ * @param[in] sync      synchronization input connected to the producer
+ *                      channel event, from the reference manual table
+ * @param[in] src       source peripheral data register address
+ * @param[in] dst       destination peripheral data register address
+ * @param[in] buf       circular buffer, @p blksize * @p nblks data units
+ * @param[in] blksize   data units per block, in range 1..32
+ * @param[in] nblks     number of blocks in the buffer, at least 2
+ * @param[in] prodmode  extra CR bits of the producer stream, data sizes,
+ *                      priority and bursts
+ * @param[in] consmode  extra CR bits of the consumer stream
+ *
+ * @special
+ */
+void dmaPipelineStart(stm32_dma_pipeline_t *plp,
+                      const stm32_dma_stream_t *prodp,
+                      const stm32_dma_stream_t *consp,
+                      uint32_t prodreq,
+                      uint32_t consreq,
+                      uint32_t sync,
+                      volatile void *src,
+                      volatile void *dst,
+                      void *buf,
+                      uint32_t blksize,
+                      uint32_t nblks,
+                      uint32_t prodmode,
+                      uint32_t consmode) {
+
+  osalDbgCheck((plp != NULL) && (prodp != NULL) && (consp != NULL) &&
+               (prodp != consp) && (buf != NULL) &&
+               (blksize >= 1U) && (blksize <= 32U) && (nblks >= 2U));
+
+  plp->producer = prodp;
+  plp->consumer = consp;
+
+  /* Consumer stream, memory-to-peripheral over the whole buffer, the
+     DMAMUX channel releases one block of requests for each producer
+     event. It is enabled first, the synchronization logic keeps it
+     idle until the producer completes the first block.*/
+  consp->stream->PAR  = (uint32_t)dst;
+  consp->stream->M0AR = (uint32_t)buf;
+  consp->stream->NDTR = blksize * nblks;
+  consp->mux->CCR = (consreq & STM32_DMAMUX_CCR_DMAREQ_ID_MASK) |
+                    STM32_DMAMUX_CCR_SE                         |
+                    STM32_DMAMUX_CCR_SPOL_RISING                |
+                    STM32_DMAMUX_CCR_SYNC_ID(sync)              |
+                    STM32_DMAMUX_CCR_NBREQ(blksize - 1U);
+  consp->stream->CR = consmode           | STM32_DMA_CR_DIR_M2P |
+                      STM32_DMA_CR_MINC  | STM32_DMA_CR_CIRC    |
+                      STM32_DMA_CR_EN;
+
+  /* Producer stream, peripheral-to-memory over the same buffer, the
+     DMAMUX channel generates an event each completed block.*/
+  prodp->stream->PAR  = (uint32_t)src;
+  prodp->stream->M0AR = (uint32_t)buf;
+  prodp->stream->NDTR = blksize * nblks;
+  prodp->mux->CCR = (prodreq & STM32_DMAMUX_CCR_DMAREQ_ID_MASK) |
+                    STM32_DMAMUX_CCR_EGE                        |
+                    STM32_DMAMUX_CCR_NBREQ(blksize - 1U);
+  prodp->stream->CR = prodmode           | STM32_DMA_CR_DIR_P2M |
+                      STM32_DMA_CR_MINC  | STM32_DMA_CR_CIRC    |
+                      STM32_DMA_CR_EN;
+}
+
+/**
+ * @brief   Stops a peripheral-to-peripheral pipeline.
+ * @details The producer stream is disabled first so no new data enters
+ *          the buffer, then the consumer stream, both DMAMUX channels
+ *          are returned to their reset state. Data still in the buffer
+ *          is discarded.
+ * @post    The streams can be reprogrammed or released.
+ *
+ * @param[in] plp       pointer to a @p stm32_dma_pipeline_t descriptor
+ *
+ * @special
+ */
+void dmaPipelineStop(stm32_dma_pipeline_t *plp) {
+
+  osalDbgCheck((plp != NULL) && (plp->producer != NULL) &&
+               (plp->consumer != NULL));
+
+  dmaStreamDisable(plp->producer);
+  dmaStreamDisable(plp->consumer);
+  plp->producer->mux->CCR = 0U;
+  plp->consumer->mux->CCR = 0U;
+}
+
 #endif /* STM32_DMA_REQUIRED */
 
 /** @} */
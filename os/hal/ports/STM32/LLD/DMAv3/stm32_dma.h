@@ -153,6 +153,25 @@
 #define STM32_DMA_FCR_FS_MASK       DMA_SxFCR_FS_Msk
 /** @} */
 
+/**
+ * @name    DMAMUX CCR register constants
+ * @{
+ */
+#define STM32_DMAMUX_CCR_DMAREQ_ID_MASK DMAMUX_CxCR_DMAREQ_ID_Msk
+#define STM32_DMAMUX_CCR_SOIE       DMAMUX_CxCR_SOIE
+#define STM32_DMAMUX_CCR_EGE        DMAMUX_CxCR_EGE
+#define STM32_DMAMUX_CCR_SE         DMAMUX_CxCR_SE
+#define STM32_DMAMUX_CCR_SPOL_MASK  DMAMUX_CxCR_SPOL_Msk
+#define STM32_DMAMUX_CCR_SPOL_NONE  0U
+#define STM32_DMAMUX_CCR_SPOL_RISING DMAMUX_CxCR_SPOL_0
+#define STM32_DMAMUX_CCR_SPOL_FALLING DMAMUX_CxCR_SPOL_1
+#define STM32_DMAMUX_CCR_SPOL_BOTH  (DMAMUX_CxCR_SPOL_0 | DMAMUX_CxCR_SPOL_1)
+#define STM32_DMAMUX_CCR_NBREQ_MASK DMAMUX_CxCR_NBREQ_Msk
+#define STM32_DMAMUX_CCR_NBREQ(n)   ((n) << DMAMUX_CxCR_NBREQ_Pos)
+#define STM32_DMAMUX_CCR_SYNC_ID_MASK DMAMUX_CxCR_SYNC_ID_Msk
+#define STM32_DMAMUX_CCR_SYNC_ID(n) ((n) << DMAMUX_CxCR_SYNC_ID_Pos)
+/** @} */
+
 /**
  * @name    Status flags passed to the ISR callbacks
  */
@@ -333,6 +352,25 @@ typedef struct {
  */
 typedef void (*stm32_dmaisr_t)(void *p, uint32_t flags);
 
+/**
+ * @brief   STM32 DMA peripheral-to-peripheral pipeline descriptor.
+ * @details Binds two streams moving data through a shared circular
+ *          buffer without CPU intervention: a producer stream fills the
+ *          buffer from a peripheral and a consumer stream drains it to
+ *          another peripheral, the DMAMUX synchronization logic paces
+ *          the consumer one block behind the producer.
+ */
+typedef struct {
+  /**
+   * @brief   Producer stream, peripheral to memory.
+   */
+  const stm32_dma_stream_t  *producer;
+  /**
+   * @brief   Consumer stream, memory to peripheral.
+   */
+  const stm32_dma_stream_t  *consumer;
+} stm32_dma_pipeline_t;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -570,6 +608,20 @@ extern "C" {
                          void *param);
   void dmaSetRequestSource(const stm32_dma_stream_t *stp, uint32_t per);
   void dmaStreamRelease(const stm32_dma_stream_t *stp);
+  void dmaPipelineStart(stm32_dma_pipeline_t *plp,
+                        const stm32_dma_stream_t *prodp,
+                        const stm32_dma_stream_t *consp,
+                        uint32_t prodreq,
+                        uint32_t consreq,
+                        uint32_t sync,
+                        volatile void *src,
+                        volatile void *dst,
+                        void *buf,
+                        uint32_t blksize,
+                        uint32_t nblks,
+                        uint32_t prodmode,
+                        uint32_t consmode);
+  void dmaPipelineStop(stm32_dma_pipeline_t *plp);
 #ifdef __cplusplus
 }
 #endif
@@ -201,6 +201,11 @@ OSAL_IRQ_HANDLER(STM32_ETH_HANDLER) {
   if (dmasr & ETH_DMASR_RS) {
     /* Data Received.*/
     osalSysLockFromISR();
+#if MAC_USE_RX_MITIGATION
+    /* The receive interrupt is masked for the rest of the burst, it is
+       re-enabled by mac_lld_rx_irq_enable() when the ring is emptied.*/
+    ETH->DMAIER &= ~ETH_DMAIER_RIE;
+#endif
     osalThreadDequeueAllI(&ETHD1.rdqueue, MSG_RESET);
 #if MAC_USE_EVENTS
     osalEventBroadcastFlagsI(&ETHD1.rdevent, 0);
@@ -438,6 +443,12 @@ msg_t mac_lld_get_transmit_descriptor(MACDriver *macp,
   /* Marks the current descriptor as locked using a reserved bit.*/
   tdes->tdes0 |= STM32_TDES0_LOCKED;
 
+#if MAC_USE_TX_GATHER
+  /* The descriptor may have been used by a gather frame pointing into
+     external segments, the static buffer is re-attached.*/
+  tdes->tdes2 = (uint32_t)__eth_tb[tdes - __eth_td];
+#endif
+
   /* Next TX descriptor to use.*/
   macp->txptr = (stm32_eth_tx_descriptor_t *)tdes->tdes3;
 
@@ -758,6 +769,141 @@ const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
 }
 #endif /* MAC_USE_ZERO_COPY */
 
+#if MAC_USE_RX_MITIGATION || defined(__DOXYGEN__)
+/**
+ * @brief   Re-enables the receive interrupt.
+ * @details Called by the high level driver after the receive ring has been
+ *          found empty. A frame received while the interrupt was masked
+ *          leaves the status flag pending, the interrupt is then served as
+ *          soon as it is re-enabled.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ *
+ * @notapi
+ */
+void mac_lld_rx_irq_enable(MACDriver *macp) {
+
+  (void)macp;
+
+  ETH->DMAIER |= ETH_DMAIER_RIE;
+}
+#endif /* MAC_USE_RX_MITIGATION */
+
+#if MAC_USE_TX_GATHER || defined(__DOXYGEN__)
+/**
+ * @brief   Transmits a frame composed of multiple segments.
+ * @details One descriptor per segment is attached to the DMA chain, the
+ *          descriptors point into the segments in place so no copy is
+ *          performed. The first descriptor is handed over to the DMA last
+ *          so the engine cannot start on a partially built chain.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tdp      pointer to a @p MACTransmitDescriptor structure,
+ *                      on success it references the last descriptor of
+ *                      the frame for completion polling
+ * @param[in] segs      frame segments array
+ * @param[in] n         number of segments, it cannot exceed
+ *                      @p STM32_MAC_TRANSMIT_BUFFERS
+ * @return              The operation status.
+ * @retval MSG_OK       the frame has been queued for transmission.
+ * @retval MSG_TIMEOUT  enough descriptors not currently available.
+ *
+ * @notapi
+ */
+msg_t mac_lld_transmit_gather(MACDriver *macp,
+                              MACTransmitDescriptor *tdp,
+                              const macsegment_t segs[],
+                              size_t n) {
+  stm32_eth_tx_descriptor_t *tdes, *first;
+  size_t i;
+
+  osalDbgAssert(n <= (size_t)STM32_MAC_TRANSMIT_BUFFERS,
+                "too many segments");
+
+  if (!macp->link_up)
+    return MSG_TIMEOUT;
+
+  osalSysLock();
+
+  /* Checking that enough consecutive descriptors are neither owned by
+     the DMA nor locked by another thread.*/
+  tdes = macp->txptr;
+  for (i = 0; i < n; i++) {
+    if (tdes->tdes0 & (STM32_TDES0_OWN | STM32_TDES0_LOCKED)) {
+      osalSysUnlock();
+      return MSG_TIMEOUT;
+    }
+    tdes = (stm32_eth_tx_descriptor_t *)tdes->tdes3;
+  }
+
+  /* Attaching the segments, all descriptors except the first are given
+     to the DMA immediately.*/
+  first = macp->txptr;
+  tdes  = first;
+  for (i = 0; i < n; i++) {
+    uint32_t tdes0 = STM32_TDES0_CIC(STM32_MAC_IP_CHECKSUM_OFFLOAD) |
+                     STM32_TDES0_TCH;
+
+    if (i == 0U)
+      tdes0 |= STM32_TDES0_FS;
+    else
+      tdes0 |= STM32_TDES0_OWN;
+    if (i == (n - 1U)) {
+      tdes0 |= STM32_TDES0_LS | STM32_TDES0_IC;
+
+      /* The last descriptor is the completion reference, the whole frame
+         has been transmitted when its OWN bit returns to zero.*/
+      tdp->offset   = 0;
+      tdp->size     = 0;
+      tdp->physdesc = tdes;
+    }
+    tdes->tdes2 = (uint32_t)segs[i].data;
+    tdes->tdes1 = (uint32_t)segs[i].size;
+    tdes->tdes0 = tdes0;
+    tdes = (stm32_eth_tx_descriptor_t *)tdes->tdes3;
+  }
+
+  /* Next TX descriptor to use.*/
+  macp->txptr = tdes;
+
+  /* Wait for the chain writes to go through before handing over the
+     first descriptor.*/
+  __DSB();
+
+  /* The DMA engine can now fetch the whole frame.*/
+  first->tdes0 |= STM32_TDES0_OWN;
+
+  /* Wait for the write to tdes0 to go through before resuming the DMA.*/
+  __DSB();
+
+  /* If the DMA engine is stalled then a restart request is issued.*/
+  if ((ETH->DMASR & ETH_DMASR_TPS) == ETH_DMASR_TPS_Suspended) {
+    ETH->DMASR   = ETH_DMASR_TBUS;
+    ETH->DMATPDR = ETH_DMASR_TBUS; /* Any value is OK.*/
+  }
+
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Evaluates whether a gather frame has been transmitted.
+ *
+ * @param[in] tdp       pointer to the @p MACTransmitDescriptor structure
+ *                      returned by @p mac_lld_transmit_gather()
+ * @return              The frame status.
+ * @retval true         if the frame has been fully transmitted.
+ * @retval false        if the frame is still owned by the DMA.
+ *
+ * @notapi
+ */
+bool mac_lld_is_frame_transmitted(MACTransmitDescriptor *tdp) {
+
+  return (tdp->physdesc->tdes0 & STM32_TDES0_OWN) == 0U;
+}
+#endif /* MAC_USE_TX_GATHER */
+
 #endif /* HAL_USE_MAC */
 
 /** @} */
@@ -36,6 +36,16 @@
  */
 #define MAC_SUPPORTS_ZERO_COPY      TRUE
 
+/**
+ * @brief   This implementation supports the RX interrupts mitigation.
+ */
+#define MAC_SUPPORTS_RX_MITIGATION  TRUE
+
+/**
+ * @brief   This implementation supports the scatter-gather transmit API.
+ */
+#define MAC_SUPPORTS_TX_GATHER      TRUE
+
 /**
  * @name    RDES0 constants
  * @{
@@ -348,6 +358,16 @@ extern "C" {
   const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
                                                  size_t *sizep);
 #endif /* MAC_USE_ZERO_COPY */
+#if MAC_USE_RX_MITIGATION
+  void mac_lld_rx_irq_enable(MACDriver *macp);
+#endif /* MAC_USE_RX_MITIGATION */
+#if MAC_USE_TX_GATHER
+  msg_t mac_lld_transmit_gather(MACDriver *macp,
+                                MACTransmitDescriptor *tdp,
+                                const macsegment_t segs[],
+                                size_t n);
+  bool mac_lld_is_frame_transmitted(MACTransmitDescriptor *tdp);
+#endif /* MAC_USE_TX_GATHER */
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,15 @@
 
 #endif
 
+/**
+ * @brief   Evaluates to true if the driver is using the internal DMA.
+ */
+#if STM32_USB_OTG2_USE_DMA || defined(__DOXYGEN__)
+#define otg_dma_mode(usbp)      (&USBD2 == (usbp))
+#else
+#define otg_dma_mode(usbp)      false
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -90,10 +99,19 @@ static union {
   USBOutEndpointState out;
 } ep0_state;
 
+#if STM32_USB_OTG2_USE_DMA
+/**
+ * @brief   Buffer for the EP0 setup packets.
+ * @note    In DMA mode the buffer must be able to hold up to three
+ *          back-to-back setup packets and must be word aligned.
+ */
+static uint32_t ep0setup_buffer[6];
+#else
 /**
  * @brief   Buffer for the EP0 setup packets.
  */
 static uint8_t ep0setup_buffer[8];
+#endif
 
 /**
  * @brief   EP0 initialization structure.
@@ -108,7 +126,7 @@ static const USBEndpointConfig ep0config = {
   &ep0_state.in,
   &ep0_state.out,
   1,
-  ep0setup_buffer
+  (uint8_t *)ep0setup_buffer
 };
 
 #if STM32_USB_USE_OTG1
@@ -214,6 +232,28 @@ static uint32_t otg_ram_alloc(USBDriver *usbp, size_t size) {
   return next;
 }
 
+#if STM32_USB_OTG2_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Arms the reception of setup packets on the endpoint zero.
+ * @details In DMA mode setup packets are deposited by the DMA engine
+ *          directly in memory, the OUT endpoint zero must be enabled and
+ *          pointed at the setup buffer for this to happen.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+static void otg_ep0out_setup_arm(USBDriver *usbp) {
+  stm32_otg_t *otgp = usbp->otg;
+
+  otgp->oe[0].DOEPTSIZ = DOEPTSIZ_STUPCNT(3) | DOEPTSIZ_PKTCNT(1) |
+                         DOEPTSIZ_XFRSIZ(24);
+  otgp->oe[0].DOEPDMA  = (uint32_t)usbp->epc[0]->setup_buf;
+  STM32_USB_OTG_DMA_BUF_INVALIDATE(usbp->epc[0]->setup_buf, 24);
+  otgp->oe[0].DOEPCTL |= DOEPCTL_EPENA;
+}
+#endif /* STM32_USB_OTG2_USE_DMA */
+
 /**
  * @brief   Writes to a TX FIFO.
  *
@@ -377,6 +417,15 @@ static void otg_epin_handler(USBDriver *usbp, usbep_t ep) {
     /* Transmit transfer complete.*/
     USBInEndpointState *isp = usbp->epc[ep]->in_state;
 
+#if STM32_USB_OTG2_USE_DMA
+    if (otg_dma_mode(usbp)) {
+      /* In DMA mode the buffer pointer and the counter are not advanced
+         by the FIFO filling code, it is done here instead.*/
+      isp->txbuf += isp->txsize;
+      isp->txcnt  = isp->txsize;
+    }
+#endif
+
     if (isp->txsize < isp->totsize) {
       /* In case the transaction covered only part of the total transfer
          then another transaction is immediately started in order to
@@ -390,6 +439,16 @@ static void otg_epin_handler(USBDriver *usbp, usbep_t ep) {
     else {
       /* End on IN transfer.*/
       _usb_isr_invoke_in_cb(usbp, ep);
+
+#if STM32_USB_OTG2_USE_DMA
+      /* In DMA mode the reception of the next setup packet must be
+         explicitly armed, it is done when the callback has not started
+         another OUT transaction on the endpoint zero.*/
+      if (otg_dma_mode(usbp) && (ep == 0) &&
+          ((otgp->oe[0].DOEPCTL & DOEPCTL_EPENA) == 0)) {
+        otg_ep0out_setup_arm(usbp);
+      }
+#endif
     }
   }
   if ((epint & DIEPINT_TXFE) &&
@@ -424,6 +483,23 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
   otgp->oe[ep].DOEPINT = epint;
 
   if ((epint & DOEPINT_STUP) && (otgp->DOEPMSK & DOEPMSK_STUPM)) {
+#if STM32_USB_OTG2_USE_DMA
+    if (otg_dma_mode(usbp)) {
+      uint32_t nsetup = 3U - ((otgp->oe[ep].DOEPTSIZ &
+                               DOEPTSIZ_STUPCNT_MASK) >> 29);
+
+      /* The DMA engine deposits back-to-back setup packets consecutively
+         in memory, the last received one is the valid one and is moved
+         at the buffer start when required.*/
+      STM32_USB_OTG_DMA_BUF_INVALIDATE(usbp->epc[ep]->setup_buf, 24);
+      if (nsetup > 1U) {
+        memcpy(usbp->epc[ep]->setup_buf,
+               usbp->epc[ep]->setup_buf + ((nsetup - 1U) * 8U),
+               8U);
+      }
+    }
+#endif
+
     /* Setup packets handling, setup packets are handled using a
        specific callback.*/
     _usb_isr_invoke_setup_cb(usbp, ep);
@@ -435,6 +511,32 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
     /* OUT state structure pointer for this endpoint.*/
     osp = usbp->epc[ep]->out_state;
 
+#if STM32_USB_OTG2_USE_DMA
+    if (otg_dma_mode(usbp)) {
+      uint32_t cnt, pcnt, rxsize;
+
+      /* In DMA mode an OUT transaction end interrupt can be generated
+         also at the end of the setup phase, it is ignored when the
+         endpoint zero state machine is not in an OUT state.*/
+      if ((ep == 0) && ((usbp->ep0state & USB_OUT_STATE) == 0))
+        return;
+
+      /* In DMA mode the buffer pointer and the counter are not advanced
+         by the RX FIFO draining code, the received size is reconstructed
+         from the transfer size register which counts down from the
+         programmed value.*/
+      pcnt   = ((uint32_t)osp->rxsize + usbp->epc[ep]->out_maxsize - 1U) /
+               usbp->epc[ep]->out_maxsize;
+      rxsize = (pcnt * usbp->epc[ep]->out_maxsize + 3U) & 0xFFFFFFFCU;
+      cnt    = rxsize - (otgp->oe[ep].DOEPTSIZ & DOEPTSIZ_XFRSIZ_MASK);
+      if (cnt > osp->rxsize)
+        cnt = (uint32_t)osp->rxsize;
+      STM32_USB_OTG_DMA_BUF_INVALIDATE(osp->rxbuf, cnt);
+      osp->rxbuf += cnt;
+      osp->rxcnt += cnt;
+    }
+#endif
+
     /* EP0 requires special handling.*/
     if (ep == 0) {
 
@@ -463,6 +565,16 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
 
     /* End on OUT transfer.*/
     _usb_isr_invoke_out_cb(usbp, ep);
+
+#if STM32_USB_OTG2_USE_DMA
+    /* In DMA mode the reception of the next setup packet must be
+       explicitly armed, it is done when the callback has not started
+       another OUT transaction on the endpoint zero.*/
+    if (otg_dma_mode(usbp) && (ep == 0) &&
+        ((otgp->oe[0].DOEPCTL & DOEPCTL_EPENA) == 0)) {
+      otg_ep0out_setup_arm(usbp);
+    }
+#endif
   }
 }
 
@@ -908,6 +1020,13 @@ void usb_lld_start(USBDriver *usbp) {
     /* Interrupts on TXFIFOs half empty.*/
     otgp->GAHBCFG = 0;
 
+#if STM32_USB_OTG2_USE_DMA
+    /* Internal DMA mode, the FIFOs are serviced by the DMA engine using
+       INCR4 bursts.*/
+    if (otg_dma_mode(usbp))
+      otgp->GAHBCFG = GAHBCFG_DMAEN | GAHBCFG_HBSTLEN(3);
+#endif
+
     /* Endpoints re-initialization.*/
     otg_disable_ep(usbp);
 
@@ -1032,7 +1151,16 @@ void usb_lld_reset(USBDriver *usbp) {
   otgp->DCFG = (otgp->DCFG & ~DCFG_DAD_MASK) | DCFG_DAD(0);
 
   /* Enables also EP-related interrupt sources.*/
+#if STM32_USB_OTG2_USE_DMA
+  /* In DMA mode the RX FIFO is drained by the DMA engine, the RXFLVL
+     interrupt must stay masked.*/
+  if (otg_dma_mode(usbp))
+    otgp->GINTMSK |= GINTMSK_OEPM | GINTMSK_IEPM;
+  else
+    otgp->GINTMSK |= GINTMSK_RXFLVLM | GINTMSK_OEPM | GINTMSK_IEPM;
+#else
   otgp->GINTMSK  |= GINTMSK_RXFLVLM | GINTMSK_OEPM  | GINTMSK_IEPM;
+#endif
   otgp->DIEPMSK   = DIEPMSK_TOCM    | DIEPMSK_XFRCM;
   otgp->DOEPMSK   = DOEPMSK_STUPM   | DOEPMSK_XFRCM;
 
@@ -1047,6 +1175,13 @@ void usb_lld_reset(USBDriver *usbp) {
   otgp->DIEPTXF0 = DIEPTXF_INEPTXFD(ep0config.in_maxsize / 4) |
                    DIEPTXF_INEPTXSA(otg_ram_alloc(usbp,
                                                   ep0config.in_maxsize / 4));
+
+#if STM32_USB_OTG2_USE_DMA
+  /* In DMA mode the reception of setup packets must be explicitly
+     armed.*/
+  if (otg_dma_mode(usbp))
+    otg_ep0out_setup_arm(usbp);
+#endif
 }
 
 /**
@@ -1242,6 +1377,16 @@ void usb_lld_start_out(USBDriver *usbp, usbep_t ep) {
   usbp->otg->oe[ep].DOEPTSIZ = DOEPTSIZ_STUPCNT(3) | DOEPTSIZ_PKTCNT(pcnt) |
                                DOEPTSIZ_XFRSIZ(rxsize);
 
+#if STM32_USB_OTG2_USE_DMA
+  if (otg_dma_mode(usbp)) {
+    osalDbgAssert(((uint32_t)osp->rxbuf & 3U) == 0U,
+                  "unaligned buffer in DMA mode");
+
+    STM32_USB_OTG_DMA_BUF_INVALIDATE(osp->rxbuf, rxsize);
+    usbp->otg->oe[ep].DOEPDMA = (uint32_t)osp->rxbuf;
+  }
+#endif
+
   /* Special case of isochronous endpoint.*/
   if ((usbp->epc[ep]->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_ISOC) {
     /* Odd/even bit toggling for isochronous endpoint.*/
@@ -1284,6 +1429,16 @@ void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
                                  DIEPTSIZ_XFRSIZ(isp->txsize);
   }
 
+#if STM32_USB_OTG2_USE_DMA
+  if (otg_dma_mode(usbp)) {
+    osalDbgAssert(((uint32_t)isp->txbuf & 3U) == 0U,
+                  "unaligned buffer in DMA mode");
+
+    STM32_USB_OTG_DMA_BUF_CLEAN(isp->txbuf, isp->txsize);
+    usbp->otg->ie[ep].DIEPDMA = (uint32_t)isp->txbuf;
+  }
+#endif
+
   /* Special case of isochronous endpoint.*/
   if ((usbp->epc[ep]->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_ISOC) {
     /* Odd/even bit toggling.*/
@@ -1295,7 +1450,15 @@ void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
 
   /* Starting operation.*/
   usbp->otg->ie[ep].DIEPCTL |= DIEPCTL_EPENA | DIEPCTL_CNAK;
+
+#if STM32_USB_OTG2_USE_DMA
+  /* In DMA mode the TX FIFO is filled by the DMA engine, the FIFO empty
+     interrupt is not used.*/
+  if (!otg_dma_mode(usbp))
+    usbp->otg->DIEPEMPMSK |= DIEPEMPMSK_INEPTXFEM(ep);
+#else
   usbp->otg->DIEPEMPMSK |= DIEPEMPMSK_INEPTXFEM(ep);
+#endif
 }
 
 /**
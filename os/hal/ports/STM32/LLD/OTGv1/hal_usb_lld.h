@@ -109,6 +109,49 @@
 #define STM32_USE_USB_OTG2_HS               TRUE
 #endif
 
+/**
+ * @brief   OTG2 internal DMA enable switch.
+ * @details If set to @p TRUE the FIFOs of the OTG_HS cell are serviced by
+ *          the internal DMA engine instead of the CPU, removing the FIFO
+ *          copy loops from the interrupt handler.
+ * @note    Only the OTG_HS cell has the internal DMA, the option cannot
+ *          be used with OTG_FS.
+ * @note    In DMA mode all the transfer buffers, including the setup
+ *          buffers of control endpoints, must be 32 bits aligned. The
+ *          core cannot fall back to FIFO access on a per-endpoint basis
+ *          so the alignment is enforced with a debug assertion.
+ * @note    Setup buffers of control endpoints must be able to hold up to
+ *          three back-to-back setup packets (24 bytes) because the DMA
+ *          deposits them consecutively in memory.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(STM32_USB_OTG2_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_USB_OTG2_USE_DMA              FALSE
+#endif
+
+/**
+ * @brief   DMA buffer cache clean hook.
+ * @details Invoked before starting a DMA transmission, on devices with a
+ *          data cache it must clean the cache lines covering the buffer,
+ *          for example using @p SCB_CleanDCache_by_Addr(). The default is
+ *          an empty hook, suitable for cores without a data cache.
+ */
+#if !defined(STM32_USB_OTG_DMA_BUF_CLEAN) || defined(__DOXYGEN__)
+#define STM32_USB_OTG_DMA_BUF_CLEAN(addr, n)
+#endif
+
+/**
+ * @brief   DMA buffer cache invalidate hook.
+ * @details Invoked before starting and after completing a DMA reception,
+ *          on devices with a data cache it must invalidate the cache
+ *          lines covering the buffer, for example using
+ *          @p SCB_InvalidateDCache_by_Addr(). The default is an empty
+ *          hook, suitable for cores without a data cache.
+ */
+#if !defined(STM32_USB_OTG_DMA_BUF_INVALIDATE) || defined(__DOXYGEN__)
+#define STM32_USB_OTG_DMA_BUF_INVALIDATE(addr, n)
+#endif
+
 /**
  * @brief   Dedicated data pump threads priority.
  */
@@ -235,6 +278,10 @@
 #error "OTG2 RX FIFO size must be a multiple of 4"
 #endif
 
+#if STM32_USB_OTG2_USE_DMA && !STM32_USB_USE_OTG2
+#error "STM32_USB_OTG2_USE_DMA requires STM32_USB_USE_OTG2"
+#endif
+
 #if defined(STM32F2XX) || defined(STM32F4XX) || defined(STM32F7XX)
 #define STM32_USBCLK                        STM32_PLL48CLK
 #elif defined(STM32F10X_CL)
@@ -287,6 +334,20 @@ typedef struct {
    * @brief   Waiting thread.
    */
   thread_reference_t            thread;
+#endif
+#if (USB_USE_TRANSFER_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Queued transfer buffer pointer.
+   */
+  const uint8_t                 *next_txbuf;
+  /**
+   * @brief   Queued transfer size.
+   */
+  size_t                        next_txsize;
+  /**
+   * @brief   Queued transfer pending flag.
+   */
+  bool                          next_pending;
 #endif
   /* End of the mandatory fields.*/
   /**
@@ -316,6 +377,20 @@ typedef struct {
    * @brief   Waiting thread.
    */
   thread_reference_t            thread;
+#endif
+#if (USB_USE_TRANSFER_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Queued transfer buffer pointer.
+   */
+  uint8_t                       *next_rxbuf;
+  /**
+   * @brief   Queued transfer size.
+   */
+  size_t                        next_rxsize;
+  /**
+   * @brief   Queued transfer pending flag.
+   */
+  bool                          next_pending;
 #endif
   /* End of the mandatory fields.*/
   /**
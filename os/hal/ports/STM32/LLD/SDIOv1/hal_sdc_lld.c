@@ -326,6 +326,13 @@ OSAL_IRQ_HANDLER(STM32_SDIO_HANDLER) {
      read/write functions needs to check them.*/
   SDIO->MASK = 0;
 
+#if SDC_USE_ASYNC == TRUE
+  /* Notifies the end of the data phase of an asynchronous transfer, the
+     transaction is then finalized by sdc_lld_finish_transfer().*/
+  if ((SDCD1.asyncblocks > 0U) && (SDCD1.end_cb != NULL))
+    SDCD1.end_cb(&SDCD1);
+#endif
+
   osalThreadResumeI(&SDCD1.thread, MSG_OK);
 
   osalSysUnlockFromISR();
@@ -346,6 +353,10 @@ void sdc_lld_init(void) {
 
   sdcObjectInit(&SDCD1);
   SDCD1.thread = NULL;
+#if SDC_USE_ASYNC == TRUE
+  SDCD1.end_cb      = NULL;
+  SDCD1.asyncblocks = 0;
+#endif
   SDCD1.dma    = STM32_DMA_STREAM(STM32_SDC_SDIO_DMA_STREAM);
   SDCD1.sdio   = SDIO;
 }
@@ -783,6 +794,172 @@ error:
   return HAL_FAILED;
 }
 
+#if (SDC_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous read of one or more blocks.
+ * @details The function returns after the data transfer has been started,
+ *          the transaction is finalized by @p sdc_lld_finish_transfer().
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[out] buf      pointer to the read buffer, it must be aligned to
+ *                      a 32 bits boundary
+ * @param[in] blocks    number of blocks to read
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_read(SDCDriver *sdcp, uint32_t startblk,
+                        uint8_t *buf, uint32_t blocks) {
+  uint32_t resp[1];
+
+  osalDbgCheck(blocks < 0x1000000 / MMCSD_BLOCK_SIZE);
+  osalDbgAssert((((unsigned)buf & 3) == 0), "unaligned buffer");
+
+  sdcp->sdio->DTIMER = STM32_SDC_READ_TIMEOUT;
+
+  /* Checks for errors and waits for the card to be ready for reading.*/
+  if (_sdc_wait_for_transfer_state(sdcp))
+    return HAL_FAILED;
+
+  /* Prepares the DMA channel for reading.*/
+  dmaStreamSetMemory0(sdcp->dma, buf);
+  dmaStreamSetTransactionSize(sdcp->dma,
+                              (blocks * MMCSD_BLOCK_SIZE) / sizeof (uint32_t));
+  dmaStreamSetMode(sdcp->dma, sdcp->dmamode | STM32_DMA_CR_DIR_P2M);
+  dmaStreamEnable(sdcp->dma);
+
+  /* The transaction is flagged before enabling the interrupt sources so
+     the ISR can notify its data end.*/
+  sdcp->asyncblocks = blocks;
+
+  /* Setting up data transfer.*/
+  sdcp->sdio->ICR   = STM32_SDIO_ICR_ALL_FLAGS;
+  sdcp->sdio->MASK  = SDIO_MASK_DCRCFAILIE |
+                      SDIO_MASK_DTIMEOUTIE |
+                      SDIO_MASK_STBITERRIE |
+                      SDIO_MASK_RXOVERRIE |
+                      SDIO_MASK_DATAENDIE;
+  sdcp->sdio->DLEN  = blocks * MMCSD_BLOCK_SIZE;
+
+  /* Transaction starts just after DTEN bit setting.*/
+  sdcp->sdio->DCTRL = SDIO_DCTRL_DTDIR |
+                      SDIO_DCTRL_DBLOCKSIZE_3 |
+                      SDIO_DCTRL_DBLOCKSIZE_0 |
+                      SDIO_DCTRL_DMAEN |
+                      SDIO_DCTRL_DTEN;
+
+  if (sdc_lld_prepare_read(sdcp, startblk, blocks, resp) == true)
+    goto error;
+
+  return HAL_SUCCESS;
+
+error:
+  sdcp->asyncblocks = 0;
+  sdc_lld_error_cleanup(sdcp, blocks, resp);
+  return HAL_FAILED;
+}
+
+/**
+ * @brief   Starts an asynchronous write of one or more blocks.
+ * @details The function returns after the data transfer has been started,
+ *          the transaction is finalized by @p sdc_lld_finish_transfer().
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] buf       pointer to the write buffer, it must be aligned to
+ *                      a 32 bits boundary
+ * @param[in] blocks    number of blocks to write
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_write(SDCDriver *sdcp, uint32_t startblk,
+                         const uint8_t *buf, uint32_t blocks) {
+  uint32_t resp[1];
+
+  osalDbgCheck(blocks < 0x1000000 / MMCSD_BLOCK_SIZE);
+  osalDbgAssert((((unsigned)buf & 3) == 0), "unaligned buffer");
+
+  sdcp->sdio->DTIMER = STM32_SDC_WRITE_TIMEOUT;
+
+  /* Checks for errors and waits for the card to be ready for writing.*/
+  if (_sdc_wait_for_transfer_state(sdcp))
+    return HAL_FAILED;
+
+  /* Prepares the DMA channel for writing.*/
+  dmaStreamSetMemory0(sdcp->dma, buf);
+  dmaStreamSetTransactionSize(sdcp->dma,
+                             (blocks * MMCSD_BLOCK_SIZE) / sizeof (uint32_t));
+  dmaStreamSetMode(sdcp->dma, sdcp->dmamode | STM32_DMA_CR_DIR_M2P);
+  dmaStreamEnable(sdcp->dma);
+
+  /* The transaction is flagged before enabling the interrupt sources so
+     the ISR can notify its data end.*/
+  sdcp->asyncblocks = blocks;
+
+  /* Setting up data transfer.*/
+  sdcp->sdio->ICR   = STM32_SDIO_ICR_ALL_FLAGS;
+  sdcp->sdio->MASK  = SDIO_MASK_DCRCFAILIE |
+                      SDIO_MASK_DTIMEOUTIE |
+                      SDIO_MASK_STBITERRIE |
+                      SDIO_MASK_TXUNDERRIE |
+                      SDIO_MASK_DATAENDIE;
+  sdcp->sdio->DLEN  = blocks * MMCSD_BLOCK_SIZE;
+
+  /* Talk to card what we want from it.*/
+  if (sdc_lld_prepare_write(sdcp, startblk, blocks, resp) == true)
+    goto error;
+
+  /* Transaction starts just after DTEN bit setting.*/
+  sdcp->sdio->DCTRL = SDIO_DCTRL_DBLOCKSIZE_3 |
+                      SDIO_DCTRL_DBLOCKSIZE_0 |
+                      SDIO_DCTRL_DMAEN |
+                      SDIO_DCTRL_DTEN;
+
+  return HAL_SUCCESS;
+
+error:
+  sdcp->asyncblocks = 0;
+  sdc_lld_error_cleanup(sdcp, blocks, resp);
+  return HAL_FAILED;
+}
+
+/**
+ * @brief   Completes an asynchronous transfer.
+ * @details If the data phase is still in progress then the invoking
+ *          thread is suspended until its end, then the transaction is
+ *          finalized, stop command included.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool sdc_lld_finish_transfer(SDCDriver *sdcp) {
+  uint32_t resp[1];
+  uint32_t blocks = sdcp->asyncblocks;
+
+  osalDbgAssert(blocks > 0U, "no transfer in progress");
+
+  sdcp->asyncblocks = 0;
+  if (sdc_lld_wait_transaction_end(sdcp, blocks, resp) == true) {
+    sdc_lld_error_cleanup(sdcp, blocks, resp);
+    return HAL_FAILED;
+  }
+  return HAL_SUCCESS;
+}
+#endif /* SDC_USE_ASYNC == TRUE */
+
 /**
  * @brief   Reads one or more blocks.
  *
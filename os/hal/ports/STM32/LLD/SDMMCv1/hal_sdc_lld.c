@@ -347,6 +347,13 @@ OSAL_IRQ_HANDLER(STM32_SDMMC1_HANDLER) {
      read/write functions needs to check them.*/
   SDMMC1->MASK = 0;
 
+#if SDC_USE_ASYNC == TRUE
+  /* Notifies the end of the data phase of an asynchronous transfer, the
+     transaction is then finalized by sdc_lld_finish_transfer().*/
+  if ((SDCD1.asyncblocks > 0U) && (SDCD1.end_cb != NULL))
+    SDCD1.end_cb(&SDCD1);
+#endif
+
   osalThreadResumeI(&SDCD1.thread, MSG_OK);
 
   osalSysUnlockFromISR();
@@ -373,6 +380,13 @@ OSAL_IRQ_HANDLER(STM32_SDMMC2_HANDLER) {
      read/write functions needs to check them.*/
   SDMMC2->MASK = 0;
 
+#if SDC_USE_ASYNC == TRUE
+  /* Notifies the end of the data phase of an asynchronous transfer, the
+     transaction is then finalized by sdc_lld_finish_transfer().*/
+  if ((SDCD2.asyncblocks > 0U) && (SDCD2.end_cb != NULL))
+    SDCD2.end_cb(&SDCD2);
+#endif
+
   osalThreadResumeI(&SDCD2.thread, MSG_OK);
 
   osalSysUnlockFromISR();
@@ -395,6 +409,10 @@ void sdc_lld_init(void) {
 #if STM32_SDC_USE_SDMMC1
   sdcObjectInit(&SDCD1);
   SDCD1.thread = NULL;
+#if SDC_USE_ASYNC == TRUE
+  SDCD1.end_cb      = NULL;
+  SDCD1.asyncblocks = 0;
+#endif
   SDCD1.rtmo   = SDMMC1_READ_TIMEOUT;
   SDCD1.wtmo   = SDMMC1_WRITE_TIMEOUT;
   SDCD1.dma    = STM32_DMA_STREAM(STM32_SDC_SDMMC1_DMA_STREAM);
@@ -405,6 +423,10 @@ void sdc_lld_init(void) {
 #if STM32_SDC_USE_SDMMC2
   sdcObjectInit(&SDCD2);
   SDCD2.thread = NULL;
+#if SDC_USE_ASYNC == TRUE
+  SDCD2.end_cb      = NULL;
+  SDCD2.asyncblocks = 0;
+#endif
   SDCD2.rtmo   = SDMMC2_READ_TIMEOUT;
   SDCD2.wtmo   = SDMMC2_WRITE_TIMEOUT;
   SDCD2.dma    = STM32_DMA_STREAM(STM32_SDC_SDMMC2_DMA_STREAM);
@@ -895,6 +917,170 @@ error:
   return HAL_FAILED;
 }
 
+#if (SDC_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous read of one or more blocks.
+ * @details The function returns after the data transfer has been started,
+ *          the transaction is finalized by @p sdc_lld_finish_transfer().
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[out] buf      pointer to the read buffer, it must be aligned to
+ *                      a 32 bits boundary
+ * @param[in] blocks    number of blocks to read
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_read(SDCDriver *sdcp, uint32_t startblk,
+                        uint8_t *buf, uint32_t blocks) {
+  uint32_t resp[1];
+
+  osalDbgCheck(blocks < 0x1000000 / MMCSD_BLOCK_SIZE);
+  osalDbgAssert((((unsigned)buf & 3) == 0), "unaligned buffer");
+
+  sdcp->sdmmc->DTIMER = sdcp->rtmo;
+
+  /* Checks for errors and waits for the card to be ready for reading.*/
+  if (_sdc_wait_for_transfer_state(sdcp))
+    return HAL_FAILED;
+
+  /* Prepares the DMA channel for reading.*/
+  dmaStreamSetMemory0(sdcp->dma, buf);
+  dmaStreamSetTransactionSize(sdcp->dma,
+                              (blocks * MMCSD_BLOCK_SIZE) / sizeof (uint32_t));
+  dmaStreamSetMode(sdcp->dma, sdcp->dmamode | STM32_DMA_CR_DIR_P2M);
+  dmaStreamEnable(sdcp->dma);
+
+  /* The transaction is flagged before enabling the interrupt sources so
+     the ISR can notify its data end.*/
+  sdcp->asyncblocks = blocks;
+
+  /* Setting up data transfer.*/
+  sdcp->sdmmc->ICR   = SDMMC_ICR_ALL_FLAGS;
+  sdcp->sdmmc->MASK  = SDMMC_MASK_DCRCFAILIE |
+                       SDMMC_MASK_DTIMEOUTIE |
+                       SDMMC_MASK_RXOVERRIE |
+                       SDMMC_MASK_DATAENDIE;
+  sdcp->sdmmc->DLEN  = blocks * MMCSD_BLOCK_SIZE;
+
+  /* Transaction starts just after DTEN bit setting.*/
+  sdcp->sdmmc->DCTRL = SDMMC_DCTRL_DTDIR |
+                       SDMMC_DCTRL_DBLOCKSIZE_3 |
+                       SDMMC_DCTRL_DBLOCKSIZE_0 |
+                       SDMMC_DCTRL_DMAEN |
+                       SDMMC_DCTRL_DTEN;
+
+  if (sdc_lld_prepare_read(sdcp, startblk, blocks, resp) == true)
+    goto error;
+
+  return HAL_SUCCESS;
+
+error:
+  sdcp->asyncblocks = 0;
+  sdc_lld_error_cleanup(sdcp, blocks, resp);
+  return HAL_FAILED;
+}
+
+/**
+ * @brief   Starts an asynchronous write of one or more blocks.
+ * @details The function returns after the data transfer has been started,
+ *          the transaction is finalized by @p sdc_lld_finish_transfer().
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] buf       pointer to the write buffer, it must be aligned to
+ *                      a 32 bits boundary
+ * @param[in] blocks    number of blocks to write
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_write(SDCDriver *sdcp, uint32_t startblk,
+                         const uint8_t *buf, uint32_t blocks) {
+  uint32_t resp[1];
+
+  osalDbgCheck(blocks < 0x1000000 / MMCSD_BLOCK_SIZE);
+  osalDbgAssert((((unsigned)buf & 3) == 0), "unaligned buffer");
+
+  sdcp->sdmmc->DTIMER = sdcp->wtmo;
+
+  /* Checks for errors and waits for the card to be ready for writing.*/
+  if (_sdc_wait_for_transfer_state(sdcp))
+    return HAL_FAILED;
+
+  /* Prepares the DMA channel for writing.*/
+  dmaStreamSetMemory0(sdcp->dma, buf);
+  dmaStreamSetTransactionSize(sdcp->dma,
+                             (blocks * MMCSD_BLOCK_SIZE) / sizeof (uint32_t));
+  dmaStreamSetMode(sdcp->dma, sdcp->dmamode | STM32_DMA_CR_DIR_M2P);
+  dmaStreamEnable(sdcp->dma);
+
+  /* The transaction is flagged before enabling the interrupt sources so
+     the ISR can notify its data end.*/
+  sdcp->asyncblocks = blocks;
+
+  /* Setting up data transfer.*/
+  sdcp->sdmmc->ICR   = SDMMC_ICR_ALL_FLAGS;
+  sdcp->sdmmc->MASK  = SDMMC_MASK_DCRCFAILIE |
+                       SDMMC_MASK_DTIMEOUTIE |
+                       SDMMC_MASK_TXUNDERRIE |
+                       SDMMC_MASK_DATAENDIE;
+  sdcp->sdmmc->DLEN  = blocks * MMCSD_BLOCK_SIZE;
+
+  /* Talk to card what we want from it.*/
+  if (sdc_lld_prepare_write(sdcp, startblk, blocks, resp) == true)
+    goto error;
+
+  /* Transaction starts just after DTEN bit setting.*/
+  sdcp->sdmmc->DCTRL = SDMMC_DCTRL_DBLOCKSIZE_3 |
+                       SDMMC_DCTRL_DBLOCKSIZE_0 |
+                       SDMMC_DCTRL_DMAEN |
+                       SDMMC_DCTRL_DTEN;
+
+  return HAL_SUCCESS;
+
+error:
+  sdcp->asyncblocks = 0;
+  sdc_lld_error_cleanup(sdcp, blocks, resp);
+  return HAL_FAILED;
+}
+
+/**
+ * @brief   Completes an asynchronous transfer.
+ * @details If the data phase is still in progress then the invoking
+ *          thread is suspended until its end, then the transaction is
+ *          finalized, stop command included.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool sdc_lld_finish_transfer(SDCDriver *sdcp) {
+  uint32_t resp[1];
+  uint32_t blocks = sdcp->asyncblocks;
+
+  osalDbgAssert(blocks > 0U, "no transfer in progress");
+
+  sdcp->asyncblocks = 0;
+  if (sdc_lld_wait_transaction_end(sdcp, blocks, resp) == true) {
+    sdc_lld_error_cleanup(sdcp, blocks, resp);
+    return HAL_FAILED;
+  }
+  return HAL_SUCCESS;
+}
+#endif /* SDC_USE_ASYNC == TRUE */
+
 /**
  * @brief   Reads one or more blocks.
  *
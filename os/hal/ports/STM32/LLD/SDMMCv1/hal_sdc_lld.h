@@ -31,6 +31,11 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   This implementation supports the asynchronous transfer API.
+ */
+#define SDC_SUPPORTS_ASYNC      TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -329,6 +334,16 @@ struct SDCDriver {
    * @brief Thread waiting for I/O completion IRQ.
    */
   thread_reference_t        thread;
+#if (SDC_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief     End of data phase callback for asynchronous transfers.
+   */
+  sdccallback_t             end_cb;
+  /**
+   * @brief     Blocks count of the asynchronous transfer in progress.
+   */
+  uint32_t                  asyncblocks;
+#endif
   /**
    * @brief     DTIMER register value for read operations.
    */
@@ -391,6 +406,13 @@ extern "C" {
                     uint8_t *buf, uint32_t blocks);
   bool sdc_lld_write(SDCDriver *sdcp, uint32_t startblk,
                      const uint8_t *buf, uint32_t blocks);
+#if SDC_USE_ASYNC == TRUE
+  bool sdc_lld_start_read(SDCDriver *sdcp, uint32_t startblk,
+                          uint8_t *buf, uint32_t blocks);
+  bool sdc_lld_start_write(SDCDriver *sdcp, uint32_t startblk,
+                           const uint8_t *buf, uint32_t blocks);
+  bool sdc_lld_finish_transfer(SDCDriver *sdcp);
+#endif
   bool sdc_lld_sync(SDCDriver *sdcp);
   bool sdc_lld_is_card_inserted(SDCDriver *sdcp);
   bool sdc_lld_is_write_protected(SDCDriver *sdcp);
@@ -366,6 +366,12 @@ struct I2SDriver {
    * @brief   Current configuration data.
    */
   const I2SConfig           *config;
+#if (I2S_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timestamp of the latest buffer event.
+   */
+  systime_t                 timestamp;
+#endif /* I2S_USE_TIMESTAMP */
   /* End of the mandatory fields.*/
   /**
    * @brief   Pointer to the SPIx registers block.
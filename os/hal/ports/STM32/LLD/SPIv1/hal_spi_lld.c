@@ -445,10 +445,19 @@ void spi_lld_start(SPIDriver *spip) {
 
   /* SPI setup and enable.*/
   spip->spi->CR1 &= ~SPI_CR1_SPE;
-  spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR | SPI_CR1_SSM |
-                    SPI_CR1_SSI;
-  spip->spi->CR2  = spip->config->cr2 | SPI_CR2_SSOE | SPI_CR2_RXDMAEN |
-                    SPI_CR2_TXDMAEN;
+  if (spip->config->slave) {
+    /* In slave mode the clock and the slave select are driven by the
+       master, NSS management is left to the application through cr1.*/
+    spip->spi->CR1  = spip->config->cr1 & ~SPI_CR1_MSTR;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_RXDMAEN |
+                      SPI_CR2_TXDMAEN;
+  }
+  else {
+    spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR | SPI_CR1_SSM |
+                      SPI_CR1_SSI;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_SSOE | SPI_CR2_RXDMAEN |
+                      SPI_CR2_TXDMAEN;
+  }
   spip->spi->CR1 |= SPI_CR1_SPE;
 }
 
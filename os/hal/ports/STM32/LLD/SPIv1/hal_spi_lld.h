@@ -36,6 +36,11 @@
  */
 #define SPI_SUPPORTS_CIRCULAR           TRUE
 
+/**
+ * @brief   Slave mode support flag.
+ */
+#define SPI_SUPPORTS_SLAVE_MODE         TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -431,6 +436,12 @@ typedef struct {
    * @brief   Enables the circular buffer mode.
    */
   bool                      circular;
+#endif
+#if (SPI_SUPPORTS_SLAVE_MODE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Enables the slave mode.
+   */
+  bool                      slave;
 #endif
   /**
    * @brief Operation complete callback or @p NULL.
@@ -497,6 +508,16 @@ struct SPIDriver {
    */
   mutex_t                   mutex;
 #endif /* SPI_USE_MUTUAL_EXCLUSION */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the queued transactions list.
+   */
+  spi_transaction_t         *txnhead;
+  /**
+   * @brief   Tail of the queued transactions list.
+   */
+  spi_transaction_t         *txntail;
+#endif /* SPI_USE_TRANSACTIONS */
 #if defined(SPI_DRIVER_EXT_FIELDS)
   SPI_DRIVER_EXT_FIELDS
 #endif
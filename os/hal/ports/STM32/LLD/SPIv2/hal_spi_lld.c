@@ -445,11 +445,26 @@ void spi_lld_start(SPIDriver *spip) {
     spip->txdmamode &= ~(STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE);
   }
 
+  /* The NSS pulse feature is specific to the Motorola frame format and
+     must not be combined with the TI mode.*/
+  osalDbgAssert((spip->config->cr2 & (SPI_CR2_FRF | SPI_CR2_NSSP)) !=
+                (SPI_CR2_FRF | SPI_CR2_NSSP),
+                "NSSP not allowed in TI mode");
+
   /* SPI setup and enable.*/
   spip->spi->CR1 &= ~SPI_CR1_SPE;
-  spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR;
-  spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH | SPI_CR2_SSOE |
-                    SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+  if (spip->config->slave) {
+    /* In slave mode the clock and the slave select are driven by the
+       master, NSS management is left to the application through cr1.*/
+    spip->spi->CR1  = spip->config->cr1 & ~SPI_CR1_MSTR;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH |
+                      SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+  }
+  else {
+    spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH | SPI_CR2_SSOE |
+                      SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+  }
   spip->spi->CR1 |= SPI_CR1_SPE;
 }
 
@@ -36,6 +36,11 @@
  */
 #define SPI_SUPPORTS_CIRCULAR           TRUE
 
+/**
+ * @brief   Slave mode support flag.
+ */
+#define SPI_SUPPORTS_SLAVE_MODE         TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -431,6 +436,12 @@ typedef struct {
    * @brief   Enables the circular buffer mode.
    */
   bool                      circular;
+#endif
+#if (SPI_SUPPORTS_SLAVE_MODE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Enables the slave mode.
+   */
+  bool                      slave;
 #endif
   /**
    * @brief Operation complete callback or @p NULL.
@@ -469,6 +480,16 @@ typedef struct {
   uint16_t                  cr1;
   /**
    * @brief SPI CR2 register initialization data.
+   * @note    The bits FRXTH, RXDMAEN and TXDMAEN are enforced internally
+   *          to the driver, in master mode SSOE is enforced too, keep
+   *          them to zero.
+   * @note    Hardware chip select timing is controlled from this field:
+   *          @p SPI_CR2_NSSP makes the SPI generate an NSS pulse between
+   *          frames, @p SPI_CR2_FRF selects the TI frame format with its
+   *          hardware-timed NSS strobes. When NSS is driven by hardware
+   *          select @p SPI_SELECT_MODE_NONE, @p spiSelect() and
+   *          @p spiUnselect() then become empty and the inter-frame
+   *          timing is exact regardless of scheduler activity.
    */
   uint16_t                  cr2;
 } SPIConfig;
@@ -497,6 +518,16 @@ struct SPIDriver {
    */
   mutex_t                   mutex;
 #endif /* SPI_USE_MUTUAL_EXCLUSION */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the queued transactions list.
+   */
+  spi_transaction_t         *txnhead;
+  /**
+   * @brief   Tail of the queued transactions list.
+   */
+  spi_transaction_t         *txntail;
+#endif /* SPI_USE_TRANSACTIONS */
 #if defined(SPI_DRIVER_EXT_FIELDS)
   SPI_DRIVER_EXT_FIELDS
 #endif
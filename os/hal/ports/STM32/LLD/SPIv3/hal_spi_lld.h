@@ -560,10 +560,22 @@ typedef struct {
   /* End of the mandatory fields.*/
   /**
    * @brief SPI CFG1 register initialization data.
+   * @note    The bits FTHLV, RXDMAEN and TXDMAEN are enforced internally
+   *          to the driver, keep them to zero.
    */
   uint32_t                  cfg1;
   /**
    * @brief SPI CFG2 register initialization data.
+   * @note    The bits MASTER and SSOE are enforced internally to the
+   *          driver and the COMM field is cleared, keep them to zero.
+   * @note    Hardware chip select timing is controlled from this field:
+   *          @p SPI_CFG2_SSOM together with @p SPI_CFG2_MSSI_VALUE() and
+   *          @p SPI_CFG2_MIDI_VALUE() gives hardware-exact SS idle pulses
+   *          and inter-data intervals, @p SPI_CFG2_SP_VALUE() selects the
+   *          TI protocol. When NSS is driven by hardware select
+   *          @p SPI_SELECT_MODE_NONE, @p spiSelect() and @p spiUnselect()
+   *          then become empty and the inter-frame timing is exact
+   *          regardless of scheduler activity.
    */
   uint32_t                  cfg2;
 } SPIConfig;
@@ -592,6 +604,16 @@ struct SPIDriver {
    */
   mutex_t                   mutex;
 #endif /* SPI_USE_MUTUAL_EXCLUSION */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the queued transactions list.
+   */
+  spi_transaction_t         *txnhead;
+  /**
+   * @brief   Tail of the queued transactions list.
+   */
+  spi_transaction_t         *txntail;
+#endif /* SPI_USE_TRANSACTIONS */
 #if defined(SPI_DRIVER_EXT_FIELDS)
   SPI_DRIVER_EXT_FIELDS
 #endif
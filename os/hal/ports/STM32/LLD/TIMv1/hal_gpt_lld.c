@@ -884,6 +884,7 @@ void gpt_lld_serve_interrupt(GPTDriver *gptp) {
     gptp->state = GPT_READY;                /* Back in GPT_READY state.     */
     gpt_lld_stop_timer(gptp);               /* Timer automatically stopped. */
   }
+  _gpt_isr_wrap_code(gptp);
   gptp->config->callback(gptp);
 }
 
@@ -138,6 +138,36 @@ static bool icu_lld_wait_edge(ICUDriver *icup) {
   return result;
 }
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared DMA service routine.
+ * @details Each completed half ring is reported through the callback, on
+ *          DMA errors the capture is restarted from an empty ring.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void icu_lld_serve_dma_interrupt(ICUDriver *icup, uint32_t flags) {
+
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0U) {
+    /* The ring content is compromised, restarting the transfer.*/
+    dmaStreamDisable(icup->dmastp);
+    dmaStreamSetMemory0(icup->dmastp, icup->buffer);
+    dmaStreamSetTransactionSize(icup->dmastp, icup->depth);
+    dmaStreamEnable(icup->dmastp);
+  }
+  else {
+    if ((flags & STM32_DMA_ISR_HTIF) != 0U) {
+      icup->buf_cb(icup, icup->buffer, icup->depth / 2U);
+    }
+    if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+      icup->buf_cb(icup, icup->buffer + (icup->depth / 2U),
+                   icup->depth / 2U);
+    }
+  }
+}
+#endif /* ICU_USE_BUFFERED_CAPTURE == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -338,42 +368,119 @@ void icu_lld_init(void) {
   /* Driver initialization.*/
   icuObjectInit(&ICUD1);
   ICUD1.tim = STM32_TIM1;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD1.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM1_DMA_STREAM);
+  ICUD1.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM1_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM1_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD1.dmairqprio = STM32_ICU_TIM1_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM2
   /* Driver initialization.*/
   icuObjectInit(&ICUD2);
   ICUD2.tim = STM32_TIM2;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD2.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM2_DMA_STREAM);
+  ICUD2.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM2_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM2_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD2.dmairqprio = STM32_ICU_TIM2_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM3
   /* Driver initialization.*/
   icuObjectInit(&ICUD3);
   ICUD3.tim = STM32_TIM3;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD3.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM3_DMA_STREAM);
+  ICUD3.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM3_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM3_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD3.dmairqprio = STM32_ICU_TIM3_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM4
   /* Driver initialization.*/
   icuObjectInit(&ICUD4);
   ICUD4.tim = STM32_TIM4;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD4.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM4_DMA_STREAM);
+  ICUD4.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM4_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM4_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD4.dmairqprio = STM32_ICU_TIM4_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM5
   /* Driver initialization.*/
   icuObjectInit(&ICUD5);
   ICUD5.tim = STM32_TIM5;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD5.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM5_DMA_STREAM);
+  ICUD5.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM5_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM5_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD5.dmairqprio = STM32_ICU_TIM5_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM8
   /* Driver initialization.*/
   icuObjectInit(&ICUD8);
   ICUD8.tim = STM32_TIM8;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD8.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM8_DMA_STREAM);
+  ICUD8.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM8_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM8_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD8.dmairqprio = STM32_ICU_TIM8_IRQ_PRIORITY;
+#endif
 #endif
 
 #if STM32_ICU_USE_TIM9
   /* Driver initialization.*/
   icuObjectInit(&ICUD9);
   ICUD9.tim = STM32_TIM9;
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  ICUD9.dmastp  = STM32_DMA_STREAM(STM32_ICU_TIM9_DMA_STREAM);
+  ICUD9.dmamode = STM32_DMA_CR_CHSEL(STM32_ICU_TIM9_DMA_CHANNEL) |
+                  STM32_DMA_CR_PL(STM32_ICU_TIM9_DMA_PRIORITY) |
+                  STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                  STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                  STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                  STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                  STM32_DMA_CR_DMEIE;
+  ICUD9.dmairqprio = STM32_ICU_TIM9_IRQ_PRIORITY;
+#endif
 #endif
 }
 
@@ -802,6 +909,70 @@ void icu_lld_serve_interrupt(ICUDriver *icup) {
     _icu_isr_invoke_overflow_cb(icup);
 }
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a buffered capture.
+ * @details The timer is configured for capture exactly as in notification
+ *          mode but the CC interrupts stay disabled, the period captures
+ *          are transferred into the ring by DMA and served one interrupt
+ *          per half ring.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ *
+ * @notapi
+ */
+void icu_lld_start_buffered_capture(ICUDriver *icup) {
+  bool b;
+
+  /* DMA stream allocation and programming on the period capture
+     register.*/
+  b = dmaStreamAllocate(icup->dmastp, icup->dmairqprio,
+                        (stm32_dmaisr_t)icu_lld_serve_dma_interrupt,
+                        (void *)icup);
+  osalDbgAssert(!b, "stream already allocated");
+  dmaStreamSetPeripheral(icup->dmastp, icup->pccrp);
+  dmaStreamSetMemory0(icup->dmastp, icup->buffer);
+  dmaStreamSetTransactionSize(icup->dmastp, icup->depth);
+  dmaStreamSetMode(icup->dmastp, icup->dmamode);
+  dmaStreamEnable(icup->dmastp);
+
+  /* DMA request enabled on the period capture event.*/
+  if (icup->config->channel == ICU_CHANNEL_1) {
+    icup->tim->DIER |= STM32_TIM_DIER_CC1DE;
+  }
+  else {
+    icup->tim->DIER |= STM32_TIM_DIER_CC2DE;
+  }
+
+  /* Triggering an UG and clearing the IRQ status.*/
+  icup->tim->EGR |= STM32_TIM_EGR_UG;
+  icup->tim->SR = 0;
+
+  /* Timer is started.*/
+  icup->tim->CR1 = STM32_TIM_CR1_URS | STM32_TIM_CR1_CEN;
+}
+
+/**
+ * @brief   Stops a buffered capture.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ *
+ * @notapi
+ */
+void icu_lld_stop_buffered_capture(ICUDriver *icup) {
+
+  /* Timer stopped.*/
+  icup->tim->CR1 = 0;
+
+  /* DMA request disabled.*/
+  icup->tim->DIER &= ~(STM32_TIM_DIER_CC1DE | STM32_TIM_DIER_CC2DE);
+
+  /* DMA stream released.*/
+  dmaStreamDisable(icup->dmastp);
+  dmaStreamRelease(icup->dmastp);
+}
+#endif /* ICU_USE_BUFFERED_CAPTURE == TRUE */
+
 #endif /* HAL_USE_ICU */
 
 /** @} */
@@ -152,6 +152,55 @@
 #if !defined(STM32_ICU_TIM9_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_ICU_TIM9_IRQ_PRIORITY         7
 #endif
+
+/**
+ * @brief   ICUD1 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM1_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM1_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD2 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM2_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM2_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD3 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM3_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM3_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD4 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM4_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM4_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD5 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM5_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM5_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD8 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM8_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM8_DMA_PRIORITY         2
+#endif
+
+/**
+ * @brief   ICUD9 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_TIM9_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_TIM9_DMA_PRIORITY         2
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -286,6 +335,51 @@
 #error "Invalid IRQ priority assigned to TIM9"
 #endif
 
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+#if STM32_ICU_USE_TIM1 && !defined(STM32_ICU_TIM1_DMA_STREAM)
+#error "TIM1 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM1 && !defined(STM32_ICU_TIM1_DMA_CHANNEL)
+#error "TIM1 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM2 && !defined(STM32_ICU_TIM2_DMA_STREAM)
+#error "TIM2 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM2 && !defined(STM32_ICU_TIM2_DMA_CHANNEL)
+#error "TIM2 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM3 && !defined(STM32_ICU_TIM3_DMA_STREAM)
+#error "TIM3 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM3 && !defined(STM32_ICU_TIM3_DMA_CHANNEL)
+#error "TIM3 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM4 && !defined(STM32_ICU_TIM4_DMA_STREAM)
+#error "TIM4 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM4 && !defined(STM32_ICU_TIM4_DMA_CHANNEL)
+#error "TIM4 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM5 && !defined(STM32_ICU_TIM5_DMA_STREAM)
+#error "TIM5 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM5 && !defined(STM32_ICU_TIM5_DMA_CHANNEL)
+#error "TIM5 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM8 && !defined(STM32_ICU_TIM8_DMA_STREAM)
+#error "TIM8 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM8 && !defined(STM32_ICU_TIM8_DMA_CHANNEL)
+#error "TIM8 DMA channel not defined"
+#endif
+#if STM32_ICU_USE_TIM9 && !defined(STM32_ICU_TIM9_DMA_STREAM)
+#error "TIM9 DMA stream not defined"
+#endif
+#if STM32_ICU_USE_TIM9 && !defined(STM32_ICU_TIM9_DMA_CHANNEL)
+#error "TIM9 DMA channel not defined"
+#endif
+#endif /* ICU_USE_BUFFERED_CAPTURE == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -316,6 +410,18 @@ typedef enum {
  */
 typedef uint32_t icucnt_t;
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   ICU buffered capture callback type.
+ *
+ * @param[in] icup      pointer to a @p ICUDriver object
+ * @param[in] buffer    pointer to the completed half ring
+ * @param[in] n         number of values in the half ring
+ */
+typedef void (*icubufcallback_t)(ICUDriver *icup, const icucnt_t *buffer,
+                                 size_t n);
+#endif
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -369,6 +475,20 @@ struct ICUDriver {
    * @brief Current configuration data.
    */
   const ICUConfig           *config;
+#if ICU_USE_BUFFERED_CAPTURE || defined(__DOXYGEN__)
+  /**
+   * @brief Capture ring buffer pointer.
+   */
+  icucnt_t                  *buffer;
+  /**
+   * @brief Capture ring depth.
+   */
+  size_t                    depth;
+  /**
+   * @brief Half ring callback.
+   */
+  icubufcallback_t          buf_cb;
+#endif /* ICU_USE_BUFFERED_CAPTURE */
 #if defined(ICU_DRIVER_EXT_FIELDS)
   ICU_DRIVER_EXT_FIELDS
 #endif
@@ -389,6 +509,20 @@ struct ICUDriver {
    * @brief CCR register used for period capture.
    */
   volatile uint32_t         *pccrp;
+#if ICU_USE_BUFFERED_CAPTURE || defined(__DOXYGEN__)
+  /**
+   * @brief DMA stream used for the capture ring.
+   */
+  const stm32_dma_stream_t  *dmastp;
+  /**
+   * @brief DMA mode bits.
+   */
+  uint32_t                  dmamode;
+  /**
+   * @brief DMA interrupt priority.
+   */
+  uint32_t                  dmairqprio;
+#endif /* ICU_USE_BUFFERED_CAPTURE */
 };
 
 /*===========================================================================*/
@@ -476,6 +610,10 @@ extern "C" {
   void icu_lld_enable_notifications(ICUDriver *icup);
   void icu_lld_disable_notifications(ICUDriver *icup);
   void icu_lld_serve_interrupt(ICUDriver *icup);
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  void icu_lld_start_buffered_capture(ICUDriver *icup);
+  void icu_lld_stop_buffered_capture(ICUDriver *icup);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -729,6 +729,44 @@ void pwm_lld_enable_channel(PWMDriver *pwmp,
 #endif
 }
 
+/**
+ * @brief   Updates a set of PWM channels atomically.
+ * @details Update events are gated while the compare preload registers
+ *          are written so that the whole set is transferred to the
+ *          shadow registers on the same update event, no torn updates
+ *          can be observed on the outputs.
+ * @pre     The PWM unit must have been activated using @p pwmStart().
+ * @post    The channels are active using the specified widths.
+ * @note    The function has effect at the next cycle start.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] mask      mask of the channels to be updated
+ * @param[in] widths    array of pulse widths as clock pulses number,
+ *                      indexed by channel number
+ *
+ * @notapi
+ */
+void pwm_lld_set_channels(PWMDriver *pwmp,
+                          pwmchnmsk_t mask,
+                          const pwmcnt_t widths[]) {
+  pwmchannel_t channel;
+
+  pwmp->tim->CR1 |= STM32_TIM_CR1_UDIS;
+  for (channel = 0; channel < pwmp->channels; channel++) {
+    if ((mask & ((pwmchnmsk_t)1U << (pwmchnmsk_t)channel)) != 0U) {
+#if STM32_TIM_MAX_CHANNELS <= 4
+      pwmp->tim->CCR[channel] = widths[channel];
+#else
+      if (channel < 4)
+        pwmp->tim->CCR[channel] = widths[channel];
+      else
+        pwmp->tim->CCXR[channel - 4] = widths[channel];
+#endif
+    }
+  }
+  pwmp->tim->CR1 &= ~STM32_TIM_CR1_UDIS;
+}
+
 /**
  * @brief   Disables a PWM channel and its notification.
  * @pre     The PWM unit must have been activated using @p pwmStart().
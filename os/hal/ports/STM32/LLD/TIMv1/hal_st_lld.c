@@ -216,10 +216,60 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) &&                                   \
+    (OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING)
+/**
+ * @brief   Clock listener used for prescaler renegotiation.
+ */
+static hal_clock_listener_t st_clock_listener;
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if ((HAL_USE_CLOCK_MANAGEMENT == TRUE) &&                                  \
+     (OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING)) || defined(__DOXYGEN__)
+/* Clock point feeding the selected timer.*/
+#if (STM32_ST_USE_TIMER == 21) || (STM32_ST_USE_TIMER == 22)
+#define ST_CLOCK_POINT                      CLK_TIMCLK2
+#else
+#define ST_CLOCK_POINT                      CLK_TIMCLK1
+#endif
+
+/**
+ * @brief   Recomputes the timer prescaler after a clock switch.
+ * @details The systick frequency is kept constant across clock tree
+ *          transitions by reprogramming the prescaler, the counter value
+ *          is preserved so pending alarms keep their absolute time.
+ *
+ * @param[in] event     notified event
+ * @param[in] param     unused
+ *
+ * @notapi
+ */
+static void st_clock_listener_cb(halclockevent_t event, void *param) {
+
+  (void)param;
+
+  if (event == HAL_CLOCKEVENT_POST_SWITCH) {
+    uint32_t cnt;
+
+    osalSysLock();
+
+    /* The new prescaler is latched through an update event which also
+       resets the counter, the counter is restored afterward.*/
+    cnt = STM32_ST_TIM->CNT;
+    STM32_ST_TIM->PSC = (halClockGetPointX(ST_CLOCK_POINT) /
+                         OSAL_ST_FREQUENCY) - 1;
+    STM32_ST_TIM->EGR = TIM_EGR_UG;
+    STM32_ST_TIM->CNT = cnt;
+
+    osalSysUnlock();
+  }
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -251,9 +301,14 @@ OSAL_IRQ_HANDLER(SysTick_Handler) {
  * @isr
  */
 OSAL_IRQ_HANDLER(ST_HANDLER) {
+#if ST_LLD_NUM_ALARMS > 1
+  uint32_t sr;
+  unsigned alarm;
+#endif
 
   OSAL_IRQ_PROLOGUE();
 
+#if ST_LLD_NUM_ALARMS == 1
   /* Note, under rare circumstances an interrupt can remain latched even if
      the timer SR register has been cleared, in those cases the interrupt
      is simply ignored.*/
@@ -264,6 +319,30 @@ OSAL_IRQ_HANDLER(ST_HANDLER) {
     osalOsTimerHandlerI();
     osalSysUnlockFromISR();
   }
+#else /* ST_LLD_NUM_ALARMS > 1 */
+  /* The compare flags are set on match regardless of the interrupt
+     enables, only the flags of the started alarms are served. The other
+     flags are preserved, writing ones has no effect on this register.
+     Note, under rare circumstances an interrupt can remain latched even
+     if the timer SR register has been cleared, in those cases the
+     interrupt is simply ignored.*/
+  sr  = STM32_ST_TIM->SR;
+  sr &= STM32_ST_TIM->DIER;
+  STM32_ST_TIM->SR = ~sr;
+
+  if ((sr & TIM_SR_CC1IF) != 0U) {
+    osalSysLockFromISR();
+    osalOsTimerHandlerI();
+    osalSysUnlockFromISR();
+  }
+  for (alarm = 1U; alarm < (unsigned)ST_LLD_NUM_ALARMS; alarm++) {
+    if ((sr & ((uint32_t)TIM_SR_CC1IF << alarm)) != 0U) {
+      if (st_callbacks[alarm - 1U] != NULL) {
+        st_callbacks[alarm - 1U](alarm);
+      }
+    }
+  }
+#endif /* ST_LLD_NUM_ALARMS > 1 */
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -301,6 +380,11 @@ void st_lld_init(void) {
 
   /* IRQ enabled.*/
   nvicEnableVector(ST_NUMBER, STM32_ST_IRQ_PRIORITY);
+
+#if HAL_USE_CLOCK_MANAGEMENT == TRUE
+  /* The prescaler is renegotiated after clock tree transitions.*/
+  halAddClockListener(&st_clock_listener, st_clock_listener_cb, NULL);
+#endif
 #endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
 
 #if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
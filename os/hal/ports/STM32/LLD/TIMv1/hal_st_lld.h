@@ -59,6 +59,19 @@
 #if !defined(STM32_ST_USE_TIMER) || defined(__DOXYGEN__)
 #define STM32_ST_USE_TIMER                  2
 #endif
+
+/**
+ * @brief   Number of alarms to be used.
+ * @details The first alarm, on compare channel 1, is reserved for the OS
+ *          tick, additional alarms use the following compare channels of
+ *          the same timer and are available to the application through
+ *          @p stStartAlarmN().
+ * @note    Timers 2, 3, 4 and 5 support up to 4 alarms, timers 21 and 22
+ *          support up to 2 alarms.
+ */
+#if !defined(STM32_ST_NUM_ALARMS) || defined(__DOXYGEN__)
+#define STM32_ST_NUM_ALARMS                 1
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -105,6 +118,20 @@
 #error "STM32_ST_USE_TIMER specifies an unsupported timer"
 #endif
 
+#if (STM32_ST_NUM_ALARMS < 1) || (STM32_ST_NUM_ALARMS > 4)
+#error "STM32_ST_NUM_ALARMS must be between 1 and 4"
+#endif
+
+#if ((STM32_ST_USE_TIMER == 21) || (STM32_ST_USE_TIMER == 22)) &&           \
+    (STM32_ST_NUM_ALARMS > 2)
+#error "the selected timer supports up to 2 alarms"
+#endif
+
+/**
+ * @brief   Number of alarms exported to the ST driver.
+ */
+#define ST_LLD_NUM_ALARMS                         STM32_ST_NUM_ALARMS
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -153,8 +180,13 @@ static inline systime_t st_lld_get_counter(void) {
 static inline void st_lld_start_alarm(systime_t time) {
 
   STM32_ST_TIM->CCR[0] = (uint32_t)time;
+#if ST_LLD_NUM_ALARMS == 1
   STM32_ST_TIM->SR     = 0;
   STM32_ST_TIM->DIER   = STM32_TIM_DIER_CC1IE;
+#else
+  STM32_ST_TIM->SR     = ~STM32_TIM_SR_CC1IF;
+  STM32_ST_TIM->DIER  |= STM32_TIM_DIER_CC1IE;
+#endif
 }
 
 /**
@@ -164,7 +196,11 @@ static inline void st_lld_start_alarm(systime_t time) {
  */
 static inline void st_lld_stop_alarm(void) {
 
+#if ST_LLD_NUM_ALARMS == 1
   STM32_ST_TIM->DIER = 0;
+#else
+  STM32_ST_TIM->DIER &= ~STM32_TIM_DIER_CC1IE;
+#endif
 }
 
 /**
@@ -205,6 +241,79 @@ static inline bool st_lld_is_alarm_active(void) {
   return (bool)((STM32_ST_TIM->DIER & STM32_TIM_DIER_CC1IE) != 0);
 }
 
+#if (ST_LLD_NUM_ALARMS > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an additional alarm.
+ * @note    Makes sure that no spurious alarms are triggered after
+ *          this call.
+ *
+ * @param[in] alarm     alarm channel number
+ * @param[in] time      the time to be set for the first alarm
+ *
+ * @notapi
+ */
+static inline void st_lld_start_alarm_n(unsigned alarm, systime_t time) {
+
+  STM32_ST_TIM->CCR[alarm] = (uint32_t)time;
+  STM32_ST_TIM->SR         = ~(STM32_TIM_SR_CC1IF << alarm);
+  STM32_ST_TIM->DIER      |= (STM32_TIM_DIER_CC1IE << alarm);
+}
+
+/**
+ * @brief   Stops an additional alarm interrupt.
+ *
+ * @param[in] alarm     alarm channel number
+ *
+ * @notapi
+ */
+static inline void st_lld_stop_alarm_n(unsigned alarm) {
+
+  STM32_ST_TIM->DIER &= ~(STM32_TIM_DIER_CC1IE << alarm);
+}
+
+/**
+ * @brief   Sets the time of an additional alarm.
+ *
+ * @param[in] alarm     alarm channel number
+ * @param[in] time      the time to be set for the next alarm
+ *
+ * @notapi
+ */
+static inline void st_lld_set_alarm_n(unsigned alarm, systime_t time) {
+
+  STM32_ST_TIM->CCR[alarm] = (uint32_t)time;
+}
+
+/**
+ * @brief   Returns the current time of an additional alarm.
+ *
+ * @param[in] alarm     alarm channel number
+ * @return              The currently set alarm time.
+ *
+ * @notapi
+ */
+static inline systime_t st_lld_get_alarm_n(unsigned alarm) {
+
+  return (systime_t)STM32_ST_TIM->CCR[alarm];
+}
+
+/**
+ * @brief   Determines if an additional alarm is active.
+ *
+ * @param[in] alarm     alarm channel number
+ * @return              The alarm status.
+ * @retval false        if the alarm is not active.
+ * @retval true         is the alarm is active
+ *
+ * @notapi
+ */
+static inline bool st_lld_is_alarm_active_n(unsigned alarm) {
+
+  return (bool)((STM32_ST_TIM->DIER &
+                 (STM32_TIM_DIER_CC1IE << alarm)) != 0);
+}
+#endif /* ST_LLD_NUM_ALARMS > 1 */
+
 #endif /* HAL_ST_LLD_H */
 
 /** @} */
@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    TIMv1/stm32_tim64.h
+ * @brief   STM32 chained 64-bit timer helper header.
+ * @details This header implements a 64-bit free running counter built by
+ *          chaining two 32-bit TIM units in hardware, the low timer
+ *          generates an update TRGO on overflow which clocks the high
+ *          timer through its internal trigger input. Because the carry is
+ *          propagated by hardware the composed value is exact, the read
+ *          function only has to guard against the low counter rolling over
+ *          between the two register reads which can require at most one
+ *          retry every 2^32 ticks.
+ * @note    This file requires definitions from the ST STM32 header file.
+ * @note    The caller is responsible for enabling the clocks of both TIM
+ *          units, for example through @p rccEnableTIM2(), and for choosing
+ *          32-bit capable units (TIM2 and TIM5 on most devices).
+ *
+ * @addtogroup STM32_TIMv1
+ * @{
+ */
+
+#ifndef STM32_TIM64_H
+#define STM32_TIM64_H
+
+#include "stm32_tim.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a chained 64-bit timer object.
+ */
+typedef struct {
+  /**
+   * @brief   Low word timer, master of the chain.
+   */
+  stm32_tim_t           *low;
+  /**
+   * @brief   High word timer, clocked by the low timer overflow.
+   */
+  stm32_tim_t           *high;
+} stm32_tim64_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a chained 64-bit timer object.
+ *
+ * @param[out] t64p     pointer to the @p stm32_tim64_t object
+ * @param[in] low       low word timer, a 32-bit capable TIM unit
+ * @param[in] high      high word timer
+ *
+ * @init
+ */
+static inline void stm32_tim64_object_init(stm32_tim64_t *t64p,
+                                           stm32_tim_t *low,
+                                           stm32_tim_t *high) {
+
+  t64p->low  = low;
+  t64p->high = high;
+}
+
+/**
+ * @brief   Configures and starts the chained 64-bit counter.
+ * @details The low timer is programmed as a free running counter
+ *          generating an update TRGO on overflow, the high timer counts
+ *          those events through the internal trigger selected by
+ *          @p trgsel in external clock mode 1.
+ * @pre     The clocks of both TIM units must be enabled and the units
+ *          must not be in use by other drivers.
+ * @note    The internal trigger number connecting the low timer to the
+ *          high timer TRGI is device-specific, it must be taken from the
+ *          "TIMx internal trigger connection" table in the reference
+ *          manual. For example on STM32F4xx devices TIM2 feeds the TIM5
+ *          trigger input ITR0, hence low=TIM2, high=TIM5, trgsel=0.
+ *
+ * @param[in] t64p      pointer to the @p stm32_tim64_t object
+ * @param[in] psc       prescaler applied to the low timer clock
+ * @param[in] trgsel    internal trigger number of the high timer TRGI
+ *                      connected to the low timer TRGO, in range 0..3
+ *
+ * @api
+ */
+static inline void stm32_tim64_start(stm32_tim64_t *t64p,
+                                     uint32_t psc,
+                                     uint32_t trgsel) {
+
+  /* Both timers stopped during setup.*/
+  t64p->low->CR1   = 0;
+  t64p->high->CR1  = 0;
+
+  /* Low timer, free running with update event as TRGO.*/
+  t64p->low->PSC   = psc;
+  t64p->low->ARR   = 0xFFFFFFFFU;
+  t64p->low->CR2   = STM32_TIM_CR2_MMS(2);
+  t64p->low->SMCR  = 0;
+  t64p->low->DIER  = 0;
+
+  osalDbgAssert(t64p->low->ARR == 0xFFFFFFFFU,
+                "low timer is not a 32-bit unit");
+
+  /* High timer clocked by the low timer overflow, external clock mode 1
+     on the selected internal trigger.*/
+  t64p->high->PSC  = 0;
+  t64p->high->ARR  = 0xFFFFFFFFU;
+  t64p->high->CR2  = 0;
+  t64p->high->SMCR = STM32_TIM_SMCR_TS(trgsel) | STM32_TIM_SMCR_SMS(7);
+  t64p->high->DIER = 0;
+
+  /* Loading prescalers and counters, the UG events do not propagate to
+     the high timer because it is still stopped.*/
+  t64p->low->EGR   = STM32_TIM_EGR_UG;
+  t64p->high->EGR  = STM32_TIM_EGR_UG;
+  t64p->low->CNT   = 0;
+  t64p->high->CNT  = 0;
+
+  /* The slave is enabled first so no carries are lost.*/
+  t64p->high->CR1  = STM32_TIM_CR1_CEN;
+  t64p->low->CR1   = STM32_TIM_CR1_CEN;
+}
+
+/**
+ * @brief   Stops the chained 64-bit counter.
+ *
+ * @param[in] t64p      pointer to the @p stm32_tim64_t object
+ *
+ * @api
+ */
+static inline void stm32_tim64_stop(stm32_tim64_t *t64p) {
+
+  t64p->low->CR1   = 0;
+  t64p->high->CR1  = 0;
+  t64p->low->CR2   = 0;
+  t64p->high->SMCR = 0;
+}
+
+/**
+ * @brief   Returns the current 64-bit counter value.
+ * @details The high word is sampled around the low word read, a mismatch
+ *          means the low counter rolled over in between and the read is
+ *          repeated. Because a roll-over happens once every 2^32 low
+ *          timer ticks at most one retry can occur.
+ * @note    This function can be called from any context, it performs no
+ *          locking.
+ *
+ * @param[in] t64p      pointer to the @p stm32_tim64_t object
+ * @return              The counter value.
+ *
+ * @special
+ */
+static inline uint64_t stm32_tim64_get(const stm32_tim64_t *t64p) {
+  uint32_t hi, lo;
+
+  do {
+    hi = t64p->high->CNT;
+    lo = t64p->low->CNT;
+  } while (hi != t64p->high->CNT);
+
+  return ((uint64_t)hi << 32) | (uint64_t)lo;
+}
+
+#endif /* STM32_TIM64_H */
+
+/** @} */
@@ -546,6 +546,16 @@ struct UARTDriver {
    */
   mutex_t                   mutex;
 #endif /* UART_USE_MUTUAL_EXCLUSION */
+#if (UART_USE_RX_CHAIN == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Chained receive buffer or @p NULL.
+   */
+  void                      *rxchainbuf;
+  /**
+   * @brief   Size of the chained receive buffer.
+   */
+  size_t                    rxchainn;
+#endif /* UART_USE_RX_CHAIN */
 #if defined(UART_DRIVER_EXT_FIELDS)
   UART_DRIVER_EXT_FIELDS
 #endif
@@ -53,6 +53,14 @@
 #define USART_CR1_M_1                       (1 << 28)
 #endif
 
+/* Transmission interrupt source: the TX FIFO threshold in FIFO mode, the
+   transmit data register in normal mode.*/
+#if STM32_SERIAL_USE_FIFO == TRUE
+#define usart_enable_tx_irq(u)              ((u)->CR3 |= USART_CR3_TXFTIE)
+#else
+#define usart_enable_tx_irq(u)              ((u)->CR1 |= USART_CR1_TXEIE)
+#endif
+
 /* Workarounds for those devices where UARTs are USARTs.*/
 #if defined(USART4)
 #define UART4 USART4
@@ -201,10 +209,116 @@ static uint8_t sd_in_buflp1[STM32_SERIAL_LPUART1_IN_BUF_SIZE];
 static uint8_t sd_out_buflp1[STM32_SERIAL_LPUART1_OUT_BUF_SIZE];
 #endif
 
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/** @brief Clock listener used for baud rate renegotiation.*/
+static hal_clock_listener_t sd_clock_listener;
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Renegotiates the baud rate of one instance.
+ * @details The instance clock is refreshed from the specified clock point
+ *          and the baud rate generator is reprogrammed from the current
+ *          configuration, characters in transit are lost.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] pt        clock point feeding the instance
+ *
+ * @notapi
+ */
+static void sd_update_clock(SerialDriver *sdp, halclkpt_t pt) {
+
+  if (sdp->state == SD_READY) {
+    USART_TypeDef *u = sdp->usart;
+
+    sdp->clock = halClockGetPointX(pt);
+
+    /* The baud rate generator can only be written with the USART
+       disabled.*/
+    u->CR1 &= ~USART_CR1_UE;
+#if STM32_SERIAL_USE_LPUART1
+    if (sdp == &LPSD1) {
+      u->BRR = (uint32_t)(((uint64_t)sdp->clock * 256) /
+                          sdp->config->speed);
+    }
+    else
+#endif
+    u->BRR = (uint32_t)(sdp->clock / sdp->config->speed);
+    u->CR1 |= USART_CR1_UE;
+  }
+}
+
+/**
+ * @brief   Recomputes the baud rates after a clock switch.
+ * @note    Instances fed by kernel clock sources other than the bus
+ *          clock, HSI or LSE for example, are not affected by system
+ *          clock scaling and are left alone.
+ *
+ * @param[in] event     notified event
+ * @param[in] param     unused
+ *
+ * @notapi
+ */
+static void sd_clock_listener_cb(halclockevent_t event, void *param) {
+
+  (void)param;
+
+  if (event != HAL_CLOCKEVENT_POST_SWITCH) {
+    return;
+  }
+
+#if STM32_SERIAL_USE_USART1
+#if !defined(STM32_USART1SEL) || (STM32_USART1SEL == STM32_USART1SEL_PCLK2)
+  sd_update_clock(&SD1, CLK_PCLK2);
+#endif
+#endif
+#if STM32_SERIAL_USE_USART2
+#if !defined(STM32_USART2SEL) || (STM32_USART2SEL == STM32_USART2SEL_PCLK1)
+  sd_update_clock(&SD2, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_USART3
+#if !defined(STM32_USART3SEL) || (STM32_USART3SEL == STM32_USART3SEL_PCLK1)
+  sd_update_clock(&SD3, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_UART4
+#if !defined(STM32_UART4SEL) || (STM32_UART4SEL == STM32_UART4SEL_PCLK1)
+  sd_update_clock(&SD4, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_UART5
+#if !defined(STM32_UART5SEL) || (STM32_UART5SEL == STM32_UART5SEL_PCLK1)
+  sd_update_clock(&SD5, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_USART6
+#if !defined(STM32_USART6SEL) || (STM32_USART6SEL == STM32_USART6SEL_PCLK2)
+  sd_update_clock(&SD6, CLK_PCLK2);
+#endif
+#endif
+#if STM32_SERIAL_USE_UART7
+#if !defined(STM32_UART7SEL) || (STM32_UART7SEL == STM32_UART7SEL_PCLK1)
+  sd_update_clock(&SD7, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_UART8
+#if !defined(STM32_UART8SEL) || (STM32_UART8SEL == STM32_UART8SEL_PCLK1)
+  sd_update_clock(&SD8, CLK_PCLK1);
+#endif
+#endif
+#if STM32_SERIAL_USE_LPUART1
+#if !defined(STM32_LPUART1SEL) || (STM32_LPUART1SEL == STM32_LPUART1SEL_PCLK1)
+  sd_update_clock(&LPSD1, CLK_PCLK1);
+#endif
+#endif
+}
+#endif /* HAL_USE_CLOCK_MANAGEMENT == TRUE */
+
 /**
  * @brief   USART initialization.
  * @details This function must be invoked with interrupts disabled.
@@ -226,11 +340,25 @@ static void usart_init(SerialDriver *sdp, const SerialConfig *config) {
   u->BRR = (uint32_t)(sdp->clock / config->speed);
 
   /* Note that some bits are enforced.*/
+#if STM32_SERIAL_USE_FIFO == TRUE
+  /* In FIFO mode the RX FIFO threshold and receiver timeout interrupts
+     replace the per-character RXNE source, the timeout flushes data
+     sitting below the threshold when the line goes idle.*/
+  u->RTOR = STM32_SERIAL_FIFO_RX_TIMEOUT;
+  u->CR2 = config->cr2 | USART_CR2_LBDIE | USART_CR2_RTOEN;
+  u->CR3 = config->cr3 | USART_CR3_EIE | USART_CR3_RXFTIE |
+           (STM32_SERIAL_FIFO_RX_THRESHOLD << USART_CR3_RXFTCFG_Pos) |
+           (STM32_SERIAL_FIFO_TX_THRESHOLD << USART_CR3_TXFTCFG_Pos);
+  u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
+                         USART_CR1_FIFOEN | USART_CR1_RTOIE |
+                         USART_CR1_TE | USART_CR1_RE;
+#else
   u->CR2 = config->cr2 | USART_CR2_LBDIE;
   u->CR3 = config->cr3 | USART_CR3_EIE;
   u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
                          USART_CR1_RXNEIE | USART_CR1_TE |
                          USART_CR1_RE;
+#endif
   u->ICR = 0xFFFFFFFFU;
 
   /* Deciding mask to be applied on the data register on receive, this is
@@ -313,13 +441,42 @@ static void serve_interrupt(SerialDriver *sdp) {
   }
 
   /* Data available.*/
+#if STM32_SERIAL_USE_FIFO == TRUE
+  if (isr & (USART_ISR_RXNE | USART_ISR_RXFT | USART_ISR_RTOF)) {
+    /* Draining the whole RX FIFO in a single ISR invocation.*/
+    osalSysLockFromISR();
+    while (u->ISR & USART_ISR_RXNE) {
+      sdIncomingDataI(sdp, (uint8_t)u->RDR & sdp->rxmask);
+    }
+    osalSysUnlockFromISR();
+  }
+#else
   if (isr & USART_ISR_RXNE) {
     osalSysLockFromISR();
     sdIncomingDataI(sdp, (uint8_t)u->RDR & sdp->rxmask);
     osalSysUnlockFromISR();
   }
+#endif
 
   /* Transmission buffer empty.*/
+#if STM32_SERIAL_USE_FIFO == TRUE
+  if ((u->CR3 & USART_CR3_TXFTIE) && (isr & (USART_ISR_TXE | USART_ISR_TXFT))) {
+    osalSysLockFromISR();
+    /* Refilling the TX FIFO until full or until the output queue is
+       empty.*/
+    while (u->ISR & USART_ISR_TXE) {
+      msg_t b = oqGetI(&sdp->oqueue);
+      if (b < MSG_OK) {
+        chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY);
+        u->CR3 &= ~USART_CR3_TXFTIE;
+        u->CR1 = cr1 | USART_CR1_TCIE;
+        break;
+      }
+      u->TDR = b;
+    }
+    osalSysUnlockFromISR();
+  }
+#else
   if ((cr1 & USART_CR1_TXEIE) && (isr & USART_ISR_TXE)) {
     msg_t b;
     osalSysLockFromISR();
@@ -332,6 +489,7 @@ static void serve_interrupt(SerialDriver *sdp) {
       u->TDR = b;
     osalSysUnlockFromISR();
   }
+#endif
 
   /* Physical transmission end.*/
   if ((cr1 & USART_CR1_TCIE) && (isr & USART_ISR_TC)) {
@@ -348,7 +506,7 @@ static void serve_interrupt(SerialDriver *sdp) {
 static void notify1(io_queue_t *qp) {
 
   (void)qp;
-  USART1->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(USART1);
 }
 #endif
 
@@ -356,7 +514,7 @@ static void notify1(io_queue_t *qp) {
 static void notify2(io_queue_t *qp) {
 
   (void)qp;
-  USART2->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(USART2);
 }
 #endif
 
@@ -364,7 +522,7 @@ static void notify2(io_queue_t *qp) {
 static void notify3(io_queue_t *qp) {
 
   (void)qp;
-  USART3->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(USART3);
 }
 #endif
 
@@ -372,7 +530,7 @@ static void notify3(io_queue_t *qp) {
 static void notify4(io_queue_t *qp) {
 
   (void)qp;
-  UART4->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(UART4);
 }
 #endif
 
@@ -380,7 +538,7 @@ static void notify4(io_queue_t *qp) {
 static void notify5(io_queue_t *qp) {
 
   (void)qp;
-  UART5->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(UART5);
 }
 #endif
 
@@ -388,7 +546,7 @@ static void notify5(io_queue_t *qp) {
 static void notify6(io_queue_t *qp) {
 
   (void)qp;
-  USART6->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(USART6);
 }
 #endif
 
@@ -396,7 +554,7 @@ static void notify6(io_queue_t *qp) {
 static void notify7(io_queue_t *qp) {
 
   (void)qp;
-  UART7->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(UART7);
 }
 #endif
 
@@ -404,7 +562,7 @@ static void notify7(io_queue_t *qp) {
 static void notify8(io_queue_t *qp) {
 
   (void)qp;
-  UART8->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(UART8);
 }
 #endif
 
@@ -412,7 +570,7 @@ static void notify8(io_queue_t *qp) {
 static void notifylp1(io_queue_t *qp) {
 
   (void)qp;
-  LPUART1->CR1 |= USART_CR1_TXEIE;
+  usart_enable_tx_irq(LPUART1);
 }
 #endif
 
@@ -748,6 +906,11 @@ void sd_lld_init(void) {
   nvicEnableVector(STM32_USART3_8_NUMBER, STM32_SERIAL_USART3_8_PRIORITY);
 #endif
 #endif
+
+#if HAL_USE_CLOCK_MANAGEMENT == TRUE
+  /* Baud rates are renegotiated after clock tree transitions.*/
+  halAddClockListener(&sd_clock_listener, sd_clock_listener_cb, NULL);
+#endif
 }
 
 /**
@@ -812,6 +975,7 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
     }
 #endif
   }
+  sdp->config = config;
   usart_init(sdp, config);
 }
 
@@ -325,6 +325,47 @@
 #if !defined(STM32_SERIAL_LPUART1_OUT_BUF_SIZE) || defined(__DOXYGEN__)
 #define STM32_SERIAL_LPUART1_OUT_BUF_SIZE   SERIAL_BUFFERS_SIZE
 #endif
+
+/**
+ * @brief   USART FIFO mode enable switch.
+ * @details If set to @p TRUE the hardware FIFOs of the USARTs are enabled
+ *          and the driver is serviced by FIFO threshold and receiver
+ *          timeout interrupts instead of per-character interrupts.
+ * @note    The default is @p FALSE.
+ * @note    This option is only available on those devices whose USARTs
+ *          have hardware FIFOs, a compile time error is generated
+ *          otherwise.
+ */
+#if !defined(STM32_SERIAL_USE_FIFO) || defined(__DOXYGEN__)
+#define STM32_SERIAL_USE_FIFO               FALSE
+#endif
+
+/**
+ * @brief   RX FIFO interrupt threshold setting.
+ * @details Encoded as per the RXFTCFG field of CR3, the default of 2
+ *          triggers the interrupt when the RX FIFO is half full.
+ */
+#if !defined(STM32_SERIAL_FIFO_RX_THRESHOLD) || defined(__DOXYGEN__)
+#define STM32_SERIAL_FIFO_RX_THRESHOLD      2
+#endif
+
+/**
+ * @brief   TX FIFO interrupt threshold setting.
+ * @details Encoded as per the TXFTCFG field of CR3, the default of 2
+ *          triggers the interrupt when the TX FIFO is half empty.
+ */
+#if !defined(STM32_SERIAL_FIFO_TX_THRESHOLD) || defined(__DOXYGEN__)
+#define STM32_SERIAL_FIFO_TX_THRESHOLD      2
+#endif
+
+/**
+ * @brief   Receiver timeout in bit times used in FIFO mode.
+ * @details The receiver timeout interrupt flushes data sitting below the
+ *          RX FIFO threshold when the line goes idle.
+ */
+#if !defined(STM32_SERIAL_FIFO_RX_TIMEOUT) || defined(__DOXYGEN__)
+#define STM32_SERIAL_FIFO_RX_TIMEOUT        16
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -367,6 +408,22 @@
 #error "LPUART1 not present in the selected device"
 #endif
 
+#if (STM32_SERIAL_USE_FIFO == TRUE) && !defined(USART_CR1_FIFOEN)
+#error "USART hardware FIFOs not present in the selected device"
+#endif
+
+#if (STM32_SERIAL_USE_FIFO == TRUE) &&                                      \
+    ((STM32_SERIAL_FIFO_RX_THRESHOLD < 0) ||                                \
+     (STM32_SERIAL_FIFO_RX_THRESHOLD > 5))
+#error "invalid STM32_SERIAL_FIFO_RX_THRESHOLD value"
+#endif
+
+#if (STM32_SERIAL_USE_FIFO == TRUE) &&                                      \
+    ((STM32_SERIAL_FIFO_TX_THRESHOLD < 0) ||                                \
+     (STM32_SERIAL_FIFO_TX_THRESHOLD > 5))
+#error "invalid STM32_SERIAL_FIFO_TX_THRESHOLD value"
+#endif
+
 #if !STM32_SERIAL_USE_USART1 && !STM32_SERIAL_USE_USART2 &&                 \
     !STM32_SERIAL_USE_USART3 && !STM32_SERIAL_USE_UART4  &&                 \
     !STM32_SERIAL_USE_UART5  && !STM32_SERIAL_USE_USART6 &&                 \
@@ -479,6 +536,8 @@ typedef struct {
   /* End of the mandatory fields.*/                                         \
   /* Pointer to the USART registers block.*/                                \
   USART_TypeDef             *usart;                                         \
+  /* Current configuration, needed for clock renegotiation.*/               \
+  const SerialConfig        *config;                                        \
   /* Clock frequency for the associated USART/UART.*/                       \
   uint32_t                  clock;                                          \
   /* Mask to be applied on received frames.*/                               \
@@ -47,6 +47,12 @@
   }                                                                         \
 }
 
+#if HAL_USE_PAL && PAL_USE_GROUP_EVENTS
+#define exti_serve_groups(pr) ((pr) &= ~_pal_serve_group_events(pr))
+#else
+#define exti_serve_groups(pr)
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -66,6 +72,7 @@ OSAL_IRQ_HANDLER(Vector58) {
   pr = EXTI->PR;
   pr &= EXTI->IMR & (1U << 0);
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 0);
 
@@ -87,6 +94,7 @@ OSAL_IRQ_HANDLER(Vector5C) {
   pr = EXTI->PR;
   pr &= EXTI->IMR & (1U << 1);
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 1);
 
@@ -108,6 +116,7 @@ OSAL_IRQ_HANDLER(Vector60) {
   pr = EXTI->PR;
   pr &= EXTI->IMR & (1U << 2);
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 2);
 
@@ -129,6 +138,7 @@ OSAL_IRQ_HANDLER(Vector64) {
   pr = EXTI->PR;
   pr &= EXTI->IMR & (1U << 3);
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 3);
 
@@ -150,6 +160,7 @@ OSAL_IRQ_HANDLER(Vector68) {
   pr = EXTI->PR;
   pr &= EXTI->IMR & (1U << 4);
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 4);
 
@@ -172,6 +183,7 @@ OSAL_IRQ_HANDLER(Vector9C) {
   pr &= EXTI->IMR & ((1U << 5) | (1U << 6) | (1U << 7) | (1U << 8) |
                      (1U << 9));
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 5);
   exti_serve_irq(pr, 6);
@@ -198,6 +210,7 @@ OSAL_IRQ_HANDLER(VectorE0) {
   pr &= EXTI->IMR & ((1U << 10) | (1U << 11) | (1U << 12) | (1U << 13) |
                      (1U << 14) | (1U << 15));
   EXTI->PR = pr;
+  exti_serve_groups(pr);
 
   exti_serve_irq(pr, 10);
   exti_serve_irq(pr, 11);
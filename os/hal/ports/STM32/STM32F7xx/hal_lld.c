@@ -38,14 +38,118 @@
  */
 uint32_t SystemCoreClock = STM32_HCLK;
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Default clock configuration.
+ * @details Register images matching the static configuration established
+ *          by @p stm32_clock_init(), switching to this configuration
+ *          returns the clock tree to the boot settings.
+ */
+const halclkcfg_t hal_clkcfg_default = {
+#if STM32_OVERDRIVE_REQUIRED
+  .pwr_cr1      = STM32_VOS | PWR_CR1_ODEN | PWR_CR1_ODSWEN,
+#else
+  .pwr_cr1      = STM32_VOS,
+#endif
+  .rcc_cr       = RCC_CR_HSION
+#if STM32_HSE_ENABLED
+                | RCC_CR_HSEON
+#endif
+#if STM32_ACTIVATE_PLL
+                | RCC_CR_PLLON
+#endif
+  ,
+  .rcc_cfgr     = STM32_MCO2SEL | STM32_MCO2PRE | STM32_MCO1PRE |
+                  STM32_I2SSRC  | STM32_MCO1SEL | STM32_RTCPRE  |
+                  STM32_PPRE2   | STM32_PPRE1   | STM32_HPRE    |
+                  STM32_SW,
+  .rcc_pllcfgr  = STM32_PLLQ | STM32_PLLSRC | STM32_PLLP | STM32_PLLN |
+                  STM32_PLLM,
+  .flash_acr    = FLASH_ACR_ARTEN | FLASH_ACR_PRFTEN | STM32_FLASHBITS
+};
+#endif /* STM32_CLOCK_DYNAMIC == TRUE */
+
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Current frequencies of the tracked clock points.
+ */
+static uint32_t clock_points[CLK_ARRAY_SIZE] = {
+  STM32_SYSCLK,
+  STM32_HCLK,
+  STM32_PCLK1,
+  STM32_PCLK2,
+  STM32_TIMCLK1,
+  STM32_TIMCLK2
+};
+#endif /* STM32_CLOCK_DYNAMIC == TRUE */
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Recomputes the clock points from the hardware settings.
+ *
+ * @notapi
+ */
+static void hal_lld_clock_points_update(void) {
+  static const uint8_t hpre_shift[16] = {0, 0, 0, 0, 0, 0, 0, 0,
+                                         1, 2, 3, 4, 6, 7, 8, 9};
+  static const uint8_t ppre_shift[8]  = {0, 0, 0, 0, 1, 2, 3, 4};
+  uint32_t sysclk, cfgr, shift;
+
+  /* SYSCLK from the current source.*/
+  cfgr = RCC->CFGR;
+  switch (cfgr & RCC_CFGR_SWS) {
+  case RCC_CFGR_SWS_HSI:
+    sysclk = STM32_HSICLK;
+    break;
+  case RCC_CFGR_SWS_HSE:
+    sysclk = STM32_HSECLK;
+    break;
+  case RCC_CFGR_SWS_PLL:
+  {
+    uint32_t pllcfgr, m, n, p;
+
+    pllcfgr = RCC->PLLCFGR;
+    m = pllcfgr & RCC_PLLCFGR_PLLM;
+    n = (pllcfgr & RCC_PLLCFGR_PLLN) >> 6;
+    p = ((((pllcfgr & RCC_PLLCFGR_PLLP) >> 16) + 1) * 2);
+    if ((pllcfgr & RCC_PLLCFGR_PLLSRC) != 0) {
+      sysclk = STM32_HSECLK;
+    }
+    else {
+      sysclk = STM32_HSICLK;
+    }
+    sysclk = (sysclk / m) * n / p;
+    break;
+  }
+  default:
+    sysclk = 0;
+  }
+
+  clock_points[CLK_SYSCLK] = sysclk;
+
+  /* HCLK and APB clocks from the prescalers.*/
+  clock_points[CLK_HCLK] = sysclk >> hpre_shift[(cfgr & RCC_CFGR_HPRE) >> 4];
+
+  shift = ppre_shift[(cfgr & RCC_CFGR_PPRE1) >> 10];
+  clock_points[CLK_PCLK1]   = clock_points[CLK_HCLK] >> shift;
+  clock_points[CLK_TIMCLK1] = (shift == 0) ? clock_points[CLK_PCLK1]
+                                           : clock_points[CLK_PCLK1] * 2;
+
+  shift = ppre_shift[(cfgr & RCC_CFGR_PPRE2) >> 13];
+  clock_points[CLK_PCLK2]   = clock_points[CLK_HCLK] >> shift;
+  clock_points[CLK_TIMCLK2] = (shift == 0) ? clock_points[CLK_PCLK2]
+                                           : clock_points[CLK_PCLK2] * 2;
+}
+#endif /* STM32_CLOCK_DYNAMIC == TRUE */
+
 /**
  * @brief   Initializes the backup domain.
  * @note    WARNING! Changing clock source impossible without resetting
@@ -301,4 +405,119 @@ void stm32_clock_init(void) {
   rccEnableAPB2(RCC_APB2ENR_SYSCFGEN, true);
 }
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Switches the clock tree to a new configuration.
+ * @details The system clock source is moved to HSI, the PLL is retuned
+ *          with the new settings, then the new source and prescalers are
+ *          applied. Finally the clock points and @p SystemCoreClock are
+ *          recomputed from the hardware settings.
+ * @note    The function must be invoked in a critical section, drivers
+ *          clocked by the switched trees must be quiesced by the caller,
+ *          this is normally handled by @p halClockSwitch().
+ *
+ * @param[in] ccp       pointer to a @p halclkcfg_t structure
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the switch has been performed.
+ * @retval HAL_FAILED   if the configuration is inconsistent.
+ *
+ * @notapi
+ */
+bool hal_lld_clock_switch(const halclkcfg_t *ccp) {
+
+  /* The PLL cannot be the clock source if it is not enabled in the
+     target configuration.*/
+  if (((ccp->rcc_cfgr & RCC_CFGR_SW) == STM32_SW_PLL) &&
+      ((ccp->rcc_cr & RCC_CR_PLLON) == 0)) {
+    return HAL_FAILED;
+  }
+
+  /* HSI is the switch-over source, making sure it is enabled and
+     selected.*/
+  RCC->CR |= RCC_CR_HSION;
+  while ((RCC->CR & RCC_CR_HSIRDY) == 0)
+    ;
+  RCC->CFGR &= ~RCC_CFGR_SW;
+  while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI)
+    ;
+
+  /* Over-drive mode is exited, if active, before touching the voltage
+     scaling.*/
+  if ((PWR->CR1 & PWR_CR1_ODSWEN) != 0) {
+    PWR->CR1 &= ~PWR_CR1_ODSWEN;
+    PWR->CR1 &= ~PWR_CR1_ODEN;
+  }
+
+  /* PLL is stopped before retuning.*/
+  RCC->CR &= ~RCC_CR_PLLON;
+
+  /* New voltage scaling, flash wait states and HSE state.*/
+  PWR->CR1 = (PWR->CR1 & ~PWR_CR1_VOS) | (ccp->pwr_cr1 & PWR_CR1_VOS);
+  FLASH->ACR = ccp->flash_acr;
+  if ((ccp->rcc_cr & RCC_CR_HSEON) != 0) {
+    RCC->CR |= RCC_CR_HSEON;
+    while ((RCC->CR & RCC_CR_HSERDY) == 0)
+      ;
+  }
+
+  /* PLL setup and activation, the over-drive sequence is performed
+     while the PLL locks as done in the initialization code.*/
+  RCC->PLLCFGR = ccp->rcc_pllcfgr;
+  if ((ccp->rcc_cr & RCC_CR_PLLON) != 0) {
+    RCC->CR |= RCC_CR_PLLON;
+
+    while ((PWR->CSR1 & PWR_CSR1_VOSRDY) == 0)
+      ;
+
+    if ((ccp->pwr_cr1 & PWR_CR1_ODEN) != 0) {
+      PWR->CR1 |= PWR_CR1_ODEN;
+      while ((PWR->CSR1 & PWR_CSR1_ODRDY) == 0)
+        ;
+      PWR->CR1 |= PWR_CR1_ODSWEN;
+      while ((PWR->CSR1 & PWR_CSR1_ODSWRDY) == 0)
+        ;
+    }
+
+    while ((RCC->CR & RCC_CR_PLLRDY) == 0)
+      ;
+  }
+
+  /* Prescalers are applied before switching to the final source.*/
+  RCC->CFGR = ccp->rcc_cfgr & ~RCC_CFGR_SW;
+  RCC->CFGR |= ccp->rcc_cfgr & RCC_CFGR_SW;
+  while ((RCC->CFGR & RCC_CFGR_SWS) != ((ccp->rcc_cfgr & RCC_CFGR_SW) << 2))
+    ;
+
+  /* HSE and HSI are gated off if the new configuration does not require
+     them.*/
+  if ((ccp->rcc_cr & RCC_CR_HSEON) == 0) {
+    RCC->CR &= ~RCC_CR_HSEON;
+  }
+  if ((ccp->rcc_cr & RCC_CR_HSION) == 0) {
+    RCC->CR &= ~RCC_CR_HSION;
+  }
+
+  /* Tracked frequencies are recomputed from the hardware settings.*/
+  hal_lld_clock_points_update();
+  SystemCoreClock = clock_points[CLK_HCLK];
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Returns the current frequency of a clock point.
+ *
+ * @param[in] pt        clock point identifier
+ * @return              The clock point frequency in Hz.
+ *
+ * @notapi
+ */
+uint32_t hal_lld_get_clock_point(halclkpt_t pt) {
+
+  osalDbgCheck(pt < CLK_ARRAY_SIZE);
+
+  return clock_points[pt];
+}
+#endif /* STM32_CLOCK_DYNAMIC == TRUE */
+
 /** @} */
@@ -464,6 +464,16 @@
 #define STM32_NO_INIT                       FALSE
 #endif
 
+/**
+ * @brief   Enables the dynamic clocks handling.
+ * @details When enabled the clock tree can be reprogrammed at runtime
+ *          through @p halClockSwitch(), clock frequencies are tracked in
+ *          runtime clock points queryable with @p halClockGetPointX().
+ */
+#if !defined(STM32_CLOCK_DYNAMIC) || defined(__DOXYGEN__)
+#define STM32_CLOCK_DYNAMIC                 FALSE
+#endif
+
 /**
  * @brief   Enables or disables the programmable voltage detector.
  */
@@ -2069,10 +2079,71 @@
 #error "invalid frequency at specified VDD level"
 #endif
 
+/* Dynamic clocks support is advertised to the HAL.*/
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+#define HAL_LLD_USE_CLOCK_MANAGEMENT
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @name    Clock points names
+ * @{
+ */
+#define CLK_SYSCLK              0U
+#define CLK_HCLK                1U
+#define CLK_PCLK1               2U
+#define CLK_PCLK2               3U
+#define CLK_TIMCLK1             4U
+#define CLK_TIMCLK2             5U
+#define CLK_ARRAY_SIZE          6U
+/** @} */
+
+/**
+ * @brief   Type of a clock point identifier.
+ */
+typedef uint32_t halclkpt_t;
+
+/**
+ * @brief   Type of a clock configuration structure.
+ * @details The structure contains the images of the registers controlling
+ *          the clock tree, the @p hal_clkcfg_default constant represents
+ *          the configuration established by @p stm32_clock_init().
+ * @note    The HSI oscillator is kept enabled during transitions, the
+ *          PLL settings must be consistent with the flash wait states
+ *          and voltage scaling specified in the other fields.
+ */
+typedef struct {
+  /**
+   * @brief   Image of the PWR CR1 register, only the VOS, ODEN and
+   *          ODSWEN fields are used.
+   */
+  uint32_t                  pwr_cr1;
+  /**
+   * @brief   Image of the RCC CR register, only the HSION, HSEON and
+   *          PLLON fields are used.
+   */
+  uint32_t                  rcc_cr;
+  /**
+   * @brief   Image of the RCC CFGR register, clock source and
+   *          prescalers.
+   */
+  uint32_t                  rcc_cfgr;
+  /**
+   * @brief   Image of the RCC PLLCFGR register.
+   */
+  uint32_t                  rcc_pllcfgr;
+  /**
+   * @brief   Image of the FLASH ACR register, wait states matching the
+   *          target AHB frequency.
+   */
+  uint32_t                  flash_acr;
+} halclkcfg_t;
+#endif /* STM32_CLOCK_DYNAMIC == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -2089,11 +2160,19 @@
 #include "stm32_dma.h"
 #include "stm32_rcc.h"
 
+#if (STM32_CLOCK_DYNAMIC == TRUE) && !defined(__DOXYGEN__)
+extern const halclkcfg_t hal_clkcfg_default;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
   void hal_lld_init(void);
   void stm32_clock_init(void);
+#if (STM32_CLOCK_DYNAMIC == TRUE) || defined(__DOXYGEN__)
+  bool hal_lld_clock_switch(const halclkcfg_t *ccp);
+  uint32_t hal_lld_get_clock_point(halclkpt_t pt);
+#endif
 #ifdef __cplusplus
 }
 #endif
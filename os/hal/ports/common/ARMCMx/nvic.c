@@ -40,6 +40,15 @@
 /* Driver local variables.                                                   */
 /*===========================================================================*/
 
+#if (NVIC_USE_RAM_VECTORS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   RAM vectors table.
+ */
+static uint32_t nvic_ram_vectors[CORTEX_NUM_VECTORS + 16]
+                __attribute__((aligned(NVIC_RAM_VECTORS_ALIGN),
+                               section(NVIC_RAM_VECTORS_SECTION)));
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -111,4 +120,50 @@ void nvicClearPending(uint32_t n) {
   NVIC->ICPR[n >> 5] = 1 << (n & 0x1F);
 }
 
+#if (NVIC_USE_RAM_VECTORS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Copies the vectors table in RAM and activates the copy.
+ * @details The table currently pointed by @p VTOR is copied into the
+ *          RAM table then @p VTOR is re-pointed to the copy. Meant to
+ *          be called once with interrupts still disabled, typically
+ *          from @p __late_init() or right after @p halInit().
+ * @note    The RAM table lives in a non-initialized section so it does
+ *          not exist before this call, the reset-time table stays in
+ *          flash.
+ */
+void nvicInitRamVectors(void) {
+  uint32_t i;
+  const uint32_t *src = (const uint32_t *)SCB->VTOR;
+
+  for (i = 0U; i < (uint32_t)CORTEX_NUM_VECTORS + 16U; i++) {
+    nvic_ram_vectors[i] = src[i];
+  }
+  __DSB();
+  SCB->VTOR = (uint32_t)nvic_ram_vectors;
+  __DSB();
+  __ISB();
+}
+
+/**
+ * @brief   Installs an interrupt handler into the RAM vectors table.
+ * @details The handler is entered by the NVIC directly, without any
+ *          intermediate dispatch, it must be written like a static
+ *          vector using @p OSAL_IRQ_HANDLER(). The previous handler,
+ *          usually the weak unhandled-exception catcher, is simply
+ *          overwritten.
+ *
+ * @param[in] n         the interrupt number
+ * @param[in] handler   the interrupt handler
+ */
+void nvicSetVector(uint32_t n, nvic_vector_t handler) {
+
+  osalDbgCheck((n < (uint32_t)CORTEX_NUM_VECTORS) && (handler != NULL));
+  osalDbgAssert(SCB->VTOR == (uint32_t)nvic_ram_vectors,
+                "RAM table not active");
+
+  nvic_ram_vectors[16U + n] = (uint32_t)handler;
+  __DSB();
+}
+#endif /* NVIC_USE_RAM_VECTORS == TRUE */
+
 /** @} */
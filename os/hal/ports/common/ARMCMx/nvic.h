@@ -51,14 +51,60 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   RAM vectors table switch.
+ * @details When enabled the vectors table is copied in RAM and @p VTOR is
+ *          re-pointed to the copy, removing the flash wait states from
+ *          every interrupt entry. The copy also enables the run-time
+ *          registration of handlers through @p nvicSetVector().
+ */
+#if !defined(NVIC_USE_RAM_VECTORS) || defined(__DOXYGEN__)
+#define NVIC_USE_RAM_VECTORS            FALSE
+#endif
+
+/**
+ * @brief   Section where the RAM vectors table is placed.
+ * @details It must be one of the @p .ramN sections defined in the linker
+ *          script. On devices with a core-coupled memory placing the
+ *          table there, for example ".ram4" on STM32F4, removes the
+ *          vector fetch from the bus matrix entirely.
+ */
+#if !defined(NVIC_RAM_VECTORS_SECTION) || defined(__DOXYGEN__)
+#define NVIC_RAM_VECTORS_SECTION        ".ram0"
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (NVIC_USE_RAM_VECTORS == TRUE) && (CORTEX_MODEL == 0)
+#error "NVIC_USE_RAM_VECTORS not supported on this core, VTOR not present"
+#endif
+
+/**
+ * @brief   Alignment of the RAM vectors table.
+ * @details @p VTOR requires the table to be aligned to the next power of
+ *          two greater than or equal to its size in bytes, 128 at least.
+ */
+#if ((CORTEX_NUM_VECTORS + 16) <= 32) || defined(__DOXYGEN__)
+#define NVIC_RAM_VECTORS_ALIGN          128U
+#elif (CORTEX_NUM_VECTORS + 16) <= 64
+#define NVIC_RAM_VECTORS_ALIGN          256U
+#elif (CORTEX_NUM_VECTORS + 16) <= 128
+#define NVIC_RAM_VECTORS_ALIGN          512U
+#else
+#define NVIC_RAM_VECTORS_ALIGN          1024U
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Type of an interrupt vector.
+ */
+typedef void (*nvic_vector_t)(void);
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -79,6 +125,10 @@ extern "C" {
   void nvicDisableVector(uint32_t n);
   void nvicSetSystemHandlerPriority(uint32_t handler, uint32_t prio);
   void nvicClearPending(uint32_t n);
+#if (NVIC_USE_RAM_VECTORS == TRUE) || defined(__DOXYGEN__)
+  void nvicInitRamVectors(void);
+  void nvicSetVector(uint32_t n, nvic_vector_t handler);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -60,6 +60,39 @@ static size_t _read(void *ip, uint8_t *bp, size_t n) {
   return fread(bp, 1, n, stdin);
 }
 
+static size_t _writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t wr = 0;
+
+  (void)ip;
+
+  while (iovcnt > 0) {
+    size_t done = fwrite(iov->base, 1, iov->len, stdout);
+    wr += done;
+    if (done < iov->len)
+      break;
+    iov++;
+    iovcnt--;
+  }
+  fflush(stdout);
+  return wr;
+}
+
+static size_t _readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  size_t rd = 0;
+
+  (void)ip;
+
+  while (iovcnt > 0) {
+    size_t done = fread(iov->base, 1, iov->len, stdin);
+    rd += done;
+    if (done < iov->len)
+      break;
+    iov++;
+    iovcnt--;
+  }
+  return rd;
+}
+
 static msg_t _put(void *ip, uint8_t b) {
 
   (void)ip;
@@ -124,7 +157,7 @@ static msg_t _ctl(void *ip, unsigned int operation, void *arg) {
 
 static const struct BaseChannelVMT vmt = {
   (size_t)0,
-  _write, _read, _put, _get,
+  _write, _read, _writev, _readv, _put, _get,
   _putt, _gett, _writet, _readt,
   _ctl
 };
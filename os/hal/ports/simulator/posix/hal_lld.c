@@ -36,8 +36,10 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (SIMULATOR_VIRTUAL_TIME == FALSE) || defined(__DOXYGEN__)
 static struct timeval nextcnt;
 static struct timeval tick = {0UL, 1000000UL / OSAL_ST_FREQUENCY};
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
@@ -61,15 +63,19 @@ void hal_lld_init(void) {
 #else
   puts("ChibiOS/RT simulator (Linux)\n");
 #endif
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   gettimeofday(&nextcnt, NULL);
   timeradd(&nextcnt, &tick, &nextcnt);
+#endif
 }
 
 /**
  * @brief   Interrupt simulation.
  */
 void _sim_check_for_interrupts(void) {
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   struct timeval tv;
+#endif
   bool int_occurred = false;
 
 #if HAL_USE_SERIAL
@@ -78,6 +84,7 @@ void _sim_check_for_interrupts(void) {
   }
 #endif
 
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   gettimeofday(&tv, NULL);
   if (timercmp(&tv, &nextcnt, >=)) {
     int_occurred = true;
@@ -91,6 +98,21 @@ void _sim_check_for_interrupts(void) {
 
     CH_IRQ_EPILOGUE();
   }
+#else /* SIMULATOR_VIRTUAL_TIME == TRUE */
+  /* In virtual time mode the wall clock is not consulted, a tick interrupt
+     is served on each check. The check is performed whenever the system
+     has nothing better to do so the simulated time advances instantly
+     while all threads are sleeping.*/
+  int_occurred = true;
+
+  CH_IRQ_PROLOGUE();
+
+  chSysLockFromISR();
+  chSysTimerHandlerI();
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+#endif /* SIMULATOR_VIRTUAL_TIME == TRUE */
 
   if (int_occurred) {
     _dbg_check_lock();
@@ -32,8 +32,10 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (SIMULATOR_VIRTUAL_TIME == FALSE) || defined(__DOXYGEN__)
 static LARGE_INTEGER nextcnt;
 static LARGE_INTEGER slice;
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
@@ -60,6 +62,7 @@ void hal_lld_init(void) {
   }
 
   printf("ChibiOS/RT simulator (Win32)\n");
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   if (!QueryPerformanceFrequency(&slice)) {
     printf("QueryPerformanceFrequency() error");
     exit(1);
@@ -67,6 +70,7 @@ void hal_lld_init(void) {
   slice.QuadPart /= CH_CFG_ST_FREQUENCY;
   QueryPerformanceCounter(&nextcnt);
   nextcnt.QuadPart += slice.QuadPart;
+#endif
 
   fflush(stdout);
 }
@@ -75,7 +79,9 @@ void hal_lld_init(void) {
  * @brief   Interrupt simulation.
  */
 void _sim_check_for_interrupts(void) {
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   LARGE_INTEGER n;
+#endif
   bool int_occurred = false;
 
 #if HAL_USE_SERIAL
@@ -84,6 +90,7 @@ void _sim_check_for_interrupts(void) {
   }
 #endif
 
+#if SIMULATOR_VIRTUAL_TIME == FALSE
   /* Interrupt Timer simulation (10ms interval).*/
   QueryPerformanceCounter(&n);
   if (n.QuadPart > nextcnt.QuadPart) {
@@ -98,6 +105,21 @@ void _sim_check_for_interrupts(void) {
 
     CH_IRQ_EPILOGUE();
   }
+#else /* SIMULATOR_VIRTUAL_TIME == TRUE */
+  /* In virtual time mode the wall clock is not consulted, a tick interrupt
+     is served on each check. The check is performed whenever the system
+     has nothing better to do so the simulated time advances instantly
+     while all threads are sleeping.*/
+  int_occurred = true;
+
+  CH_IRQ_PROLOGUE();
+
+  chSysLockFromISR();
+  chSysTimerHandlerI();
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+#endif /* SIMULATOR_VIRTUAL_TIME == TRUE */
 
   if (int_occurred) {
     _dbg_check_lock();
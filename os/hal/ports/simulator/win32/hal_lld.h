@@ -41,6 +41,18 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Enables the virtual time mode.
+ * @details When enabled the simulated system tick is no more bound to the
+ *          host wall clock, a tick interrupt is served on each interrupt
+ *          check instead. The simulated time advances as fast as the host
+ *          can run it and delays become fully deterministic, time-based
+ *          test suites complete in a fraction of the real-time duration.
+ */
+#if !defined(SIMULATOR_VIRTUAL_TIME) || defined(__DOXYGEN__)
+#define SIMULATOR_VIRTUAL_TIME      FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -28,6 +28,14 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+#define HAL_INIT_PHASE_BEGIN(name) hal_init_phase_begin(name)
+#define HAL_INIT_PHASE_END() hal_init_phase_end()
+#else
+#define HAL_INIT_PHASE_BEGIN(name)
+#define HAL_INIT_PHASE_END()
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -36,10 +44,79 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initialization records storage.
+ */
+static halinitrecord_t hal_init_records[HAL_INIT_MAX_RECORDS];
+
+/**
+ * @brief   Number of valid initialization records.
+ */
+static unsigned hal_init_records_n;
+#endif /* HAL_USE_STAGED_INIT == TRUE */
+
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   List of the registered clock listeners.
+ */
+static hal_clock_listener_t *hal_clock_listeners;
+#endif /* HAL_USE_CLOCK_MANAGEMENT == TRUE */
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Opens an initialization record.
+ * @details Phases in excess of @p HAL_INIT_MAX_RECORDS are executed but
+ *          not recorded.
+ *
+ * @param[in] name      name stored in the record
+ *
+ * @notapi
+ */
+static void hal_init_phase_begin(const char *name) {
+
+  if (hal_init_records_n < (unsigned)HAL_INIT_MAX_RECORDS) {
+    hal_init_records[hal_init_records_n].name  = name;
+    hal_init_records[hal_init_records_n].start = HAL_INIT_GET_TIMESTAMP();
+  }
+}
+
+/**
+ * @brief   Closes the current initialization record.
+ *
+ * @notapi
+ */
+static void hal_init_phase_end(void) {
+
+  if (hal_init_records_n < (unsigned)HAL_INIT_MAX_RECORDS) {
+    hal_init_records[hal_init_records_n].end = HAL_INIT_GET_TIMESTAMP();
+    hal_init_records_n++;
+  }
+}
+#endif /* HAL_USE_STAGED_INIT == TRUE */
+
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Notifies all the registered clock listeners.
+ *
+ * @param[in] event     event to be notified
+ *
+ * @notapi
+ */
+static void hal_notify_clock_listeners(halclockevent_t event) {
+  hal_clock_listener_t *hclp = hal_clock_listeners;
+
+  while (hclp != NULL) {
+    hclp->cb(event, hclp->param);
+    hclp = hclp->next;
+  }
+}
+#endif /* HAL_USE_CLOCK_MANAGEMENT == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -55,12 +132,21 @@
  */
 void halInit(void) {
 
+#if HAL_USE_STAGED_INIT == TRUE
+  HAL_INIT_TIMESTAMP_INIT();
+#endif
+
+  HAL_INIT_PHASE_BEGIN("core");
+
   /* Initializes the OS Abstraction Layer.*/
   osalInit();
 
   /* Platform low level initializations.*/
   hal_lld_init();
 
+  HAL_INIT_PHASE_END();
+  HAL_INIT_PHASE_BEGIN("drivers");
+
 #if (HAL_USE_PAL == TRUE) || defined(__DOXYGEN__)
 #if defined(PAL_NEW_INIT)
   palInit();
@@ -139,16 +225,156 @@ void halInit(void) {
 #endif
 #endif
 
+  HAL_INIT_PHASE_END();
+  HAL_INIT_PHASE_BEGIN("board");
+
   /* Board specific initialization.*/
   boardInit();
 
+  HAL_INIT_PHASE_END();
+
 /*
  *  The ST driver is a special case, it is only initialized if the OSAL is
  *  configured to require it.
  */
 #if OSAL_ST_MODE != OSAL_ST_MODE_NONE
+  HAL_INIT_PHASE_BEGIN("st");
   stInit();
+  HAL_INIT_PHASE_END();
 #endif
 }
 
+#if (HAL_USE_STAGED_INIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Deferred initialization stage.
+ * @details Executes, in order, the initialization functions of the
+ *          passed table, each one is timestamped into its own record.
+ *          The function is meant to be called by a low priority thread
+ *          after the scheduler has been started so that boot-critical
+ *          drivers become operational without waiting for slow ones.
+ *
+ * @param[in] eip       pointer to a table of @p halinitentry_t entries
+ *                      terminated by an entry with a @p NULL function
+ *                      pointer
+ *
+ * @api
+ */
+void halDeferredInit(const halinitentry_t *eip) {
+
+  osalDbgCheck(eip != NULL);
+
+  while (eip->func != NULL) {
+    HAL_INIT_PHASE_BEGIN(eip->name);
+    eip->func();
+    HAL_INIT_PHASE_END();
+    eip++;
+  }
+}
+
+/**
+ * @brief   Returns the initialization records.
+ * @details Each record carries the timestamps taken on entry and exit of
+ *          one initialization phase, the first records cover @p halInit()
+ *          itself, further records are added by @p halDeferredInit().
+ *
+ * @param[out] np       pointer to a variable receiving the number of
+ *                      valid records, can be @p NULL
+ * @return              Pointer to the records array.
+ *
+ * @api
+ */
+const halinitrecord_t *halGetInitRecords(unsigned *np) {
+
+  if (np != NULL) {
+    *np = hal_init_records_n;
+  }
+
+  return hal_init_records;
+}
+#endif /* HAL_USE_STAGED_INIT == TRUE */
+
+#if (HAL_USE_CLOCK_MANAGEMENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Registers a clock listener.
+ * @details The listener is notified before and after each clock tree
+ *          transition performed through @p halClockSwitch(). Drivers
+ *          computing dividers from clock frequencies register a listener
+ *          in order to recompute them, listeners cannot be unregistered.
+ *
+ * @param[out] hclp     pointer to the @p hal_clock_listener_t structure
+ *                      to be registered, it must be statically allocated
+ * @param[in] cb        listener callback
+ * @param[in] param     parameter passed to the callback
+ *
+ * @api
+ */
+void halAddClockListener(hal_clock_listener_t *hclp,
+                         halclockcb_t cb, void *param) {
+
+  osalDbgCheck((hclp != NULL) && (cb != NULL));
+
+  hclp->cb    = cb;
+  hclp->param = param;
+
+  osalSysLock();
+  hclp->next          = hal_clock_listeners;
+  hal_clock_listeners = hclp;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Switches the clock tree to a new configuration.
+ * @details The registered listeners are notified with
+ *          @p HAL_CLOCKEVENT_PRE_SWITCH so ongoing operations can be
+ *          quiesced, then the port-specific transition is performed in a
+ *          critical section, finally the listeners are notified with
+ *          @p HAL_CLOCKEVENT_POST_SWITCH so dividers can be recomputed.
+ * @note    Drivers whose divider settings are specified as raw register
+ *          values in their configuration, SPI prescalers for example,
+ *          cannot recompute them autonomously, the application is
+ *          expected to register its own listener and restart those
+ *          drivers with updated configurations.
+ *
+ * @param[in] ccp       pointer to a port-defined @p halclkcfg_t clock
+ *                      configuration
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the switch has been performed.
+ * @retval HAL_FAILED   if the configuration has been rejected by the
+ *                      port layer, the previous configuration is still
+ *                      active.
+ *
+ * @api
+ */
+bool halClockSwitch(const halclkcfg_t *ccp) {
+  bool result;
+
+  osalDbgCheck(ccp != NULL);
+
+  hal_notify_clock_listeners(HAL_CLOCKEVENT_PRE_SWITCH);
+
+  osalSysLock();
+  result = hal_lld_clock_switch(ccp);
+  osalSysUnlock();
+
+  if (result == HAL_SUCCESS) {
+    hal_notify_clock_listeners(HAL_CLOCKEVENT_POST_SWITCH);
+  }
+
+  return result;
+}
+
+/**
+ * @brief   Returns the current frequency of a clock point.
+ *
+ * @param[in] pt        port-defined clock point identifier
+ * @return              The clock point frequency in Hz.
+ *
+ * @xclass
+ */
+uint32_t halClockGetPointX(halclkpt_t pt) {
+
+  return hal_lld_get_clock_point(pt);
+}
+#endif /* HAL_USE_CLOCK_MANAGEMENT == TRUE */
+
 /** @} */
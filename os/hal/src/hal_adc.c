@@ -78,6 +78,13 @@ void adcObjectInit(ADCDriver *adcp) {
 #if ADC_USE_MUTUAL_EXCLUSION == TRUE
   osalMutexObjectInit(&adcp->mutex);
 #endif
+#if ADC_USE_DECIMATION == TRUE
+  adcp->dshift   = 0;
+  adcp->dbuf     = NULL;
+#endif
+#if ADC_USE_TIMESTAMP == TRUE
+  adcp->timestamp = (systime_t)0;
+#endif
 #if defined(ADC_DRIVER_EXT_INIT_HOOK)
   ADC_DRIVER_EXT_INIT_HOOK(adcp);
 #endif
@@ -180,6 +187,13 @@ void adcStartConversionI(ADCDriver *adcp,
   osalDbgCheckClassI();
   osalDbgCheck((adcp != NULL) && (grpp != NULL) && (samples != NULL) &&
                (depth > 0U) && ((depth == 1U) || ((depth & 1U) == 0U)));
+#if ADC_USE_DECIMATION == TRUE
+  osalDbgCheck((adcp->dshift == 0U) ||
+               ((adcp->dbuf != NULL) &&
+                ((depth % ((size_t)1 << adcp->dshift)) == 0U) &&
+                ((depth == 1U) ||
+                 (((depth / 2U) % ((size_t)1 << adcp->dshift)) == 0U))));
+#endif
   osalDbgAssert((adcp->state == ADC_READY) ||
                 (adcp->state == ADC_COMPLETE) ||
                 (adcp->state == ADC_ERROR),
@@ -192,6 +206,98 @@ void adcStartConversionI(ADCDriver *adcp,
   adc_lld_start_conversion(adcp);
 }
 
+#if (ADC_USE_SYNCHRONIZATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts ADC conversions on a set of drivers.
+ * @details Starts an asynchronous conversion operation on each driver of
+ *          the set. The parameters of all drivers are validated first,
+ *          then the conversions are started back-to-back, the residual
+ *          start skew is the execution time of one low level start.
+ *
+ * @param[in] adcps     array of pointers to @p ADCDriver objects
+ * @param[in] grpps     array of pointers to @p ADCConversionGroup objects,
+ *                      one for each driver
+ * @param[out] samples  array of pointers to the samples buffers, one for
+ *                      each driver
+ * @param[in] depth     buffer depth (matrix rows number), common to all
+ *                      drivers. The buffer depth must be one or an even
+ *                      number.
+ * @param[in] n         number of drivers in the set
+ *
+ * @api
+ */
+void adcStartConversionSynchronized(ADCDriver * const adcps[],
+                                    const ADCConversionGroup * const grpps[],
+                                    adcsample_t * const samples[],
+                                    size_t depth,
+                                    size_t n) {
+
+  osalSysLock();
+  adcStartConversionSynchronizedI(adcps, grpps, samples, depth, n);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts ADC conversions on a set of drivers.
+ * @details Starts an asynchronous conversion operation on each driver of
+ *          the set. The parameters of all drivers are validated first,
+ *          then the conversions are started back-to-back, the residual
+ *          start skew is the execution time of one low level start.
+ * @post    The callbacks associated to the conversion groups will be
+ *          invoked on buffer fill and error events.
+ *
+ * @param[in] adcps     array of pointers to @p ADCDriver objects
+ * @param[in] grpps     array of pointers to @p ADCConversionGroup objects,
+ *                      one for each driver
+ * @param[out] samples  array of pointers to the samples buffers, one for
+ *                      each driver
+ * @param[in] depth     buffer depth (matrix rows number), common to all
+ *                      drivers. The buffer depth must be one or an even
+ *                      number.
+ * @param[in] n         number of drivers in the set
+ *
+ * @iclass
+ */
+void adcStartConversionSynchronizedI(ADCDriver * const adcps[],
+                                     const ADCConversionGroup * const grpps[],
+                                     adcsample_t * const samples[],
+                                     size_t depth,
+                                     size_t n) {
+  size_t i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((adcps != NULL) && (grpps != NULL) && (samples != NULL) &&
+               (n > 0U) && (depth > 0U) &&
+               ((depth == 1U) || ((depth & 1U) == 0U)));
+
+  /* Validating all drivers before starting any of them, the start loop
+     below must not be interleaved with checks.*/
+  for (i = 0U; i < n; i++) {
+    osalDbgCheck((adcps[i] != NULL) && (grpps[i] != NULL) &&
+                 (samples[i] != NULL));
+#if ADC_USE_DECIMATION == TRUE
+    osalDbgCheck((adcps[i]->dshift == 0U) ||
+                 ((adcps[i]->dbuf != NULL) &&
+                  ((depth % ((size_t)1 << adcps[i]->dshift)) == 0U) &&
+                  ((depth == 1U) ||
+                   (((depth / 2U) % ((size_t)1 << adcps[i]->dshift)) == 0U))));
+#endif
+    osalDbgAssert((adcps[i]->state == ADC_READY) ||
+                  (adcps[i]->state == ADC_COMPLETE) ||
+                  (adcps[i]->state == ADC_ERROR),
+                  "not ready");
+  }
+
+  for (i = 0U; i < n; i++) {
+    adcps[i]->samples  = samples[i];
+    adcps[i]->depth    = depth;
+    adcps[i]->grpp     = grpps[i];
+    adcps[i]->state    = ADC_ACTIVE;
+    adc_lld_start_conversion(adcps[i]);
+  }
+}
+#endif /* ADC_USE_SYNCHRONIZATION == TRUE */
+
 /**
  * @brief   Stops an ongoing conversion.
  * @details This function stops the currently ongoing conversion and returns
@@ -245,6 +351,79 @@ void adcStopConversionI(ADCDriver *adcp) {
   }
 }
 
+#if (ADC_USE_DECIMATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Arms or disarms the decimation stage.
+ * @details When armed, each buffer callback accumulates groups of
+ *          <tt>2^dshift</tt> consecutive sample rows per channel, shifts
+ *          the accumulated values right by @p dshift and delivers the
+ *          averaged rows to the end callback, which then receives
+ *          <tt>n >> dshift</tt> rows pointing into @p dbuf.
+ * @pre     In order to use this function the option @p ADC_USE_DECIMATION
+ *          must be enabled.
+ * @pre     The number of rows passed to each callback, the buffer depth
+ *          for linear conversions or half of it for circular ones, must
+ *          be a multiple of <tt>2^dshift</tt>, this is checked in
+ *          @p adcStartConversionI().
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] dshift    decimation shift, zero disables the stage
+ * @param[in] dbuf      buffer receiving the decimated samples, it must be
+ *                      able to hold the decimated rows of one callback,
+ *                      can be @p NULL if @p dshift is zero
+ *
+ * @api
+ */
+void adcSetDecimation(ADCDriver *adcp, uint8_t dshift, adcsample_t *dbuf) {
+
+  osalDbgCheck((adcp != NULL) && ((dshift == 0U) || (dbuf != NULL)));
+
+  osalSysLock();
+  osalDbgAssert((adcp->state == ADC_STOP) || (adcp->state == ADC_READY),
+                "invalid state");
+  adcp->dshift = dshift;
+  adcp->dbuf   = dbuf;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Decimates a buffer and invokes the end callback.
+ * @note    This function is meant to be invoked by the buffer callback
+ *          macros only, not by the application.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] buffer    pointer to the first sample row of the buffer
+ * @param[in] n         number of sample rows in the buffer
+ *
+ * @notapi
+ */
+void _adc_decimate(ADCDriver *adcp, adcsample_t *buffer, size_t n) {
+  size_t nch = (size_t)adcp->grpp->num_channels;
+  size_t ratio = (size_t)1 << adcp->dshift;
+  adcsample_t *dst = adcp->dbuf;
+
+  while (n > 0U) {
+    size_t ch;
+
+    /* One decimated row is produced from "ratio" consecutive rows.*/
+    for (ch = 0U; ch < nch; ch++) {
+      uint32_t acc = 0;
+      size_t r;
+
+      for (r = 0U; r < ratio; r++) {
+        acc += (uint32_t)buffer[(r * nch) + ch];
+      }
+      *dst++ = (adcsample_t)(acc >> adcp->dshift);
+    }
+    buffer += ratio * nch;
+    n -= ratio;
+  }
+
+  adcp->grpp->end_cb(adcp, adcp->dbuf,
+                     (size_t)(dst - adcp->dbuf) / nch);
+}
+#endif /* ADC_USE_DECIMATION == TRUE */
+
 #if (ADC_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Performs an ADC conversion.
@@ -44,6 +44,13 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/*
+ * Fallback on ports not providing optimized bulk memory operations.
+ */
+#if !defined(PORT_SUPPORTS_MEMOPS)
+#define __port_memcpy(dp, sp, n)    memcpy((dp), (sp), (n))
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -152,6 +159,13 @@ void ibqPostFullBufferI(input_buffers_queue_t *ibqp, size_t size) {
   osalDbgCheck((size > 0U) && (size <= (ibqp->bsize - sizeof (size_t))));
   osalDbgAssert(!ibqIsFullI(ibqp), "buffers queue full");
 
+#if BQ_USE_CACHE_MAINTENANCE == TRUE
+  /* Discarding any cached copy of the buffer just filled by the DMA, it
+     must be done before writing the size field or the write would be
+     lost together with the stale lines.*/
+  cacheBufferInvalidate(ibqp->bwrptr, sizeof (size_t) + size);
+#endif
+
   /* Writing size field in the buffer.*/
   *((size_t *)ibqp->bwrptr) = size;
 
@@ -166,6 +180,67 @@ void ibqPostFullBufferI(input_buffers_queue_t *ibqp, size_t size) {
   osalThreadDequeueNextI(&ibqp->waiting, MSG_OK);
 }
 
+/**
+ * @brief   Gets the next filled buffer from the queue.
+ * @note    The function always returns the same buffer if called repeatedly.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ * @param[out] sizep    pointer to the filled buffer size
+ * @return              A pointer to the filled buffer.
+ * @retval NULL         if the queue is empty.
+ *
+ * @iclass
+ */
+uint8_t *ibqGetFullBufferI(input_buffers_queue_t *ibqp,
+                           size_t *sizep) {
+
+  osalDbgCheckClassI();
+
+  if (ibqIsEmptyI(ibqp)) {
+    return NULL;
+  }
+
+  /* Buffer size.*/
+  *sizep = *((size_t *)ibqp->brdptr);
+
+  return ibqp->brdptr + sizeof (size_t);
+}
+
+/**
+ * @brief   Releases the buffer back in the queue.
+ * @note    The object callback is called after releasing the buffer.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ *
+ * @iclass
+ */
+void ibqReleaseEmptyBufferI(input_buffers_queue_t *ibqp) {
+
+  osalDbgCheckClassI();
+  osalDbgAssert(!ibqIsEmptyI(ibqp), "buffers queue empty");
+
+#if BQ_USE_CACHE_MAINTENANCE == TRUE
+  /* Discarding any cached content of the released buffer before it is
+     handed back to the DMA for refilling.*/
+  cacheBufferInvalidate(ibqp->brdptr, ibqp->bsize);
+#endif
+
+  /* Freeing a buffer slot in the queue.*/
+  ibqp->bcounter--;
+  ibqp->brdptr += ibqp->bsize;
+  if (ibqp->brdptr >= ibqp->btop) {
+    ibqp->brdptr = ibqp->buffers;
+  }
+
+  /* No "current" buffer.*/
+  ibqp->ptr = NULL;
+
+  /* Notifying the buffer release.*/
+  if (ibqp->notify != NULL) {
+    ibqp->notify(ibqp);
+  }
+}
+
 /**
  * @brief   Gets the next filled buffer from the queue.
  * @note    The function always acquires the same buffer if called repeatedly.
@@ -243,6 +318,115 @@ msg_t ibqGetFullBufferTimeout(input_buffers_queue_t *ibqp,
   return MSG_OK;
 }
 
+/**
+ * @brief   Gets the most recent filled buffer from the queue.
+ * @details Older filled buffers, if any, are discarded in a single step and
+ *          their slots are immediately returned to the producer side, this
+ *          implements a "latest wins" policy. With a queue of three or more
+ *          buffers this allows the classic triple-buffer rotation where the
+ *          producer is never stalled and the consumer always processes the
+ *          freshest data.
+ * @post    After calling the function the fields @p ptr and @p top are set
+ *          at beginning and end of the buffer data or @p NULL if the queue
+ *          is empty.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been acquired.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset or has been put in
+ *                      suspended state.
+ *
+ * @api
+ */
+msg_t ibqGetLatestFullBufferTimeout(input_buffers_queue_t *ibqp,
+                                    sysinterval_t timeout) {
+  msg_t msg;
+
+  osalSysLock();
+  msg = ibqGetLatestFullBufferTimeoutS(ibqp, timeout);
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Gets the most recent filled buffer from the queue.
+ * @details Older filled buffers, if any, are discarded in a single step and
+ *          their slots are immediately returned to the producer side, this
+ *          implements a "latest wins" policy. With a queue of three or more
+ *          buffers this allows the classic triple-buffer rotation where the
+ *          producer is never stalled and the consumer always processes the
+ *          freshest data.
+ * @post    After calling the function the fields @p ptr and @p top are set
+ *          at beginning and end of the buffer data or @p NULL if the queue
+ *          is empty.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been acquired.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset or has been put in
+ *                      suspended state.
+ *
+ * @sclass
+ */
+msg_t ibqGetLatestFullBufferTimeoutS(input_buffers_queue_t *ibqp,
+                                     sysinterval_t timeout) {
+  size_t stale;
+
+  osalDbgCheckClassS();
+
+  while (ibqIsEmptyI(ibqp)) {
+    if (ibqp->suspended) {
+      return MSG_RESET;
+    }
+    msg_t msg = osalThreadEnqueueTimeoutS(&ibqp->waiting, timeout);
+    if (msg < MSG_OK) {
+       return msg;
+    }
+  }
+
+  osalDbgAssert(!ibqIsEmptyI(ibqp), "still empty");
+
+  /* Discarding all filled buffers except the most recent one, the read
+     pointer is moved directly to the last filled slot so the cost does
+     not depend on the number of discarded buffers.*/
+  stale = ibqp->bcounter - 1U;
+  if (stale > 0U) {
+    size_t offset = (size_t)(ibqp->brdptr - ibqp->buffers) +
+                    (stale * ibqp->bsize);
+    size_t total  = (size_t)(ibqp->btop - ibqp->buffers);
+
+    if (offset >= total) {
+      offset -= total;
+    }
+    ibqp->brdptr = ibqp->buffers + offset;
+    ibqp->bcounter = 1U;
+
+    /* Notifying the release of the discarded slots.*/
+    if (ibqp->notify != NULL) {
+      ibqp->notify(ibqp);
+    }
+  }
+
+  /* Setting up the "current" buffer and its boundary.*/
+  ibqp->ptr = ibqp->brdptr + sizeof (size_t);
+  ibqp->top = ibqp->ptr + *((size_t *)ibqp->brdptr);
+
+  return MSG_OK;
+}
+
 /**
  * @brief   Releases the buffer back in the queue.
  * @note    The object callback is called after releasing the buffer.
@@ -269,22 +453,8 @@ void ibqReleaseEmptyBuffer(input_buffers_queue_t *ibqp) {
   void ibqReleaseEmptyBufferS(input_buffers_queue_t *ibqp) {
 
   osalDbgCheckClassS();
-  osalDbgAssert(!ibqIsEmptyI(ibqp), "buffers queue empty");
-
-  /* Freeing a buffer slot in the queue.*/
-  ibqp->bcounter--;
-  ibqp->brdptr += ibqp->bsize;
-  if (ibqp->brdptr >= ibqp->btop) {
-    ibqp->brdptr = ibqp->buffers;
-  }
 
-  /* No "current" buffer.*/
-  ibqp->ptr = NULL;
-
-  /* Notifying the buffer release.*/
-  if (ibqp->notify != NULL) {
-    ibqp->notify(ibqp);
-  }
+  ibqReleaseEmptyBufferI(ibqp);
 }
 
 /**
@@ -410,13 +580,13 @@ size_t ibqReadTimeout(input_buffers_queue_t *ibqp, uint8_t *bp,
        this impacts throughput however.*/
     if (size > 64U) {
       /* Giving the compiler a chance to optimize for a fixed size move.*/
-      memcpy(bp, ibqp->ptr, 64U);
+      __port_memcpy(bp, ibqp->ptr, 64U);
       bp        += 64U;
       ibqp->ptr += 64U;
       r         += 64U;
     }
     else {
-      memcpy(bp, ibqp->ptr, size);
+      __port_memcpy(bp, ibqp->ptr, size);
       bp        += size;
       ibqp->ptr += size;
       r         += size;
@@ -541,6 +711,67 @@ void obqReleaseEmptyBufferI(output_buffers_queue_t *obqp) {
   osalThreadDequeueNextI(&obqp->waiting, MSG_OK);
 }
 
+/**
+ * @brief   Gets the next empty buffer from the queue.
+ * @note    The function always returns the same buffer if called repeatedly.
+ *
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @return              A pointer to the empty buffer.
+ * @retval NULL         if the queue is full.
+ *
+ * @iclass
+ */
+uint8_t *obqGetEmptyBufferI(output_buffers_queue_t *obqp) {
+
+  osalDbgCheckClassI();
+
+  if (obqIsFullI(obqp)) {
+    return NULL;
+  }
+
+  return obqp->bwrptr + sizeof (size_t);
+}
+
+/**
+ * @brief   Posts a new filled buffer to the queue.
+ * @note    The object callback is called after releasing the buffer.
+ *
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @param[in] size      used size of the buffer, cannot be zero
+ *
+ * @iclass
+ */
+void obqPostFullBufferI(output_buffers_queue_t *obqp, size_t size) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck((size > 0U) && (size <= (obqp->bsize - sizeof (size_t))));
+  osalDbgAssert(!obqIsFullI(obqp), "buffers queue full");
+
+  /* Writing size field in the buffer.*/
+  *((size_t *)obqp->bwrptr) = size;
+
+#if BQ_USE_CACHE_MAINTENANCE == TRUE
+  /* Flushing the buffer to memory before it is handed to the DMA.*/
+  cacheBufferFlush(obqp->bwrptr, sizeof (size_t) + size);
+#endif
+
+  /* Posting the buffer in the queue.*/
+  obqp->bcounter--;
+  obqp->bwrptr += obqp->bsize;
+  if (obqp->bwrptr >= obqp->btop) {
+    obqp->bwrptr = obqp->buffers;
+  }
+
+  /* No "current" buffer.*/
+  obqp->ptr = NULL;
+
+  /* Notifying the buffer release.*/
+  if (obqp->notify != NULL) {
+    obqp->notify(obqp);
+  }
+}
+
 /**
  * @brief   Gets the next empty buffer from the queue.
  * @note    The function always acquires the same buffer if called repeatedly.
@@ -646,26 +877,8 @@ void obqPostFullBuffer(output_buffers_queue_t *obqp, size_t size) {
 void obqPostFullBufferS(output_buffers_queue_t *obqp, size_t size) {
 
   osalDbgCheckClassS();
-  osalDbgCheck((size > 0U) && (size <= (obqp->bsize - sizeof (size_t))));
-  osalDbgAssert(!obqIsFullI(obqp), "buffers queue full");
-
-  /* Writing size field in the buffer.*/
-  *((size_t *)obqp->bwrptr) = size;
-
-  /* Posting the buffer in the queue.*/
-  obqp->bcounter--;
-  obqp->bwrptr += obqp->bsize;
-  if (obqp->bwrptr >= obqp->btop) {
-    obqp->bwrptr = obqp->buffers;
-  }
 
-  /* No "current" buffer.*/
-  obqp->ptr = NULL;
-
-  /* Notifying the buffer release.*/
-  if (obqp->notify != NULL) {
-    obqp->notify(obqp);
-  }
+  obqPostFullBufferI(obqp, size);
 }
 
 /**
@@ -793,13 +1006,13 @@ size_t obqWriteTimeout(output_buffers_queue_t *obqp, const uint8_t *bp,
        this impacts throughput however.*/
     if (size > 64U) {
       /* Giving the compiler a chance to optimize for a fixed size move.*/
-      memcpy(obqp->ptr, bp, 64U);
+      __port_memcpy(obqp->ptr, bp, 64U);
       bp        += 64U;
       obqp->ptr += 64U;
       w         += 64U;
     }
     else {
-      memcpy(obqp->ptr, bp, size);
+      __port_memcpy(obqp->ptr, bp, size);
       bp        += size;
       obqp->ptr += size;
       w         += size;
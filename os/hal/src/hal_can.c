@@ -42,6 +42,42 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Inserts a frame into the software TX queue.
+ * @details The frame is copied into a free slot and the slot is inserted
+ *          keeping the queue ordered by arbitration key, FIFO within the
+ *          same key.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] ctfp      pointer to the CAN frame to be queued
+ * @return              The operation result.
+ * @retval false        Frame queued.
+ * @retval true         No free slots.
+ */
+static bool can_txq_insert(CANDriver *canp, const CANTxFrame *ctfp) {
+  can_tx_slot_t *slot, **lpp;
+  uint32_t key;
+
+  slot = canp->txfree;
+  if (slot == NULL) {
+    return true;
+  }
+  canp->txfree = slot->next;
+  slot->frame = *ctfp;
+
+  key = CAN_TX_FRAME_KEY(ctfp);
+  lpp = &canp->txhead;
+  while ((*lpp != NULL) && (CAN_TX_FRAME_KEY(&(*lpp)->frame) <= key)) {
+    lpp = &(*lpp)->next;
+  }
+  slot->next = *lpp;
+  *lpp = slot;
+
+  return false;
+}
+#endif /* CAN_USE_TX_QUEUE == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -71,6 +107,24 @@ void canObjectInit(CANDriver *canp) {
   canp->config      = NULL;
   osalThreadQueueObjectInit(&canp->txqueue);
   osalThreadQueueObjectInit(&canp->rxqueue);
+#if CAN_USE_TX_QUEUE == TRUE
+  canp->txhead      = NULL;
+  canp->txfree      = NULL;
+#endif
+#if CAN_USE_ERROR_MONITOR == TRUE
+  canp->stats.error_frames = 0U;
+  canp->stats.arb_losses   = 0U;
+  canp->stats.overruns     = 0U;
+  canp->stats.warnings     = 0U;
+  canp->stats.passives     = 0U;
+  canp->stats.bus_offs     = 0U;
+  canp->stats.recoveries   = 0U;
+  canp->rec_enabled = false;
+  canp->rec_limit   = 0U;
+  canp->rec_window  = (sysinterval_t)0;
+  canp->rec_start   = (systime_t)0;
+  canp->rec_count   = 0U;
+#endif
 #if CAN_ENFORCE_USE_CALLBACKS == FALSE
   osalEventObjectInit(&canp->rxfull_event);
   osalEventObjectInit(&canp->txempty_event);
@@ -153,6 +207,10 @@ void canStop(CANDriver *canp) {
  * @brief   Can frame transmission attempt.
  * @details The specified frame is queued for transmission, if the hardware
  *          queue is full then the function fails.
+ * @note    When @p CAN_USE_TX_QUEUE is enabled and @p CAN_ANY_MAILBOX is
+ *          specified the frame is stored in the software TX queue when
+ *          the hardware is busy, the function only fails when no free
+ *          queue slots are left.
  *
  * @param[in] canp      pointer to the @p CANDriver object
  * @param[in] mailbox   mailbox number, @p CAN_ANY_MAILBOX for any mailbox
@@ -173,6 +231,22 @@ bool canTryTransmitI(CANDriver *canp,
   osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
                 "invalid state");
 
+#if CAN_USE_TX_QUEUE == TRUE
+  if (mailbox == CAN_ANY_MAILBOX) {
+    /* Hardware fast path, only taken when the software queue is empty so
+       that queued higher priority frames are not overtaken.*/
+    if ((canp->txhead == NULL) && (canp->state == CAN_READY) &&
+        can_lld_is_tx_empty(canp, CAN_ANY_MAILBOX)) {
+      can_lld_transmit(canp, CAN_ANY_MAILBOX, ctfp);
+      return false;
+    }
+
+    /* Queueing the frame sorted by arbitration priority, it will be fed
+       to the hardware from the TX-empty ISR.*/
+    return can_txq_insert(canp, ctfp);
+  }
+#endif
+
   /* If the RX mailbox is full then the function fails.*/
   if (!can_lld_is_tx_empty(canp, mailbox)) {
     return true;
@@ -184,6 +258,200 @@ bool canTryTransmitI(CANDriver *canp,
   return false;
 }
 
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Assigns the software TX queue slots to the driver.
+ * @details The slots array is linked into the free list, the previously
+ *          assigned slots, if any, are discarded.
+ * @pre     The software TX queue must be empty.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] slots     array of TX queue slots, owned by the driver after
+ *                      the call
+ * @param[in] n         number of slots in the array
+ *
+ * @api
+ */
+void canSetTxQueue(CANDriver *canp, can_tx_slot_t slots[], size_t n) {
+  size_t i;
+
+  osalDbgCheck((canp != NULL) && (slots != NULL) && (n > 0U));
+
+  osalSysLock();
+
+  osalDbgAssert(canp->txhead == NULL, "queue not empty");
+
+  for (i = 0U; i < (n - 1U); i++) {
+    slots[i].next = &slots[i + 1U];
+  }
+  slots[n - 1U].next = NULL;
+  canp->txfree = &slots[0];
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Feeds the highest priority queued frame to the hardware.
+ * @details If the software TX queue is not empty and a hardware mailbox
+ *          is free then one frame is moved into the hardware, one frame
+ *          per TX-empty event keeps the hardware loaded in priority
+ *          order.
+ * @note    Not an API, this function is invoked by the TX-empty ISR
+ *          macros within the system critical zone.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void _can_txq_feed(CANDriver *canp) {
+  can_tx_slot_t *slot = canp->txhead;
+
+  if ((slot != NULL) && (canp->state == CAN_READY) &&
+      can_lld_is_tx_empty(canp, CAN_ANY_MAILBOX)) {
+    canp->txhead = slot->next;
+    can_lld_transmit(canp, CAN_ANY_MAILBOX, &slot->frame);
+
+    /* Returning the slot to the free list.*/
+    slot->next = canp->txfree;
+    canp->txfree = slot;
+  }
+}
+#endif /* CAN_USE_TX_QUEUE == TRUE */
+
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables the automatic bus-off recovery engine.
+ * @details When the bus-off state is entered the low level driver is
+ *          immediately instructed to start the recovery sequence, the
+ *          fault confinement rules then keep the node off the bus until
+ *          128 occurrences of 11 consecutive recessive bits have been
+ *          monitored, so a persistently faulted bus is never hammered.
+ *          The policy parameters additionally bound the recovery rate:
+ *          at most @p limit recoveries are performed within each
+ *          @p window interval, once exhausted the driver is left in the
+ *          bus-off state and application intervention is required.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] limit     maximum number of recoveries per window, zero
+ *                      disables the rate limiting
+ * @param[in] window    observation window length
+ *
+ * @api
+ */
+void canEnableAutoRecovery(CANDriver *canp, uint32_t limit,
+                           sysinterval_t window) {
+
+  osalDbgCheck(canp != NULL);
+
+  osalSysLock();
+  osalDbgAssert(canp->state == CAN_READY, "invalid state");
+  canp->rec_limit   = limit;
+  canp->rec_window  = window;
+  canp->rec_start   = osalOsGetSystemTimeX();
+  canp->rec_count   = 0U;
+  canp->rec_enabled = true;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Disables the automatic bus-off recovery engine.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @api
+ */
+void canDisableAutoRecovery(CANDriver *canp) {
+
+  osalDbgCheck(canp != NULL);
+
+  osalSysLock();
+  canp->rec_enabled = false;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Returns a snapshot of the error statistics.
+ * @details The counters are copied atomically into the provided buffer
+ *          and then cleared, successive calls return per-interval
+ *          figures.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[out] csp      pointer to the buffer where the statistics are
+ *                      copied
+ *
+ * @api
+ */
+void canGetAndClearStats(CANDriver *canp, can_stats_t *csp) {
+
+  osalDbgCheck((canp != NULL) && (csp != NULL));
+
+  osalSysLock();
+  *csp = canp->stats;
+  canp->stats.error_frames = 0U;
+  canp->stats.arb_losses   = 0U;
+  canp->stats.overruns     = 0U;
+  canp->stats.warnings     = 0U;
+  canp->stats.passives     = 0U;
+  canp->stats.bus_offs     = 0U;
+  canp->stats.recoveries   = 0U;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Accounts an error event and advances the recovery engine.
+ * @note    Not an API, this function is invoked by the error ISR macros
+ *          within the system critical zone.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] flags     error flags
+ *
+ * @notapi
+ */
+void _can_monitor_error(CANDriver *canp, eventflags_t flags) {
+
+  if ((flags & CAN_FRAMING_ERROR) != 0U) {
+    canp->stats.error_frames++;
+  }
+  if ((flags & CAN_OVERFLOW_ERROR) != 0U) {
+    canp->stats.overruns++;
+  }
+  if ((flags & CAN_LIMIT_WARNING) != 0U) {
+    canp->stats.warnings++;
+  }
+  if ((flags & CAN_LIMIT_ERROR) != 0U) {
+    canp->stats.passives++;
+  }
+  if ((flags & CAN_BUS_OFF_ERROR) != 0U) {
+    canp->stats.bus_offs++;
+
+    if (canp->rec_enabled && (canp->state == CAN_READY)) {
+      if (canp->rec_limit > 0U) {
+        systime_t now = osalOsGetSystemTimeX();
+
+        /* A new observation window is started when the previous one has
+           expired.*/
+        if (osalTimeDiffX(canp->rec_start, now) >= canp->rec_window) {
+          canp->rec_start = now;
+          canp->rec_count = 0U;
+        }
+
+        /* Policy exhausted, the driver is left in the bus-off state.*/
+        if (canp->rec_count >= canp->rec_limit) {
+          return;
+        }
+        canp->rec_count++;
+      }
+
+      /* The recovery delay is enforced by the protocol itself, the node
+         rejoins the bus only after 128 occurrences of 11 consecutive
+         recessive bits.*/
+      canp->stats.recoveries++;
+      can_lld_recover(canp);
+    }
+  }
+}
+#endif /* CAN_USE_ERROR_MONITOR == TRUE */
+
 /**
  * @brief   Can frame receive attempt.
  * @details The function tries to fetch a frame from a mailbox.
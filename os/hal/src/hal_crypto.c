@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_CRY == TRUE) || defined(__DOXYGEN__)
@@ -42,6 +44,23 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Advances a 128 bits CTR input vector by a number of blocks.
+ *
+ * @param[in,out] ctr   128 bits input vector + counter
+ * @param[in] blocks    number of processed blocks to be added to the
+ *                      32 bits counter
+ */
+static void cry_ctr_advance(uint8_t *ctr, uint32_t blocks) {
+  unsigned i;
+
+  for (i = 15U; i >= 12U; i--) {
+    blocks  += (uint32_t)ctr[i];
+    ctr[i]   = (uint8_t)blocks;
+    blocks >>= 8;
+  }
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -685,6 +704,237 @@ cryerror_t cryDecryptAES_CTR(CRYDriver *cryp,
 #endif
 }
 
+/**
+ * @brief   Encryption operation using AES-CBC on non-contiguous buffers.
+ * @details The message is described by an array of scatter/gather segments,
+ *          the operation is chained across the segments so the result is
+ *          identical to a single operation on a contiguous buffer. No
+ *          assembly copy of chained network buffers is required, in-place
+ *          operation is possible.
+ * @note    Each segment length must be a non-zero multiple of an AES block,
+ *          this means that padding must be done by the caller.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] n                 number of segments in the array
+ * @param[in] sges              array of scatter/gather segments containing
+ *                              the input plaintext and receiving the output
+ *                              cyphertext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @api
+ */
+cryerror_t cryEncryptAES_CBC_SG(CRYDriver *cryp,
+                                crykey_t key_id,
+                                size_t n,
+                                const cry_sge_t *sges,
+                                const uint8_t *iv) {
+  const uint8_t *ivp = iv;
+  size_t i;
+
+  osalDbgCheck((sges != NULL) && (n > (size_t)0));
+
+  for (i = (size_t)0; i < n; i++) {
+    cryerror_t err;
+
+    err = cryEncryptAES_CBC(cryp, key_id, sges[i].size,
+                            sges[i].in, sges[i].out, ivp);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+
+    /* The last cyphertext block becomes the IV of the next segment.*/
+    ivp = &sges[i].out[sges[i].size - (size_t)16];
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-CBC on non-contiguous buffers.
+ * @details The message is described by an array of scatter/gather segments,
+ *          the operation is chained across the segments so the result is
+ *          identical to a single operation on a contiguous buffer. No
+ *          assembly copy of chained network buffers is required, in-place
+ *          operation is possible.
+ * @note    Each segment length must be a non-zero multiple of an AES block,
+ *          this means that padding must be done by the caller.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] n                 number of segments in the array
+ * @param[in] sges              array of scatter/gather segments containing
+ *                              the input cyphertext and receiving the output
+ *                              plaintext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @api
+ */
+cryerror_t cryDecryptAES_CBC_SG(CRYDriver *cryp,
+                                crykey_t key_id,
+                                size_t n,
+                                const cry_sge_t *sges,
+                                const uint8_t *iv) {
+  uint8_t ivbuf[2][16];
+  const uint8_t *ivp = iv;
+  unsigned idx = 0U;
+  size_t i;
+
+  osalDbgCheck((sges != NULL) && (n > (size_t)0));
+
+  for (i = (size_t)0; i < n; i++) {
+    cryerror_t err;
+
+    /* The last cyphertext block is the IV of the next segment, it must
+       be saved before the operation because of possible in-place
+       decryption.*/
+    memcpy(ivbuf[idx], &sges[i].in[sges[i].size - (size_t)16], 16U);
+
+    err = cryDecryptAES_CBC(cryp, key_id, sges[i].size,
+                            sges[i].in, sges[i].out, ivp);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+
+    ivp  = ivbuf[idx];
+    idx ^= 1U;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Encryption operation using AES-CTR on non-contiguous buffers.
+ * @details The message is described by an array of scatter/gather segments,
+ *          the counter is advanced across the segments so the result is
+ *          identical to a single operation on a contiguous buffer. No
+ *          assembly copy of chained network buffers is required, in-place
+ *          operation is possible.
+ * @note    Each segment length must be a non-zero multiple of an AES block,
+ *          this means that padding must be done by the caller.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] n                 number of segments in the array
+ * @param[in] sges              array of scatter/gather segments containing
+ *                              the input plaintext and receiving the output
+ *                              cyphertext
+ * @param[in] iv                128 bits input vector + counter, it contains
+ *                              a 96 bits IV and a 32 bits counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @api
+ */
+cryerror_t cryEncryptAES_CTR_SG(CRYDriver *cryp,
+                                crykey_t key_id,
+                                size_t n,
+                                const cry_sge_t *sges,
+                                const uint8_t *iv) {
+  uint8_t ctr[16];
+  size_t i;
+
+  osalDbgCheck((sges != NULL) && (n > (size_t)0) && (iv != NULL));
+
+  memcpy(ctr, iv, 16U);
+
+  for (i = (size_t)0; i < n; i++) {
+    cryerror_t err;
+
+    err = cryEncryptAES_CTR(cryp, key_id, sges[i].size,
+                            sges[i].in, sges[i].out, ctr);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+
+    cry_ctr_advance(ctr, (uint32_t)(sges[i].size / (size_t)16));
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-CTR on non-contiguous buffers.
+ * @details The message is described by an array of scatter/gather segments,
+ *          the counter is advanced across the segments so the result is
+ *          identical to a single operation on a contiguous buffer. No
+ *          assembly copy of chained network buffers is required, in-place
+ *          operation is possible.
+ * @note    Each segment length must be a non-zero multiple of an AES block,
+ *          this means that padding must be done by the caller.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] n                 number of segments in the array
+ * @param[in] sges              array of scatter/gather segments containing
+ *                              the input cyphertext and receiving the output
+ *                              plaintext
+ * @param[in] iv                128 bits input vector + counter, it contains
+ *                              a 96 bits IV and a 32 bits counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @api
+ */
+cryerror_t cryDecryptAES_CTR_SG(CRYDriver *cryp,
+                                crykey_t key_id,
+                                size_t n,
+                                const cry_sge_t *sges,
+                                const uint8_t *iv) {
+  uint8_t ctr[16];
+  size_t i;
+
+  osalDbgCheck((sges != NULL) && (n > (size_t)0) && (iv != NULL));
+
+  memcpy(ctr, iv, 16U);
+
+  for (i = (size_t)0; i < n; i++) {
+    cryerror_t err;
+
+    err = cryDecryptAES_CTR(cryp, key_id, sges[i].size,
+                            sges[i].in, sges[i].out, ctr);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+
+    cry_ctr_advance(ctr, (uint32_t)(sges[i].size / (size_t)16));
+  }
+
+  return CRY_NOERROR;
+}
+
 /**
  * @brief   Encryption operation using AES-GCM.
  * @note    The function operates on data buffers whose length is a multiple
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_DAC == TRUE) || defined(__DOXYGEN__)
@@ -69,6 +71,9 @@ void dacObjectInit(DACDriver *dacp) {
 
   dacp->state = DAC_STOP;
   dacp->config = NULL;
+#if DAC_USE_STREAMING
+  dacp->sb_active = false;
+#endif
 #if DAC_USE_WAIT
   dacp->thread = NULL;
 #endif
@@ -234,6 +239,7 @@ void dacStopConversion(DACDriver *dacp) {
 
   if (dacp->state != DAC_READY) {
     dac_lld_stop_conversion(dacp);
+    _dac_stream_deactivate(dacp);
     dacp->grpp  = NULL;
     dacp->state = DAC_READY;
     _dac_reset_s(dacp);
@@ -263,6 +269,7 @@ void dacStopConversionI(DACDriver *dacp) {
 
   if (dacp->state != DAC_READY) {
     dac_lld_stop_conversion(dacp);
+    _dac_stream_deactivate(dacp);
     dacp->grpp  = NULL;
     dacp->state = DAC_READY;
     _dac_reset_i(dacp);
@@ -309,6 +316,207 @@ msg_t dacConvert(DACDriver *dacp,
 }
 #endif /* DAC_USE_WAIT == TRUE */
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a streaming conversion.
+ * @details The conversion buffer is operated circularly and refilled by
+ *          the driver from the chain of buffers posted with
+ *          @p dacStreamPost(), the output is gapless across chained
+ *          buffers. When the chain runs empty the idle sample is inserted
+ *          on all channels and the underrun callback, if defined, is
+ *          invoked, the streaming operation keeps running and resumes
+ *          from the chain as soon as new buffers are posted.
+ * @pre     The configuration option @p DAC_USE_STREAMING must be enabled
+ *          in order to use this function.
+ * @note    In streaming mode the @p end_cb callback of the conversion
+ *          group is not invoked, notifications happen per chained buffer
+ *          through the @p scb callback.
+ * @note    The callbacks are invoked from ISR context within a critical
+ *          zone, only I-class functions are allowed.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] grpp      pointer to a @p DACConversionGroup object
+ * @param[in] samples   pointer to the circular conversion buffer
+ * @param[in] depth     conversion buffer depth (matrix rows number), must
+ *                      be an even number greater than one
+ * @param[in] idle      sample inserted on all channels during an underrun
+ * @param[in] scb       buffer consumed callback, can be @p NULL
+ * @param[in] ucb       underrun callback, can be @p NULL
+ *
+ * @api
+ */
+void dacStartStreaming(DACDriver *dacp, const DACConversionGroup *grpp,
+                       dacsample_t *samples, size_t depth,
+                       dacsample_t idle,
+                       dacstreamcallback_t scb, dacstreamcallback_t ucb) {
+
+  osalSysLock();
+  dacStartStreamingI(dacp, grpp, samples, depth, idle, scb, ucb);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts a streaming conversion.
+ * @details See @p dacStartStreaming() for the streaming operation details.
+ * @pre     The configuration option @p DAC_USE_STREAMING must be enabled
+ *          in order to use this function.
+ * @post    The conversion buffer is entirely filled with the idle sample,
+ *          the output starts from the chain content only after the first
+ *          buffers are posted.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] grpp      pointer to a @p DACConversionGroup object
+ * @param[in] samples   pointer to the circular conversion buffer
+ * @param[in] depth     conversion buffer depth (matrix rows number), must
+ *                      be an even number greater than one
+ * @param[in] idle      sample inserted on all channels during an underrun
+ * @param[in] scb       buffer consumed callback, can be @p NULL
+ * @param[in] ucb       underrun callback, can be @p NULL
+ *
+ * @iclass
+ */
+void dacStartStreamingI(DACDriver *dacp, const DACConversionGroup *grpp,
+                        dacsample_t *samples, size_t depth,
+                        dacsample_t idle,
+                        dacstreamcallback_t scb, dacstreamcallback_t ucb) {
+  size_t i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((dacp != NULL) && (grpp != NULL) && (samples != NULL) &&
+               (depth > 1) && ((depth & 1) == 0));
+
+  /* The buffer starts as idle output, the chain is initially empty.*/
+  for (i = 0; i < (depth * (size_t)grpp->num_channels); i++) {
+    samples[i] = idle;
+  }
+
+  dacp->sb_head      = NULL;
+  dacp->sb_tail      = NULL;
+  dacp->sb_offset    = 0U;
+  dacp->sb_idle      = idle;
+  dacp->sb_cb        = scb;
+  dacp->sb_ucb       = ucb;
+  dacp->sb_underruns = 0U;
+  dacp->sb_active    = true;
+
+  dacStartConversionI(dacp, grpp, samples, depth);
+}
+
+/**
+ * @brief   Appends a buffer to the streaming chain.
+ * @details The buffer is output after the already chained ones with no
+ *          gaps, the descriptor and the samples must remain valid and
+ *          constant until the consumed callback reports the descriptor
+ *          back.
+ * @pre     A streaming operation must be in progress.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] sbp       pointer to the buffer descriptor to be appended
+ *
+ * @api
+ */
+void dacStreamPost(DACDriver *dacp, dacstreambuf_t *sbp) {
+
+  osalSysLock();
+  dacStreamPostI(dacp, sbp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Appends a buffer to the streaming chain.
+ * @details See @p dacStreamPost().
+ * @pre     A streaming operation must be in progress.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] sbp       pointer to the buffer descriptor to be appended
+ *
+ * @iclass
+ */
+void dacStreamPostI(DACDriver *dacp, dacstreambuf_t *sbp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((dacp != NULL) && (sbp != NULL) &&
+               (sbp->buffer != NULL) && (sbp->depth > 0U));
+  osalDbgAssert(dacp->sb_active, "not streaming");
+
+  sbp->next = NULL;
+  if (dacp->sb_tail == NULL) {
+    dacp->sb_head = sbp;
+  }
+  else {
+    dacp->sb_tail->next = sbp;
+  }
+  dacp->sb_tail = sbp;
+}
+
+/**
+ * @brief   Refills a released half of the conversion buffer.
+ * @details The half is filled from the streaming chain, fully consumed
+ *          descriptors are unlinked and reported through the consumed
+ *          callback. If the chain is exhausted then the remainder is
+ *          filled with the idle sample, the event is accounted in the
+ *          underruns counter and reported through the underrun callback.
+ * @note    This function is meant to be invoked by the half and full
+ *          buffer ISR macros only.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[out] buffer   pointer to the released half buffer
+ * @param[in] n         size of the released half in sample rows
+ *
+ * @notapi
+ */
+void _dac_stream_refill(DACDriver *dacp, dacsample_t *buffer, size_t n) {
+  size_t nch = (size_t)dacp->grpp->num_channels;
+
+  osalSysLockFromISR();
+
+  while (n > 0U) {
+    dacstreambuf_t *sbp = dacp->sb_head;
+    size_t rows;
+
+    if (sbp == NULL) {
+      size_t i;
+
+      /* Underrun, the rest of the half is filled with the idle sample.*/
+      dacp->sb_underruns++;
+      if (dacp->sb_ucb != NULL) {
+        dacp->sb_ucb(dacp, NULL);
+      }
+      for (i = 0; i < (n * nch); i++) {
+        buffer[i] = dacp->sb_idle;
+      }
+      break;
+    }
+
+    /* Copying from the head buffer as many rows as available and
+       needed.*/
+    rows = sbp->depth - dacp->sb_offset;
+    if (rows > n) {
+      rows = n;
+    }
+    memcpy(buffer, sbp->buffer + (dacp->sb_offset * nch),
+           rows * nch * sizeof (dacsample_t));
+    buffer += rows * nch;
+    dacp->sb_offset += rows;
+    n -= rows;
+
+    /* Fully consumed buffers are unlinked and reported back.*/
+    if (dacp->sb_offset >= sbp->depth) {
+      dacp->sb_head = sbp->next;
+      if (dacp->sb_head == NULL) {
+        dacp->sb_tail = NULL;
+      }
+      dacp->sb_offset = 0U;
+      if (dacp->sb_cb != NULL) {
+        dacp->sb_cb(dacp, sbp);
+      }
+    }
+  }
+
+  osalSysUnlockFromISR();
+}
+#endif /* DAC_USE_STREAMING == TRUE */
+
 #if (DAC_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Gains exclusive access to the DAC bus.
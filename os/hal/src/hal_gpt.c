@@ -69,6 +69,9 @@ void gptObjectInit(GPTDriver *gptp) {
 
   gptp->state  = GPT_STOP;
   gptp->config = NULL;
+#if GPT_USE_COUNTER64 == TRUE
+  gptp->wraps  = 0;
+#endif
 }
 
 /**
@@ -167,6 +170,9 @@ void gptStartContinuousI(GPTDriver *gptp, gptcnt_t interval) {
   osalDbgAssert(gptp->state == GPT_READY,
                 "invalid state");
 
+#if GPT_USE_COUNTER64 == TRUE
+  gptp->wraps = 0;
+#endif
   gptp->state = GPT_CONTINUOUS;
   gpt_lld_start_timer(gptp, interval);
 }
@@ -69,6 +69,9 @@ void i2sObjectInit(I2SDriver *i2sp) {
 
   i2sp->state  = I2S_STOP;
   i2sp->config = NULL;
+#if I2S_USE_TIMESTAMP == TRUE
+  i2sp->timestamp = (systime_t)0;
+#endif
 }
 
 /**
@@ -184,6 +184,73 @@ void icuStopCapture(ICUDriver *icup) {
   osalSysUnlock();
 }
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a buffered capture.
+ * @details The captured period values are transferred into the ring
+ *          buffer by the low level driver with no per-capture interrupt,
+ *          the callback is invoked once per half ring with the batch of
+ *          fresh values. The interrupt rate is reduced by half the ring
+ *          depth with respect to the notification mode while every
+ *          captured edge is preserved.
+ * @pre     The configuration option @p ICU_USE_BUFFERED_CAPTURE must be
+ *          enabled in order to use this function.
+ * @note    The callback is invoked in ISR context.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[out] buffer   pointer to the capture ring buffer
+ * @param[in] depth     number of entries in the ring, must be an even
+ *                      number greater than one
+ * @param[in] cb        half ring callback
+ *
+ * @api
+ */
+void icuStartBufferedCapture(ICUDriver *icup, icucnt_t *buffer,
+                             size_t depth, icubufcallback_t cb) {
+
+  osalDbgCheck((icup != NULL) && (buffer != NULL) && (cb != NULL) &&
+               (depth > 1U) && ((depth & 1U) == 0U));
+
+  osalSysLock();
+
+  osalDbgAssert(icup->state == ICU_READY, "invalid state");
+
+  icup->buffer = buffer;
+  icup->depth  = depth;
+  icup->buf_cb = cb;
+  icu_lld_start_buffered_capture(icup);
+  icup->state = ICU_ACTIVE;
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops a buffered capture.
+ * @pre     The configuration option @p ICU_USE_BUFFERED_CAPTURE must be
+ *          enabled in order to use this function.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ *
+ * @api
+ */
+void icuStopBufferedCapture(ICUDriver *icup) {
+
+  osalDbgCheck(icup != NULL);
+
+  osalSysLock();
+
+  osalDbgAssert((icup->state == ICU_READY) || (icup->state == ICU_ACTIVE),
+                "invalid state");
+
+  if (icup->state == ICU_ACTIVE) {
+    icu_lld_stop_buffered_capture(icup);
+    icup->state = ICU_READY;
+  }
+
+  osalSysUnlock();
+}
+#endif /* ICU_USE_BUFFERED_CAPTURE == TRUE */
+
 /**
  * @brief   Enables notifications.
  * @pre     The ICU unit must have been activated using @p icuStart() and the
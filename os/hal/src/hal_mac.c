@@ -34,14 +34,38 @@
 #error "MAC_USE_ZERO_COPY not supported by this implementation"
 #endif
 
+#if (MAC_USE_RX_MITIGATION == TRUE) && (MAC_SUPPORTS_RX_MITIGATION == FALSE)
+#error "MAC_USE_RX_MITIGATION not supported by this implementation"
+#endif
+
+#if (MAC_USE_TX_GATHER == TRUE) && (MAC_SUPPORTS_TX_GATHER == FALSE)
+#error "MAC_USE_TX_GATHER not supported by this implementation"
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
 
+#if (MAC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Global MAC statistics counters.
+ * @note    The counters are also updated by the network bindings, use
+ *          @p macGetStats() in order to take a consistent snapshot.
+ */
+mac_stats_t mac_stats;
+#endif
+
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (MAC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Frames drained since the receive ring was last found empty.
+ */
+static uint32_t mac_rx_batch;
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -157,6 +181,7 @@ msg_t macWaitTransmitDescriptor(MACDriver *macp,
 
   while (((msg = mac_lld_get_transmit_descriptor(macp, tdp)) != MSG_OK) &&
          (timeout > (sysinterval_t)0)) {
+    macStatsIncrement(tx_desc_unavail);
     osalSysLock();
     msg = osalThreadEnqueueTimeoutS(&macp->tdqueue, timeout);
     if (msg == MSG_TIMEOUT) {
@@ -181,7 +206,66 @@ void macReleaseTransmitDescriptor(MACTransmitDescriptor *tdp) {
   osalDbgCheck(tdp != NULL);
 
   mac_lld_release_transmit_descriptor(tdp);
+  macStatsIncrement(tx_frames);
+}
+
+#if (MAC_USE_TX_GATHER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Transmits a frame composed of multiple segments.
+ * @details The segments are attached to a chain of transmit descriptors
+ *          and transmitted in place as a single frame, no assembly copy
+ *          is performed. If enough descriptors are not currently available
+ *          then the invoking thread is queued until they are freed.
+ * @post    On success the frame is owned by the DMA engine, the segments
+ *          must remain valid and unmodified until
+ *          @p macIsFrameTransmitted() returns true for the returned
+ *          descriptor.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tdp      pointer to a @p MACTransmitDescriptor structure
+ * @param[in] segs      frame segments array
+ * @param[in] n         number of segments, the maximum is defined by the
+ *                      low level driver
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       the frame has been queued for transmission.
+ * @retval MSG_TIMEOUT  the operation timed out, frame not transmitted.
+ *
+ * @api
+ */
+msg_t macWaitTransmitGather(MACDriver *macp,
+                            MACTransmitDescriptor *tdp,
+                            const macsegment_t segs[],
+                            size_t n,
+                            sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((macp != NULL) && (tdp != NULL) && (segs != NULL) && (n > 0U));
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  while (((msg = mac_lld_transmit_gather(macp, tdp, segs, n)) != MSG_OK) &&
+         (timeout > (sysinterval_t)0)) {
+    macStatsIncrement(tx_desc_unavail);
+    osalSysLock();
+    msg = osalThreadEnqueueTimeoutS(&macp->tdqueue, timeout);
+    if (msg == MSG_TIMEOUT) {
+      osalSysUnlock();
+      break;
+    }
+    osalSysUnlock();
+  }
+#if MAC_USE_STATS == TRUE
+  if (msg == MSG_OK) {
+    macStatsIncrement(tx_frames);
+  }
+#endif
+  return msg;
 }
+#endif /* MAC_USE_TX_GATHER == TRUE */
 
 /**
  * @brief   Waits for a received frame.
@@ -211,7 +295,23 @@ msg_t macWaitReceiveDescriptor(MACDriver *macp,
   osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
 
   while (((msg = mac_lld_get_receive_descriptor(macp, rdp)) != MSG_OK)) {
+#if MAC_USE_STATS == TRUE
+    /* The ring has been found empty, the current drain batch is closed.*/
+    if (mac_rx_batch > 0U) {
+      mac_stats.rx_wakeups++;
+      if (mac_rx_batch > mac_stats.rx_batch_max) {
+        mac_stats.rx_batch_max = mac_rx_batch;
+      }
+      mac_rx_batch = 0U;
+    }
+#endif
     osalSysLock();
+#if MAC_USE_RX_MITIGATION == TRUE
+    /* The ring is empty, the receive interrupt masked by the ISR can be
+       re-enabled. A frame received after the empty check leaves the
+       interrupt pending so the wakeup is not lost.*/
+    mac_lld_rx_irq_enable(macp);
+#endif
     msg = osalThreadEnqueueTimeoutS(&macp->rdqueue, timeout);
     if (msg == MSG_TIMEOUT) {
       osalSysUnlock();
@@ -219,6 +319,12 @@ msg_t macWaitReceiveDescriptor(MACDriver *macp,
     }
     osalSysUnlock();
   }
+#if MAC_USE_STATS == TRUE
+  if (msg == MSG_OK) {
+    mac_stats.rx_frames++;
+    mac_rx_batch++;
+  }
+#endif
   return msg;
 }
 
@@ -256,6 +362,38 @@ bool macPollLinkStatus(MACDriver *macp) {
   return mac_lld_poll_link_status(macp);
 }
 
+#if (MAC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Takes a snapshot of the statistics counters.
+ *
+ * @param[out] msp      pointer to the @p mac_stats_t structure receiving
+ *                      the snapshot
+ *
+ * @api
+ */
+void macGetStats(mac_stats_t *msp) {
+
+  osalDbgCheck(msp != NULL);
+
+  osalSysLock();
+  *msp = mac_stats;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Resets the statistics counters.
+ *
+ * @api
+ */
+void macResetStats(void) {
+  static const mac_stats_t zero_stats;
+
+  osalSysLock();
+  mac_stats = zero_stats;
+  osalSysUnlock();
+}
+#endif /* MAC_USE_STATS == TRUE */
+
 #endif /* HAL_USE_MAC == TRUE */
 
 /** @} */
@@ -157,26 +157,32 @@ static uint8_t crc7(uint8_t crc, const uint8_t *buffer, size_t len) {
 
 /**
  * @brief   Waits an idle condition.
+ * @note    The busy polling is performed in multi-byte bursts, each
+ *          @p spiReceive() costs a whole DMA transaction regardless of
+ *          its size so larger reads waste less CPU time. Extra bytes
+ *          clocked after the busy condition has ended are idle clocks,
+ *          the card ignores them.
  *
  * @param[in] mmcp      pointer to the @p MMCDriver object
  *
  * @notapi
  */
 static void wait(MMCDriver *mmcp) {
-  int i;
-  uint8_t buf[4];
+  unsigned i;
+  uint8_t buf[16];
 
-  for (i = 0; i < 16; i++) {
-    spiReceive(mmcp->config->spip, 1, buf);
-    if (buf[0] == 0xFFU) {
-      return;
-    }
+  /* Quick check for the common case of an already idle bus.*/
+  spiReceive(mmcp->config->spip, 1, buf);
+  if (buf[0] == 0xFFU) {
+    return;
   }
   /* Looks like it is a long wait.*/
   while (true) {
-    spiReceive(mmcp->config->spip, 1, buf);
-    if (buf[0] == 0xFFU) {
-      break;
+    spiReceive(mmcp->config->spip, sizeof buf, buf);
+    for (i = 0; i < sizeof buf; i++) {
+      if (buf[i] == 0xFFU) {
+        return;
+      }
     }
 #if MMC_NICE_WAITING == TRUE
     /* Trying to be nice with the other threads.*/
@@ -353,19 +359,9 @@ static bool read_CxD(MMCDriver *mmcp, uint8_t cmd, uint32_t cxd[4]) {
  * @notapi
  */
 static void sync(MMCDriver *mmcp) {
-  uint8_t buf[1];
 
   spiSelect(mmcp->config->spip);
-  while (true) {
-    spiReceive(mmcp->config->spip, 1, buf);
-    if (buf[0] == 0xFFU) {
-      break;
-    }
-#if MMC_NICE_WAITING == TRUE
-    /* Trying to be nice with the other threads.*/
-    osalThreadSleepMilliseconds(1);
-#endif
-  }
+  wait(mmcp);
   spiUnselect(mmcp->config->spip);
 }
 
@@ -759,7 +755,7 @@ bool mmcStartSequentialWrite(MMCDriver *mmcp, uint32_t startblk) {
  */
 bool mmcSequentialWrite(MMCDriver *mmcp, const uint8_t *buffer) {
   static const uint8_t start[] = {0xFF, 0xFC};
-  uint8_t b[1];
+  uint8_t b[3];
 
   osalDbgCheck((mmcp != NULL) && (buffer != NULL));
 
@@ -769,9 +765,10 @@ bool mmcSequentialWrite(MMCDriver *mmcp, const uint8_t *buffer) {
 
   spiSend(mmcp->config->spip, sizeof(start), start);    /* Data prologue.   */
   spiSend(mmcp->config->spip, MMCSD_BLOCK_SIZE, buffer);/* Data.            */
-  spiIgnore(mmcp->config->spip, 2);                     /* CRC ignored.     */
-  spiReceive(mmcp->config->spip, 1, b);
-  if ((b[0] & 0x1FU) == 0x05U) {
+  /* The two dummy CRC bytes and the data response token are clocked with
+     a single transfer, the CRC positions are don't care.*/
+  spiReceive(mmcp->config->spip, 3, b);
+  if ((b[2] & 0x1FU) == 0x05U) {
     wait(mmcp);
     return HAL_SUCCESS;
   }
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_MMC_SPI == TRUE) || (HAL_USE_SDC == TRUE) || defined(__DOXYGEN__)
@@ -326,6 +328,240 @@ void _mmcsd_unpack_csd_v20(const MMCSDBlockDevice *sdcp,
   csd20->write_blk_misalign  = (uint8_t) _mmcsd_get_slice(csd, MMCSD_CSD_20_WRITE_BLK_MISALIGN_SLICE);
 }
 
+/**
+ * @brief   Initializes a @p MMCSDStream object.
+ *
+ * @param[out] msp      pointer to the @p MMCSDStream object
+ * @param[in] blkp      pointer to the block device backing the stream
+ *
+ * @init
+ */
+void mmcsdStreamObjectInit(MMCSDStream *msp, BaseBlockDevice *blkp) {
+
+  osalDbgCheck((msp != NULL) && (blkp != NULL));
+
+  msp->state    = MMCSD_STREAM_IDLE;
+  msp->blkp     = blkp;
+  msp->startblk = 0U;
+  msp->offset   = 0U;
+}
+
+/**
+ * @brief   Opens a stream for sequential reading.
+ * @details Data is then pulled using @p mmcsdStreamRead(), consecutive
+ *          calls return consecutive bytes of the device regardless of
+ *          block boundaries, whole spanned blocks are fetched in single
+ *          multi-block transfers.
+ * @pre     The stream must be in the @p MMCSD_STREAM_IDLE state.
+ *
+ * @param[in] msp       pointer to the @p MMCSDStream object
+ * @param[in] startblk  first block of the stream
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool mmcsdStreamOpenRead(MMCSDStream *msp, uint32_t startblk) {
+
+  osalDbgCheck(msp != NULL);
+  osalDbgAssert(msp->state == MMCSD_STREAM_IDLE, "invalid state");
+
+  msp->state    = MMCSD_STREAM_READING;
+  msp->startblk = startblk;
+  msp->offset   = 0U;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Opens a stream for sequential writing.
+ * @details Data is then pushed using @p mmcsdStreamWrite(), consecutive
+ *          calls write consecutive bytes of the device regardless of
+ *          block boundaries, whole spanned blocks are written in single
+ *          multi-block transfers.
+ * @pre     The stream must be in the @p MMCSD_STREAM_IDLE state.
+ *
+ * @param[in] msp       pointer to the @p MMCSDStream object
+ * @param[in] startblk  first block of the stream
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool mmcsdStreamOpenWrite(MMCSDStream *msp, uint32_t startblk) {
+
+  osalDbgCheck(msp != NULL);
+  osalDbgAssert(msp->state == MMCSD_STREAM_IDLE, "invalid state");
+
+  msp->state    = MMCSD_STREAM_WRITING;
+  msp->startblk = startblk;
+  msp->offset   = 0U;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Reads data from a stream.
+ * @details Any number of bytes can be requested, leading and trailing
+ *          partial blocks are staged internally, the fully spanned
+ *          blocks are read directly into the user buffer with a single
+ *          multi-block transfer.
+ * @pre     The stream must have been opened with @p mmcsdStreamOpenRead().
+ *
+ * @param[in] msp       pointer to the @p MMCSDStream object
+ * @param[out] buf      pointer to the read buffer
+ * @param[in] n         number of bytes to read
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool mmcsdStreamRead(MMCSDStream *msp, uint8_t *buf, size_t n) {
+
+  osalDbgCheck((msp != NULL) && (buf != NULL));
+  osalDbgAssert(msp->state == MMCSD_STREAM_READING, "invalid state");
+
+  while (n > 0U) {
+    if (msp->offset > 0U) {
+      /* Data staged from a previously read block.*/
+      size_t chunk = (size_t)MMCSD_BLOCK_SIZE - (size_t)msp->offset;
+
+      if (chunk > n) {
+        chunk = n;
+      }
+      memcpy(buf, &msp->buffer[msp->offset], chunk);
+      msp->offset = (msp->offset + (uint32_t)chunk) % MMCSD_BLOCK_SIZE;
+      buf += chunk;
+      n   -= chunk;
+    }
+    else if (n >= (size_t)MMCSD_BLOCK_SIZE) {
+      /* Whole blocks are transferred directly in a single operation.*/
+      uint32_t nblk = (uint32_t)(n / (size_t)MMCSD_BLOCK_SIZE);
+
+      if (blkRead(msp->blkp, msp->startblk, buf, nblk) == HAL_FAILED) {
+        return HAL_FAILED;
+      }
+      msp->startblk += nblk;
+      buf += (size_t)nblk * (size_t)MMCSD_BLOCK_SIZE;
+      n   -= (size_t)nblk * (size_t)MMCSD_BLOCK_SIZE;
+    }
+    else {
+      /* Trailing partial block, staged for the next call.*/
+      if (blkRead(msp->blkp, msp->startblk, msp->buffer, 1U) == HAL_FAILED) {
+        return HAL_FAILED;
+      }
+      msp->startblk++;
+      memcpy(buf, msp->buffer, n);
+      msp->offset = (uint32_t)n;
+      n = 0U;
+    }
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes data to a stream.
+ * @details Any number of bytes can be pushed, partial blocks are staged
+ *          internally and flushed when completed by subsequent calls or
+ *          by @p mmcsdStreamClose(), the fully spanned blocks are
+ *          written from the user buffer with a single multi-block
+ *          transfer.
+ * @pre     The stream must have been opened with @p mmcsdStreamOpenWrite().
+ *
+ * @param[in] msp       pointer to the @p MMCSDStream object
+ * @param[in] buf       pointer to the write buffer
+ * @param[in] n         number of bytes to write
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool mmcsdStreamWrite(MMCSDStream *msp, const uint8_t *buf, size_t n) {
+
+  osalDbgCheck((msp != NULL) && (buf != NULL));
+  osalDbgAssert(msp->state == MMCSD_STREAM_WRITING, "invalid state");
+
+  while (n > 0U) {
+    if ((msp->offset > 0U) || (n < (size_t)MMCSD_BLOCK_SIZE)) {
+      /* Completing or starting a staged partial block.*/
+      size_t chunk = (size_t)MMCSD_BLOCK_SIZE - (size_t)msp->offset;
+
+      if (chunk > n) {
+        chunk = n;
+      }
+      memcpy(&msp->buffer[msp->offset], buf, chunk);
+      msp->offset += (uint32_t)chunk;
+      buf += chunk;
+      n   -= chunk;
+
+      if (msp->offset == MMCSD_BLOCK_SIZE) {
+        if (blkWrite(msp->blkp, msp->startblk, msp->buffer, 1U) == HAL_FAILED) {
+          return HAL_FAILED;
+        }
+        msp->startblk++;
+        msp->offset = 0U;
+      }
+    }
+    else {
+      /* Whole blocks are transferred directly in a single operation.*/
+      uint32_t nblk = (uint32_t)(n / (size_t)MMCSD_BLOCK_SIZE);
+
+      if (blkWrite(msp->blkp, msp->startblk, buf, nblk) == HAL_FAILED) {
+        return HAL_FAILED;
+      }
+      msp->startblk += nblk;
+      buf += (size_t)nblk * (size_t)MMCSD_BLOCK_SIZE;
+      n   -= (size_t)nblk * (size_t)MMCSD_BLOCK_SIZE;
+    }
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Closes a stream.
+ * @details If the stream is open for writing and a partial block is
+ *          staged then the block is completed with @p 0xFF filler
+ *          bytes and written before closing.
+ * @post    The stream returns to the @p MMCSD_STREAM_IDLE state, also
+ *          on failure.
+ *
+ * @param[in] msp       pointer to the @p MMCSDStream object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool mmcsdStreamClose(MMCSDStream *msp) {
+  bool status = HAL_SUCCESS;
+
+  osalDbgCheck(msp != NULL);
+  osalDbgAssert(msp->state != MMCSD_STREAM_IDLE, "invalid state");
+
+  if ((msp->state == MMCSD_STREAM_WRITING) && (msp->offset > 0U)) {
+    memset(&msp->buffer[msp->offset],
+           0xFF,
+           (size_t)MMCSD_BLOCK_SIZE - (size_t)msp->offset);
+    status = blkWrite(msp->blkp, msp->startblk, msp->buffer, 1U);
+  }
+
+  msp->state  = MMCSD_STREAM_IDLE;
+  msp->offset = 0U;
+
+  return status;
+}
+
 #endif /* (HAL_USE_MMC_SPI == TRUE) || (HAL_USE_SDC == TRUE) */
 
 /** @} */
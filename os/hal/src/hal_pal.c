@@ -38,6 +38,13 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (PAL_USE_GROUP_EVENTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Registered group events, free records have a @p NULL callback.
+ */
+static palgroupevent_t _pal_groups[PAL_GROUP_EVENTS_MAX];
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -94,6 +101,42 @@ void palWriteBus(const IOBus *bus, ioportmask_t bits) {
   palWriteGroup(bus->portid, bus->mask, bus->offset, bits);
 }
 
+/**
+ * @brief   Strobed burst write to an I/O bus.
+ * @details Each byte of the buffer is written on the bus and latched by
+ *          pulsing the strobe line high then low, as required by parallel
+ *          peripherals such as LCD controllers. The strobe line must be
+ *          already configured as a low output.
+ * @note    The operation is not guaranteed to be atomic on all the
+ *          architectures, for atomicity and/or portability reasons you may
+ *          need to enclose port I/O operations between @p osalSysLock() and
+ *          @p osalSysUnlock().
+ * @note    No delays are inserted, on fast cores an external peripheral
+ *          with setup/hold requirements longer than a few core cycles
+ *          must be driven with an explicit loop instead.
+ * @note    The function can be called from any context.
+ *
+ * @param[in] bus       the I/O bus, pointer to a @p IOBus structure
+ * @param[in] strobe    line to be pulsed after each datum
+ * @param[in] buffer    pointer to the data buffer
+ * @param[in] n         number of bytes to be written
+ *
+ * @special
+ */
+void palWriteBusBurst(const IOBus *bus, ioline_t strobe,
+                      const uint8_t buffer[], size_t n) {
+  size_t i;
+
+  osalDbgCheck((bus != NULL) && (bus->offset < PAL_IOPORTS_WIDTH) &&
+               (buffer != NULL));
+
+  for (i = (size_t)0; i < n; i++) {
+    palWriteBusX(bus, (ioportmask_t)buffer[i]);
+    palSetLine(strobe);
+    palClearLine(strobe);
+  }
+}
+
 /**
  * @brief   Programs a bus with the specified mode.
  * @note    The operation is not guaranteed to be atomic on all the
@@ -153,6 +196,45 @@ void palSetLineCallbackI(ioline_t line, palcallback_t cb, void *arg) {
 }
 #endif /* PAL_USE_CALLBACKS == TRUE */
 
+#if (PAL_USE_TIMESTAMPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the timestamp of the last event on a port/pad.
+ * @details The timestamp is captured on entry in the event dispatch code
+ *          using the @p PAL_TIMESTAMP_NOW() source, it can be read from
+ *          within the event callback or after a successful wait.
+ * @note    The function can be called from any context.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ * @return              The timestamp of the last event.
+ *
+ * @xclass
+ */
+rtcnt_t palGetPadEventTimestampX(ioportid_t port, iopadid_t pad) {
+
+  palevent_t *pep = pal_lld_get_pad_event(port, pad);
+  return pep->timestamp;
+}
+
+/**
+ * @brief   Returns the timestamp of the last event on a line.
+ * @details The timestamp is captured on entry in the event dispatch code
+ *          using the @p PAL_TIMESTAMP_NOW() source, it can be read from
+ *          within the event callback or after a successful wait.
+ * @note    The function can be called from any context.
+ *
+ * @param[in] line      line identifier
+ * @return              The timestamp of the last event.
+ *
+ * @xclass
+ */
+rtcnt_t palGetLineEventTimestampX(ioline_t line) {
+
+  palevent_t *pep = pal_lld_get_line_event(line);
+  return pep->timestamp;
+}
+#endif /* PAL_USE_TIMESTAMPS == TRUE */
+
 #if (PAL_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Waits for an edge on the specified port/pad.
@@ -252,6 +334,132 @@ msg_t palWaitLineTimeout(ioline_t line, sysinterval_t timeout) {
 }
 #endif /* PAL_USE_WAIT == TRUE */
 
+#if (PAL_USE_GROUP_EVENTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a port-group event.
+ * @details The event mode is programmed on all the lines in the mask and
+ *          the callback is registered, an event on any of the lines then
+ *          results in a single callback activation carrying the mask of
+ *          the triggering lines and an atomic snapshot of the whole port
+ *          input register. Lines served by the same interrupt handler
+ *          and triggering together are coalesced into one activation.
+ * @note    Lines belonging to a group are no more dispatched per-line,
+ *          callbacks and waits registered on the single lines are not
+ *          served while the group is active.
+ *
+ * @param[in] port      port identifier
+ * @param[in] mask      mask of the lines belonging to the group
+ * @param[in] mode      lines event mode
+ * @param[in] cb        group event callback function
+ * @param[in] arg       callback argument
+ *
+ * @api
+ */
+void palEnableGroupEvent(ioportid_t port, ioportmask_t mask,
+                         ioeventmode_t mode, palgroupcb_t cb, void *arg) {
+  palgroupevent_t *pgp;
+  unsigned i;
+  iopadid_t pad;
+
+  osalDbgCheck((mask != 0U) && (cb != NULL));
+
+  osalSysLock();
+
+  /* Looking for a free record.*/
+  pgp = NULL;
+  for (i = 0U; i < (unsigned)PAL_GROUP_EVENTS_MAX; i++) {
+    if (_pal_groups[i].cb == NULL) {
+      pgp = &_pal_groups[i];
+      break;
+    }
+  }
+  osalDbgAssert(pgp != NULL, "no free group records");
+
+  pgp->port = port;
+  pgp->mask = mask;
+  pgp->arg  = arg;
+
+  /* The callback is stored last, it marks the record as active for the
+     lock-free readers in the event dispatch code.*/
+  pgp->cb   = cb;
+
+  /* Enabling the event on all the lines of the group.*/
+  for (pad = 0U; pad < (iopadid_t)PAL_IOPORTS_WIDTH; pad++) {
+    if ((mask & PAL_PORT_BIT(pad)) != 0U) {
+      palEnablePadEventI(port, pad, mode);
+    }
+  }
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Disables a port-group event.
+ * @details The events are disabled on all the lines in the mask and the
+ *          group record is released.
+ *
+ * @param[in] port      port identifier
+ * @param[in] mask      mask of the lines belonging to the group
+ *
+ * @api
+ */
+void palDisableGroupEvent(ioportid_t port, ioportmask_t mask) {
+  unsigned i;
+  iopadid_t pad;
+
+  osalDbgCheck(mask != 0U);
+
+  osalSysLock();
+
+  for (i = 0U; i < (unsigned)PAL_GROUP_EVENTS_MAX; i++) {
+    if ((_pal_groups[i].cb != NULL) &&
+        (_pal_groups[i].port == port) && (_pal_groups[i].mask == mask)) {
+      _pal_groups[i].cb = NULL;
+      break;
+    }
+  }
+
+  for (pad = 0U; pad < (iopadid_t)PAL_IOPORTS_WIDTH; pad++) {
+    if ((mask & PAL_PORT_BIT(pad)) != 0U) {
+      palDisablePadEventI(port, pad);
+    }
+  }
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Dispatches the group events matching a set of event lines.
+ * @details For each registered group intersecting the passed mask the
+ *          port input register is sampled once, the callback invoked,
+ *          and the group lines marked as served, the returned mask
+ *          allows the caller to skip the per-line dispatch for them.
+ * @note    Not an API, this function is invoked by the low level event
+ *          dispatch handlers from the ISR context.
+ *
+ * @param[in] lines     mask of the pending event lines
+ * @return              The mask of the lines served by group callbacks.
+ *
+ * @notapi
+ */
+ioportmask_t _pal_serve_group_events(ioportmask_t lines) {
+  ioportmask_t served = 0U;
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)PAL_GROUP_EVENTS_MAX; i++) {
+    palgroupevent_t *pgp = &_pal_groups[i];
+    ioportmask_t changed = lines & pgp->mask;
+
+    if ((pgp->cb != NULL) && (changed != 0U)) {
+      pgp->cb(pgp->arg, changed, palReadPort(pgp->port));
+      served |= changed;
+    }
+  }
+
+  return served;
+}
+#endif /* PAL_USE_GROUP_EVENTS == TRUE */
+
 #endif /* HAL_USE_PAL == TRUE */
 
 /** @} */
@@ -206,6 +206,75 @@ void pwmDisableChannel(PWMDriver *pwmp, pwmchannel_t channel) {
   osalSysUnlock();
 }
 
+/**
+ * @brief   Updates a set of PWM channels atomically.
+ * @details The specified channels are enabled using the matching elements
+ *          of the widths array. Where the low level driver supports
+ *          grouped updates the whole set takes effect on the same PWM
+ *          period, else the channels are updated back-to-back.
+ * @pre     The PWM unit must have been activated using @p pwmStart().
+ * @post    The channels are active using the specified widths.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] mask      mask of the channels to be updated
+ * @param[in] widths    array of pulse widths as clock pulses number,
+ *                      indexed by channel number
+ *
+ * @api
+ */
+void pwmSetChannels(PWMDriver *pwmp,
+                    pwmchnmsk_t mask,
+                    const pwmcnt_t widths[]) {
+
+  osalSysLock();
+
+  osalDbgAssert(pwmp->state == PWM_READY, "not ready");
+
+  pwmSetChannelsI(pwmp, mask, widths);
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Updates a set of PWM channels atomically.
+ * @details The specified channels are enabled using the matching elements
+ *          of the widths array. Where the low level driver supports
+ *          grouped updates the whole set takes effect on the same PWM
+ *          period, else the channels are updated back-to-back.
+ * @pre     The PWM unit must have been activated using @p pwmStart().
+ * @post    The channels are active using the specified widths.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] mask      mask of the channels to be updated
+ * @param[in] widths    array of pulse widths as clock pulses number,
+ *                      indexed by channel number
+ *
+ * @iclass
+ */
+void pwmSetChannelsI(PWMDriver *pwmp,
+                     pwmchnmsk_t mask,
+                     const pwmcnt_t widths[]) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((pwmp != NULL) && (widths != NULL) && (mask != 0U) &&
+               ((mask >> pwmp->channels) == 0U));
+
+  pwmp->enabled |= mask;
+#if PWM_SUPPORTS_GROUP_UPDATE == TRUE
+  pwm_lld_set_channels(pwmp, mask, widths);
+#else
+  {
+    pwmchannel_t channel;
+
+    for (channel = 0; channel < pwmp->channels; channel++) {
+      if ((mask & ((pwmchnmsk_t)1U << (pwmchnmsk_t)channel)) != 0U) {
+        pwm_lld_enable_channel(pwmp, channel, widths[channel]);
+      }
+    }
+  }
+#endif
+}
+
 /**
  * @brief   Enables the periodic activation edge notification.
  * @pre     The PWM unit must have been activated using @p pwmStart().
@@ -43,6 +43,34 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/*
+ * Fallback on ports not providing optimized bulk memory operations.
+ */
+#if !defined(PORT_SUPPORTS_MEMOPS)
+#define __port_memcpy(dp, sp, n)    memcpy((dp), (sp), (n))
+#endif
+
+#if (HAL_QUEUES_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Head of the queues enumeration list.
+ */
+static io_queue_t *q_list;
+#endif
+
+/*
+ * High watermark update, a single compare and store on the filling paths,
+ * the fill level is the number of buffered bytes for both queue types.
+ */
+#if (HAL_QUEUES_STATS == TRUE) && !defined(__DOXYGEN__)
+#define Q_STATS_UPDATE(qp, fill) {                                          \
+  if ((fill) > (qp)->q_hwm) {                                               \
+    (qp)->q_hwm = (fill);                                                   \
+  }                                                                         \
+}
+#else
+#define Q_STATS_UPDATE(qp, fill)
+#endif
+
 /**
  * @brief   Non-blocking input queue read.
  * @details The function reads data from an input queue into a buffer. The
@@ -72,18 +100,18 @@ static size_t iq_read(input_queue_t *iqp, uint8_t *bp, size_t n) {
   s1 = (size_t)(iqp->q_top - iqp->q_rdptr);
   /*lint -restore*/
   if (n < s1) {
-    memcpy((void *)bp, (void *)iqp->q_rdptr, n);
+    __port_memcpy((void *)bp, (void *)iqp->q_rdptr, n);
     iqp->q_rdptr += n;
   }
   else if (n > s1) {
-    memcpy((void *)bp, (void *)iqp->q_rdptr, s1);
+    __port_memcpy((void *)bp, (void *)iqp->q_rdptr, s1);
     bp += s1;
     s2 = n - s1;
-    memcpy((void *)bp, (void *)iqp->q_buffer, s2);
+    __port_memcpy((void *)bp, (void *)iqp->q_buffer, s2);
     iqp->q_rdptr = iqp->q_buffer + s2;
   }
   else { /* n == s1 */
-    memcpy((void *)bp, (void *)iqp->q_rdptr, n);
+    __port_memcpy((void *)bp, (void *)iqp->q_rdptr, n);
     iqp->q_rdptr = iqp->q_buffer;
   }
 
@@ -91,6 +119,55 @@ static size_t iq_read(input_queue_t *iqp, uint8_t *bp, size_t n) {
   return n;
 }
 
+/**
+ * @brief   Non-blocking input queue write.
+ * @details The function writes data from a buffer into an input queue. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or when the input queue has been filled.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t iq_write(input_queue_t *iqp, const uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  osalDbgCheck(n > 0U);
+
+  /* Number of bytes that can be written in a single atomic operation.*/
+  if (n > iqGetEmptyI(iqp)) {
+    n = iqGetEmptyI(iqp);
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(iqp->q_top - iqp->q_wrptr);
+  /*lint -restore*/
+  if (n < s1) {
+    __port_memcpy((void *)iqp->q_wrptr, (const void *)bp, n);
+    iqp->q_wrptr += n;
+  }
+  else if (n > s1) {
+    __port_memcpy((void *)iqp->q_wrptr, (const void *)bp, s1);
+    bp += s1;
+    s2 = n - s1;
+    __port_memcpy((void *)iqp->q_buffer, (const void *)bp, s2);
+    iqp->q_wrptr = iqp->q_buffer + s2;
+  }
+  else { /* n == s1 */
+    __port_memcpy((void *)iqp->q_wrptr, (const void *)bp, n);
+    iqp->q_wrptr = iqp->q_buffer;
+  }
+
+  iqp->q_counter += n;
+  Q_STATS_UPDATE(iqp, iqp->q_counter);
+  return n;
+}
+
 /**
  * @brief   Non-blocking output queue write.
  * @details The function writes data from a buffer to an output queue. The
@@ -120,22 +197,71 @@ static size_t oq_write(output_queue_t *oqp, const uint8_t *bp, size_t n) {
   s1 = (size_t)(oqp->q_top - oqp->q_wrptr);
   /*lint -restore*/
   if (n < s1) {
-    memcpy((void *)oqp->q_wrptr, (const void *)bp, n);
+    __port_memcpy((void *)oqp->q_wrptr, (const void *)bp, n);
     oqp->q_wrptr += n;
   }
   else if (n > s1) {
-    memcpy((void *)oqp->q_wrptr, (const void *)bp, s1);
+    __port_memcpy((void *)oqp->q_wrptr, (const void *)bp, s1);
     bp += s1;
     s2 = n - s1;
-    memcpy((void *)oqp->q_buffer, (const void *)bp, s2);
+    __port_memcpy((void *)oqp->q_buffer, (const void *)bp, s2);
     oqp->q_wrptr = oqp->q_buffer + s2;
   }
   else { /* n == s1 */
-    memcpy((void *)oqp->q_wrptr, (const void *)bp, n);
+    __port_memcpy((void *)oqp->q_wrptr, (const void *)bp, n);
     oqp->q_wrptr = oqp->q_buffer;
   }
 
   oqp->q_counter -= n;
+  Q_STATS_UPDATE(oqp, qSizeX(oqp) - oqp->q_counter);
+  return n;
+}
+
+/**
+ * @brief   Non-blocking output queue read.
+ * @details The function reads data from an output queue into a buffer. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or when the output queue has been emptied.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t oq_read(output_queue_t *oqp, uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  osalDbgCheck(n > 0U);
+
+  /* Number of bytes that can be read in a single atomic operation.*/
+  if (n > oqGetFullI(oqp)) {
+    n = oqGetFullI(oqp);
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(oqp->q_top - oqp->q_rdptr);
+  /*lint -restore*/
+  if (n < s1) {
+    __port_memcpy((void *)bp, (void *)oqp->q_rdptr, n);
+    oqp->q_rdptr += n;
+  }
+  else if (n > s1) {
+    __port_memcpy((void *)bp, (void *)oqp->q_rdptr, s1);
+    bp += s1;
+    s2 = n - s1;
+    __port_memcpy((void *)bp, (void *)oqp->q_buffer, s2);
+    oqp->q_rdptr = oqp->q_buffer + s2;
+  }
+  else { /* n == s1 */
+    __port_memcpy((void *)bp, (void *)oqp->q_rdptr, n);
+    oqp->q_rdptr = oqp->q_buffer;
+  }
+
+  oqp->q_counter += n;
   return n;
 }
 
@@ -185,6 +311,15 @@ void iqObjectInit(input_queue_t *iqp, uint8_t *bp, size_t size,
   iqp->q_top     = bp + size;
   iqp->q_notify  = infy;
   iqp->q_link    = link;
+
+#if HAL_QUEUES_STATS == TRUE
+  /* Linking into the queues enumeration list.*/
+  iqp->q_hwm = (size_t)0;
+  osalSysLock();
+  iqp->q_next = q_list;
+  q_list = iqp;
+  osalSysUnlock();
+#endif
 }
 
 /**
@@ -228,6 +363,7 @@ msg_t iqPutI(input_queue_t *iqp, uint8_t b) {
   /* Queue space check.*/
   if (!iqIsFullI(iqp)) {
     iqp->q_counter++;
+    Q_STATS_UPDATE(iqp, iqp->q_counter);
     *iqp->q_wrptr++ = b;
     if (iqp->q_wrptr >= iqp->q_top) {
       iqp->q_wrptr = iqp->q_buffer;
@@ -241,6 +377,39 @@ msg_t iqPutI(input_queue_t *iqp, uint8_t b) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Input queue non-blocking write.
+ * @details The function writes data from a buffer into the low end of an
+ *          input queue. The operation completes immediately.
+ * @note    This function is the bulk equivalent of @p iqPutI(), it is
+ *          meant to be used by those drivers transferring data in blocks,
+ *          for example from a DMA buffer, the data is copied in contiguous
+ *          spans using bulk copies instead of one byte at a time.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @iclass
+ */
+size_t iqWriteI(input_queue_t *iqp, const uint8_t *bp, size_t n) {
+  size_t wr;
+
+  osalDbgCheckClassI();
+
+  wr = iq_write(iqp, bp, n);
+
+  /* Inform the high side that the queue has at least one character
+     available.*/
+  if (wr > (size_t)0) {
+    osalThreadDequeueNextI(&iqp->q_waiting, MSG_OK);
+  }
+
+  return wr;
+}
+
 /**
  * @brief   Input queue non-blocking read.
  * @details This function reads a byte value from an input queue. The
@@ -428,6 +597,84 @@ size_t iqReadTimeout(input_queue_t *iqp, uint8_t *bp,
   return rd;
 }
 
+/**
+ * @brief   Input queue vectored read with timeout.
+ * @details The function reads data from an input queue into the segments
+ *          described by an array of segment descriptors, this performs a
+ *          multi-segment transfer in a single queue transaction. The
+ *          operation completes when all the segments have been filled or
+ *          after the specified timeout or if the queue has been reset.
+ * @note    The function is not atomic, if you need atomicity it is suggested
+ *          to use a semaphore or a mutex for mutual exclusion.
+ * @note    The callback is invoked after removing each character from the
+ *          queue.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] iov       pointer to an array of @p stm_iovec_t segment
+ *                      descriptors
+ * @param[in] iovcnt    number of segment descriptors, the value 0 is
+ *                      reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred.
+ *
+ * @api
+ */
+size_t iqReadVTimeout(input_queue_t *iqp, const stm_iovec_t iov[],
+                      size_t iovcnt, sysinterval_t timeout) {
+  qnotify_t nfy = iqp->q_notify;
+  size_t rd = 0;
+
+  osalDbgCheck((iov != NULL) && (iovcnt > 0U));
+
+  osalSysLock();
+
+  while (iovcnt > 0U) {
+    uint8_t *bp = (uint8_t *)iov->base;
+    size_t n = iov->len;
+
+    while (n > 0U) {
+      size_t done;
+
+      done = iq_read(iqp, bp, n);
+      if (done == (size_t)0) {
+        msg_t msg = osalThreadEnqueueTimeoutS(&iqp->q_waiting, timeout);
+
+        /* Anything except MSG_OK causes the operation to stop.*/
+        if (msg != MSG_OK) {
+          osalSysUnlock();
+          return rd;
+        }
+      }
+      else {
+        /* Inform the low side that the queue has at least one empty slot
+           available.*/
+        if (nfy != NULL) {
+          nfy(iqp);
+        }
+
+        /* Giving a preemption chance in a controlled point.*/
+        osalSysUnlock();
+
+        rd += done;
+        bp += done;
+        n  -= done;
+
+        osalSysLock();
+      }
+    }
+
+    iov++;
+    iovcnt--;
+  }
+
+  osalSysUnlock();
+  return rd;
+}
+
 /**
  * @brief   Initializes an output queue.
  * @details A Semaphore is internally initialized and works as a counter of
@@ -454,6 +701,15 @@ void oqObjectInit(output_queue_t *oqp, uint8_t *bp, size_t size,
   oqp->q_top     = bp + size;
   oqp->q_notify  = onfy;
   oqp->q_link    = link;
+
+#if HAL_QUEUES_STATS == TRUE
+  /* Linking into the queues enumeration list.*/
+  oqp->q_hwm = (size_t)0;
+  osalSysLock();
+  oqp->q_next = q_list;
+  q_list = oqp;
+  osalSysUnlock();
+#endif
 }
 
 /**
@@ -499,6 +755,7 @@ msg_t oqPutI(output_queue_t *oqp, uint8_t b) {
   while (!oqIsFullI(oqp)) {
     /* Putting the character into the queue.*/
     oqp->q_counter--;
+    Q_STATS_UPDATE(oqp, qSizeX(oqp) - oqp->q_counter);
     *oqp->q_wrptr++ = b;
     if (oqp->q_wrptr >= oqp->q_top) {
       oqp->q_wrptr = oqp->q_buffer;
@@ -552,6 +809,7 @@ msg_t oqPutTimeout(output_queue_t *oqp, uint8_t b, sysinterval_t timeout) {
 
   /* Putting the character into the queue.*/
   oqp->q_counter--;
+  Q_STATS_UPDATE(oqp, qSizeX(oqp) - oqp->q_counter);
   *oqp->q_wrptr++ = b;
   if (oqp->q_wrptr >= oqp->q_top) {
     oqp->q_wrptr = oqp->q_buffer;
@@ -600,6 +858,37 @@ msg_t oqGetI(output_queue_t *oqp) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Output queue non-blocking read.
+ * @details The function reads data from the low end of an output queue into
+ *          a buffer. The operation completes immediately.
+ * @note    This function is the bulk equivalent of @p oqGetI(), it is
+ *          meant to be used by those drivers transferring data in blocks,
+ *          for example into a DMA buffer, the data is copied in contiguous
+ *          spans using bulk copies instead of one byte at a time.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @iclass
+ */
+size_t oqReadI(output_queue_t *oqp, uint8_t *bp, size_t n) {
+  size_t rd;
+
+  osalDbgCheckClassI();
+
+  rd = oq_read(oqp, bp, n);
+
+  /* Inform the high side that the queue has some free space available.*/
+  if (rd > (size_t)0) {
+    osalThreadDequeueNextI(&oqp->q_waiting, MSG_OK);
+  }
+
+  return rd;
+}
 
 /**
  * @brief   Output queue non-blocking write.
@@ -697,4 +986,103 @@ size_t oqWriteTimeout(output_queue_t *oqp, const uint8_t *bp,
   return wr;
 }
 
+/**
+ * @brief   Output queue vectored write with timeout.
+ * @details The function writes the segments described by an array of
+ *          segment descriptors into an output queue, this performs a
+ *          multi-segment transfer in a single queue transaction. The
+ *          operation completes when all the segments have been transferred
+ *          or after the specified timeout or if the queue has been reset.
+ * @note    The function is not atomic, if you need atomicity it is suggested
+ *          to use a semaphore or a mutex for mutual exclusion.
+ * @note    The callback is invoked after adding each character to the
+ *          queue.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[in] iov       pointer to an array of @p stm_iovec_t segment
+ *                      descriptors
+ * @param[in] iovcnt    number of segment descriptors, the value 0 is
+ *                      reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred.
+ *
+ * @api
+ */
+size_t oqWriteVTimeout(output_queue_t *oqp, const stm_iovec_t iov[],
+                       size_t iovcnt, sysinterval_t timeout) {
+  qnotify_t nfy = oqp->q_notify;
+  size_t wr = 0;
+
+  osalDbgCheck((iov != NULL) && (iovcnt > 0U));
+
+  osalSysLock();
+
+  while (iovcnt > 0U) {
+    const uint8_t *bp = (const uint8_t *)iov->base;
+    size_t n = iov->len;
+
+    while (n > 0U) {
+      size_t done;
+
+      done = oq_write(oqp, bp, n);
+      if (done == (size_t)0) {
+        msg_t msg = osalThreadEnqueueTimeoutS(&oqp->q_waiting, timeout);
+
+        /* Anything except MSG_OK causes the operation to stop.*/
+        if (msg != MSG_OK) {
+          osalSysUnlock();
+          return wr;
+        }
+      }
+      else {
+        /* Inform the low side that the queue has at least one character
+           available.*/
+        if (nfy != NULL) {
+          nfy(oqp);
+        }
+
+        /* Giving a preemption chance in a controlled point.*/
+        osalSysUnlock();
+
+        wr += done;
+        bp += done;
+        n  -= done;
+
+        osalSysLock();
+      }
+    }
+
+    iov++;
+    iovcnt--;
+  }
+
+  osalSysUnlock();
+  return wr;
+}
+
+#if (HAL_QUEUES_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the next queue in the enumeration list.
+ * @details All queues initialized with @p iqObjectInit() or
+ *          @p oqObjectInit() are linked in a global list, the peak fill
+ *          level of each one is available through
+ *          @p qGetHighWatermarkX().
+ *
+ * @param[in] qp        previously returned queue or @p NULL in order to
+ *                      start the enumeration
+ * @return              The next queue in the list.
+ * @retval NULL         if there are no more queues.
+ *
+ * @xclass
+ */
+io_queue_t *qGetNextX(io_queue_t *qp) {
+
+  return (qp == NULL) ? q_list : qp->q_next;
+}
+#endif /* HAL_QUEUES_STATS == TRUE */
+
 /** @} */
@@ -129,6 +129,38 @@ void rtcGetTime(RTCDriver *rtcp, RTCDateTime *timespec) {
   rtc_lld_get_time(rtcp, timespec);
 }
 
+/**
+ * @brief   Get a correlated RTC/system time sample.
+ * @details The RTC time and the system time are sampled in the same
+ *          instant: the system time is read before and after the RTC
+ *          access and the RTC is read again if a tick boundary has been
+ *          crossed, so the returned pair is consistent within one system
+ *          tick. The pair allows translating timestamps between the two
+ *          time domains without estimating a drifting offset.
+ * @note    This function can be called from any context but limitations
+ *          could be imposed by the low level implementation. It is
+ *          guaranteed that the function can be called from thread
+ *          context.
+ * @note    The function can be reentrant or not reentrant depending on
+ *          the low level implementation.
+ *
+ * @param[in] rtcp      pointer to RTC driver structure
+ * @param[out] corp     pointer to a @p RTCCorrelation structure
+ *
+ * @special
+ */
+void rtcGetCorrelation(RTCDriver *rtcp, RTCCorrelation *corp) {
+  systime_t end;
+
+  osalDbgCheck((rtcp != NULL) && (corp != NULL));
+
+  do {
+    corp->systime = osalOsGetSystemTimeX();
+    rtc_lld_get_time(rtcp, &corp->rtctime);
+    end = osalOsGetSystemTimeX();
+  } while (corp->systime != end);
+}
+
 #if (RTC_ALARMS > 0) || defined(__DOXYGEN__)
 /**
  * @brief   Set alarm time.
@@ -32,6 +32,10 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (SDC_USE_ASYNC == TRUE) && (SDC_SUPPORTS_ASYNC == FALSE)
+#error "SDC_USE_ASYNC not supported by this implementation"
+#endif
+
 /**
  * @brief   MMC switch mode.
  */
@@ -64,6 +68,13 @@ typedef enum {
 /* Driver exported variables.                                                */
 /*===========================================================================*/
 
+#if (SDC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Global SDC statistics, see @p SDC_USE_STATS.
+ */
+sdc_stats_t sdc_stats;
+#endif
+
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
@@ -86,6 +97,31 @@ static const struct SDCDriverVMT sdc_vmt = {
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
+
+#if (SDC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Accumulates a service time measurement.
+ *
+ * @param[in,out] tmp   pointer to the accumulator to be updated
+ * @param[in] start     system time sampled before the measured activity
+ *
+ * @notapi
+ */
+static void sdc_stats_update(sdc_time_measurement_t *tmp, systime_t start) {
+  systime_t t = osalOsGetSystemTimeX() - start;
+
+  if ((tmp->n == 0U) || (t < tmp->best)) {
+    tmp->best = t;
+  }
+  if (t > tmp->worst) {
+    tmp->worst = t;
+  }
+  tmp->last        = t;
+  tmp->cumulative += (uint32_t)t;
+  tmp->n++;
+}
+#endif /* SDC_USE_STATS == TRUE */
+
 /**
  * @brief   Detects card mode.
  *
@@ -278,8 +314,12 @@ static uint16_t sdc_cmd6_extract_info(sd_switch_function_t function,
 
 /**
  * @brief   Checks status after switching using CMD6.
+ * @details The status nibble of the function group must match the
+ *          selected function, cards rejecting the switch answer with
+ *          0xF or with the function they stayed in.
  *
- * @param[in] function  function number to be switched
+ * @param[in] group     function group to be checked
+ * @param[in] function  function number that was selected
  * @param[in] buf       buffer with answer
  *
  * @return              The operation status.
@@ -288,8 +328,9 @@ static uint16_t sdc_cmd6_extract_info(sd_switch_function_t function,
  *
  * @notapi
  */
-static bool sdc_cmd6_check_status(sd_switch_function_t function,
-                                 const uint8_t *buf) {
+static bool sdc_cmd6_check_status(sd_switch_function_t group,
+                                  uint32_t function,
+                                  const uint8_t *buf) {
 
   uint32_t tmp;
   uint32_t status;
@@ -297,8 +338,8 @@ static bool sdc_cmd6_check_status(sd_switch_function_t function,
   tmp = ((uint32_t)buf[14] << 16U) |
         ((uint32_t)buf[15] << 8U) |
         (uint32_t)buf[16];
-  status = (tmp >> ((uint32_t)function * 4U)) & 0xFU;
-  if (0xFU != status) {
+  status = (tmp >> ((uint32_t)group * 4U)) & 0xFU;
+  if (function == status) {
     return HAL_SUCCESS;
   }
   return HAL_FAILED;
@@ -317,7 +358,16 @@ static bool sdc_cmd6_check_status(sd_switch_function_t function,
  * @notapi
  */
 static bool sdc_detect_bus_clk(SDCDriver *sdcp, sdcbusclk_t *clk) {
-  uint32_t cmdarg;
+  static const struct {
+    sdcbusclk_t             clk;
+    uint32_t                function;
+  } modes[] = {
+    {SDC_CLK_DDR50,  4U},                       /* DDR50.                  */
+    {SDC_CLK_100MHz, 2U},                       /* SDR50.                  */
+    {SDC_CLK_50MHz,  1U}                        /* High speed.             */
+  };
+  uint32_t cmdarg, support;
+  unsigned i;
   const size_t N = 64;
   uint8_t tmp[N];
 
@@ -327,7 +377,6 @@ static bool sdc_detect_bus_clk(SDCDriver *sdcp, sdcbusclk_t *clk) {
   /* Looks like only "high capacity" cards produce meaningful results during
      this clock detection procedure.*/
   if (0U == _mmcsd_get_slice(sdcp->csd, MMCSD_CSD_10_CSD_STRUCTURE_SLICE)) {
-    *clk = SDC_CLK_25MHz;
     return HAL_SUCCESS;
   }
 
@@ -336,10 +385,23 @@ static bool sdc_detect_bus_clk(SDCDriver *sdcp, sdcbusclk_t *clk) {
     return HAL_FAILED;
   }
 
-  /* Check card capabilities parsing acquired data.*/
-  if ((sdc_cmd6_extract_info(SD_SWITCH_FUNCTION_SPEED, tmp) & 2U) == 2U) {
+  /* Access mode functions supported by the card.*/
+  support = sdc_cmd6_extract_info(SD_SWITCH_FUNCTION_SPEED, tmp);
+
+  /* Modes are attempted in decreasing speed order, modes not supported by
+     the card or above the controller capability are skipped, the ladder
+     falls back to the next slower mode when the card rejects a switch.*/
+  for (i = 0; i < (sizeof modes / sizeof modes[0]); i++) {
+    if (modes[i].clk > SDC_LLD_MAX_BUS_CLOCK) {
+      continue;
+    }
+    if ((support & (1U << modes[i].function)) == 0U) {
+      continue;
+    }
+
     /* Construct command to set the bus speed.*/
-    cmdarg = sdc_cmd6_construct(SD_SWITCH_SET, SD_SWITCH_FUNCTION_SPEED, 1);
+    cmdarg = sdc_cmd6_construct(SD_SWITCH_SET, SD_SWITCH_FUNCTION_SPEED,
+                                modes[i].function);
 
     /* Write constructed command and read operation status in single call.*/
     if (sdc_lld_read_special(sdcp, tmp, N, MMCSD_CMD_SWITCH, cmdarg)) {
@@ -347,11 +409,10 @@ static bool sdc_detect_bus_clk(SDCDriver *sdcp, sdcbusclk_t *clk) {
     }
 
     /* Check card answer for success status bits.*/
-    if (HAL_SUCCESS == sdc_cmd6_check_status(SD_SWITCH_FUNCTION_SPEED, tmp)) {
-      *clk = SDC_CLK_50MHz;
-    }
-    else {
-      *clk = SDC_CLK_25MHz;
+    if (HAL_SUCCESS == sdc_cmd6_check_status(SD_SWITCH_FUNCTION_SPEED,
+                                             modes[i].function, tmp)) {
+      *clk = modes[i].clk;
+      break;
     }
   }
 
@@ -502,17 +563,25 @@ static bool mmc_set_bus_width(SDCDriver *sdcp) {
  */
 bool _sdc_wait_for_transfer_state(SDCDriver *sdcp) {
   uint32_t resp[1];
+  bool status = HAL_FAILED;
+#if SDC_USE_STATS == TRUE
+  systime_t start = osalOsGetSystemTimeX();
+#endif
 
   while (true) {
+#if SDC_USE_STATS == TRUE
+    sdc_stats.busy_polls++;
+#endif
     if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_SEND_STATUS,
                                    sdcp->rca, resp) ||
         MMCSD_R1_ERROR(resp[0])) {
-      return HAL_FAILED;
+      break;
     }
 
     switch (MMCSD_R1_STS(resp[0])) {
     case MMCSD_STS_TRAN:
-      return HAL_SUCCESS;
+      status = HAL_SUCCESS;
+      break;
     case MMCSD_STS_DATA:
     case MMCSD_STS_RCV:
     case MMCSD_STS_PRG:
@@ -523,9 +592,16 @@ bool _sdc_wait_for_transfer_state(SDCDriver *sdcp) {
     default:
       /* The card should have been initialized so any other state is not
          valid and is reported as an error.*/
-      return HAL_FAILED;
+      break;
     }
+    break;
   }
+
+#if SDC_USE_STATS == TRUE
+  sdc_stats_update(&sdc_stats.busy, start);
+#endif
+
+  return status;
 }
 
 /*===========================================================================*/
@@ -804,6 +880,9 @@ bool sdcDisconnect(SDCDriver *sdcp) {
  */
 bool sdcRead(SDCDriver *sdcp, uint32_t startblk, uint8_t *buf, uint32_t n) {
   bool status;
+#if SDC_USE_STATS == TRUE
+  systime_t start;
+#endif
 
   osalDbgCheck((sdcp != NULL) && (buf != NULL) && (n > 0U));
   osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
@@ -816,7 +895,16 @@ bool sdcRead(SDCDriver *sdcp, uint32_t startblk, uint8_t *buf, uint32_t n) {
   /* Read operation in progress.*/
   sdcp->state = BLK_READING;
 
+#if SDC_USE_STATS == TRUE
+  start = osalOsGetSystemTimeX();
+#endif
   status = sdc_lld_read(sdcp, startblk, buf, n);
+#if SDC_USE_STATS == TRUE
+  sdc_stats_update(&sdc_stats.read, start);
+  if (status == HAL_FAILED) {
+    sdc_stats.read_errors++;
+  }
+#endif
 
   /* Read operation finished.*/
   sdcp->state = BLK_READY;
@@ -842,6 +930,9 @@ bool sdcRead(SDCDriver *sdcp, uint32_t startblk, uint8_t *buf, uint32_t n) {
 bool sdcWrite(SDCDriver *sdcp, uint32_t startblk,
               const uint8_t *buf, uint32_t n) {
   bool status;
+#if SDC_USE_STATS == TRUE
+  systime_t start;
+#endif
 
   osalDbgCheck((sdcp != NULL) && (buf != NULL) && (n > 0U));
   osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
@@ -854,13 +945,144 @@ bool sdcWrite(SDCDriver *sdcp, uint32_t startblk,
   /* Write operation in progress.*/
   sdcp->state = BLK_WRITING;
 
+#if SDC_USE_STATS == TRUE
+  start = osalOsGetSystemTimeX();
+#endif
   status = sdc_lld_write(sdcp, startblk, buf, n);
+#if SDC_USE_STATS == TRUE
+  sdc_stats_update(&sdc_stats.write, start);
+  if (status == HAL_FAILED) {
+    sdc_stats.write_errors++;
+  }
+#endif
 
   /* Write operation finished.*/
   sdcp->state = BLK_READY;
   return status;
 }
 
+#if (SDC_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous read of one or more blocks.
+ * @details The function returns as soon as the DMA transfer has been
+ *          started, the @p end_cb callback, if defined, is invoked from
+ *          the ISR when the data phase ends, then the transfer must be
+ *          completed by calling @p sdcFinishTransfer() from thread
+ *          context.
+ * @pre     The driver must be in the @p BLK_READY state after a successful
+ *          sdcConnect() invocation.
+ * @note    The buffer must be word aligned, the unaligned fallback of the
+ *          synchronous API is not available on the asynchronous one.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[out] buf      pointer to the read buffer
+ * @param[in] n         number of blocks to read
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @api
+ */
+bool sdcStartRead(SDCDriver *sdcp, uint32_t startblk,
+                  uint8_t *buf, uint32_t n) {
+
+  osalDbgCheck((sdcp != NULL) && (buf != NULL) && (n > 0U));
+  osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
+
+  if ((startblk + n - 1U) > sdcp->capacity) {
+    sdcp->errors |= SDC_OVERFLOW_ERROR;
+    return HAL_FAILED;
+  }
+
+  /* Read operation in progress until sdcFinishTransfer().*/
+  sdcp->state = BLK_READING;
+
+  if (sdc_lld_start_read(sdcp, startblk, buf, n) != HAL_SUCCESS) {
+    sdcp->state = BLK_READY;
+    return HAL_FAILED;
+  }
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Starts an asynchronous write of one or more blocks.
+ * @details The function returns as soon as the DMA transfer has been
+ *          started, the @p end_cb callback, if defined, is invoked from
+ *          the ISR when the data phase ends, then the transfer must be
+ *          completed by calling @p sdcFinishTransfer() from thread
+ *          context.
+ * @pre     The driver must be in the @p BLK_READY state after a successful
+ *          sdcConnect() invocation.
+ * @note    The buffer must be word aligned, the unaligned fallback of the
+ *          synchronous API is not available on the asynchronous one.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] buf       pointer to the write buffer
+ * @param[in] n         number of blocks to write
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @api
+ */
+bool sdcStartWrite(SDCDriver *sdcp, uint32_t startblk,
+                   const uint8_t *buf, uint32_t n) {
+
+  osalDbgCheck((sdcp != NULL) && (buf != NULL) && (n > 0U));
+  osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
+
+  if ((startblk + n - 1U) > sdcp->capacity) {
+    sdcp->errors |= SDC_OVERFLOW_ERROR;
+    return HAL_FAILED;
+  }
+
+  /* Write operation in progress until sdcFinishTransfer().*/
+  sdcp->state = BLK_WRITING;
+
+  if (sdc_lld_start_write(sdcp, startblk, buf, n) != HAL_SUCCESS) {
+    sdcp->state = BLK_READY;
+    return HAL_FAILED;
+  }
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Completes an asynchronous transfer.
+ * @details The transaction finalization, stop command included, is
+ *          performed and the transfer outcome is returned. If the data
+ *          phase is still in progress then the invoking thread is
+ *          suspended until it ends, calling after the @p end_cb callback
+ *          has been invoked does not block.
+ * @pre     A transfer must have been started with @p sdcStartRead() or
+ *          @p sdcStartWrite().
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool sdcFinishTransfer(SDCDriver *sdcp) {
+  bool status;
+
+  osalDbgCheck(sdcp != NULL);
+  osalDbgAssert((sdcp->state == BLK_READING) || (sdcp->state == BLK_WRITING),
+                "invalid state");
+
+  status = sdc_lld_finish_transfer(sdcp);
+
+  /* Transfer operation finished.*/
+  sdcp->state = BLK_READY;
+  return status;
+}
+#endif /* SDC_USE_ASYNC == TRUE */
+
 /**
  * @brief   Returns the errors mask associated to the previous operation.
  *
@@ -1004,6 +1226,37 @@ failed:
   return HAL_FAILED;
 }
 
+#if (SDC_USE_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns a copy of the driver statistics.
+ *
+ * @param[out] ssp      pointer to a @p sdc_stats_t structure to be filled
+ *
+ * @api
+ */
+void sdcGetStats(sdc_stats_t *ssp) {
+
+  osalDbgCheck(ssp != NULL);
+
+  osalSysLock();
+  *ssp = sdc_stats;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Resets the driver statistics.
+ *
+ * @api
+ */
+void sdcResetStats(void) {
+  static const sdc_stats_t zero_stats;
+
+  osalSysLock();
+  sdc_stats = zero_stats;
+  osalSysUnlock();
+}
+#endif /* SDC_USE_STATS == TRUE */
+
 #endif /* HAL_USE_SDC == TRUE */
 
 /** @} */
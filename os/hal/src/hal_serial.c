@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_SERIAL == TRUE) || defined(__DOXYGEN__)
@@ -59,6 +61,18 @@ static size_t _read(void *ip, uint8_t *bp, size_t n) {
                        n, TIME_INFINITE);
 }
 
+static size_t _writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+
+  return oqWriteVTimeout(&((SerialDriver *)ip)->oqueue, iov,
+                         iovcnt, TIME_INFINITE);
+}
+
+static size_t _readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+
+  return iqReadVTimeout(&((SerialDriver *)ip)->iqueue, iov,
+                        iovcnt, TIME_INFINITE);
+}
+
 static msg_t _put(void *ip, uint8_t b) {
 
   return oqPutTimeout(&((SerialDriver *)ip)->oqueue, b, TIME_INFINITE);
@@ -114,11 +128,78 @@ static msg_t _ctl(void *ip, unsigned int operation, void *arg) {
   return MSG_OK;
 }
 
+static msg_t _startread(void *ip, chn_async_descriptor_t *adp) {
+  SerialDriver *sdp = (SerialDriver *)ip;
+
+  osalDbgCheck((adp != NULL) && (adp->buffer != NULL) &&
+               (adp->size > 0U) && (adp->callback != NULL));
+
+  osalSysLock();
+  if (sdp->state != SD_READY) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(sdp->rxasync == NULL, "read already armed");
+
+  /* Draining data already accumulated in the input queue.*/
+  adp->offset = 0U;
+  while (adp->offset < adp->size) {
+    msg_t b = iqGetI(&sdp->iqueue);
+    if (b < MSG_OK) {
+      break;
+    }
+    adp->buffer[adp->offset] = (uint8_t)b;
+    adp->offset++;
+  }
+
+  if (adp->offset >= adp->size) {
+    /* Enough buffered data, completing immediately.*/
+    adp->callback(sdp, adp);
+  }
+  else {
+    /* Arming the descriptor, the ISR side will complete it.*/
+    sdp->rxasync = adp;
+  }
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+static msg_t _startwrite(void *ip, chn_async_descriptor_t *adp) {
+  SerialDriver *sdp = (SerialDriver *)ip;
+  qnotify_t nfy;
+
+  osalDbgCheck((adp != NULL) && (adp->buffer != NULL) &&
+               (adp->size > 0U) && (adp->callback != NULL));
+
+  osalSysLock();
+  if (sdp->state != SD_READY) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(sdp->txasync == NULL, "write already armed");
+
+  /* Arming the descriptor, the ISR side fetches the data directly from
+     the descriptor buffer.*/
+  adp->offset = 0U;
+  sdp->txasync = adp;
+
+  /* Starting the transmission as the output queue notification would.*/
+  nfy = sdp->oqueue.q_notify;
+  if (nfy != NULL) {
+    nfy(&sdp->oqueue);
+  }
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
 static const struct SerialDriverVMT vmt = {
   (size_t)0,
-  _write, _read, _put, _get,
+  _write, _read, _writev, _readv, _put, _get,
   _putt, _gett, _writet, _readt,
-  _ctl
+  _ctl,
+  _startread, _startwrite
 };
 
 /*===========================================================================*/
@@ -159,6 +240,8 @@ void sdObjectInit(SerialDriver *sdp, qnotify_t inotify, qnotify_t onotify) {
 
   sdp->vmt = &vmt;
   osalEventObjectInit(&sdp->event);
+  sdp->rxasync = NULL;
+  sdp->txasync = NULL;
   sdp->state = SD_STOP;
   iqObjectInit(&sdp->iqueue, sdp->ib, SERIAL_BUFFERS_SIZE, inotify, sdp);
   oqObjectInit(&sdp->oqueue, sdp->ob, SERIAL_BUFFERS_SIZE, onotify, sdp);
@@ -168,6 +251,8 @@ void sdObjectInit(SerialDriver *sdp) {
 
   sdp->vmt = &vmt;
   osalEventObjectInit(&sdp->event);
+  sdp->rxasync = NULL;
+  sdp->txasync = NULL;
   sdp->state = SD_STOP;
 }
 #endif
@@ -214,6 +299,8 @@ void sdStop(SerialDriver *sdp) {
 
   sd_lld_stop(sdp);
   sdp->state = SD_STOP;
+  sdp->rxasync = NULL;
+  sdp->txasync = NULL;
   oqResetI(&sdp->oqueue);
   iqResetI(&sdp->iqueue);
   osalOsRescheduleS();
@@ -238,10 +325,24 @@ void sdStop(SerialDriver *sdp) {
  * @iclass
  */
 void sdIncomingDataI(SerialDriver *sdp, uint8_t b) {
+  chn_async_descriptor_t *adp;
 
   osalDbgCheckClassI();
   osalDbgCheck(sdp != NULL);
 
+  /* If an asynchronous read is armed then the byte goes directly into the
+     descriptor buffer, bypassing the input queue.*/
+  adp = sdp->rxasync;
+  if (adp != NULL) {
+    adp->buffer[adp->offset] = b;
+    adp->offset++;
+    if (adp->offset >= adp->size) {
+      sdp->rxasync = NULL;
+      adp->callback(sdp, adp);
+    }
+    return;
+  }
+
   if (iqIsEmptyI(&sdp->iqueue))
     chnAddFlagsI(sdp, CHN_INPUT_AVAILABLE);
   if (iqPutI(&sdp->iqueue, b) < MSG_OK)
@@ -264,17 +365,146 @@ void sdIncomingDataI(SerialDriver *sdp, uint8_t b) {
  * @iclass
  */
 msg_t sdRequestDataI(SerialDriver *sdp) {
+  chn_async_descriptor_t *adp;
   msg_t  b;
 
   osalDbgCheckClassI();
   osalDbgCheck(sdp != NULL);
 
+  /* If an asynchronous write is armed then bytes are fetched directly from
+     the descriptor buffer, bypassing the output queue. Completion is
+     notified when the last byte is handed to the low level driver.*/
+  adp = sdp->txasync;
+  if (adp != NULL) {
+    b = (msg_t)adp->buffer[adp->offset];
+    adp->offset++;
+    if (adp->offset >= adp->size) {
+      sdp->txasync = NULL;
+      adp->callback(sdp, adp);
+    }
+    return b;
+  }
+
   b = oqGetI(&sdp->oqueue);
   if (b < MSG_OK)
     chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY);
   return b;
 }
 
+/**
+ * @brief   Handles incoming data in bulk.
+ * @details This function is the span equivalent of @p sdIncomingDataI(),
+ *          it is meant to be called by those low level drivers receiving
+ *          data in blocks, for example from a circular DMA buffer on the
+ *          half transfer, full transfer and idle line interrupts. The
+ *          whole span is copied into the input queue through the bulk
+ *          queue interface and the events are generated once per span
+ *          instead of once per byte.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver structure
+ * @param[in] bp        pointer to the received data span
+ * @param[in] n         size of the received data span, cannot be zero
+ * @return              The number of bytes effectively processed, the
+ *                      remainder has been dropped because the input queue
+ *                      was full.
+ *
+ * @iclass
+ */
+size_t sdIncomingDataBulkI(SerialDriver *sdp, const uint8_t *bp, size_t n) {
+  chn_async_descriptor_t *adp;
+  size_t done = 0U;
+  size_t wr;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sdp != NULL) && (bp != NULL) && (n > 0U));
+
+  /* If an asynchronous read is armed then data goes directly into the
+     descriptor buffer, bypassing the input queue.*/
+  adp = sdp->rxasync;
+  if (adp != NULL) {
+    size_t cnt = adp->size - adp->offset;
+
+    if (cnt > n) {
+      cnt = n;
+    }
+    memcpy(adp->buffer + adp->offset, bp, cnt);
+    adp->offset += cnt;
+    if (adp->offset >= adp->size) {
+      sdp->rxasync = NULL;
+      adp->callback(sdp, adp);
+    }
+    done += cnt;
+    bp += cnt;
+    n -= cnt;
+    if (n == 0U) {
+      return done;
+    }
+  }
+
+  if (iqIsEmptyI(&sdp->iqueue))
+    chnAddFlagsI(sdp, CHN_INPUT_AVAILABLE);
+  wr = iqWriteI(&sdp->iqueue, bp, n);
+  if (wr < n)
+    chnAddFlagsI(sdp, SD_QUEUE_FULL_ERROR);
+
+  return done + wr;
+}
+
+/**
+ * @brief   Handles outgoing data in bulk.
+ * @details This function is the span equivalent of @p sdRequestDataI(),
+ *          it is meant to be called by those low level drivers transmitting
+ *          data in blocks, for example when refilling a DMA buffer. The
+ *          data is copied out of the output queue through the bulk queue
+ *          interface and the events are generated once per span instead
+ *          of once per byte.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver structure
+ * @param[out] bp       pointer to the transmit data buffer
+ * @param[in] n         maximum size of the data span, cannot be zero
+ * @return              The number of bytes effectively copied, zero or a
+ *                      short count if the output queue has been emptied.
+ *
+ * @iclass
+ */
+size_t sdRequestDataBulkI(SerialDriver *sdp, uint8_t *bp, size_t n) {
+  chn_async_descriptor_t *adp;
+  size_t done = 0U;
+  size_t rd;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sdp != NULL) && (bp != NULL) && (n > 0U));
+
+  /* If an asynchronous write is armed then data is fetched directly from
+     the descriptor buffer, bypassing the output queue.*/
+  adp = sdp->txasync;
+  if (adp != NULL) {
+    size_t cnt = adp->size - adp->offset;
+
+    if (cnt > n) {
+      cnt = n;
+    }
+    memcpy(bp, adp->buffer + adp->offset, cnt);
+    adp->offset += cnt;
+    if (adp->offset >= adp->size) {
+      sdp->txasync = NULL;
+      adp->callback(sdp, adp);
+    }
+    done += cnt;
+    bp += cnt;
+    n -= cnt;
+    if (n == 0U) {
+      return done;
+    }
+  }
+
+  rd = oqReadI(&sdp->oqueue, bp, n);
+  if (rd < n)
+    chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY);
+
+  return done + rd;
+}
+
 /**
  * @brief   Direct output check on a @p SerialDriver.
  * @note    This function bypasses the indirect access to the channel and
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_SERIAL_USB == TRUE) || defined(__DOXYGEN__)
@@ -46,10 +48,46 @@ static cdc_linecoding_t linecoding = {
   LC_STOP_1, LC_PARITY_NONE, 8
 };
 
+#if (SERIAL_USB_USE_SHARED_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared buffers pool storage.
+ */
+static uint8_t sdu_pool[SERIAL_USB_POOL_SIZE];
+
+/**
+ * @brief   First free position in the shared pool.
+ */
+static size_t sdu_pool_next;
+#endif /* SERIAL_USB_USE_SHARED_POOL == TRUE */
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (SERIAL_USB_USE_SHARED_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reserves storage from the shared pool.
+ * @details Reservations are permanent, each instance takes its storage at
+ *          the first start and keeps it across stop/start cycles.
+ *
+ * @param[in] size      size of the reservation
+ * @return              Pointer to the reserved storage or @p NULL if the
+ *                      pool is exhausted.
+ *
+ * @notapi
+ */
+static uint8_t *sdu_pool_reserve(size_t size) {
+  uint8_t *p;
+
+  if ((SERIAL_USB_POOL_SIZE - sdu_pool_next) < size) {
+    return NULL;
+  }
+  p = &sdu_pool[sdu_pool_next];
+  sdu_pool_next += size;
+  return p;
+}
+#endif /* SERIAL_USB_USE_SHARED_POOL == TRUE */
+
 static bool sdu_start_receive(SerialUSBDriver *sdup) {
   uint8_t *buf;
 
@@ -73,11 +111,119 @@ static bool sdu_start_receive(SerialUSBDriver *sdup) {
 
   /* Buffer found, starting a new transaction.*/
   usbStartReceiveI(sdup->config->usbp, sdup->config->bulk_out,
-                   buf, SERIAL_USB_BUFFERS_SIZE);
+                   buf, sdup->ibqueue.bsize - sizeof (size_t));
 
   return false;
 }
 
+/**
+ * @brief   Returns the number of bytes in the partially filled buffer.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ */
+static size_t sdu_pending_bytes(SerialUSBDriver *sdup) {
+
+  if (sdup->obqueue.ptr == NULL) {
+    return (size_t)0;
+  }
+  return (size_t)(sdup->obqueue.ptr -
+                  (sdup->obqueue.bwrptr + sizeof (size_t)));
+}
+
+/**
+ * @brief   Copies buffered input data into the armed read descriptor.
+ * @details Filled buffers are consumed through the queue "current" buffer
+ *          pointers so partially consumed buffers are resumed by the next
+ *          asynchronous read.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ */
+static void sdu_async_rx_pump(SerialUSBDriver *sdup) {
+  chn_async_descriptor_t *adp = sdup->rxasync;
+
+  while (adp != NULL) {
+    size_t n;
+
+    /* Making a buffer "current" if there is not one already.*/
+    if (sdup->ibqueue.ptr == NULL) {
+      uint8_t *buf = ibqGetFullBufferI(&sdup->ibqueue, &n);
+      if (buf == NULL) {
+        return;
+      }
+      sdup->ibqueue.ptr = buf;
+      sdup->ibqueue.top = buf + n;
+    }
+
+    /* Copying out of the current buffer.*/
+    n = (size_t)(sdup->ibqueue.top - sdup->ibqueue.ptr);
+    if (n > adp->size - adp->offset) {
+      n = adp->size - adp->offset;
+    }
+    memcpy(adp->buffer + adp->offset, sdup->ibqueue.ptr, n);
+    adp->offset += n;
+    sdup->ibqueue.ptr += n;
+
+    /* Releasing the buffer if it has been fully consumed.*/
+    if (sdup->ibqueue.ptr >= sdup->ibqueue.top) {
+      ibqReleaseEmptyBufferI(&sdup->ibqueue);
+    }
+
+    /* Completion check.*/
+    if (adp->offset >= adp->size) {
+      sdup->rxasync = NULL;
+      adp->callback(sdup, adp);
+      return;
+    }
+  }
+}
+
+/**
+ * @brief   Copies data from the armed write descriptor into queue buffers.
+ * @details Completely filled buffers are posted for transmission, a trailing
+ *          partial buffer is left "current" and is flushed by the SOF hook.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ */
+static void sdu_async_tx_pump(SerialUSBDriver *sdup) {
+  chn_async_descriptor_t *adp = sdup->txasync;
+
+  while (adp != NULL) {
+    size_t n;
+
+    /* Making a buffer "current" if there is not one already.*/
+    if (sdup->obqueue.ptr == NULL) {
+      uint8_t *buf = obqGetEmptyBufferI(&sdup->obqueue);
+      if (buf == NULL) {
+        return;
+      }
+      sdup->obqueue.ptr = buf;
+      sdup->obqueue.top = sdup->obqueue.bwrptr + sdup->obqueue.bsize;
+    }
+
+    /* Copying into the current buffer.*/
+    n = (size_t)(sdup->obqueue.top - sdup->obqueue.ptr);
+    if (n > adp->size - adp->offset) {
+      n = adp->size - adp->offset;
+    }
+    memcpy(sdup->obqueue.ptr, adp->buffer + adp->offset, n);
+    adp->offset += n;
+    sdup->obqueue.ptr += n;
+
+    /* Posting the buffer if it has been completely filled.*/
+    if (sdup->obqueue.ptr >= sdup->obqueue.top) {
+      obqPostFullBufferI(&sdup->obqueue,
+                         sdup->obqueue.bsize - sizeof (size_t));
+    }
+
+    /* Completion check.*/
+    if (adp->offset >= adp->size) {
+      sdup->txasync = NULL;
+      adp->callback(sdup, adp);
+      return;
+    }
+  }
+}
+
 /*
  * Interface implementation.
  */
@@ -94,6 +240,50 @@ static size_t _read(void *ip, uint8_t *bp, size_t n) {
                         n, TIME_INFINITE);
 }
 
+static size_t _writev(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  SerialUSBDriver *sdup = (SerialUSBDriver *)ip;
+  size_t wr = 0;
+
+  /* Consecutive segments are packed into the same queue buffer so a
+     multi-segment frame does not cause extra USB transactions.*/
+  while (iovcnt > 0U) {
+    if (iov->len > 0U) {
+      size_t done = obqWriteTimeout(&sdup->obqueue,
+                                    (const uint8_t *)iov->base,
+                                    iov->len, TIME_INFINITE);
+      wr += done;
+      if (done < iov->len) {
+        break;
+      }
+    }
+    iov++;
+    iovcnt--;
+  }
+
+  return wr;
+}
+
+static size_t _readv(void *ip, const stm_iovec_t iov[], size_t iovcnt) {
+  SerialUSBDriver *sdup = (SerialUSBDriver *)ip;
+  size_t rd = 0;
+
+  while (iovcnt > 0U) {
+    if (iov->len > 0U) {
+      size_t done = ibqReadTimeout(&sdup->ibqueue,
+                                   (uint8_t *)iov->base,
+                                   iov->len, TIME_INFINITE);
+      rd += done;
+      if (done < iov->len) {
+        break;
+      }
+    }
+    iov++;
+    iovcnt--;
+  }
+
+  return rd;
+}
+
 static msg_t _put(void *ip, uint8_t b) {
 
   return obqPutTimeout(&((SerialUSBDriver *)ip)->obqueue, b, TIME_INFINITE);
@@ -153,11 +343,58 @@ static msg_t _ctl(void *ip, unsigned int operation, void *arg) {
   return MSG_OK;
 }
 
+static msg_t _startread(void *ip, chn_async_descriptor_t *adp) {
+  SerialUSBDriver *sdup = (SerialUSBDriver *)ip;
+
+  osalDbgCheck((adp != NULL) && (adp->buffer != NULL) &&
+               (adp->size > 0U) && (adp->callback != NULL));
+
+  osalSysLock();
+  if (sdup->state != SDU_READY) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(sdup->rxasync == NULL, "read already armed");
+
+  /* Arming the descriptor then draining data already buffered, the
+     operation can complete immediately.*/
+  adp->offset = 0U;
+  sdup->rxasync = adp;
+  sdu_async_rx_pump(sdup);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+static msg_t _startwrite(void *ip, chn_async_descriptor_t *adp) {
+  SerialUSBDriver *sdup = (SerialUSBDriver *)ip;
+
+  osalDbgCheck((adp != NULL) && (adp->buffer != NULL) &&
+               (adp->size > 0U) && (adp->callback != NULL));
+
+  osalSysLock();
+  if (sdup->state != SDU_READY) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(sdup->txasync == NULL, "write already armed");
+
+  /* Arming the descriptor then filling the available queue buffers, the
+     operation can complete immediately.*/
+  adp->offset = 0U;
+  sdup->txasync = adp;
+  sdu_async_tx_pump(sdup);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
 static const struct SerialUSBDriverVMT vmt = {
   (size_t)0,
-  _write, _read, _put, _get,
+  _write, _read, _writev, _readv, _put, _get,
   _putt, _gett, _writet, _readt,
-  _ctl
+  _ctl,
+  _startread, _startwrite
 };
 
 /**
@@ -224,13 +461,23 @@ void sduObjectInit(SerialUSBDriver *sdup) {
 
   sdup->vmt = &vmt;
   osalEventObjectInit(&sdup->event);
+  sdup->rxasync = NULL;
+  sdup->txasync = NULL;
+  sdup->obcoalesce = 0;
   sdup->state = SDU_STOP;
+#if SERIAL_USB_USE_SHARED_POOL == TRUE
+  /* In pool mode the queues are initialized at the first start, when the
+     geometry is known and the storage is reserved from the pool.*/
+  sdup->ib = NULL;
+  sdup->ob = NULL;
+#else
   ibqObjectInit(&sdup->ibqueue, true, sdup->ib,
                 SERIAL_USB_BUFFERS_SIZE, SERIAL_USB_BUFFERS_NUMBER,
                 ibnotify, sdup);
   obqObjectInit(&sdup->obqueue, true, sdup->ob,
                 SERIAL_USB_BUFFERS_SIZE, SERIAL_USB_BUFFERS_NUMBER,
                 obnotify, sdup);
+#endif
 }
 
 /**
@@ -249,6 +496,43 @@ void sduStart(SerialUSBDriver *sdup, const SerialUSBConfig *config) {
   osalSysLock();
   osalDbgAssert((sdup->state == SDU_STOP) || (sdup->state == SDU_READY),
                 "invalid state");
+  if (sdup->state == SDU_STOP) {
+    size_t bsize = (config->buffers_size != (size_t)0)
+                     ? config->buffers_size
+                     : (size_t)SERIAL_USB_BUFFERS_SIZE;
+    size_t ibn   = (config->in_buffers_number != (size_t)0)
+                     ? config->in_buffers_number
+                     : (size_t)SERIAL_USB_BUFFERS_NUMBER;
+    size_t obn   = (config->out_buffers_number != (size_t)0)
+                     ? config->out_buffers_number
+                     : (size_t)SERIAL_USB_BUFFERS_NUMBER;
+
+#if SERIAL_USB_USE_SHARED_POOL == TRUE
+    if (sdup->ib == NULL) {
+      sdup->ibsize = BQ_BUFFER_SIZE(ibn, bsize);
+      sdup->obsize = BQ_BUFFER_SIZE(obn, bsize);
+      sdup->ib = sdu_pool_reserve(sdup->ibsize);
+      sdup->ob = sdu_pool_reserve(sdup->obsize);
+      osalDbgAssert((sdup->ib != NULL) && (sdup->ob != NULL),
+                    "pool exhausted");
+    }
+    else {
+      /* The reservation is permanent, a restart cannot grow it.*/
+      osalDbgAssert((BQ_BUFFER_SIZE(ibn, bsize) <= sdup->ibsize) &&
+                    (BQ_BUFFER_SIZE(obn, bsize) <= sdup->obsize),
+                    "geometry exceeds reservation");
+    }
+#else
+    osalDbgAssert((BQ_BUFFER_SIZE(ibn, bsize) <= sizeof sdup->ib) &&
+                  (BQ_BUFFER_SIZE(obn, bsize) <= sizeof sdup->ob),
+                  "geometry exceeds embedded storage");
+#endif
+
+    ibqObjectInit(&sdup->ibqueue, true, sdup->ib, bsize, ibn,
+                  ibnotify, sdup);
+    obqObjectInit(&sdup->obqueue, true, sdup->ob, bsize, obn,
+                  obnotify, sdup);
+  }
   usbp->in_params[config->bulk_in - 1U]   = sdup;
   usbp->out_params[config->bulk_out - 1U] = sdup;
   if (config->int_in > 0U) {
@@ -289,6 +573,8 @@ void sduStop(SerialUSBDriver *sdup) {
 
   /* Enforces a disconnection.*/
   chnAddFlagsI(sdup, CHN_DISCONNECTED);
+  sdup->rxasync = NULL;
+  sdup->txasync = NULL;
   ibqResetI(&sdup->ibqueue);
   obqResetI(&sdup->obqueue);
   osalOsRescheduleS();
@@ -343,6 +629,9 @@ void sduWakeupHookI(SerialUSBDriver *sdup) {
  */
 void sduConfigureHookI(SerialUSBDriver *sdup) {
 
+  sdup->rxasync = NULL;
+  sdup->txasync = NULL;
+  sdup->obcoalesce = 0;
   ibqResetI(&sdup->ibqueue);
   bqResumeX(&sdup->ibqueue);
   obqResetI(&sdup->obqueue);
@@ -397,6 +686,7 @@ bool sduRequestsHook(USBDriver *usbp) {
  * @iclass
  */
 void sduSOFHookI(SerialUSBDriver *sdup) {
+  size_t pending;
 
   /* If the USB driver is not in the appropriate state then transactions
      must not be started.*/
@@ -411,6 +701,25 @@ void sduSOFHookI(SerialUSBDriver *sdup) {
     return;
   }
 
+  /* Nothing to do if there is no partially filled buffer pending.*/
+  pending = sdu_pending_bytes(sdup);
+  if (pending == (size_t)0) {
+    sdup->obcoalesce = 0;
+    return;
+  }
+
+  /* Write coalescing, the partial buffer is allowed to age for the
+     configured number of frames unless the fill threshold is reached,
+     small writes accumulate into fewer, larger transfers.*/
+  if ((sdup->config->coalesce_threshold == (size_t)0) ||
+      (pending < sdup->config->coalesce_threshold)) {
+    if (sdup->obcoalesce < sdup->config->coalesce_frames) {
+      sdup->obcoalesce++;
+      return;
+    }
+  }
+  sdup->obcoalesce = 0;
+
   /* Checking if there only a buffer partially filled, if so then it is
      enforced in the queue and transmitted.*/
   if (obqTryFlushI(&sdup->obqueue)) {
@@ -450,6 +759,10 @@ void sduDataTransmitted(USBDriver *usbp, usbep_t ep) {
     obqReleaseEmptyBufferI(&sdup->obqueue);
   }
 
+  /* Feeding a pending asynchronous write, if any, using the space just
+     made available.*/
+  sdu_async_tx_pump(sdup);
+
   /* Checking if there is a buffer ready for transmission.*/
   buf = obqGetFullBufferI(&sdup->obqueue, &n);
 
@@ -461,12 +774,25 @@ void sduDataTransmitted(USBDriver *usbp, usbep_t ep) {
   else if ((usbp->epc[ep]->in_state->txsize > 0U) &&
            ((usbp->epc[ep]->in_state->txsize &
             ((size_t)usbp->epc[ep]->in_maxsize - 1U)) == 0U)) {
-    /* Transmit zero sized packet in case the last one has maximum allowed
-       size. Otherwise the recipient may expect more data coming soon and
-       not return buffered data to app. See section 5.8.3 Bulk Transfer
-       Packet Size Constraints of the USB Specification document.*/
-    usbStartTransmitI(usbp, ep, usbp->setup, 0);
+    /* A zero sized packet would be required in case the last one has
+       maximum allowed size, if there is data pending in a partially
+       filled buffer then it is transmitted in its place, both
+       terminating the previous transfer and eliding the empty packet.*/
+    if (obqTryFlushI(&sdup->obqueue)) {
+      buf = obqGetFullBufferI(&sdup->obqueue, &n);
+
+      osalDbgAssert(buf != NULL, "queue is empty");
 
+      sdup->obcoalesce = 0;
+      usbStartTransmitI(usbp, ep, buf, n);
+    }
+    else {
+      /* Transmit zero sized packet in case the last one has maximum allowed
+         size. Otherwise the recipient may expect more data coming soon and
+         not return buffered data to app. See section 5.8.3 Bulk Transfer
+         Packet Size Constraints of the USB Specification document.*/
+      usbStartTransmitI(usbp, ep, usbp->setup, 0);
+    }
   }
   else {
     /* Nothing to transmit.*/
@@ -502,6 +828,9 @@ void sduDataReceived(USBDriver *usbp, usbep_t ep) {
 
     /* Posting the filled buffer in the queue.*/
     ibqPostFullBufferI(&sdup->ibqueue, size);
+
+    /* Feeding a pending asynchronous read, if any.*/
+    sdu_async_rx_pump(sdup);
   }
 
   /* The endpoint cannot be busy, we are in the context of the callback,
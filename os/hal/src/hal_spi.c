@@ -42,6 +42,39 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the operation described by a transaction descriptor.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] stp       pointer to the transaction descriptor
+ *
+ * @notapi
+ */
+static void spi_txn_start(SPIDriver *spip, spi_transaction_t *stp) {
+
+  if (stp->select) {
+    spiSelectI(spip);
+  }
+  if (stp->txbuf != NULL) {
+    if (stp->rxbuf != NULL) {
+      spiStartExchangeI(spip, stp->n, stp->txbuf, stp->rxbuf);
+    }
+    else {
+      spiStartSendI(spip, stp->n, stp->txbuf);
+    }
+  }
+  else {
+    if (stp->rxbuf != NULL) {
+      spiStartReceiveI(spip, stp->n, stp->rxbuf);
+    }
+    else {
+      spiStartIgnoreI(spip, stp->n);
+    }
+  }
+}
+#endif /* SPI_USE_TRANSACTIONS == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -75,6 +108,10 @@ void spiObjectInit(SPIDriver *spip) {
 #if SPI_USE_MUTUAL_EXCLUSION == TRUE
   osalMutexObjectInit(&spip->mutex);
 #endif
+#if SPI_USE_TRANSACTIONS == TRUE
+  spip->txnhead = NULL;
+  spip->txntail = NULL;
+#endif
 #if defined(SPI_DRIVER_EXT_INIT_HOOK)
   SPI_DRIVER_EXT_INIT_HOOK(spip);
 #endif
@@ -139,6 +176,9 @@ void spiSelect(SPIDriver *spip) {
 
   osalSysLock();
   osalDbgAssert(spip->state == SPI_READY, "not ready");
+#if SPI_SUPPORTS_SLAVE_MODE == TRUE
+  osalDbgAssert(!spip->config->slave, "slave mode");
+#endif
   spiSelectI(spip);
   osalSysUnlock();
 }
@@ -157,6 +197,9 @@ void spiUnselect(SPIDriver *spip) {
 
   osalSysLock();
   osalDbgAssert(spip->state == SPI_READY, "not ready");
+#if SPI_SUPPORTS_SLAVE_MODE == TRUE
+  osalDbgAssert(!spip->config->slave, "slave mode");
+#endif
   spiUnselectI(spip);
   osalSysUnlock();
 }
@@ -263,6 +306,118 @@ void spiStartReceive(SPIDriver *spip, size_t n, void *rxbuf) {
   osalSysUnlock();
 }
 
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Appends a chain of transactions to the driver queue.
+ * @details The chain is linked through the @p next fields and must be
+ *          @p NULL terminated. If the bus is idle then the first queued
+ *          transaction is started immediately, else it is started from
+ *          ISR context when the current transaction completes, the
+ *          queued transactions are executed back-to-back without
+ *          returning to thread context.
+ * @pre     In order to use this function the option @p SPI_USE_TRANSACTIONS
+ *          must be enabled.
+ * @pre     Queued transactions must not be mixed with the @p spiStartXXX()
+ *          and synchronous APIs, those must only be used while the
+ *          transaction queue is empty.
+ * @post    Each descriptor is released by the driver after invoking its
+ *          completion callback, if any.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] stp       pointer to the first transaction descriptor
+ *
+ * @iclass
+ */
+void spiPostTransactionI(SPIDriver *spip, spi_transaction_t *stp) {
+  spi_transaction_t *last = stp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((spip != NULL) && (stp != NULL) && (stp->n > 0U));
+  osalDbgAssert((spip->state == SPI_READY) || (spip->txnhead != NULL),
+                "not ready");
+
+  /* Locating the last descriptor of the submitted chain.*/
+  while (last->next != NULL) {
+    last = last->next;
+  }
+
+  /* Appending the chain to the queue.*/
+  if (spip->txnhead == NULL) {
+    spip->txnhead = stp;
+  }
+  else {
+    spip->txntail->next = stp;
+  }
+  spip->txntail = last;
+
+  /* If the bus is idle then the first transaction is started
+     immediately.*/
+  if (spip->state == SPI_READY) {
+    spi_txn_start(spip, spip->txnhead);
+  }
+}
+
+/**
+ * @brief   Appends a chain of transactions to the driver queue.
+ * @pre     In order to use this function the option @p SPI_USE_TRANSACTIONS
+ *          must be enabled.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] stp       pointer to the first transaction descriptor
+ *
+ * @api
+ */
+void spiPostTransaction(SPIDriver *spip, spi_transaction_t *stp) {
+
+  osalDbgCheck((spip != NULL) && (stp != NULL));
+
+  osalSysLock();
+  spiPostTransactionI(spip, stp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Advances the transaction queue after a transfer completion.
+ * @details The completed transaction is removed from the queue and the
+ *          next one, if any, is started before the completion callback is
+ *          invoked so the callback does not extend the inter-transaction
+ *          gap.
+ * @note    This function is meant to be invoked by @p _spi_isr_code()
+ *          only, not by the application.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void _spi_txn_advance(SPIDriver *spip) {
+  spi_transaction_t *stp = spip->txnhead;
+
+  /* Removing the completed transaction from the queue.*/
+  spip->txnhead = stp->next;
+  if (spip->txnhead == NULL) {
+    spip->txntail = NULL;
+  }
+
+  if (stp->select) {
+    spiUnselectI(spip);
+  }
+
+  /* The next queued transaction, if any, is started back-to-back, else
+     the bus becomes ready again.*/
+  if (spip->txnhead != NULL) {
+    spi_txn_start(spip, spip->txnhead);
+  }
+  else {
+    spip->state = SPI_READY;
+  }
+
+  /* Completion callback invoked after the bus has been restarted.*/
+  if (stp->callback != NULL) {
+    stp->callback(spip, stp);
+  }
+}
+#endif /* SPI_USE_TRANSACTIONS == TRUE */
+
 #if (SPI_SUPPORTS_CIRCULAR == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Aborts the ongoing SPI operation.
@@ -34,6 +34,16 @@
 /* Driver exported variables.                                                */
 /*===========================================================================*/
 
+#if (ST_LLD_NUM_ALARMS > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Callbacks of the additional alarms.
+ * @note    This array is accessed by the low level driver ISR, it must
+ *          not be manipulated directly, use @p stStartAlarmN() and
+ *          @p stStopAlarmN() instead.
+ */
+st_callback_t st_callbacks[ST_LLD_NUM_ALARMS - 1];
+#endif
+
 /*===========================================================================*/
 /* Driver local types.                                                       */
 /*===========================================================================*/
@@ -124,6 +134,51 @@ systime_t stGetAlarm(void) {
   return st_lld_get_alarm();
 }
 
+#if (ST_LLD_NUM_ALARMS > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an additional alarm.
+ * @details Additional alarms are independent hardware compare channels
+ *          of the system timer, events scheduled on them do not go
+ *          through the virtual timers list so the callback jitter is
+ *          only the interrupt latency.
+ * @note    The callback is invoked in ISR context.
+ * @note    This functionality is only available in free running mode, the
+ *          behavior in periodic mode is undefined.
+ *
+ * @param[in] alarm     alarm channel number, greater than zero
+ * @param[in] abstime   the time to be set for the first alarm
+ * @param[in] cb        alarm callback
+ *
+ * @api
+ */
+void stStartAlarmN(unsigned alarm, systime_t abstime, st_callback_t cb) {
+
+  osalDbgCheck((alarm > 0U) && (alarm < (unsigned)ST_LLD_NUM_ALARMS) &&
+               (cb != NULL));
+  osalDbgAssert(stIsAlarmActiveN(alarm) == false, "already active");
+
+  st_callbacks[alarm - 1U] = cb;
+  st_lld_start_alarm_n(alarm, abstime);
+}
+
+/**
+ * @brief   Stops an additional alarm.
+ * @note    This functionality is only available in free running mode, the
+ *          behavior in periodic mode is undefined.
+ *
+ * @param[in] alarm     alarm channel number, greater than zero
+ *
+ * @api
+ */
+void stStopAlarmN(unsigned alarm) {
+
+  osalDbgCheck((alarm > 0U) && (alarm < (unsigned)ST_LLD_NUM_ALARMS));
+
+  st_lld_stop_alarm_n(alarm);
+  st_callbacks[alarm - 1U] = NULL;
+}
+#endif /* ST_LLD_NUM_ALARMS > 1 */
+
 #endif /* OSAL_ST_MODE != OSAL_ST_MODE_NONE */
 
 /** @} */
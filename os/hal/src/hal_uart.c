@@ -79,6 +79,10 @@ void uartObjectInit(UARTDriver *uartp) {
 #if UART_USE_MUTUAL_EXCLUSION == TRUE
   osalMutexObjectInit(&uartp->mutex);
 #endif /* UART_USE_MUTUAL_EXCLUSION */
+#if UART_USE_RX_CHAIN == TRUE
+  uartp->rxchainbuf = NULL;
+  uartp->rxchainn   = 0;
+#endif /* UART_USE_RX_CHAIN */
 
   /* Optional, user-defined initializer.*/
 #if defined(UART_DRIVER_EXT_INIT_HOOK)
@@ -313,6 +317,9 @@ size_t uartStopReceive(UARTDriver *uartp) {
   else {
     n = 0;
   }
+#if UART_USE_RX_CHAIN == TRUE
+  uartp->rxchainbuf = NULL;
+#endif
   osalSysUnlock();
 
   return n;
@@ -340,10 +347,88 @@ size_t uartStopReceiveI(UARTDriver *uartp) {
   if (uartp->rxstate == UART_RX_ACTIVE) {
     size_t n = uart_lld_stop_receive(uartp);
     uartp->rxstate = UART_RX_IDLE;
+#if UART_USE_RX_CHAIN == TRUE
+    uartp->rxchainbuf = NULL;
+#endif
+    return n;
+  }
+  return 0;
+}
+
+#if (UART_USE_RX_CHAIN == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts or chains a receive operation on the UART peripheral.
+ * @details If the receiver is idle then the operation is started
+ *          immediately, else the buffer is armed as the next buffer in
+ *          the chain and is started from within the ISR when the current
+ *          operation completes, without a reception gap. Only one buffer
+ *          can be chained at a time.
+ * @note    The buffers are organized as uint8_t arrays for data sizes below
+ *          or equal to 8 bits else it is organized as uint16_t arrays.
+ * @note    This function has to be invoked from a lock zone.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] n         number of data frames to receive
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @iclass
+ */
+void uartStartReceiveChainI(UARTDriver *uartp, size_t n, void *rxbuf) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((uartp != NULL) && (n > 0U) && (rxbuf != NULL));
+  osalDbgAssert(uartp->state == UART_READY, "is active");
+
+  if (uartp->rxstate != UART_RX_ACTIVE) {
+    uart_lld_start_receive(uartp, n, rxbuf);
+    uartp->rxstate = UART_RX_ACTIVE;
+  }
+  else {
+    osalDbgAssert(uartp->rxchainbuf == NULL, "chain full");
+    uartp->rxchainbuf = rxbuf;
+    uartp->rxchainn   = n;
+  }
+}
+
+/**
+ * @brief   Completes the current receive operation early.
+ * @details The ongoing operation is stopped and, if a chained buffer is
+ *          armed, the chained buffer is started immediately. This function
+ *          is meant to be called from the receiver timeout or idle line
+ *          callback in order to deliver a partially filled buffer, the
+ *          number of frames received is the started size minus the
+ *          returned value. The receive callbacks are not invoked.
+ * @note    This function has to be invoked from a lock zone.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @return              The number of data frames not received by the
+ *                      completed receive operation.
+ * @retval 0            There was no receive operation in progress.
+ *
+ * @iclass
+ */
+size_t uartFinishReceiveI(UARTDriver *uartp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(uartp != NULL);
+  osalDbgAssert(uartp->state == UART_READY, "not active");
+
+  if (uartp->rxstate == UART_RX_ACTIVE) {
+    size_t n = uart_lld_stop_receive(uartp);
+
+    if (uartp->rxchainbuf != NULL) {
+      uart_lld_start_receive(uartp, uartp->rxchainn, uartp->rxchainbuf);
+      uartp->rxchainbuf = NULL;
+    }
+    else {
+      uartp->rxstate = UART_RX_IDLE;
+    }
     return n;
   }
   return 0;
 }
+#endif /* UART_USE_RX_CHAIN == TRUE */
 
 #if (UART_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
@@ -456,7 +456,23 @@ void usbStartReceiveI(USBDriver *usbp, usbep_t ep,
 
   osalDbgCheckClassI();
   osalDbgCheck((usbp != NULL) && (ep <= (usbep_t)USB_MAX_ENDPOINTS));
+
+#if USB_USE_TRANSFER_QUEUE == TRUE
+  if (usbGetReceiveStatusI(usbp, ep)) {
+    /* Endpoint busy, the transfer is queued and started from the ISR
+       when the active one completes.*/
+    osp = usbp->epc[ep]->out_state;
+
+    osalDbgAssert(!osp->next_pending, "transfer queue full");
+
+    osp->next_rxbuf   = buf;
+    osp->next_rxsize  = n;
+    osp->next_pending = true;
+    return;
+  }
+#else
   osalDbgAssert(!usbGetReceiveStatusI(usbp, ep), "already receiving");
+#endif
 
   /* Marking the endpoint as active.*/
   usbp->receiving |= (uint16_t)((unsigned)1U << (unsigned)ep);
@@ -495,7 +511,23 @@ void usbStartTransmitI(USBDriver *usbp, usbep_t ep,
 
   osalDbgCheckClassI();
   osalDbgCheck((usbp != NULL) && (ep <= (usbep_t)USB_MAX_ENDPOINTS));
+
+#if USB_USE_TRANSFER_QUEUE == TRUE
+  if (usbGetTransmitStatusI(usbp, ep)) {
+    /* Endpoint busy, the transfer is queued and started from the ISR
+       when the active one completes.*/
+    isp = usbp->epc[ep]->in_state;
+
+    osalDbgAssert(!isp->next_pending, "transfer queue full");
+
+    isp->next_txbuf   = buf;
+    isp->next_txsize  = n;
+    isp->next_pending = true;
+    return;
+  }
+#else
   osalDbgAssert(!usbGetTransmitStatusI(usbp, ep), "already transmitting");
+#endif
 
   /* Marking the endpoint as active.*/
   usbp->transmitting |= (uint16_t)((unsigned)1U << (unsigned)ep);
@@ -651,6 +683,105 @@ void usbWakeupHost(USBDriver *usbp) {
   }
 }
 
+#if (USB_USE_TRANSFER_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   IN transfer end handling.
+ * @details If a transfer is queued on the endpoint then it is started
+ *          back-to-back before invoking the endpoint callback and the
+ *          endpoint stays active, else the endpoint is released.
+ * @note    This function is not meant to be called directly by
+ *          applications, the low level drivers invoke it through the
+ *          @p _usb_isr_invoke_in_cb() macro.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void _usb_in_complete(USBDriver *usbp, usbep_t ep) {
+  USBInEndpointState *isp = usbp->epc[ep]->in_state;
+
+  if (isp->next_pending) {
+    /* Starting the queued transfer before notifying the completion, the
+       endpoint is re-armed within the ISR and no bus-idle gap is
+       introduced.*/
+    isp->next_pending = false;
+    isp->txbuf  = isp->next_txbuf;
+    isp->txsize = isp->next_txsize;
+    isp->txcnt  = 0;
+    osalSysLockFromISR();
+    usb_lld_start_in(usbp, ep);
+    osalSysUnlockFromISR();
+
+    if (usbp->epc[ep]->in_cb != NULL) {
+      usbp->epc[ep]->in_cb(usbp, ep);
+    }
+  }
+  else {
+    usbp->transmitting &= ~(uint16_t)((unsigned)1U << (unsigned)ep);
+    if (usbp->epc[ep]->in_cb != NULL) {
+      usbp->epc[ep]->in_cb(usbp, ep);
+    }
+#if USB_USE_WAIT == TRUE
+    osalSysLockFromISR();
+    osalThreadResumeI(&isp->thread, MSG_OK);
+    osalSysUnlockFromISR();
+#endif
+  }
+}
+
+/**
+ * @brief   OUT transfer end handling.
+ * @details If a transfer is queued on the endpoint then it is started
+ *          back-to-back within the completion ISR and the endpoint stays
+ *          active, else the endpoint is released.
+ * @note    This function is not meant to be called directly by
+ *          applications, the low level drivers invoke it through the
+ *          @p _usb_isr_invoke_out_cb() macro.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void _usb_out_complete(USBDriver *usbp, usbep_t ep) {
+  USBOutEndpointState *osp = usbp->epc[ep]->out_state;
+
+  if (osp->next_pending) {
+    uint8_t *nbuf  = osp->next_rxbuf;
+    size_t   nsize = osp->next_rxsize;
+
+    osp->next_pending = false;
+
+    /* The callback is invoked before re-arming because the transaction
+       size of the completed transfer must still be readable, the
+       endpoint is then re-armed within the same ISR.*/
+    if (usbp->epc[ep]->out_cb != NULL) {
+      usbp->epc[ep]->out_cb(usbp, ep);
+    }
+
+    osp->rxbuf  = nbuf;
+    osp->rxsize = nsize;
+    osp->rxcnt  = 0;
+    osalSysLockFromISR();
+    usb_lld_start_out(usbp, ep);
+    osalSysUnlockFromISR();
+  }
+  else {
+    usbp->receiving &= ~(uint16_t)((unsigned)1U << (unsigned)ep);
+    if (usbp->epc[ep]->out_cb != NULL) {
+      usbp->epc[ep]->out_cb(usbp, ep);
+    }
+#if USB_USE_WAIT == TRUE
+    osalSysLockFromISR();
+    osalThreadResumeI(&osp->thread,
+                      usbGetReceiveTransactionSizeX(usbp, ep));
+    osalSysUnlockFromISR();
+#endif
+  }
+}
+#endif /* USB_USE_TRANSFER_QUEUE == TRUE */
+
 /**
  * @brief   USB reset routine.
  * @details This function must be invoked when an USB bus reset condition is
@@ -993,6 +1124,159 @@ void _usb_ep0out(USBDriver *usbp, usbep_t ep) {
   }
 }
 
+#if (USB_USE_ISOCHRONOUS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p USBIsochronousTransfer object.
+ *
+ * @param[out] itp      pointer to the @p USBIsochronousTransfer object
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        isochronous endpoint number
+ * @param[in] in        endpoint direction, @p true for an IN endpoint
+ * @param[in] buf0      first frame buffer
+ * @param[in] buf1      second frame buffer
+ * @param[in] size      frame buffer size in bytes, it must not exceed
+ *                      the endpoint maximum packet size
+ * @param[in] cb        per-frame callback, can be @p NULL
+ *
+ * @init
+ */
+void usbIsoObjectInit(USBIsochronousTransfer *itp, USBDriver *usbp,
+                      usbep_t ep, bool in, uint8_t *buf0, uint8_t *buf1,
+                      size_t size, usbisocallback_t cb) {
+
+  osalDbgCheck((itp != NULL) && (usbp != NULL) && (ep > 0U) &&
+               (buf0 != NULL) && (buf1 != NULL) && (size > 0U));
+
+  itp->usbp    = usbp;
+  itp->ep      = ep;
+  itp->in      = in;
+  itp->buf[0]  = buf0;
+  itp->buf[1]  = buf1;
+  itp->size    = size;
+  itp->active  = 0U;
+  itp->running = false;
+  itp->cb      = cb;
+}
+
+/**
+ * @brief   Starts an isochronous transfer pump.
+ * @details The first buffer is put on the bus, from there on the
+ *          endpoint callbacks keep the endpoint armed frame by frame.
+ * @pre     The endpoint must have been initialized as an isochronous
+ *          endpoint with @p usbIsoInCallback() or @p usbIsoOutCallback()
+ *          as notification callback.
+ * @pre     For IN endpoints both buffers must have been filled with the
+ *          initial frames before starting.
+ *
+ * @param[in] itp       pointer to the @p USBIsochronousTransfer object
+ *
+ * @iclass
+ */
+void usbIsoStartI(USBIsochronousTransfer *itp) {
+  USBDriver *usbp = itp->usbp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(itp != NULL);
+
+  itp->active  = 0U;
+  itp->running = true;
+  if (itp->in) {
+    usbp->in_params[itp->ep - 1U] = itp;
+    usbStartTransmitI(usbp, itp->ep, itp->buf[0], itp->size);
+  }
+  else {
+    usbp->out_params[itp->ep - 1U] = itp;
+    usbStartReceiveI(usbp, itp->ep, itp->buf[0], itp->size);
+  }
+}
+
+/**
+ * @brief   Stops an isochronous transfer pump.
+ * @details The endpoint is no more re-armed after the frame currently
+ *          on the bus.
+ *
+ * @param[in] itp       pointer to the @p USBIsochronousTransfer object
+ *
+ * @iclass
+ */
+void usbIsoStopI(USBIsochronousTransfer *itp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(itp != NULL);
+
+  itp->running = false;
+  if (itp->in) {
+    itp->usbp->in_params[itp->ep - 1U] = NULL;
+  }
+  else {
+    itp->usbp->out_params[itp->ep - 1U] = NULL;
+  }
+}
+
+/**
+ * @brief   Default isochronous IN endpoint callback.
+ * @details The application must use this function as callback for the
+ *          pumped isochronous IN endpoint. The next frame transfer is
+ *          started on the other buffer before the per-frame callback is
+ *          invoked, so the refill happens while the bus is busy.
+ * @note    The low level drivers invoke this callback also when an
+ *          isochronous frame fails, the endpoint is then re-armed for
+ *          the next frame.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        IN endpoint number
+ */
+void usbIsoInCallback(USBDriver *usbp, usbep_t ep) {
+  USBIsochronousTransfer *itp = usbp->in_params[ep - 1U];
+  unsigned done;
+
+  if ((itp == NULL) || !itp->running) {
+    return;
+  }
+
+  done = itp->active;
+  itp->active = done ^ 1U;
+  osalSysLockFromISR();
+  usbStartTransmitI(usbp, ep, itp->buf[itp->active], itp->size);
+  osalSysUnlockFromISR();
+
+  if (itp->cb != NULL) {
+    itp->cb(usbp, ep, itp->buf[done], itp->size);
+  }
+}
+
+/**
+ * @brief   Default isochronous OUT endpoint callback.
+ * @details The application must use this function as callback for the
+ *          pumped isochronous OUT endpoint. The next frame reception is
+ *          started on the other buffer before the per-frame callback is
+ *          invoked, so the consumption happens while the bus is busy.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        OUT endpoint number
+ */
+void usbIsoOutCallback(USBDriver *usbp, usbep_t ep) {
+  USBIsochronousTransfer *itp = usbp->out_params[ep - 1U];
+  unsigned done;
+  size_t n;
+
+  if ((itp == NULL) || !itp->running) {
+    return;
+  }
+
+  n = usbGetReceiveTransactionSizeX(usbp, ep);
+  done = itp->active;
+  itp->active = done ^ 1U;
+  osalSysLockFromISR();
+  usbStartReceiveI(usbp, ep, itp->buf[itp->active], itp->size);
+  osalSysUnlockFromISR();
+
+  if (itp->cb != NULL) {
+    itp->cb(usbp, ep, itp->buf[done], n);
+  }
+}
+#endif /* USB_USE_ISOCHRONOUS == TRUE */
+
 #endif /* HAL_USE_USB == TRUE */
 
 /** @} */
@@ -0,0 +1,893 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_msc.c
+ * @brief   USB Mass Storage Class Driver code.
+ * @details The driver implements the Bulk-Only Transport protocol and a
+ *          SCSI transparent command set sufficient for all major host
+ *          operating systems, exposing any @p BaseBlockDevice to the
+ *          host. Data phases are pipelined using two buffers: while one
+ *          buffer streams over the bulk endpoint the storage transfer of
+ *          the next chunk is already in progress, overlapping the card
+ *          access time with the USB transfer time.
+ *
+ * @addtogroup USB_MSC
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_USB_MSC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Zero returned by the Get Max LUN request, single LUN devices.
+ */
+static const uint8_t msc_zero_lun = 0U;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Big endian 16 bits field extraction.
+ */
+static uint32_t msc_get_be16(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 8) | (uint32_t)p[1];
+}
+
+/**
+ * @brief   Big endian 32 bits field extraction.
+ */
+static uint32_t msc_get_be32(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+}
+
+/**
+ * @brief   Big endian 32 bits field store.
+ */
+static void msc_put_be32(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+/**
+ * @brief   Copies an identification string padding with spaces.
+ */
+static void msc_scsi_strcpy(uint8_t *dst, const char *src, size_t n) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    if ((src != NULL) && (*src != '\0')) {
+      dst[i] = (uint8_t)*src++;
+    }
+    else {
+      dst[i] = (uint8_t)' ';
+    }
+  }
+}
+
+/**
+ * @brief   Updates the stored sense data.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] key       sense key
+ * @param[in] asc       additional sense code
+ * @param[in] ascq      additional sense code qualifier
+ *
+ * @notapi
+ */
+static void msc_set_sense(USBMassStorageDriver *mscp, uint8_t key,
+                          uint8_t asc, uint8_t ascq) {
+
+  memset(mscp->sense, 0, sizeof mscp->sense);
+  mscp->sense[0]  = 0x70U;              /* Fixed format, current error.     */
+  mscp->sense[2]  = key;
+  mscp->sense[7]  = 10U;                /* Additional sense length.         */
+  mscp->sense[12] = asc;
+  mscp->sense[13] = ascq;
+}
+
+/**
+ * @brief   Waits until an endpoint event flag becomes set.
+ * @details The flag is consumed on exit. The wait is interrupted by USB
+ *          reset, suspend or driver stop.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] flagp     pointer to the flag to be waited on
+ *
+ * @return              The wait status.
+ * @retval MSG_OK       the event occurred.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_wait_flag(USBMassStorageDriver *mscp, bool *flagp) {
+  msg_t msg = MSG_OK;
+
+  osalSysLock();
+  while (!*flagp) {
+    if ((mscp->state != MSC_READY) ||
+        (usbGetDriverStateI(mscp->config->usbp) != USB_ACTIVE)) {
+      msg = MSG_RESET;
+      break;
+    }
+    msg = osalThreadEnqueueTimeoutS(&mscp->waiting, TIME_INFINITE);
+    if (msg != MSG_OK) {
+      break;
+    }
+  }
+  if (msg == MSG_OK) {
+    *flagp = false;
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Starts a transmission on the bulk IN endpoint.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] buf       data to be transmitted
+ * @param[in] n         number of bytes to be transmitted
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       transaction started.
+ * @retval MSG_RESET    the USB device is not active.
+ *
+ * @notapi
+ */
+static msg_t msc_start_transmit(USBMassStorageDriver *mscp,
+                                const uint8_t *buf, size_t n) {
+  USBDriver *usbp = mscp->config->usbp;
+
+  osalSysLock();
+  if (usbGetDriverStateI(usbp) != USB_ACTIVE) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  mscp->in_done = false;
+  usbStartTransmitI(usbp, mscp->config->bulk_in, buf, n);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Starts a reception on the bulk OUT endpoint.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[out] buf      receive buffer
+ * @param[in] n         maximum number of bytes to be received
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       transaction started.
+ * @retval MSG_RESET    the USB device is not active.
+ *
+ * @notapi
+ */
+static msg_t msc_start_receive(USBMassStorageDriver *mscp,
+                               uint8_t *buf, size_t n) {
+  USBDriver *usbp = mscp->config->usbp;
+
+  osalSysLock();
+  if (usbGetDriverStateI(usbp) != USB_ACTIVE) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  mscp->out_done = false;
+  usbStartReceiveI(usbp, mscp->config->bulk_out, buf, n);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Performs a complete transmission on the bulk IN endpoint.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] buf       data to be transmitted
+ * @param[in] n         number of bytes to be transmitted
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       transaction performed.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_transmit(USBMassStorageDriver *mscp,
+                          const uint8_t *buf, size_t n) {
+  msg_t msg;
+
+  msg = msc_start_transmit(mscp, buf, n);
+  if (msg == MSG_OK) {
+    msg = msc_wait_flag(mscp, &mscp->in_done);
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Performs a complete reception on the bulk OUT endpoint.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[out] buf      receive buffer
+ * @param[in] n         maximum number of bytes to be received
+ * @param[out] np       received bytes, can be @p NULL
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       transaction performed.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_receive(USBMassStorageDriver *mscp,
+                         uint8_t *buf, size_t n, size_t *np) {
+  msg_t msg;
+
+  msg = msc_start_receive(mscp, buf, n);
+  if (msg == MSG_OK) {
+    msg = msc_wait_flag(mscp, &mscp->out_done);
+  }
+  if ((msg == MSG_OK) && (np != NULL)) {
+    *np = usbGetReceiveTransactionSizeX(mscp->config->usbp,
+                                        mscp->config->bulk_out);
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Stalls the bulk IN endpoint.
+ *
+ * @notapi
+ */
+static void msc_stall_in(USBMassStorageDriver *mscp) {
+
+  osalSysLock();
+  (void) usbStallTransmitI(mscp->config->usbp, mscp->config->bulk_in);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stalls the bulk OUT endpoint.
+ *
+ * @notapi
+ */
+static void msc_stall_out(USBMassStorageDriver *mscp) {
+
+  osalSysLock();
+  (void) usbStallReceiveI(mscp->config->usbp, mscp->config->bulk_out);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Sends a data-in response, shorter than the host expectation
+ *          if necessary.
+ * @details The CSW residue is updated with the amount of data not
+ *          transferred.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] buf       response data
+ * @param[in] n         response size in bytes
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       response sent.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_send_response(USBMassStorageDriver *mscp,
+                               const uint8_t *buf, size_t n) {
+  msg_t msg = MSG_OK;
+
+  if (n > (size_t)mscp->cbw.data_len) {
+    n = (size_t)mscp->cbw.data_len;
+  }
+  if (n > 0U) {
+    msg = msc_transmit(mscp, buf, n);
+  }
+  if (msg == MSG_OK) {
+    mscp->csw.data_residue = mscp->cbw.data_len - (uint32_t)n;
+    mscp->csw.status = MSC_CSW_STATUS_PASSED;
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Fails the current command.
+ * @details The sense data is updated and, if the command carries a data
+ *          phase, the corresponding endpoint is stalled so that the host
+ *          can detect the short transfer.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] key       sense key
+ * @param[in] asc       additional sense code
+ *
+ * @notapi
+ */
+static void msc_fail_command(USBMassStorageDriver *mscp,
+                             uint8_t key, uint8_t asc) {
+
+  msc_set_sense(mscp, key, asc, 0U);
+  if (mscp->cbw.data_len > 0U) {
+    if ((mscp->cbw.flags & MSC_CBW_FLAGS_DIR_IN) != 0U) {
+      msc_stall_in(mscp);
+    }
+    else {
+      msc_stall_out(mscp);
+    }
+  }
+  mscp->csw.data_residue = mscp->cbw.data_len;
+  mscp->csw.status = MSC_CSW_STATUS_FAILED;
+}
+
+/**
+ * @brief   Handles a READ (10) command with a pipelined data phase.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] bdip      pointer to the block device information
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       command handled, CSW prepared.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_scsi_read(USBMassStorageDriver *mscp,
+                           const BlockDeviceInfo *bdip) {
+  uint32_t lba, nblk, cnt, maxblk;
+  uint32_t transferred = 0U;
+  unsigned idx = 0U;
+  msg_t msg;
+
+  lba  = msc_get_be32(&mscp->cbw.cmd[2]);
+  nblk = msc_get_be16(&mscp->cbw.cmd[7]);
+
+  if (nblk == 0U) {
+    mscp->csw.data_residue = mscp->cbw.data_len;
+    mscp->csw.status = MSC_CSW_STATUS_PASSED;
+    return MSG_OK;
+  }
+
+  if ((lba + nblk) > bdip->blk_num) {
+    msc_fail_command(mscp, SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+                     SCSI_ASC_LBA_OUT_OF_RANGE);
+    return MSG_OK;
+  }
+
+  maxblk = (uint32_t)USB_MSC_BUFFERS_SIZE / bdip->blk_size;
+  cnt = nblk > maxblk ? maxblk : nblk;
+
+  /* Pre-filling the first buffer, subsequent chunks are read while the
+     previous one streams over the bulk IN endpoint.*/
+  if (blkRead(mscp->config->blkp, lba, mscp->buf[0], cnt) == HAL_FAILED) {
+    msc_fail_command(mscp, SCSI_SENSE_KEY_MEDIUM_ERROR,
+                     SCSI_ASC_UNRECOVERED_READ_ERROR);
+    return MSG_OK;
+  }
+
+  while (cnt > 0U) {
+    uint32_t next;
+    bool read_ok = true;
+
+    msg = msc_start_transmit(mscp, mscp->buf[idx], cnt * bdip->blk_size);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+
+    /* Next storage chunk overlapped with the ongoing USB transfer.*/
+    lba  += cnt;
+    nblk -= cnt;
+    next  = nblk > maxblk ? maxblk : nblk;
+    if (next > 0U) {
+      read_ok = blkRead(mscp->config->blkp, lba,
+                        mscp->buf[idx ^ 1U], next) == HAL_SUCCESS;
+    }
+
+    msg = msc_wait_flag(mscp, &mscp->in_done);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+    transferred += cnt * bdip->blk_size;
+
+    if (!read_ok) {
+      msc_set_sense(mscp, SCSI_SENSE_KEY_MEDIUM_ERROR,
+                    SCSI_ASC_UNRECOVERED_READ_ERROR, 0U);
+      msc_stall_in(mscp);
+      mscp->csw.data_residue = mscp->cbw.data_len - transferred;
+      mscp->csw.status = MSC_CSW_STATUS_FAILED;
+      return MSG_OK;
+    }
+
+    cnt = next;
+    idx ^= 1U;
+  }
+
+  mscp->csw.data_residue = mscp->cbw.data_len - transferred;
+  mscp->csw.status = MSC_CSW_STATUS_PASSED;
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Handles a WRITE (10) command with a pipelined data phase.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ * @param[in] bdip      pointer to the block device information
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       command handled, CSW prepared.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_scsi_write(USBMassStorageDriver *mscp,
+                            const BlockDeviceInfo *bdip) {
+  uint32_t lba, nblk, cnt, maxblk;
+  uint32_t transferred = 0U;
+  unsigned idx = 0U;
+  msg_t msg;
+
+  lba  = msc_get_be32(&mscp->cbw.cmd[2]);
+  nblk = msc_get_be16(&mscp->cbw.cmd[7]);
+
+  if (nblk == 0U) {
+    mscp->csw.data_residue = mscp->cbw.data_len;
+    mscp->csw.status = MSC_CSW_STATUS_PASSED;
+    return MSG_OK;
+  }
+
+  if ((lba + nblk) > bdip->blk_num) {
+    msc_fail_command(mscp, SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+                     SCSI_ASC_LBA_OUT_OF_RANGE);
+    return MSG_OK;
+  }
+
+  if (blkIsWriteProtected(mscp->config->blkp)) {
+    msc_fail_command(mscp, SCSI_SENSE_KEY_DATA_PROTECT,
+                     SCSI_ASC_WRITE_PROTECTED);
+    return MSG_OK;
+  }
+
+  maxblk = (uint32_t)USB_MSC_BUFFERS_SIZE / bdip->blk_size;
+  cnt = nblk > maxblk ? maxblk : nblk;
+
+  msg = msc_start_receive(mscp, mscp->buf[0], cnt * bdip->blk_size);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  while (cnt > 0U) {
+    uint32_t next;
+    bool write_ok;
+
+    msg = msc_wait_flag(mscp, &mscp->out_done);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+
+    /* Reception of the next chunk overlapped with the storage write of
+       the current one.*/
+    nblk -= cnt;
+    next  = nblk > maxblk ? maxblk : nblk;
+    if (next > 0U) {
+      msg = msc_start_receive(mscp, mscp->buf[idx ^ 1U],
+                              next * bdip->blk_size);
+      if (msg != MSG_OK) {
+        return msg;
+      }
+    }
+
+    write_ok = blkWrite(mscp->config->blkp, lba,
+                        mscp->buf[idx], cnt) == HAL_SUCCESS;
+    lba += cnt;
+    transferred += cnt * bdip->blk_size;
+
+    if (!write_ok) {
+      msc_set_sense(mscp, SCSI_SENSE_KEY_MEDIUM_ERROR,
+                    SCSI_ASC_WRITE_FAULT, 0U);
+      msc_stall_out(mscp);
+      mscp->csw.data_residue = mscp->cbw.data_len - transferred;
+      mscp->csw.status = MSC_CSW_STATUS_FAILED;
+      return MSG_OK;
+    }
+
+    cnt = next;
+    idx ^= 1U;
+  }
+
+  mscp->csw.data_residue = mscp->cbw.data_len - transferred;
+  mscp->csw.status = MSC_CSW_STATUS_PASSED;
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Dispatches the SCSI command contained in the current CBW.
+ *
+ * @param[in] mscp      pointer to the @p USBMassStorageDriver object
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       command handled, CSW prepared.
+ * @retval MSG_RESET    the bus has been reset or the driver stopped.
+ *
+ * @notapi
+ */
+static msg_t msc_scsi_dispatch(USBMassStorageDriver *mscp) {
+  BlockDeviceInfo bdi;
+  uint8_t b[36];
+
+  switch (mscp->cbw.cmd[0]) {
+  case SCSI_CMD_INQUIRY:
+    memset(b, 0, 36);
+    b[1] = 0x80U;                       /* Removable medium.                */
+    b[3] = 0x02U;                       /* Response data format.            */
+    b[4] = 31U;                         /* Additional length.               */
+    msc_scsi_strcpy(&b[8], mscp->config->vendor_id, 8U);
+    msc_scsi_strcpy(&b[16], mscp->config->product_id, 16U);
+    msc_scsi_strcpy(&b[32], mscp->config->product_rev, 4U);
+    return msc_send_response(mscp, b, 36U);
+
+  case SCSI_CMD_REQUEST_SENSE:
+  {
+    msg_t msg = msc_send_response(mscp, mscp->sense, sizeof mscp->sense);
+
+    /* Sense data is consumed by the request.*/
+    msc_set_sense(mscp, SCSI_SENSE_KEY_NO_SENSE, 0U, 0U);
+    return msg;
+  }
+
+  case SCSI_CMD_TEST_UNIT_READY:
+    if (blkGetDriverState(mscp->config->blkp) != BLK_READY) {
+      msc_fail_command(mscp, SCSI_SENSE_KEY_NOT_READY,
+                       SCSI_ASC_MEDIUM_NOT_PRESENT);
+      return MSG_OK;
+    }
+    mscp->csw.data_residue = mscp->cbw.data_len;
+    mscp->csw.status = MSC_CSW_STATUS_PASSED;
+    return MSG_OK;
+
+  case SCSI_CMD_MODE_SENSE_6:
+    b[0] = 3U;                          /* Mode data length.                */
+    b[1] = 0U;
+    b[2] = blkIsWriteProtected(mscp->config->blkp) ? 0x80U : 0x00U;
+    b[3] = 0U;
+    return msc_send_response(mscp, b, 4U);
+
+  case SCSI_CMD_START_STOP_UNIT:
+  case SCSI_CMD_PREVENT_ALLOW_REMOVAL:
+  case SCSI_CMD_VERIFY_10:
+    mscp->csw.data_residue = mscp->cbw.data_len;
+    mscp->csw.status = MSC_CSW_STATUS_PASSED;
+    return MSG_OK;
+
+  case SCSI_CMD_READ_CAPACITY_10:
+    if (blkGetInfo(mscp->config->blkp, &bdi) == HAL_FAILED) {
+      msc_fail_command(mscp, SCSI_SENSE_KEY_NOT_READY,
+                       SCSI_ASC_MEDIUM_NOT_PRESENT);
+      return MSG_OK;
+    }
+    msc_put_be32(&b[0], bdi.blk_num - 1U);
+    msc_put_be32(&b[4], bdi.blk_size);
+    return msc_send_response(mscp, b, 8U);
+
+  case SCSI_CMD_READ_FORMAT_CAPACITIES:
+    if (blkGetInfo(mscp->config->blkp, &bdi) == HAL_FAILED) {
+      msc_fail_command(mscp, SCSI_SENSE_KEY_NOT_READY,
+                       SCSI_ASC_MEDIUM_NOT_PRESENT);
+      return MSG_OK;
+    }
+    memset(b, 0, 12);
+    b[3] = 8U;                          /* Capacity list length.            */
+    msc_put_be32(&b[4], bdi.blk_num);
+    msc_put_be32(&b[8], bdi.blk_size);
+    b[8] = 0x02U;                       /* Formatted media descriptor.      */
+    return msc_send_response(mscp, b, 12U);
+
+  case SCSI_CMD_READ_10:
+  case SCSI_CMD_WRITE_10:
+    if (blkGetInfo(mscp->config->blkp, &bdi) == HAL_FAILED) {
+      msc_fail_command(mscp, SCSI_SENSE_KEY_NOT_READY,
+                       SCSI_ASC_MEDIUM_NOT_PRESENT);
+      return MSG_OK;
+    }
+    osalDbgAssert((bdi.blk_size <= (uint32_t)USB_MSC_BUFFERS_SIZE) &&
+                  (((uint32_t)USB_MSC_BUFFERS_SIZE % bdi.blk_size) == 0U),
+                  "invalid block size");
+    if (mscp->cbw.cmd[0] == SCSI_CMD_READ_10) {
+      return msc_scsi_read(mscp, &bdi);
+    }
+    return msc_scsi_write(mscp, &bdi);
+
+  default:
+    msc_fail_command(mscp, SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+                     SCSI_ASC_INVALID_COMMAND);
+    return MSG_OK;
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p USBMassStorageDriver structure.
+ *
+ * @param[out] mscp     pointer to a @p USBMassStorageDriver structure
+ *
+ * @init
+ */
+void mscObjectInit(USBMassStorageDriver *mscp) {
+
+  mscp->state    = MSC_STOP;
+  mscp->config   = NULL;
+  mscp->in_done  = false;
+  mscp->out_done = false;
+  osalThreadQueueObjectInit(&mscp->waiting);
+  msc_set_sense(mscp, SCSI_SENSE_KEY_NO_SENSE, 0U, 0U);
+}
+
+/**
+ * @brief   Configures and starts the driver.
+ *
+ * @param[in] mscp      pointer to a @p USBMassStorageDriver object
+ * @param[in] config    the USB mass storage driver configuration
+ *
+ * @api
+ */
+void mscStart(USBMassStorageDriver *mscp, const USBMassStorageConfig *config) {
+  USBDriver *usbp = config->usbp;
+
+  osalDbgCheck(mscp != NULL);
+
+  osalSysLock();
+  osalDbgAssert((mscp->state == MSC_STOP) || (mscp->state == MSC_READY),
+                "invalid state");
+  usbp->in_params[config->bulk_in - 1U]   = mscp;
+  usbp->out_params[config->bulk_out - 1U] = mscp;
+  mscp->config = config;
+  mscp->state = MSC_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops the driver.
+ * @details A thread suspended inside @p mscPerformTransaction() is
+ *          awakened and the function returns @p HAL_FAILED.
+ *
+ * @param[in] mscp      pointer to a @p USBMassStorageDriver object
+ *
+ * @api
+ */
+void mscStop(USBMassStorageDriver *mscp) {
+  USBDriver *usbp = mscp->config->usbp;
+
+  osalDbgCheck(mscp != NULL);
+
+  osalSysLock();
+
+  osalDbgAssert((mscp->state == MSC_STOP) || (mscp->state == MSC_READY),
+                "invalid state");
+
+  usbp->in_params[mscp->config->bulk_in - 1U]   = NULL;
+  usbp->out_params[mscp->config->bulk_out - 1U] = NULL;
+  mscp->config = NULL;
+  mscp->state  = MSC_STOP;
+
+  osalThreadDequeueAllI(&mscp->waiting, MSG_RESET);
+  osalOsRescheduleS();
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Performs one Bulk-Only Transport transaction.
+ * @details The function receives a CBW, executes the contained SCSI
+ *          command, then sends the CSW. It must be invoked in a loop
+ *          from a dedicated thread. Data phases of READ (10) and
+ *          WRITE (10) are pipelined: the storage transfer of each chunk
+ *          is overlapped with the USB transfer of the previous one.
+ * @pre     The driver must be in the @p MSC_READY state and the USB
+ *          endpoints must have been initialized by the application on
+ *          the @p USB_EVENT_CONFIGURED event.
+ *
+ * @param[in] mscp      pointer to a @p USBMassStorageDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  a transaction has been completed.
+ * @retval HAL_FAILED   the USB device is not active, the caller should
+ *                      delay before retrying.
+ *
+ * @api
+ */
+bool mscPerformTransaction(USBMassStorageDriver *mscp) {
+  size_t n;
+  msg_t msg;
+
+  osalDbgCheck(mscp != NULL);
+  osalDbgAssert(mscp->state == MSC_READY, "invalid state");
+
+  /* Next CBW, the reception is started as soon as the previous
+     transaction has been closed.*/
+  msg = msc_receive(mscp, (uint8_t *)&mscp->cbw, MSC_CBW_SIZE, &n);
+  if (msg != MSG_OK) {
+    return HAL_FAILED;
+  }
+
+  /* CBW validity checks as per the Bulk-Only Transport specification,
+     an invalid CBW causes both endpoints to stall until a reset
+     recovery is performed by the host.*/
+  if ((n != (size_t)MSC_CBW_SIZE) ||
+      (mscp->cbw.signature != MSC_CBW_SIGNATURE) ||
+      (mscp->cbw.lun != 0U) ||
+      (mscp->cbw.cmd_len < 1U) || (mscp->cbw.cmd_len > 16U)) {
+    msc_stall_in(mscp);
+    msc_stall_out(mscp);
+    return HAL_SUCCESS;
+  }
+
+  mscp->csw.signature = MSC_CSW_SIGNATURE;
+  mscp->csw.tag = mscp->cbw.tag;
+
+  msg = msc_scsi_dispatch(mscp);
+  if (msg != MSG_OK) {
+    return HAL_FAILED;
+  }
+
+  /* Status phase, a stalled IN endpoint is cleared by the host before
+     it picks up the CSW.*/
+  msg = msc_transmit(mscp, (const uint8_t *)&mscp->csw, MSC_CSW_SIZE);
+  if (msg != MSG_OK) {
+    return HAL_FAILED;
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   USB device configured handler.
+ * @details Any transaction in progress is aborted so that the worker
+ *          thread restarts from a clean CBW phase.
+ *
+ * @param[in] mscp      pointer to a @p USBMassStorageDriver object
+ *
+ * @iclass
+ */
+void mscConfigureHookI(USBMassStorageDriver *mscp) {
+
+  mscp->in_done  = false;
+  mscp->out_done = false;
+  osalThreadDequeueAllI(&mscp->waiting, MSG_RESET);
+}
+
+/**
+ * @brief   USB device suspend handler.
+ * @details The worker thread is awakened so that it does not remain
+ *          stuck in the middle of a transaction while the bus is down.
+ * @note    This handler must also be invoked on the @p USB_EVENT_RESET
+ *          and @p USB_EVENT_UNCONFIGURED events.
+ *
+ * @param[in] mscp      pointer to a @p USBMassStorageDriver object
+ *
+ * @iclass
+ */
+void mscSuspendHookI(USBMassStorageDriver *mscp) {
+
+  osalThreadDequeueAllI(&mscp->waiting, MSG_RESET);
+}
+
+/**
+ * @brief   Default requests hook.
+ * @details Applications wanting to use the USB mass storage driver can
+ *          use this function as requests hook in the USB configuration.
+ *          The following requests are emulated:
+ *          - MSC_REQ_GET_MAX_LUN.
+ *          - MSC_REQ_RESET.
+ *          .
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @return              The hook status.
+ * @retval true         Message handled internally.
+ * @retval false        Message not handled.
+ */
+bool mscRequestsHook(USBDriver *usbp) {
+
+  if ((usbp->setup[0] & USB_RTYPE_TYPE_MASK) == USB_RTYPE_TYPE_CLASS) {
+    switch (usbp->setup[1]) {
+    case MSC_REQ_GET_MAX_LUN:
+      /* Single LUN devices.*/
+      usbSetupTransfer(usbp, (uint8_t *)&msc_zero_lun, 1, NULL);
+      return true;
+    case MSC_REQ_RESET:
+      /* Bulk-Only Mass Storage Reset, the next CBW is awaited by the
+         worker thread in any case.*/
+      usbSetupTransfer(usbp, NULL, 0, NULL);
+      return true;
+    default:
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief   Default data transmitted callback.
+ * @details The application must use this function as callback for the
+ *          bulk IN endpoint.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        IN endpoint number
+ */
+void mscDataTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBMassStorageDriver *mscp = usbp->in_params[ep - 1U];
+
+  if (mscp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+  mscp->in_done = true;
+  osalThreadDequeueNextI(&mscp->waiting, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Default data received callback.
+ * @details The application must use this function as callback for the
+ *          bulk OUT endpoint.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        OUT endpoint number
+ */
+void mscDataReceived(USBDriver *usbp, usbep_t ep) {
+  USBMassStorageDriver *mscp = usbp->out_params[ep - 1U];
+
+  if (mscp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+  mscp->out_done = true;
+  osalThreadDequeueNextI(&mscp->waiting, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+#endif /* HAL_USE_USB_MSC == TRUE */
+
+/** @} */
@@ -237,6 +237,21 @@ void can_lld_wakeup(CANDriver *canp) {
 }
 #endif /* CAN_USE_SLEEP_MOD == TRUEE */
 
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the bus-off recovery sequence.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_recover(CANDriver *canp) {
+
+  (void)canp;
+
+}
+#endif /* CAN_USE_ERROR_MONITOR */
+
 #endif /* HAL_USE_CAN == TRUE */
 
 /** @} */
@@ -229,6 +229,42 @@ struct CANDriver {
   can_callback_t            wakeup_cb;
 #endif
 #endif
+#if (CAN_USE_TX_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the priority-sorted software TX queue.
+   */
+  can_tx_slot_t             *txhead;
+  /**
+   * @brief   Head of the free TX slots list.
+   */
+  can_tx_slot_t             *txfree;
+#endif /* CAN_USE_TX_QUEUE */
+#if (CAN_USE_ERROR_MONITOR == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Error statistics.
+   */
+  can_stats_t               stats;
+  /**
+   * @brief   Automatic bus-off recovery enable flag.
+   */
+  bool                      rec_enabled;
+  /**
+   * @brief   Maximum number of recoveries per observation window.
+   */
+  uint32_t                  rec_limit;
+  /**
+   * @brief   Observation window length.
+   */
+  sysinterval_t             rec_window;
+  /**
+   * @brief   Start time of the current observation window.
+   */
+  systime_t                 rec_start;
+  /**
+   * @brief   Recoveries performed in the current observation window.
+   */
+  uint32_t                  rec_count;
+#endif /* CAN_USE_ERROR_MONITOR */
   /* End of the mandatory fields.*/
 };
 
@@ -236,6 +272,24 @@ struct CANDriver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   Returns the transmit error counter (TEC).
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+#define can_lld_get_transmit_errors(canp) ((uint8_t)0)
+
+/**
+ * @brief   Returns the receive error counter (REC).
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+#define can_lld_get_receive_errors(canp) ((uint8_t)0)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -262,6 +316,9 @@ extern "C" {
   void can_lld_sleep(CANDriver *canp);
   void can_lld_wakeup(CANDriver *canp);
 #endif
+#if CAN_USE_ERROR_MONITOR == TRUE
+  void can_lld_recover(CANDriver *canp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -98,6 +98,12 @@ struct GPTDriver {
    * @brief Current configuration data.
    */
   const GPTConfig           *config;
+#if (GPT_USE_COUNTER64 == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Counter overflows accumulator.
+   */
+  volatile uint32_t         wraps;
+#endif /* GPT_USE_COUNTER64 */
 #if defined(GPT_DRIVER_EXT_FIELDS)
   GPT_DRIVER_EXT_FIELDS
 #endif
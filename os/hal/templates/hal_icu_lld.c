@@ -182,6 +182,32 @@ void icu_lld_disable_notifications(ICUDriver *icup) {
   (void)icup;
 }
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a buffered capture.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ *
+ * @notapi
+ */
+void icu_lld_start_buffered_capture(ICUDriver *icup) {
+
+  (void)icup;
+}
+
+/**
+ * @brief   Stops a buffered capture.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ *
+ * @notapi
+ */
+void icu_lld_stop_buffered_capture(ICUDriver *icup) {
+
+  (void)icup;
+}
+#endif /* ICU_USE_BUFFERED_CAPTURE == TRUE */
+
 #endif /* HAL_USE_ICU == TRUE */
 
 /** @} */
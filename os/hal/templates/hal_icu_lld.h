@@ -75,6 +75,18 @@ typedef uint32_t icufreq_t;
  */
 typedef uint32_t icucnt_t;
 
+#if (ICU_USE_BUFFERED_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   ICU buffered capture callback type.
+ *
+ * @param[in] icup      pointer to a @p ICUDriver object
+ * @param[in] buffer    pointer to the completed half ring
+ * @param[in] n         number of values in the half ring
+ */
+typedef void (*icubufcallback_t)(ICUDriver *icup, const icucnt_t *buffer,
+                                 size_t n);
+#endif
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -117,6 +129,20 @@ struct ICUDriver {
    * @brief Current configuration data.
    */
   const ICUConfig           *config;
+#if ICU_USE_BUFFERED_CAPTURE || defined(__DOXYGEN__)
+  /**
+   * @brief Capture ring buffer pointer.
+   */
+  icucnt_t                  *buffer;
+  /**
+   * @brief Capture ring depth.
+   */
+  size_t                    depth;
+  /**
+   * @brief Half ring callback.
+   */
+  icubufcallback_t          buf_cb;
+#endif /* ICU_USE_BUFFERED_CAPTURE */
 #if defined(ICU_DRIVER_EXT_FIELDS)
   ICU_DRIVER_EXT_FIELDS
 #endif
@@ -182,6 +208,10 @@ extern "C" {
   void icu_lld_stop_capture(ICUDriver *icup);
   void icu_lld_enable_notifications(ICUDriver *icup);
   void icu_lld_disable_notifications(ICUDriver *icup);
+#if ICU_USE_BUFFERED_CAPTURE == TRUE
+  void icu_lld_start_buffered_capture(ICUDriver *icup);
+  void icu_lld_stop_buffered_capture(ICUDriver *icup);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -308,6 +308,72 @@ const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
 }
 #endif /* MAC_USE_ZERO_COPY == TRUE */
 
+#if (MAC_USE_RX_MITIGATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Re-enables the receive interrupt.
+ * @details Called by the high level driver after the receive ring has been
+ *          found empty.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ *
+ * @notapi
+ */
+void mac_lld_rx_irq_enable(MACDriver *macp) {
+
+  (void)macp;
+
+}
+#endif /* MAC_USE_RX_MITIGATION == TRUE */
+
+#if (MAC_USE_TX_GATHER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Transmits a frame composed of multiple segments.
+ * @details The segments are transmitted in place as a single frame, no
+ *          assembly copy is performed.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tdp      pointer to a @p MACTransmitDescriptor structure,
+ *                      on success it can be polled for completion
+ * @param[in] segs      frame segments array
+ * @param[in] n         number of segments
+ * @return              The operation status.
+ * @retval MSG_OK       the frame has been queued for transmission.
+ * @retval MSG_TIMEOUT  enough descriptors not currently available.
+ *
+ * @notapi
+ */
+msg_t mac_lld_transmit_gather(MACDriver *macp,
+                              MACTransmitDescriptor *tdp,
+                              const macsegment_t segs[],
+                              size_t n) {
+
+  (void)macp;
+  (void)tdp;
+  (void)segs;
+  (void)n;
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Evaluates whether a gather frame has been transmitted.
+ *
+ * @param[in] tdp       pointer to the @p MACTransmitDescriptor structure
+ *                      returned by @p mac_lld_transmit_gather()
+ * @return              The frame status.
+ * @retval true         if the frame has been fully transmitted.
+ * @retval false        if the frame is still owned by the DMA.
+ *
+ * @notapi
+ */
+bool mac_lld_is_frame_transmitted(MACTransmitDescriptor *tdp) {
+
+  (void)tdp;
+
+  return true;
+}
+#endif /* MAC_USE_TX_GATHER == TRUE */
+
 #endif /* HAL_USE_MAC == TRUE */
 
 /** @} */
@@ -151,6 +151,30 @@ void pwm_lld_disable_channel(PWMDriver *pwmp, pwmchannel_t channel) {
   (void)channel;
 }
 
+/**
+ * @brief   Updates a set of PWM channels atomically.
+ * @details The whole set of compare registers takes effect on the same
+ *          PWM period.
+ * @pre     The PWM unit must have been activated using @p pwmStart().
+ * @post    The channels are active using the specified widths.
+ * @note    The function has effect at the next cycle start.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] mask      mask of the channels to be updated
+ * @param[in] widths    array of pulse widths as clock pulses number,
+ *                      indexed by channel number
+ *
+ * @notapi
+ */
+void pwm_lld_set_channels(PWMDriver *pwmp,
+                          pwmchnmsk_t mask,
+                          const pwmcnt_t widths[]) {
+
+  (void)pwmp;
+  (void)mask;
+  (void)widths;
+}
+
 /**
  * @brief   Enables the periodic activation edge notification.
  * @pre     The PWM unit must have been activated using @p pwmStart().
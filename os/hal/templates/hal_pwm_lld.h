@@ -36,6 +36,11 @@
  */
 #define PWM_CHANNELS                            4
 
+/**
+ * @brief   Grouped channels update support flag.
+ */
+#define PWM_SUPPORTS_GROUP_UPDATE               TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -198,6 +203,9 @@ extern "C" {
                               pwmchannel_t channel,
                               pwmcnt_t width);
   void pwm_lld_disable_channel(PWMDriver *pwmp, pwmchannel_t channel);
+  void pwm_lld_set_channels(PWMDriver *pwmp,
+                            pwmchnmsk_t mask,
+                            const pwmcnt_t widths[]);
   void pwm_lld_enable_periodic_notification(PWMDriver *pwmp);
   void pwm_lld_disable_periodic_notification(PWMDriver *pwmp);
   void pwm_lld_enable_channel_notification(PWMDriver *pwmp,
@@ -305,6 +305,76 @@ bool sdc_lld_write(SDCDriver *sdcp, uint32_t startblk,
   return HAL_SUCCESS;
 }
 
+#if (SDC_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous read of one or more blocks.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[out] buf      pointer to the read buffer
+ * @param[in] blocks    number of blocks to read
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_read(SDCDriver *sdcp, uint32_t startblk,
+                        uint8_t *buf, uint32_t blocks) {
+
+  (void)sdcp;
+  (void)startblk;
+  (void)buf;
+  (void)blocks;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Starts an asynchronous write of one or more blocks.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] buf       pointer to the write buffer
+ * @param[in] blocks    number of blocks to write
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  transfer started.
+ * @retval HAL_FAILED   transfer not started.
+ *
+ * @notapi
+ */
+bool sdc_lld_start_write(SDCDriver *sdcp, uint32_t startblk,
+                         const uint8_t *buf, uint32_t blocks) {
+
+  (void)sdcp;
+  (void)startblk;
+  (void)buf;
+  (void)blocks;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Completes an asynchronous transfer.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool sdc_lld_finish_transfer(SDCDriver *sdcp) {
+
+  (void)sdcp;
+
+  return HAL_SUCCESS;
+}
+#endif /* SDC_USE_ASYNC == TRUE */
+
 /**
  * @brief   Waits for card idle condition.
  *
@@ -159,6 +159,13 @@
 #define HAL_USE_SERIAL_USB                  TRUE
 #endif
 
+/**
+ * @brief   Enables the USB Mass Storage subsystem.
+ */
+#if !defined(HAL_USE_USB_MSC) || defined(__DOXYGEN__)
+#define HAL_USE_USB_MSC                     FALSE
+#endif
+
 /**
  * @brief   Enables the SPI subsystem.
  */
@@ -207,6 +214,15 @@
 #define PAL_USE_WAIT                        FALSE
 #endif
 
+/**
+ * @brief   Enables event timestamping.
+ * @note    The timestamp source can be redefined using the
+ *          @p PAL_TIMESTAMP_NOW() hook macro.
+ */
+#if !defined(PAL_USE_TIMESTAMPS) || defined(__DOXYGEN__)
+#define PAL_USE_TIMESTAMPS                  FALSE
+#endif
+
 /*===========================================================================*/
 /* ADC driver related settings.                                              */
 /*===========================================================================*/
@@ -513,6 +529,13 @@
 #define USB_USE_WAIT                        TRUE
 #endif
 
+/**
+ * @brief   Enables queuing of pending transfers on endpoints.
+ */
+#if !defined(USB_USE_TRANSFER_QUEUE) || defined(__DOXYGEN__)
+#define USB_USE_TRANSFER_QUEUE              FALSE
+#endif
+
 #endif /* HALCONF_H */
 
 /** @} */
@@ -82,6 +82,28 @@
 #define CH_CFG_FACTORY_OBJ_FIFOS            TRUE
 #endif
 
+/**
+ * @brief   Enables the hash-indexed objects registry.
+ * @details If enabled then the factory maintains an open addressing hash
+ *          table over all the allocated/registered objects, find-by-name
+ *          operations are performed in constant time instead of scanning
+ *          the object lists. It also enables finding registered objects
+ *          by pre-computed hash key.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_INDEX) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_INDEX           FALSE
+#endif
+
+/**
+ * @brief   Number of slots in the factory hash table.
+ * @note    It must be a power of two and not lower than the maximum
+ *          number of objects simultaneously handled by the factory.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_SIZE            64
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -121,6 +143,12 @@
 #error "invalid CH_CFG_FACTORY_MAX_NAMES_LENGTH value"
 #endif
 
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) &&                                  \
+    ((CH_CFG_FACTORY_HASH_SIZE < 2) ||                                      \
+     ((CH_CFG_FACTORY_HASH_SIZE & (CH_CFG_FACTORY_HASH_SIZE - 1)) != 0))
+#error "invalid CH_CFG_FACTORY_HASH_SIZE value, it must be a power of two"
+#endif
+
 #if (CH_CFG_USE_MUTEXES == FALSE) && (CH_CFG_USE_SEMAPHORES == FALSE)
 #error "CH_CFG_USE_FACTORY requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
@@ -153,6 +181,12 @@ typedef struct ch_dyn_element {
    * @brief   Number of references to this object.
    */
   ucnt_t                refs;
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Hash key of the object name.
+   */
+  uint32_t              key;
+#endif
 #if (CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0) || defined(__DOXYGEN__)
   char                  name[CH_CFG_FACTORY_MAX_NAMES_LENGTH];
 #else
@@ -167,6 +201,23 @@ typedef struct ch_dyn_list {
     dyn_element_t       *next;
 } dyn_list_t;
 
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a factory hash table slot.
+ */
+typedef struct ch_factory_hash_slot {
+  /**
+   * @brief   List owning the indexed element or @p NULL.
+   * @note    A non-NULL list with a @p NULL element marks a deleted slot.
+   */
+  dyn_list_t            *list;
+  /**
+   * @brief   Indexed element or @p NULL.
+   */
+  dyn_element_t         *element;
+} factory_hash_slot_t;
+#endif
+
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Type of a registered object.
@@ -315,6 +366,12 @@ typedef struct ch_objects_factory {
    */
   dyn_list_t            fifo_list;
 #endif /* CH_CFG_FACTORY_OBJ_FIFOS = TRUE */
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Hash table indexing all the factory objects.
+   */
+  factory_hash_slot_t   hash[CH_CFG_FACTORY_HASH_SIZE];
+#endif /* CH_CFG_FACTORY_HASH_INDEX = TRUE */
 } objects_factory_t;
 
 /*===========================================================================*/
@@ -333,10 +390,16 @@ extern objects_factory_t ch_factory;
 extern "C" {
 #endif
   void _factory_init(void);
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+  uint32_t chFactoryHashName(const char *name);
+#endif
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
   registered_object_t *chFactoryRegisterObject(const char *name,
                                                void *objp);
   registered_object_t *chFactoryFindObject(const char *name);
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+  registered_object_t *chFactoryFindObjectByKey(uint32_t key);
+#endif
   registered_object_t *chFactoryFindObjectByPointer(void *objp);
   void chFactoryReleaseObject(registered_object_t *rop);
 #endif
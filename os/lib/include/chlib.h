@@ -157,9 +157,28 @@
 #error "CH_CFG_USE_OBJ_FIFOS not defined in chlibconf.h"
 #endif
 
-//#if !defined(CH_CFG_USE_PIPES)
-//#error "CH_CFG_USE_PIPES not defined in chlibconf.h"
-//#endif
+/* The pipes subsystem is more recent than the other library modules, a
+   missing setting defaults to FALSE instead of triggering an error in
+   order to not break existing configuration files.*/
+#if !defined(CH_CFG_USE_PIPES)
+#define CH_CFG_USE_PIPES                    FALSE
+#endif
+
+/* The work queues subsystem is also more recent, a missing setting
+   defaults to FALSE for the same reason.*/
+#if !defined(CH_CFG_USE_WORKQUEUES)
+#define CH_CFG_USE_WORKQUEUES               FALSE
+#endif
+
+/* Event sources are a RT-only feature, the NIL kernel only implements
+   thread event masks. Library features relying on event sources are
+   compiled only when this derived setting is TRUE.*/
+#if (defined(_CHIBIOS_RT_) && (CH_CFG_USE_EVENTS == TRUE)) ||               \
+    defined(__DOXYGEN__)
+#define CH_LIB_USE_EVENT_SOURCES            TRUE
+#else
+#define CH_LIB_USE_EVENT_SOURCES            FALSE
+#endif
 
 /* Objects factory options checks.*/
 #if !defined(CH_CFG_USE_FACTORY)
@@ -213,7 +232,8 @@
 #include "chmemheaps.h"
 #include "chmempools.h"
 #include "chobjfifos.h"
-//#include "chpipes.h"
+#include "chpipes.h"
+#include "chworkqueues.h"
 #include "chfactory.h"
 
 #endif /* CHLIB_H */
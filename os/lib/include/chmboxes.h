@@ -38,10 +38,46 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Lock-free mailboxes APIs.
+ * @details If enabled then the lock-free mailbox variant APIs are included
+ *          in the kernel. Posts and fetches on a @p lf_mailbox_t object are
+ *          performed using atomic operations on the buffer indexes without
+ *          masking interrupts, the kernel critical zone is only entered on
+ *          the full/empty transitions of the blocking variants.
+ * @note    This option requires a compiler providing the GCC atomic
+ *          builtins.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_MAILBOXES_LOCKFREE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MAILBOXES_LOCKFREE       FALSE
+#endif
+
+/**
+ * @brief   Mailboxes occupancy statistics.
+ * @details If enabled then each mailbox tracks the peak number of queued
+ *          messages, a single compare and store on the post paths, and
+ *          all mailboxes initialized with @p chMBObjectInit() can be
+ *          enumerated using @p chMBGetNextX(). The high watermarks allow
+ *          to size the buffers on measured worst cases instead of
+ *          guesses.
+ * @note    Statically initialized mailboxes are not linked in the
+ *          enumeration list.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_MAILBOX_STATS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MAILBOX_STATS            FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE) && !defined(__GNUC__) &&        \
+    !defined(__DOXYGEN__)
+#error "CH_CFG_USE_MAILBOXES_LOCKFREE requires the GCC atomic builtins"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -49,7 +85,7 @@
 /**
  * @brief   Structure representing a mailbox object.
  */
-typedef struct {
+typedef struct ch_mailbox {
   msg_t                 *buffer;        /**< @brief Pointer to the mailbox
                                                     buffer.                 */
   msg_t                 *top;           /**< @brief Pointer to the location
@@ -60,8 +96,41 @@ typedef struct {
   bool                  reset;          /**< @brief True in reset state.    */
   threads_queue_t       qw;             /**< @brief Queued writers.         */
   threads_queue_t       qr;             /**< @brief Queued readers.         */
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) || defined(__DOXYGEN__)
+  size_t                hwm;            /**< @brief Peak number of queued
+                                                    messages.               */
+  struct ch_mailbox     *next;          /**< @brief Next in the mailboxes
+                                                    enumeration list.       */
+#endif
 } mailbox_t;
 
+#if (CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a lock-free mailbox slot.
+ * @details Each message is stored together with a sequence number used for
+ *          the lock-free hand-shake between producers and consumers.
+ */
+typedef struct {
+  size_t                seq;            /**< @brief Slot sequence number.   */
+  msg_t                 msg;            /**< @brief Message storage.        */
+} lf_mbslot_t;
+
+/**
+ * @brief   Structure representing a lock-free mailbox object.
+ */
+typedef struct {
+  lf_mbslot_t           *buffer;        /**< @brief Pointer to the slots
+                                                    buffer.                 */
+  size_t                mask;           /**< @brief Buffer size minus one.  */
+  size_t                wrpos;          /**< @brief Write position.         */
+  size_t                rdpos;          /**< @brief Read position.          */
+  volatile cnt_t        qwcnt;          /**< @brief Sleeping writers.       */
+  volatile cnt_t        qrcnt;          /**< @brief Sleeping readers.       */
+  threads_queue_t       qw;             /**< @brief Queued writers.         */
+  threads_queue_t       qr;             /**< @brief Queued readers.         */
+} lf_mailbox_t;
+#endif /* CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -75,6 +144,7 @@ typedef struct {
  * @param[in] buffer    pointer to the mailbox buffer array of @p msg_t
  * @param[in] size      number of @p msg_t elements in the buffer array
  */
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) && !defined(__DOXYGEN__)
 #define _MAILBOX_DATA(name, buffer, size) {                                 \
   (msg_t *)(buffer),                                                        \
   (msg_t *)(buffer) + size,                                                 \
@@ -84,7 +154,21 @@ typedef struct {
   false,                                                                    \
   _THREADS_QUEUE_DATA(name.qw),                                             \
   _THREADS_QUEUE_DATA(name.qr),                                             \
+  (size_t)0,                                                                \
+  NULL,                                                                     \
 }
+#else
+#define _MAILBOX_DATA(name, buffer, size) {                                 \
+  (msg_t *)(buffer),                                                        \
+  (msg_t *)(buffer) + size,                                                 \
+  (msg_t *)(buffer),                                                        \
+  (msg_t *)(buffer),                                                        \
+  (size_t)0,                                                                \
+  false,                                                                    \
+  _THREADS_QUEUE_DATA(name.qw),                                             \
+  _THREADS_QUEUE_DATA(name.qr),                                             \
+}
+#endif
 
 /**
  * @brief   Static mailbox initializer.
@@ -114,9 +198,29 @@ extern "C" {
   msg_t chMBPostAheadTimeout(mailbox_t *mbp, msg_t msg, sysinterval_t timeout);
   msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout);
   msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg);
+  size_t chMBPostBurstTimeout(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                              sysinterval_t timeout);
+  size_t chMBPostBurstTimeoutS(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                               sysinterval_t timeout);
   msg_t chMBFetchTimeout(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout);
   msg_t chMBFetchTimeoutS(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout);
   msg_t chMBFetchI(mailbox_t *mbp, msg_t *msgp);
+  size_t chMBFetchBurstTimeout(mailbox_t *mbp, msg_t *msgp, size_t n,
+                               sysinterval_t timeout);
+  size_t chMBFetchBurstTimeoutS(mailbox_t *mbp, msg_t *msgp, size_t n,
+                                sysinterval_t timeout);
+#if CH_CFG_USE_MAILBOX_STATS == TRUE
+  mailbox_t *chMBGetNextX(mailbox_t *mbp);
+#endif
+#if CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE
+  void chLFMBObjectInit(lf_mailbox_t *mbp, lf_mbslot_t *buf, size_t n);
+  msg_t chLFMBPostX(lf_mailbox_t *mbp, msg_t msg);
+  msg_t chLFMBFetchX(lf_mailbox_t *mbp, msg_t *msgp);
+  msg_t chLFMBPostTimeout(lf_mailbox_t *mbp, msg_t msg,
+                          sysinterval_t timeout);
+  msg_t chLFMBFetchTimeout(lf_mailbox_t *mbp, msg_t *msgp,
+                           sysinterval_t timeout);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -202,6 +306,21 @@ static inline void chMBResumeX(mailbox_t *mbp) {
   mbp->reset = false;
 }
 
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the peak number of messages queued into a mailbox.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @return              The mailbox high watermark.
+ *
+ * @xclass
+ */
+static inline size_t chMBGetHighWatermarkX(const mailbox_t *mbp) {
+
+  return mbp->hwm;
+}
+#endif
+
 #endif /* CH_CFG_USE_MAILBOXES == TRUE */
 
 #endif /* CHMBOXES_H */
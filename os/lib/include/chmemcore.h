@@ -89,6 +89,16 @@ typedef struct {
   uint8_t *endmem;
 } memcore_t;
 
+/**
+ * @brief   Type of a core memory checkpoint.
+ */
+typedef struct {
+  /**
+   * @brief   Saved next free address.
+   */
+  uint8_t *markmem;
+} memcore_mark_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -112,6 +122,10 @@ extern "C" {
                                      unsigned align,
                                      size_t offset);
   size_t chCoreGetStatusX(void);
+  void chCoreSaveMarkI(memcore_mark_t *mcmp);
+  void chCoreSaveMark(memcore_mark_t *mcmp);
+  void chCoreRestoreMarkI(const memcore_mark_t *mcmp);
+  void chCoreRestoreMark(const memcore_mark_t *mcmp);
 #ifdef __cplusplus
 }
 #endif
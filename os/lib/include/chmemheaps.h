@@ -50,6 +50,45 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   TLSF heap backend.
+ * @details If enabled then memory heaps can optionally be initialized with
+ *          @p chHeapObjectInitTLSF(), allocations on such heaps are
+ *          performed using a two-level segregated-fit strategy with
+ *          constant execution time and bounded fragmentation. Heaps
+ *          initialized with @p chHeapObjectInit() keep using the classic
+ *          first-fit strategy.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_TLSF        FALSE
+#endif
+
+/**
+ * @brief   Heap blocks guarding.
+ * @details If enabled then each allocated block is tagged with its owner
+ *          thread and followed by a pattern-filled redzone, the pattern
+ *          is verified when the block is freed and by the optional
+ *          @p chHeapGuardCheck() sweep. Buffer overruns are so detected
+ *          at the damaged block instead of at the subsequent crash.
+ * @note    The runtime cost is a few cycles per allocation plus
+ *          @p CH_CFG_HEAP_GUARD_SIZE pattern bytes to be written and
+ *          checked, cheap enough to be left enabled in production
+ *          images.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_HEAP_GUARD) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_GUARD       FALSE
+#endif
+
+/**
+ * @brief   Size of the redzone placed after each guarded block.
+ * @note    The default is 16 bytes.
+ */
+#if !defined(CH_CFG_HEAP_GUARD_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_GUARD_SIZE      16
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -62,6 +101,10 @@
 #error "CH_CFG_USE_HEAP requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
 
+#if CH_CFG_HEAP_GUARD_SIZE <= 0
+#error "invalid CH_CFG_HEAP_GUARD_SIZE specified"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -97,6 +140,11 @@ struct memory_heap {
   memgetfunc2_t         provider;   /**< @brief Memory blocks provider for
                                                 this heap.                  */
   heap_header_t         header;     /**< @brief Free blocks list header.    */
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+  void                  *tlsf;      /**< @brief TLSF control structure or
+                                                @p NULL if the heap uses
+                                                the first-fit strategy.     */
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   mutex_t               mtx;        /**< @brief Heap access mutex.          */
 #else
@@ -104,6 +152,40 @@ struct memory_heap {
 #endif
 };
 
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a heap guard header.
+ * @details The header is placed immediately before the area returned to
+ *          the caller, the redzone follows the area.
+ */
+typedef struct heap_guard heap_guard_t;
+
+/**
+ * @brief   Heap guard header.
+ */
+struct heap_guard {
+  heap_guard_t          *next;      /**< @brief Next guarded block.         */
+  heap_guard_t          *prev;      /**< @brief Previous guarded block.     */
+  thread_t              *owner;     /**< @brief Allocating thread.          */
+  size_t                size;       /**< @brief Requested size in bytes.    */
+  void                  *base;      /**< @brief Underlying heap block.      */
+};
+
+/**
+ * @brief   Type of a heap damage report.
+ * @details The structure is filled before halting or returning when a
+ *          damaged redzone is detected, it is meant to be inspected from
+ *          a debugger or printed by the application.
+ */
+typedef struct {
+  void                  *p;         /**< @brief Damaged block or @p NULL.   */
+  thread_t              *owner;     /**< @brief Allocating thread.          */
+#if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
+  const char            *name;      /**< @brief Allocating thread name.     */
+#endif
+} heap_guard_report_t;
+#endif /* CH_CFG_USE_HEAP_GUARD == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -119,14 +201,24 @@ struct memory_heap {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) && !defined(__DOXYGEN__)
+extern heap_guard_report_t ch_heap_guard_report;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
   void _heap_init(void);
   void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size);
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  void chHeapObjectInitTLSF(memory_heap_t *heapp, void *buf, size_t size);
+#endif
   void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align);
   void chHeapFree(void *p);
   size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp);
+#if CH_CFG_USE_HEAP_GUARD == TRUE
+  void *chHeapGuardCheck(thread_t **ownerp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -168,7 +260,11 @@ static inline void *chHeapAlloc(memory_heap_t *heapp, size_t size) {
  */
 static inline size_t chHeapGetSize(const void *p) {
 
+#if CH_CFG_USE_HEAP_GUARD == TRUE
+  return ((const heap_guard_t *)p - 1U)->size;
+#else
   return ((heap_header_t *)p - 1U)->used.size;
+#endif
 }
 
 #endif /* CH_CFG_USE_HEAP == TRUE */
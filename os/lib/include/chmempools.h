@@ -70,6 +70,24 @@ typedef struct {
                                                     for this pool.          */
 } memory_pool_t;
 
+/**
+ * @brief   Memory pool thread cache descriptor.
+ * @details A pool cache is a small magazine of pre-allocated objects
+ *          owned by a single thread, the common allocation and release
+ *          paths only touch the cache and require no critical zone, the
+ *          shared pool is accessed in batches on cache refill and flush.
+ * @note    A pool cache must only be used by its owner thread.
+ */
+typedef struct {
+  memory_pool_t         *pool;          /**< @brief The backing shared
+                                                    pool.                   */
+  void                  **objects;      /**< @brief Cached objects array.   */
+  size_t                depth;          /**< @brief Size of the objects
+                                                    array.                  */
+  size_t                cnt;            /**< @brief Number of currently
+                                                    cached objects.         */
+} pool_cache_t;
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Guarded memory pool descriptor.
@@ -78,6 +96,12 @@ typedef struct {
   semaphore_t           sem;            /**< @brief Counter semaphore guarding
                                                     the memory pool.        */
   memory_pool_t         pool;           /**< @brief The memory pool itself. */
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+  event_source_t        lowev;          /**< @brief Low-watermark event
+                                                    source.                 */
+  cnt_t                 lowlevel;       /**< @brief Low-watermark level,
+                                                    zero if disabled.       */
+#endif
 } guarded_memory_pool_t;
 #endif /* CH_CFG_USE_SEMAPHORES == TRUE */
 
@@ -122,10 +146,19 @@ typedef struct {
  * @param[in] size      size of the memory pool contained objects
  * @param[in] align     required memory alignment
  */
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+#define _GUARDEDMEMORYPOOL_DATA(name, size, align) {                        \
+  _SEMAPHORE_DATA(name.sem, (cnt_t)0),                                      \
+  _MEMORYPOOL_DATA(NULL, size, align, NULL),                                \
+  _EVENTSOURCE_DATA(name.lowev),                                            \
+  (cnt_t)0,                                                                 \
+}
+#else /* CH_LIB_USE_EVENT_SOURCES == FALSE */
 #define _GUARDEDMEMORYPOOL_DATA(name, size, align) {                        \
   _SEMAPHORE_DATA(name.sem, (cnt_t)0),                                      \
   _MEMORYPOOL_DATA(NULL, size, align, NULL)                                 \
 }
+#endif /* CH_LIB_USE_EVENT_SOURCES == FALSE */
 
 /**
  * @brief   Static guarded memory pool initializer.
@@ -154,6 +187,11 @@ extern "C" {
   void *chPoolAlloc(memory_pool_t *mp);
   void chPoolFreeI(memory_pool_t *mp, void *objp);
   void chPoolFree(memory_pool_t *mp, void *objp);
+  void chPoolCacheObjectInit(pool_cache_t *pcp, memory_pool_t *mp,
+                             void **buf, size_t n);
+  void *chPoolCacheAlloc(pool_cache_t *pcp);
+  void chPoolCacheFree(pool_cache_t *pcp, void *objp);
+  void chPoolCacheFlush(pool_cache_t *pcp);
 #if CH_CFG_USE_SEMAPHORES == TRUE
   void chGuardedPoolObjectInitAligned(guarded_memory_pool_t *gmp,
                                       size_t size,
@@ -307,9 +345,53 @@ static inline void *chGuardedPoolAllocI(guarded_memory_pool_t *gmp) {
     chSemFastWaitI(&gmp->sem);
     chDbgAssert(chSemGetCounterI(&gmp->sem) >= (cnt_t)0,
                 "semaphore out of sync");
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+    if ((gmp->lowlevel > (cnt_t)0) &&
+        (chSemGetCounterI(&gmp->sem) < gmp->lowlevel)) {
+      chEvtBroadcastI(&gmp->lowev);
+    }
+#endif
   }
   return p;
 }
+
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the low-watermark event source.
+ * @details The event source is broadcast when, after an allocation, the
+ *          number of free objects in the pool is below the configured
+ *          low-watermark level. A replenisher thread can listen to it and
+ *          proactively return objects before the pool runs empty.
+ *
+ * @param[in] gmp       pointer to a @p guarded_memory_pool_t structure
+ * @return              The pointer to the low-watermark event source.
+ *
+ * @xclass
+ */
+static inline event_source_t *
+chGuardedPoolGetEventSourceX(guarded_memory_pool_t *gmp) {
+
+  return &gmp->lowev;
+}
+
+/**
+ * @brief   Sets the low-watermark level.
+ * @details When, after an allocation, the number of free objects in the
+ *          pool is below @p level then the low-watermark event source is
+ *          broadcast.
+ *
+ * @param[in] gmp       pointer to a @p guarded_memory_pool_t structure
+ * @param[in] level     the low-watermark level, zero disables the
+ *                      notification
+ *
+ * @xclass
+ */
+static inline void chGuardedPoolSetLowWatermarkX(guarded_memory_pool_t *gmp,
+                                                 cnt_t level) {
+
+  gmp->lowlevel = level;
+}
+#endif /* CH_LIB_USE_EVENT_SOURCES == TRUE */
 #endif /* CH_CFG_USE_SEMAPHORES == TRUE */
 
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
@@ -88,6 +88,46 @@ typedef struct ch_objects_fifo {
   mailbox_t                 mbx;
 } objects_fifo_t;
 
+/**
+ * @brief   Type of a ring-mode objects FIFO.
+ * @details In this variant the objects are stored in a contiguous circular
+ *          buffer and no free-list is involved, producers claim the slots
+ *          in ring order and consumers must release them in the same order.
+ *          The sequential layout allows to peek at a whole batch of
+ *          completed objects and to target the slots directly with DMA
+ *          transfers.
+ */
+typedef struct ch_ring_objects_fifo {
+  /**
+   * @brief   Pointer to the slots buffer.
+   */
+  uint8_t                   *buffer;
+  /**
+   * @brief   Size of the objects.
+   */
+  size_t                    objsize;
+  /**
+   * @brief   Number of slots in the buffer.
+   */
+  size_t                    objn;
+  /**
+   * @brief   Index of the next slot to be claimed.
+   */
+  size_t                    wridx;
+  /**
+   * @brief   Index of the next slot to be fetched.
+   */
+  size_t                    rdidx;
+  /**
+   * @brief   Counter of the free slots.
+   */
+  semaphore_t               free;
+  /**
+   * @brief   Counter of the sent objects.
+   */
+  semaphore_t               sent;
+} ring_objects_fifo_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -331,6 +371,288 @@ static inline msg_t chFifoReceiveObjectTimeout(objects_fifo_t *ofp,
 
   return chMBFetchTimeout(&ofp->mbx, (msg_t *)objpp, timeout);
 }
+
+/**
+ * @brief   Initializes a ring-mode FIFO object.
+ * @pre     The objects size must be a multiple of the alignment
+ *          requirement of the stored objects.
+ *
+ * @param[out] rfp      pointer to a @p ring_objects_fifo_t structure
+ * @param[in] objsize   size of objects
+ * @param[in] objn      number of objects available
+ * @param[in] objbuf    pointer to the contiguous buffer of objects, it must
+ *                      be able to hold @p objn objects of @p objsize size
+ *
+ * @init
+ */
+static inline void chRingFifoObjectInit(ring_objects_fifo_t *rfp,
+                                        size_t objsize, size_t objn,
+                                        void *objbuf) {
+
+  chDbgCheck((rfp != NULL) && (objbuf != NULL) &&
+             (objsize > (size_t)0) && (objn > (size_t)0));
+
+  rfp->buffer  = (uint8_t *)objbuf;
+  rfp->objsize = objsize;
+  rfp->objn    = objn;
+  rfp->wridx   = (size_t)0;
+  rfp->rdidx   = (size_t)0;
+  chSemObjectInit(&rfp->free, (cnt_t)objn);
+  chSemObjectInit(&rfp->sent, (cnt_t)0);
+}
+
+/**
+ * @brief   Claims the next free slot of a ring-mode FIFO.
+ * @note    The returned pointer is stable, the slot is not moved nor
+ *          reused until it is released by the consumer side.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The pointer to the claimed slot.
+ * @retval NULL         if a slot is not available within the specified
+ *                      timeout.
+ *
+ * @sclass
+ */
+static inline void *chRingFifoTakeObjectTimeoutS(ring_objects_fifo_t *rfp,
+                                                 sysinterval_t timeout) {
+  void *objp;
+
+  if (chSemWaitTimeoutS(&rfp->free, timeout) != MSG_OK) {
+    return NULL;
+  }
+  objp = (void *)(rfp->buffer + (rfp->wridx * rfp->objsize));
+  rfp->wridx = (rfp->wridx + (size_t)1) % rfp->objn;
+
+  return objp;
+}
+
+/**
+ * @brief   Claims the next free slot of a ring-mode FIFO.
+ * @note    The returned pointer is stable, the slot is not moved nor
+ *          reused until it is released by the consumer side.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The pointer to the claimed slot.
+ * @retval NULL         if a slot is not available within the specified
+ *                      timeout.
+ *
+ * @api
+ */
+static inline void *chRingFifoTakeObjectTimeout(ring_objects_fifo_t *rfp,
+                                                sysinterval_t timeout) {
+  void *objp;
+
+  chSysLock();
+  objp = chRingFifoTakeObjectTimeoutS(rfp, timeout);
+  chSysUnlock();
+
+  return objp;
+}
+
+/**
+ * @brief   Marks a claimed slot as completed.
+ * @note    Slots must be completed in the same order they have been
+ *          claimed, when multiple producers are involved the application
+ *          must enforce the ordering.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ *
+ * @iclass
+ */
+static inline void chRingFifoSendObjectI(ring_objects_fifo_t *rfp) {
+
+  chSemSignalI(&rfp->sent);
+}
+
+/**
+ * @brief   Marks a claimed slot as completed.
+ * @note    Slots must be completed in the same order they have been
+ *          claimed, when multiple producers are involved the application
+ *          must enforce the ordering.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ *
+ * @api
+ */
+static inline void chRingFifoSendObject(ring_objects_fifo_t *rfp) {
+
+  chSemSignal(&rfp->sent);
+}
+
+/**
+ * @brief   Fetches the oldest completed object.
+ * @note    The object remains owned by the FIFO, the slot becomes free
+ *          again only after @p chRingFifoReturnObject() is called.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] objpp     pointer to the fetched object reference
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @sclass
+ */
+static inline msg_t chRingFifoReceiveObjectTimeoutS(ring_objects_fifo_t *rfp,
+                                                    void **objpp,
+                                                    sysinterval_t timeout) {
+
+  if (chSemWaitTimeoutS(&rfp->sent, timeout) != MSG_OK) {
+    return MSG_TIMEOUT;
+  }
+  *objpp = (void *)(rfp->buffer + (rfp->rdidx * rfp->objsize));
+  rfp->rdidx = (rfp->rdidx + (size_t)1) % rfp->objn;
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Fetches the oldest completed object.
+ * @note    The object remains owned by the FIFO, the slot becomes free
+ *          again only after @p chRingFifoReturnObject() is called.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] objpp     pointer to the fetched object reference
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t chRingFifoReceiveObjectTimeout(ring_objects_fifo_t *rfp,
+                                                   void **objpp,
+                                                   sysinterval_t timeout) {
+  msg_t msg;
+
+  chSysLock();
+  msg = chRingFifoReceiveObjectTimeoutS(rfp, objpp, timeout);
+  chSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Releases the oldest fetched slot.
+ * @note    Slots must be released in the same order they have been
+ *          fetched.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ *
+ * @iclass
+ */
+static inline void chRingFifoReturnObjectI(ring_objects_fifo_t *rfp) {
+
+  chSemSignalI(&rfp->free);
+}
+
+/**
+ * @brief   Releases the oldest fetched slot.
+ * @note    Slots must be released in the same order they have been
+ *          fetched.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ *
+ * @api
+ */
+static inline void chRingFifoReturnObject(ring_objects_fifo_t *rfp) {
+
+  chSemSignal(&rfp->free);
+}
+
+/**
+ * @brief   Peeks at the batch of completed objects.
+ * @details The returned batch is the contiguous sequence of completed
+ *          objects starting at the oldest one, it can be processed in a
+ *          single pass without fetching the objects one by one. The batch
+ *          is truncated at the buffer wrap point, a second call after
+ *          releasing the batch returns the wrapped-around part.
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[out] objpp    pointer to the first object of the batch
+ * @return              The number of objects in the batch.
+ * @retval 0            if there are no completed objects.
+ *
+ * @iclass
+ */
+static inline size_t chRingFifoPeekBatchI(ring_objects_fifo_t *rfp,
+                                          void **objpp) {
+  cnt_t cnt;
+  size_t n;
+
+  cnt = chSemGetCounterI(&rfp->sent);
+  n = (cnt > (cnt_t)0) ? (size_t)cnt : (size_t)0;
+  if (n > rfp->objn - rfp->rdidx) {
+    n = rfp->objn - rfp->rdidx;
+  }
+  *objpp = (void *)(rfp->buffer + (rfp->rdidx * rfp->objsize));
+
+  return n;
+}
+
+/**
+ * @brief   Releases a batch of completed objects.
+ * @details The @p n oldest completed objects are consumed and their slots
+ *          are made available to the producer side in a single operation.
+ * @pre     The batch size must not exceed the value returned by
+ *          @p chRingFifoPeekBatchI().
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] n         number of objects to be released
+ *
+ * @sclass
+ */
+static inline void chRingFifoReleaseBatchS(ring_objects_fifo_t *rfp,
+                                           size_t n) {
+  size_t i;
+
+  chDbgAssert(chSemGetCounterI(&rfp->sent) >= (cnt_t)n, "batch too large");
+
+  for (i = (size_t)0; i < n; i++) {
+    (void) chSemWaitS(&rfp->sent);
+    chSemSignalI(&rfp->free);
+  }
+  rfp->rdidx = (rfp->rdidx + n) % rfp->objn;
+}
+
+/**
+ * @brief   Releases a batch of completed objects.
+ * @details The @p n oldest completed objects are consumed and their slots
+ *          are made available to the producer side in a single operation.
+ * @pre     The batch size must not exceed the value returned by
+ *          @p chRingFifoPeekBatchI().
+ *
+ * @param[in] rfp       pointer to a @p ring_objects_fifo_t structure
+ * @param[in] n         number of objects to be released
+ *
+ * @api
+ */
+static inline void chRingFifoReleaseBatch(ring_objects_fifo_t *rfp,
+                                          size_t n) {
+
+  chSysLock();
+  chRingFifoReleaseBatchS(rfp, n);
+  chSchRescheduleS();
+  chSysUnlock();
+}
 #endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
 
 #endif /* CHOBJFIFOS_H */
@@ -65,12 +65,44 @@ typedef struct {
 #else
   semaphore_t           sem;        /**< @brief Heap access semaphore.      */
 #endif
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+  event_source_t        esr;        /**< @brief Data-available event
+                                                source.                     */
+  event_source_t        esw;        /**< @brief Space-available event
+                                                source.                     */
+#endif
 } pipe_t;
 
+/**
+ * @brief   Type of a pipe data segment descriptor.
+ * @details An array of segment descriptors can be committed to a pipe
+ *          atomically using @p chPipeWriteVTimeout().
+ */
+typedef struct {
+  const uint8_t         *base;          /**< @brief Pointer to the segment
+                                                    data.                   */
+  size_t                len;            /**< @brief Segment length.         */
+} pipe_iovec_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   Events part of a static pipe initializer.
+ * @note    It is an helper for the @p _PIPE_DATA() macro, not meant to
+ *          be used directly.
+ *
+ * @param[in] name      the name of the pipe variable
+ */
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+#define __PIPE_EVENTS_DATA(name)                                            \
+  _EVENTSOURCE_DATA(name.esr),                                              \
+  _EVENTSOURCE_DATA(name.esw),
+#else
+#define __PIPE_EVENTS_DATA(name)
+#endif
+
 /**
  * @brief   Data part of a static pipe initializer.
  * @details This macro should be used when statically initializing a
@@ -91,6 +123,7 @@ typedef struct {
   _THREADS_QUEUE_DATA(name.qw),                                             \
   _THREADS_QUEUE_DATA(name.qr),                                             \
   _MUTEX_DATA(name.mtx),                                                    \
+  __PIPE_EVENTS_DATA(name)                                                  \
 }
 #else /* CH_CFG_USE_MUTEXES == FALSE */
 #define _PIPE_DATA(name, buffer, size) {                                    \
@@ -103,6 +136,7 @@ typedef struct {
   _THREADS_QUEUE_DATA(name.qw),                                             \
   _THREADS_QUEUE_DATA(name.qr),                                             \
   _SEMAPHORE_DATA(name.sem, (cnt_t)1),                                      \
+  __PIPE_EVENTS_DATA(name)                                                  \
 }
 #endif /* CH_CFG_USE_MUTEXES == FALSE */
 
@@ -129,6 +163,8 @@ extern "C" {
   void chPipeReset(pipe_t *pp);
   size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
                             size_t n, sysinterval_t timeout);
+  size_t chPipeWriteVTimeout(pipe_t *pp, const pipe_iovec_t iov[],
+                             size_t iovcnt, sysinterval_t timeout);
   size_t chPipeReadTimeout(pipe_t *pp, uint8_t *bp,
                            size_t n, sysinterval_t timeout);
 #ifdef __cplusplus
@@ -216,6 +252,40 @@ static inline void chPipeResumeX(pipe_t *pp) {
   pp->reset = false;
 }
 
+#if (CH_LIB_USE_EVENT_SOURCES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the data-available event source.
+ * @details The event source is broadcast each time data is written into
+ *          the pipe, a single thread can so wait on several pipes using
+ *          @p chEvtWaitAny() and drain whichever is ready.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @return              The pointer to the data-available event source.
+ *
+ * @xclass
+ */
+static inline event_source_t *chPipeGetDataEventSourceX(pipe_t *pp) {
+
+  return &pp->esr;
+}
+
+/**
+ * @brief   Returns the space-available event source.
+ * @details The event source is broadcast each time data is read from the
+ *          pipe, writers can so wait for free space on several pipes
+ *          without polling.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @return              The pointer to the space-available event source.
+ *
+ * @xclass
+ */
+static inline event_source_t *chPipeGetSpaceEventSourceX(pipe_t *pp) {
+
+  return &pp->esw;
+}
+#endif /* CH_LIB_USE_EVENT_SOURCES == TRUE */
+
 #endif /* CH_CFG_USE_PIPES == TRUE */
 
 #endif /* CHPIPES_H */
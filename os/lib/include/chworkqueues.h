@@ -0,0 +1,190 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chworkqueues.h
+ * @brief   Work Queues structures and macros.
+ * @details This module implements a queue of function-pointer jobs with
+ *          multiple priority lanes, built on top of objects FIFOs. Jobs
+ *          are submitted from thread or I-Class context and are executed
+ *          by dispatcher threads supplied by the application, lower lane
+ *          indexes are served first.
+ *
+ * @addtogroup work_queues
+ * @{
+ */
+
+#ifndef CHWORKQUEUES_H
+#define CHWORKQUEUES_H
+
+#if (CH_CFG_USE_WORKQUEUES == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_OBJ_FIFOS == FALSE
+#error "CH_CFG_USE_WORKQUEUES requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a work function.
+ *
+ * @param[in] arg       argument associated to the job
+ */
+typedef void (*work_function_t)(void *arg);
+
+/**
+ * @brief   Type of a work item.
+ */
+typedef struct ch_work_item {
+  /**
+   * @brief   Function to be executed.
+   */
+  work_function_t           fn;
+  /**
+   * @brief   Function argument.
+   */
+  void                      *arg;
+} work_item_t;
+
+/**
+ * @brief   Type of a work queue lane.
+ */
+typedef struct ch_workqueue_lane {
+  /**
+   * @brief   FIFO of the queued jobs.
+   */
+  objects_fifo_t            fifo;
+  /**
+   * @brief   Number of jobs accepted on this lane.
+   */
+  ucnt_t                    posted;
+  /**
+   * @brief   Number of jobs rejected because the lane was full.
+   */
+  ucnt_t                    rejected;
+} workqueue_lane_t;
+
+/**
+ * @brief   Type of a work queue.
+ */
+typedef struct ch_workqueue {
+  /**
+   * @brief   Array of the priority lanes, lane zero is served first.
+   */
+  workqueue_lane_t          *lanes;
+  /**
+   * @brief   Number of lanes.
+   */
+  size_t                    nlanes;
+  /**
+   * @brief   Counter of the queued jobs over all lanes.
+   */
+  semaphore_t               sem;
+} workqueue_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chWQObjectInit(workqueue_t *wqp,
+                      workqueue_lane_t *lanes, size_t nlanes,
+                      work_item_t *itemsbuf, msg_t *msgbuf, size_t nitems);
+  bool chWQSubmitI(workqueue_t *wqp, size_t lane,
+                   work_function_t fn, void *arg);
+  bool chWQSubmitTimeout(workqueue_t *wqp, size_t lane,
+                         work_function_t fn, void *arg,
+                         sysinterval_t timeout);
+  size_t chWQDispatchTimeout(workqueue_t *wqp, size_t max,
+                             sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of jobs accepted on a lane.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] lane      the lane index
+ * @return              The number of accepted jobs.
+ *
+ * @xclass
+ */
+static inline ucnt_t chWQGetPostedX(workqueue_t *wqp, size_t lane) {
+
+  return wqp->lanes[lane].posted;
+}
+
+/**
+ * @brief   Returns the number of jobs rejected on a lane.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] lane      the lane index
+ * @return              The number of rejected jobs.
+ *
+ * @xclass
+ */
+static inline ucnt_t chWQGetRejectedX(workqueue_t *wqp, size_t lane) {
+
+  return wqp->lanes[lane].rejected;
+}
+
+/**
+ * @brief   Returns the current depth of a lane.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] lane      the lane index
+ * @return              The number of jobs waiting on the lane.
+ *
+ * @iclass
+ */
+static inline size_t chWQGetDepthI(workqueue_t *wqp, size_t lane) {
+
+  return (size_t)chMBGetUsedCountI(&wqp->lanes[lane].fifo.mbx);
+}
+
+#endif /* CH_CFG_USE_WORKQUEUES == TRUE */
+
+#endif /* CHWORKQUEUES_H */
+
+/** @} */
@@ -22,6 +22,12 @@ endif
 ifneq ($(findstring CH_CFG_USE_MEMPOOLS TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/lib/src/chmempools.c
 endif
+ifneq ($(findstring CH_CFG_USE_PIPES TRUE,$(CHLIBCONF)),)
+LIBSRC += $(CHIBIOS)/os/lib/src/chpipes.c
+endif
+ifneq ($(findstring CH_CFG_USE_WORKQUEUES TRUE,$(CHLIBCONF)),)
+LIBSRC += $(CHIBIOS)/os/lib/src/chworkqueues.c
+endif
 ifneq ($(findstring CH_CFG_USE_FACTORY TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/lib/src/chfactory.c
 endif
@@ -30,6 +36,8 @@ LIBSRC := $(CHIBIOS)/os/lib/src/chmboxes.c \
           $(CHIBIOS)/os/lib/src/chmemcore.c \
           $(CHIBIOS)/os/lib/src/chmemheaps.c \
           $(CHIBIOS)/os/lib/src/chmempools.c \
+          $(CHIBIOS)/os/lib/src/chpipes.c \
+          $(CHIBIOS)/os/lib/src/chworkqueues.c \
           $(CHIBIOS)/os/lib/src/chfactory.c
 endif
 
@@ -60,6 +60,13 @@
 #define F_UNLOCK()      chSemSignal(&ch_factory.sem)
 #endif
 
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask for the hash table index wrap-around.
+ */
+#define F_HASH_MASK     ((size_t)CH_CFG_FACTORY_HASH_SIZE - (size_t)1)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -88,7 +95,74 @@ static inline void dyn_list_init(dyn_list_t *dlp) {
   dlp->next = (dyn_element_t *)dlp;
 }
 
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+static void dyn_hash_insert(dyn_element_t *dep, dyn_list_t *dlp) {
+  size_t i = (size_t)dep->key & F_HASH_MASK;
+  size_t n;
+
+  /* Linear probing, free and deleted slots can both be reused.*/
+  for (n = (size_t)0; n < (size_t)CH_CFG_FACTORY_HASH_SIZE; n++) {
+    factory_hash_slot_t *fhsp = &ch_factory.hash[i];
+
+    if (fhsp->element == NULL) {
+      fhsp->element = dep;
+      fhsp->list    = dlp;
+      return;
+    }
+    i = (i + (size_t)1) & F_HASH_MASK;
+  }
+
+  /* The table must be dimensioned for the maximum number of objects
+     simultaneously handled by the factory.*/
+  chDbgAssert(false, "factory hash table full");
+}
+
+static void dyn_hash_remove(dyn_element_t *dep) {
+  size_t i = (size_t)dep->key & F_HASH_MASK;
+  size_t n;
+
+  for (n = (size_t)0; n < (size_t)CH_CFG_FACTORY_HASH_SIZE; n++) {
+    factory_hash_slot_t *fhsp = &ch_factory.hash[i];
+
+    if ((fhsp->element == NULL) && (fhsp->list == NULL)) {
+      /* Free slot reached, the element is not in the table.*/
+      return;
+    }
+    if (fhsp->element == dep) {
+      /* The list pointer is left as the deleted-slot marker so probe
+         sequences passing through this slot are not broken.*/
+      fhsp->element = NULL;
+      return;
+    }
+    i = (i + (size_t)1) & F_HASH_MASK;
+  }
+}
+#endif /* CH_CFG_FACTORY_HASH_INDEX == TRUE */
+
 static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
+#if CH_CFG_FACTORY_HASH_INDEX == TRUE
+  uint32_t key = chFactoryHashName(name);
+  size_t i = (size_t)key & F_HASH_MASK;
+  size_t n;
+
+  for (n = (size_t)0; n < (size_t)CH_CFG_FACTORY_HASH_SIZE; n++) {
+    factory_hash_slot_t *fhsp = &ch_factory.hash[i];
+
+    if ((fhsp->element == NULL) && (fhsp->list == NULL)) {
+      /* Free slot reached, the name is not in the table.*/
+      return NULL;
+    }
+    if ((fhsp->element != NULL) && (fhsp->list == dlp) &&
+        (fhsp->element->key == key) &&
+        (strncmp(fhsp->element->name, name,
+                 CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0)) {
+      return fhsp->element;
+    }
+    i = (i + (size_t)1) & F_HASH_MASK;
+  }
+
+  return NULL;
+#else
   dyn_element_t *p = dlp->next;
 
   while (p != (dyn_element_t *)dlp) {
@@ -99,6 +173,7 @@ static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
   }
 
   return NULL;
+#endif
 }
 
 static dyn_element_t *dyn_list_unlink(dyn_element_t *element,
@@ -110,6 +185,9 @@ static dyn_element_t *dyn_list_unlink(dyn_element_t *element,
     if (prev->next == element) {
       /* Found.*/
       prev->next = element->next;
+#if CH_CFG_FACTORY_HASH_INDEX == TRUE
+      dyn_hash_remove(element);
+#endif
       return element;
     }
 
@@ -151,6 +229,12 @@ static dyn_element_t *dyn_create_object_heap(const char *name,
   /* Updating factory list.*/
   dlp->next = dep;
 
+#if CH_CFG_FACTORY_HASH_INDEX == TRUE
+  /* Indexing the new element.*/
+  dep->key = chFactoryHashName(name);
+  dyn_hash_insert(dep, dlp);
+#endif
+
   return dep;
 }
 
@@ -200,6 +284,12 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
   /* Updating factory list.*/
   dlp->next = (dyn_element_t *)dep;
 
+#if CH_CFG_FACTORY_HASH_INDEX == TRUE
+  /* Indexing the new element.*/
+  dep->key = chFactoryHashName(name);
+  dyn_hash_insert(dep, dlp);
+#endif
+
   return dep;
 }
 
@@ -271,7 +361,43 @@ void _factory_init(void) {
 #if CH_CFG_FACTORY_OBJ_FIFOS == TRUE
   dyn_list_init(&ch_factory.fifo_list);
 #endif
+#if CH_CFG_FACTORY_HASH_INDEX == TRUE
+  memset((void *)ch_factory.hash, 0, sizeof ch_factory.hash);
+#endif
+}
+
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Computes the hash key of an object name.
+ * @details The returned key can be stored by the application and later
+ *          passed to @p chFactoryFindObjectByKey() in order to skip the
+ *          string hashing entirely in hot paths.
+ *
+ * @param[in] name      name to be hashed
+ * @return              The hash key of the name.
+ *
+ * @api
+ */
+uint32_t chFactoryHashName(const char *name) {
+  uint32_t h = (uint32_t)0x811C9DC5;
+#if CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0
+  unsigned i;
+
+  /* FNV-1a over at most the stored name length.*/
+  for (i = 0U; (i < (unsigned)CH_CFG_FACTORY_MAX_NAMES_LENGTH) &&
+               (name[i] != '\0'); i++) {
+    h = (h ^ (uint32_t)(uint8_t)name[i]) * (uint32_t)0x01000193;
+  }
+#else
+  while (*name != '\0') {
+    h = (h ^ (uint32_t)(uint8_t)*name) * (uint32_t)0x01000193;
+    name++;
+  }
+#endif
+
+  return h;
 }
+#endif /* CH_CFG_FACTORY_HASH_INDEX == TRUE */
 
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXIGEN__)
 /**
@@ -332,6 +458,57 @@ registered_object_t *chFactoryFindObject(const char *name) {
   return rop;
 }
 
+#if (CH_CFG_FACTORY_HASH_INDEX == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Retrieves a registered object by hash key.
+ * @details The key is the value returned by @p chFactoryHashName() for the
+ *          object name, string hashing and comparisons are entirely
+ *          skipped.
+ * @post    A reference to the registered object is returned with the
+ *          reference counter increased by one.
+ * @note    The names of the objects retrieved through this function must
+ *          not collide on the same key, the first object whose name hash
+ *          matches the key is returned.
+ *
+ * @param[in] key       hash key of the registered object name
+ *
+ * @return              The reference to the found registered object.
+ * @retval NULL         if a registered object with the specified key
+ *                      does not exist.
+ *
+ * @api
+ */
+registered_object_t *chFactoryFindObjectByKey(uint32_t key) {
+  registered_object_t *rop = NULL;
+  size_t i = (size_t)key & F_HASH_MASK;
+  size_t n;
+
+  F_LOCK();
+
+  for (n = (size_t)0; n < (size_t)CH_CFG_FACTORY_HASH_SIZE; n++) {
+    factory_hash_slot_t *fhsp = &ch_factory.hash[i];
+
+    if ((fhsp->element == NULL) && (fhsp->list == NULL)) {
+      /* Free slot reached, the key is not in the table.*/
+      break;
+    }
+    if ((fhsp->element != NULL) &&
+        (fhsp->list == &ch_factory.obj_list) &&
+        (fhsp->element->key == key)) {
+      /* Increasing references counter.*/
+      fhsp->element->refs++;
+      rop = (registered_object_t *)fhsp->element;
+      break;
+    }
+    i = (i + (size_t)1) & F_HASH_MASK;
+  }
+
+  F_UNLOCK();
+
+  return rop;
+}
+#endif /* CH_CFG_FACTORY_HASH_INDEX == TRUE */
+
 /**
  * @brief   Retrieves a registered object by pointer.
  * @post    A reference to the registered object is returned with the
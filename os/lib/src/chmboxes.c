@@ -50,10 +50,23 @@
  * @{
  */
 
+#include <string.h>
+
 #include "ch.h"
 
 #if (CH_CFG_USE_MAILBOXES == TRUE) || defined(__DOXYGEN__)
 
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*
+ * Fallback on ports not providing optimized bulk memory operations.
+ */
+#if !defined(PORT_SUPPORTS_MEMOPS)
+#define __port_memcpy(dp, sp, n)    memcpy((dp), (sp), (n))
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -66,10 +79,30 @@
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Head of the mailboxes enumeration list.
+ */
+static mailbox_t *mb_list;
+#endif
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/*
+ * High watermark update, a single compare and store on the post paths.
+ */
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) && !defined(__DOXYGEN__)
+#define MB_STATS_UPDATE(mbp) {                                              \
+  if ((mbp)->cnt > (mbp)->hwm) {                                            \
+    (mbp)->hwm = (mbp)->cnt;                                                \
+  }                                                                         \
+}
+#else
+#define MB_STATS_UPDATE(mbp)
+#endif
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -96,6 +129,15 @@ void chMBObjectInit(mailbox_t *mbp, msg_t *buf, size_t n) {
   mbp->reset  = false;
   chThdQueueObjectInit(&mbp->qw);
   chThdQueueObjectInit(&mbp->qr);
+
+#if CH_CFG_USE_MAILBOX_STATS == TRUE
+  /* Linking into the mailboxes enumeration list.*/
+  mbp->hwm = (size_t)0;
+  chSysLock();
+  mbp->next = mb_list;
+  mb_list = mbp;
+  chSysUnlock();
+#endif
 }
 
 /**
@@ -210,6 +252,7 @@ msg_t chMBPostTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
         mbp->wrptr = mbp->buffer;
       }
       mbp->cnt++;
+      MB_STATS_UPDATE(mbp);
 
       /* If there is a reader waiting then makes it ready.*/
       chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -257,6 +300,7 @@ msg_t chMBPostI(mailbox_t *mbp, msg_t msg) {
       mbp->wrptr = mbp->buffer;
     }
     mbp->cnt++;
+    MB_STATS_UPDATE(mbp);
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -335,6 +379,7 @@ msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
       }
       *mbp->rdptr = msg;
       mbp->cnt++;
+      MB_STATS_UPDATE(mbp);
 
       /* If there is a reader waiting then makes it ready.*/
       chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -382,6 +427,7 @@ msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg) {
     }
     *mbp->rdptr = msg;
     mbp->cnt++;
+    MB_STATS_UPDATE(mbp);
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -393,6 +439,122 @@ msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Posts a burst of messages into a mailbox.
+ * @details Up to @p n messages are copied from the caller array within a
+ *          single critical zone, waiting readers are woken only once at
+ *          the end of the burst. If the mailbox is full then the invoking
+ *          thread waits until a slot becomes available or the specified
+ *          time runs out.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         maximum number of messages to be posted
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of messages posted into the mailbox, it
+ *                      can be lower than @p n if the mailbox has less free
+ *                      slots available.
+ * @retval 0            if the operation timed out or the mailbox has been
+ *                      reset.
+ *
+ * @api
+ */
+size_t chMBPostBurstTimeout(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                            sysinterval_t timeout) {
+  size_t posted;
+
+  chSysLock();
+  posted = chMBPostBurstTimeoutS(mbp, msgp, n, timeout);
+  chSysUnlock();
+
+  return posted;
+}
+
+/**
+ * @brief   Posts a burst of messages into a mailbox.
+ * @details Up to @p n messages are copied from the caller array within a
+ *          single critical zone, waiting readers are woken only once at
+ *          the end of the burst. If the mailbox is full then the invoking
+ *          thread waits until a slot becomes available or the specified
+ *          time runs out.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         maximum number of messages to be posted
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of messages posted into the mailbox, it
+ *                      can be lower than @p n if the mailbox has less free
+ *                      slots available.
+ * @retval 0            if the operation timed out or the mailbox has been
+ *                      reset.
+ *
+ * @sclass
+ */
+size_t chMBPostBurstTimeoutS(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                             sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chDbgCheckClassS();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0));
+
+  do {
+    size_t free;
+
+    /* If the mailbox is in reset state then returns immediately.*/
+    if (mbp->reset) {
+      return (size_t)0;
+    }
+
+    /* Is there at least a free message slot in queue? if so then posts
+       as many messages as possible in a single pass.*/
+    free = chMBGetFreeCountI(mbp);
+    if (free > (size_t)0) {
+      size_t posted = (n < free) ? n : free;
+      size_t s1 = (size_t)(mbp->top - mbp->wrptr);
+
+      /* The messages are copied in at most two contiguous segments, the
+         slots are word-sized and word-aligned so the copies run entirely
+         on the bulk path.*/
+      if (posted < s1) {
+        __port_memcpy((void *)mbp->wrptr, (const void *)msgp,
+                      posted * sizeof (msg_t));
+        mbp->wrptr += posted;
+      }
+      else {
+        size_t s2 = posted - s1;
+
+        __port_memcpy((void *)mbp->wrptr, (const void *)msgp,
+                      s1 * sizeof (msg_t));
+        __port_memcpy((void *)mbp->buffer, (const void *)(msgp + s1),
+                      s2 * sizeof (msg_t));
+        mbp->wrptr = mbp->buffer + s2;
+      }
+      mbp->cnt += posted;
+      MB_STATS_UPDATE(mbp);
+
+      /* If there are readers waiting then makes them all ready, the
+         wakeup is paid once per burst.*/
+      chThdDequeueAllI(&mbp->qr, MSG_OK);
+      chSchRescheduleS();
+
+      return posted;
+    }
+
+    /* No space in the queue, waiting for a slot to become available.*/
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qw, timeout);
+  } while (rdymsg == MSG_OK);
+
+  return (size_t)0;
+}
+
 /**
  * @brief   Retrieves a message from a mailbox.
  * @details The invoking thread waits until a message is posted in the mailbox
@@ -517,6 +679,421 @@ msg_t chMBFetchI(mailbox_t *mbp, msg_t *msgp) {
   /* No message, immediate timeout.*/
   return MSG_TIMEOUT;
 }
+
+/**
+ * @brief   Retrieves a burst of messages from a mailbox.
+ * @details Up to @p n messages are copied into the caller array within a
+ *          single critical zone, waiting writers are woken only once at
+ *          the end of the burst. If the mailbox is empty then the invoking
+ *          thread waits until a message is posted or the specified time
+ *          runs out.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to the array for the received messages
+ * @param[in] n         maximum number of messages to be fetched
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of messages fetched from the mailbox, it
+ *                      can be lower than @p n if the mailbox has less
+ *                      messages queued.
+ * @retval 0            if the operation timed out or the mailbox has been
+ *                      reset.
+ *
+ * @api
+ */
+size_t chMBFetchBurstTimeout(mailbox_t *mbp, msg_t *msgp, size_t n,
+                             sysinterval_t timeout) {
+  size_t fetched;
+
+  chSysLock();
+  fetched = chMBFetchBurstTimeoutS(mbp, msgp, n, timeout);
+  chSysUnlock();
+
+  return fetched;
+}
+
+/**
+ * @brief   Retrieves a burst of messages from a mailbox.
+ * @details Up to @p n messages are copied into the caller array within a
+ *          single critical zone, waiting writers are woken only once at
+ *          the end of the burst. If the mailbox is empty then the invoking
+ *          thread waits until a message is posted or the specified time
+ *          runs out.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to the array for the received messages
+ * @param[in] n         maximum number of messages to be fetched
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of messages fetched from the mailbox, it
+ *                      can be lower than @p n if the mailbox has less
+ *                      messages queued.
+ * @retval 0            if the operation timed out or the mailbox has been
+ *                      reset.
+ *
+ * @sclass
+ */
+size_t chMBFetchBurstTimeoutS(mailbox_t *mbp, msg_t *msgp, size_t n,
+                              sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chDbgCheckClassS();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0));
+
+  do {
+    size_t used;
+
+    /* If the mailbox is in reset state then returns immediately.*/
+    if (mbp->reset) {
+      return (size_t)0;
+    }
+
+    /* Is there at least a message in queue? if so then fetches as many
+       messages as possible in a single pass.*/
+    used = chMBGetUsedCountI(mbp);
+    if (used > (size_t)0) {
+      size_t fetched = (n < used) ? n : used;
+      size_t s1 = (size_t)(mbp->top - mbp->rdptr);
+
+      /* The messages are copied in at most two contiguous segments, the
+         slots are word-sized and word-aligned so the copies run entirely
+         on the bulk path.*/
+      if (fetched < s1) {
+        __port_memcpy((void *)msgp, (const void *)mbp->rdptr,
+                      fetched * sizeof (msg_t));
+        mbp->rdptr += fetched;
+      }
+      else {
+        size_t s2 = fetched - s1;
+
+        __port_memcpy((void *)msgp, (const void *)mbp->rdptr,
+                      s1 * sizeof (msg_t));
+        __port_memcpy((void *)(msgp + s1), (const void *)mbp->buffer,
+                      s2 * sizeof (msg_t));
+        mbp->rdptr = mbp->buffer + s2;
+      }
+      mbp->cnt -= fetched;
+
+      /* If there are writers waiting then makes them all ready, the
+         wakeup is paid once per burst.*/
+      chThdDequeueAllI(&mbp->qw, MSG_OK);
+      chSchRescheduleS();
+
+      return fetched;
+    }
+
+    /* No message in the queue, waiting for a message to become available.*/
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qr, timeout);
+  } while (rdymsg == MSG_OK);
+
+  return (size_t)0;
+}
+
+#if (CH_CFG_USE_MAILBOX_STATS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the next mailbox in the enumeration list.
+ * @details All mailboxes initialized with @p chMBObjectInit() are linked
+ *          in a global list, the peak occupancy of each one is available
+ *          through @p chMBGetHighWatermarkX().
+ *
+ * @param[in] mbp       previously returned mailbox or @p NULL in order to
+ *                      start the enumeration
+ * @return              The next mailbox in the list.
+ * @retval NULL         if there are no more mailboxes.
+ *
+ * @xclass
+ */
+mailbox_t *chMBGetNextX(mailbox_t *mbp) {
+
+  return (mbp == NULL) ? mb_list : mbp->next;
+}
+#endif /* CH_CFG_USE_MAILBOX_STATS == TRUE */
+
+#if (CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p lf_mailbox_t object.
+ *
+ * @param[out] mbp      the pointer to the @p lf_mailbox_t structure to be
+ *                      initialized
+ * @param[in] buf       pointer to the messages buffer as an array of
+ *                      @p lf_mbslot_t
+ * @param[in] n         number of elements in the buffer array, it must be
+ *                      a power of two
+ *
+ * @init
+ */
+void chLFMBObjectInit(lf_mailbox_t *mbp, lf_mbslot_t *buf, size_t n) {
+  size_t i;
+
+  chDbgCheck((mbp != NULL) && (buf != NULL) && (n > (size_t)0) &&
+             ((n & (n - (size_t)1)) == (size_t)0));
+
+  mbp->buffer = buf;
+  mbp->mask   = n - (size_t)1;
+  mbp->wrpos  = (size_t)0;
+  mbp->rdpos  = (size_t)0;
+  mbp->qwcnt  = (cnt_t)0;
+  mbp->qrcnt  = (cnt_t)0;
+  for (i = (size_t)0; i < n; i++) {
+    buf[i].seq = i;
+  }
+  chThdQueueObjectInit(&mbp->qw);
+  chThdQueueObjectInit(&mbp->qr);
+}
+
+/**
+ * @brief   Posts a message into a lock-free mailbox.
+ * @details The message is posted in FIFO order without masking interrupts,
+ *          concurrent producers are serialized through an atomic
+ *          reservation of the write position.
+ * @note    This function does not wake up threads sleeping inside
+ *          @p chLFMBFetchTimeout(), it is done by the blocking
+ *          @p chLFMBPostTimeout() variant. ISR producers pairing with
+ *          blocking consumers should check the @p qrcnt field and perform
+ *          the wakeup with @p chThdDequeueNextI() from their own critical
+ *          zone.
+ *
+ * @param[in] mbp       the pointer to an initialized @p lf_mailbox_t object
+ * @param[in] msg       the message to be posted
+ * @return              The operation status.
+ * @retval MSG_OK       if a message has been correctly posted.
+ * @retval MSG_TIMEOUT  if the mailbox is full and the message cannot be
+ *                      posted.
+ *
+ * @xclass
+ */
+msg_t chLFMBPostX(lf_mailbox_t *mbp, msg_t msg) {
+  size_t pos;
+
+  chDbgCheck(mbp != NULL);
+
+  pos = __atomic_load_n(&mbp->wrpos, __ATOMIC_RELAXED);
+  for (;;) {
+    lf_mbslot_t *sp = &mbp->buffer[pos & mbp->mask];
+    size_t seq = __atomic_load_n(&sp->seq, __ATOMIC_ACQUIRE);
+    ptrdiff_t dif = (ptrdiff_t)(seq - pos);
+
+    if (dif == (ptrdiff_t)0) {
+      /* The slot is free, trying to reserve it.*/
+      if (__atomic_compare_exchange_n(&mbp->wrpos, &pos, pos + (size_t)1,
+                                      true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        /* Slot owned, storing the message then publishing it by advancing
+           the slot sequence.*/
+        sp->msg = msg;
+        __atomic_store_n(&sp->seq, pos + (size_t)1, __ATOMIC_RELEASE);
+
+        return MSG_OK;
+      }
+    }
+    else if (dif < (ptrdiff_t)0) {
+      /* The slot still contains an unfetched message, buffer full.*/
+      return MSG_TIMEOUT;
+    }
+    else {
+      /* Another producer overtook this position, retrying on the
+         current one.*/
+      pos = __atomic_load_n(&mbp->wrpos, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/**
+ * @brief   Retrieves a message from a lock-free mailbox.
+ * @details The message is fetched in FIFO order without masking interrupts,
+ *          concurrent consumers are serialized through an atomic
+ *          reservation of the read position.
+ * @note    This function does not wake up threads sleeping inside
+ *          @p chLFMBPostTimeout(), it is done by the blocking
+ *          @p chLFMBFetchTimeout() variant.
+ *
+ * @param[in] mbp       the pointer to an initialized @p lf_mailbox_t object
+ * @param[out] msgp     pointer to a message variable for the received message
+ * @return              The operation status.
+ * @retval MSG_OK       if a message has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the mailbox is empty and a message cannot be
+ *                      fetched.
+ *
+ * @xclass
+ */
+msg_t chLFMBFetchX(lf_mailbox_t *mbp, msg_t *msgp) {
+  size_t pos;
+
+  chDbgCheck((mbp != NULL) && (msgp != NULL));
+
+  pos = __atomic_load_n(&mbp->rdpos, __ATOMIC_RELAXED);
+  for (;;) {
+    lf_mbslot_t *sp = &mbp->buffer[pos & mbp->mask];
+    size_t seq = __atomic_load_n(&sp->seq, __ATOMIC_ACQUIRE);
+    ptrdiff_t dif = (ptrdiff_t)(seq - (pos + (size_t)1));
+
+    if (dif == (ptrdiff_t)0) {
+      /* The slot contains a published message, trying to reserve it.*/
+      if (__atomic_compare_exchange_n(&mbp->rdpos, &pos, pos + (size_t)1,
+                                      true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        /* Slot owned, reading the message then marking the slot free for
+           the next buffer lap.*/
+        *msgp = sp->msg;
+        __atomic_store_n(&sp->seq, pos + mbp->mask + (size_t)1,
+                         __ATOMIC_RELEASE);
+
+        return MSG_OK;
+      }
+    }
+    else if (dif < (ptrdiff_t)0) {
+      /* The slot has not been published yet, buffer empty.*/
+      return MSG_TIMEOUT;
+    }
+    else {
+      /* Another consumer overtook this position, retrying on the
+         current one.*/
+      pos = __atomic_load_n(&mbp->rdpos, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/**
+ * @brief   Posts a message into a lock-free mailbox.
+ * @details The invoking thread waits until a empty slot in the mailbox
+ *          becomes available or the specified time runs out. The fast path
+ *          is entirely lock-free, the kernel critical zone is only entered
+ *          when the mailbox is full or in order to wake up a sleeping
+ *          consumer.
+ *
+ * @param[in] mbp       the pointer to an initialized @p lf_mailbox_t object
+ * @param[in] msg       the message to be posted
+ * @param[in] timeout   message post timeout, the following special values
+ *                      are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a message has been correctly posted.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+msg_t chLFMBPostTimeout(lf_mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
+
+  for (;;) {
+    msg_t rdymsg;
+
+    if (chLFMBPostX(mbp, msg) == MSG_OK) {
+      /* Waking up a sleeping reader, if any. The counter is read outside
+         the critical zone, this is safe because sleeping readers re-check
+         the buffer from within the critical zone before suspending, a
+         wakeup cannot be lost.*/
+      if (mbp->qrcnt > (cnt_t)0) {
+        chSysLock();
+        chThdDequeueNextI(&mbp->qr, MSG_OK);
+        chSchRescheduleS();
+        chSysUnlock();
+      }
+
+      return MSG_OK;
+    }
+
+    /* Buffer full, falling back to the blocking path.*/
+    chSysLock();
+
+    /* Retrying from within the critical zone, a slot could have been
+       released before the zone was entered.*/
+    if (chLFMBPostX(mbp, msg) == MSG_OK) {
+      if (mbp->qrcnt > (cnt_t)0) {
+        chThdDequeueNextI(&mbp->qr, MSG_OK);
+        chSchRescheduleS();
+      }
+      chSysUnlock();
+
+      return MSG_OK;
+    }
+
+    /* Suspending until a consumer makes space or a timeout occurs.*/
+    mbp->qwcnt++;
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qw, timeout);
+    mbp->qwcnt--;
+    chSysUnlock();
+    if (rdymsg != MSG_OK) {
+      return rdymsg;
+    }
+  }
+}
+
+/**
+ * @brief   Retrieves a message from a lock-free mailbox.
+ * @details The invoking thread waits until a message is posted in the
+ *          mailbox or the specified time runs out. The fast path is
+ *          entirely lock-free, the kernel critical zone is only entered
+ *          when the mailbox is empty or in order to wake up a sleeping
+ *          producer.
+ *
+ * @param[in] mbp       the pointer to an initialized @p lf_mailbox_t object
+ * @param[out] msgp     pointer to a message variable for the received message
+ * @param[in] timeout   message fetch timeout, the following special values
+ *                      are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a message has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+msg_t chLFMBFetchTimeout(lf_mailbox_t *mbp, msg_t *msgp,
+                         sysinterval_t timeout) {
+
+  for (;;) {
+    msg_t rdymsg;
+
+    if (chLFMBFetchX(mbp, msgp) == MSG_OK) {
+      /* Waking up a sleeping writer, if any. The counter is read outside
+         the critical zone, this is safe because sleeping writers re-check
+         the buffer from within the critical zone before suspending, a
+         wakeup cannot be lost.*/
+      if (mbp->qwcnt > (cnt_t)0) {
+        chSysLock();
+        chThdDequeueNextI(&mbp->qw, MSG_OK);
+        chSchRescheduleS();
+        chSysUnlock();
+      }
+
+      return MSG_OK;
+    }
+
+    /* Buffer empty, falling back to the blocking path.*/
+    chSysLock();
+
+    /* Retrying from within the critical zone, a message could have been
+       posted before the zone was entered.*/
+    if (chLFMBFetchX(mbp, msgp) == MSG_OK) {
+      if (mbp->qwcnt > (cnt_t)0) {
+        chThdDequeueNextI(&mbp->qw, MSG_OK);
+        chSchRescheduleS();
+      }
+      chSysUnlock();
+
+      return MSG_OK;
+    }
+
+    /* Suspending until a producer posts a message or a timeout occurs.*/
+    mbp->qrcnt++;
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qr, timeout);
+    mbp->qrcnt--;
+    chSysUnlock();
+    if (rdymsg != MSG_OK) {
+      return rdymsg;
+    }
+  }
+}
+#endif /* CH_CFG_USE_MAILBOXES_LOCKFREE == TRUE */
 #endif /* CH_CFG_USE_MAILBOXES == TRUE */
 
 /** @} */
@@ -65,6 +65,15 @@ memcore_t ch_memcore;
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Fill value used when poisoning rewound core memory.
+ */
+#define MEMCORE_FILL_VALUE  0x55U
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
@@ -170,6 +179,101 @@ size_t chCoreGetStatusX(void) {
   return (size_t)(ch_memcore.endmem - ch_memcore.nextmem);
   /*lint -restore*/
 }
+
+/**
+ * @brief   Saves a core memory checkpoint.
+ * @details The saved checkpoint can later be passed to
+ *          @p chCoreRestoreMarkI() in order to release, in constant time,
+ *          all the core memory allocated after this call.
+ *
+ * @param[out] mcmp     pointer to a @p memcore_mark_t structure
+ *
+ * @iclass
+ */
+void chCoreSaveMarkI(memcore_mark_t *mcmp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(mcmp != NULL);
+
+  mcmp->markmem = ch_memcore.nextmem;
+}
+
+/**
+ * @brief   Saves a core memory checkpoint.
+ * @details The saved checkpoint can later be passed to
+ *          @p chCoreRestoreMark() in order to release, in constant time,
+ *          all the core memory allocated after this call.
+ *
+ * @param[out] mcmp     pointer to a @p memcore_mark_t structure
+ *
+ * @api
+ */
+void chCoreSaveMark(memcore_mark_t *mcmp) {
+
+  chSysLock();
+  chCoreSaveMarkI(mcmp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Restores a core memory checkpoint.
+ * @details All the core memory allocated after the checkpoint was saved is
+ *          made available again for allocation.
+ * @pre     No references must be left, anywhere, to the memory allocated
+ *          after the checkpoint, this includes objects handed to the other
+ *          allocators using the core memory as provider.
+ * @note    If @p CH_DBG_FILL_THREADS is enabled then the released memory
+ *          is filled with a poison pattern, stale pointers dereferencing
+ *          it become immediately evident. Note that the fill extends the
+ *          critical zone duration proportionally to the released area.
+ *
+ * @param[in] mcmp      pointer to a @p memcore_mark_t structure
+ *
+ * @iclass
+ */
+void chCoreRestoreMarkI(const memcore_mark_t *mcmp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(mcmp != NULL);
+  chDbgAssert((mcmp->markmem <= ch_memcore.nextmem) &&
+              (mcmp->markmem <= ch_memcore.endmem),
+              "invalid core memory mark");
+
+#if defined(CH_DBG_FILL_THREADS) && (CH_DBG_FILL_THREADS == TRUE)
+  {
+    uint8_t *p = mcmp->markmem;
+
+    while (p < ch_memcore.nextmem) {
+      *p = (uint8_t)MEMCORE_FILL_VALUE;
+      p++;
+    }
+  }
+#endif
+
+  ch_memcore.nextmem = mcmp->markmem;
+}
+
+/**
+ * @brief   Restores a core memory checkpoint.
+ * @details All the core memory allocated after the checkpoint was saved is
+ *          made available again for allocation.
+ * @pre     No references must be left, anywhere, to the memory allocated
+ *          after the checkpoint, this includes objects handed to the other
+ *          allocators using the core memory as provider.
+ * @note    If @p CH_DBG_FILL_THREADS is enabled then the released memory
+ *          is filled with a poison pattern, stale pointers dereferencing
+ *          it become immediately evident.
+ *
+ * @param[in] mcmp      pointer to a @p memcore_mark_t structure
+ *
+ * @api
+ */
+void chCoreRestoreMark(const memcore_mark_t *mcmp) {
+
+  chSysLock();
+  chCoreRestoreMarkI(mcmp);
+  chSysUnlock();
+}
 #endif /* CH_CFG_USE_MEMCORE == TRUE */
 
 /** @} */
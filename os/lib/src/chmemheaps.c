@@ -74,14 +74,125 @@
   ((size_t)((p1) - (p2)))                                                   \
   /*lint -restore*/
 
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/*
+ * Pattern used to fill the redzones, any partial overrun changes at
+ * least one byte of it.
+ */
+#define HEAP_GUARD_FILL     0xA5U
+#endif
+
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/*
+ * TLSF backend parameters. Sizes below 2^(TLSF_FL_BASE + 1) are mapped
+ * linearly on the first row of the segregated lists matrix, larger sizes
+ * are mapped logarithmically with TLSF_SL_COUNT subdivisions per power
+ * of two.
+ */
+#define TLSF_SL_BITS        3U
+#define TLSF_SL_COUNT       (1U << TLSF_SL_BITS)
+#define TLSF_FL_BASE        6U
+#define TLSF_SMALL_SIZE     ((size_t)1 << (TLSF_FL_BASE + 1U))
+#if (SIZEOF_PTR == 4) || defined(__DOXYGEN__)
+#define TLSF_FL_COUNT       (32U - TLSF_FL_BASE)
+#elif (SIZEOF_PTR == 2)
+#define TLSF_FL_COUNT       (16U - TLSF_FL_BASE)
+#endif
+
+/*
+ * TLSF block size field handling, the free flag is stored in the size
+ * LSB, sizes are always multiples of CH_HEAP_ALIGNMENT.
+ */
+#define TLSF_FREE_FLAG      ((size_t)1)
+#define TLSF_BSIZE(bp)      ((bp)->bsize & ~TLSF_FREE_FLAG)
+#define TLSF_IS_FREE(bp)    (((bp)->bsize & TLSF_FREE_FLAG) != (size_t)0)
+
+/*
+ * TLSF block header size and minimum block size, the free list pointers
+ * are overlaid on the used block fields so a free block does not require
+ * extra space.
+ */
+#define TLSF_HDR_SIZE       sizeof (tlsf_block_t)
+#define TLSF_MIN_BLOCK      (TLSF_HDR_SIZE + CH_HEAP_ALIGNMENT)
+
+/*
+ * Next physical block, valid for any block except the ending sentinel.
+ */
+#define TLSF_NEXT(bp)                                                       \
+  /*lint -save -e9087 [11.3] Safe cast.*/                                   \
+  ((tlsf_block_t *)(void *)((uint8_t *)(bp) + TLSF_BSIZE(bp)))              \
+  /*lint -restore*/
+
+/*
+ * Payload area of a TLSF block.
+ */
+#define TLSF_PAYLOAD(bp)    ((void *)((uint8_t *)(bp) + TLSF_HDR_SIZE))
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Last heap damage report.
+ * @details The structure is filled before halting, or before returning
+ *          from @p chHeapGuardCheck(), when a damaged redzone is found.
+ */
+heap_guard_report_t ch_heap_guard_report;
+#endif
+
 /*===========================================================================*/
 /* Module local types.                                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a TLSF block header.
+ * @details The @p heap and @p size fields of a used block are placed at
+ *          the end of the header so they overlay the position of the
+ *          classic @p heap_header_t, @p chHeapFree() and
+ *          @p chHeapGetSize() work unchanged on both block formats.
+ */
+typedef struct tlsf_block tlsf_block_t;
+struct tlsf_block {
+  tlsf_block_t          *phys_prev;     /**< @brief Previous physical block
+                                                    or @p NULL.             */
+  size_t                bsize;          /**< @brief Block size inclusive of
+                                                    the header, the LSB is
+                                                    the free flag.          */
+  union {
+    struct {
+      tlsf_block_t      *next;          /**< @brief Next free block in the
+                                                    segregated list.        */
+      tlsf_block_t      *prev;          /**< @brief Previous free block in
+                                                    the segregated list.    */
+    } free;
+    struct {
+      memory_heap_t     *heap;          /**< @brief Block owner heap.       */
+      size_t            size;           /**< @brief Requested size in
+                                                    bytes.                  */
+    } used;
+  } h;
+};
+
+/**
+ * @brief   Type of a TLSF control structure.
+ * @details The structure is allocated at the beginning of the heap buffer
+ *          by @p chHeapObjectInitTLSF().
+ */
+typedef struct {
+  uint32_t              flmap;          /**< @brief Bitmap of the non-empty
+                                                    matrix rows.            */
+  uint32_t              slmap[TLSF_FL_COUNT];
+                                        /**< @brief Bitmaps of the non-empty
+                                                    lists of each row.      */
+  tlsf_block_t          *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+                                        /**< @brief Matrix of the segregated
+                                                    free lists.             */
+} tlsf_control_t;
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module local variables.                                                   */
 /*===========================================================================*/
@@ -91,10 +202,439 @@
  */
 static memory_heap_t default_heap;
 
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Head of the guarded blocks list.
+ * @details All live allocations from all heaps are linked here so they
+ *          can be swept by @p chHeapGuardCheck().
+ */
+static heap_guard_t *guard_list;
+#endif
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the index of the most significant bit set.
+ * @pre     The argument must not be zero.
+ *
+ * @param[in] v         the value to be scanned
+ * @return              The bit index.
+ *
+ * @notapi
+ */
+static inline unsigned tlsf_msb(size_t v) {
+
+#if defined(__GNUC__) && !defined(__DOXYGEN__)
+  return (unsigned)((sizeof (unsigned long) * 8U) - 1U) -
+         (unsigned)__builtin_clzl((unsigned long)v);
+#else
+  unsigned n = 0U;
+
+  while (v > (size_t)1) {
+    v >>= 1;
+    n++;
+  }
+
+  return n;
+#endif
+}
+
+/**
+ * @brief   Returns the index of the least significant bit set.
+ * @pre     The argument must not be zero.
+ *
+ * @param[in] v         the value to be scanned
+ * @return              The bit index.
+ *
+ * @notapi
+ */
+static inline unsigned tlsf_lsb(uint32_t v) {
+
+#if defined(__GNUC__) && !defined(__DOXYGEN__)
+  return (unsigned)__builtin_ctzl((unsigned long)v);
+#else
+  unsigned n = 0U;
+
+  while ((v & 1U) == 0U) {
+    v >>= 1;
+    n++;
+  }
+
+  return n;
+#endif
+}
+
+/**
+ * @brief   Maps a block size on the segregated lists matrix.
+ *
+ * @param[in] size      the block size
+ * @param[out] flp      first level index
+ * @param[out] slp      second level index
+ *
+ * @notapi
+ */
+static void tlsf_mapping(size_t size, unsigned *flp, unsigned *slp) {
+
+  if (size < TLSF_SMALL_SIZE) {
+    *flp = 0U;
+    *slp = (unsigned)(size >> (TLSF_FL_BASE + 1U - TLSF_SL_BITS));
+  }
+  else {
+    unsigned t = tlsf_msb(size);
+
+    *flp = t - TLSF_FL_BASE;
+    *slp = (unsigned)(size >> (t - TLSF_SL_BITS)) & (TLSF_SL_COUNT - 1U);
+  }
+}
+
+/**
+ * @brief   Inserts a free block in the segregated lists matrix.
+ *
+ * @param[in] ctlp      pointer to the TLSF control structure
+ * @param[in] bp        pointer to the block to be inserted
+ *
+ * @notapi
+ */
+static void tlsf_insert(tlsf_control_t *ctlp, tlsf_block_t *bp) {
+  unsigned fl, sl;
+
+  tlsf_mapping(TLSF_BSIZE(bp), &fl, &sl);
+  bp->h.free.next = ctlp->blocks[fl][sl];
+  bp->h.free.prev = NULL;
+  if (ctlp->blocks[fl][sl] != NULL) {
+    ctlp->blocks[fl][sl]->h.free.prev = bp;
+  }
+  ctlp->blocks[fl][sl] = bp;
+  ctlp->slmap[fl] |= (uint32_t)1 << sl;
+  ctlp->flmap     |= (uint32_t)1 << fl;
+}
+
+/**
+ * @brief   Removes a free block from the segregated lists matrix.
+ *
+ * @param[in] ctlp      pointer to the TLSF control structure
+ * @param[in] bp        pointer to the block to be removed
+ *
+ * @notapi
+ */
+static void tlsf_remove(tlsf_control_t *ctlp, tlsf_block_t *bp) {
+  unsigned fl, sl;
+
+  tlsf_mapping(TLSF_BSIZE(bp), &fl, &sl);
+  if (bp->h.free.prev != NULL) {
+    bp->h.free.prev->h.free.next = bp->h.free.next;
+  }
+  else {
+    ctlp->blocks[fl][sl] = bp->h.free.next;
+    if (ctlp->blocks[fl][sl] == NULL) {
+      ctlp->slmap[fl] &= ~((uint32_t)1 << sl);
+      if (ctlp->slmap[fl] == 0U) {
+        ctlp->flmap &= ~((uint32_t)1 << fl);
+      }
+    }
+  }
+  if (bp->h.free.next != NULL) {
+    bp->h.free.next->h.free.prev = bp->h.free.prev;
+  }
+}
+
+/**
+ * @brief   Finds and removes a free block of sufficient size.
+ * @details The request size is rounded up to the next list boundary so
+ *          any block found in the selected or following lists is
+ *          guaranteed to fit, no list walking is required.
+ *
+ * @param[in] ctlp      pointer to the TLSF control structure
+ * @param[in] size      the minimum block size
+ * @return              The pointer to the found block.
+ * @retval NULL         if no suitable block exists.
+ *
+ * @notapi
+ */
+static tlsf_block_t *tlsf_find(tlsf_control_t *ctlp, size_t size) {
+  tlsf_block_t *bp;
+  unsigned fl, sl;
+  uint32_t map;
+
+  /* Rounding up to the next list boundary.*/
+  if (size >= TLSF_SMALL_SIZE) {
+    size += ((size_t)1 << (tlsf_msb(size) - TLSF_SL_BITS)) - (size_t)1;
+  }
+  else {
+    size += ((size_t)1 << (TLSF_FL_BASE + 1U - TLSF_SL_BITS)) - (size_t)1;
+  }
+  tlsf_mapping(size, &fl, &sl);
+
+  /* Searching the mapped row starting from the mapped list.*/
+  map = ctlp->slmap[fl] & (~(uint32_t)0 << sl);
+  if (map == 0U) {
+    /* Nothing in the mapped row, going up to the first non-empty row.*/
+    map = ctlp->flmap & (~(uint32_t)0 << (fl + 1U));
+    if (map == 0U) {
+      return NULL;
+    }
+    fl  = tlsf_lsb(map);
+    map = ctlp->slmap[fl];
+  }
+  sl = tlsf_lsb(map);
+
+  bp = ctlp->blocks[fl][sl];
+  tlsf_remove(ctlp, bp);
+
+  return bp;
+}
+
+/**
+ * @brief   Splits the trailing excess of a block, if large enough.
+ *
+ * @param[in] ctlp      pointer to the TLSF control structure
+ * @param[in] bp        pointer to the block to be split
+ * @param[in] size      the required block size
+ *
+ * @notapi
+ */
+static void tlsf_trim(tlsf_control_t *ctlp, tlsf_block_t *bp, size_t size) {
+
+  if (TLSF_BSIZE(bp) - size >= TLSF_MIN_BLOCK) {
+    tlsf_block_t *rp;
+
+    /*lint -save -e9087 [11.3] Safe cast.*/
+    rp = (tlsf_block_t *)(void *)((uint8_t *)bp + size);
+    /*lint -restore*/
+    rp->bsize     = (TLSF_BSIZE(bp) - size) | TLSF_FREE_FLAG;
+    rp->phys_prev = bp;
+    bp->bsize     = size | (bp->bsize & TLSF_FREE_FLAG);
+    TLSF_NEXT(rp)->phys_prev = rp;
+    tlsf_insert(ctlp, rp);
+  }
+}
+
+/**
+ * @brief   TLSF allocation.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] size      the size of the block to be allocated
+ * @param[in] align     desired memory alignment
+ * @return              A pointer to the aligned allocated block.
+ * @retval NULL         if the block cannot be allocated.
+ *
+ * @notapi
+ */
+static void *tlsf_alloc(memory_heap_t *heapp, size_t size, unsigned align) {
+  tlsf_control_t *ctlp = (tlsf_control_t *)heapp->tlsf;
+  tlsf_block_t *bp;
+  size_t need;
+
+  /* Block size inclusive of the header.*/
+  need = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT) + TLSF_HDR_SIZE;
+  if (need < TLSF_MIN_BLOCK) {
+    need = TLSF_MIN_BLOCK;
+  }
+
+  H_LOCK(heapp);
+
+  if (align <= CH_HEAP_ALIGNMENT) {
+    /* Natural alignment, constant-time path.*/
+    bp = tlsf_find(ctlp, need);
+    if (bp == NULL) {
+      H_UNLOCK(heapp);
+
+      return NULL;
+    }
+  }
+  else {
+    uint8_t *pay, *apay;
+
+    /* Extended alignment, over-allocating so the payload can be moved
+       forward to an aligned boundary leaving room for a leading free
+       block.*/
+    bp = tlsf_find(ctlp, need + (size_t)align + TLSF_MIN_BLOCK);
+    if (bp == NULL) {
+      H_UNLOCK(heapp);
+
+      return NULL;
+    }
+
+    pay  = (uint8_t *)TLSF_PAYLOAD(bp);
+    apay = (uint8_t *)MEM_ALIGN_NEXT(pay, align);
+    while ((apay != pay) && ((size_t)(apay - pay) < TLSF_MIN_BLOCK)) {
+      apay += align;
+    }
+    if (apay != pay) {
+      tlsf_block_t *abp;
+
+      /* Splitting the leading gap into a new free block.*/
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      abp = (tlsf_block_t *)(void *)(apay - TLSF_HDR_SIZE);
+      /*lint -restore*/
+      abp->bsize     = TLSF_BSIZE(bp) - (size_t)((uint8_t *)abp -
+                                                 (uint8_t *)bp);
+      abp->phys_prev = bp;
+      bp->bsize      = (size_t)((uint8_t *)abp - (uint8_t *)bp) |
+                       TLSF_FREE_FLAG;
+      TLSF_NEXT(abp)->phys_prev = abp;
+      tlsf_insert(ctlp, bp);
+      bp = abp;
+    }
+  }
+
+  /* Returning the trailing excess, if any, then marking the block as
+     used.*/
+  tlsf_trim(ctlp, bp, need);
+  bp->bsize &= ~TLSF_FREE_FLAG;
+  bp->h.used.heap = heapp;
+  bp->h.used.size = size;
+
+  H_UNLOCK(heapp);
+
+  return TLSF_PAYLOAD(bp);
+}
+
+/**
+ * @brief   TLSF release.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] p         pointer to the memory block to be freed
+ *
+ * @notapi
+ */
+static void tlsf_free(memory_heap_t *heapp, void *p) {
+  tlsf_control_t *ctlp = (tlsf_control_t *)heapp->tlsf;
+  tlsf_block_t *bp, *nbp, *pbp;
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  bp = (tlsf_block_t *)(void *)((uint8_t *)p - TLSF_HDR_SIZE);
+  /*lint -restore*/
+
+  chDbgAssert(!TLSF_IS_FREE(bp), "double free");
+
+  H_LOCK(heapp);
+
+  bp->bsize |= TLSF_FREE_FLAG;
+
+  /* Merging with the next physical block, if free. The ending sentinel
+     has a zero size and is never free.*/
+  nbp = TLSF_NEXT(bp);
+  if (TLSF_IS_FREE(nbp)) {
+    tlsf_remove(ctlp, nbp);
+    bp->bsize += TLSF_BSIZE(nbp);
+  }
+
+  /* Merging with the previous physical block, if free.*/
+  pbp = bp->phys_prev;
+  if ((pbp != NULL) && TLSF_IS_FREE(pbp)) {
+    tlsf_remove(ctlp, pbp);
+    pbp->bsize += TLSF_BSIZE(bp);
+    bp = pbp;
+  }
+
+  TLSF_NEXT(bp)->phys_prev = bp;
+  tlsf_insert(ctlp, bp);
+
+  H_UNLOCK(heapp);
+}
+
+/**
+ * @brief   TLSF heap status.
+ * @details The physical blocks list is walked, the execution time depends
+ *          on the number of blocks.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] totalp    pointer to a variable that will receive the total
+ *                      fragmented free space or @p NULL
+ * @param[in] largestp  pointer to a variable that will receive the largest
+ *                      free free block found space or @p NULL
+ * @return              The number of fragments in the heap.
+ *
+ * @notapi
+ */
+static size_t tlsf_status(memory_heap_t *heapp,
+                          size_t *totalp, size_t *largestp) {
+  tlsf_block_t *bp;
+  size_t n, total, largest;
+
+  H_LOCK(heapp);
+
+  n       = 0U;
+  total   = 0U;
+  largest = 0U;
+
+  /* The first physical block follows the control structure.*/
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  bp = (tlsf_block_t *)(void *)((uint8_t *)heapp->tlsf +
+                                MEM_ALIGN_NEXT(sizeof (tlsf_control_t),
+                                               CH_HEAP_ALIGNMENT));
+  /*lint -restore*/
+  while (TLSF_BSIZE(bp) != (size_t)0) {
+    if (TLSF_IS_FREE(bp)) {
+      size_t free = TLSF_BSIZE(bp) - TLSF_HDR_SIZE;
+
+      n++;
+      total += free;
+      if (free > largest) {
+        largest = free;
+      }
+    }
+    bp = TLSF_NEXT(bp);
+  }
+
+  if (totalp != NULL) {
+    *totalp = total;
+  }
+  if (largestp != NULL) {
+    *largestp = largest;
+  }
+
+  H_UNLOCK(heapp);
+
+  return n;
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Verifies the redzone of a guarded block.
+ *
+ * @param[in] ghp       pointer to the guard header
+ * @return              The redzone state.
+ * @retval true         if the redzone is intact.
+ * @retval false        if the redzone has been overwritten.
+ *
+ * @notapi
+ */
+static bool heap_guard_is_intact(const heap_guard_t *ghp) {
+  const uint8_t *rzp = (const uint8_t *)(const void *)(ghp + 1U) + ghp->size;
+  size_t i;
+
+  for (i = 0U; i < (size_t)CH_CFG_HEAP_GUARD_SIZE; i++) {
+    if (rzp[i] != (uint8_t)HEAP_GUARD_FILL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Fills the damage report for a guarded block.
+ *
+ * @param[in] ghp       pointer to the guard header
+ *
+ * @notapi
+ */
+static void heap_guard_report(heap_guard_t *ghp) {
+
+  ch_heap_guard_report.p     = (void *)(ghp + 1U);
+  ch_heap_guard_report.owner = ghp->owner;
+#if CH_CFG_USE_REGISTRY == TRUE
+  ch_heap_guard_report.name  = chRegGetThreadNameX(ghp->owner);
+#endif
+}
+#endif /* CH_CFG_USE_HEAP_GUARD == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -109,6 +649,9 @@ void _heap_init(void) {
   default_heap.provider = chCoreAllocAlignedWithOffset;
   H_NEXT(&default_heap.header) = NULL;
   H_PAGES(&default_heap.header) = 0;
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  default_heap.tlsf = NULL;
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&default_heap.mtx);
 #else
@@ -145,6 +688,9 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
   H_PAGES(&heapp->header) = 0;
   H_NEXT(hp) = NULL;
   H_PAGES(hp) = (size - sizeof (heap_header_t)) / CH_HEAP_ALIGNMENT;
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heapp->tlsf = NULL;
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&heapp->mtx);
 #else
@@ -152,34 +698,110 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
 #endif
 }
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
 /**
- * @brief   Allocates a block of memory from the heap by using the first-fit
- *          algorithm.
- * @details The allocated block is guaranteed to be properly aligned to the
- *          specified alignment.
+ * @brief   Initializes a TLSF memory heap from a static memory area.
+ * @details The heap uses a two-level segregated-fit allocation strategy,
+ *          allocations and releases are performed in constant time
+ *          regardless of the heap fragmentation state. The TLSF control
+ *          structure is carved from the beginning of the heap buffer.
+ * @note    The heap buffer base and size are adjusted if the passed buffer
+ *          is not aligned to @p CH_HEAP_ALIGNMENT. This mean that the
+ *          effective heap size can be less than @p size.
+ *
+ * @param[out] heapp    pointer to the memory heap descriptor to be initialized
+ * @param[in] buf       heap buffer base
+ * @param[in] size      heap size
+ *
+ * @init
+ */
+void chHeapObjectInitTLSF(memory_heap_t *heapp, void *buf, size_t size) {
+  tlsf_control_t *ctlp;
+  tlsf_block_t *bp, *sp;
+  uint8_t *base = (uint8_t *)MEM_ALIGN_NEXT(buf, CH_HEAP_ALIGNMENT);
+  size_t ctlsize = MEM_ALIGN_NEXT(sizeof (tlsf_control_t),
+                                  CH_HEAP_ALIGNMENT);
+  unsigned fl, sl;
+
+  chDbgCheck((heapp != NULL) && (buf != NULL));
+
+  /* Adjusting the size in case the initial block was not correctly
+     aligned.*/
+  /*lint -save -e9033 [10.8] Required cast operations.*/
+  size -= (size_t)(base - (uint8_t *)buf);
+  /*lint -restore*/
+  size = MEM_ALIGN_PREV(size, CH_HEAP_ALIGNMENT);
+
+  /* The buffer must be able to contain the control structure, the ending
+     sentinel and at least one block of minimum size.*/
+  chDbgCheck(size >= ctlsize + TLSF_MIN_BLOCK + TLSF_HDR_SIZE);
+
+  /* Initializing the control structure, all lists empty.*/
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  ctlp = (tlsf_control_t *)(void *)base;
+  /*lint -restore*/
+  ctlp->flmap = 0U;
+  for (fl = 0U; fl < TLSF_FL_COUNT; fl++) {
+    ctlp->slmap[fl] = 0U;
+    for (sl = 0U; sl < TLSF_SL_COUNT; sl++) {
+      ctlp->blocks[fl][sl] = NULL;
+    }
+  }
+
+  /* Initializing the heap descriptor, TLSF heaps have no provider.*/
+  heapp->provider = NULL;
+  H_NEXT(&heapp->header) = NULL;
+  H_PAGES(&heapp->header) = 0;
+  heapp->tlsf = (void *)ctlp;
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+  chMtxObjectInit(&heapp->mtx);
+#else
+  chSemObjectInit(&heapp->sem, (cnt_t)1);
+#endif
+
+  /* The whole remaining space becomes the initial free block, it is
+     followed by a zero-sized used sentinel marking the heap end.*/
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  bp = (tlsf_block_t *)(void *)(base + ctlsize);
+  /*lint -restore*/
+  bp->phys_prev = NULL;
+  bp->bsize     = (size - ctlsize - TLSF_HDR_SIZE) | TLSF_FREE_FLAG;
+  sp            = TLSF_NEXT(bp);
+  sp->phys_prev = bp;
+  sp->bsize     = (size_t)0;
+  tlsf_insert(ctlp, bp);
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
+/**
+ * @brief   Heap allocation, backend selection.
  *
  * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
  *                      access the default heap.
- * @param[in] size      the size of the block to be allocated. Note that the
- *                      allocated block may be a bit bigger than the requested
- *                      size for alignment and fragmentation reasons.
+ * @param[in] size      the size of the block to be allocated
  * @param[in] align     desired memory alignment
  * @return              A pointer to the aligned allocated block.
  * @retval NULL         if the block cannot be allocated.
  *
- * @api
+ * @notapi
  */
-void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
+static void *heap_alloc(memory_heap_t *heapp, size_t size, unsigned align) {
   heap_header_t *qp, *hp, *ahp;
   size_t pages;
 
-  chDbgCheck((size > 0U) && MEM_IS_VALID_ALIGNMENT(align));
-
   /* If an heap is not specified then the default system header is used.*/
   if (heapp == NULL) {
     heapp = &default_heap;
   }
 
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* Heaps initialized with chHeapObjectInitTLSF() are served by the
+     TLSF backend.*/
+  if (heapp->tlsf != NULL) {
+    return tlsf_alloc(heapp, size, align);
+  }
+#endif
+
   /* Minimum alignment is constrained by the heap header structure size.*/
   if (align < CH_HEAP_ALIGNMENT) {
     align = CH_HEAP_ALIGNMENT;
@@ -284,22 +906,102 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
 }
 
 /**
- * @brief   Frees a previously allocated memory block.
+ * @brief   Allocates a block of memory from the heap by using the first-fit
+ *          algorithm.
+ * @details The allocated block is guaranteed to be properly aligned to the
+ *          specified alignment.
  *
- * @param[in] p         pointer to the memory block to be freed
+ * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
+ *                      access the default heap.
+ * @param[in] size      the size of the block to be allocated. Note that the
+ *                      allocated block may be a bit bigger than the requested
+ *                      size for alignment and fragmentation reasons.
+ * @param[in] align     desired memory alignment
+ * @return              A pointer to the aligned allocated block.
+ * @retval NULL         if the block cannot be allocated.
  *
  * @api
  */
-void chHeapFree(void *p) {
+void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
+
+  chDbgCheck((size > 0U) && MEM_IS_VALID_ALIGNMENT(align));
+
+#if CH_CFG_USE_HEAP_GUARD == TRUE
+  {
+    heap_guard_t *ghp;
+    uint8_t *base, *rzp;
+    size_t goffset, i;
+
+    if (align < CH_HEAP_ALIGNMENT) {
+      align = CH_HEAP_ALIGNMENT;
+    }
+
+    /* The guard header is placed immediately before the returned area,
+       the area offset is rounded up so the requested alignment is
+       preserved.*/
+    goffset = MEM_ALIGN_NEXT(sizeof (heap_guard_t), align);
+    base = heap_alloc(heapp, goffset + size + (size_t)CH_CFG_HEAP_GUARD_SIZE,
+                      align);
+    if (base == NULL) {
+      return NULL;
+    }
+
+    /*lint -save -e9087 [11.3] Safe cast.*/
+    ghp = (heap_guard_t *)(void *)(base + goffset) - 1;
+    /*lint -restore*/
+    ghp->size = size;
+    ghp->base = (void *)base;
+
+    /* Filling the redzone that follows the returned area.*/
+    rzp = base + goffset + size;
+    for (i = 0U; i < (size_t)CH_CFG_HEAP_GUARD_SIZE; i++) {
+      rzp[i] = (uint8_t)HEAP_GUARD_FILL;
+    }
+
+    /* Tagging the owner and linking into the guarded blocks list.*/
+    chSysLock();
+    ghp->owner = chThdGetSelfX();
+    ghp->next  = guard_list;
+    ghp->prev  = NULL;
+    if (guard_list != NULL) {
+      guard_list->prev = ghp;
+    }
+    guard_list = ghp;
+    chSysUnlock();
+
+    return (void *)(base + goffset);
+  }
+#else
+  return heap_alloc(heapp, size, align);
+#endif
+}
+
+/**
+ * @brief   Heap release, backend selection.
+ *
+ * @param[in] p         pointer to the memory block to be freed
+ *
+ * @notapi
+ */
+static void heap_free(void *p) {
   heap_header_t *qp, *hp;
   memory_heap_t *heapp;
 
-  chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
-
   /*lint -save -e9087 [11.3] Safe cast.*/
   hp = (heap_header_t *)p - 1U;
   /*lint -restore*/
   heapp = H_HEAP(hp);
+
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* The owner heap field is stored in the same position by both block
+     formats, TLSF blocks are returned to the TLSF backend.*/
+  if (heapp->tlsf != NULL) {
+    tlsf_free(heapp, p);
+
+    return;
+  }
+#endif
+
   qp = &heapp->header;
 
   /* Size is converted in number of elementary allocation units.*/
@@ -339,6 +1041,94 @@ void chHeapFree(void *p) {
   return;
 }
 
+/**
+ * @brief   Frees a previously allocated memory block.
+ * @note    If the heap guard is enabled then the block redzone is
+ *          verified, the system is halted with message "heap guard" if
+ *          an overrun is detected, @p ch_heap_guard_report is filled
+ *          with the damaged block address and owner before halting.
+ *
+ * @param[in] p         pointer to the memory block to be freed
+ *
+ * @api
+ */
+void chHeapFree(void *p) {
+
+  chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
+
+#if CH_CFG_USE_HEAP_GUARD == TRUE
+  {
+    heap_guard_t *ghp = (heap_guard_t *)p - 1;
+
+    if (!heap_guard_is_intact(ghp)) {
+      heap_guard_report(ghp);
+      chSysHalt("heap guard");
+    }
+
+    /* Unlinking from the guarded blocks list.*/
+    chSysLock();
+    if (ghp->prev != NULL) {
+      ghp->prev->next = ghp->next;
+    }
+    else {
+      guard_list = ghp->next;
+    }
+    if (ghp->next != NULL) {
+      ghp->next->prev = ghp->prev;
+    }
+    chSysUnlock();
+
+    heap_free(ghp->base);
+  }
+#else
+  heap_free(p);
+#endif
+}
+
+#if (CH_CFG_USE_HEAP_GUARD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Sweeps all live allocations verifying their redzones.
+ * @details The function is meant to be invoked periodically, for example
+ *          from a low priority or idle-time thread, so overruns are
+ *          detected close to when they happen instead of when the
+ *          damaged block is eventually freed.
+ * @note    The sweep is performed in a single critical section, the
+ *          duration depends on the number of live allocations and on
+ *          @p CH_CFG_HEAP_GUARD_SIZE.
+ *
+ * @param[out] ownerp   pointer to a variable that will receive the thread
+ *                      owning the damaged block or @p NULL
+ * @return              A pointer to the first damaged block found, the
+ *                      owning thread name, if the registry is enabled,
+ *                      is available in @p ch_heap_guard_report.
+ * @retval NULL         if all redzones are intact.
+ *
+ * @api
+ */
+void *chHeapGuardCheck(thread_t **ownerp) {
+  heap_guard_t *ghp;
+
+  chSysLock();
+  ghp = guard_list;
+  while (ghp != NULL) {
+    if (!heap_guard_is_intact(ghp)) {
+      heap_guard_report(ghp);
+      chSysUnlock();
+
+      if (ownerp != NULL) {
+        *ownerp = ch_heap_guard_report.owner;
+      }
+
+      return ch_heap_guard_report.p;
+    }
+    ghp = ghp->next;
+  }
+  chSysUnlock();
+
+  return NULL;
+}
+#endif /* CH_CFG_USE_HEAP_GUARD == TRUE */
+
 /**
  * @brief   Reports the heap status.
  * @note    This function is meant to be used in the test suite, it should
@@ -362,6 +1152,12 @@ size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
     heapp = &default_heap;
   }
 
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  if (heapp->tlsf != NULL) {
+    return tlsf_status(heapp, totalp, largestp);
+  }
+#endif
+
   H_LOCK(heapp);
   tpages = 0U;
   lpages = 0U;
@@ -206,6 +206,138 @@ void chPoolFree(memory_pool_t *mp, void *objp) {
   chSysUnlock();
 }
 
+/**
+ * @brief   Initializes an empty pool cache.
+ * @details The cache is bound to a shared memory pool, objects allocated
+ *          and released through the cache only touch the shared pool when
+ *          the cache is refilled or flushed in batches of half its depth.
+ * @pre     The backing memory pool must already be initialized.
+ * @note    The cache must only be used by its owner thread, this is what
+ *          makes the common paths lock-free.
+ *
+ * @param[out] pcp      pointer to a @p pool_cache_t structure
+ * @param[in] mp        pointer to the backing @p memory_pool_t structure
+ * @param[in] buf       pointer to the cached objects pointers array
+ * @param[in] n         number of elements in the array
+ *
+ * @init
+ */
+void chPoolCacheObjectInit(pool_cache_t *pcp, memory_pool_t *mp,
+                           void **buf, size_t n) {
+
+  chDbgCheck((pcp != NULL) && (mp != NULL) && (buf != NULL) &&
+             (n >= (size_t)2));
+
+  pcp->pool    = mp;
+  pcp->objects = buf;
+  pcp->depth   = n;
+  pcp->cnt     = (size_t)0;
+}
+
+/**
+ * @brief   Allocates an object through a pool cache.
+ * @details If the cache is not empty then the object is taken from there
+ *          without entering a critical zone, else the cache is refilled
+ *          with a batch of objects from the shared pool within a single
+ *          critical zone.
+ * @pre     The invoking thread must be the cache owner.
+ *
+ * @param[in] pcp       pointer to a @p pool_cache_t structure
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if both the cache and the pool are empty.
+ *
+ * @api
+ */
+void *chPoolCacheAlloc(pool_cache_t *pcp) {
+
+  chDbgCheck(pcp != NULL);
+
+  /* Fast path, the object is taken from the cache.*/
+  if (pcp->cnt > (size_t)0) {
+    pcp->cnt--;
+
+    return pcp->objects[pcp->cnt];
+  }
+
+  /* Cache empty, refilling with up to half depth objects in a single
+     critical zone.*/
+  chSysLock();
+  while (pcp->cnt < (pcp->depth + (size_t)1) / (size_t)2) {
+    void *objp = chPoolAllocI(pcp->pool);
+
+    if (objp == NULL) {
+      break;
+    }
+    pcp->objects[pcp->cnt] = objp;
+    pcp->cnt++;
+  }
+  chSysUnlock();
+
+  if (pcp->cnt == (size_t)0) {
+    return NULL;
+  }
+
+  pcp->cnt--;
+
+  return pcp->objects[pcp->cnt];
+}
+
+/**
+ * @brief   Releases an object through a pool cache.
+ * @details If the cache is not full then the object is stored there
+ *          without entering a critical zone, else half of the cached
+ *          objects are returned to the shared pool within a single
+ *          critical zone.
+ * @pre     The invoking thread must be the cache owner.
+ * @pre     The released object must come from the backing pool or be of
+ *          the right size and alignment for it.
+ *
+ * @param[in] pcp       pointer to a @p pool_cache_t structure
+ * @param[in] objp      the pointer to the object to be released
+ *
+ * @api
+ */
+void chPoolCacheFree(pool_cache_t *pcp, void *objp) {
+
+  chDbgCheck((pcp != NULL) && (objp != NULL));
+
+  if (pcp->cnt >= pcp->depth) {
+    /* Cache full, flushing half of the cached objects back to the shared
+       pool in a single critical zone.*/
+    chSysLock();
+    while (pcp->cnt > pcp->depth / (size_t)2) {
+      pcp->cnt--;
+      chPoolFreeI(pcp->pool, pcp->objects[pcp->cnt]);
+    }
+    chSysUnlock();
+  }
+
+  pcp->objects[pcp->cnt] = objp;
+  pcp->cnt++;
+}
+
+/**
+ * @brief   Flushes a pool cache.
+ * @details All the cached objects are returned to the shared pool, the
+ *          cache can then be safely abandoned, for example before the
+ *          owner thread terminates.
+ *
+ * @param[in] pcp       pointer to a @p pool_cache_t structure
+ *
+ * @api
+ */
+void chPoolCacheFlush(pool_cache_t *pcp) {
+
+  chDbgCheck(pcp != NULL);
+
+  chSysLock();
+  while (pcp->cnt > (size_t)0) {
+    pcp->cnt--;
+    chPoolFreeI(pcp->pool, pcp->objects[pcp->cnt]);
+  }
+  chSysUnlock();
+}
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Initializes an empty guarded memory pool.
@@ -224,6 +356,10 @@ void chGuardedPoolObjectInitAligned(guarded_memory_pool_t *gmp,
 
   chPoolObjectInitAligned(&gmp->pool, size, align, NULL);
   chSemObjectInit(&gmp->sem, (cnt_t)0);
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+  chEvtObjectInit(&gmp->lowev);
+  gmp->lowlevel = (cnt_t)0;
+#endif
 }
 
 /**
@@ -270,13 +406,26 @@ void chGuardedPoolLoadArray(guarded_memory_pool_t *gmp, void *p, size_t n) {
 void *chGuardedPoolAllocTimeoutS(guarded_memory_pool_t *gmp,
                                  sysinterval_t timeout) {
   msg_t msg;
+  void *p;
 
   msg = chSemWaitTimeoutS(&gmp->sem, timeout);
   if (msg != MSG_OK) {
     return NULL;
   }
 
-  return chPoolAllocI(&gmp->pool);
+  p = chPoolAllocI(&gmp->pool);
+
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+  /* If the free objects dropped below the low watermark then the
+     replenisher threads are notified.*/
+  if ((gmp->lowlevel > (cnt_t)0) &&
+      (chSemGetCounterI(&gmp->sem) < gmp->lowlevel)) {
+    chEvtBroadcastI(&gmp->lowev);
+    chSchRescheduleS();
+  }
+#endif
+
+  return p;
 }
 
 /**
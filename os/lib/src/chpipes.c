@@ -31,12 +31,17 @@
  *          - <b>Reset</b>: The pipe is emptied and all the stored data
  *            is lost.
  *          .
+ *          Data is moved with @p memcpy() in at most two segments per
+ *          operation, one before and one after the circular buffer wrap
+ *          point.
  * @pre     In order to use the pipes APIs the @p CH_CFG_USE_PIPES
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
  * @{
  */
 
+#include <string.h>
+
 #include "ch.h"
 
 #if (CH_CFG_USE_PIPES == TRUE) || defined(__DOXYGEN__)
@@ -45,6 +50,13 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+/*
+ * Fallback on ports not providing optimized bulk memory operations.
+ */
+#if !defined(PORT_SUPPORTS_MEMOPS)
+#define __port_memcpy(dp, sp, n)    memcpy((dp), (sp), (n))
+#endif
+
 /*
  * Defaults on the best synchronization mechanism available.
  */
@@ -72,12 +84,181 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Non-blocking pipe write.
+ * @details The function writes data from a buffer to a pipe. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or when the pipe buffer has been filled. The data
+ *          is copied in at most two @p memcpy() segments.
+ * @pre     The pipe access mutex must be owned by the invoking thread.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_write(pipe_t *pp, const uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  /* Number of bytes that can be written in a single atomic operation.*/
+  if (n > chPipeGetSizeI(pp) - pp->cnt) {
+    n = chPipeGetSizeI(pp) - pp->cnt;
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(pp->top - pp->wrptr);
+  /*lint -restore*/
+
+  if (n < s1) {
+    __port_memcpy((void *)pp->wrptr, (const void *)bp, n);
+    pp->wrptr += n;
+  }
+  else if (n > s1) {
+    __port_memcpy((void *)pp->wrptr, (const void *)bp, s1);
+    bp += s1;
+    s2 = n - s1;
+    __port_memcpy((void *)pp->buffer, (const void *)bp, s2);
+    pp->wrptr = pp->buffer + s2;
+  }
+  else {  /* n == s1 */
+    __port_memcpy((void *)pp->wrptr, (const void *)bp, n);
+    pp->wrptr = pp->buffer;
+  }
+
+  chSysLock();
+  pp->cnt += n;
+  chSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Non-blocking pipe read.
+ * @details The function reads data from a pipe into a buffer. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or when the pipe buffer has been emptied. The data
+ *          is copied in at most two @p memcpy() segments.
+ * @pre     The pipe access mutex must be owned by the invoking thread.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_read(pipe_t *pp, uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  /* Number of bytes that can be read in a single atomic operation.*/
+  if (n > pp->cnt) {
+    n = pp->cnt;
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(pp->top - pp->rdptr);
+  /*lint -restore*/
+
+  if (n < s1) {
+    __port_memcpy((void *)bp, (const void *)pp->rdptr, n);
+    pp->rdptr += n;
+  }
+  else if (n > s1) {
+    __port_memcpy((void *)bp, (const void *)pp->rdptr, s1);
+    bp += s1;
+    s2 = n - s1;
+    __port_memcpy((void *)bp, (const void *)pp->buffer, s2);
+    pp->rdptr = pp->buffer + s2;
+  }
+  else {  /* n == s1 */
+    __port_memcpy((void *)bp, (const void *)pp->rdptr, n);
+    pp->rdptr = pp->buffer;
+  }
+
+  chSysLock();
+  pp->cnt -= n;
+  chSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Blocking pipe write.
+ * @details The function writes data from a buffer to a pipe. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or after the specified timeout or if the pipe has
+ *          been reset.
+ * @pre     The pipe access mutex must be owned by the invoking thread.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_write_timeout(pipe_t *pp, const uint8_t *bp,
+                                 size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  while (n > 0U) {
+    size_t done;
+
+    /* If the pipe is in reset state then returns immediately.*/
+    if (pp->reset) {
+      break;
+    }
+
+    done = pipe_write(pp, bp, n);
+    if (done == (size_t)0) {
+      msg_t msg;
+
+      chSysLock();
+      msg = chThdEnqueueTimeoutS(&pp->qw, timeout);
+      chSysUnlock();
+
+      /* Anything except MSG_OK interrupts the operation.*/
+      if (msg != MSG_OK) {
+        break;
+      }
+    }
+    else {
+      n  -= done;
+      bp += done;
+
+      /* Resuming the reader, if present, and signaling the data-available
+         condition to the listeners.*/
+      chSysLock();
+      chThdDequeueNextI(&pp->qr, MSG_OK);
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+      chEvtBroadcastI(&pp->esr);
+#endif
+      chSchRescheduleS();
+      chSysUnlock();
+    }
+  }
+
+  return max - n;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
 /**
- * @brief   Initializes a @p mailbox_t object.
+ * @brief   Initializes a @p pipe_t object.
  *
  * @param[out] pp       the pointer to the @p pipe_t structure to be
  *                      initialized
@@ -98,6 +279,15 @@ void chPipeObjectInit(pipe_t *pp, uint8_t *buf, size_t n) {
   pp->reset  = false;
   chThdQueueObjectInit(&pp->qw);
   chThdQueueObjectInit(&pp->qr);
+#if CH_CFG_USE_MUTEXES == TRUE
+  chMtxObjectInit(&pp->mtx);
+#else
+  chSemObjectInit(&pp->sem, (cnt_t)1);
+#endif
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+  chEvtObjectInit(&pp->esr);
+  chEvtObjectInit(&pp->esw);
+#endif
 }
 
 /**
@@ -105,7 +295,7 @@ void chPipeObjectInit(pipe_t *pp, uint8_t *buf, size_t n) {
  * @details All the waiting threads are resumed with status @p MSG_RESET and
  *          the queued data is lost.
  * @post    The pipe is in reset state, all operations will fail and
- *          return @p MSG_RESET until the mailbox is enabled again using
+ *          return @p MSG_RESET until the pipe is enabled again using
  *          @p chPipeResumeX().
  *
  * @param[in] pp        the pointer to an initialized @p pipe_t object
@@ -118,15 +308,20 @@ void chPipeReset(pipe_t *pp) {
 
   P_LOCK(pp);
   chSysLock();
-  pipe_t->wrptr = pipe_t->buffer;
-  pipe_t->rdptr = pipe_t->buffer;
-  pipe_t->cnt   = (size_t)0;
-  pipe_t->reset = true;
-  chThdDequeueAllI(&pipe_t->qw, MSG_RESET);
-  chThdDequeueAllI(&pipe_t->qr, MSG_RESET);
+  pp->wrptr = pp->buffer;
+  pp->rdptr = pp->buffer;
+  pp->cnt   = (size_t)0;
+  pp->reset = true;
+  chThdDequeueAllI(&pp->qw, MSG_RESET);
+  chThdDequeueAllI(&pp->qr, MSG_RESET);
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+  /* Waking up the listeners too so pollers can detect the reset state.*/
+  chEvtBroadcastI(&pp->esr);
+  chEvtBroadcastI(&pp->esw);
+#endif
   chSchRescheduleS();
   chSysUnlock();
-  P_UNLOCK();
+  P_UNLOCK(pp);
 }
 
 /**
@@ -146,14 +341,63 @@ void chPipeReset(pipe_t *pp) {
  *                      - @a TIME_INFINITE no timeout.
  *                      .
  * @return              The number of bytes effectively transferred.
- * @retval MSG_RESET    if the mailbox has been reset.
- * @retval MSG_TIMEOUT  if the operation has timed out.
  *
  * @api
  */
 size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
                           size_t n, sysinterval_t timeout) {
+  size_t done;
 
+  chDbgCheck(n > 0U);
+
+  P_LOCK(pp);
+  done = pipe_write_timeout(pp, bp, n, timeout);
+  P_UNLOCK(pp);
+
+  return done;
+}
+
+/**
+ * @brief   Gathering pipe write with timeout.
+ * @details The function writes data from a vector of buffers to a pipe,
+ *          the segments are committed in order within a single acquisition
+ *          of the pipe access mutex so they cannot be interleaved with
+ *          data from other writers. The operation completes when all the
+ *          segments have been transferred or after the specified timeout
+ *          or if the pipe has been reset.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] iov       pointer to an array of data segments descriptors
+ * @param[in] iovcnt    number of elements in the segments array, the
+ *                      value 0 is reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred.
+ *
+ * @api
+ */
+size_t chPipeWriteVTimeout(pipe_t *pp, const pipe_iovec_t iov[],
+                           size_t iovcnt, sysinterval_t timeout) {
+  size_t i, total = (size_t)0;
+
+  chDbgCheck((iov != NULL) && (iovcnt > 0U));
+
+  P_LOCK(pp);
+  for (i = (size_t)0; i < iovcnt; i++) {
+    size_t done;
+
+    done = pipe_write_timeout(pp, iov[i].base, iov[i].len, timeout);
+    total += done;
+    if (done < iov[i].len) {
+      break;
+    }
+  }
+  P_UNLOCK(pp);
+
+  return total;
 }
 
 /**
@@ -164,7 +408,7 @@ size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
  *          been reset.
  *
  * @param[in] pp        the pointer to an initialized @p pipe_t object
- * @param[out] bp        pointer to the data buffer
+ * @param[out] bp       pointer to the data buffer
  * @param[in] n         the maximum amount of data to be transferred, the
  *                      value 0 is reserved
  * @param[in] timeout   the number of ticks before the operation timeouts,
@@ -173,16 +417,59 @@ size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
  *                      - @a TIME_INFINITE no timeout.
  *                      .
  * @return              The number of bytes effectively transferred.
- * @retval MSG_RESET    if the mailbox has been reset.
- * @retval MSG_TIMEOUT  if the operation has timed out.
  *
  * @api
  */
 size_t chPipeReadTimeout(pipe_t *pp, uint8_t *bp,
                          size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  chDbgCheck(n > 0U);
+
+  P_LOCK(pp);
+
+  while (n > 0U) {
+    size_t done;
+
+    /* If the pipe is in reset state then returns immediately.*/
+    if (pp->reset) {
+      break;
+    }
+
+    done = pipe_read(pp, bp, n);
+    if (done == (size_t)0) {
+      msg_t msg;
+
+      chSysLock();
+      msg = chThdEnqueueTimeoutS(&pp->qr, timeout);
+      chSysUnlock();
+
+      /* Anything except MSG_OK interrupts the operation.*/
+      if (msg != MSG_OK) {
+        break;
+      }
+    }
+    else {
+      n  -= done;
+      bp += done;
+
+      /* Resuming the writer, if present, and signaling the space-available
+         condition to the listeners.*/
+      chSysLock();
+      chThdDequeueNextI(&pp->qw, MSG_OK);
+#if CH_LIB_USE_EVENT_SOURCES == TRUE
+      chEvtBroadcastI(&pp->esw);
+#endif
+      chSchRescheduleS();
+      chSysUnlock();
+    }
+  }
+
+  P_UNLOCK(pp);
 
+  return max - n;
 }
 
-#endif /* CH_CFG_USE_MAILBOXES == TRUE */
+#endif /* CH_CFG_USE_PIPES == TRUE */
 
 /** @} */
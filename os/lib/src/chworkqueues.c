@@ -0,0 +1,257 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chworkqueues.c
+ * @brief   Work Queues code.
+ * @details Jobs are (function, argument) pairs stored in per-lane objects
+ *          FIFOs, a queue-level counting semaphore accounts the jobs over
+ *          all the lanes so a dispatcher can block on the whole queue.
+ *          Dispatcher threads are supplied by the application, one thread
+ *          looping on @p chWQDispatchTimeout() is the common case, more
+ *          threads can serve the same queue concurrently.
+ *          <h2>Operation mode</h2>
+ *          Submission takes a free item from the lane pool, fills it and
+ *          posts it, the I-Class variant never blocks and rejects the job
+ *          when the lane is full. Dispatching consumes one semaphore
+ *          credit per job and always fetches from the lowest-index
+ *          non-empty lane, so lane zero acts as the highest priority
+ *          lane. Batching is performed by consuming additional credits
+ *          with an immediate timeout, only the first job of a batch can
+ *          block.
+ * @pre     In order to use the work queues APIs the @p CH_CFG_USE_WORKQUEUES
+ *          option must be enabled in @p chconf.h.
+ * @note    Compatible with RT and NIL.
+ *
+ * @addtogroup work_queues
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_WORKQUEUES == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p workqueue_t object.
+ * @details The items and messages buffers are partitioned evenly among
+ *          the lanes, each lane can hold up to @p nitems jobs.
+ *
+ * @param[out] wqp      pointer to a @p workqueue_t structure
+ * @param[in] lanes     pointer to an array of @p workqueue_lane_t
+ * @param[in] nlanes    number of lanes, lane zero has the highest priority
+ * @param[in] itemsbuf  pointer to a buffer of <tt>nlanes * nitems</tt>
+ *                      work items
+ * @param[in] msgbuf    pointer to a buffer of <tt>nlanes * nitems</tt>
+ *                      messages
+ * @param[in] nitems    capacity of each lane
+ *
+ * @init
+ */
+void chWQObjectInit(workqueue_t *wqp,
+                    workqueue_lane_t *lanes, size_t nlanes,
+                    work_item_t *itemsbuf, msg_t *msgbuf, size_t nitems) {
+  size_t i;
+
+  chDbgCheck((wqp != NULL) && (lanes != NULL) && (nlanes > (size_t)0) &&
+             (itemsbuf != NULL) && (msgbuf != NULL) && (nitems > (size_t)0));
+
+  wqp->lanes  = lanes;
+  wqp->nlanes = nlanes;
+  chSemObjectInit(&wqp->sem, (cnt_t)0);
+
+  for (i = (size_t)0; i < nlanes; i++) {
+    chFifoObjectInit(&lanes[i].fifo, sizeof (work_item_t), nitems,
+                     PORT_NATURAL_ALIGN,
+                     (void *)&itemsbuf[i * nitems], &msgbuf[i * nitems]);
+    lanes[i].posted   = (ucnt_t)0;
+    lanes[i].rejected = (ucnt_t)0;
+  }
+}
+
+/**
+ * @brief   Submits a job to a work queue.
+ * @details Meant to be called from ISRs, the job is rejected instead of
+ *          waiting when the lane is full.
+ * @note    A reschedule must be performed before exiting the critical
+ *          zone, the submission can make a dispatcher thread ready.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] lane      the lane index
+ * @param[in] fn        function to be executed
+ * @param[in] arg       argument passed to the function
+ * @return              The operation status.
+ * @retval true         if the job has been queued.
+ * @retval false        if the lane is full, the job is accounted in the
+ *                      rejected counter.
+ *
+ * @iclass
+ */
+bool chWQSubmitI(workqueue_t *wqp, size_t lane,
+                 work_function_t fn, void *arg) {
+  work_item_t *wip;
+
+  chDbgCheckClassI();
+  chDbgCheck((wqp != NULL) && (lane < wqp->nlanes) && (fn != NULL));
+
+  wip = (work_item_t *)chFifoTakeObjectI(&wqp->lanes[lane].fifo);
+  if (wip == NULL) {
+    wqp->lanes[lane].rejected++;
+    return false;
+  }
+  wip->fn  = fn;
+  wip->arg = arg;
+  chFifoSendObjectI(&wqp->lanes[lane].fifo, (void *)wip);
+  chSemSignalI(&wqp->sem);
+  wqp->lanes[lane].posted++;
+
+  return true;
+}
+
+/**
+ * @brief   Submits a job to a work queue.
+ * @details If the lane is full then the calling thread waits for a free
+ *          slot until the specified timeout expires.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] lane      the lane index
+ * @param[in] fn        function to be executed
+ * @param[in] arg       argument passed to the function
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval true         if the job has been queued.
+ * @retval false        if the operation timed out, the job is accounted
+ *                      in the rejected counter.
+ *
+ * @api
+ */
+bool chWQSubmitTimeout(workqueue_t *wqp, size_t lane,
+                       work_function_t fn, void *arg,
+                       sysinterval_t timeout) {
+  work_item_t *wip;
+
+  chDbgCheck((wqp != NULL) && (lane < wqp->nlanes) && (fn != NULL));
+
+  wip = (work_item_t *)chFifoTakeObjectTimeout(&wqp->lanes[lane].fifo,
+                                               timeout);
+  if (wip == NULL) {
+    chSysLock();
+    wqp->lanes[lane].rejected++;
+    chSysUnlock();
+    return false;
+  }
+  wip->fn  = fn;
+  wip->arg = arg;
+
+  chSysLock();
+  chFifoSendObjectI(&wqp->lanes[lane].fifo, (void *)wip);
+  chSemSignalI(&wqp->sem);
+  wqp->lanes[lane].posted++;
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return true;
+}
+
+/**
+ * @brief   Dispatches jobs from a work queue.
+ * @details Waits for a job until the specified timeout expires then
+ *          executes, in the caller context, up to @p max jobs without
+ *          further waiting. Jobs are always fetched from the lowest-index
+ *          non-empty lane.
+ *
+ * @param[in] wqp       pointer to a @p workqueue_t structure
+ * @param[in] max       maximum number of jobs to be executed
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of executed jobs.
+ *
+ * @api
+ */
+size_t chWQDispatchTimeout(workqueue_t *wqp, size_t max,
+                           sysinterval_t timeout) {
+  size_t served = (size_t)0;
+
+  chDbgCheck((wqp != NULL) && (max > (size_t)0));
+
+  while (served < max) {
+    work_item_t item;
+    work_item_t *wip;
+    size_t i;
+    msg_t msg;
+
+    /* Only the first job of a batch can wait, the following credits are
+       consumed with an immediate timeout.*/
+    msg = chSemWaitTimeout(&wqp->sem,
+                           (served == (size_t)0) ? timeout : TIME_IMMEDIATE);
+    if (msg != MSG_OK) {
+      break;
+    }
+
+    /* A credit is never signaled before its job is posted so a job is
+       guaranteed to be found.*/
+    chSysLock();
+    wip = NULL;
+    for (i = (size_t)0; i < wqp->nlanes; i++) {
+      if (chFifoReceiveObjectI(&wqp->lanes[i].fifo, (void **)&wip) == MSG_OK) {
+        item = *wip;
+        chFifoReturnObjectI(&wqp->lanes[i].fifo, (void *)wip);
+        break;
+      }
+    }
+    chSysUnlock();
+
+    chDbgAssert(wip != NULL, "credit without job");
+
+    item.fn(item.arg);
+    served++;
+  }
+
+  return served;
+}
+
+#endif /* CH_CFG_USE_WORKQUEUES == TRUE */
+
+/** @} */
@@ -158,6 +158,20 @@
 #define CH_CFG_NUM_THREADS                  2
 #endif
 
+/*-*
+ * @brief   Ready bitmap optimization.
+ * @details If enabled then the scheduler keeps a bitmap of the ready
+ *          threads and picks the highest priority one with a single
+ *          find-first-set operation instead of scanning the threads
+ *          table, making the reschedule cost independent of
+ *          @p CH_CFG_NUM_THREADS.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_OPTIMIZE_SCHED_BITMAP) || defined(__DOXYGEN__)
+#define CH_CFG_OPTIMIZE_SCHED_BITMAP        FALSE
+#endif
+
 /*-*
  * @brief   System time counter resolution.
  * @note    Allowed values are 16 or 32 bits.
@@ -664,6 +678,14 @@ struct nil_system {
    *          or to an higher priority thread if a switch is required.
    */
   thread_t              *next;
+#if (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Bitmap of the ready threads.
+   * @note    The bit position matches the thread position in the
+   *          @p threads array, the idle thread is not represented.
+   */
+  uint32_t              ready;
+#endif
 #if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
   /**
    * @brief   System time.
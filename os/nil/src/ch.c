@@ -48,6 +48,63 @@ nil_system_t nil;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Sets the ready bitmap bit associated to a thread.
+ *
+ * @param[in] tp        pointer to the @p thread_t object
+ *
+ * @notapi
+ */
+static inline void nil_ready_set(thread_t *tp) {
+
+  nil.ready |= (uint32_t)1U << (unsigned)(tp - nil.threads);
+}
+
+/**
+ * @brief   Clears the ready bitmap bit associated to a thread.
+ *
+ * @param[in] tp        pointer to the @p thread_t object
+ *
+ * @notapi
+ */
+static inline void nil_ready_clear(thread_t *tp) {
+
+  nil.ready &= ~((uint32_t)1U << (unsigned)(tp - nil.threads));
+}
+
+/**
+ * @brief   Returns the highest priority ready thread.
+ * @note    The lookup is constant-time, a single find-first-set on the
+ *          ready bitmap.
+ *
+ * @return              The pointer to the highest priority ready thread,
+ *                      the idle thread when the bitmap is empty.
+ *
+ * @notapi
+ */
+static inline thread_t *nil_ready_first(void) {
+  uint32_t mask = nil.ready;
+
+  if (mask == 0U) {
+    return &nil.threads[CH_CFG_NUM_THREADS];
+  }
+#if defined(__GNUC__)
+  return &nil.threads[(unsigned)__builtin_ctz(mask)];
+#else
+  {
+    unsigned n = 0U;
+
+    while ((mask & 1U) == 0U) {
+      mask >>= 1U;
+      n++;
+    }
+    return &nil.threads[n];
+  }
+#endif
+}
+#endif /* CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE */
+
 /*===========================================================================*/
 /* Module interrupt handlers.                                                */
 /*===========================================================================*/
@@ -279,6 +336,11 @@ void chSysInit(void) {
      initializations performed before.*/
   port_init();
 
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  /* All the user threads start in the ready state.*/
+  nil.ready = ((uint32_t)1U << CH_CFG_NUM_THREADS) - 1U;
+#endif
+
   /* Runs the highest priority thread, the current one becomes the idle
      thread.*/
   nil.current = nil.next = nil.threads;
@@ -555,6 +617,9 @@ thread_t *chSchReadyI(thread_t *tp, msg_t msg) {
   tp->u1.msg = msg;
   tp->state = NIL_STATE_READY;
   tp->timeout = (sysinterval_t)0;
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  nil_ready_set(tp);
+#endif
   if (tp < nil.next) {
     nil.next = tp;
   }
@@ -637,6 +702,9 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
 
   /* Storing the wait object for the current thread.*/
   otp->state = newstate;
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  nil_ready_clear(otp);
+#endif
 
 #if CH_CFG_ST_TIMEDELTA > 0
   if (timeout != TIME_INFINITE) {
@@ -674,6 +742,18 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
   otp->timeout = timeout;
 #endif
 
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  /* Picking the highest priority ready thread with a single find-first-set
+     on the ready bitmap, the idle thread is selected when the bitmap is
+     empty.*/
+  ntp = nil_ready_first();
+  nil.current = nil.next = ntp;
+  if (ntp == &nil.threads[CH_CFG_NUM_THREADS]) {
+    CH_CFG_IDLE_ENTER_HOOK();
+  }
+  port_switch(ntp, otp);
+  return nil.current->u1.msg;
+#else
   /* Scanning the whole threads array.*/
   ntp = nil.threads;
   while (true) {
@@ -692,6 +772,7 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
     chDbgAssert(ntp <= &nil.threads[CH_CFG_NUM_THREADS],
                 "pointer out of range");
   }
+#endif
 }
 
 /**
@@ -121,8 +121,11 @@ extern "C" {
 #include "chsem.h"
 #include "chmtx.h"
 #include "chcond.h"
+#include "chrwlock.h"
 #include "chevents.h"
+#include "chdeferred.h"
 #include "chmsg.h"
+#include "chsmp.h"
 
 /* OSLIB.*/
 #include "chlib.h"
@@ -41,6 +41,23 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Wait morphing on broadcast.
+ * @details When enabled @p chCondBroadcast() makes ready only the highest
+ *          priority waiter, the remaining waiters are moved directly on the
+ *          wait queue of the associated mutex so they are released one by
+ *          one as the mutex is passed along instead of all racing for it.
+ * @note    A broadcast should be performed while owning the associated
+ *          mutex, if the mutex is not owned then the classic wake-all
+ *          behavior is used. The priority of the mutex owner is re-evaluated
+ *          when the mutex is released, morphed waiters do not boost it
+ *          before then.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_CONDVARS_MORPHING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_CONDVARS_MORPHING        FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -59,6 +76,11 @@
 typedef struct condition_variable {
   threads_queue_t       queue;              /**< @brief Condition variable
                                                  threads queue.             */
+#if (CH_CFG_USE_CONDVARS_MORPHING == TRUE) || defined(__DOXYGEN__)
+  mutex_t               *mtx;               /**< @brief Mutex associated to
+                                                 the condition variable by
+                                                 the last wait operation.   */
+#endif
 } condition_variable_t;
 
 /*===========================================================================*/
@@ -72,7 +94,11 @@ typedef struct condition_variable {
  *
  * @param[in] name      the name of the condition variable
  */
+#if (CH_CFG_USE_CONDVARS_MORPHING == TRUE) || defined(__DOXYGEN__)
+#define _CONDVAR_DATA(name) {_THREADS_QUEUE_DATA(name.queue), NULL}
+#else
 #define _CONDVAR_DATA(name) {_THREADS_QUEUE_DATA(name.queue)}
+#endif
 
 /**
  * @brief Static condition variable initializer.
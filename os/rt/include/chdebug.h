@@ -32,6 +32,30 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Debug classes
+ * @details Each check or assertion belongs to a class, classes can be
+ *          individually enabled or disabled through the class masks.
+ * @{
+ */
+#define CH_DBG_CLASS_CORE                   0U
+#define CH_DBG_CLASS_VT                     1U
+#define CH_DBG_CLASS_HAL                    2U
+#define CH_DBG_CLASS_APP                    3U
+/** @} */
+
+/**
+ * @name    Debug class masks
+ * @{
+ */
+#define CH_DBG_CLASS_MASK_NONE              0U
+#define CH_DBG_CLASS_MASK_CORE              (1U << CH_DBG_CLASS_CORE)
+#define CH_DBG_CLASS_MASK_VT                (1U << CH_DBG_CLASS_VT)
+#define CH_DBG_CLASS_MASK_HAL               (1U << CH_DBG_CLASS_HAL)
+#define CH_DBG_CLASS_MASK_APP               (1U << CH_DBG_CLASS_APP)
+#define CH_DBG_CLASS_MASK_ALL               15U
+/** @} */
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -46,12 +70,52 @@
 #if !defined(CH_DBG_STACK_FILL_VALUE) || defined(__DOXYGEN__)
 #define CH_DBG_STACK_FILL_VALUE             0x55
 #endif
+
+/**
+ * @brief   Mask of the enabled parameter checks classes.
+ * @details The mask restricts @p CH_DBG_ENABLE_CHECKS to a subset of the
+ *          debug classes, checks belonging to classes not in the mask are
+ *          compiled out. It has no effect while @p CH_DBG_ENABLE_CHECKS
+ *          is @p FALSE.
+ */
+#if !defined(CH_DBG_CHECKS_MASK) || defined(__DOXYGEN__)
+#define CH_DBG_CHECKS_MASK                  CH_DBG_CLASS_MASK_ALL
+#endif
+
+/**
+ * @brief   Mask of the enabled assertions classes.
+ * @details The mask restricts @p CH_DBG_ENABLE_ASSERTS to a subset of the
+ *          debug classes, assertions belonging to classes not in the mask
+ *          are compiled out. It has no effect while
+ *          @p CH_DBG_ENABLE_ASSERTS is @p FALSE.
+ */
+#if !defined(CH_DBG_ASSERTS_MASK) || defined(__DOXYGEN__)
+#define CH_DBG_ASSERTS_MASK                 CH_DBG_CLASS_MASK_ALL
+#endif
+
+/**
+ * @brief   Debug class of the current translation unit.
+ * @details Translation units can redefine this setting before inclusion
+ *          of any system header in order to tag their own checks and
+ *          assertions, application code would use @p CH_DBG_CLASS_APP.
+ */
+#if !defined(CH_DBG_CURRENT_CLASS) || defined(__DOXYGEN__)
+#define CH_DBG_CURRENT_CLASS                CH_DBG_CLASS_CORE
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_DBG_CHECKS_MASK & ~CH_DBG_CLASS_MASK_ALL) != 0U
+#error "invalid CH_DBG_CHECKS_MASK value"
+#endif
+
+#if (CH_DBG_ASSERTS_MASK & ~CH_DBG_CLASS_MASK_ALL) != 0U
+#error "invalid CH_DBG_ASSERTS_MASK value"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -88,51 +152,93 @@
  * @{
  */
 /**
- * @brief   Function parameters check.
+ * @brief   Function parameters check with an explicit debug class.
  * @details If the condition check fails then the kernel panics and halts.
- * @note    The condition is tested only if the @p CH_DBG_ENABLE_CHECKS switch
- *          is specified in @p chconf.h else the macro does nothing.
+ * @note    The condition is tested only if the @p CH_DBG_ENABLE_CHECKS
+ *          switch is specified in @p chconf.h and the class is enabled in
+ *          @p CH_DBG_CHECKS_MASK, else the macro does nothing.
  *
+ * @param[in] class     the debug class of the check
  * @param[in] c         the condition to be verified to be true
  *
  * @api
  */
-#if !defined(chDbgCheck)
-#define chDbgCheck(c) do {                                                  \
+#if !defined(chDbgCheckClassed)
+#define chDbgCheckClassed(class, c) do {                                    \
   /*lint -save -e506 -e774 [2.1, 14.3] Can be a constant by design.*/       \
-  if (CH_DBG_ENABLE_CHECKS != FALSE) {                                      \
+  if ((CH_DBG_ENABLE_CHECKS != FALSE) &&                                    \
+      ((CH_DBG_CHECKS_MASK & (1U << (class))) != 0U)) {                     \
     if (!(c)) {                                                             \
   /*lint -restore*/                                                         \
       chSysHalt(__func__);                                                  \
     }                                                                       \
   }                                                                         \
 } while (false)
+#endif /* !defined(chDbgCheckClassed) */
+
+/**
+ * @brief   Function parameters check.
+ * @details If the condition check fails then the kernel panics and halts.
+ * @note    The condition is tested only if the @p CH_DBG_ENABLE_CHECKS switch
+ *          is specified in @p chconf.h else the macro does nothing.
+ * @note    The check belongs to the debug class of the current translation
+ *          unit, see @p CH_DBG_CURRENT_CLASS.
+ *
+ * @param[in] c         the condition to be verified to be true
+ *
+ * @api
+ */
+#if !defined(chDbgCheck)
+#define chDbgCheck(c) chDbgCheckClassed(CH_DBG_CURRENT_CLASS, c)
 #endif /* !defined(chDbgCheck) */
 
 /**
- * @brief   Condition assertion.
+ * @brief   Condition assertion with an explicit debug class.
  * @details If the condition check fails then the kernel panics with a
  *          message and halts.
- * @note    The condition is tested only if the @p CH_DBG_ENABLE_ASSERTS switch
- *          is specified in @p chconf.h else the macro does nothing.
+ * @note    The condition is tested only if the @p CH_DBG_ENABLE_ASSERTS
+ *          switch is specified in @p chconf.h and the class is enabled in
+ *          @p CH_DBG_ASSERTS_MASK, else the macro does nothing.
  * @note    The remark string is not currently used except for putting a
  *          comment in the code about the assertion.
  *
+ * @param[in] class     the debug class of the assertion
  * @param[in] c         the condition to be verified to be true
  * @param[in] r         a remark string
  *
  * @api
  */
-#if !defined(chDbgAssert)
-#define chDbgAssert(c, r) do {                                              \
+#if !defined(chDbgAssertClassed)
+#define chDbgAssertClassed(class, c, r) do {                                \
   /*lint -save -e506 -e774 [2.1, 14.3] Can be a constant by design.*/       \
-  if (CH_DBG_ENABLE_ASSERTS != FALSE) {                                     \
+  if ((CH_DBG_ENABLE_ASSERTS != FALSE) &&                                   \
+      ((CH_DBG_ASSERTS_MASK & (1U << (class))) != 0U)) {                    \
     if (!(c)) {                                                             \
   /*lint -restore*/                                                         \
       chSysHalt(__func__);                                                  \
     }                                                                       \
   }                                                                         \
 } while (false)
+#endif /* !defined(chDbgAssertClassed) */
+
+/**
+ * @brief   Condition assertion.
+ * @details If the condition check fails then the kernel panics with a
+ *          message and halts.
+ * @note    The condition is tested only if the @p CH_DBG_ENABLE_ASSERTS switch
+ *          is specified in @p chconf.h else the macro does nothing.
+ * @note    The remark string is not currently used except for putting a
+ *          comment in the code about the assertion.
+ * @note    The assertion belongs to the debug class of the current
+ *          translation unit, see @p CH_DBG_CURRENT_CLASS.
+ *
+ * @param[in] c         the condition to be verified to be true
+ * @param[in] r         a remark string
+ *
+ * @api
+ */
+#if !defined(chDbgAssert)
+#define chDbgAssert(c, r) chDbgAssertClassed(CH_DBG_CURRENT_CLASS, c, r)
 #endif /* !defined(chDbgAssert) */
 /** @} */
 
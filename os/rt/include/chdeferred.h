@@ -0,0 +1,176 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chdeferred.h
+ * @brief   Deferred interrupt handlers macros and structures.
+ *
+ * @addtogroup deferred
+ * @{
+ */
+
+#ifndef CHDEFERRED_H
+#define CHDEFERRED_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Deferred handlers APIs.
+ * @details If enabled then the deferred interrupt handlers APIs are
+ *          included in the kernel.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_DEFERRED) || defined(__DOXYGEN__)
+#define CH_CFG_USE_DEFERRED                 FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_DEFERRED == TRUE) && (CH_CFG_USE_EVENTS == FALSE)
+#error "CH_CFG_USE_DEFERRED requires CH_CFG_USE_EVENTS"
+#endif
+
+#if (CH_CFG_USE_DEFERRED == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a deferred handler function.
+ *
+ * @param[in] arg       argument associated to the work token
+ */
+typedef void (*deferred_handler_t)(void *arg);
+
+/**
+ * @brief   Type of a work token.
+ * @details Work tokens are queued from the interrupt top half and consumed
+ *          by the worker thread which invokes the handler.
+ */
+typedef struct {
+  deferred_handler_t    handler;    /**< @brief Bottom half function.       */
+  void                  *arg;       /**< @brief Handler argument.           */
+} deferred_work_t;
+
+/**
+ * @brief   Type of a deferred worker structure.
+ */
+typedef struct ch_deferred_worker deferred_worker_t;
+
+/**
+ * @brief   Deferred worker structure.
+ */
+struct ch_deferred_worker {
+  thread_t              *thread;    /**< @brief Worker @p thread_t pointer
+                                                or @p NULL.                 */
+  const char            *name;      /**< @brief Worker thread name.         */
+  deferred_work_t       *buffer;    /**< @brief Pointer to the tokens
+                                                buffer.                     */
+  deferred_work_t       *top;       /**< @brief Pointer to the location
+                                                after the buffer.           */
+  deferred_work_t       *wrptr;     /**< @brief Write pointer.              */
+  deferred_work_t       *rdptr;     /**< @brief Read pointer.               */
+  volatile cnt_t        cnt;        /**< @brief Number of queued tokens.    */
+  volatile cnt_t        dropped;    /**< @brief Number of tokens rejected
+                                                on queue full.              */
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Data part of a static deferred worker initializer.
+ * @details This macro should be used when statically initializing a worker
+ *          that is part of a bigger structure.
+ *
+ * @param[in] name      the name of the worker variable
+ * @param[in] buffer    pointer to the tokens buffer
+ * @param[in] size      number of @p deferred_work_t elements in the buffer
+ */
+#define _DEFERRED_WORKER_DATA(name, buffer, size) {                         \
+  NULL, NULL, (buffer), (buffer) + (size), (buffer), (buffer), 0, 0         \
+}
+
+/**
+ * @brief   Static deferred worker initializer.
+ * @details Statically initialized workers require no explicit
+ *          initialization using @p chDeferredObjectInit().
+ *
+ * @param[in] name      the name of the worker variable
+ * @param[in] buffer    pointer to the tokens buffer
+ * @param[in] size      number of @p deferred_work_t elements in the buffer
+ */
+#define DEFERRED_WORKER_DECL(name, buffer, size)                            \
+  deferred_worker_t name = _DEFERRED_WORKER_DATA(name, buffer, size)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chDeferredObjectInit(deferred_worker_t *dwp,
+                            deferred_work_t *buffer, size_t n);
+  void chDeferredStart(deferred_worker_t *dwp, const char *name,
+                       tprio_t prio, void *wsp, size_t size);
+  bool chDeferredPostI(deferred_worker_t *dwp,
+                       deferred_handler_t handler, void *arg);
+  bool chDeferredPost(deferred_worker_t *dwp,
+                      deferred_handler_t handler, void *arg);
+#if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
+  void chDeferredStop(deferred_worker_t *dwp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of tokens rejected because the queue was
+ *          full.
+ *
+ * @param[in] dwp       pointer to a @p deferred_worker_t structure
+ * @return              The number of rejected tokens.
+ *
+ * @xclass
+ */
+static inline cnt_t chDeferredGetDroppedX(deferred_worker_t *dwp) {
+
+  return dwp->dropped;
+}
+
+#endif /* CH_CFG_USE_DEFERRED == TRUE */
+
+#endif /* CHDEFERRED_H */
+
+/** @} */
@@ -38,10 +38,41 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Working areas recycling cache.
+ * @details If enabled then the working areas of terminated heap threads
+ *          are parked in a small cache keyed by size class and reused by
+ *          the next @p chThdCreateFromHeap() of a compatible size, so
+ *          steady-state thread churn performs no heap operations and
+ *          does not grow fragmentation.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_WA_CACHE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_WA_CACHE                 FALSE
+#endif
+
+/**
+ * @brief   Number of size classes in the working areas cache.
+ */
+#if !defined(CH_CFG_WA_CACHE_CLASSES) || defined(__DOXYGEN__)
+#define CH_CFG_WA_CACHE_CLASSES             4
+#endif
+
+/**
+ * @brief   Maximum number of parked working areas per size class.
+ */
+#if !defined(CH_CFG_WA_CACHE_DEPTH) || defined(__DOXYGEN__)
+#define CH_CFG_WA_CACHE_DEPTH               4
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_WA_CACHE == TRUE) && (CH_CFG_USE_HEAP == FALSE)
+#error "CH_CFG_USE_WA_CACHE requires CH_CFG_USE_HEAP"
+#endif
+
 /*
  * Module dependencies check.
  */
@@ -75,6 +106,10 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#if CH_CFG_USE_WA_CACHE == TRUE
+  void _dyn_wa_free(void *wa);
+  void chThdWACacheTrim(void);
+#endif
 #if CH_CFG_USE_HEAP == TRUE
   thread_t *chThdCreateFromHeap(memory_heap_t *heapp, size_t size,
                                 const char *name, tprio_t prio,
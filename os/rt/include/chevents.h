@@ -41,6 +41,30 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Priority-ordered event delivery.
+ * @details When enabled the listeners lists are kept ordered by listener
+ *          thread priority, broadcasts signal the highest priority
+ *          listeners first.
+ * @note    The ordering is established at registration time, subsequent
+ *          priority changes of the registered threads are not tracked.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_EVENTS_PRIORITY) || defined(__DOXYGEN__)
+#define CH_CFG_USE_EVENTS_PRIORITY          FALSE
+#endif
+
+/**
+ * @brief   Events coalescing statistics.
+ * @details When enabled each listener counts the deliveries that found the
+ *          associated events mask already pending in the listening thread,
+ *          a growing counter reveals a consumer falling behind its source.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_EVENTS_COALESCING) || defined(__DOXYGEN__)
+#define CH_DBG_EVENTS_COALESCING            FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -66,6 +90,11 @@ struct event_listener {
                                                     by the event source.    */
   eventflags_t          wflags;         /**< @brief Flags that this listener
                                                     interested in.          */
+#if (CH_DBG_EVENTS_COALESCING == TRUE) || defined(__DOXYGEN__)
+  ucnt_t                coalesced;      /**< @brief Number of deliveries that
+                                                    found the events mask
+                                                    already pending.        */
+#endif
 };
 
 /**
@@ -284,6 +313,25 @@ static inline eventmask_t chEvtGetEventsX(void) {
   return currp->epending;
 }
 
+#if (CH_DBG_EVENTS_COALESCING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of coalesced deliveries of a listener.
+ * @details Coalesced deliveries are those that found the associated events
+ *          mask already pending in the listening thread.
+ * @pre     In order to use this function the option
+ *          @p CH_DBG_EVENTS_COALESCING must be enabled.
+ *
+ * @param[in] elp       pointer to the @p event_listener_t structure
+ * @return              The number of coalesced deliveries.
+ *
+ * @xclass
+ */
+static inline ucnt_t chEvtGetCoalescedX(event_listener_t *elp) {
+
+  return elp->coalesced;
+}
+#endif
+
 #endif /* CH_CFG_USE_EVENTS == TRUE */
 
 #endif /* CHEVENTS_H */
@@ -38,14 +38,53 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Priority inheritance on messages.
+ * @details If enabled then a server thread inherits the priority of the
+ *          highest priority client queued on it, the boost is propagated
+ *          through the mutexes machinery and removed when the client is
+ *          released, bounding the client waiting time.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_MESSAGES_INHERITANCE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MESSAGES_INHERITANCE     FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MESSAGES_INHERITANCE == TRUE) &&                            \
+    (CH_CFG_USE_MUTEXES == FALSE)
+#error "CH_CFG_USE_MESSAGES_INHERITANCE requires CH_CFG_USE_MUTEXES"
+#endif
+
+#if (CH_CFG_USE_MESSAGES_INHERITANCE == TRUE) &&                            \
+    (CH_CFG_USE_MESSAGES_PRIORITY == FALSE)
+#error "CH_CFG_USE_MESSAGES_INHERITANCE requires CH_CFG_USE_MESSAGES_PRIORITY"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Type of a message buffer descriptor.
+ * @details Describes a data buffer handed to the receiver for the duration
+ *          of the rendezvous, the descriptor itself lives on the sender
+ *          stack which is frozen until @p chMsgRelease() is invoked.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the buffer.
+   */
+  void              *buf;
+  /**
+   * @brief   Buffer size in bytes.
+   */
+  size_t            size;
+} msg_buffer_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -58,8 +97,12 @@
 extern "C" {
 #endif
   msg_t chMsgSend(thread_t *tp, msg_t msg);
+  msg_t chMsgSendWithBuffer(thread_t *tp, void *bufp, size_t size);
   thread_t * chMsgWait(void);
   void chMsgRelease(thread_t *tp, msg_t msg);
+#if CH_CFG_USE_MESSAGES_INHERITANCE == TRUE
+  void chMsgReleaseS(thread_t *tp, msg_t msg);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -100,10 +143,37 @@ static inline msg_t chMsgGet(thread_t *tp) {
   return tp->u.sentmsg;
 }
 
+/**
+ * @brief   Returns the buffer view carried by the specified thread.
+ * @details The returned pointer gives direct access to the sender buffer,
+ *          no copy is performed. The view is valid until @p chMsgRelease()
+ *          is invoked because the sending thread is suspended until then.
+ * @pre     The sender must have used @p chMsgSendWithBuffer(), this function
+ *          must be invoked immediately after exiting a call to
+ *          @p chMsgWait().
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[out] sizep    pointer to a variable receiving the buffer size
+ * @return              The pointer to the sender buffer.
+ *
+ * @api
+ */
+static inline void *chMsgGetBuffer(thread_t *tp, size_t *sizep) {
+  const msg_buffer_t *mbp = (const msg_buffer_t *)chMsgGet(tp);
+
+  *sizep = mbp->size;
+
+  return mbp->buf;
+}
+
+#if (CH_CFG_USE_MESSAGES_INHERITANCE == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Releases the thread waiting on top of the messages queue.
  * @pre     Invoke this function only after a message has been received
  *          using @p chMsgWait().
+ * @note    With @p CH_CFG_USE_MESSAGES_INHERITANCE enabled this function
+ *          is not inlined because it also recomputes the inherited
+ *          priority of the releasing thread.
  *
  * @param[in] tp        pointer to the thread
  * @param[in] msg       message to be returned to the sender
@@ -116,6 +186,7 @@ static inline void chMsgReleaseS(thread_t *tp, msg_t msg) {
 
   chSchWakeupS(tp, msg);
 }
+#endif /* CH_CFG_USE_MESSAGES_INHERITANCE == FALSE */
 
 #endif /* CH_CFG_USE_MESSAGES == TRUE */
 
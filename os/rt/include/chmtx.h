@@ -38,10 +38,39 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Adaptive spinning on contended mutexes.
+ * @details When enabled @p chMtxLock() performs a bounded number of polling
+ *          attempts before suspending the calling thread, short critical
+ *          sections can be acquired without paying two context switches.
+ * @note    Only the thread-level @p chMtxLock() API spins, the S-class
+ *          functions are unaffected because the critical zone cannot be
+ *          abandoned there. The blocking path and the priority inheritance
+ *          machinery are unchanged.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_MTX_ADAPTIVE_SPIN) || defined(__DOXYGEN__)
+#define CH_CFG_MTX_ADAPTIVE_SPIN            FALSE
+#endif
+
+/**
+ * @brief   Number of polling attempts before suspending.
+ * @note    Each attempt enters and leaves the kernel critical zone, the
+ *          value should be tuned against the context switch round trip
+ *          time of the target.
+ */
+#if !defined(CH_CFG_MTX_SPIN_COUNT) || defined(__DOXYGEN__)
+#define CH_CFG_MTX_SPIN_COUNT               32
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_MTX_ADAPTIVE_SPIN == TRUE) && (CH_CFG_MTX_SPIN_COUNT <= 0)
+#error "invalid CH_CFG_MTX_SPIN_COUNT specified"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -100,6 +129,7 @@ struct ch_mutex {
 extern "C" {
 #endif
   void chMtxObjectInit(mutex_t *mp);
+  void chMtxPropagatePriorityS(thread_t *tp, tprio_t newprio);
   void chMtxLock(mutex_t *mp);
   void chMtxLockS(mutex_t *mp);
   bool chMtxTryLock(mutex_t *mp);
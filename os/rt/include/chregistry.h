@@ -34,6 +34,12 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Invalid thread identifier.
+ * @details Returned value when no more identifiers are available.
+ */
+#define CH_THREAD_ID_INVALID        ((uint16_t)-1)
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -70,6 +76,33 @@ typedef struct {
   uint8_t   off_time;               /**< @brief Offset of @p time field.    */
 } chdebug_t;
 
+/**
+ * @brief   Type of a thread state snapshot.
+ * @details Elements of the array filled by @p chRegSnapshotThreads(), the
+ *          fields are copies taken in a single critical zone so they are
+ *          mutually consistent.
+ */
+typedef struct {
+  /**
+   * @brief   Thread name or @p NULL.
+   */
+  const char            *name;
+  /**
+   * @brief   Thread priority.
+   */
+  tprio_t               prio;
+  /**
+   * @brief   Thread state.
+   */
+  tstate_t              state;
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Realtime counter cycles consumed by the thread.
+   */
+  rtcnt_t               cycles;
+#endif
+} thread_snapshot_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -80,10 +113,18 @@ typedef struct {
  *
  * @param[in] tp        thread to remove from the registry
  */
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
 #define REG_REMOVE(tp) {                                                    \
+  _reg_release_id(tp);                                                      \
   (tp)->older->newer = (tp)->newer;                                         \
   (tp)->newer->older = (tp)->older;                                         \
 }
+#else
+#define REG_REMOVE(tp) {                                                    \
+  (tp)->older->newer = (tp)->newer;                                         \
+  (tp)->newer->older = (tp)->older;                                         \
+}
+#endif
 
 /**
  * @brief   Adds a thread to the registry list.
@@ -91,12 +132,22 @@ typedef struct {
  *
  * @param[in] tp        thread to add to the registry
  */
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
 #define REG_INSERT(tp) {                                                    \
+  _reg_assign_id(tp);                                                       \
   (tp)->newer = (thread_t *)&ch.rlist;                                      \
   (tp)->older = ch.rlist.older;                                           \
   (tp)->older->newer = (tp);                                                \
   ch.rlist.older = (tp);                                                  \
 }
+#else
+#define REG_INSERT(tp) {                                                    \
+  (tp)->newer = (thread_t *)&ch.rlist;                                      \
+  (tp)->older = ch.rlist.older;                                           \
+  (tp)->older->newer = (tp);                                                \
+  ch.rlist.older = (tp);                                                  \
+}
+#endif
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -109,8 +160,17 @@ extern "C" {
   thread_t *chRegFirstThread(void);
   thread_t *chRegNextThread(thread_t *tp);
   thread_t *chRegFindThreadByName(const char *name);
+#if CH_CFG_USE_REGISTRY_IDS == TRUE
+  void _reg_assign_id(thread_t *tp);
+  void _reg_release_id(thread_t *tp);
+  uint32_t chRegHashName(const char *name);
+  thread_t *chRegFindThreadByID(uint16_t id);
+  thread_t *chRegFindThreadByHash(uint32_t hash);
+#endif
   thread_t *chRegFindThreadByPointer(thread_t *tp);
   thread_t *chRegFindThreadByWorkingArea(stkalign_t *wa);
+  size_t chRegSnapshotThreadsI(thread_snapshot_t *tsp, size_t n);
+  size_t chRegSnapshotThreads(thread_snapshot_t *tsp, size_t n);
 #ifdef __cplusplus
 }
 #endif
@@ -134,11 +194,31 @@ static inline void chRegSetThreadName(const char *name) {
 
 #if CH_CFG_USE_REGISTRY == TRUE
   ch.rlist.current->name = name;
+#if CH_CFG_USE_REGISTRY_IDS == TRUE
+  ch.rlist.current->namehash = chRegHashName(name);
+#endif
 #else
   (void)name;
 #endif
 }
 
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the stable identifier of a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The thread identifier.
+ * @retval CH_THREAD_ID_INVALID if no identifier could be assigned at
+ *                      creation.
+ *
+ * @xclass
+ */
+static inline uint16_t chRegGetThreadIDX(const thread_t *tp) {
+
+  return tp->id;
+}
+#endif /* CH_CFG_USE_REGISTRY_IDS == TRUE */
+
 /**
  * @brief   Returns the name of the specified thread.
  * @pre     This function only returns the pointer to the name if the option
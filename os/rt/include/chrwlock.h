@@ -0,0 +1,165 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chrwlock.h
+ * @brief   Readers-writer lock macros and structures.
+ *
+ * @addtogroup rwlocks
+ * @{
+ */
+
+#ifndef CHRWLOCK_H
+#define CHRWLOCK_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Readers-writer locks APIs.
+ * @details If enabled then the readers-writer locks APIs are included in
+ *          the kernel.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_RWLOCKS                  FALSE
+#endif
+
+/**
+ * @brief   Number of reader threads tracked for priority inheritance.
+ * @details Blocked writers boost the priority of at most this number of
+ *          concurrent readers, readers in excess of the tracking capacity
+ *          hold the lock normally but do not receive the boost.
+ */
+#if !defined(CH_CFG_RWLOCK_TRACKED_READERS) || defined(__DOXYGEN__)
+#define CH_CFG_RWLOCK_TRACKED_READERS       4
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) && (CH_CFG_USE_MUTEXES == FALSE)
+#error "CH_CFG_USE_RWLOCKS requires CH_CFG_USE_MUTEXES"
+#endif
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) && (CH_CFG_RWLOCK_TRACKED_READERS <= 0)
+#error "invalid CH_CFG_RWLOCK_TRACKED_READERS specified"
+#endif
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a readers-writer lock structure.
+ */
+typedef struct ch_rwlock rwlock_t;
+
+/**
+ * @brief   Readers-writer lock structure.
+ */
+struct ch_rwlock {
+  cnt_t                 cnt;        /**< @brief Lock state, zero if free,
+                                                positive is the number of
+                                                active readers, negative if
+                                                owned by a writer.          */
+  thread_t              *writer;    /**< @brief Owner writer @p thread_t
+                                                pointer or @p NULL.         */
+  threads_queue_t       rqueue;     /**< @brief Queue of the threads waiting
+                                                for reading.                */
+  threads_queue_t       wqueue;     /**< @brief Queue of the threads waiting
+                                                for writing.                */
+  thread_t              *readers[CH_CFG_RWLOCK_TRACKED_READERS];
+                                    /**< @brief Active readers tracked for
+                                                priority inheritance.       */
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Data part of a static readers-writer lock initializer.
+ * @details This macro should be used when statically initializing a lock
+ *          that is part of a bigger structure.
+ *
+ * @param[in] name      the name of the lock variable
+ */
+#define _RWLOCK_DATA(name) {0, NULL, _THREADS_QUEUE_DATA(name.rqueue),      \
+                            _THREADS_QUEUE_DATA(name.wqueue), {NULL}}
+
+/**
+ * @brief   Static readers-writer lock initializer.
+ * @details Statically initialized locks require no explicit initialization
+ *          using @p chRWObjectInit().
+ *
+ * @param[in] name      the name of the lock variable
+ */
+#define RWLOCK_DECL(name) rwlock_t name = _RWLOCK_DATA(name)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chRWObjectInit(rwlock_t *rwp);
+  void chRWReadLock(rwlock_t *rwp);
+  void chRWReadLockS(rwlock_t *rwp);
+  void chRWReadUnlock(rwlock_t *rwp);
+  void chRWReadUnlockS(rwlock_t *rwp);
+  void chRWWriteLock(rwlock_t *rwp);
+  void chRWWriteLockS(rwlock_t *rwp);
+  void chRWWriteUnlock(rwlock_t *rwp);
+  void chRWWriteUnlockS(rwlock_t *rwp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns @p true if the lock is currently taken by a writer.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ * @return              The lock write-ownership status.
+ *
+ * @xclass
+ */
+static inline bool chRWIsWriteLockedX(rwlock_t *rwp) {
+
+  return (bool)(rwp->cnt < (cnt_t)0);
+}
+
+#endif /* CH_CFG_USE_RWLOCKS == TRUE */
+
+#endif /* CHRWLOCK_H */
+
+/** @} */
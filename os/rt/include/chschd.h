@@ -110,10 +110,186 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Constant-time ready list.
+ * @details If enabled then the ready list is implemented as an array of
+ *          FIFO queues, one for each priority level, plus a bitmap of the
+ *          non-empty levels. Insertion in the ready list and extraction of
+ *          the highest priority thread become constant-time operations
+ *          regardless of the number of ready threads.
+ * @note    This option trades RAM for a deterministic scheduler, the ready
+ *          list grows by one queue header for each priority level plus the
+ *          priority bitmap.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_OPTIMIZE_SCHED_BITMAP) || defined(__DOXYGEN__)
+#define CH_CFG_OPTIMIZE_SCHED_BITMAP        FALSE
+#endif
+
+/**
+ * @brief   Deferred ready list.
+ * @details If enabled then interrupt handlers can post thread wakeups into
+ *          a lock-free multiple-producer single-consumer list using
+ *          @p chSchDeferReadyX() without entering the kernel critical zone.
+ *          The list is drained by the scheduler on the reschedule paths.
+ * @note    This option requires a compiler providing the GCC atomic
+ *          builtins.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_DEFERRED_READY) || defined(__DOXYGEN__)
+#define CH_CFG_USE_DEFERRED_READY           FALSE
+#endif
+
+/**
+ * @brief   Per-thread CPU cycles accounting.
+ * @details If enabled then the realtime counter is sampled at each context
+ *          switch and the consumed cycles are accumulated in the switched
+ *          out thread. This is much cheaper than the full statistics
+ *          module and is meant to stay enabled in production builds.
+ * @note    This option requires @p PORT_SUPPORTS_RT.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_THREAD_CYCLES) || defined(__DOXYGEN__)
+#define CH_CFG_USE_THREAD_CYCLES            FALSE
+#endif
+
+/**
+ * @brief   Idle cycles ledger.
+ * @details If enabled then the realtime counter is sampled when the
+ *          scheduler enters and leaves the idle priority level and the
+ *          delta is accumulated in a 64 bits ledger, measuring the true
+ *          sleep residency including the time spent in the wait
+ *          instruction. Unlike the per-thread accounting it works also
+ *          when @p CH_CFG_NO_IDLE_THREAD is enabled.
+ * @note    This option requires @p PORT_SUPPORTS_RT.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_IDLE_CYCLES) || defined(__DOXYGEN__)
+#define CH_CFG_USE_IDLE_CYCLES              FALSE
+#endif
+
+/**
+ * @brief   Registry thread identifiers.
+ * @details If enabled then every thread is assigned at creation a small
+ *          stable integer identifier and the hash of its name is cached
+ *          in the thread structure, threads become addressable in O(1)
+ *          by identifier and by a single-pass hash comparison by name.
+ *          Identifiers are reused after thread destruction, with a
+ *          deterministic creation order they are stable across reboots.
+ * @note    This option requires @p CH_CFG_USE_REGISTRY.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_REGISTRY_IDS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_REGISTRY_IDS             FALSE
+#endif
+
+/**
+ * @brief   Maximum number of registry thread identifiers.
+ */
+#if !defined(CH_CFG_REGISTRY_IDS_MAX) || defined(__DOXYGEN__)
+#define CH_CFG_REGISTRY_IDS_MAX             32
+#endif
+
+/**
+ * @brief   Timer-wheel virtual timers.
+ * @details If enabled then the virtual timers are kept in a hashed timer
+ *          wheel instead of a single delta list. Arming and disarming a
+ *          timer only touches the timers hashed to the same wheel slot,
+ *          making the operations cost independent from the total number
+ *          of active timers.
+ * @note    This mode requires @p CH_CFG_INTERVALS_SIZE to not exceed
+ *          @p CH_CFG_ST_RESOLUTION.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_OPTIMIZE_VT_WHEEL) || defined(__DOXYGEN__)
+#define CH_CFG_OPTIMIZE_VT_WHEEL            FALSE
+#endif
+
+/**
+ * @brief   Number of slots in the virtual timers wheel.
+ * @note    This value must be a power of two.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_VT_WHEEL_SIZE                64
+#endif
+
+/**
+ * @brief   Earliest Deadline First scheduling band.
+ * @details If enabled then threads can enter a deadline-driven scheduling
+ *          band placed above the whole fixed priorities range by declaring
+ *          an absolute deadline with @p chThdSetDeadline(). Threads in the
+ *          band are ordered by earliest absolute deadline, fixed priority
+ *          threads run only when the band is empty.
+ * @note    Deadlines are expressed on the system time base, the same used
+ *          by the virtual timers.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_EDF                      FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of priority levels handled by the bitmap ready list.
+ */
+#define CH_SCH_PRIO_LEVELS      ((unsigned)HIGHPRIO + 1U)
+
+/**
+ * @brief   Number of words in the ready list priority bitmap.
+ */
+#define CH_SCH_PRIO_BMAP_WORDS  ((CH_SCH_PRIO_LEVELS + 31U) / 32U)
+#endif
+
+#if (CH_CFG_USE_DEFERRED_READY == TRUE) && !defined(__GNUC__) &&            \
+    !defined(__DOXYGEN__)
+#error "CH_CFG_USE_DEFERRED_READY requires the GCC atomic builtins"
+#endif
+
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Priority level of the EDF scheduling band.
+ * @details Threads with a declared deadline are placed at this priority
+ *          level, above the whole fixed priorities range, and ordered among
+ *          themselves by earliest absolute deadline.
+ */
+#define EDFPRIO                 ((tprio_t)HIGHPRIO + (tprio_t)1)
+#endif
+
+#if (CH_CFG_USE_EDF == TRUE) && (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE)
+#error "CH_CFG_USE_EDF requires the priority ordered ready list"
+#endif
+
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) && (PORT_SUPPORTS_RT == FALSE)
+#error "CH_CFG_USE_THREAD_CYCLES requires PORT_SUPPORTS_RT"
+#endif
+
+#if (CH_CFG_USE_IDLE_CYCLES == TRUE) && (PORT_SUPPORTS_RT == FALSE)
+#error "CH_CFG_USE_IDLE_CYCLES requires PORT_SUPPORTS_RT"
+#endif
+
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) && (CH_CFG_USE_REGISTRY == FALSE)
+#error "CH_CFG_USE_REGISTRY_IDS requires CH_CFG_USE_REGISTRY"
+#endif
+
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+#if (CH_CFG_VT_WHEEL_SIZE & (CH_CFG_VT_WHEEL_SIZE - 1)) != 0
+#error "CH_CFG_VT_WHEEL_SIZE must be a power of two"
+#endif
+
+#if CH_CFG_INTERVALS_SIZE > CH_CFG_ST_RESOLUTION
+#error "CH_CFG_OPTIMIZE_VT_WHEEL requires CH_CFG_INTERVALS_SIZE <= CH_CFG_ST_RESOLUTION"
+#endif
+
+/**
+ * @brief   Mask used to map a deadline on a wheel slot.
+ */
+#define CH_VT_WHEEL_MASK        ((systime_t)(CH_CFG_VT_WHEEL_SIZE - 1))
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -154,6 +330,16 @@ struct ch_thread {
    */
   const char            *name;
 #endif
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Stable thread identifier.
+   */
+  uint16_t              id;
+  /**
+   * @brief   Hash of the thread name.
+   */
+  uint32_t              namehash;
+#endif
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE) ||  \
     defined(__DOXYGEN__)
   /**
@@ -162,6 +348,14 @@ struct ch_thread {
    *          dynamic threading.
    */
   stkalign_t            *wabase;
+#endif
+#if (CH_DBG_FILL_THREADS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Stack usage watermark.
+   * @note    It is the lowest stack address known to have been used,
+   *          lazily updated by @p chThdGetFreeStackX().
+   */
+  uint8_t               *wlow;
 #endif
   /**
    * @brief   Current thread state.
@@ -189,6 +383,22 @@ struct ch_thread {
    * @note    This field can overflow.
    */
   volatile systime_t    time;
+#endif
+#if ((CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                   \
+     (CH_DBG_TRACE_COMPACT == TRUE)) || defined(__DOXYGEN__)
+  /**
+   * @brief   Compact thread identifier used in the trace records.
+   */
+  uint8_t               traceid;
+#endif
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Realtime counter cycles consumed by the thread.
+   * @note    This field can overflow. It is updated when the thread is
+   *          switched out, the cycles of the current activation are not
+   *          included.
+   */
+  volatile rtcnt_t      cycles;
 #endif
   /**
    * @brief   State-specific fields.
@@ -257,6 +467,16 @@ struct ch_thread {
     eventmask_t         ewmask;
 #endif
   }                     u;
+#if (CH_CFG_USE_DEFERRED_READY == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Next thread in the deferred ready list.
+   */
+  thread_t * volatile   dfrnext;
+  /**
+   * @brief   Wakeup message of the pending deferred wakeup.
+   */
+  msg_t                 dfrmsg;
+#endif
 #if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Termination waiting list.
@@ -286,6 +506,17 @@ struct ch_thread {
    */
   tprio_t               realprio;
 #endif
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Absolute deadline of the thread.
+   * @note    Only meaningful while the thread is in the EDF band.
+   */
+  systime_t             deadline;
+  /**
+   * @brief   Fixed priority to be restored when leaving the EDF band.
+   */
+  tprio_t               bprio;
+#endif
 #if ((CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_MEMPOOLS == TRUE)) ||      \
     defined(__DOXYGEN__)
   /**
@@ -313,7 +544,12 @@ struct ch_thread {
 struct ch_virtual_timer {
   virtual_timer_t       *next;      /**< @brief Next timer in the list.     */
   virtual_timer_t       *prev;      /**< @brief Previous timer in the list. */
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+  systime_t             deadline;   /**< @brief Absolute expiration time.   */
+#endif
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == FALSE) || defined(__DOXYGEN__)
   sysinterval_t         delta;      /**< @brief Time delta before timeout.  */
+#endif
   vtfunc_t              func;       /**< @brief Timer callback function
                                                 pointer.                    */
   void                  *par;       /**< @brief Timer callback function
@@ -327,11 +563,28 @@ struct ch_virtual_timer {
  *          timer is often used in the code.
  */
 struct ch_virtual_timers_list {
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == FALSE) || defined(__DOXYGEN__)
   virtual_timer_t       *next;      /**< @brief Next timer in the delta
                                                 list.                       */
   virtual_timer_t       *prev;      /**< @brief Last timer in the delta
                                                 list.                       */
   sysinterval_t         delta;      /**< @brief Must be initialized to -1.  */
+#endif
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timer wheel slots, one queue of timers for each slot.
+   * @note    Timers are hashed on the slots by expiration time, each slot
+   *          queue is kept ordered by expiration time.
+   */
+  struct {
+    virtual_timer_t     *next;      /**< @brief First timer in the slot.    */
+    virtual_timer_t     *prev;      /**< @brief Last timer in the slot.     */
+  } slots[CH_CFG_VT_WHEEL_SIZE];
+  /**
+   * @brief   Number of currently armed timers.
+   */
+  cnt_t                 cnt;
+#endif
 #if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
   volatile systime_t    systime;    /**< @brief System Time counter.        */
 #endif
@@ -360,6 +613,26 @@ struct ch_ready_list {
   /* End of the fields shared with the thread_t structure.*/
   thread_t              *current;   /**< @brief The currently running
                                                 thread.                     */
+#if (CH_CFG_USE_DEFERRED_READY == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the lock-free deferred ready list.
+   * @note    This field is accessed from interrupt handlers outside the
+   *          kernel critical zone using atomic operations.
+   */
+  thread_t * volatile   dfrlist;
+#endif
+#if (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Bitmap of the non-empty priority FIFOs.
+   * @note    Bit @p n is set when @p fifos[n] contains at least one
+   *          ready thread.
+   */
+  uint32_t              prio_bmap[CH_SCH_PRIO_BMAP_WORDS];
+  /**
+   * @brief   One FIFO of ready threads for each priority level.
+   */
+  threads_queue_t       fifos[CH_SCH_PRIO_LEVELS];
+#endif
 };
 
 /**
@@ -425,6 +698,23 @@ struct ch_system {
    * @brief   Global kernel statistics.
    */
   kernel_stats_t        kernel_stats;
+#endif
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Realtime counter value at the last context switch.
+   */
+  rtcnt_t               lastswc;
+#endif
+#if (CH_CFG_USE_IDLE_CYCLES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Realtime counter value at the last idle entry.
+   */
+  rtcnt_t               idle_start;
+  /**
+   * @brief   Realtime counter cycles accumulated at the idle priority
+   *          level.
+   */
+  volatile rttime_t     idle_cycles;
 #endif
   CH_CFG_SYSTEM_EXTRA_FIELDS
 };
@@ -464,11 +754,16 @@ extern "C" {
   void _scheduler_init(void);
   thread_t *chSchReadyI(thread_t *tp);
   thread_t *chSchReadyAheadI(thread_t *tp);
+  void chSchWakeupAllI(threads_queue_t *tqp, msg_t msg);
   void chSchGoSleepS(tstate_t newstate);
   msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout);
   void chSchWakeupS(thread_t *ntp, msg_t msg);
   void chSchRescheduleS(void);
   bool chSchIsPreemptionRequired(void);
+#if CH_CFG_USE_DEFERRED_READY == TRUE
+  void chSchDeferReadyX(thread_t *tp, msg_t msg);
+  void chSchDrainDeferredI(void);
+#endif
   void chSchDoRescheduleBehind(void);
   void chSchDoRescheduleAhead(void);
   void chSchDoReschedule(void);
@@ -630,6 +925,197 @@ static inline thread_t *queue_dequeue(thread_t *tp) {
 }
 #endif /* CH_CFG_OPTIMIZE_SPEED == TRUE */
 
+#if (CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Sets the ready list bitmap bit associated to a priority level.
+ *
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void prio_bmap_set(tprio_t prio) {
+
+  ch.rlist.prio_bmap[(unsigned)prio / 32U] |=
+                                   (uint32_t)1U << ((unsigned)prio % 32U);
+}
+
+/**
+ * @brief   Clears the ready list bitmap bit associated to a priority level.
+ *
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void prio_bmap_clear(tprio_t prio) {
+
+  ch.rlist.prio_bmap[(unsigned)prio / 32U] &=
+                                ~((uint32_t)1U << ((unsigned)prio % 32U));
+}
+
+/**
+ * @brief   Returns the highest priority level with ready threads.
+ * @note    The scan is constant-time, it is bounded by the fixed number
+ *          of bitmap words.
+ *
+ * @return              The highest ready priority.
+ * @retval NOPRIO       if the ready list is empty.
+ *
+ * @notapi
+ */
+static inline tprio_t prio_bmap_first(void) {
+  unsigned i = CH_SCH_PRIO_BMAP_WORDS;
+
+  do {
+    uint32_t w;
+
+    i--;
+    w = ch.rlist.prio_bmap[i];
+    if (w != 0U) {
+#if defined(__GNUC__)
+      return (tprio_t)((i * 32U) + (31U - (unsigned)__builtin_clz(w)));
+#else
+      unsigned n = 0U;
+
+      if ((w & 0xFFFF0000U) != 0U) {
+        w >>= 16U;
+        n += 16U;
+      }
+      if ((w & 0xFF00U) != 0U) {
+        w >>= 8U;
+        n += 8U;
+      }
+      if ((w & 0xF0U) != 0U) {
+        w >>= 4U;
+        n += 4U;
+      }
+      if ((w & 0xCU) != 0U) {
+        w >>= 2U;
+        n += 2U;
+      }
+      if ((w & 0x2U) != 0U) {
+        n += 1U;
+      }
+      return (tprio_t)((i * 32U) + n);
+#endif
+    }
+  } while (i > 0U);
+
+  return NOPRIO;
+}
+#endif /* CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE */
+
+/**
+ * @brief   Returns the priority of the first thread in the ready list.
+ *
+ * @return              The highest ready priority.
+ * @retval NOPRIO       if the ready list is empty.
+ *
+ * @notapi
+ */
+static inline tprio_t sch_firstprio(void) {
+
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  return prio_bmap_first();
+#else
+  return firstprio(&ch.rlist.queue);
+#endif
+}
+
+/**
+ * @brief   Removes the highest priority thread from the ready list.
+ * @pre     The ready list must be non-empty before calling this function.
+ *
+ * @return              The removed thread pointer.
+ *
+ * @notapi
+ */
+static inline thread_t *sch_pick_first(void) {
+
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  tprio_t prio = prio_bmap_first();
+  threads_queue_t *tqp = &ch.rlist.fifos[prio];
+  thread_t *tp = queue_fifo_remove(tqp);
+
+  if (queue_isempty(tqp)) {
+    prio_bmap_clear(prio);
+  }
+
+  return tp;
+#else
+  return queue_fifo_remove(&ch.rlist.queue);
+#endif
+}
+
+/**
+ * @brief   Removes a thread from the ready list regardless of its position.
+ * @note    This function, unlike a simple @p queue_dequeue(), keeps the
+ *          priority bitmap consistent when the bitmap ready list is enabled,
+ *          it must be used when re-enqueuing a ready thread after a priority
+ *          change.
+ *
+ * @param[in] tp        the pointer to the thread to be removed
+ * @return              The removed thread pointer.
+ *
+ * @notapi
+ */
+static inline thread_t *sch_ready_dequeue(thread_t *tp) {
+
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  /* If the thread is the only element then both links point to the FIFO
+     header, the FIFO is becoming empty and its bitmap bit is cleared. The
+     thread priority cannot be used as index because this function can be
+     invoked after a priority boost.*/
+  if (tp->queue.next == tp->queue.prev) {
+    prio_bmap_clear((tprio_t)((threads_queue_t *)(void *)tp->queue.next -
+                              &ch.rlist.fifos[0]));
+  }
+#endif
+
+  return queue_dequeue(tp);
+}
+
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Evaluates the relative order of two absolute deadlines.
+ * @note    The comparison is wrap-safe as long as the two deadlines are
+ *          less than half of the @p systime_t range apart.
+ *
+ * @param[in] d1        first absolute deadline
+ * @param[in] d2        second absolute deadline
+ * @return              The deadlines situation.
+ * @retval true         if @p d1 is strictly earlier than @p d2.
+ *
+ * @notapi
+ */
+static inline bool sch_edf_is_earlier(systime_t d1, systime_t d2) {
+
+  return (bool)((systime_t)((systime_t)(d2 - d1) - (systime_t)1) <
+                (systime_t)((systime_t)-1 >> 1));
+}
+
+/**
+ * @brief   Evaluates if a thread must run before another one.
+ * @details Threads in the EDF band are ordered by earliest absolute
+ *          deadline, the comparison degenerates in the usual priority
+ *          comparison when at least one of the threads is outside the band.
+ *
+ * @param[in] tp1       pointer to the first thread
+ * @param[in] tp2       pointer to the second thread
+ * @return              The threads situation.
+ * @retval true         if @p tp1 must run before @p tp2.
+ *
+ * @notapi
+ */
+static inline bool sch_runs_before(thread_t *tp1, thread_t *tp2) {
+
+  if ((tp1->prio == EDFPRIO) && (tp2->prio == EDFPRIO)) {
+    return sch_edf_is_earlier(tp1->deadline, tp2->deadline);
+  }
+
+  return (bool)(tp1->prio > tp2->prio);
+}
+#endif /* CH_CFG_USE_EDF == TRUE */
+
 /**
  * @brief   Determines if the current thread must reschedule.
  * @details This function returns @p true if there is a ready thread with
@@ -645,7 +1131,11 @@ static inline bool chSchIsRescRequiredI(void) {
 
   chDbgCheckClassI();
 
-  return firstprio(&ch.rlist.queue) > currp->prio;
+#if CH_CFG_USE_EDF == TRUE
+  return sch_runs_before(ch.rlist.queue.next, currp);
+#else
+  return sch_firstprio() > currp->prio;
+#endif
 }
 
 /**
@@ -663,7 +1153,7 @@ static inline bool chSchCanYieldS(void) {
 
   chDbgCheckClassS();
 
-  return firstprio(&ch.rlist.queue) >= currp->prio;
+  return sch_firstprio() >= currp->prio;
 }
 
 /**
@@ -690,7 +1180,7 @@ static inline void chSchDoYieldS(void) {
  * @special
  */
 static inline void chSchPreemption(void) {
-  tprio_t p1 = firstprio(&ch.rlist.queue);
+  tprio_t p1 = sch_firstprio();
   tprio_t p2 = currp->prio;
 
 #if CH_CFG_TIME_QUANTUM > 0
@@ -38,6 +38,18 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Per-semaphore queuing policy.
+ * @details If enabled then the FIFO versus priority queuing order can be
+ *          selected on each semaphore instead of globally through
+ *          @p CH_CFG_USE_SEMAPHORES_PRIORITY, which then only provides
+ *          the default for new semaphores.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_SEMAPHORES_POLICY) || defined(__DOXYGEN__)
+#define CH_CFG_USE_SEMAPHORES_POLICY        FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -53,6 +65,10 @@ typedef struct ch_semaphore {
   threads_queue_t       queue;      /**< @brief Queue of the threads sleeping
                                                 on this semaphore.          */
   cnt_t                 cnt;        /**< @brief The semaphore counter.      */
+#if (CH_CFG_USE_SEMAPHORES_POLICY == TRUE) || defined(__DOXYGEN__)
+  bool                  prio;       /**< @brief Priority queuing order
+                                                flag.                       */
+#endif
 } semaphore_t;
 
 /*===========================================================================*/
@@ -68,7 +84,12 @@ typedef struct ch_semaphore {
  * @param[in] n         the counter initial value, this value must be
  *                      non-negative
  */
+#if (CH_CFG_USE_SEMAPHORES_POLICY == TRUE) || defined(__DOXYGEN__)
+#define _SEMAPHORE_DATA(name, n) {_THREADS_QUEUE_DATA(name.queue), n,       \
+                                  CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE}
+#else
 #define _SEMAPHORE_DATA(name, n) {_THREADS_QUEUE_DATA(name.queue), n}
+#endif
 
 /**
  * @brief   Static semaphore initializer.
@@ -97,6 +118,7 @@ extern "C" {
   msg_t chSemWaitTimeoutS(semaphore_t *sp, sysinterval_t timeout);
   void chSemSignal(semaphore_t *sp);
   void chSemSignalI(semaphore_t *sp);
+  void chSemSignalN(semaphore_t *sp, cnt_t n);
   void chSemAddCounterI(semaphore_t *sp, cnt_t n);
   msg_t chSemSignalWait(semaphore_t *sps, semaphore_t *spw);
 #ifdef __cplusplus
@@ -138,6 +160,38 @@ static inline void chSemFastSignalI(semaphore_t *sp) {
   sp->cnt++;
 }
 
+#if (CH_CFG_USE_SEMAPHORES_POLICY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Sets the semaphore queuing policy.
+ * @pre     The semaphore must have no waiting threads when the policy is
+ *          changed.
+ *
+ * @param[in] sp        pointer to a @p semaphore_t structure
+ * @param[in] prio      @p true for priority order, @p false for FIFO
+ *                      order
+ *
+ * @xclass
+ */
+static inline void chSemSetPolicyX(semaphore_t *sp, bool prio) {
+
+  sp->prio = prio;
+}
+
+/**
+ * @brief   Returns the semaphore queuing policy.
+ *
+ * @param[in] sp        pointer to a @p semaphore_t structure
+ * @return              The queuing policy.
+ * @retval true         if the queue is priority ordered.
+ *
+ * @xclass
+ */
+static inline bool chSemGetPolicyX(const semaphore_t *sp) {
+
+  return sp->prio;
+}
+#endif /* CH_CFG_USE_SEMAPHORES_POLICY == TRUE */
+
 /**
  * @brief   Returns the semaphore counter current value.
  *
@@ -0,0 +1,162 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chsmp.h
+ * @brief   Multi-core support macros and structures.
+ * @details This module supports asymmetric multi-processing configurations
+ *          where each core runs its own independent RT instance with its
+ *          own ready list and idle thread. Cross-core thread wakeups are
+ *          performed through single-producer single-consumer queues placed
+ *          in memory shared by the cores, the receiving core drains its
+ *          queue from an IPI interrupt handler.
+ *
+ * @addtogroup smp
+ * @{
+ */
+
+#ifndef CHSMP_H
+#define CHSMP_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Multi-core support.
+ * @details If enabled then the cross-core wakeup queues are included
+ *          in the kernel.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_SMP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_SMP                      FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_SMP == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a cross-core wakeup request.
+ */
+typedef struct ch_smp_wakeup {
+  /**
+   * @brief   Reference to the thread to be resumed on the remote core.
+   */
+  thread_reference_t    *trp;
+  /**
+   * @brief   Wakeup message to be delivered to the resumed thread.
+   */
+  msg_t                 msg;
+} smp_wakeup_t;
+
+/**
+ * @brief   Type of a cross-core wakeup queue.
+ * @details The queue is a single-producer single-consumer circular buffer,
+ *          the producing core only writes @p wrptr, the consuming core only
+ *          writes @p rdptr, so no inter-core lock is required.
+ * @note    The structure and its buffer must be placed in memory accessible
+ *          and coherent for both cores.
+ */
+typedef struct ch_smp_queue {
+  /**
+   * @brief   Pointer to the queue buffer.
+   */
+  smp_wakeup_t          *buffer;
+  /**
+   * @brief   Pointer to the first location past the queue buffer.
+   */
+  smp_wakeup_t          *top;
+  /**
+   * @brief   Write pointer, only advanced by the producing core.
+   */
+  smp_wakeup_t * volatile wrptr;
+  /**
+   * @brief   Read pointer, only advanced by the consuming core.
+   */
+  smp_wakeup_t * volatile rdptr;
+} smp_queue_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Memory barrier separating the queue slot write from the write
+ *          pointer update.
+ * @note    This macro can be overridden in @p chconf.h with an
+ *          architecture-specific barrier if required by the target cores
+ *          memory model.
+ */
+#if !defined(CH_CFG_SMP_MEMORY_BARRIER) || defined(__DOXYGEN__)
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define CH_CFG_SMP_MEMORY_BARRIER() __asm volatile ("" : : : "memory")
+#else
+#define CH_CFG_SMP_MEMORY_BARRIER()
+#endif
+#endif
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chSMPQueueObjectInit(smp_queue_t *sqp, smp_wakeup_t *buf, size_t n);
+  bool chSMPPostWakeupI(smp_queue_t *sqp, thread_reference_t *trp, msg_t msg);
+  void chSMPDispatchI(smp_queue_t *sqp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Evaluates to @p true if the wakeup queue contains pending
+ *          requests.
+ * @note    This function can be safely invoked by both cores.
+ *
+ * @param[in] sqp       pointer to a @p smp_queue_t structure
+ * @return              The queue status.
+ *
+ * @xclass
+ */
+static inline bool chSMPIsQueuePendingX(smp_queue_t *sqp) {
+
+  return (bool)(sqp->wrptr != sqp->rdptr);
+}
+
+#endif /* CH_CFG_USE_SMP == TRUE */
+
+#endif /* CHSMP_H */
+
+/** @} */
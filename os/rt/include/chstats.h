@@ -38,18 +38,79 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
-#if CH_CFG_USE_TM == FALSE
-#error "CH_DBG_STATISTICS requires CH_CFG_USE_TM"
+/**
+ * @brief   Critical sections auditor.
+ * @details If enabled then each critical zone is measured individually
+ *          using the realtime counter, the DWT cycle counter on Cortex-M
+ *          parts, and attributed to its call site captured from the
+ *          return address of the measurement hooks. The worst offenders
+ *          are kept in the @p slots table of @p ch.kernel_stats.audit,
+ *          each entry holding the call site, its worst duration in
+ *          cycles and the number of executed sections.
+ * @note    This option requires a compiler providing the GCC return
+ *          address builtins.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_AUDIT_CRITICAL) || defined(__DOXYGEN__)
+#define CH_DBG_AUDIT_CRITICAL               FALSE
+#endif
+
+/**
+ * @brief   Number of entries in the worst offenders table.
+ * @note    The default is 8.
+ */
+#if !defined(CH_DBG_AUDIT_CRITICAL_SLOTS) || defined(__DOXYGEN__)
+#define CH_DBG_AUDIT_CRITICAL_SLOTS         8
 #endif
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if CH_CFG_USE_TM == FALSE
+#error "CH_DBG_STATISTICS requires CH_CFG_USE_TM"
+#endif
+
+#if (CH_DBG_AUDIT_CRITICAL == TRUE) && !defined(__GNUC__) &&                \
+    !defined(__DOXYGEN__)
+#error "CH_DBG_AUDIT_CRITICAL requires the GCC return address builtins"
+#endif
+
+#if (CH_DBG_AUDIT_CRITICAL == TRUE) && (CH_DBG_AUDIT_CRITICAL_SLOTS <= 0)
+#error "invalid CH_DBG_AUDIT_CRITICAL_SLOTS specified"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (CH_DBG_AUDIT_CRITICAL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an entry of the critical sections offenders table.
+ */
+typedef struct {
+  void                  *caller;    /**< @brief Critical zone call site.    */
+  rtcnt_t               worst;      /**< @brief Worst duration in cycles.   */
+  ucnt_t                n;          /**< @brief Number of executed zones.   */
+} crit_audit_slot_t;
+
+/**
+ * @brief   Type of the critical sections auditor state.
+ */
+typedef struct {
+  void                  *thd_caller;/**< @brief Current thread-side zone
+                                                call site.                  */
+  rtcnt_t               thd_start;  /**< @brief Current thread-side zone
+                                                start cycle.                */
+  void                  *isr_caller;/**< @brief Current ISR-side zone call
+                                                site.                       */
+  rtcnt_t               isr_start;  /**< @brief Current ISR-side zone start
+                                                cycle.                      */
+  crit_audit_slot_t     slots[CH_DBG_AUDIT_CRITICAL_SLOTS];
+                                    /**< @brief Worst offenders table.      */
+} crit_audit_t;
+#endif /* CH_DBG_AUDIT_CRITICAL == TRUE */
+
 /**
  * @brief   Type of a kernel statistics structure.
  */
@@ -60,6 +121,10 @@ typedef struct {
                                                 critical zones duration.    */
   time_measurement_t    m_crit_isr; /**< @brief Measurement of ISRs critical
                                                 zones duration.             */
+#if (CH_DBG_AUDIT_CRITICAL == TRUE) || defined(__DOXYGEN__)
+  crit_audit_t          audit;      /**< @brief Critical sections auditor
+                                                state.                      */
+#endif
 } kernel_stats_t;
 
 /*===========================================================================*/
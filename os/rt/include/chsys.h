@@ -56,6 +56,30 @@
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Type of an incremental integrity check cursor.
+ * @details The cursor carries the resume position of an incremental
+ *          integrity sweep across calls to @p chSysIntegrityCheckStepI().
+ *          It must be zero-initialized before starting a sweep, positions
+ *          are tracked as ordinals so no kernel pointer is retained
+ *          outside the critical zone.
+ */
+typedef struct {
+  /**
+   * @brief   Check being resumed, one of the @p CH_INTEGRITY_ masks or
+   *          zero when a sweep is complete.
+   */
+  unsigned              stage;
+  /**
+   * @brief   Sub-structure index within the current check.
+   */
+  unsigned              index;
+  /**
+   * @brief   Ordinal position within the current list.
+   */
+  cnt_t                 offset;
+} sys_integrity_cursor_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -267,6 +291,7 @@
                                                                             \
   _trace_switch(ntp, otp);                                                  \
   _stats_ctxswc(ntp, otp);                                                  \
+  _cycles_ctxswc(ntp, otp);                                                 \
   CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp);                                     \
   port_switch(ntp, otp);                                                    \
 }
@@ -284,6 +309,8 @@ extern "C" {
 #endif
   void chSysInit(void);
   bool chSysIntegrityCheckI(unsigned testmask);
+  bool chSysIntegrityCheckStepI(sys_integrity_cursor_t *icp,
+                                unsigned testmask, unsigned n);
   void chSysTimerHandlerI(void);
   syssts_t chSysGetStatusAndLockX(void);
   void chSysRestoreStatusX(syssts_t sts);
@@ -299,6 +326,29 @@ extern "C" {
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Per-thread cycles accounting at context switch.
+ * @note    Not a user function, it is meant to be invoked from within
+ *          @p chSysSwitch().
+ *
+ * @param[in] ntp       the thread to be switched in
+ * @param[in] otp       the thread to be switched out
+ *
+ * @notapi
+ */
+static inline void _cycles_ctxswc(thread_t *ntp, thread_t *otp) {
+  rtcnt_t now = (rtcnt_t)port_rt_get_counter_value();
+
+  (void)ntp;
+
+  otp->cycles += now - ch.lastswc;
+  ch.lastswc = now;
+}
+#else /* CH_CFG_USE_THREAD_CYCLES == FALSE */
+#define _cycles_ctxswc(ntp, otp)
+#endif /* CH_CFG_USE_THREAD_CYCLES == FALSE */
+
 /**
  * @brief   Raises the system interrupt priority mask to the maximum level.
  * @details All the maskable interrupt sources are disabled regardless their
@@ -371,8 +421,7 @@ static inline void chSysUnlock(void) {
      in a critical section not followed by a chSchResceduleS(), this means
      that the current thread has a lower priority than the next thread in
      the ready list.*/
-  chDbgAssert((ch.rlist.queue.next == (thread_t *)&ch.rlist.queue) ||
-              (ch.rlist.current->prio >= ch.rlist.queue.next->prio),
+  chDbgAssert(ch.rlist.current->prio >= sch_firstprio(),
               "priority order violation");
 
   port_unlock();
@@ -460,10 +509,61 @@ static inline void chSysUnconditionalUnlock(void) {
  */
 static inline thread_t *chSysGetIdleThreadX(void) {
 
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  /* The idle thread is the only thread at @p IDLEPRIO level.*/
+  return ch.rlist.fifos[IDLEPRIO].next;
+#else
   return ch.rlist.queue.prev;
+#endif
 }
+
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the realtime counter cycles consumed by the idle thread.
+ * @details Comparing two samples of this value against the realtime counter
+ *          span gives the system idle ratio without enabling the statistics
+ *          module.
+ * @pre     In order to use this function the option @p CH_CFG_USE_THREAD_CYCLES
+ *          must be enabled.
+ * @note    The cycles of the current idle activation, if any, are not
+ *          included.
+ *
+ * @return              The idle thread consumed cycles.
+ *
+ * @xclass
+ */
+static inline rtcnt_t chSysGetIdleTimeX(void) {
+
+  return chSysGetIdleThreadX()->cycles;
+}
+#endif /* CH_CFG_USE_THREAD_CYCLES == TRUE */
 #endif /* CH_CFG_NO_IDLE_THREAD == FALSE */
 
+#if (CH_CFG_USE_IDLE_CYCLES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the accumulated idle realtime counter cycles.
+ * @details The ledger is maintained by the scheduler across the idle
+ *          entry and exit transitions, it measures the true sleep
+ *          residency including the cycles spent in the wait instruction
+ *          and works also when @p CH_CFG_NO_IDLE_THREAD is enabled.
+ * @pre     In order to use this function the option @p CH_CFG_USE_IDLE_CYCLES
+ *          must be enabled.
+ * @note    On architectures where the realtime counter stops in the low
+ *          power state entered by the idle loop the ledger only measures
+ *          the active portion of the idle windows.
+ * @note    The cycles of the current idle window, if any, are not
+ *          included.
+ *
+ * @return              The accumulated idle cycles.
+ *
+ * @xclass
+ */
+static inline rttime_t chSysGetIdleCyclesX(void) {
+
+  return ch.idle_cycles;
+}
+#endif /* CH_CFG_USE_IDLE_CYCLES == TRUE */
+
 #endif /* CHSYS_H */
 
 /** @} */
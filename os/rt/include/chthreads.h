@@ -38,10 +38,30 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Spin threshold for @p chThdSleep() in ticks.
+ * @details Delays not exceeding this threshold are performed with a polled
+ *          wait on the system time base instead of arming a virtual timer,
+ *          trading a short busy wait for a lower wakeup latency and no
+ *          pressure on the timers subsystem.
+ * @note    Meaningful values are at or below @p CH_CFG_ST_TIMEDELTA where
+ *          the timers subsystem would round the delay up anyway, spinning
+ *          on longer delays wastes CPU time.
+ * @note    The default is @p 0, the feature is disabled and all delays go
+ *          through the timers subsystem.
+ */
+#if !defined(CH_CFG_THREAD_SPIN_THRESHOLD) || defined(__DOXYGEN__)
+#define CH_CFG_THREAD_SPIN_THRESHOLD    0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if CH_CFG_THREAD_SPIN_THRESHOLD < 0
+#error "invalid CH_CFG_THREAD_SPIN_THRESHOLD specified"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -150,6 +170,44 @@ typedef struct {
                                  (sizeof (s) / sizeof (stkalign_t)))
 /** @} */
 
+/**
+ * @name    Static threads table
+ * @details These macros allow to define the application threads as a single
+ *          constant table of @p thread_descriptor_t entries placed in
+ *          flash-initialized data. All the threads in the table are created
+ *          at once by calling @p chThdCreateAll(), this is faster than a
+ *          series of @p chThdCreateStatic() calls because the critical zone
+ *          is entered once and rescheduling is evaluated once at the end.
+ * @{
+ */
+/**
+ * @brief   Start of the static threads table.
+ */
+#define THD_TABLE_BEGIN                                                     \
+  const thread_descriptor_t ch_thd_table[] = {
+
+/**
+ * @brief   Entry of the static threads table.
+ *
+ * @param[in] wap       thread working area, declared with
+ *                      @p THD_WORKING_AREA()
+ * @param[in] name      thread name
+ * @param[in] prio      thread priority
+ * @param[in] funcp     thread function
+ * @param[in] arg       thread function argument
+ */
+#define THD_TABLE_ENTRY(wap, name, prio, funcp, arg)                        \
+  {name, THD_WORKING_AREA_BASE(wap), THD_WORKING_AREA_END(wap),             \
+   prio, funcp, arg},
+
+/**
+ * @brief   End of the static threads table.
+ */
+#define THD_TABLE_END                                                       \
+  {NULL, NULL, NULL, NOPRIO, NULL, NULL}                                    \
+};
+/** @} */
+
 /**
  * @name    Threads abstraction macros
  */
@@ -223,6 +281,10 @@ extern "C" {
    thread_t *_thread_init(thread_t *tp, const char *name, tprio_t prio);
 #if CH_DBG_FILL_THREADS == TRUE
   void _thread_memfill(uint8_t *startp, uint8_t *endp, uint8_t v);
+#endif
+#if (CH_DBG_FILL_THREADS == TRUE) &&                                        \
+    ((CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE))
+  size_t chThdGetFreeStackX(thread_t *tp);
 #endif
   thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp);
   thread_t *chThdCreateSuspended(const thread_descriptor_t *tdp);
@@ -230,6 +292,8 @@ extern "C" {
   thread_t *chThdCreate(const thread_descriptor_t *tdp);
   thread_t *chThdCreateStatic(void *wsp, size_t size,
                               tprio_t prio, tfunc_t pf, void *arg);
+  extern const thread_descriptor_t ch_thd_table[];
+  void chThdCreateAll(void);
   thread_t *chThdStart(thread_t *tp);
 #if CH_CFG_USE_REGISTRY == TRUE
   thread_t *chThdAddRef(thread_t *tp);
@@ -239,8 +303,13 @@ extern "C" {
   void chThdExitS(msg_t msg);
 #if CH_CFG_USE_WAITEXIT == TRUE
   msg_t chThdWait(thread_t *tp);
+  void chThdWaitAll(thread_t *tps[], size_t n, msg_t msgs[]);
 #endif
   tprio_t chThdSetPriority(tprio_t newprio);
+#if CH_CFG_USE_EDF == TRUE
+  void chThdSetDeadlineS(sysinterval_t delay);
+  void chThdSetDeadline(sysinterval_t delay);
+#endif
   void chThdTerminate(thread_t *tp);
   msg_t chThdSuspendS(thread_reference_t *trp);
   msg_t chThdSuspendTimeoutS(thread_reference_t *trp, sysinterval_t timeout);
@@ -250,6 +319,7 @@ extern "C" {
   msg_t chThdEnqueueTimeoutS(threads_queue_t *tqp, sysinterval_t timeout);
   void chThdDequeueNextI(threads_queue_t *tqp, msg_t msg);
   void chThdDequeueAllI(threads_queue_t *tqp, msg_t msg);
+  void chThdSpinDelayX(sysinterval_t delay);
   void chThdSleep(sysinterval_t time);
   void chThdSleepUntil(systime_t time);
   systime_t chThdSleepUntilWindowed(systime_t prev, systime_t next);
@@ -304,6 +374,26 @@ static inline systime_t chThdGetTicksX(thread_t *tp) {
 }
 #endif
 
+#if (CH_CFG_USE_THREAD_CYCLES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the realtime counter cycles consumed by the specified
+ *          thread.
+ * @note    This function is only available when the
+ *          @p CH_CFG_USE_THREAD_CYCLES configuration option is enabled.
+ * @note    The cycles of the current activation, if the thread is running,
+ *          are not included.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The number of consumed realtime counter cycles.
+ *
+ * @xclass
+ */
+static inline rtcnt_t chThdGetCyclesX(thread_t *tp) {
+
+  return tp->cycles;
+}
+#endif
+
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE) ||  \
     defined(__DOXYGEN__)
 /**
@@ -334,6 +424,33 @@ static inline bool chThdTerminatedX(thread_t *tp) {
   return (bool)(tp->state == CH_STATE_FINAL);
 }
 
+/**
+ * @brief   Retrieves the exit code of a terminated thread, non blocking.
+ * @note    The references to the thread are not touched, a successful
+ *          peek does not replace the mandatory @p chThdWait() or
+ *          @p chThdRelease() on the thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[out] msgp     pointer to the exit code destination, can be
+ *                      @p NULL
+ * @retval true         thread terminated, exit code retrieved.
+ * @retval false        thread not terminated yet.
+ *
+ * @xclass
+ */
+static inline bool chThdPeekExitX(thread_t *tp, msg_t *msgp) {
+
+  if (tp->state != CH_STATE_FINAL) {
+    return false;
+  }
+
+  if (msgp != NULL) {
+    *msgp = tp->u.exitcode;
+  }
+
+  return true;
+}
+
 /**
  * @brief   Verifies if the current thread has a termination request pending.
  *
@@ -34,10 +34,28 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of buckets in a measurements histogram.
+ * @details Bucket @p i counts the measurements whose integer binary
+ *          logarithm is @p i, the whole @p rtcnt_t range is covered.
+ */
+#define CH_TM_HISTOGRAM_BUCKETS         32U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Time Measurement histogram support.
+ * @details If enabled then measurement objects can optionally accumulate
+ *          a log2 histogram of the measured times, allowing percentile
+ *          estimations without exporting raw samples.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_TM_HISTOGRAM) || defined(__DOXYGEN__)
+#define CH_CFG_TM_HISTOGRAM             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -75,6 +93,15 @@ typedef struct {
   rtcnt_t               last;           /**< @brief Last measurement.       */
   ucnt_t                n;              /**< @brief Number of measurements. */
   rttime_t              cumulative;     /**< @brief Cumulative measurement. */
+#if (CH_CFG_TM_HISTOGRAM == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Optional log2 histogram buckets.
+   * @note    It is @p NULL if the object has been initialized with
+   *          @p chTMObjectInit(), the histogram is only accumulated for
+   *          objects initialized with @p chTMObjectInitHist().
+   */
+  ucnt_t                *hist;
+#endif
 } time_measurement_t;
 
 /*===========================================================================*/
@@ -90,6 +117,10 @@ extern "C" {
 #endif
   void _tm_init(void);
   void chTMObjectInit(time_measurement_t *tmp);
+#if CH_CFG_TM_HISTOGRAM == TRUE
+  void chTMObjectInitHist(time_measurement_t *tmp,
+                          ucnt_t hist[CH_TM_HISTOGRAM_BUCKETS]);
+#endif
   NOINLINE void chTMStartMeasurementX(time_measurement_t *tmp);
   NOINLINE void chTMStopMeasurementX(time_measurement_t *tmp);
   NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
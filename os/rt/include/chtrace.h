@@ -86,6 +86,26 @@
 #if !defined(CH_DBG_TRACE_BUFFER_SIZE) || defined(__DOXYGEN__)
 #define CH_DBG_TRACE_BUFFER_SIZE            128
 #endif
+
+/**
+ * @brief   Compact trace mode.
+ * @details When enabled the trace records are stored in a variable-length
+ *          binary encoding, time stamps are delta-encoded and threads are
+ *          identified by small indices instead of pointers. The buffer is
+ *          split in two banks so a full bank can be streamed out through
+ *          @p chDbgFetchTraceBuffer() without stopping the capture.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_TRACE_COMPACT) || defined(__DOXYGEN__)
+#define CH_DBG_TRACE_COMPACT                FALSE
+#endif
+
+/**
+ * @brief   Size in bytes of each of the two compact trace banks.
+ */
+#if !defined(CH_DBG_TRACE_COMPACT_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CH_DBG_TRACE_COMPACT_BUFFER_SIZE    256
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -96,7 +116,64 @@
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
-#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) || defined(__DOXYGEN__)
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    (CH_DBG_TRACE_COMPACT == TRUE)
+/**
+ * @brief   Compact trace buffer header.
+ * @details The records are stored as variable-length byte sequences: one
+ *          header byte carrying the record type in the three most
+ *          significant bits, a delta-encoded time stamp as a base-128
+ *          varint and a type-dependent payload. The buffer is organized in
+ *          two banks filled alternately.
+ */
+typedef struct {
+  /**
+   * @brief   Suspended trace sources mask.
+   */
+  uint16_t              suspended;
+  /**
+   * @brief   Index of the bank currently being filled.
+   */
+  uint8_t               active;
+  /**
+   * @brief   Mask of the banks ready to be drained.
+   */
+  volatile uint8_t      full;
+  /**
+   * @brief   Index of the bank being drained or @p 2 if none.
+   */
+  uint8_t               draining;
+  /**
+   * @brief   Next thread trace identifier to be assigned.
+   */
+  uint8_t               nextid;
+  /**
+   * @brief   Records dropped because both banks were full.
+   */
+  uint16_t              dropped;
+  /**
+   * @brief   Number of used bytes in each bank.
+   */
+  uint16_t              used[2];
+  /**
+   * @brief   Write pointer inside the active bank.
+   */
+  uint8_t               *wptr;
+  /**
+   * @brief   End of the active bank.
+   */
+  uint8_t               *wend;
+  /**
+   * @brief   Time stamp of the most recent record.
+   */
+  rtcnt_t               lastts;
+  /**
+   * @brief   Trace banks.
+   */
+  uint8_t               buffer[2][CH_DBG_TRACE_COMPACT_BUFFER_SIZE];
+} ch_trace_buffer_t;
+
+#elif (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) || defined(__DOXYGEN__)
 /*lint -save -e46 [6.1] An uint32_t is required.*/
 /**
  * @brief   Trace buffer record.
@@ -242,6 +319,12 @@ extern "C" {
   void chDbgSuspendTrace(uint16_t mask);
   void chDbgResumeTraceI(uint16_t mask);
   void chDbgResumeTrace(uint16_t mask);
+#if CH_DBG_TRACE_COMPACT == TRUE
+  bool chDbgFetchTraceBufferI(const uint8_t **bufp, size_t *sizep);
+  bool chDbgFetchTraceBuffer(const uint8_t **bufp, size_t *sizep);
+  void chDbgReleaseTraceBufferI(void);
+  void chDbgReleaseTraceBuffer(void);
+#endif
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 #ifdef __cplusplus
 }
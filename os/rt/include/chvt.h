@@ -75,6 +75,7 @@ extern "C" {
   void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
                   vtfunc_t vtfunc, void *par);
   void chVTDoResetI(virtual_timer_t *vtp);
+  void chVTRearmI(virtual_timer_t *vtp, sysinterval_t delay);
 #ifdef __cplusplus
 }
 #endif
@@ -190,6 +191,39 @@ static inline bool chVTIsSystemTimeWithin(systime_t start, systime_t end) {
   return chTimeIsInRangeX(chVTGetSystemTime(), start, end);
 }
 
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the armed timer with the nearest deadline.
+ * @details Because each slot queue is ordered by expiration time only the
+ *          slot heads are compared, the scan cost is bounded by the wheel
+ *          size regardless of the number of armed timers.
+ * @pre     The wheel must contain at least one armed timer.
+ *
+ * @param[in] ref       reference time, it must not be past any armed
+ *                      deadline
+ * @return              The pointer to the nearest timer.
+ *
+ * @notapi
+ */
+static inline virtual_timer_t *vt_wheel_nearest(systime_t ref) {
+  virtual_timer_t *best = NULL;
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SIZE; i++) {
+    virtual_timer_t *slot = (virtual_timer_t *)&ch.vtlist.slots[i];
+    virtual_timer_t *vtp = slot->next;
+
+    if ((vtp != slot) &&
+        ((best == NULL) || (chTimeDiffX(ref, vtp->deadline) <
+                            chTimeDiffX(ref, best->deadline)))) {
+      best = vtp;
+    }
+  }
+
+  return best;
+}
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == TRUE */
+
 /**
  * @brief   Returns the time interval until the next timer event.
  * @note    The return value is not perfectly accurate and can report values
@@ -210,6 +244,22 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
 
   chDbgCheckClassI();
 
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+  if (ch.vtlist.cnt == (cnt_t)0) {
+    return false;
+  }
+
+  if (timep != NULL) {
+#if CH_CFG_ST_TIMEDELTA == 0
+    systime_t ref = ch.vtlist.systime;
+#else
+    systime_t ref = chVTGetSystemTimeX();
+#endif
+    *timep = chTimeDiffX(ref, vt_wheel_nearest(ref)->deadline);
+  }
+
+  return true;
+#else /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
   if (&ch.vtlist == (virtual_timers_list_t *)ch.vtlist.next) {
     return false;
   }
@@ -226,6 +276,7 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
   }
 
   return true;
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
 }
 
 /**
@@ -358,6 +409,29 @@ static inline void chVTSet(virtual_timer_t *vtp, sysinterval_t delay,
   chSysUnlock();
 }
 
+/**
+ * @brief   Re-arms an active virtual timer with a new delay.
+ * @details The timer callback and parameter are preserved, the hardware
+ *          alarm is only reprogrammed once for the new deadline.
+ * @pre     The timer must be in armed state before calling this function.
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ *
+ * @api
+ */
+static inline void chVTRearm(virtual_timer_t *vtp, sysinterval_t delay) {
+
+  chSysLock();
+  chVTRearmI(vtp, delay);
+  chSysUnlock();
+}
+
 /**
  * @brief   Virtual timers ticker.
  * @note    The system lock is released before entering the callback and
@@ -371,6 +445,114 @@ static inline void chVTDoTickI(void) {
 
   chDbgCheckClassI();
 
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+#if CH_CFG_ST_TIMEDELTA == 0
+  ch.vtlist.systime++;
+  if (ch.vtlist.cnt > (cnt_t)0) {
+    virtual_timer_t *slot;
+
+    /* Only the slot associated to the current time can contain elapsed
+       timers, the slot queue is ordered so the scan stops at the first
+       timer belonging to a future wheel lap.*/
+    slot = (virtual_timer_t *)&ch.vtlist.slots[ch.vtlist.systime &
+                                               CH_VT_WHEEL_MASK];
+    while (true) {
+      virtual_timer_t *vtp = slot->next;
+      vtfunc_t fn;
+
+      if ((vtp == slot) || (vtp->deadline != ch.vtlist.systime)) {
+        break;
+      }
+
+      vtp->prev->next = vtp->next;
+      vtp->next->prev = vtp->prev;
+      fn = vtp->func;
+      vtp->func = NULL;
+      ch.vtlist.cnt--;
+
+      chSysUnlockFromISR();
+      fn(vtp->par);
+      chSysLockFromISR();
+    }
+  }
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  while (true) {
+    virtual_timer_t *vtp;
+    systime_t now;
+    sysinterval_t delta, nowdelta;
+    unsigned i, n;
+
+    /* Getting the system time as reference.*/
+    now = chVTGetSystemTimeX();
+    nowdelta = chTimeDiffX(ch.vtlist.lasttime, now);
+
+    /* Visiting the slots crossed since the last processed time, the whole
+       wheel if at least one full lap has elapsed.*/
+    n = (nowdelta >= (sysinterval_t)CH_CFG_VT_WHEEL_SIZE) ?
+        (unsigned)CH_CFG_VT_WHEEL_SIZE : (unsigned)nowdelta;
+    for (i = 1U; i <= n; i++) {
+      virtual_timer_t *slot;
+
+      slot = (virtual_timer_t *)&ch.vtlist.slots[chTimeAddX(ch.vtlist.lasttime,
+                                                 (systime_t)i) &
+                                                 CH_VT_WHEEL_MASK];
+      while (true) {
+        vtfunc_t fn;
+
+        vtp = slot->next;
+
+        /* The slot queue is ordered so the scan stops at the first timer
+           that is not elapsed yet. The reference time is re-evaluated on
+           each iteration because callbacks can restart the wheel.*/
+        if ((vtp == slot) ||
+            (chTimeDiffX(ch.vtlist.lasttime, vtp->deadline) >
+             chTimeDiffX(ch.vtlist.lasttime, now))) {
+          break;
+        }
+
+        vtp->prev->next = vtp->next;
+        vtp->next->prev = vtp->prev;
+        fn = vtp->func;
+        vtp->func = NULL;
+        ch.vtlist.cnt--;
+
+        /* The callback is invoked outside the kernel critical zone.*/
+        chSysUnlockFromISR();
+        fn(vtp->par);
+        chSysLockFromISR();
+      }
+    }
+
+    /* All timers up to "now" have been served.*/
+    ch.vtlist.lasttime = now;
+
+    /* If the wheel is empty then the alarm timer is stopped.*/
+    if (ch.vtlist.cnt == (cnt_t)0) {
+      port_timer_stop_alarm();
+
+      return;
+    }
+
+    /* Time could have advanced during the callbacks execution, if the
+       nearest deadline is already elapsed then another processing pass
+       is performed.*/
+    vtp = vt_wheel_nearest(now);
+    if (chTimeDiffX(now, vtp->deadline) <=
+        chTimeDiffX(now, chVTGetSystemTimeX())) {
+      continue;
+    }
+
+    /* Recalculating the next alarm time.*/
+    delta = chTimeDiffX(now, vtp->deadline);
+    if (delta < (sysinterval_t)CH_CFG_ST_TIMEDELTA) {
+      delta = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
+    }
+    port_timer_set_alarm(chTimeAddX(now, delta));
+
+    return;
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+#else /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
 #if CH_CFG_ST_TIMEDELTA == 0
   ch.vtlist.systime++;
   if (&ch.vtlist != (virtual_timers_list_t *)ch.vtlist.next) {
@@ -466,6 +648,7 @@ static inline void chVTDoTickI(void) {
               chTimeDiffX(ch.vtlist.lasttime, chTimeAddX(now, delta)),
               "exceeding delta");
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
 }
 
 #endif /* CHVT_H */
@@ -77,6 +77,9 @@ void chCondObjectInit(condition_variable_t *cp) {
   chDbgCheck(cp != NULL);
 
   queue_init(&cp->queue);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  cp->mtx = NULL;
+#endif
 }
 
 /**
@@ -151,12 +154,43 @@ void chCondBroadcastI(condition_variable_t *cp) {
   chDbgCheckClassI();
   chDbgCheck(cp != NULL);
 
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  if (queue_notempty(&cp->queue)) {
+    mutex_t *mp = cp->mtx;
+
+    /* The highest priority waiter is made ready, the wakeup message is set
+       to @p MSG_RESET in order to make a chCondBroadcast() detectable from
+       a chCondSignal().*/
+    chSchReadyI(queue_fifo_remove(&cp->queue))->u.rdymsg = MSG_RESET;
+
+    if ((mp != NULL) && (mp->owner != NULL)) {
+      /* Wait morphing, the remaining waiters are moved directly on the
+         wait queue of the associated mutex, they will be released one by
+         one as the mutex is passed along without ever racing for it.*/
+      while (queue_notempty(&cp->queue)) {
+        thread_t *tp = queue_fifo_remove(&cp->queue);
+
+        tp->u.wtmtxp = mp;
+        tp->state    = CH_STATE_WTMTX;
+        queue_prio_insert(tp, &mp->queue);
+      }
+    }
+    else {
+      /* The mutex is not currently owned, falling back to the classic
+         wake-all behavior.*/
+      while (queue_notempty(&cp->queue)) {
+        chSchReadyI(queue_fifo_remove(&cp->queue))->u.rdymsg = MSG_RESET;
+      }
+    }
+  }
+#else
   /* Empties the condition variable queue and inserts all the threads into the
      ready list in FIFO order. The wakeup message is set to @p MSG_RESET in
      order to make a chCondBroadcast() detectable from a chCondSignal().*/
   while (queue_notempty(&cp->queue)) {
     chSchReadyI(queue_fifo_remove(&cp->queue))->u.rdymsg = MSG_RESET;
   }
+#endif
 }
 
 /**
@@ -218,9 +252,24 @@ msg_t chCondWaitS(condition_variable_t *cp) {
      again.*/
   ctp->u.wtobjp = cp;
   queue_prio_insert(ctp, &cp->queue);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  cp->mtx = mp;
+#endif
   chSchGoSleepS(CH_STATE_WTCOND);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  if (ctp->mtxlist == mp) {
+    /* The mutex has already been granted by the wait morphing hand-off,
+       this can only happen on a broadcast.*/
+    msg = MSG_RESET;
+  }
+  else {
+    msg = ctp->u.rdymsg;
+    chMtxLockS(mp);
+  }
+#else
   msg = ctp->u.rdymsg;
   chMtxLockS(mp);
+#endif
 
   return msg;
 }
@@ -307,10 +356,24 @@ msg_t chCondWaitTimeoutS(condition_variable_t *cp, sysinterval_t timeout) {
      again.*/
   currp->u.wtobjp = cp;
   queue_prio_insert(currp, &cp->queue);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  cp->mtx = mp;
+#endif
   msg = chSchGoSleepTimeoutS(CH_STATE_WTCOND, timeout);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  if (currp->mtxlist == mp) {
+    /* The mutex has already been granted by the wait morphing hand-off,
+       this can only happen on a broadcast.*/
+    msg = MSG_RESET;
+  }
+  else if (msg != MSG_TIMEOUT) {
+    chMtxLockS(mp);
+  }
+#else
   if (msg != MSG_TIMEOUT) {
     chMtxLockS(mp);
   }
+#endif
 
   return msg;
 }
@@ -0,0 +1,267 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chdeferred.c
+ * @brief   Deferred interrupt handlers code.
+ * @details Deferred handlers split interrupt work into a minimal top half,
+ *          running in ISR context, and a bottom half executed by a
+ *          high-priority worker thread. The top half queues a work token
+ *          with @p chDeferredPostI() and returns, the worker thread is
+ *          woken through an event signal and invokes the handler in
+ *          thread context where it can be preempted and can use the full
+ *          system API.
+ *          <h2>Operation mode</h2>
+ *          Each worker owns a circular tokens queue. Posting from an ISR
+ *          happens in I-Class context so concurrent producers are already
+ *          serialized by the kernel lock, the worker consumes tokens in
+ *          FIFO order. When the queue is full the token is rejected and
+ *          accounted in a diagnostic counter, the producer can then fall
+ *          back to coalescing or dropping the event.
+ * @pre     In order to use the deferred handlers APIs the
+ *          @p CH_CFG_USE_DEFERRED option must be enabled in @p chconf.h.
+ *
+ * @addtogroup deferred
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_DEFERRED == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Event mask used to wake up the worker thread.
+ */
+#define DEFERRED_WAKEUP_EVENT       EVENT_MASK(0)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Worker thread function.
+ * @details Waits for the wakeup event then drains the tokens queue
+ *          invoking the queued handlers in FIFO order.
+ *
+ * @param[in] p         pointer to the @p deferred_worker_t structure
+ *
+ * @notapi
+ */
+static THD_FUNCTION(deferred_worker_thread, p) {
+  deferred_worker_t *dwp = (deferred_worker_t *)p;
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  chRegSetThreadName(dwp->name);
+#endif
+
+  while (!chThdShouldTerminateX()) {
+    (void) chEvtWaitAny(ALL_EVENTS);
+
+    /* Draining the queue, the event flag is sticky so tokens posted
+       while draining are not lost.*/
+    while (true) {
+      deferred_work_t w;
+
+      chSysLock();
+      if (dwp->cnt <= (cnt_t)0) {
+        chSysUnlock();
+        break;
+      }
+      dwp->cnt--;
+      w = *dwp->rdptr;
+      if (++dwp->rdptr >= dwp->top) {
+        dwp->rdptr = dwp->buffer;
+      }
+      chSysUnlock();
+
+      w.handler(w.arg);
+    }
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p deferred_worker_t structure.
+ *
+ * @param[out] dwp      pointer to a @p deferred_worker_t structure
+ * @param[in] buffer    pointer to the tokens buffer
+ * @param[in] n         number of @p deferred_work_t elements in the buffer
+ *
+ * @init
+ */
+void chDeferredObjectInit(deferred_worker_t *dwp,
+                          deferred_work_t *buffer, size_t n) {
+
+  chDbgCheck((dwp != NULL) && (buffer != NULL) && (n > (size_t)0));
+
+  dwp->thread  = NULL;
+  dwp->name    = NULL;
+  dwp->buffer  = buffer;
+  dwp->top     = &buffer[n];
+  dwp->wrptr   = buffer;
+  dwp->rdptr   = buffer;
+  dwp->cnt     = (cnt_t)0;
+  dwp->dropped = (cnt_t)0;
+}
+
+/**
+ * @brief   Starts the worker thread of a deferred worker.
+ * @details The worker thread should run above the priority of the threads
+ *          whose latency depends on the deferred work, the framework is
+ *          meant for bottom halves so a priority just below the interrupt
+ *          handlers is the typical choice.
+ *
+ * @param[in] dwp       pointer to a @p deferred_worker_t structure
+ * @param[in] name      thread name assigned to the worker
+ * @param[in] prio      worker thread priority
+ * @param[in] wsp       pointer to the worker working area
+ * @param[in] size      size of the worker working area
+ *
+ * @api
+ */
+void chDeferredStart(deferred_worker_t *dwp, const char *name,
+                     tprio_t prio, void *wsp, size_t size) {
+
+  chDbgCheck((dwp != NULL) && (wsp != NULL));
+  chDbgAssert(dwp->thread == NULL, "already started");
+
+  dwp->name   = name;
+  dwp->thread = chThdCreateStatic(wsp, size, prio,
+                                  deferred_worker_thread, (void *)dwp);
+}
+
+/**
+ * @brief   Posts a work token to a deferred worker.
+ * @details Meant to be called from the interrupt top half, the cost is a
+ *          pair of stores and an event signal, the handler is invoked
+ *          later in the worker thread context.
+ *
+ * @param[in] dwp       pointer to a @p deferred_worker_t structure
+ * @param[in] handler   bottom half function to be invoked
+ * @param[in] arg       argument passed to the handler
+ * @return              The operation status.
+ * @retval true         if the token has been queued.
+ * @retval false        if the queue is full, the token is rejected and
+ *                      accounted in the dropped counter.
+ *
+ * @iclass
+ */
+bool chDeferredPostI(deferred_worker_t *dwp,
+                     deferred_handler_t handler, void *arg) {
+
+  chDbgCheckClassI();
+  chDbgCheck((dwp != NULL) && (handler != NULL));
+
+  if (dwp->cnt >= (cnt_t)(dwp->top - dwp->buffer)) {
+    dwp->dropped++;
+    return false;
+  }
+  dwp->wrptr->handler = handler;
+  dwp->wrptr->arg     = arg;
+  if (++dwp->wrptr >= dwp->top) {
+    dwp->wrptr = dwp->buffer;
+  }
+  dwp->cnt++;
+
+  if (dwp->thread != NULL) {
+    chEvtSignalI(dwp->thread, DEFERRED_WAKEUP_EVENT);
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Posts a work token to a deferred worker.
+ *
+ * @param[in] dwp       pointer to a @p deferred_worker_t structure
+ * @param[in] handler   bottom half function to be invoked
+ * @param[in] arg       argument passed to the handler
+ * @return              The operation status.
+ * @retval true         if the token has been queued.
+ * @retval false        if the queue is full.
+ *
+ * @api
+ */
+bool chDeferredPost(deferred_worker_t *dwp,
+                    deferred_handler_t handler, void *arg) {
+  bool posted;
+
+  chSysLock();
+  posted = chDeferredPostI(dwp, handler, arg);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return posted;
+}
+
+#if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Stops the worker thread of a deferred worker.
+ * @details The worker thread is terminated and joined, tokens still in
+ *          the queue are not executed, they remain queued and would be
+ *          served after a new @p chDeferredStart().
+ * @pre     The @p CH_CFG_USE_WAITEXIT option must be enabled in
+ *          @p chconf.h.
+ *
+ * @param[in] dwp       pointer to a @p deferred_worker_t structure
+ *
+ * @api
+ */
+void chDeferredStop(deferred_worker_t *dwp) {
+  thread_t *tp;
+
+  chDbgCheck(dwp != NULL);
+
+  chSysLock();
+  tp = dwp->thread;
+  dwp->thread = NULL;
+  chSysUnlock();
+
+  if (tp == NULL) {
+    return;
+  }
+
+  chThdTerminate(tp);
+  chEvtSignal(tp, DEFERRED_WAKEUP_EVENT);
+  (void) chThdWait(tp);
+}
+#endif /* CH_CFG_USE_WAITEXIT == TRUE */
+
+#endif /* CH_CFG_USE_DEFERRED == TRUE */
+
+/** @} */
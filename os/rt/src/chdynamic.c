@@ -46,10 +46,66 @@
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_WA_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a working areas cache size class.
+ */
+typedef struct {
+  /**
+   * @brief   Heap block size of the parked areas, zero if the class is
+   *          not claimed yet.
+   */
+  size_t                size;
+  /**
+   * @brief   LIFO of the parked areas, linked through their first word.
+   */
+  void                  *first;
+  /**
+   * @brief   Number of parked areas.
+   */
+  ucnt_t                n;
+} wa_cache_class_t;
+
+/**
+ * @brief   Working areas cache classes.
+ */
+static wa_cache_class_t wa_cache[CH_CFG_WA_CACHE_CLASSES];
+#endif /* CH_CFG_USE_WA_CACHE == TRUE */
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_WA_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Takes a compatible working area from the cache.
+ *
+ * @param[in] size      requested working area size
+ * @return              A pointer to a parked working area of at least the
+ *                      requested size.
+ * @retval NULL         if the cache holds no compatible area.
+ *
+ * @notapi
+ */
+static void *dyn_wa_try_alloc(size_t size) {
+  unsigned i;
+  void *wsp = NULL;
+
+  chSysLock();
+  for (i = 0U; i < (unsigned)CH_CFG_WA_CACHE_CLASSES; i++) {
+    if ((wa_cache[i].first != NULL) && (wa_cache[i].size >= size)) {
+      wsp = wa_cache[i].first;
+      wa_cache[i].first = *(void **)wsp;
+      wa_cache[i].n--;
+      break;
+    }
+  }
+  chSysUnlock();
+
+  return wsp;
+}
+#endif /* CH_CFG_USE_WA_CACHE == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -85,10 +141,20 @@ thread_t *chThdCreateFromHeap(memory_heap_t *heapp, size_t size,
   thread_t *tp;
   void *wsp;
 
+#if CH_CFG_USE_WA_CACHE == TRUE
+  wsp = dyn_wa_try_alloc(size);
+  if (wsp == NULL) {
+    wsp = chHeapAllocAligned(heapp, size, PORT_WORKING_AREA_ALIGN);
+  }
+  if (wsp == NULL) {
+    return NULL;
+  }
+#else
   wsp = chHeapAllocAligned(heapp, size, PORT_WORKING_AREA_ALIGN);
   if (wsp == NULL) {
     return NULL;
   }
+#endif
 
   thread_descriptor_t td = {
     name,
@@ -113,6 +179,76 @@ thread_t *chThdCreateFromHeap(memory_heap_t *heapp, size_t size,
 
   return tp;
 }
+#if (CH_CFG_USE_WA_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns a working area to the cache or to the heap.
+ * @details The area is parked in its size class when one is available
+ *          and not full, it is returned to the heap otherwise. Classes
+ *          are claimed by the first released area of a new size.
+ * @note    This function is not meant for use in application code, it is
+ *          invoked by the thread release path.
+ *
+ * @param[in] wa        pointer to the working area
+ *
+ * @notapi
+ */
+void _dyn_wa_free(void *wa) {
+  size_t size = chHeapGetSize(wa);
+  unsigned i;
+
+  chSysLock();
+  for (i = 0U; i < (unsigned)CH_CFG_WA_CACHE_CLASSES; i++) {
+    if ((wa_cache[i].size == size) || (wa_cache[i].size == (size_t)0)) {
+      if (wa_cache[i].n < (ucnt_t)CH_CFG_WA_CACHE_DEPTH) {
+        wa_cache[i].size  = size;
+        *(void **)wa      = wa_cache[i].first;
+        wa_cache[i].first = wa;
+        wa_cache[i].n++;
+        chSysUnlock();
+
+        return;
+      }
+      break;
+    }
+  }
+  chSysUnlock();
+
+  chHeapFree(wa);
+}
+
+/**
+ * @brief   Releases all the cached working areas to the heap.
+ * @details Meant to be invoked under memory pressure, the classes are
+ *          reset so they can adapt to new sizes.
+ *
+ * @api
+ */
+void chThdWACacheTrim(void) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_WA_CACHE_CLASSES; i++) {
+    void *wsp;
+
+    do {
+      chSysLock();
+      wsp = wa_cache[i].first;
+      if (wsp != NULL) {
+        wa_cache[i].first = *(void **)wsp;
+        wa_cache[i].n--;
+      }
+      else {
+        wa_cache[i].size = (size_t)0;
+      }
+      chSysUnlock();
+
+      if (wsp != NULL) {
+        chHeapFree(wsp);
+      }
+    } while (wsp != NULL);
+  }
+}
+#endif /* CH_CFG_USE_WA_CACHE == TRUE */
+
 #endif /* CH_CFG_USE_HEAP == TRUE */
 
 #if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
@@ -108,12 +108,32 @@ void chEvtRegisterMaskWithFlags(event_source_t *esp,
   chDbgCheck((esp != NULL) && (elp != NULL));
 
   chSysLock();
+#if CH_CFG_USE_EVENTS_PRIORITY == TRUE
+  {
+    event_listener_t *p = (event_listener_t *)esp;
+
+    /* Keeping the list ordered by descending listener priority so that
+       broadcasts signal the highest priority listeners first.*/
+    /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
+    while ((p->next != (event_listener_t *)esp) &&
+           (p->next->listener->prio >= currp->prio)) {
+    /*lint -restore*/
+      p = p->next;
+    }
+    elp->next   = p->next;
+    p->next     = elp;
+  }
+#else
   elp->next     = esp->next;
   esp->next     = elp;
+#endif
   elp->listener = currp;
   elp->events   = events;
   elp->flags    = (eventflags_t)0;
   elp->wflags   = wflags;
+#if CH_DBG_EVENTS_COALESCING == TRUE
+  elp->coalesced = (ucnt_t)0;
+#endif
   chSysUnlock();
 }
 
@@ -237,6 +257,11 @@ void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags) {
        source does not emit any flag.*/
     if ((flags == (eventflags_t)0) ||
         ((elp->flags & elp->wflags) != (eventflags_t)0)) {
+#if CH_DBG_EVENTS_COALESCING == TRUE
+      if ((elp->listener->epending & elp->events) == elp->events) {
+        elp->coalesced++;
+      }
+#endif
       chEvtSignalI(elp->listener, elp->events);
     }
     elp = elp->next;
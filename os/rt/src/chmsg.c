@@ -92,6 +92,11 @@ msg_t chMsgSend(thread_t *tp, msg_t msg) {
   chSysLock();
   ctp->u.sentmsg = msg;
   msg_insert(ctp, &tp->msgqueue);
+#if CH_CFG_USE_MESSAGES_INHERITANCE == TRUE
+  /* The server thread inherits the client priority, the boost follows
+     the thread-mutex dependencies.*/
+  chMtxPropagatePriorityS(tp, ctp->prio);
+#endif
   if (tp->state == CH_STATE_WTMSG) {
     (void) chSchReadyI(tp);
   }
@@ -102,6 +107,32 @@ msg_t chMsgSend(thread_t *tp, msg_t msg) {
   return msg;
 }
 
+/**
+ * @brief   Sends a message carrying a view on a data buffer.
+ * @details The receiver gains direct access to the specified buffer through
+ *          @p chMsgGetBuffer() for the duration of the rendezvous, no data
+ *          is copied and no intermediate allocation is performed. The buffer
+ *          descriptor is built on the sender stack which is frozen until the
+ *          receiver executes a @p chMsgRelease().
+ *
+ * @param[in] tp        the pointer to the thread
+ * @param[in] bufp      pointer to the buffer to be made accessible
+ * @param[in] size      size of the buffer in bytes
+ * @return              The answer message from @p chMsgRelease().
+ *
+ * @api
+ */
+msg_t chMsgSendWithBuffer(thread_t *tp, void *bufp, size_t size) {
+  msg_buffer_t mb;
+
+  chDbgCheck((bufp != NULL) && (size > (size_t)0));
+
+  mb.buf  = bufp;
+  mb.size = size;
+
+  return chMsgSend(tp, (msg_t)&mb);
+}
+
 /**
  * @brief   Suspends the thread and waits for an incoming message.
  * @post    After receiving a message the function @p chMsgGet() must be
@@ -147,9 +178,52 @@ void chMsgRelease(thread_t *tp, msg_t msg) {
   chSysLock();
   chDbgAssert(tp->state == CH_STATE_SNDMSG, "invalid state");
   chMsgReleaseS(tp, msg);
+#if CH_CFG_USE_MESSAGES_INHERITANCE == TRUE
+  /* The priority of this thread could have been lowered by the release,
+     a reschedule towards other ready threads could be needed.*/
+  chSchRescheduleS();
+#endif
   chSysUnlock();
 }
 
+#if (CH_CFG_USE_MESSAGES_INHERITANCE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Releases the thread waiting on top of the messages queue.
+ * @details The inherited priority of the releasing thread is recomputed
+ *          from its base priority, the mutexes still owned and the
+ *          clients still queued, then the client is awakened.
+ * @pre     Invoke this function only after a message has been received
+ *          using @p chMsgWait().
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] msg       message to be returned to the sender
+ *
+ * @sclass
+ */
+void chMsgReleaseS(thread_t *tp, msg_t msg) {
+  thread_t *ctp = currp;
+  tprio_t newprio = ctp->realprio;
+  mutex_t *lmp = ctp->mtxlist;
+
+  chDbgCheckClassS();
+
+  /* Recalculates the optimal thread priority by scanning the owned
+     mutexes list and the queued clients.*/
+  while (lmp != NULL) {
+    if (chMtxQueueNotEmptyS(lmp) && (lmp->queue.next->prio > newprio)) {
+      newprio = lmp->queue.next->prio;
+    }
+    lmp = lmp->next;
+  }
+  if (chMsgIsPendingI(ctp) && (ctp->msgqueue.next->prio > newprio)) {
+    newprio = ctp->msgqueue.next->prio;
+  }
+  ctp->prio = newprio;
+
+  chSchWakeupS(tp, msg);
+}
+#endif /* CH_CFG_USE_MESSAGES_INHERITANCE == TRUE */
+
 #endif /* CH_CFG_USE_MESSAGES == TRUE */
 
 /** @} */
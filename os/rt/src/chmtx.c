@@ -93,6 +93,69 @@
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
+/**
+ * @brief   Propagates a priority boost through the dependency chains.
+ * @details The priority of the specified thread is raised, if lower, to
+ *          the specified value, following the thread-mutex dependencies
+ *          so that all the affected threads are boosted as well. It is
+ *          the core of the priority inheritance protocol, also used by
+ *          the messages subsystem when client-to-server inheritance is
+ *          enabled.
+ *
+ * @param[in] tp        pointer to the thread to be boosted
+ * @param[in] newprio   the priority to be propagated
+ *
+ * @sclass
+ */
+void chMtxPropagatePriorityS(thread_t *tp, tprio_t newprio) {
+
+  while (tp->prio < newprio) {
+    /* Make priority of thread tp match the propagated priority.*/
+    tp->prio = newprio;
+
+    /* The following states need priority queues reordering.*/
+    switch (tp->state) {
+    case CH_STATE_WTMTX:
+      /* Re-enqueues the mutex owner with its new priority.*/
+      queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
+      tp = tp->u.wtmtxp->owner;
+      /*lint -e{9042} [16.1] Continues the while.*/
+      continue;
+#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
+    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
+     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)) ||                           \
+    ((CH_CFG_USE_MESSAGES == TRUE) &&                                       \
+     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE))
+#if CH_CFG_USE_CONDVARS == TRUE
+    case CH_STATE_WTCOND:
+#endif
+#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
+    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
+    case CH_STATE_WTSEM:
+#endif
+#if (CH_CFG_USE_MESSAGES == TRUE) && (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
+    case CH_STATE_SNDMSGQ:
+#endif
+      /* Re-enqueues tp with its new priority on the queue.*/
+      queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
+      break;
+#endif
+    case CH_STATE_READY:
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+      /* Prevents an assertion in chSchReadyI().*/
+      tp->state = CH_STATE_CURRENT;
+#endif
+      /* Re-enqueues tp with its new priority on the ready list.*/
+      (void) chSchReadyI(sch_ready_dequeue(tp));
+      break;
+    default:
+      /* Nothing to do for other states.*/
+      break;
+    }
+    break;
+  }
+}
+
 /**
  * @brief   Initializes s @p mutex_t structure.
  *
@@ -115,6 +178,9 @@ void chMtxObjectInit(mutex_t *mp) {
  * @brief   Locks the specified mutex.
  * @post    The mutex is locked and inserted in the per-thread stack of owned
  *          mutexes.
+ * @note    If the option @p CH_CFG_MTX_ADAPTIVE_SPIN is enabled then, on
+ *          contention, up to @p CH_CFG_MTX_SPIN_COUNT polling attempts are
+ *          performed before suspending the calling thread.
  *
  * @param[in] mp        pointer to the @p mutex_t structure
  *
@@ -122,6 +188,20 @@ void chMtxObjectInit(mutex_t *mp) {
  */
 void chMtxLock(mutex_t *mp) {
 
+#if CH_CFG_MTX_ADAPTIVE_SPIN == TRUE
+  cnt_t n = (cnt_t)CH_CFG_MTX_SPIN_COUNT;
+
+  do {
+    chSysLock();
+    if (chMtxTryLockS(mp)) {
+      chSysUnlock();
+      return;
+    }
+    chSysUnlock();
+    n--;
+  } while (n > (cnt_t)0);
+#endif
+
   chSysLock();
   chMtxLockS(mp);
   chSysUnlock();
@@ -158,55 +238,7 @@ void chMtxLockS(mutex_t *mp) {
       /* Priority inheritance protocol; explores the thread-mutex dependencies
          boosting the priority of all the affected threads to equal the
          priority of the running thread requesting the mutex.*/
-      thread_t *tp = mp->owner;
-
-      /* Does the running thread have higher priority than the mutex
-         owning thread? */
-      while (tp->prio < ctp->prio) {
-        /* Make priority of thread tp match the running thread's priority.*/
-        tp->prio = ctp->prio;
-
-        /* The following states need priority queues reordering.*/
-        switch (tp->state) {
-        case CH_STATE_WTMTX:
-          /* Re-enqueues the mutex owner with its new priority.*/
-          queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
-          tp = tp->u.wtmtxp->owner;
-          /*lint -e{9042} [16.1] Continues the while.*/
-          continue;
-#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
-    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
-     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)) ||                           \
-    ((CH_CFG_USE_MESSAGES == TRUE) &&                                       \
-     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE))
-#if CH_CFG_USE_CONDVARS == TRUE
-        case CH_STATE_WTCOND:
-#endif
-#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
-    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
-        case CH_STATE_WTSEM:
-#endif
-#if (CH_CFG_USE_MESSAGES == TRUE) && (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
-        case CH_STATE_SNDMSGQ:
-#endif
-          /* Re-enqueues tp with its new priority on the queue.*/
-          queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
-          break;
-#endif
-        case CH_STATE_READY:
-#if CH_DBG_ENABLE_ASSERTS == TRUE
-          /* Prevents an assertion in chSchReadyI().*/
-          tp->state = CH_STATE_CURRENT;
-#endif
-          /* Re-enqueues tp with its new priority on the ready list.*/
-          (void) chSchReadyI(queue_dequeue(tp));
-          break;
-        default:
-          /* Nothing to do for other states.*/
-          break;
-        }
-        break;
-      }
+      chMtxPropagatePriorityS(mp->owner, ctp->prio);
 
       /* Sleep on the mutex.*/
       queue_prio_insert(ctp, &mp->queue);
@@ -63,6 +63,15 @@
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Thread identifiers table.
+ * @details Each slot points to the thread owning the identifier equal to
+ *          the slot index, @p NULL slots are free.
+ */
+static thread_t *reg_id_table[CH_CFG_REGISTRY_IDS_MAX];
+#endif
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
@@ -233,6 +242,70 @@ thread_t *chRegFindThreadByPointer(thread_t *tp) {
   return NULL;
 }
 
+/**
+ * @brief   Copies the state of all registered threads in a single pass.
+ * @details Name, priority, state and, if enabled, the consumed cycles of
+ *          each registered thread are copied into the provided array
+ *          without releasing the critical zone between threads, the
+ *          resulting snapshot is consistent. Unlike the iteration with
+ *          @p chRegFirstThread() and @p chRegNextThread() no references
+ *          are taken so the walk has no side effects on the threads.
+ * @note    The critical zone duration is proportional to the number of
+ *          registered threads.
+ *
+ * @param[out] tsp      pointer to an array of @p thread_snapshot_t
+ * @param[in] n         number of elements in the array
+ * @return              The number of registered threads, can be greater
+ *                      than @p n if the array could not hold all threads.
+ *
+ * @iclass
+ */
+size_t chRegSnapshotThreadsI(thread_snapshot_t *tsp, size_t n) {
+  thread_t *tp;
+  size_t cnt = (size_t)0;
+
+  chDbgCheckClassI();
+  chDbgCheck((tsp != NULL) || (n == (size_t)0));
+
+  tp = ch.rlist.newer;
+  /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
+  while (tp != (thread_t *)&ch.rlist) {
+  /*lint -restore*/
+    if (cnt < n) {
+      tsp[cnt].name   = tp->name;
+      tsp[cnt].prio   = tp->prio;
+      tsp[cnt].state  = tp->state;
+#if CH_CFG_USE_THREAD_CYCLES == TRUE
+      tsp[cnt].cycles = tp->cycles;
+#endif
+    }
+    cnt++;
+    tp = tp->newer;
+  }
+
+  return cnt;
+}
+
+/**
+ * @brief   Copies the state of all registered threads in a single pass.
+ *
+ * @param[out] tsp      pointer to an array of @p thread_snapshot_t
+ * @param[in] n         number of elements in the array
+ * @return              The number of registered threads, can be greater
+ *                      than @p n if the array could not hold all threads.
+ *
+ * @api
+ */
+size_t chRegSnapshotThreads(thread_snapshot_t *tsp, size_t n) {
+  size_t cnt;
+
+  chSysLock();
+  cnt = chRegSnapshotThreadsI(tsp, n);
+  chSysUnlock();
+
+  return cnt;
+}
+
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE) ||  \
     defined(__DOXYGEN__)
 /**
@@ -263,6 +336,136 @@ thread_t *chRegFindThreadByWorkingArea(stkalign_t *wa) {
 }
 #endif
 
+#if (CH_CFG_USE_REGISTRY_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Assigns a free identifier to a thread.
+ * @details The lowest free identifier is assigned, with a deterministic
+ *          creation order the assignment is stable across reboots. The
+ *          hash of the thread name is cached as well.
+ * @note    This function is not meant for use in application code.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+void _reg_assign_id(thread_t *tp) {
+  unsigned i;
+
+  tp->namehash = chRegHashName(tp->name);
+  for (i = 0U; i < (unsigned)CH_CFG_REGISTRY_IDS_MAX; i++) {
+    if (reg_id_table[i] == NULL) {
+      reg_id_table[i] = tp;
+      tp->id = (uint16_t)i;
+      return;
+    }
+  }
+  tp->id = CH_THREAD_ID_INVALID;
+}
+
+/**
+ * @brief   Releases the identifier owned by a thread.
+ * @note    This function is not meant for use in application code.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+void _reg_release_id(thread_t *tp) {
+
+  if (tp->id != CH_THREAD_ID_INVALID) {
+    reg_id_table[tp->id] = NULL;
+    tp->id = CH_THREAD_ID_INVALID;
+  }
+}
+
+/**
+ * @brief   Hashes a thread name.
+ * @details FNV-1a over the name characters, the same hash can be
+ *          computed offline by host tools from the known thread names,
+ *          at build time for string literals.
+ *
+ * @param[in] name      thread name as a zero terminated string or @p NULL
+ * @return              The name hash, zero for a @p NULL name.
+ *
+ * @api
+ */
+uint32_t chRegHashName(const char *name) {
+  uint32_t h;
+
+  if (name == NULL) {
+    return 0U;
+  }
+
+  h = 0x811C9DC5U;
+  while (*name != '\0') {
+    h = (h ^ (uint32_t)(uint8_t)*name) * 0x01000193U;
+    name++;
+  }
+
+  return h;
+}
+
+/**
+ * @brief   Retrieves a thread by identifier, in constant time.
+ * @note    The reference counter of the found thread is increased by one
+ *          so it cannot be disposed incidentally after the pointer has
+ *          been returned.
+ *
+ * @param[in] id        thread identifier
+ * @return              A pointer to the found thread.
+ * @retval NULL         if no thread owns the identifier.
+ *
+ * @api
+ */
+thread_t *chRegFindThreadByID(uint16_t id) {
+  thread_t *tp;
+
+  if (id >= (uint16_t)CH_CFG_REGISTRY_IDS_MAX) {
+    return NULL;
+  }
+
+  chSysLock();
+  tp = reg_id_table[id];
+#if CH_CFG_USE_DYNAMIC == TRUE
+  if (tp != NULL) {
+    tp->refs++;
+  }
+#endif
+  chSysUnlock();
+
+  return tp;
+}
+
+/**
+ * @brief   Retrieves a thread by name hash.
+ * @details A single registry pass comparing the cached hashes, no string
+ *          comparison is performed.
+ * @note    The reference counter of the found thread is increased by one
+ *          so it cannot be disposed incidentally after the pointer has
+ *          been returned.
+ *
+ * @param[in] hash      hash of the thread name, see @p chRegHashName()
+ * @return              A pointer to the found thread.
+ * @retval NULL         if no thread matches the hash.
+ *
+ * @api
+ */
+thread_t *chRegFindThreadByHash(uint32_t hash) {
+  thread_t *ctp;
+
+  /* Scanning registry.*/
+  ctp = chRegFirstThread();
+  do {
+    if (ctp->namehash == hash) {
+      return ctp;
+    }
+    ctp = chRegNextThread(ctp);
+  } while (ctp != NULL);
+
+  return NULL;
+}
+#endif /* CH_CFG_USE_REGISTRY_IDS == TRUE */
+
 #endif /* CH_CFG_USE_REGISTRY == TRUE */
 
 /** @} */
@@ -0,0 +1,392 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chrwlock.c
+ * @brief   Readers-writer locks code.
+ *
+ * @addtogroup rwlocks
+ * @details This module implements a readers-writer lock, a synchronization
+ *          object allowing any number of concurrent readers or a single
+ *          writer inside the protected zone.
+ *          <h2>Operation mode</h2>
+ *          The lock state is kept in a single counter so the uncontended
+ *          read path only costs a counter adjustment inside the critical
+ *          zone. Writers have precedence, new readers are held back while
+ *          a writer is waiting so write access latency stays bounded on
+ *          read-mostly data.<br>
+ *          A blocked writer transmits its priority to the threads currently
+ *          holding the lock: to the owning writer, following the thread-mutex
+ *          dependencies as the mutexes subsystem does, or to the active
+ *          readers. Readers are tracked for this purpose up to
+ *          @p CH_CFG_RWLOCK_TRACKED_READERS, readers in excess hold the lock
+ *          normally but do not receive the boost.
+ * @pre     In order to use the readers-writer lock APIs the
+ *          @p CH_CFG_USE_RWLOCKS option must be enabled in @p chconf.h.
+ * @note    Read locks cannot be acquired recursively while a writer is
+ *          waiting, the second acquisition would deadlock against the
+ *          writer precedence.
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*
+ * Boosts the priority of the specified thread following the thread-mutex
+ * dependencies, same protocol implemented in chMtxLockS().
+ */
+static void rw_boost(thread_t *tp, tprio_t prio) {
+
+  while (tp->prio < prio) {
+    tp->prio = prio;
+
+    switch (tp->state) {
+    case CH_STATE_WTMTX:
+      /* Re-enqueues the thread with its new priority on the mutex queue
+         then boosts the mutex owner too.*/
+      queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
+      tp = tp->u.wtmtxp->owner;
+      /*lint -e{9042} [16.1] Continues the while.*/
+      continue;
+#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
+    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
+     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)) ||                           \
+    ((CH_CFG_USE_MESSAGES == TRUE) &&                                       \
+     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE))
+#if CH_CFG_USE_CONDVARS == TRUE
+    case CH_STATE_WTCOND:
+#endif
+#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
+    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
+    case CH_STATE_WTSEM:
+#endif
+#if (CH_CFG_USE_MESSAGES == TRUE) && (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
+    case CH_STATE_SNDMSGQ:
+#endif
+      /* Re-enqueues the thread with its new priority on the queue.*/
+      queue_prio_insert(queue_dequeue(tp), &tp->u.wtmtxp->queue);
+      break;
+#endif
+    case CH_STATE_READY:
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+      /* Prevents an assertion in chSchReadyI().*/
+      tp->state = CH_STATE_CURRENT;
+#endif
+      /* Re-enqueues the thread with its new priority on the ready list.*/
+      (void) chSchReadyI(sch_ready_dequeue(tp));
+      break;
+    default:
+      /* Nothing to do for other states.*/
+      break;
+    }
+    break;
+  }
+}
+
+/*
+ * Restores the priority of the current thread, the optimal priority is
+ * recalculated by scanning the owned mutexes list as chMtxUnlockS() does.
+ */
+static void rw_restore_prio(thread_t *ctp) {
+  tprio_t newprio = ctp->realprio;
+  mutex_t *lmp = ctp->mtxlist;
+
+  while (lmp != NULL) {
+    if (queue_notempty(&lmp->queue) && (lmp->queue.next->prio > newprio)) {
+      newprio = lmp->queue.next->prio;
+    }
+    lmp = lmp->next;
+  }
+  ctp->prio = newprio;
+}
+
+/*
+ * Puts the current thread to sleep on the specified lock queue.
+ */
+static void rw_sleep(rwlock_t *rwp, threads_queue_t *tqp) {
+
+  queue_prio_insert(currp, tqp);
+  currp->u.wtobjp = rwp;
+  chSchGoSleepS(CH_STATE_QUEUED);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p rwlock_t structure.
+ *
+ * @param[out] rwp      pointer to a @p rwlock_t structure
+ *
+ * @init
+ */
+void chRWObjectInit(rwlock_t *rwp) {
+  unsigned i;
+
+  chDbgCheck(rwp != NULL);
+
+  rwp->cnt    = (cnt_t)0;
+  rwp->writer = NULL;
+  queue_init(&rwp->rqueue);
+  queue_init(&rwp->wqueue);
+  for (i = 0U; i < (unsigned)CH_CFG_RWLOCK_TRACKED_READERS; i++) {
+    rwp->readers[i] = NULL;
+  }
+}
+
+/**
+ * @brief   Acquires the lock for reading.
+ * @details Multiple readers can own the lock concurrently, the calling
+ *          thread is suspended while a writer owns the lock or is waiting
+ *          for it.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWReadLock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWReadLockS(rwp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Acquires the lock for reading.
+ * @details Multiple readers can own the lock concurrently, the calling
+ *          thread is suspended while a writer owns the lock or is waiting
+ *          for it.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWReadLockS(rwlock_t *rwp) {
+  unsigned i;
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  while ((rwp->cnt < (cnt_t)0) || queue_notempty(&rwp->wqueue)) {
+    /* A blocked reader transmits its priority to the owning writer,
+       if any.*/
+    if (rwp->cnt < (cnt_t)0) {
+      rw_boost(rwp->writer, currp->prio);
+    }
+    rw_sleep(rwp, &rwp->rqueue);
+  }
+  rwp->cnt++;
+
+  /* Registering in a free tracking slot, if any, for priority
+     inheritance.*/
+  for (i = 0U; i < (unsigned)CH_CFG_RWLOCK_TRACKED_READERS; i++) {
+    if (rwp->readers[i] == NULL) {
+      rwp->readers[i] = currp;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief   Releases the lock previously acquired for reading.
+ * @pre     The invoking thread <b>must</b> own a read lock on the object.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWReadUnlock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWReadUnlockS(rwp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Releases the lock previously acquired for reading.
+ * @pre     The invoking thread <b>must</b> own a read lock on the object.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWReadUnlockS(rwlock_t *rwp) {
+  thread_t *ctp = currp;
+  unsigned i;
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+  chDbgAssert(rwp->cnt > (cnt_t)0, "not read-locked");
+
+  /* Releasing the tracking slot, if one was taken.*/
+  for (i = 0U; i < (unsigned)CH_CFG_RWLOCK_TRACKED_READERS; i++) {
+    if (rwp->readers[i] == ctp) {
+      rwp->readers[i] = NULL;
+      break;
+    }
+  }
+
+  /* Restoring the priority in case a boost was received from a blocked
+     writer.*/
+  if (ctp->prio != ctp->realprio) {
+    rw_restore_prio(ctp);
+  }
+
+  rwp->cnt--;
+  if ((rwp->cnt == (cnt_t)0) && queue_notempty(&rwp->wqueue)) {
+    /* The last reader left, the first waiting writer is released.*/
+    chThdDequeueNextI(&rwp->wqueue, MSG_OK);
+  }
+}
+
+/**
+ * @brief   Acquires the lock for writing.
+ * @details Only one writer at a time can own the lock, the calling thread
+ *          is suspended while the lock is owned by a writer or by readers.
+ *          Writers have precedence over new readers.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWWriteLock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWWriteLockS(rwp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Acquires the lock for writing.
+ * @details Only one writer at a time can own the lock, the calling thread
+ *          is suspended while the lock is owned by a writer or by readers.
+ *          Writers have precedence over new readers.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWWriteLockS(rwlock_t *rwp) {
+  thread_t *ctp = currp;
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  while (rwp->cnt != (cnt_t)0) {
+    /* Transmitting the priority to the threads currently holding the
+       lock.*/
+    if (rwp->cnt < (cnt_t)0) {
+      rw_boost(rwp->writer, ctp->prio);
+    }
+    else {
+      unsigned i;
+
+      for (i = 0U; i < (unsigned)CH_CFG_RWLOCK_TRACKED_READERS; i++) {
+        if (rwp->readers[i] != NULL) {
+          rw_boost(rwp->readers[i], ctp->prio);
+        }
+      }
+    }
+    rw_sleep(rwp, &rwp->wqueue);
+  }
+  rwp->cnt    = (cnt_t)-1;
+  rwp->writer = ctp;
+}
+
+/**
+ * @brief   Releases the lock previously acquired for writing.
+ * @pre     The invoking thread <b>must</b> own a write lock on the object.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWWriteUnlock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWWriteUnlockS(rwp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Releases the lock previously acquired for writing.
+ * @pre     The invoking thread <b>must</b> own a write lock on the object.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel.
+ *
+ * @param[in] rwp       pointer to a @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWWriteUnlockS(rwlock_t *rwp) {
+  thread_t *ctp = currp;
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+  chDbgAssert((rwp->cnt == (cnt_t)-1) && (rwp->writer == ctp),
+              "not write-locked");
+
+  /* Restoring the priority in case a boost was received from a blocked
+     writer.*/
+  if (ctp->prio != ctp->realprio) {
+    rw_restore_prio(ctp);
+  }
+
+  rwp->cnt    = (cnt_t)0;
+  rwp->writer = NULL;
+  if (queue_notempty(&rwp->wqueue)) {
+    /* Writers precedence, the next waiting writer is released.*/
+    chThdDequeueNextI(&rwp->wqueue, MSG_OK);
+  }
+  else {
+    /* All the waiting readers are released at once.*/
+    chThdDequeueAllI(&rwp->rqueue, MSG_OK);
+  }
+}
+
+#endif /* CH_CFG_USE_RWLOCKS == TRUE */
+
+/** @} */
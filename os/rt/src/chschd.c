@@ -32,6 +32,17 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if CH_CFG_USE_IDLE_CYCLES == TRUE
+#define IDLE_LEDGER_ENTER()                                                 \
+  (ch.idle_start = chSysGetRealtimeCounterX())
+#define IDLE_LEDGER_LEAVE()                                                 \
+  (ch.idle_cycles += (rttime_t)(rtcnt_t)(chSysGetRealtimeCounterX() -       \
+                                         ch.idle_start))
+#else
+#define IDLE_LEDGER_ENTER()
+#define IDLE_LEDGER_LEAVE()
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -66,10 +77,28 @@ void _scheduler_init(void) {
 
   queue_init(&ch.rlist.queue);
   ch.rlist.prio = NOPRIO;
+#if CH_CFG_USE_DEFERRED_READY == TRUE
+  ch.rlist.dfrlist = NULL;
+#endif
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  {
+    unsigned i;
+
+    for (i = 0U; i < CH_SCH_PRIO_BMAP_WORDS; i++) {
+      ch.rlist.prio_bmap[i] = (uint32_t)0;
+    }
+    for (i = 0U; i < CH_SCH_PRIO_LEVELS; i++) {
+      queue_init(&ch.rlist.fifos[i]);
+    }
+  }
+#endif
 #if CH_CFG_USE_REGISTRY == TRUE
   ch.rlist.newer = (thread_t *)&ch.rlist;
   ch.rlist.older = (thread_t *)&ch.rlist;
 #endif
+#if CH_CFG_USE_IDLE_CYCLES == TRUE
+  ch.idle_cycles = (rttime_t)0;
+#endif
 }
 
 #if (CH_CFG_OPTIMIZE_SPEED == FALSE) || defined(__DOXYGEN__)
@@ -216,7 +245,9 @@ thread_t *list_remove(threads_list_t *tlp) {
  * @iclass
  */
 thread_t *chSchReadyI(thread_t *tp) {
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == FALSE
   thread_t *cp;
+#endif
 
   chDbgCheckClassI();
   chDbgCheck(tp != NULL);
@@ -225,15 +256,30 @@ thread_t *chSchReadyI(thread_t *tp) {
               "invalid state");
 
   tp->state = CH_STATE_READY;
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  /* Constant-time insertion at the tail of the priority FIFO.*/
+  queue_insert(tp, &ch.rlist.fifos[tp->prio]);
+  prio_bmap_set(tp->prio);
+#else
   cp = (thread_t *)&ch.rlist.queue;
+#if CH_CFG_USE_EDF == TRUE
+  do {
+    cp = cp->queue.next;
+  } while ((cp->prio > tp->prio) ||
+           ((cp->prio == tp->prio) &&
+            ((tp->prio != EDFPRIO) ||
+             !sch_edf_is_earlier(tp->deadline, cp->deadline))));
+#else
   do {
     cp = cp->queue.next;
   } while (cp->prio >= tp->prio);
+#endif
   /* Insertion on prev.*/
   tp->queue.next             = cp;
   tp->queue.prev             = cp->queue.prev;
   tp->queue.prev->queue.next = tp;
   cp->queue.prev             = tp;
+#endif
 
   return tp;
 }
@@ -255,7 +301,9 @@ thread_t *chSchReadyI(thread_t *tp) {
  * @iclass
  */
 thread_t *chSchReadyAheadI(thread_t *tp) {
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == FALSE
   thread_t *cp;
+#endif
 
   chDbgCheckClassI();
   chDbgCheck(tp != NULL);
@@ -264,19 +312,134 @@ thread_t *chSchReadyAheadI(thread_t *tp) {
               "invalid state");
 
   tp->state = CH_STATE_READY;
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  {
+    /* Constant-time insertion at the head of the priority FIFO.*/
+    threads_queue_t *tqp = &ch.rlist.fifos[tp->prio];
+
+    tp->queue.prev             = (thread_t *)tqp;
+    tp->queue.next             = tqp->next;
+    tp->queue.next->queue.prev = tp;
+    tqp->next                  = tp;
+    prio_bmap_set(tp->prio);
+  }
+#else
   cp = (thread_t *)&ch.rlist.queue;
+#if CH_CFG_USE_EDF == TRUE
+  do {
+    cp = cp->queue.next;
+  } while ((cp->prio > tp->prio) ||
+           ((cp->prio == tp->prio) && (tp->prio == EDFPRIO) &&
+            sch_edf_is_earlier(cp->deadline, tp->deadline)));
+#else
   do {
     cp = cp->queue.next;
   } while (cp->prio > tp->prio);
+#endif
   /* Insertion on prev.*/
   tp->queue.next             = cp;
   tp->queue.prev             = cp->queue.prev;
   tp->queue.prev->queue.next = tp;
   cp->queue.prev             = tp;
+#endif
 
   return tp;
 }
 
+#if (CH_CFG_USE_DEFERRED_READY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Posts a deferred wakeup for a thread without taking the kernel
+ *          lock.
+ * @details The thread is pushed on a lock-free list using an atomic
+ *          compare-and-swap loop, the actual state transition is performed
+ *          by the scheduler when the list is drained on a reschedule path,
+ *          so high-rate interrupt sources do not serialize on the kernel
+ *          critical zone.
+ * @pre     The thread must be suspended on a @p thread_reference_t and the
+ *          invoking interrupt source must be the only wakeup source for the
+ *          thread, at most one deferred wakeup can be pending for a thread.
+ * @note    This function can be invoked from interrupt handlers without
+ *          calling @p chSysLockFromISR() first.
+ *
+ * @param[in] tp        the thread to be made ready
+ * @param[in] msg       the wakeup message
+ *
+ * @xclass
+ */
+void chSchDeferReadyX(thread_t *tp, msg_t msg) {
+  thread_t *old;
+
+  chDbgCheck(tp != NULL);
+
+  tp->dfrmsg = msg;
+  do {
+    old = ch.rlist.dfrlist;
+    tp->dfrnext = old;
+  } while (!__atomic_compare_exchange_n(&ch.rlist.dfrlist, &old, tp,
+                                        false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief   Drains the deferred ready list.
+ * @details All threads with a pending deferred wakeup are resumed on the
+ *          ready list. This function is invoked by the scheduler on the
+ *          reschedule paths, it does not need to be called explicitly.
+ * @post    This function does not reschedule.
+ *
+ * @iclass
+ */
+void chSchDrainDeferredI(void) {
+  thread_t *tp;
+
+  chDbgCheckClassI();
+
+  tp = __atomic_exchange_n(&ch.rlist.dfrlist, NULL, __ATOMIC_ACQUIRE);
+  while (tp != NULL) {
+    thread_t *ntp = tp->dfrnext;
+
+    tp->dfrnext = NULL;
+
+    /* If the thread has been awakened by another source in the meantime,
+       a timeout for example, then the deferred wakeup is simply dropped.*/
+    if ((tp->state == CH_STATE_SUSPENDED) && (*tp->u.wttrp == tp)) {
+      *tp->u.wttrp = NULL;
+      tp->u.rdymsg = tp->dfrmsg;
+      (void) chSchReadyI(tp);
+    }
+
+    tp = ntp;
+  }
+}
+#endif /* CH_CFG_USE_DEFERRED_READY == TRUE */
+
+/**
+ * @brief   Wakes up all the threads waiting on a threads queue object.
+ * @details All the threads are dequeued and inserted in the ready list in
+ *          a single pass, the rescheduling evaluation is left to the caller
+ *          so that a fan-out wakeup pays it only once.
+ * @post    Always invoke @p chSchRescheduleS() before leaving the critical
+ *          zone for the first time after this call.
+ *
+ * @param[in] tqp       pointer to the threads queue object
+ * @param[in] msg       the wakeup message
+ *
+ * @iclass
+ */
+void chSchWakeupAllI(threads_queue_t *tqp, msg_t msg) {
+
+  chDbgCheckClassI();
+
+  while (queue_notempty(tqp)) {
+    thread_t *tp = queue_fifo_remove(tqp);
+
+    chDbgAssert(tp->state == CH_STATE_QUEUED, "invalid state");
+
+    tp->u.rdymsg = msg;
+    (void) chSchReadyI(tp);
+  }
+}
+
 /**
  * @brief   Puts the current thread to sleep into the specified state.
  * @details The thread goes into a sleeping state. The possible
@@ -301,11 +464,12 @@ void chSchGoSleepS(tstate_t newstate) {
 #endif
 
   /* Next thread in ready list becomes current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = sch_pick_first();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-enter hook.*/
   if (currp->prio == IDLEPRIO) {
+    IDLE_LEDGER_ENTER();
     CH_CFG_IDLE_ENTER_HOOK();
   }
 
@@ -338,6 +502,11 @@ static void wakeup(void *p) {
     /* Falls through.*/
 #if (CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_CONDVARS_TIMEOUT == TRUE)
   case CH_STATE_WTCOND:
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  /* A thread can wait on a mutex with an armed timeout only as effect of
+     wait morphing.*/
+  case CH_STATE_WTMTX:
+#endif
 #endif
     /* States requiring dequeuing.*/
     (void) queue_dequeue(tp);
@@ -414,8 +583,7 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
 
   chDbgCheckClassS();
 
-  chDbgAssert((ch.rlist.queue.next == (thread_t *)&ch.rlist.queue) ||
-              (ch.rlist.current->prio >= ch.rlist.queue.next->prio),
+  chDbgAssert(ch.rlist.current->prio >= sch_firstprio(),
               "priority order violation");
 
   /* Storing the message to be retrieved by the target thread when it will
@@ -426,7 +594,11 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
      one then it is just inserted in the ready list else it made
      running immediately and the invoking thread goes in the ready
      list instead.*/
+#if CH_CFG_USE_EDF == TRUE
+  if (!sch_runs_before(ntp, otp)) {
+#else
   if (ntp->prio <= otp->prio) {
+#endif
     (void) chSchReadyI(ntp);
   }
   else {
@@ -434,6 +606,7 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
 
     /* Handling idle-leave hook.*/
     if (otp->prio == IDLEPRIO) {
+      IDLE_LEDGER_LEAVE();
       CH_CFG_IDLE_LEAVE_HOOK();
     }
 
@@ -457,6 +630,10 @@ void chSchRescheduleS(void) {
 
   chDbgCheckClassS();
 
+#if CH_CFG_USE_DEFERRED_READY == TRUE
+  chSchDrainDeferredI();
+#endif
+
   if (chSchIsRescRequiredI()) {
     chSchDoRescheduleAhead();
   }
@@ -477,8 +654,27 @@ void chSchRescheduleS(void) {
  * @special
  */
 bool chSchIsPreemptionRequired(void) {
-  tprio_t p1 = firstprio(&ch.rlist.queue);
-  tprio_t p2 = currp->prio;
+  tprio_t p1;
+  tprio_t p2;
+
+#if CH_CFG_USE_DEFERRED_READY == TRUE
+  /* Deferred wakeups posted by interrupt handlers are served before
+     evaluating the priorities.*/
+  chSchDrainDeferredI();
+#endif
+
+#if CH_CFG_USE_EDF == TRUE
+  /* When both the ready list head and the current thread are in the EDF
+     band the decision is taken on the deadlines, the round robin counter
+     is not relevant there.*/
+  if ((ch.rlist.queue.next->prio == EDFPRIO) && (currp->prio == EDFPRIO)) {
+    return sch_edf_is_earlier(ch.rlist.queue.next->deadline,
+                              currp->deadline);
+  }
+#endif
+
+  p1 = sch_firstprio();
+  p2 = currp->prio;
 
 #if CH_CFG_TIME_QUANTUM > 0
   /* If the running thread has not reached its time quantum, reschedule only
@@ -508,11 +704,12 @@ void chSchDoRescheduleBehind(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = sch_pick_first();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
   if (otp->prio == IDLEPRIO) {
+    IDLE_LEDGER_LEAVE();
     CH_CFG_IDLE_LEAVE_HOOK();
   }
 
@@ -541,11 +738,12 @@ void chSchDoRescheduleAhead(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = sch_pick_first();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
   if (otp->prio == IDLEPRIO) {
+    IDLE_LEDGER_LEAVE();
     CH_CFG_IDLE_LEAVE_HOOK();
   }
 
@@ -571,11 +769,12 @@ void chSchDoReschedule(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = sch_pick_first();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
   if (otp->prio == IDLEPRIO) {
+    IDLE_LEDGER_LEAVE();
     CH_CFG_IDLE_LEAVE_HOOK();
   }
 
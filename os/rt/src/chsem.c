@@ -75,10 +75,19 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
-#if CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE
-#define sem_insert(tp, qp) queue_prio_insert(tp, qp)
+#if CH_CFG_USE_SEMAPHORES_POLICY == TRUE
+#define sem_insert(tp, sp) do {                                             \
+  if ((sp)->prio) {                                                         \
+    queue_prio_insert(tp, &(sp)->queue);                                    \
+  }                                                                         \
+  else {                                                                    \
+    queue_insert(tp, &(sp)->queue);                                         \
+  }                                                                         \
+} while (false)
+#elif CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE
+#define sem_insert(tp, sp) queue_prio_insert(tp, &(sp)->queue)
 #else
-#define sem_insert(tp, qp) queue_insert(tp, qp)
+#define sem_insert(tp, sp) queue_insert(tp, &(sp)->queue)
 #endif
 
 /*===========================================================================*/
@@ -100,6 +109,9 @@ void chSemObjectInit(semaphore_t *sp, cnt_t n) {
 
   queue_init(&sp->queue);
   sp->cnt = n;
+#if CH_CFG_USE_SEMAPHORES_POLICY == TRUE
+  sp->prio = CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE;
+#endif
 }
 
 /**
@@ -204,7 +216,7 @@ msg_t chSemWaitS(semaphore_t *sp) {
 
   if (--sp->cnt < (cnt_t)0) {
     currp->u.wtsemp = sp;
-    sem_insert(currp, &sp->queue);
+    sem_insert(currp, sp);
     chSchGoSleepS(CH_STATE_WTSEM);
 
     return currp->u.rdymsg;
@@ -276,7 +288,7 @@ msg_t chSemWaitTimeoutS(semaphore_t *sp, sysinterval_t timeout) {
       return MSG_TIMEOUT;
     }
     currp->u.wtsemp = sp;
-    sem_insert(currp, &sp->queue);
+    sem_insert(currp, sp);
 
     return chSchGoSleepTimeoutS(CH_STATE_WTSEM, timeout);
   }
@@ -333,6 +345,26 @@ void chSemSignalI(semaphore_t *sp) {
   }
 }
 
+/**
+ * @brief   Performs multiple signal operations on a semaphore.
+ * @details The semaphore counter is incremented by @p n in a single
+ *          queue pass followed by a single reschedule, it is equivalent
+ *          to, and cheaper than, calling @p chSemSignal() in a loop.
+ *
+ * @param[in] sp        pointer to a @p semaphore_t structure
+ * @param[in] n         value to be added to the semaphore counter. The value
+ *                      must be positive.
+ *
+ * @api
+ */
+void chSemSignalN(semaphore_t *sp, cnt_t n) {
+
+  chSysLock();
+  chSemAddCounterI(sp, n);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
 /**
  * @brief   Adds the specified value to the semaphore counter.
  * @post    This function does not reschedule so a call to a rescheduling
@@ -392,7 +424,7 @@ msg_t chSemSignalWait(semaphore_t *sps, semaphore_t *spw) {
   }
   if (--spw->cnt < (cnt_t)0) {
     thread_t *ctp = currp;
-    sem_insert(ctp, &spw->queue);
+    sem_insert(ctp, spw);
     ctp->u.wtsemp = spw;
     chSchGoSleepS(CH_STATE_WTSEM);
     msg = ctp->u.rdymsg;
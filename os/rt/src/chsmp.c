@@ -0,0 +1,152 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chsmp.c
+ * @brief   Multi-core support code.
+ *
+ * @addtogroup smp
+ * @details Cross-core wakeup queues for asymmetric multi-processing
+ *          configurations.
+ *          <h2>Operation mode</h2>
+ *          Each core runs its own RT instance, threads belong to the core
+ *          they have been created on and are never migrated. A thread
+ *          waiting for a remote event suspends on a thread reference, the
+ *          remote core posts a wakeup request into the queue owned by the
+ *          target core then triggers an inter-processor interrupt. The
+ *          target core drains the queue from the IPI handler resuming the
+ *          referenced threads on its own ready list, so the two schedulers
+ *          never access each other's @p ch.rlist.
+ * @pre     In order to use the SMP queues the @p CH_CFG_USE_SMP option
+ *          must be enabled in @p chconf.h.
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_SMP == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a cross-core wakeup queue.
+ *
+ * @param[out] sqp      pointer to a @p smp_queue_t structure
+ * @param[in] buf       pointer to the queue buffer, it must be placed in
+ *                      memory shared by the cores
+ * @param[in] n         number of elements in the queue buffer, at least 2
+ *
+ * @init
+ */
+void chSMPQueueObjectInit(smp_queue_t *sqp, smp_wakeup_t *buf, size_t n) {
+
+  chDbgCheck((sqp != NULL) && (buf != NULL) && (n >= (size_t)2));
+
+  sqp->buffer = buf;
+  sqp->top    = &buf[n];
+  sqp->wrptr  = buf;
+  sqp->rdptr  = buf;
+}
+
+/**
+ * @brief   Posts a wakeup request for a thread running on another core.
+ * @details The request is appended to the queue owned by the target core.
+ *          The caller is responsible for triggering the IPI toward the
+ *          target core after this function returns @p true.
+ * @note    This function must be invoked from the producing core only.
+ *
+ * @param[in] sqp       pointer to a @p smp_queue_t structure
+ * @param[in] trp       pointer to the thread reference, located in shared
+ *                      memory, the remote thread is suspended on
+ * @param[in] msg       the wakeup message
+ * @return              The operation status.
+ * @retval true         if the request has been enqueued.
+ * @retval false        if the queue is full.
+ *
+ * @iclass
+ */
+bool chSMPPostWakeupI(smp_queue_t *sqp, thread_reference_t *trp, msg_t msg) {
+  smp_wakeup_t *wrptr, *next;
+
+  chDbgCheckClassI();
+  chDbgCheck((sqp != NULL) && (trp != NULL));
+
+  wrptr = sqp->wrptr;
+  next  = wrptr + 1;
+  if (next >= sqp->top) {
+    next = sqp->buffer;
+  }
+
+  /* Checking for queue full condition, one slot is sacrificed in order to
+     distinguish it from the empty condition.*/
+  if (next == sqp->rdptr) {
+    return false;
+  }
+
+  wrptr->trp = trp;
+  wrptr->msg = msg;
+
+  /* The slot must be globally visible before the write pointer update
+     makes it reachable by the consuming core.*/
+  CH_CFG_SMP_MEMORY_BARRIER();
+
+  sqp->wrptr = next;
+
+  return true;
+}
+
+/**
+ * @brief   Dispatches all pending wakeup requests on the local core.
+ * @details The referenced threads are resumed on the local ready list.
+ * @note    This function is meant to be invoked from the IPI interrupt
+ *          handler of the core owning the queue.
+ *
+ * @param[in] sqp       pointer to a @p smp_queue_t structure
+ *
+ * @iclass
+ */
+void chSMPDispatchI(smp_queue_t *sqp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(sqp != NULL);
+
+  while (sqp->rdptr != sqp->wrptr) {
+    smp_wakeup_t *rdptr = sqp->rdptr;
+    thread_reference_t *trp = rdptr->trp;
+    msg_t msg = rdptr->msg;
+
+    /* The slot content must be sampled before the read pointer update
+       makes the slot reusable by the producing core.*/
+    CH_CFG_SMP_MEMORY_BARRIER();
+
+    rdptr++;
+    if (rdptr >= sqp->top) {
+      rdptr = sqp->buffer;
+    }
+    sqp->rdptr = rdptr;
+
+    chThdResumeI(trp, msg);
+  }
+}
+
+#endif /* CH_CFG_USE_SMP == TRUE */
+
+/** @} */
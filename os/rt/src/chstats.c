@@ -50,6 +50,53 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_DBG_AUDIT_CRITICAL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Accounts a finished critical zone in the offenders table.
+ * @details If the call site is already in the table then its entry is
+ *          updated, else an empty slot is taken. When the table is full
+ *          the entry with the smallest worst time is evicted, but only
+ *          if the new measurement is worse, so the table converges on
+ *          the worst offenders.
+ * @note    Must be called from within a critical zone.
+ *
+ * @param[in] caller    the critical zone call site
+ * @param[in] cycles    the measured duration in cycles
+ *
+ * @notapi
+ */
+static void stats_audit_insert(void *caller, rtcnt_t cycles) {
+  crit_audit_slot_t *sp = ch.kernel_stats.audit.slots;
+  crit_audit_slot_t *minp = sp;
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_DBG_AUDIT_CRITICAL_SLOTS; i++, sp++) {
+    if (sp->caller == caller) {
+      sp->n++;
+      if (cycles > sp->worst) {
+        sp->worst = cycles;
+      }
+      return;
+    }
+    if (sp->caller == NULL) {
+      sp->caller = caller;
+      sp->worst  = cycles;
+      sp->n      = (ucnt_t)1;
+      return;
+    }
+    if (sp->worst < minp->worst) {
+      minp = sp;
+    }
+  }
+
+  if (cycles > minp->worst) {
+    minp->caller = caller;
+    minp->worst  = cycles;
+    minp->n      = (ucnt_t)1;
+  }
+}
+#endif /* CH_DBG_AUDIT_CRITICAL == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -65,6 +112,20 @@ void _stats_init(void) {
   ch.kernel_stats.n_ctxswc = (ucnt_t)0;
   chTMObjectInit(&ch.kernel_stats.m_crit_thd);
   chTMObjectInit(&ch.kernel_stats.m_crit_isr);
+
+#if CH_DBG_AUDIT_CRITICAL == TRUE
+  {
+    unsigned i;
+
+    ch.kernel_stats.audit.thd_caller = NULL;
+    ch.kernel_stats.audit.isr_caller = NULL;
+    for (i = 0U; i < (unsigned)CH_DBG_AUDIT_CRITICAL_SLOTS; i++) {
+      ch.kernel_stats.audit.slots[i].caller = NULL;
+      ch.kernel_stats.audit.slots[i].worst  = (rtcnt_t)0;
+      ch.kernel_stats.audit.slots[i].n      = (ucnt_t)0;
+    }
+  }
+#endif
 }
 
 /**
@@ -91,10 +152,18 @@ void _stats_ctxswc(thread_t *ntp, thread_t *otp) {
 
 /**
  * @brief   Starts the measurement of a thread critical zone.
+ * @note    This function is called from the inlined @p chSysLock() so its
+ *          return address identifies the zone call site in the
+ *          application.
  */
 void _stats_start_measure_crit_thd(void) {
 
   chTMStartMeasurementX(&ch.kernel_stats.m_crit_thd);
+
+#if CH_DBG_AUDIT_CRITICAL == TRUE
+  ch.kernel_stats.audit.thd_caller = __builtin_return_address(0);
+  ch.kernel_stats.audit.thd_start  = chSysGetRealtimeCounterX();
+#endif
 }
 
 /**
@@ -102,15 +171,29 @@ void _stats_start_measure_crit_thd(void) {
  */
 void _stats_stop_measure_crit_thd(void) {
 
+#if CH_DBG_AUDIT_CRITICAL == TRUE
+  stats_audit_insert(ch.kernel_stats.audit.thd_caller,
+                     chSysGetRealtimeCounterX() -
+                     ch.kernel_stats.audit.thd_start);
+#endif
+
   chTMStopMeasurementX(&ch.kernel_stats.m_crit_thd);
 }
 
 /**
  * @brief   Starts the measurement of an ISR critical zone.
+ * @note    This function is called from the inlined @p chSysLockFromISR()
+ *          so its return address identifies the zone call site in the
+ *          interrupt handler.
  */
 void _stats_start_measure_crit_isr(void) {
 
   chTMStartMeasurementX(&ch.kernel_stats.m_crit_isr);
+
+#if CH_DBG_AUDIT_CRITICAL == TRUE
+  ch.kernel_stats.audit.isr_caller = __builtin_return_address(0);
+  ch.kernel_stats.audit.isr_start  = chSysGetRealtimeCounterX();
+#endif
 }
 
 /**
@@ -118,6 +201,12 @@ void _stats_start_measure_crit_isr(void) {
  */
 void _stats_stop_measure_crit_isr(void) {
 
+#if CH_DBG_AUDIT_CRITICAL == TRUE
+  stats_audit_insert(ch.kernel_stats.audit.isr_caller,
+                     chSysGetRealtimeCounterX() -
+                     ch.kernel_stats.audit.isr_start);
+#endif
+
   chTMStopMeasurementX(&ch.kernel_stats.m_crit_isr);
 }
 
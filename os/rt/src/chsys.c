@@ -83,6 +83,110 @@ static void _idle_thread(void *p) {
 }
 #endif /* CH_CFG_NO_IDLE_THREAD == FALSE */
 
+/**
+ * @brief   Advances an integrity cursor to the next check.
+ * @note    The stage field becomes zero after the last check.
+ *
+ * @param[in,out] icp   pointer to the cursor
+ *
+ * @notapi
+ */
+static void integrity_next_stage(sys_integrity_cursor_t *icp) {
+
+  icp->index  = 0U;
+  icp->offset = (cnt_t)0;
+  if (icp->stage == CH_INTEGRITY_PORT) {
+    icp->stage = 0U;
+  }
+  else {
+    icp->stage <<= 1U;
+  }
+}
+
+/**
+ * @brief   Verifies a slice of a threads queue.
+ * @details The walk resumes at the cursor ordinal and verifies the cross
+ *          links of up to the budgeted number of nodes. Resuming by
+ *          ordinal is safe against queue mutations between slices, at
+ *          worst nodes inserted before the resume position are verified
+ *          in the next sweep.
+ *
+ * @param[in] tqp       pointer to the threads queue
+ * @param[in,out] icp   pointer to the cursor
+ * @param[in,out] np    pointer to the nodes budget
+ * @param[out] donep    set to @p true if the queue end has been reached
+ * @return              The test result.
+ * @retval false        The test succeeded.
+ * @retval true         Test failed.
+ *
+ * @notapi
+ */
+static bool integrity_check_tqueue_slice(threads_queue_t *tqp,
+                                         sys_integrity_cursor_t *icp,
+                                         unsigned *np, bool *donep) {
+  thread_t *tp = tqp->next;
+  cnt_t i = (cnt_t)0;
+
+  /* Reaching the resume position, if the queue shrank since the previous
+     slice then the walk simply ends early.*/
+  while ((i < icp->offset) && (tp != (thread_t *)tqp)) {
+    tp = tp->queue.next;
+    i++;
+  }
+
+  /* Verifying the cross links of the following nodes within budget.*/
+  while ((*np > 0U) && (tp != (thread_t *)tqp)) {
+    if ((tp->queue.next->queue.prev != tp) ||
+        (tp->queue.prev->queue.next != tp)) {
+      return true;
+    }
+    tp = tp->queue.next;
+    icp->offset++;
+    (*np)--;
+  }
+
+  *donep = (tp == (thread_t *)tqp);
+  return false;
+}
+
+/**
+ * @brief   Verifies a slice of a virtual timers list.
+ * @details Same slicing strategy as @p integrity_check_tqueue_slice().
+ *
+ * @param[in] head      pointer to the list header
+ * @param[in,out] icp   pointer to the cursor
+ * @param[in,out] np    pointer to the nodes budget
+ * @param[out] donep    set to @p true if the list end has been reached
+ * @return              The test result.
+ * @retval false        The test succeeded.
+ * @retval true         Test failed.
+ *
+ * @notapi
+ */
+static bool integrity_check_vtlist_slice(virtual_timer_t *head,
+                                         sys_integrity_cursor_t *icp,
+                                         unsigned *np, bool *donep) {
+  virtual_timer_t *vtp = head->next;
+  cnt_t i = (cnt_t)0;
+
+  while ((i < icp->offset) && (vtp != head)) {
+    vtp = vtp->next;
+    i++;
+  }
+
+  while ((*np > 0U) && (vtp != head)) {
+    if ((vtp->next->prev != vtp) || (vtp->prev->next != vtp)) {
+      return true;
+    }
+    vtp = vtp->next;
+    icp->offset++;
+    (*np)--;
+  }
+
+  *donep = (vtp == head);
+  return false;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -122,6 +226,9 @@ void chSysInit(void) {
 #if CH_DBG_STATISTICS == TRUE
   _stats_init();
 #endif
+#if CH_CFG_USE_THREAD_CYCLES == TRUE
+  ch.lastswc = (rtcnt_t)port_rt_get_counter_value();
+#endif
 
 #if CH_CFG_NO_IDLE_THREAD == FALSE
   /* Now this instructions flow becomes the main thread.*/
@@ -141,6 +248,15 @@ void chSysInit(void) {
        symbol must be provided externally.*/
     extern stkalign_t __main_thread_stack_base__;
     currp->wabase = &__main_thread_stack_base__;
+
+#if CH_DBG_FILL_THREADS == TRUE
+    {
+      /* Initial watermark for the main thread, the stack is filled by the
+         startup code.*/
+      extern stkalign_t __main_thread_stack_end__;
+      currp->wlow = (uint8_t *)&__main_thread_stack_end__;
+    }
+#endif
   }
 #elif CH_CFG_USE_DYNAMIC == TRUE
   currp->wabase = NULL;
@@ -245,7 +361,41 @@ bool chSysIntegrityCheckI(unsigned testmask) {
   /* Ready List integrity check.*/
   if ((testmask & CH_INTEGRITY_RLIST) != 0U) {
     thread_t *tp;
-
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+    unsigned i;
+
+    /* Scanning all priority FIFOs, the bitmap must be consistent with the
+       queues state.*/
+    for (i = 0U; i < CH_SCH_PRIO_LEVELS; i++) {
+      threads_queue_t *tqp = &ch.rlist.fifos[i];
+      bool bit = (ch.rlist.prio_bmap[i / 32U] &
+                  ((uint32_t)1U << (i % 32U))) != (uint32_t)0;
+
+      if (bit == queue_isempty(tqp)) {
+        return true;
+      }
+
+      /* Scanning the FIFO forward.*/
+      n = (cnt_t)0;
+      tp = tqp->next;
+      while (tp != (thread_t *)tqp) {
+        n++;
+        tp = tp->queue.next;
+      }
+
+      /* Scanning the FIFO backward.*/
+      tp = tqp->prev;
+      while (tp != (thread_t *)tqp) {
+        n--;
+        tp = tp->queue.prev;
+      }
+
+      /* The number of elements must match.*/
+      if (n != (cnt_t)0) {
+        return true;
+      }
+    }
+#else
     /* Scanning the ready list forward.*/
     n = (cnt_t)0;
     tp = ch.rlist.queue.next;
@@ -265,12 +415,46 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+#endif
   }
 
   /* Timers list integrity check.*/
   if ((testmask & CH_INTEGRITY_VTLIST) != 0U) {
     virtual_timer_t * vtp;
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+    unsigned i;
+    cnt_t total = (cnt_t)0;
+
+    for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SIZE; i++) {
+      virtual_timer_t *slot = (virtual_timer_t *)&ch.vtlist.slots[i];
+
+      /* Scanning the slot queue forward.*/
+      n = (cnt_t)0;
+      vtp = slot->next;
+      while (vtp != slot) {
+        n++;
+        total++;
+        vtp = vtp->next;
+      }
+
+      /* Scanning the slot queue backward.*/
+      vtp = slot->prev;
+      while (vtp != slot) {
+        n--;
+        vtp = vtp->prev;
+      }
+
+      /* The number of elements must match.*/
+      if (n != (cnt_t)0) {
+        return true;
+      }
+    }
 
+    /* The timers counter must be consistent with the queues state.*/
+    if (total != ch.vtlist.cnt) {
+      return true;
+    }
+#else /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
     /* Scanning the timers list forward.*/
     n = (cnt_t)0;
     vtp = ch.vtlist.next;
@@ -290,6 +474,7 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
   }
 
 #if CH_CFG_USE_REGISTRY == TRUE
@@ -327,6 +512,177 @@ bool chSysIntegrityCheckI(unsigned testmask) {
   return false;
 }
 
+/**
+ * @brief   Incremental system integrity check.
+ * @details Performs a bounded slice of the integrity checks selected by
+ *          the mask, at most @p n list nodes are verified per call. The
+ *          cursor carries the resume position so a full sweep is spread
+ *          across many invocations, typically from the idle loop hook,
+ *          keeping each critical zone in the microseconds range.
+ * @note    The cursor must be zero-initialized before the first call, a
+ *          sweep is complete when the stage field returns to zero.
+ * @note    The verification is performed through per-node cross links
+ *          rather than the full forward/backward scans of
+ *          @p chSysIntegrityCheckI(), global invariants spanning a whole
+ *          structure, like the timers counter, cannot be verified
+ *          incrementally because the structures legitimately mutate
+ *          between slices.
+ * @note    The same failure handling considerations of
+ *          @p chSysIntegrityCheckI() apply.
+ *
+ * @param[in,out] icp   pointer to a @p sys_integrity_cursor_t structure
+ * @param[in] testmask  Each bit in this mask is associated to a test to be
+ *                      performed.
+ * @param[in] n         maximum number of list nodes to be verified
+ * @return              The test result.
+ * @retval false        The test succeeded.
+ * @retval true         Test failed.
+ *
+ * @iclass
+ */
+bool chSysIntegrityCheckStepI(sys_integrity_cursor_t *icp,
+                              unsigned testmask, unsigned n) {
+
+  chDbgCheckClassI();
+  chDbgCheck((icp != NULL) && (n > 0U));
+
+  /* Starting a new sweep when the cursor is idle.*/
+  if (icp->stage == 0U) {
+    icp->stage  = CH_INTEGRITY_RLIST;
+    icp->index  = 0U;
+    icp->offset = (cnt_t)0;
+  }
+
+  while (n > 0U) {
+    bool done;
+
+    /* Checks not selected by the mask are skipped.*/
+    if ((icp->stage & testmask) == 0U) {
+      integrity_next_stage(icp);
+      if (icp->stage == 0U) {
+        break;
+      }
+      continue;
+    }
+
+    switch (icp->stage) {
+    case CH_INTEGRITY_RLIST:
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+    {
+      threads_queue_t *tqp = &ch.rlist.fifos[icp->index];
+
+      /* The bitmap consistency is verified when entering each FIFO, the
+         check is accounted as one node.*/
+      if (icp->offset == (cnt_t)0) {
+        bool bit = (ch.rlist.prio_bmap[icp->index / 32U] &
+                    ((uint32_t)1U << (icp->index % 32U))) != (uint32_t)0;
+
+        if (bit == queue_isempty(tqp)) {
+          return true;
+        }
+        n--;
+      }
+
+      if (integrity_check_tqueue_slice(tqp, icp, &n, &done)) {
+        return true;
+      }
+      if (done) {
+        icp->index++;
+        icp->offset = (cnt_t)0;
+        if (icp->index >= (unsigned)CH_SCH_PRIO_LEVELS) {
+          integrity_next_stage(icp);
+        }
+      }
+    }
+#else
+      if (integrity_check_tqueue_slice(&ch.rlist.queue, icp, &n, &done)) {
+        return true;
+      }
+      if (done) {
+        integrity_next_stage(icp);
+      }
+#endif
+      break;
+
+    case CH_INTEGRITY_VTLIST:
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+    {
+      virtual_timer_t *slot = (virtual_timer_t *)&ch.vtlist.slots[icp->index];
+
+      if (integrity_check_vtlist_slice(slot, icp, &n, &done)) {
+        return true;
+      }
+      if (done) {
+        icp->index++;
+        icp->offset = (cnt_t)0;
+        if (icp->index >= (unsigned)CH_CFG_VT_WHEEL_SIZE) {
+          integrity_next_stage(icp);
+        }
+      }
+    }
+#else
+      if (integrity_check_vtlist_slice((virtual_timer_t *)&ch.vtlist,
+                                       icp, &n, &done)) {
+        return true;
+      }
+      if (done) {
+        integrity_next_stage(icp);
+      }
+#endif
+      break;
+
+    case CH_INTEGRITY_REGISTRY:
+#if CH_CFG_USE_REGISTRY == TRUE
+    {
+      thread_t *tp = ch.rlist.newer;
+      cnt_t i = (cnt_t)0;
+
+      while ((i < icp->offset) && (tp != (thread_t *)&ch.rlist)) {
+        tp = tp->newer;
+        i++;
+      }
+
+      while ((n > 0U) && (tp != (thread_t *)&ch.rlist)) {
+        if ((tp->newer->older != tp) || (tp->older->newer != tp)) {
+          return true;
+        }
+        tp = tp->newer;
+        icp->offset++;
+        n--;
+      }
+
+      if (tp == (thread_t *)&ch.rlist) {
+        integrity_next_stage(icp);
+      }
+    }
+#else
+      integrity_next_stage(icp);
+#endif
+      break;
+
+    case CH_INTEGRITY_PORT:
+#if defined(PORT_INTEGRITY_CHECK)
+      PORT_INTEGRITY_CHECK();
+      n--;
+#endif
+      integrity_next_stage(icp);
+      break;
+
+    default:
+      /* Invalid cursor state, restarting the sweep.*/
+      icp->stage = 0U;
+      break;
+    }
+
+    /* Sweep complete.*/
+    if (icp->stage == 0U) {
+      break;
+    }
+  }
+
+  return false;
+}
+
 /**
  * @brief   Handles time ticks for round robin preemption and timer increments.
  * @details Decrements the remaining time quantum of the running thread
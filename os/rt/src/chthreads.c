@@ -100,9 +100,22 @@ thread_t *_thread_init(thread_t *tp, const char *name, tprio_t prio) {
 #if CH_CFG_USE_EVENTS == TRUE
   tp->epending  = (eventmask_t)0;
 #endif
+#if CH_CFG_USE_DEFERRED_READY == TRUE
+  tp->dfrnext   = NULL;
+#endif
+#if CH_CFG_USE_THREAD_CYCLES == TRUE
+  tp->cycles    = (rtcnt_t)0;
+#endif
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    (CH_DBG_TRACE_COMPACT == TRUE)
+  tp->traceid   = ch.dbg.trace_buffer.nextid++;
+#endif
 #if CH_DBG_THREADS_PROFILING == TRUE
   tp->time      = (systime_t)0;
 #endif
+#if CH_DBG_FILL_THREADS == TRUE
+  tp->wlow      = NULL;
+#endif
 #if CH_CFG_USE_REGISTRY == TRUE
   tp->refs      = (trefs_t)1;
   tp->name      = name;
@@ -139,7 +152,63 @@ void _thread_memfill(uint8_t *startp, uint8_t *endp, uint8_t v) {
     *startp++ = v;
   }
 }
-#endif /* CH_DBG_FILL_THREADS */
+#endif /* CH_DBG_FILL_THREADS == TRUE */
+
+#if ((CH_DBG_FILL_THREADS == TRUE) &&                                       \
+     ((CH_DBG_ENABLE_STACK_CHECK == TRUE) ||                                \
+      (CH_CFG_USE_DYNAMIC == TRUE))) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the unused space in a thread stack.
+ * @details The stack area is searched for the high watermark of the fill
+ *          pattern using a binary search, the result is cached in the
+ *          thread structure so subsequent queries only re-scan the region
+ *          below the previous watermark.
+ * @pre     The option @p CH_DBG_FILL_THREADS must be enabled.
+ * @note    The search assumes that the used stack region is contiguous, a
+ *          stack word accidentally matching the fill pattern just above
+ *          the real watermark can cause a transient over-estimation of
+ *          the free space.
+ * @note    Zero is returned for threads without a known stack boundary,
+ *          for example the main thread when @p CH_DBG_ENABLE_STACK_CHECK
+ *          is disabled.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The unused stack space in bytes.
+ *
+ * @xclass
+ */
+size_t chThdGetFreeStackX(thread_t *tp) {
+  const uint32_t pattern = (uint32_t)CH_DBG_STACK_FILL_VALUE * 0x01010101U;
+  const uint32_t *base;
+  size_t lo, hi;
+
+  chDbgCheck(tp != NULL);
+
+  if ((tp->wabase == NULL) || (tp->wlow == NULL)) {
+    return (size_t)0;
+  }
+
+  /*lint -save -e9087 [11.3] The area is always properly aligned.*/
+  base = (const uint32_t *)(void *)tp->wabase;
+  lo = (size_t)0;
+  hi = (size_t)((const uint32_t *)(void *)tp->wlow - base);
+  /*lint -restore*/
+  while (lo < hi) {
+    size_t mid = (lo + hi) / (size_t)2;
+
+    if (base[mid] == pattern) {
+      lo = mid + (size_t)1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  tp->wlow = (uint8_t *)(base + lo);
+
+  return lo * sizeof (uint32_t);
+}
+#endif /* CH_DBG_FILL_THREADS && (CH_DBG_ENABLE_STACK_CHECK ||
+                                  CH_CFG_USE_DYNAMIC) */
 
 /**
  * @brief   Creates a new thread into a static memory area.
@@ -190,7 +259,15 @@ thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp) {
   PORT_SETUP_CONTEXT(tp, tdp->wbase, tp, tdp->funcp, tdp->arg);
 
   /* The driver object is initialized but not started.*/
-  return _thread_init(tp, tdp->name, tdp->prio);
+  tp = _thread_init(tp, tdp->name, tdp->prio);
+
+#if CH_DBG_FILL_THREADS == TRUE
+  /* Initial watermark placed at the stack top, the fill pattern is
+     scanned downward from here by chThdGetFreeStackX().*/
+  tp->wlow = (uint8_t *)tp;
+#endif
+
+  return tp;
 }
 
 /**
@@ -360,6 +437,12 @@ thread_t *chThdCreateStatic(void *wsp, size_t size,
 
   tp = _thread_init(tp, "noname", prio);
 
+#if CH_DBG_FILL_THREADS == TRUE
+  /* Initial watermark placed at the stack top, the fill pattern is
+     scanned downward from here by chThdGetFreeStackX().*/
+  tp->wlow = (uint8_t *)tp;
+#endif
+
   /* Starting the thread immediately.*/
   chSchWakeupS(tp, MSG_OK);
   chSysUnlock();
@@ -367,6 +450,32 @@ thread_t *chThdCreateStatic(void *wsp, size_t size,
   return tp;
 }
 
+/**
+ * @brief   Creates all the threads defined in the static threads table.
+ * @details The table is defined using the @p THD_TABLE_BEGIN,
+ *          @p THD_TABLE_ENTRY and @p THD_TABLE_END macros, the entry with
+ *          a @p NULL thread function marks the table end. All the threads
+ *          are created within a single critical zone and rescheduling is
+ *          evaluated once at the end, this makes the system start up faster
+ *          than a series of @p chThdCreateStatic() calls.
+ * @post    Each created thread has a reference counter set to one, it is
+ *          caller responsibility to call @p chThdRelease() or @p chThdWait()
+ *          in order to release the reference.
+ *
+ * @api
+ */
+void chThdCreateAll(void) {
+  const thread_descriptor_t *tdp = &ch_thd_table[0];
+
+  chSysLock();
+  while (tdp->funcp != NULL) {
+    (void) chThdCreateI(tdp);
+    tdp++;
+  }
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
 /**
  * @brief   Resumes a thread created with @p chThdCreateI().
  *
@@ -441,7 +550,11 @@ void chThdRelease(thread_t *tp) {
     switch (tp->flags & CH_FLAG_MODE_MASK) {
 #if CH_CFG_USE_HEAP == TRUE
     case CH_FLAG_MODE_HEAP:
+#if CH_CFG_USE_WA_CACHE == TRUE
+      _dyn_wa_free(chThdGetWorkingAreaX(tp));
+#else
       chHeapFree(chThdGetWorkingAreaX(tp));
+#endif
       break;
 #endif
 #if CH_CFG_USE_MEMPOOLS == TRUE
@@ -581,6 +694,58 @@ msg_t chThdWait(thread_t *tp) {
 
   return msg;
 }
+
+/**
+ * @brief   Blocks the execution of the invoking thread until all the
+ *          specified threads terminate.
+ * @details The function is equivalent to calling @p chThdWait() on every
+ *          element of the array but all the joins are performed within a
+ *          single critical zone, the waits overlap instead of being
+ *          serialized so the total wait equals the longest individual
+ *          termination.
+ * @pre     The configuration option @p CH_CFG_USE_WAITEXIT must be enabled in
+ *          order to use this function.
+ * @note    If @p CH_CFG_USE_DYNAMIC is not specified this function just waits
+ *          for the threads termination, no memory allocators are involved.
+ *
+ * @param[in] tps       array of pointers to the threads
+ * @param[in] n         number of elements in the array
+ * @param[out] msgs     destination array for the exit codes, can be
+ *                      @p NULL
+ *
+ * @api
+ */
+void chThdWaitAll(thread_t *tps[], size_t n, msg_t msgs[]) {
+  size_t i;
+
+  chDbgCheck((tps != NULL) && (n > 0U));
+
+  chSysLock();
+  for (i = 0U; i < n; i++) {
+    thread_t *tp = tps[i];
+
+    chDbgAssert(tp != currp, "waiting self");
+#if CH_CFG_USE_REGISTRY == TRUE
+    chDbgAssert(tp->refs > (trefs_t)0, "no references");
+#endif
+
+    if (tp->state != CH_STATE_FINAL) {
+      list_insert(currp, &tp->waiting);
+      chSchGoSleepS(CH_STATE_WTEXIT);
+    }
+    if (msgs != NULL) {
+      msgs[i] = tp->u.exitcode;
+    }
+  }
+  chSysUnlock();
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  /* Releasing a reference to each of the threads.*/
+  for (i = 0U; i < n; i++) {
+    chThdRelease(tps[i]);
+  }
+#endif
+}
 #endif /* CH_CFG_USE_WAITEXIT */
 
 /**
@@ -617,6 +782,75 @@ tprio_t chThdSetPriority(tprio_t newprio) {
   return oldprio;
 }
 
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Declares the next absolute deadline of the invoking thread.
+ * @details On the first call the thread enters the EDF scheduling band,
+ *          placed above the whole fixed priorities range, where threads
+ *          are ordered by earliest absolute deadline. Passing
+ *          @p TIME_INFINITE makes the thread leave the band restoring its
+ *          fixed priority.
+ * @note    A typical periodic thread invokes this function once per
+ *          activation passing its relative deadline, then sleeps until
+ *          the next period.
+ * @note    Priority inheritance does not boost threads into the EDF band,
+ *          sharing mutexes between EDF and fixed priority threads should
+ *          be avoided.
+ *
+ * @param[in] delay     the deadline, as an interval relative to the current
+ *                      system time, the special value @p TIME_INFINITE
+ *                      makes the thread leave the EDF band
+ *
+ * @sclass
+ */
+void chThdSetDeadlineS(sysinterval_t delay) {
+  thread_t *ctp = currp;
+
+  chDbgCheckClassS();
+
+  if (delay == TIME_INFINITE) {
+    /* Leaving the band, the fixed priority is restored.*/
+    if (ctp->prio == EDFPRIO) {
+      ctp->prio = ctp->bprio;
+#if CH_CFG_USE_MUTEXES == TRUE
+      ctp->realprio = ctp->bprio;
+#endif
+    }
+  }
+  else {
+    /* Entering the band on the first call, the fixed priority is saved
+       in order to be restored on leave.*/
+    if (ctp->prio != EDFPRIO) {
+#if CH_CFG_USE_MUTEXES == TRUE
+      ctp->bprio    = ctp->realprio;
+      ctp->realprio = EDFPRIO;
+#else
+      ctp->bprio    = ctp->prio;
+#endif
+      ctp->prio = EDFPRIO;
+    }
+    ctp->deadline = chTimeAddX(chVTGetSystemTimeX(), delay);
+  }
+  chSchRescheduleS();
+}
+
+/**
+ * @brief   Declares the next absolute deadline of the invoking thread.
+ *
+ * @param[in] delay     the deadline, as an interval relative to the current
+ *                      system time, the special value @p TIME_INFINITE
+ *                      makes the thread leave the EDF band
+ *
+ * @api
+ */
+void chThdSetDeadline(sysinterval_t delay) {
+
+  chSysLock();
+  chThdSetDeadlineS(delay);
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_EDF == TRUE */
+
 /**
  * @brief   Requests a thread termination.
  * @pre     The target thread must be written to invoke periodically
@@ -636,8 +870,33 @@ void chThdTerminate(thread_t *tp) {
   chSysUnlock();
 }
 
+/**
+ * @brief   Delays the invoking thread with a polled wait.
+ * @details The system time base is polled until the specified interval has
+ *          elapsed, no virtual timer is armed and no context switch is
+ *          performed. In tick-less mode the resolution is the one of the
+ *          time base, delays below @p CH_CFG_ST_TIMEDELTA are performed
+ *          accurately where the timers subsystem would round them up.
+ * @note    The CPU is busy for the whole delay, this function is meant for
+ *          delays shorter than the timers subsystem resolution.
+ *
+ * @param[in] delay     the delay in system ticks
+ *
+ * @xclass
+ */
+void chThdSpinDelayX(sysinterval_t delay) {
+  systime_t start = chVTGetSystemTimeX();
+  systime_t end = chTimeAddX(start, delay);
+
+  while (chTimeIsInRangeX(chVTGetSystemTimeX(), start, end)) {
+  }
+}
+
 /**
  * @brief   Suspends the invoking thread for the specified time.
+ * @note    If @p CH_CFG_THREAD_SPIN_THRESHOLD is greater than zero then
+ *          delays not exceeding the threshold are performed with a polled
+ *          wait instead of arming a virtual timer.
  *
  * @param[in] time      the delay in system ticks, the special values are
  *                      handled as follow:
@@ -650,6 +909,15 @@ void chThdTerminate(thread_t *tp) {
  */
 void chThdSleep(sysinterval_t time) {
 
+#if CH_CFG_THREAD_SPIN_THRESHOLD > 0
+  /* Short delays are spun on the time base, the timers subsystem is not
+     involved.*/
+  if ((time != TIME_INFINITE) &&
+      (time <= (sysinterval_t)CH_CFG_THREAD_SPIN_THRESHOLD)) {
+    chThdSpinDelayX(time);
+    return;
+  }
+#endif
   chSysLock();
   chThdSleepS(time);
   chSysUnlock();
@@ -898,9 +1166,7 @@ void chThdDequeueNextI(threads_queue_t *tqp, msg_t msg) {
  */
 void chThdDequeueAllI(threads_queue_t *tqp, msg_t msg) {
 
-  while (queue_notempty(tqp)) {
-    chThdDoDequeueNextI(tqp, msg);
-  }
+  chSchWakeupAllI(tqp, msg);
 }
 
 /** @} */
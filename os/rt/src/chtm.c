@@ -50,6 +50,32 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if CH_CFG_TM_HISTOGRAM == TRUE
+/**
+ * @brief   Integer binary logarithm of a measurement.
+ *
+ * @param[in] v         the measured time, must not be zero
+ * @return              The bucket index.
+ *
+ * @notapi
+ */
+static inline unsigned tm_log2(rtcnt_t v) {
+
+#if defined(__GNUC__)
+  return 31U - (unsigned)__builtin_clz((unsigned)v);
+#else
+  unsigned i = 0U;
+
+  while (v > (rtcnt_t)1) {
+    v >>= 1;
+    i++;
+  }
+
+  return i;
+#endif
+}
+#endif /* CH_CFG_TM_HISTOGRAM == TRUE */
+
 static inline void tm_stop(time_measurement_t *tmp,
                            rtcnt_t now,
                            rtcnt_t offset) {
@@ -63,6 +89,13 @@ static inline void tm_stop(time_measurement_t *tmp,
   if (tmp->last < tmp->best) {
     tmp->best = tmp->last;
   }
+#if CH_CFG_TM_HISTOGRAM == TRUE
+  if (tmp->hist != NULL) {
+    unsigned i = (tmp->last == (rtcnt_t)0) ? 0U : tm_log2(tmp->last);
+
+    tmp->hist[i]++;
+  }
+#endif
 }
 
 /*===========================================================================*/
@@ -101,7 +134,34 @@ void chTMObjectInit(time_measurement_t *tmp) {
   tmp->last       = (rtcnt_t)0;
   tmp->n          = (ucnt_t)0;
   tmp->cumulative = (rttime_t)0;
+#if CH_CFG_TM_HISTOGRAM == TRUE
+  tmp->hist       = NULL;
+#endif
+}
+
+#if (CH_CFG_TM_HISTOGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p TimeMeasurement object with histogram support.
+ * @details Each measurement is also accumulated in the log2 bucket matching
+ *          its magnitude, bucket @p i counts the measurements with an
+ *          integer binary logarithm of @p i.
+ *
+ * @param[out] tmp      pointer to a @p TimeMeasurement structure
+ * @param[in] hist      the buckets array, it is cleared
+ *
+ * @init
+ */
+void chTMObjectInitHist(time_measurement_t *tmp,
+                        ucnt_t hist[CH_TM_HISTOGRAM_BUCKETS]) {
+  unsigned i;
+
+  chTMObjectInit(tmp);
+  for (i = 0U; i < (unsigned)CH_TM_HISTOGRAM_BUCKETS; i++) {
+    hist[i] = (ucnt_t)0;
+  }
+  tmp->hist = hist;
 }
+#endif /* CH_CFG_TM_HISTOGRAM == TRUE */
 
 /**
  * @brief   Starts a measurement.
@@ -49,6 +49,7 @@
 /*===========================================================================*/
 
 #if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) || defined(__DOXYGEN__)
+#if (CH_DBG_TRACE_COMPACT == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Writes a time stamp and increases the trace buffer pointer.
  *
@@ -71,6 +72,81 @@ static NOINLINE void trace_next(void) {
     ch.dbg.trace_buffer.ptr = &ch.dbg.trace_buffer.buffer[0];
   }
 }
+
+#else /* CH_DBG_TRACE_COMPACT == TRUE */
+/**
+ * @brief   Makes room for a record in the active bank.
+ * @details If the active bank cannot hold @p n more bytes then it is marked
+ *          ready for draining and the filling continues on the other bank,
+ *          if the other bank has not been drained yet then the record is
+ *          dropped.
+ *
+ * @param[in] n         maximum size of the record to be stored
+ * @return              The operation status.
+ * @retval false        if the record must be dropped.
+ *
+ * @notapi
+ */
+static bool trace_reserve(size_t n) {
+  ch_trace_buffer_t *tbp = &ch.dbg.trace_buffer;
+
+  if ((size_t)(tbp->wend - tbp->wptr) < n) {
+    unsigned other = (unsigned)tbp->active ^ 1U;
+
+    tbp->used[tbp->active] = (uint16_t)(tbp->wptr -
+                                        &tbp->buffer[tbp->active][0]);
+    tbp->full |= (uint8_t)(1U << tbp->active);
+    if ((tbp->full & (uint8_t)(1U << other)) != 0U) {
+      /* Both banks are waiting to be drained, the record is dropped.*/
+      tbp->dropped++;
+      return false;
+    }
+    tbp->active = (uint8_t)other;
+    tbp->wptr   = &tbp->buffer[other][0];
+    tbp->wend   = tbp->wptr + CH_DBG_TRACE_COMPACT_BUFFER_SIZE;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Stores a value in base-128 varint encoding.
+ *
+ * @param[in] v         the value to be stored
+ *
+ * @notapi
+ */
+static void trace_put_varint(uint32_t v) {
+
+  while (v >= (uint32_t)0x80) {
+    *ch.dbg.trace_buffer.wptr++ = (uint8_t)(v | (uint32_t)0x80);
+    v >>= 7;
+  }
+  *ch.dbg.trace_buffer.wptr++ = (uint8_t)v;
+}
+
+/**
+ * @brief   Stores a record header and the delta-encoded time stamp.
+ *
+ * @param[in] type      record type
+ * @param[in] state     switched-out thread state or zero
+ *
+ * @notapi
+ */
+static void trace_header(uint8_t type, uint8_t state) {
+  rtcnt_t now;
+
+#if PORT_SUPPORTS_RT == TRUE
+  now = chSysGetRealtimeCounterX();
+#else
+  now = (rtcnt_t)chVTGetSystemTimeX();
+#endif
+  *ch.dbg.trace_buffer.wptr++ = (uint8_t)((type << 5) |
+                                          (state & (uint8_t)0x1F));
+  trace_put_varint((uint32_t)(now - ch.dbg.trace_buffer.lastts));
+  ch.dbg.trace_buffer.lastts = now;
+}
+#endif /* CH_DBG_TRACE_COMPACT == TRUE */
 #endif
 
 /*===========================================================================*/
@@ -83,6 +159,8 @@ static NOINLINE void trace_next(void) {
  * @note    Internal use only.
  */
 void _trace_init(void) {
+
+#if CH_DBG_TRACE_COMPACT == FALSE
   unsigned i;
 
   ch.dbg.trace_buffer.suspended = (uint16_t)~CH_DBG_TRACE_MASK;
@@ -91,6 +169,20 @@ void _trace_init(void) {
   for (i = 0U; i < (unsigned)CH_DBG_TRACE_BUFFER_SIZE; i++) {
     ch.dbg.trace_buffer.buffer[i].type = CH_TRACE_TYPE_UNUSED;
   }
+#else
+  ch.dbg.trace_buffer.suspended = (uint16_t)~CH_DBG_TRACE_MASK;
+  ch.dbg.trace_buffer.active    = (uint8_t)0;
+  ch.dbg.trace_buffer.full      = (uint8_t)0;
+  ch.dbg.trace_buffer.draining  = (uint8_t)2;
+  ch.dbg.trace_buffer.nextid    = (uint8_t)0;
+  ch.dbg.trace_buffer.dropped   = (uint16_t)0;
+  ch.dbg.trace_buffer.used[0]   = (uint16_t)0;
+  ch.dbg.trace_buffer.used[1]   = (uint16_t)0;
+  ch.dbg.trace_buffer.wptr      = &ch.dbg.trace_buffer.buffer[0][0];
+  ch.dbg.trace_buffer.wend      = ch.dbg.trace_buffer.wptr +
+                                  CH_DBG_TRACE_COMPACT_BUFFER_SIZE;
+  ch.dbg.trace_buffer.lastts    = (rtcnt_t)0;
+#endif
 }
 
 /**
@@ -106,11 +198,19 @@ void _trace_switch(thread_t *ntp, thread_t *otp) {
   (void)ntp;
 
   if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_SWITCH) == 0U) {
+#if CH_DBG_TRACE_COMPACT == FALSE
     ch.dbg.trace_buffer.ptr->type        = CH_TRACE_TYPE_SWITCH;
     ch.dbg.trace_buffer.ptr->state       = (uint8_t)otp->state;
     ch.dbg.trace_buffer.ptr->u.sw.ntp    = currp;
     ch.dbg.trace_buffer.ptr->u.sw.wtobjp = otp->u.wtobjp;
     trace_next();
+#else
+    /* Header, time stamp delta and switched-in thread index.*/
+    if (trace_reserve((size_t)7)) {
+      trace_header((uint8_t)CH_TRACE_TYPE_SWITCH, (uint8_t)otp->state);
+      *ch.dbg.trace_buffer.wptr++ = currp->traceid;
+    }
+#endif
   }
 }
 
@@ -125,10 +225,20 @@ void _trace_isr_enter(const char *isr) {
 
   if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_ISR) == 0U) {
     port_lock_from_isr();
+#if CH_DBG_TRACE_COMPACT == FALSE
     ch.dbg.trace_buffer.ptr->type        = CH_TRACE_TYPE_ISR_ENTER;
     ch.dbg.trace_buffer.ptr->state       = 0U;
     ch.dbg.trace_buffer.ptr->u.isr.name  = isr;
     trace_next();
+#else
+    /* The ISR name is dropped in compact mode, the record only carries
+       the header and the time stamp delta.*/
+    (void)isr;
+
+    if (trace_reserve((size_t)6)) {
+      trace_header((uint8_t)CH_TRACE_TYPE_ISR_ENTER, (uint8_t)0);
+    }
+#endif
     port_unlock_from_isr();
   }
 }
@@ -144,10 +254,18 @@ void _trace_isr_leave(const char *isr) {
 
   if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_ISR) == 0U) {
     port_lock_from_isr();
+#if CH_DBG_TRACE_COMPACT == FALSE
     ch.dbg.trace_buffer.ptr->type        = CH_TRACE_TYPE_ISR_LEAVE;
     ch.dbg.trace_buffer.ptr->state       = 0U;
     ch.dbg.trace_buffer.ptr->u.isr.name  = isr;
     trace_next();
+#else
+    (void)isr;
+
+    if (trace_reserve((size_t)6)) {
+      trace_header((uint8_t)CH_TRACE_TYPE_ISR_LEAVE, (uint8_t)0);
+    }
+#endif
     port_unlock_from_isr();
   }
 }
@@ -162,10 +280,18 @@ void _trace_isr_leave(const char *isr) {
 void _trace_halt(const char *reason) {
 
   if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_HALT) == 0U) {
+#if CH_DBG_TRACE_COMPACT == FALSE
     ch.dbg.trace_buffer.ptr->type          = CH_TRACE_TYPE_HALT;
     ch.dbg.trace_buffer.ptr->state         = 0;
     ch.dbg.trace_buffer.ptr->u.halt.reason = reason;
     trace_next();
+#else
+    (void)reason;
+
+    if (trace_reserve((size_t)6)) {
+      trace_header((uint8_t)CH_TRACE_TYPE_HALT, (uint8_t)0);
+    }
+#endif
   }
 }
 
@@ -182,11 +308,20 @@ void chDbgWriteTraceI(void *up1, void *up2) {
   chDbgCheckClassI();
 
   if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_USER) == 0U) {
+#if CH_DBG_TRACE_COMPACT == FALSE
     ch.dbg.trace_buffer.ptr->type       = CH_TRACE_TYPE_USER;
     ch.dbg.trace_buffer.ptr->state      = 0;
     ch.dbg.trace_buffer.ptr->u.user.up1 = up1;
     ch.dbg.trace_buffer.ptr->u.user.up2 = up2;
     trace_next();
+#else
+    /* Header, time stamp delta and the two user parameters as varints.*/
+    if (trace_reserve((size_t)16)) {
+      trace_header((uint8_t)CH_TRACE_TYPE_USER, (uint8_t)0);
+      trace_put_varint((uint32_t)(uintptr_t)up1);
+      trace_put_varint((uint32_t)(uintptr_t)up2);
+    }
+#endif
   }
 }
 
@@ -205,6 +340,94 @@ void chDbgWriteTrace(void *up1, void *up2) {
   chSysUnlock();
 }
 
+#if (CH_DBG_TRACE_COMPACT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Fetches a full trace bank for draining.
+ * @details If a bank is ready then its buffer and used size are returned,
+ *          the capture continues on the other bank while the application
+ *          streams the data out. The bank must be returned with
+ *          @p chDbgReleaseTraceBufferI() when done.
+ * @note    Only one bank can be held at a time.
+ *
+ * @param[out] bufp     pointer to the bank buffer
+ * @param[out] sizep    number of used bytes in the bank
+ * @return              The operation status.
+ * @retval false        if no bank is ready or one is already being drained.
+ *
+ * @iclass
+ */
+bool chDbgFetchTraceBufferI(const uint8_t **bufp, size_t *sizep) {
+  ch_trace_buffer_t *tbp = &ch.dbg.trace_buffer;
+  unsigned bank;
+
+  chDbgCheckClassI();
+  chDbgCheck((bufp != NULL) && (sizep != NULL));
+
+  if ((tbp->draining != (uint8_t)2) || (tbp->full == (uint8_t)0)) {
+    return false;
+  }
+
+  /* Draining the oldest full bank, it is necessarily the one which is not
+     being filled.*/
+  bank = ((tbp->full & 1U) != 0U) ? 0U : 1U;
+  tbp->draining = (uint8_t)bank;
+  *bufp  = &tbp->buffer[bank][0];
+  *sizep = (size_t)tbp->used[bank];
+
+  return true;
+}
+
+/**
+ * @brief   Fetches a full trace bank for draining.
+ *
+ * @param[out] bufp     pointer to the bank buffer
+ * @param[out] sizep    number of used bytes in the bank
+ * @return              The operation status.
+ * @retval false        if no bank is ready or one is already being drained.
+ *
+ * @api
+ */
+bool chDbgFetchTraceBuffer(const uint8_t **bufp, size_t *sizep) {
+  bool b;
+
+  chSysLock();
+  b = chDbgFetchTraceBufferI(bufp, sizep);
+  chSysUnlock();
+
+  return b;
+}
+
+/**
+ * @brief   Releases the trace bank previously fetched.
+ * @pre     A bank must have been fetched using @p chDbgFetchTraceBufferI().
+ *
+ * @iclass
+ */
+void chDbgReleaseTraceBufferI(void) {
+  ch_trace_buffer_t *tbp = &ch.dbg.trace_buffer;
+
+  chDbgCheckClassI();
+  chDbgAssert(tbp->draining != (uint8_t)2, "no bank being drained");
+
+  tbp->used[tbp->draining] = (uint16_t)0;
+  tbp->full &= (uint8_t)~(1U << tbp->draining);
+  tbp->draining = (uint8_t)2;
+}
+
+/**
+ * @brief   Releases the trace bank previously fetched.
+ * @pre     A bank must have been fetched using @p chDbgFetchTraceBuffer().
+ *
+ * @api
+ */
+void chDbgReleaseTraceBuffer(void) {
+
+  chSysLock();
+  chDbgReleaseTraceBufferI();
+  chSysUnlock();
+}
+#endif /* CH_DBG_TRACE_COMPACT == TRUE */
+
 /**
  * @brief   Suspends one or more trace events.
  *
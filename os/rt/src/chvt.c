@@ -26,6 +26,10 @@
  * @{
  */
 
+/* Checks and assertions in this module belong to the virtual timers debug
+   class, the definition must precede the system headers.*/
+#define CH_DBG_CURRENT_CLASS CH_DBG_CLASS_VT
+
 #include "ch.h"
 
 /*===========================================================================*/
@@ -52,6 +56,146 @@
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
+#if (CH_CFG_OPTIMIZE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Virtual Timers initialization.
+ * @note    Internal use only.
+ *
+ * @notapi
+ */
+void _vt_init(void) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SIZE; i++) {
+    ch.vtlist.slots[i].next = (virtual_timer_t *)&ch.vtlist.slots[i];
+    ch.vtlist.slots[i].prev = (virtual_timer_t *)&ch.vtlist.slots[i];
+  }
+  ch.vtlist.cnt = (cnt_t)0;
+#if CH_CFG_ST_TIMEDELTA == 0
+  ch.vtlist.systime = (systime_t)0;
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  ch.vtlist.lasttime = (systime_t)0;
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+
+/**
+ * @brief   Enables a virtual timer.
+ * @details The timer is enabled and programmed to trigger after the delay
+ *          specified as parameter.
+ * @pre     The timer must not be already armed before calling this function.
+ * @note    The callback function is invoked from interrupt context.
+ *
+ * @param[out] vtp      the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ * @param[in] vtfunc    the timer callback function. After invoking the
+ *                      callback the timer is disabled and the structure can
+ *                      be disposed or reused.
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
+                vtfunc_t vtfunc, void *par) {
+  virtual_timer_t *p, *slot;
+  systime_t now, deadline;
+
+  chDbgCheckClassI();
+  chDbgCheck((vtp != NULL) && (vtfunc != NULL) && (delay != TIME_IMMEDIATE));
+
+  vtp->par = par;
+  vtp->func = vtfunc;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  now = chVTGetSystemTimeX();
+
+  /* If the requested delay is lower than the minimum safe delta then it
+     is raised to the minimum safe value.*/
+  if (delay < (sysinterval_t)CH_CFG_ST_TIMEDELTA) {
+    delay = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
+  }
+
+  /* If the wheel is empty then the current time becomes the new deadlines
+     reference time.*/
+  if (ch.vtlist.cnt == (cnt_t)0) {
+    ch.vtlist.lasttime = now;
+  }
+#else /* CH_CFG_ST_TIMEDELTA == 0 */
+  now = ch.vtlist.systime;
+#endif /* CH_CFG_ST_TIMEDELTA == 0 */
+
+  deadline = chTimeAddX(now, (systime_t)delay);
+  vtp->deadline = deadline;
+
+  /* The timer is inserted in its wheel slot, the slot queue is kept ordered
+     by expiration time so only colliding timers are scanned.*/
+  slot = (virtual_timer_t *)&ch.vtlist.slots[deadline & CH_VT_WHEEL_MASK];
+  p = slot->next;
+  while ((p != slot) &&
+         (chTimeDiffX(now, p->deadline) <= chTimeDiffX(now, deadline))) {
+    /* Debug assert if the timer is already in the list.*/
+    chDbgAssert(p != vtp, "timer already armed");
+
+    p = p->next;
+  }
+  vtp->next = p;
+  vtp->prev = p->prev;
+  vtp->prev->next = vtp;
+  p->prev = vtp;
+
+  ch.vtlist.cnt++;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* The alarm is started or anticipated if this timer becomes the nearest
+     deadline.*/
+  if (ch.vtlist.cnt == (cnt_t)1) {
+    port_timer_start_alarm(deadline);
+  }
+  else if (chTimeDiffX(now, deadline) <
+           chTimeDiffX(now, port_timer_get_alarm())) {
+    port_timer_set_alarm(deadline);
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+
+/**
+ * @brief   Disables a Virtual Timer.
+ * @pre     The timer must be in armed state before calling this function.
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @iclass
+ */
+void chVTDoResetI(virtual_timer_t *vtp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(vtp != NULL);
+  chDbgAssert(vtp->func != NULL, "timer not set or already triggered");
+
+  /* Removing the timer from its wheel slot, a constant-time operation.*/
+  vtp->prev->next = vtp->next;
+  vtp->next->prev = vtp->prev;
+  vtp->func = NULL;
+
+  ch.vtlist.cnt--;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* If the wheel becomes empty then the alarm timer is stopped. If the
+     removed timer was the alarm target then the alarm is purposely left
+     armed, the resulting spurious interrupt reprograms it, this keeps the
+     reset operation constant-time.*/
+  if (ch.vtlist.cnt == (cnt_t)0) {
+    port_timer_stop_alarm();
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+
+#else /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
 /**
  * @brief   Virtual Timers initialization.
  * @note    Internal use only.
@@ -295,5 +439,85 @@ void chVTDoResetI(virtual_timer_t *vtp) {
   port_timer_set_alarm(chTimeAddX(ch.vtlist.lasttime, delta));
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
 }
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
+
+/**
+ * @brief   Re-arms an active virtual timer with a new delay.
+ * @details This function is equivalent to a @p chVTDoResetI() followed by
+ *          a @p chVTDoSetI() keeping the callback and parameter, but the
+ *          intermediate hardware alarm reprogramming performed by the
+ *          reset is skipped where possible, the alarm is only updated
+ *          once for the new deadline. When the timer is the only armed
+ *          one the alarm is cycled like in the reset/set pair. This is
+ *          meant for the frequent re-arm pattern found in protocol
+ *          retransmit paths.
+ * @pre     The timer must be in armed state before calling this function.
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ *
+ * @iclass
+ */
+void chVTRearmI(virtual_timer_t *vtp, sysinterval_t delay) {
+  vtfunc_t fn;
+
+  chDbgCheckClassI();
+  chDbgCheck((vtp != NULL) && (delay != TIME_IMMEDIATE));
+  chDbgAssert(vtp->func != NULL, "timer not set or already triggered");
+
+  fn = vtp->func;
+
+  /* Unlinking the timer without touching the hardware alarm, deltas are
+     kept consistent, the following insertion takes care of the alarm.
+     The only exception is the timer being the last armed one, in that
+     case the alarm must be stopped because the re-insertion takes the
+     empty-list path and starts it again for the new deadline.*/
+#if CH_CFG_OPTIMIZE_VT_WHEEL == TRUE
+  vtp->prev->next = vtp->next;
+  vtp->next->prev = vtp->prev;
+  ch.vtlist.cnt--;
+#if CH_CFG_ST_TIMEDELTA > 0
+  if (ch.vtlist.cnt == (cnt_t)0) {
+    port_timer_stop_alarm();
+  }
+#endif
+#else /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
+#if CH_CFG_ST_TIMEDELTA == 0
+  /* The delta of the timer is added to the next timer.*/
+  vtp->next->delta += vtp->delta;
+
+  /* Removing the element from the delta list.*/
+  vtp->prev->next = vtp->next;
+  vtp->next->prev = vtp->prev;
+
+  /* The above code changes the value in the header when the removed element
+     is the last of the list, restoring it.*/
+  ch.vtlist.delta = (sysinterval_t)-1;
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  /* Removing the element from the delta list.*/
+  vtp->prev->next = vtp->next;
+  vtp->next->prev = vtp->prev;
+
+  /* Adding delta to the next element, if it is not the list header.*/
+  if (&ch.vtlist != (virtual_timers_list_t *)vtp->next) {
+    vtp->next->delta += vtp->delta;
+  }
+
+  /* If the list became empty then the alarm is still armed for the old
+     deadline, stopping it so the re-insertion can start it fresh.*/
+  if (&ch.vtlist == (virtual_timers_list_t *)ch.vtlist.next) {
+    port_timer_stop_alarm();
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+#endif /* CH_CFG_OPTIMIZE_VT_WHEEL == FALSE */
+
+  /* Re-insertion with the new delay.*/
+  chVTDoSetI(vtp, delay, fn, vtp->par);
+}
 
 /** @} */
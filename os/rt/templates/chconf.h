@@ -118,6 +118,26 @@
  */
 #define CH_CFG_NO_IDLE_THREAD               FALSE
 
+/**
+ * @brief   Earliest Deadline First scheduling band.
+ * @details If enabled then threads can enter a deadline-driven scheduling
+ *          band placed above the whole fixed priorities range by declaring
+ *          a deadline with @p chThdSetDeadline().
+ *
+ * @note    The default is @p FALSE.
+ * @note    Not compatible with @p CH_CFG_OPTIMIZE_SCHED_BITMAP.
+ */
+#define CH_CFG_USE_EDF                      FALSE
+
+/**
+ * @brief   Multi-core support.
+ * @details If enabled then the cross-core wakeup queues are included in
+ *          the kernel.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_CFG_USE_SMP                      FALSE
+
 /** @} */
 
 /*===========================================================================*/
@@ -137,6 +157,69 @@
  */
 #define CH_CFG_OPTIMIZE_SPEED               TRUE
 
+/**
+ * @brief   Constant-time ready list.
+ * @details If enabled then the ready list is implemented as an array of
+ *          FIFO queues plus a bitmap of the non-empty priority levels,
+ *          making the scheduler operations constant-time.
+ *
+ * @note    This option trades RAM for a deterministic scheduler.
+ * @note    The default is @p FALSE.
+ */
+#define CH_CFG_OPTIMIZE_SCHED_BITMAP        FALSE
+
+/**
+ * @brief   Deferred ready list.
+ * @details If enabled then interrupt handlers can post thread wakeups into
+ *          a lock-free list using @p chSchDeferReadyX() without entering
+ *          the kernel critical zone.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires a compiler providing the GCC atomic builtins.
+ */
+#define CH_CFG_USE_DEFERRED_READY           FALSE
+
+/**
+ * @brief   Timer-wheel virtual timers.
+ * @details If enabled then the virtual timers are kept in a hashed timer
+ *          wheel instead of a single delta list, making the cost of the
+ *          timer operations independent from the number of active timers.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_CFG_OPTIMIZE_VT_WHEEL            FALSE
+
+/**
+ * @brief   Number of slots in the virtual timers wheel.
+ * @note    This value must be a power of two.
+ */
+#define CH_CFG_VT_WHEEL_SIZE                64
+
+/**
+ * @brief   Spin threshold for @p chThdSleep() in ticks.
+ * @details Delays not exceeding this threshold are performed with a polled
+ *          wait on the system time base instead of arming a virtual timer.
+ *
+ * @note    The default is @p 0, all delays go through the timers
+ *          subsystem.
+ */
+#define CH_CFG_THREAD_SPIN_THRESHOLD        0
+
+/**
+ * @brief   Adaptive spinning on contended mutexes.
+ * @details When enabled @p chMtxLock() performs a bounded number of polling
+ *          attempts before suspending the calling thread.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MUTEXES.
+ */
+#define CH_CFG_MTX_ADAPTIVE_SPIN            FALSE
+
+/**
+ * @brief   Number of polling attempts before suspending.
+ */
+#define CH_CFG_MTX_SPIN_COUNT               32
+
 /** @} */
 
 /*===========================================================================*/
@@ -155,6 +238,38 @@
  */
 #define CH_CFG_USE_TM                       TRUE
 
+/**
+ * @brief   Time Measurement histogram support.
+ * @details If enabled then measurement objects can optionally accumulate
+ *          a log2 histogram of the measured times.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TM.
+ */
+#define CH_CFG_TM_HISTOGRAM                 FALSE
+
+/**
+ * @brief   Per-thread CPU cycles accounting.
+ * @details If enabled then the realtime counter is sampled at each context
+ *          switch and the consumed cycles are accumulated in the switched
+ *          out thread.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p PORT_SUPPORTS_RT.
+ */
+#define CH_CFG_USE_THREAD_CYCLES            FALSE
+
+/**
+ * @brief   Idle cycles ledger.
+ * @details If enabled then the cycles spent at the idle priority level are
+ *          accumulated in a 64 bits ledger, measuring the true sleep
+ *          residency.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p PORT_SUPPORTS_RT.
+ */
+#define CH_CFG_USE_IDLE_CYCLES              FALSE
+
 /**
  * @brief   Threads registry APIs.
  * @details If enabled then the registry APIs are included in the kernel.
@@ -163,6 +278,22 @@
  */
 #define CH_CFG_USE_REGISTRY                 TRUE
 
+/**
+ * @brief   Registry thread identifiers.
+ * @details If enabled then every thread is assigned at creation a small
+ *          stable integer identifier and the hash of its name is cached
+ *          in the thread structure.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_REGISTRY.
+ */
+#define CH_CFG_USE_REGISTRY_IDS             FALSE
+
+/**
+ * @brief   Maximum number of registry thread identifiers.
+ */
+#define CH_CFG_REGISTRY_IDS_MAX             32
+
 /**
  * @brief   Threads synchronization APIs.
  * @details If enabled then the @p chThdWait() function is included in
@@ -191,6 +322,17 @@
  */
 #define CH_CFG_USE_SEMAPHORES_PRIORITY      FALSE
 
+/**
+ * @brief   Per-semaphore queuing policy.
+ * @details If enabled then the FIFO versus priority queuing order can be
+ *          selected on each semaphore, @p CH_CFG_USE_SEMAPHORES_PRIORITY
+ *          then only provides the default for new semaphores.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_SEMAPHORES.
+ */
+#define CH_CFG_USE_SEMAPHORES_POLICY        FALSE
+
 /**
  * @brief   Mutexes APIs.
  * @details If enabled then the mutexes APIs are included in the kernel.
@@ -209,6 +351,22 @@
  */
 #define CH_CFG_USE_MUTEXES_RECURSIVE        FALSE
 
+/**
+ * @brief   Readers-writer locks APIs.
+ * @details If enabled then the readers-writer locks APIs are included in
+ *          the kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MUTEXES.
+ */
+#define CH_CFG_USE_RWLOCKS                  FALSE
+
+/**
+ * @brief   Number of reader threads tracked for priority inheritance.
+ * @note    Requires @p CH_CFG_USE_RWLOCKS.
+ */
+#define CH_CFG_RWLOCK_TRACKED_READERS       4
+
 /**
  * @brief   Conditional Variables APIs.
  * @details If enabled then the conditional variables APIs are included
@@ -229,6 +387,17 @@
  */
 #define CH_CFG_USE_CONDVARS_TIMEOUT         TRUE
 
+/**
+ * @brief   Wait morphing on broadcast.
+ * @details When enabled @p chCondBroadcast() makes ready only the highest
+ *          priority waiter, the remaining waiters are moved directly on
+ *          the wait queue of the associated mutex.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_CONDVARS.
+ */
+#define CH_CFG_USE_CONDVARS_MORPHING        FALSE
+
 /**
  * @brief   Events Flags APIs.
  * @details If enabled then the event flags APIs are included in the kernel.
@@ -247,6 +416,27 @@
  */
 #define CH_CFG_USE_EVENTS_TIMEOUT           TRUE
 
+/**
+ * @brief   Priority-ordered event delivery.
+ * @details When enabled the listeners lists are kept ordered by listener
+ *          thread priority, broadcasts signal the highest priority
+ *          listeners first.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_EVENTS.
+ */
+#define CH_CFG_USE_EVENTS_PRIORITY          FALSE
+
+/**
+ * @brief   Deferred handlers APIs.
+ * @details If enabled then the deferred interrupt handlers APIs are
+ *          included in the kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_EVENTS.
+ */
+#define CH_CFG_USE_DEFERRED                 FALSE
+
 /**
  * @brief   Synchronous Messages APIs.
  * @details If enabled then the synchronous messages APIs are included
@@ -267,6 +457,16 @@
  */
 #define CH_CFG_USE_MESSAGES_PRIORITY        FALSE
 
+/**
+ * @brief   Priority inheritance on messages.
+ * @details If enabled then a server thread inherits the priority of the
+ *          highest priority client queued on it.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MESSAGES and @p CH_CFG_USE_MUTEXES.
+ */
+#define CH_CFG_USE_MESSAGES_INHERITANCE     FALSE
+
 /**
  * @brief   Mailboxes APIs.
  * @details If enabled then the asynchronous messages (mailboxes) APIs are
@@ -277,6 +477,27 @@
  */
 #define CH_CFG_USE_MAILBOXES                TRUE
 
+/**
+ * @brief   Lock-free mailboxes APIs.
+ * @details If enabled then the lock-free mailboxes APIs are included in
+ *          the kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires a compiler providing the GCC atomic builtins.
+ */
+#define CH_CFG_USE_MAILBOXES_LOCKFREE       FALSE
+
+/**
+ * @brief   Mailboxes occupancy statistics.
+ * @details If enabled then each mailbox tracks the peak number of queued
+ *          messages and all mailboxes initialized with @p chMBObjectInit()
+ *          can be enumerated using @p chMBGetNextX().
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MAILBOXES.
+ */
+#define CH_CFG_USE_MAILBOX_STATS            FALSE
+
 /**
  * @brief   Core Memory Manager APIs.
  * @details If enabled then the core memory manager APIs are included
@@ -298,6 +519,33 @@
  */
 #define CH_CFG_USE_HEAP                     TRUE
 
+/**
+ * @brief   TLSF heap backend.
+ * @details If enabled then memory heaps can optionally be initialized
+ *          with @p chHeapObjectInitTLSF(), allocations on such heaps are
+ *          performed in constant time with bounded fragmentation.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+
+/**
+ * @brief   Heap blocks guarding.
+ * @details If enabled then each allocated block is tagged with its owner
+ *          thread and followed by a pattern-filled redzone verified when
+ *          the block is freed.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#define CH_CFG_USE_HEAP_GUARD               FALSE
+
+/**
+ * @brief   Size of the redzone placed after each guarded block.
+ */
+#define CH_CFG_HEAP_GUARD_SIZE              16
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -316,6 +564,15 @@
  */
 #define CH_CFG_USE_OBJ_FIFOS                TRUE
 
+/**
+ * @brief   Work Queues APIs.
+ * @details If enabled then the work queues APIs are included
+ *          in the kernel.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_CFG_USE_WORKQUEUES               FALSE
+
 /**
  * @brief   Dynamic Threads APIs.
  * @details If enabled then the dynamic threads creation APIs are included
@@ -327,6 +584,27 @@
  */
 #define CH_CFG_USE_DYNAMIC                  TRUE
 
+/**
+ * @brief   Working areas recycling cache.
+ * @details If enabled then the working areas of terminated heap threads
+ *          are parked in a small cache keyed by size class and reused by
+ *          the next @p chThdCreateFromHeap() of a compatible size.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_DYNAMIC and @p CH_CFG_USE_HEAP.
+ */
+#define CH_CFG_USE_WA_CACHE                 FALSE
+
+/**
+ * @brief   Number of size classes in the working areas cache.
+ */
+#define CH_CFG_WA_CACHE_CLASSES             4
+
+/**
+ * @brief   Maximum number of parked working areas per size class.
+ */
+#define CH_CFG_WA_CACHE_DEPTH               4
+
 /** @} */
 
 /*===========================================================================*/
@@ -377,6 +655,23 @@
  */
 #define CH_CFG_FACTORY_OBJ_FIFOS            TRUE
 
+/**
+ * @brief   Enables the hash-indexed objects registry.
+ * @details If enabled then the factory maintains a hash table over all
+ *          the allocated/registered objects, find-by-name operations are
+ *          performed in constant time.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_CFG_FACTORY_HASH_INDEX           FALSE
+
+/**
+ * @brief   Number of slots in the factory hash table.
+ * @note    It must be a power of two and not lower than the maximum
+ *          number of objects simultaneously handled by the factory.
+ */
+#define CH_CFG_FACTORY_HASH_SIZE            64
+
 /** @} */
 
 /*===========================================================================*/
@@ -411,6 +706,16 @@
  */
 #define CH_DBG_ENABLE_CHECKS                TRUE
 
+/**
+ * @brief   Mask of the enabled parameter checks classes.
+ * @details The mask restricts @p CH_DBG_ENABLE_CHECKS to a subset of the
+ *          debug classes, checks belonging to classes not in the mask are
+ *          compiled out.
+ *
+ * @note    The default is @p CH_DBG_CLASS_MASK_ALL.
+ */
+#define CH_DBG_CHECKS_MASK                  CH_DBG_CLASS_MASK_ALL
+
 /**
  * @brief   Debug option, consistency checks.
  * @details If enabled then all the assertions in the kernel code are
@@ -421,6 +726,16 @@
  */
 #define CH_DBG_ENABLE_ASSERTS               TRUE
 
+/**
+ * @brief   Mask of the enabled assertions classes.
+ * @details The mask restricts @p CH_DBG_ENABLE_ASSERTS to a subset of the
+ *          debug classes, assertions belonging to classes not in the mask
+ *          are compiled out.
+ *
+ * @note    The default is @p CH_DBG_CLASS_MASK_ALL.
+ */
+#define CH_DBG_ASSERTS_MASK                 CH_DBG_CLASS_MASK_ALL
+
 /**
  * @brief   Debug option, trace buffer.
  * @details If enabled then the trace buffer is activated.
@@ -436,6 +751,21 @@
  */
 #define CH_DBG_TRACE_BUFFER_SIZE            128
 
+/**
+ * @brief   Compact trace mode.
+ * @details When enabled the trace records are stored in a variable-length
+ *          binary encoding, the buffer is split in two banks so a full
+ *          bank can be streamed out without stopping the capture.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_DBG_TRACE_COMPACT                FALSE
+
+/**
+ * @brief   Size in bytes of each of the two compact trace banks.
+ */
+#define CH_DBG_TRACE_COMPACT_BUFFER_SIZE    256
+
 /**
  * @brief   Debug option, stack checks.
  * @details If enabled then a runtime stack check is performed.
@@ -469,6 +799,34 @@
  */
 #define CH_DBG_THREADS_PROFILING            FALSE
 
+/**
+ * @brief   Events coalescing statistics.
+ * @details When enabled each listener counts the deliveries that found
+ *          the associated events mask already pending in the listening
+ *          thread.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_EVENTS.
+ */
+#define CH_DBG_EVENTS_COALESCING            FALSE
+
+/**
+ * @brief   Critical sections auditor.
+ * @details If enabled then each critical zone is measured individually
+ *          using the realtime counter and attributed to its call site,
+ *          the worst offenders are kept in a table.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_DBG_STATISTICS and a compiler providing the GCC
+ *          return address builtins.
+ */
+#define CH_DBG_AUDIT_CRITICAL               FALSE
+
+/**
+ * @brief   Number of entries in the worst offenders table.
+ */
+#define CH_DBG_AUDIT_CRITICAL_SLOTS         8
+
 /** @} */
 
 /*===========================================================================*/
@@ -0,0 +1,229 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    binlog.c
+ * @brief   Binary log code.
+ *
+ * @addtogroup binlog
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "binlog.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Head of the registered rings list.
+ */
+static binlog_ring_t *binlog_rings;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a binary log ring object.
+ * @details The ring is registered into the module list so drain code can
+ *          enumerate all the rings with @p binlogGetNext().
+ *
+ * @param[out] rp       pointer to the @p binlog_ring_t object
+ * @param[in] name      ring name shown by the drain side
+ * @param[in] buffer    records storage
+ * @param[in] n         number of records in the storage, must be a power
+ *                      of two
+ *
+ * @init
+ */
+void binlogObjectInit(binlog_ring_t *rp, const char *name,
+                      binlog_record_t *buffer, size_t n) {
+
+  chDbgCheck((rp != NULL) && (buffer != NULL) &&
+             (n > 0U) && ((n & (n - 1U)) == 0U));
+
+  rp->name    = name;
+  rp->buffer  = buffer;
+  rp->size    = n;
+  rp->wr      = 0U;
+  rp->rd      = 0U;
+  rp->dropped = 0U;
+
+  chSysLock();
+  rp->next     = binlog_rings;
+  binlog_rings = rp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stores a log record, deferred formatting.
+ * @details The format string address and the raw argument words are
+ *          stored without any formatting, the record is time stamped
+ *          like the kernel trace buffer entries. On a full ring the
+ *          record is discarded and accounted in the dropped counter.
+ * @note    The function must only be called from the single producer
+ *          context owning the ring, it does not lock nor block so it is
+ *          safe in control loops and ISRs.
+ * @note    The call sites normally use the @p BINLOGn() macros rather
+ *          than this function directly.
+ *
+ * @param[in] rp        pointer to the @p binlog_ring_t object
+ * @param[in] fmt       format string, also the message identifier
+ * @param[in] nargs     number of valid argument words
+ * @param[in] a0        first argument word
+ * @param[in] a1        second argument word
+ * @param[in] a2        third argument word
+ * @param[in] a3        fourth argument word
+ *
+ * @xclass
+ */
+void binlogWrite(binlog_ring_t *rp, const char *fmt, uint32_t nargs,
+                 uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+  size_t wr = rp->wr;
+  binlog_record_t *recp;
+
+  /* One slot is kept empty in order to distinguish the full condition.*/
+  if (((wr + 1U) & (rp->size - 1U)) == (rp->rd & (rp->size - 1U))) {
+    rp->dropped++;
+    return;
+  }
+
+  recp = &rp->buffer[wr & (rp->size - 1U)];
+  recp->fmt  = fmt;
+  recp->time = chVTGetSystemTimeX();
+#if PORT_SUPPORTS_RT == TRUE
+  recp->rtstamp = chSysGetRealtimeCounterX();
+#else
+  recp->rtstamp = (rtcnt_t)0;
+#endif
+  recp->nargs   = nargs;
+  recp->args[0] = a0;
+#if BINLOG_MAX_ARGS > 1
+  recp->args[1] = a1;
+#else
+  (void)a1;
+#endif
+#if BINLOG_MAX_ARGS > 2
+  recp->args[2] = a2;
+#else
+  (void)a2;
+#endif
+#if BINLOG_MAX_ARGS > 3
+  recp->args[3] = a3;
+#else
+  (void)a3;
+#endif
+
+  /* The write index is published after the record body.*/
+  rp->wr = wr + 1U;
+}
+
+/**
+ * @brief   Copies records out of a ring.
+ * @details The function can run concurrently with the producer, it is
+ *          the non-blocking drain side of the ring.
+ *
+ * @param[in] rp        pointer to the @p binlog_ring_t object
+ * @param[out] recp     destination records buffer
+ * @param[in] n         maximum number of records to be copied
+ * @return              The number of records effectively copied.
+ *
+ * @api
+ */
+size_t binlogFetch(binlog_ring_t *rp, binlog_record_t *recp, size_t n) {
+  size_t copied = 0U;
+
+  chDbgCheck((rp != NULL) && (recp != NULL));
+
+  while ((copied < n) && (rp->rd != rp->wr)) {
+    *recp = rp->buffer[rp->rd & (rp->size - 1U)];
+    recp++;
+    rp->rd++;
+    copied++;
+  }
+
+  return copied;
+}
+
+/**
+ * @brief   Enumerates the registered rings.
+ *
+ * @param[in] rp        previously returned ring or @p NULL for the first
+ *                      one
+ * @return              Pointer to the next registered ring.
+ * @retval NULL         if the list is exhausted.
+ *
+ * @api
+ */
+binlog_ring_t *binlogGetNext(binlog_ring_t *rp) {
+
+  if (rp == NULL) {
+    return binlog_rings;
+  }
+
+  return rp->next;
+}
+
+/**
+ * @brief   Formats a record onto a stream.
+ * @details Performs the formatting deferred by the call site, meant for
+ *          drain threads logging to a local channel, host tools would
+ *          instead resolve the format address against the image symbols.
+ *
+ * @param[in] chp       pointer to the output stream
+ * @param[in] recp      pointer to the record to be formatted
+ *
+ * @api
+ */
+void binlogFormat(BaseSequentialStream *chp, const binlog_record_t *recp) {
+
+  chDbgCheck((chp != NULL) && (recp != NULL));
+
+  chprintf(chp, "[%010lu] ", (unsigned long)recp->time);
+#if BINLOG_MAX_ARGS > 3
+  chprintf(chp, recp->fmt, recp->args[0], recp->args[1],
+           recp->args[2], recp->args[3]);
+#elif BINLOG_MAX_ARGS > 2
+  chprintf(chp, recp->fmt, recp->args[0], recp->args[1], recp->args[2]);
+#elif BINLOG_MAX_ARGS > 1
+  chprintf(chp, recp->fmt, recp->args[0], recp->args[1]);
+#else
+  chprintf(chp, recp->fmt, recp->args[0]);
+#endif
+  chprintf(chp, "\r\n");
+}
+
+/** @} */
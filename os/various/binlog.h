@@ -0,0 +1,174 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    binlog.h
+ * @brief   Binary log structures and macros.
+ * @details This module implements deferred-formatting logging. A call
+ *          site stores the format string address and the raw argument
+ *          words into a single-producer ring, a few stores in all, the
+ *          expensive formatting is performed later by a drain thread
+ *          through @p chprintf() or offline by a host tool resolving the
+ *          format addresses against the image. Each producer context
+ *          owns its own ring so no locking is required on the hot path.
+ *
+ * @addtogroup binlog
+ * @{
+ */
+
+#ifndef BINLOG_H
+#define BINLOG_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of argument words in a log record.
+ */
+#if !defined(BINLOG_MAX_ARGS) || defined(__DOXYGEN__)
+#define BINLOG_MAX_ARGS             4
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (BINLOG_MAX_ARGS < 1) || (BINLOG_MAX_ARGS > 4)
+#error "invalid BINLOG_MAX_ARGS value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a binary log record.
+ * @details The record carries the same time stamps used by the kernel
+ *          trace buffer so logs and context switch traces can be
+ *          correlated on a common time line.
+ */
+typedef struct {
+  /**
+   * @brief   Format string address, it identifies the message.
+   */
+  const char            *fmt;
+  /**
+   * @brief   Accurate time stamp.
+   * @note    This field is only valid if the port supports the realtime
+   *          counter else it is set to zero.
+   */
+  rtcnt_t               rtstamp;
+  /**
+   * @brief   System time stamp.
+   */
+  systime_t             time;
+  /**
+   * @brief   Number of valid argument words.
+   */
+  uint32_t              nargs;
+  /**
+   * @brief   Raw argument words.
+   */
+  uint32_t              args[BINLOG_MAX_ARGS];
+} binlog_record_t;
+
+/**
+ * @brief   Type of a binary log ring.
+ * @details Each ring accepts records from a single producer context, a
+ *          thread or an ISR, and is drained concurrently without locks.
+ */
+typedef struct binlog_ring {
+  /**
+   * @brief   Ring name shown by the drain side.
+   */
+  const char            *name;
+  /**
+   * @brief   Pointer to the records storage.
+   */
+  binlog_record_t       *buffer;
+  /**
+   * @brief   Number of records in the storage, power of two.
+   */
+  size_t                size;
+  /**
+   * @brief   Write index, written by the producer.
+   */
+  volatile size_t       wr;
+  /**
+   * @brief   Read index, written by the consumer.
+   */
+  volatile size_t       rd;
+  /**
+   * @brief   Records discarded because the ring was full.
+   */
+  volatile uint32_t     dropped;
+  /**
+   * @brief   Next ring in the registration list.
+   */
+  struct binlog_ring    *next;
+} binlog_ring_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @name    Log call sites
+ * @details The macros cast the arguments to word size and store them
+ *          without formatting, pointers passed for later formatting of
+ *          @p %s fields must reference constant strings.
+ * @{
+ */
+#define BINLOG0(rp, f)                                                      \
+  binlogWrite(rp, f, 0, 0U, 0U, 0U, 0U)
+#define BINLOG1(rp, f, a0)                                                  \
+  binlogWrite(rp, f, 1, (uint32_t)(a0), 0U, 0U, 0U)
+#define BINLOG2(rp, f, a0, a1)                                              \
+  binlogWrite(rp, f, 2, (uint32_t)(a0), (uint32_t)(a1), 0U, 0U)
+#define BINLOG3(rp, f, a0, a1, a2)                                          \
+  binlogWrite(rp, f, 3, (uint32_t)(a0), (uint32_t)(a1),                     \
+              (uint32_t)(a2), 0U)
+#define BINLOG4(rp, f, a0, a1, a2, a3)                                      \
+  binlogWrite(rp, f, 4, (uint32_t)(a0), (uint32_t)(a1),                     \
+              (uint32_t)(a2), (uint32_t)(a3))
+/** @} */
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void binlogObjectInit(binlog_ring_t *rp, const char *name,
+                        binlog_record_t *buffer, size_t n);
+  void binlogWrite(binlog_ring_t *rp, const char *fmt, uint32_t nargs,
+                   uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+  size_t binlogFetch(binlog_ring_t *rp, binlog_record_t *recp, size_t n);
+  binlog_ring_t *binlogGetNext(binlog_ring_t *rp);
+  void binlogFormat(BaseSequentialStream *chp, const binlog_record_t *recp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINLOG_H */
+
+/** @} */
@@ -0,0 +1,327 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.c
+ * @brief   Block device cache code.
+ *
+ * @addtogroup block_cache
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "blkcache.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/* Forward declarations required by bc_vmt.*/
+static bool bc_is_inserted(void *instance);
+static bool bc_is_protected(void *instance);
+static bool bc_connect(void *instance);
+static bool bc_disconnect(void *instance);
+static bool bc_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n);
+static bool bc_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n);
+static bool bc_sync(void *instance);
+static bool bc_get_info(void *instance, BlockDeviceInfo *bdip);
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct BaseBlockDeviceVMT bc_vmt = {
+  (size_t)0,
+  bc_is_inserted,
+  bc_is_protected,
+  bc_connect,
+  bc_disconnect,
+  bc_read,
+  bc_write,
+  bc_sync,
+  bc_get_info
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Searches the cache for the line starting at the specified block.
+ *
+ * @param[in] bcp       pointer to the @p BlockCache object
+ * @param[in] linestart first block of the searched line
+ * @return              The line pointer.
+ * @retval NULL         if the line is not cached.
+ */
+static blk_cache_line_t *bc_find(BlockCache *bcp, uint32_t linestart) {
+  uint32_t i;
+
+  for (i = 0; i < bcp->nlines; i++) {
+    if (bcp->lines[i].valid && (bcp->lines[i].startblk == linestart)) {
+      return &bcp->lines[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief   Selects the line to be replaced.
+ * @details Invalid lines are used first, else the least recently used
+ *          line is evicted.
+ *
+ * @param[in] bcp       pointer to the @p BlockCache object
+ * @return              The victim line pointer.
+ */
+static blk_cache_line_t *bc_victim(BlockCache *bcp) {
+  blk_cache_line_t *victim = &bcp->lines[0];
+  uint32_t i;
+
+  for (i = 0; i < bcp->nlines; i++) {
+    if (!bcp->lines[i].valid) {
+      return &bcp->lines[i];
+    }
+    if (bcp->lines[i].lru < victim->lru) {
+      victim = &bcp->lines[i];
+    }
+  }
+  return victim;
+}
+
+static bool bc_is_inserted(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkIsInserted(bcp->blkp);
+}
+
+static bool bc_is_protected(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkIsWriteProtected(bcp->blkp);
+}
+
+static bool bc_connect(void *instance) {
+  BlockCache *bcp = instance;
+
+  /* The media could have been replaced while disconnected.*/
+  blkcacheInvalidate(bcp);
+
+  if (blkConnect(bcp->blkp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  bcp->state = BLK_READY;
+  return HAL_SUCCESS;
+}
+
+static bool bc_disconnect(void *instance) {
+  BlockCache *bcp = instance;
+
+  blkcacheInvalidate(bcp);
+  bcp->state = BLK_ACTIVE;
+
+  return blkDisconnect(bcp->blkp);
+}
+
+static bool bc_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n) {
+  BlockCache *bcp = instance;
+
+  while (n > 0U) {
+    uint32_t linestart, offset, count;
+    blk_cache_line_t *lp;
+
+    linestart = (startblk / bcp->lineblocks) * bcp->lineblocks;
+    offset = startblk - linestart;
+    count = bcp->lineblocks - offset;
+    if (count > n) {
+      count = n;
+    }
+
+    lp = bc_find(bcp, linestart);
+    if (lp == NULL) {
+      BlockDeviceInfo bdi;
+
+      /* Partial lines at the end of the device are not cached, the
+         residual blocks are read directly.*/
+      if (blkGetInfo(bcp->blkp, &bdi) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      if (linestart + bcp->lineblocks > bdi.blk_num) {
+        return blkRead(bcp->blkp, startblk, buffer, n);
+      }
+
+      /* Fetching a whole aligned line with a single transfer.*/
+      lp = bc_victim(bcp);
+      lp->valid = false;
+      if (blkRead(bcp->blkp, linestart,
+                  lp->buffer, bcp->lineblocks) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      lp->startblk = linestart;
+      lp->valid = true;
+      bcp->misses += count;
+    }
+    else {
+      bcp->hits += count;
+    }
+    lp->lru = ++bcp->stamp;
+
+    memcpy(buffer, lp->buffer + ((size_t)offset * (size_t)bcp->blocksize),
+           (size_t)count * (size_t)bcp->blocksize);
+
+    startblk += count;
+    buffer   += (size_t)count * (size_t)bcp->blocksize;
+    n        -= count;
+  }
+  return HAL_SUCCESS;
+}
+
+static bool bc_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n) {
+  BlockCache *bcp = instance;
+  uint32_t i;
+
+  /* Write-through, the device is updated first.*/
+  if (blkWrite(bcp->blkp, startblk, buffer, n) != HAL_SUCCESS) {
+    /* The device content is uncertain, the overlapping lines are
+       discarded.*/
+    for (i = 0; i < bcp->nlines; i++) {
+      blk_cache_line_t *lp = &bcp->lines[i];
+
+      if (lp->valid && (lp->startblk < startblk + n) &&
+          (startblk < lp->startblk + bcp->lineblocks)) {
+        lp->valid = false;
+      }
+    }
+    return HAL_FAILED;
+  }
+
+  /* Updating the overlapping cached data.*/
+  for (i = 0; i < bcp->nlines; i++) {
+    blk_cache_line_t *lp = &bcp->lines[i];
+    uint32_t ovstart, ovend;
+
+    if (!lp->valid || (lp->startblk >= startblk + n) ||
+        (startblk >= lp->startblk + bcp->lineblocks)) {
+      continue;
+    }
+    ovstart = lp->startblk > startblk ? lp->startblk : startblk;
+    ovend = lp->startblk + bcp->lineblocks < startblk + n ?
+            lp->startblk + bcp->lineblocks : startblk + n;
+    memcpy(lp->buffer + ((size_t)(ovstart - lp->startblk) *
+                         (size_t)bcp->blocksize),
+           buffer + ((size_t)(ovstart - startblk) * (size_t)bcp->blocksize),
+           (size_t)(ovend - ovstart) * (size_t)bcp->blocksize);
+  }
+  return HAL_SUCCESS;
+}
+
+static bool bc_sync(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkSync(bcp->blkp);
+}
+
+static bool bc_get_info(void *instance, BlockDeviceInfo *bdip) {
+  BlockCache *bcp = instance;
+
+  return blkGetInfo(bcp->blkp, bdip);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p BlockCache object.
+ * @details The cache buffer is partitioned among the lines, it must be
+ *          at least @p nlines * @p lineblocks * @p blocksize bytes large
+ *          and satisfy the alignment requirements of the underlying
+ *          block driver.
+ *
+ * @param[out] bcp      pointer to the @p BlockCache object
+ * @param[in] blkp      pointer to the underlying block device
+ * @param[in] lines     cache line descriptors array
+ * @param[in] nlines    number of cache lines
+ * @param[in] lineblocks blocks per cache line
+ * @param[in] blocksize block size in bytes
+ * @param[in] buffer    cache data buffer
+ *
+ * @init
+ */
+void blkcacheObjectInit(BlockCache *bcp, BaseBlockDevice *blkp,
+                        blk_cache_line_t *lines, uint32_t nlines,
+                        uint32_t lineblocks, uint32_t blocksize,
+                        uint8_t *buffer) {
+  uint32_t i;
+
+  osalDbgCheck((bcp != NULL) && (blkp != NULL) && (lines != NULL) &&
+               (nlines > 0U) && (lineblocks > 0U) && (blocksize > 0U) &&
+               (buffer != NULL));
+
+  bcp->vmt        = &bc_vmt;
+  bcp->state      = BLK_ACTIVE;
+  bcp->blkp       = blkp;
+  bcp->lines      = lines;
+  bcp->nlines     = nlines;
+  bcp->lineblocks = lineblocks;
+  bcp->blocksize  = blocksize;
+  bcp->stamp      = 0U;
+  bcp->hits       = 0U;
+  bcp->misses     = 0U;
+  for (i = 0; i < nlines; i++) {
+    lines[i].valid  = false;
+    lines[i].lru    = 0U;
+    lines[i].buffer = buffer +
+                      ((size_t)i * (size_t)lineblocks * (size_t)blocksize);
+  }
+}
+
+/**
+ * @brief   Discards the whole cache content.
+ * @details Must be invoked if the device content is changed bypassing the
+ *          cache object.
+ *
+ * @param[in] bcp       pointer to the @p BlockCache object
+ *
+ * @api
+ */
+void blkcacheInvalidate(BlockCache *bcp) {
+  uint32_t i;
+
+  osalDbgCheck(bcp != NULL);
+
+  for (i = 0; i < bcp->nlines; i++) {
+    bcp->lines[i].valid = false;
+  }
+}
+
+/** @} */
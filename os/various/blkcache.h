@@ -0,0 +1,146 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.h
+ * @brief   Block device cache structures and macros.
+ * @details This module implements a read-ahead cache layered over the
+ *          abstract block device interface defined in hal_ioblock.h. The
+ *          cache object is itself a @p BaseBlockDevice so it can be
+ *          placed transparently between a file system and any block
+ *          driver, typically SDC or MMC_SPI. Reads are served in
+ *          multi-block cache lines: a miss fetches a whole aligned line
+ *          from the device with a single transfer so sequential scans
+ *          pay the command latency once per line instead of once per
+ *          block. Lines are replaced in LRU order, writes are performed
+ *          write-through and update the overlapping cached data.
+ *
+ * @addtogroup block_cache
+ * @{
+ */
+
+#ifndef BLKCACHE_H
+#define BLKCACHE_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a cache line descriptor.
+ */
+typedef struct {
+  /**
+   * @brief   First block cached in the line, aligned to the line size.
+   */
+  uint32_t              startblk;
+  /**
+   * @brief   Last-use stamp for the LRU replacement.
+   */
+  uint32_t              lru;
+  /**
+   * @brief   Line validity flag.
+   */
+  bool                  valid;
+  /**
+   * @brief   Pointer to the line data inside the cache buffer.
+   */
+  uint8_t               *buffer;
+} blk_cache_line_t;
+
+/**
+ * @extends BaseBlockDevice
+ *
+ * @brief   Type of a cached block device.
+ * @note    Accesses are not internally serialized, as for the underlying
+ *          block drivers the caller is expected to serialize the access
+ *          to the device.
+ */
+typedef struct {
+  /**
+   * @brief   Virtual Methods Table.
+   */
+  const struct BaseBlockDeviceVMT *vmt;
+  _base_block_device_data
+  /**
+   * @brief   Pointer to the underlying block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   Cache lines array.
+   */
+  blk_cache_line_t      *lines;
+  /**
+   * @brief   Number of cache lines.
+   */
+  uint32_t              nlines;
+  /**
+   * @brief   Blocks per cache line.
+   */
+  uint32_t              lineblocks;
+  /**
+   * @brief   Block size in bytes.
+   */
+  uint32_t              blocksize;
+  /**
+   * @brief   Monotonic stamp source for the LRU replacement.
+   */
+  uint32_t              stamp;
+  /**
+   * @brief   Blocks served from the cache.
+   */
+  uint32_t              hits;
+  /**
+   * @brief   Blocks fetched from the device.
+   */
+  uint32_t              misses;
+} BlockCache;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blkcacheObjectInit(BlockCache *bcp, BaseBlockDevice *blkp,
+                          blk_cache_line_t *lines, uint32_t nlines,
+                          uint32_t lineblocks, uint32_t blocksize,
+                          uint8_t *buffer);
+  void blkcacheInvalidate(BlockCache *bcp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKCACHE_H */
+
+/** @} */
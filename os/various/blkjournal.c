@@ -0,0 +1,333 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkjournal.c
+ * @brief   Block device write journal code.
+ *
+ * @addtogroup block_journal
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "blkjournal.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/* Forward declarations required by bj_vmt.*/
+static bool bj_is_inserted(void *instance);
+static bool bj_is_protected(void *instance);
+static bool bj_connect(void *instance);
+static bool bj_disconnect(void *instance);
+static bool bj_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n);
+static bool bj_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n);
+static bool bj_sync(void *instance);
+static bool bj_get_info(void *instance, BlockDeviceInfo *bdip);
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct BaseBlockDeviceVMT bj_vmt = {
+  (size_t)0,
+  bj_is_inserted,
+  bj_is_protected,
+  bj_connect,
+  bj_disconnect,
+  bj_read,
+  bj_write,
+  bj_sync,
+  bj_get_info
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Finds the journal position for the specified block.
+ * @details The returned position is either the entry holding the block or
+ *          the insertion point keeping the journal sorted.
+ *
+ * @param[in] bjp       pointer to the @p BlkJournal object
+ * @param[in] blk       searched block number
+ * @return              The journal position.
+ */
+static uint32_t bj_position(BlkJournal *bjp, uint32_t blk) {
+  uint32_t i;
+
+  for (i = 0; i < bjp->n; i++) {
+    if (bjp->blkidx[i] >= blk) {
+      break;
+    }
+  }
+  return i;
+}
+
+/**
+ * @brief   Removes the journal entries overlapping the specified range.
+ * @details Used when a write bypassing the journal supersedes journaled
+ *          data.
+ *
+ * @param[in] bjp       pointer to the @p BlkJournal object
+ * @param[in] startblk  first block of the range
+ * @param[in] n         number of blocks in the range
+ */
+static void bj_discard(BlkJournal *bjp, uint32_t startblk, uint32_t n) {
+  uint32_t first, last;
+
+  first = bj_position(bjp, startblk);
+  last = bj_position(bjp, startblk + n);
+  if (last > first) {
+    memmove(&bjp->blkidx[first], &bjp->blkidx[last],
+            (size_t)(bjp->n - last) * sizeof (uint32_t));
+    memmove(bjp->buffer + ((size_t)first * (size_t)bjp->blocksize),
+            bjp->buffer + ((size_t)last * (size_t)bjp->blocksize),
+            (size_t)(bjp->n - last) * (size_t)bjp->blocksize);
+    bjp->n -= last - first;
+  }
+}
+
+static bool bj_is_inserted(void *instance) {
+  BlkJournal *bjp = instance;
+
+  return blkIsInserted(bjp->blkp);
+}
+
+static bool bj_is_protected(void *instance) {
+  BlkJournal *bjp = instance;
+
+  return blkIsWriteProtected(bjp->blkp);
+}
+
+static bool bj_connect(void *instance) {
+  BlkJournal *bjp = instance;
+
+  /* The media could have been replaced while disconnected, the stale
+     journal content is discarded.*/
+  bjp->n = 0U;
+
+  if (blkConnect(bjp->blkp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  bjp->state = BLK_READY;
+  return HAL_SUCCESS;
+}
+
+static bool bj_disconnect(void *instance) {
+  BlkJournal *bjp = instance;
+
+  /* Journaled data must reach the media before disconnecting, on flush
+     failure the device is left connected so the operation can be
+     retried.*/
+  if (blkjournalFlush(bjp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  bjp->state = BLK_ACTIVE;
+
+  return blkDisconnect(bjp->blkp);
+}
+
+static bool bj_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n) {
+  BlkJournal *bjp = instance;
+  uint32_t i;
+
+  if (blkRead(bjp->blkp, startblk, buffer, n) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+
+  /* Journaled blocks are more recent than the media, overlaying them on
+     the read data.*/
+  for (i = bj_position(bjp, startblk); i < bjp->n; i++) {
+    if (bjp->blkidx[i] >= startblk + n) {
+      break;
+    }
+    memcpy(buffer + ((size_t)(bjp->blkidx[i] - startblk) *
+                     (size_t)bjp->blocksize),
+           bjp->buffer + ((size_t)i * (size_t)bjp->blocksize),
+           (size_t)bjp->blocksize);
+  }
+  return HAL_SUCCESS;
+}
+
+static bool bj_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n) {
+  BlkJournal *bjp = instance;
+  uint32_t pos;
+
+  /* Multi-block writes are already efficient, they bypass the journal
+     after discarding the superseded entries.*/
+  if (n > 1U) {
+    bj_discard(bjp, startblk, n);
+    return blkWrite(bjp->blkp, startblk, buffer, n);
+  }
+
+  pos = bj_position(bjp, startblk);
+  if ((pos < bjp->n) && (bjp->blkidx[pos] == startblk)) {
+    /* The block is already journaled, updating it in place.*/
+    memcpy(bjp->buffer + ((size_t)pos * (size_t)bjp->blocksize),
+           buffer, (size_t)bjp->blocksize);
+    bjp->absorbed++;
+    return HAL_SUCCESS;
+  }
+
+  if (bjp->n >= bjp->nmax) {
+    if (blkjournalFlush(bjp) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+    pos = 0U;
+  }
+
+  /* Inserting the block keeping the journal sorted, the data buffer is
+     shifted together with the index so consecutive block numbers map to
+     consecutive memory and can be flushed with a single transfer.*/
+  memmove(&bjp->blkidx[pos + 1U], &bjp->blkidx[pos],
+          (size_t)(bjp->n - pos) * sizeof (uint32_t));
+  memmove(bjp->buffer + ((size_t)(pos + 1U) * (size_t)bjp->blocksize),
+          bjp->buffer + ((size_t)pos * (size_t)bjp->blocksize),
+          (size_t)(bjp->n - pos) * (size_t)bjp->blocksize);
+  bjp->blkidx[pos] = startblk;
+  memcpy(bjp->buffer + ((size_t)pos * (size_t)bjp->blocksize),
+         buffer, (size_t)bjp->blocksize);
+  bjp->n++;
+  bjp->absorbed++;
+  return HAL_SUCCESS;
+}
+
+static bool bj_sync(void *instance) {
+  BlkJournal *bjp = instance;
+
+  if (blkjournalFlush(bjp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  return blkSync(bjp->blkp);
+}
+
+static bool bj_get_info(void *instance, BlockDeviceInfo *bdip) {
+  BlkJournal *bjp = instance;
+
+  return blkGetInfo(bjp->blkp, bdip);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p BlkJournal object.
+ * @details The journal buffer must be at least @p nmax * @p blocksize
+ *          bytes large and satisfy the alignment requirements of the
+ *          underlying block driver.
+ *
+ * @param[out] bjp      pointer to the @p BlkJournal object
+ * @param[in] blkp      pointer to the underlying block device
+ * @param[in] blkidx    block numbers array, @p nmax elements
+ * @param[in] nmax      journal capacity in blocks
+ * @param[in] blocksize block size in bytes
+ * @param[in] buffer    journal data buffer
+ *
+ * @init
+ */
+void blkjournalObjectInit(BlkJournal *bjp, BaseBlockDevice *blkp,
+                          uint32_t *blkidx, uint32_t nmax,
+                          uint32_t blocksize, uint8_t *buffer) {
+
+  osalDbgCheck((bjp != NULL) && (blkp != NULL) && (blkidx != NULL) &&
+               (nmax > 0U) && (blocksize > 0U) && (buffer != NULL));
+
+  bjp->vmt       = &bj_vmt;
+  bjp->state     = BLK_ACTIVE;
+  bjp->blkp      = blkp;
+  bjp->blkidx    = blkidx;
+  bjp->buffer    = buffer;
+  bjp->n         = 0U;
+  bjp->nmax      = nmax;
+  bjp->blocksize = blocksize;
+  bjp->absorbed  = 0U;
+  bjp->transfers = 0U;
+}
+
+/**
+ * @brief   Flushes the journal content to the device.
+ * @details Journaled blocks are written in ascending order, runs of
+ *          consecutive blocks are merged into single multi-block
+ *          transfers. The function acts as a write barrier: on success
+ *          all previously journaled data is on the device.
+ * @note    On failure the blocks not yet transferred are retained in the
+ *          journal so the flush can be retried.
+ *
+ * @param[in] bjp       pointer to the @p BlkJournal object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool blkjournalFlush(BlkJournal *bjp) {
+  uint32_t i;
+
+  osalDbgCheck(bjp != NULL);
+
+  i = 0;
+  while (i < bjp->n) {
+    uint32_t runlen = 1;
+
+    /* Extending the run over consecutive block numbers, the sorted
+       insertion guarantees the data is consecutive in memory too.*/
+    while ((i + runlen < bjp->n) &&
+           (bjp->blkidx[i + runlen] == bjp->blkidx[i] + runlen)) {
+      runlen++;
+    }
+
+    if (blkWrite(bjp->blkp, bjp->blkidx[i],
+                 bjp->buffer + ((size_t)i * (size_t)bjp->blocksize),
+                 runlen) != HAL_SUCCESS) {
+      /* Retaining the entries not yet written.*/
+      memmove(&bjp->blkidx[0], &bjp->blkidx[i],
+              (size_t)(bjp->n - i) * sizeof (uint32_t));
+      memmove(bjp->buffer,
+              bjp->buffer + ((size_t)i * (size_t)bjp->blocksize),
+              (size_t)(bjp->n - i) * (size_t)bjp->blocksize);
+      bjp->n -= i;
+      return HAL_FAILED;
+    }
+    bjp->transfers++;
+    i += runlen;
+  }
+  bjp->n = 0U;
+  return HAL_SUCCESS;
+}
+
+/** @} */
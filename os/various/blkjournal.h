@@ -0,0 +1,127 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkjournal.h
+ * @brief   Block device write journal structures and macros.
+ * @details This module implements a write coalescing journal layered over
+ *          the abstract block device interface defined in hal_ioblock.h.
+ *          The journal object is itself a @p BaseBlockDevice so it can be
+ *          placed transparently between a file system and any block
+ *          driver, typically SDC or MMC_SPI. Single-block writes, the
+ *          common case for FAT metadata updates, are retained in the
+ *          journal instead of being sent to the device immediately; the
+ *          journal is kept sorted by block number so that a flush can
+ *          merge runs of consecutive dirty blocks into multi-block
+ *          transfers, paying the write command latency once per run.
+ *          Multi-block writes bypass the journal, reads are served from
+ *          the journal content where it is more recent than the media.
+ *          The @p blkjournalFlush() function acts as a write barrier: on
+ *          return all journaled data is on the device.
+ *
+ * @addtogroup block_journal
+ * @{
+ */
+
+#ifndef BLKJOURNAL_H
+#define BLKJOURNAL_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @extends BaseBlockDevice
+ *
+ * @brief   Type of a journaled block device.
+ * @note    Accesses are not internally serialized, as for the underlying
+ *          block drivers the caller is expected to serialize the access
+ *          to the device.
+ */
+typedef struct {
+  /**
+   * @brief   Virtual Methods Table.
+   */
+  const struct BaseBlockDeviceVMT *vmt;
+  _base_block_device_data
+  /**
+   * @brief   Pointer to the underlying block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   Journaled block numbers, sorted in ascending order.
+   */
+  uint32_t              *blkidx;
+  /**
+   * @brief   Journal data buffer, entries stored in @p blkidx order.
+   */
+  uint8_t               *buffer;
+  /**
+   * @brief   Number of journaled blocks.
+   */
+  uint32_t              n;
+  /**
+   * @brief   Journal capacity in blocks.
+   */
+  uint32_t              nmax;
+  /**
+   * @brief   Block size in bytes.
+   */
+  uint32_t              blocksize;
+  /**
+   * @brief   Single-block writes absorbed by the journal.
+   */
+  uint32_t              absorbed;
+  /**
+   * @brief   Device transfers issued by flush operations.
+   */
+  uint32_t              transfers;
+} BlkJournal;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blkjournalObjectInit(BlkJournal *bjp, BaseBlockDevice *blkp,
+                            uint32_t *blkidx, uint32_t nmax,
+                            uint32_t blocksize, uint8_t *buffer);
+  bool blkjournalFlush(BlkJournal *bjp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKJOURNAL_H */
+
+/** @} */
@@ -0,0 +1,177 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkpart.c
+ * @brief   Block device partition view code.
+ *
+ * @addtogroup block_partition
+ * @{
+ */
+
+#include "hal.h"
+#include "blkpart.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/* Forward declarations required by bp_vmt.*/
+static bool bp_is_inserted(void *instance);
+static bool bp_is_protected(void *instance);
+static bool bp_connect(void *instance);
+static bool bp_disconnect(void *instance);
+static bool bp_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n);
+static bool bp_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n);
+static bool bp_sync(void *instance);
+static bool bp_get_info(void *instance, BlockDeviceInfo *bdip);
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct BaseBlockDeviceVMT bp_vmt = {
+  (size_t)0,
+  bp_is_inserted,
+  bp_is_protected,
+  bp_connect,
+  bp_disconnect,
+  bp_read,
+  bp_write,
+  bp_sync,
+  bp_get_info
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool bp_is_inserted(void *instance) {
+  BlockPartition *bpp = instance;
+
+  return blkIsInserted(bpp->blkp);
+}
+
+static bool bp_is_protected(void *instance) {
+  BlockPartition *bpp = instance;
+
+  return blkIsWriteProtected(bpp->blkp);
+}
+
+static bool bp_connect(void *instance) {
+  BlockPartition *bpp = instance;
+
+  /* The underlying device could be shared by other partition objects
+     and already connected.*/
+  if (blkGetDriverState(bpp->blkp) != BLK_READY) {
+    if (blkConnect(bpp->blkp) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+  bpp->state = BLK_READY;
+  return HAL_SUCCESS;
+}
+
+static bool bp_disconnect(void *instance) {
+  BlockPartition *bpp = instance;
+
+  bpp->state = BLK_ACTIVE;
+
+  /* The underlying device is left connected, other partition objects
+     could still be using it.*/
+  return HAL_SUCCESS;
+}
+
+static bool bp_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n) {
+  BlockPartition *bpp = instance;
+
+  if ((startblk + n) > bpp->nblocks) {
+    return HAL_FAILED;
+  }
+  return blkRead(bpp->blkp, bpp->startblk + startblk, buffer, n);
+}
+
+static bool bp_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n) {
+  BlockPartition *bpp = instance;
+
+  if ((startblk + n) > bpp->nblocks) {
+    return HAL_FAILED;
+  }
+  return blkWrite(bpp->blkp, bpp->startblk + startblk, buffer, n);
+}
+
+static bool bp_sync(void *instance) {
+  BlockPartition *bpp = instance;
+
+  return blkSync(bpp->blkp);
+}
+
+static bool bp_get_info(void *instance, BlockDeviceInfo *bdip) {
+  BlockPartition *bpp = instance;
+
+  if (blkGetInfo(bpp->blkp, bdip) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  bdip->blk_num = bpp->nblocks;
+  return HAL_SUCCESS;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p BlockPartition object.
+ * @note    The specified range is not validated against the underlying
+ *          device geometry at initialization time because the device
+ *          could be not yet connected, out of range accesses fail at
+ *          the underlying driver.
+ *
+ * @param[out] bpp      pointer to the @p BlockPartition object
+ * @param[in] blkp      pointer to the underlying block device
+ * @param[in] startblk  first block of the partition
+ * @param[in] nblocks   number of blocks in the partition
+ *
+ * @init
+ */
+void blkpartObjectInit(BlockPartition *bpp, BaseBlockDevice *blkp,
+                       uint32_t startblk, uint32_t nblocks) {
+
+  osalDbgCheck((bpp != NULL) && (blkp != NULL) && (nblocks > 0U));
+
+  bpp->vmt      = &bp_vmt;
+  bpp->state    = BLK_ACTIVE;
+  bpp->blkp     = blkp;
+  bpp->startblk = startblk;
+  bpp->nblocks  = nblocks;
+}
+
+/** @} */
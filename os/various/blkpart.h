@@ -0,0 +1,99 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkpart.h
+ * @brief   Block device partition view structures and macros.
+ * @details This module implements a partition view layered over the
+ *          abstract block device interface defined in hal_ioblock.h. The
+ *          partition object is itself a @p BaseBlockDevice exposing a
+ *          contiguous range of the underlying device as a device of its
+ *          own, so file systems and other adapters can be stacked on a
+ *          region of a larger medium without per-project offsetting
+ *          glue. Multiple partition objects can share one underlying
+ *          device.
+ *
+ * @addtogroup block_partition
+ * @{
+ */
+
+#ifndef BLKPART_H
+#define BLKPART_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @extends BaseBlockDevice
+ *
+ * @brief   Type of a block device partition view.
+ * @note    Accesses are not internally serialized, as for the underlying
+ *          block drivers the caller is expected to serialize the access
+ *          to the device.
+ */
+typedef struct {
+  /**
+   * @brief   Virtual Methods Table.
+   */
+  const struct BaseBlockDeviceVMT *vmt;
+  _base_block_device_data
+  /**
+   * @brief   Pointer to the underlying block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   First block of the partition on the underlying device.
+   */
+  uint32_t              startblk;
+  /**
+   * @brief   Number of blocks in the partition.
+   */
+  uint32_t              nblocks;
+} BlockPartition;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blkpartObjectInit(BlockPartition *bpp, BaseBlockDevice *blkp,
+                         uint32_t startblk, uint32_t nblocks);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKPART_H */
+
+/** @} */
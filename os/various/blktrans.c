@@ -0,0 +1,359 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blktrans.c
+ * @brief   Block size translation code.
+ *
+ * @addtogroup block_translation
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "blktrans.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/* Forward declarations required by bt_vmt.*/
+static bool bt_is_inserted(void *instance);
+static bool bt_is_protected(void *instance);
+static bool bt_connect(void *instance);
+static bool bt_disconnect(void *instance);
+static bool bt_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n);
+static bool bt_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n);
+static bool bt_sync(void *instance);
+static bool bt_get_info(void *instance, BlockDeviceInfo *bdip);
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct BaseBlockDeviceVMT bt_vmt = {
+  (size_t)0,
+  bt_is_inserted,
+  bt_is_protected,
+  bt_connect,
+  bt_disconnect,
+  bt_read,
+  bt_write,
+  bt_sync,
+  bt_get_info
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Writes back the translation buffer if modified.
+ *
+ * @param[in] btp       pointer to the @p BlockTranslation object
+ * @return              The operation status.
+ */
+static bool bt_flush_buffer(BlockTranslation *btp) {
+
+  if (btp->valid && btp->dirty) {
+    if (blkWrite(btp->blkp, btp->cachedblk, btp->buffer, 1U) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+    btp->dirty = false;
+  }
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Loads a physical block into the translation buffer.
+ * @details A previously buffered modified block is written back first.
+ *
+ * @param[in] btp       pointer to the @p BlockTranslation object
+ * @param[in] pblk      physical block to be loaded
+ * @return              The operation status.
+ */
+static bool bt_load_buffer(BlockTranslation *btp, uint32_t pblk) {
+
+  if (btp->valid && (btp->cachedblk == pblk)) {
+    return HAL_SUCCESS;
+  }
+  if (bt_flush_buffer(btp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  btp->valid = false;
+  if (blkRead(btp->blkp, pblk, btp->buffer, 1U) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  btp->cachedblk = pblk;
+  btp->valid = true;
+  return HAL_SUCCESS;
+}
+
+static bool bt_is_inserted(void *instance) {
+  BlockTranslation *btp = instance;
+
+  return blkIsInserted(btp->blkp);
+}
+
+static bool bt_is_protected(void *instance) {
+  BlockTranslation *btp = instance;
+
+  return blkIsWriteProtected(btp->blkp);
+}
+
+static bool bt_connect(void *instance) {
+  BlockTranslation *btp = instance;
+
+  /* The media could have been replaced while disconnected.*/
+  btp->valid = false;
+  btp->dirty = false;
+
+  if (blkConnect(btp->blkp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  btp->state = BLK_READY;
+  return HAL_SUCCESS;
+}
+
+static bool bt_disconnect(void *instance) {
+  BlockTranslation *btp = instance;
+
+  /* Modified buffered data must reach the media, on failure the device
+     is left connected so that the operation can be retried.*/
+  if (bt_flush_buffer(btp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  btp->valid = false;
+  btp->state = BLK_ACTIVE;
+
+  return blkDisconnect(btp->blkp);
+}
+
+static bool bt_read(void *instance, uint32_t startblk,
+                    uint8_t *buffer, uint32_t n) {
+  BlockTranslation *btp = instance;
+
+  if (btp->lsize > btp->psize) {
+    /* Aggregating translation, one logical block maps onto a run of
+       physical blocks, no buffering involved.*/
+    return blkRead(btp->blkp, startblk * btp->factor,
+                   buffer, n * btp->factor);
+  }
+
+  while (n > 0U) {
+    uint32_t pblk   = startblk / btp->factor;
+    uint32_t offset = startblk % btp->factor;
+
+    if ((offset == 0U) && (n >= btp->factor)) {
+      uint32_t pcount = n / btp->factor;
+
+      /* Aligned whole physical blocks bypass the buffer, a buffered
+         modified block in the range is written back first so that the
+         media is current.*/
+      if (btp->valid && btp->dirty &&
+          (btp->cachedblk >= pblk) && (btp->cachedblk < pblk + pcount)) {
+        if (bt_flush_buffer(btp) != HAL_SUCCESS) {
+          return HAL_FAILED;
+        }
+      }
+      if (blkRead(btp->blkp, pblk, buffer, pcount) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      startblk += pcount * btp->factor;
+      buffer   += (size_t)pcount * (size_t)btp->psize;
+      n        -= pcount * btp->factor;
+    }
+    else {
+      uint32_t cnt = btp->factor - offset;
+
+      if (cnt > n) {
+        cnt = n;
+      }
+      if (bt_load_buffer(btp, pblk) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      memcpy(buffer,
+             btp->buffer + ((size_t)offset * (size_t)btp->lsize),
+             (size_t)cnt * (size_t)btp->lsize);
+      startblk += cnt;
+      buffer   += (size_t)cnt * (size_t)btp->lsize;
+      n        -= cnt;
+    }
+  }
+  return HAL_SUCCESS;
+}
+
+static bool bt_write(void *instance, uint32_t startblk,
+                     const uint8_t *buffer, uint32_t n) {
+  BlockTranslation *btp = instance;
+
+  if (btp->lsize > btp->psize) {
+    /* Aggregating translation, one logical block maps onto a run of
+       physical blocks, no buffering involved.*/
+    return blkWrite(btp->blkp, startblk * btp->factor,
+                    buffer, n * btp->factor);
+  }
+
+  while (n > 0U) {
+    uint32_t pblk   = startblk / btp->factor;
+    uint32_t offset = startblk % btp->factor;
+
+    if ((offset == 0U) && (n >= btp->factor)) {
+      uint32_t pcount = n / btp->factor;
+
+      /* Aligned whole physical blocks bypass the buffer, buffered data
+         falling in the written range is superseded.*/
+      if (btp->valid &&
+          (btp->cachedblk >= pblk) && (btp->cachedblk < pblk + pcount)) {
+        btp->valid = false;
+        btp->dirty = false;
+      }
+      if (blkWrite(btp->blkp, pblk, buffer, pcount) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      startblk += pcount * btp->factor;
+      buffer   += (size_t)pcount * (size_t)btp->psize;
+      n        -= pcount * btp->factor;
+    }
+    else {
+      uint32_t cnt = btp->factor - offset;
+
+      if (cnt > n) {
+        cnt = n;
+      }
+
+      /* Read-modify-write through the translation buffer, the write
+         back is lazy: further sub-block updates of the same physical
+         block are absorbed by the buffer.*/
+      if (btp->valid && btp->dirty && (btp->cachedblk == pblk)) {
+        btp->absorbed++;
+      }
+      if (bt_load_buffer(btp, pblk) != HAL_SUCCESS) {
+        return HAL_FAILED;
+      }
+      memcpy(btp->buffer + ((size_t)offset * (size_t)btp->lsize),
+             buffer,
+             (size_t)cnt * (size_t)btp->lsize);
+      btp->dirty = true;
+      startblk += cnt;
+      buffer   += (size_t)cnt * (size_t)btp->lsize;
+      n        -= cnt;
+    }
+  }
+  return HAL_SUCCESS;
+}
+
+static bool bt_sync(void *instance) {
+  BlockTranslation *btp = instance;
+
+  if (bt_flush_buffer(btp) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  return blkSync(btp->blkp);
+}
+
+static bool bt_get_info(void *instance, BlockDeviceInfo *bdip) {
+  BlockTranslation *btp = instance;
+
+  if (blkGetInfo(btp->blkp, bdip) != HAL_SUCCESS) {
+    return HAL_FAILED;
+  }
+  if (btp->lsize > btp->psize) {
+    bdip->blk_num = bdip->blk_num / btp->factor;
+  }
+  else {
+    bdip->blk_num = bdip->blk_num * btp->factor;
+  }
+  bdip->blk_size = btp->lsize;
+  return HAL_SUCCESS;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p BlockTranslation object.
+ * @details The two block sizes must be different and one must be a
+ *          multiple of the other.
+ *
+ * @param[out] btp      pointer to the @p BlockTranslation object
+ * @param[in] blkp      pointer to the underlying block device
+ * @param[in] lsize     exposed logical block size in bytes
+ * @param[in] psize     physical block size of the underlying device
+ * @param[in] buffer    one physical block sized buffer used for the
+ *                      read-modify-write sequences, can be @p NULL when
+ *                      @p lsize is larger than @p psize
+ *
+ * @init
+ */
+void blktransObjectInit(BlockTranslation *btp, BaseBlockDevice *blkp,
+                        uint32_t lsize, uint32_t psize, uint8_t *buffer) {
+
+  osalDbgCheck((btp != NULL) && (blkp != NULL) &&
+               (lsize > 0U) && (psize > 0U) && (lsize != psize));
+  osalDbgCheck((lsize > psize) ? ((lsize % psize) == 0U)
+                               : (((psize % lsize) == 0U) &&
+                                  (buffer != NULL)));
+
+  btp->vmt       = &bt_vmt;
+  btp->state     = BLK_ACTIVE;
+  btp->blkp      = blkp;
+  btp->lsize     = lsize;
+  btp->psize     = psize;
+  btp->factor    = (lsize > psize) ? (lsize / psize) : (psize / lsize);
+  btp->cachedblk = 0U;
+  btp->valid     = false;
+  btp->dirty     = false;
+  btp->buffer    = buffer;
+  btp->absorbed  = 0U;
+}
+
+/**
+ * @brief   Writes back buffered modified data.
+ * @details Equivalent to a partial @p blkSync(), the underlying device
+ *          is not synchronized.
+ *
+ * @param[in] btp       pointer to the @p BlockTranslation object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  the operation succeeded.
+ * @retval HAL_FAILED   the operation failed.
+ *
+ * @api
+ */
+bool blktransFlush(BlockTranslation *btp) {
+
+  osalDbgCheck(btp != NULL);
+
+  return bt_flush_buffer(btp);
+}
+
+/** @} */
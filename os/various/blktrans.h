@@ -0,0 +1,130 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blktrans.h
+ * @brief   Block size translation structures and macros.
+ * @details This module implements a block size translation layered over
+ *          the abstract block device interface defined in hal_ioblock.h.
+ *          The translation object is itself a @p BaseBlockDevice
+ *          exposing the underlying device with a different block size,
+ *          typically bridging a 512 bytes file system to a 4096 bytes
+ *          medium or vice versa. When the exposed size is smaller than
+ *          the physical one sub-block writes are performed with a
+ *          read-modify-write sequence through a one-block buffer, the
+ *          buffer is written back lazily so that consecutive sub-block
+ *          updates of the same physical block cost a single physical
+ *          transfer. Aligned whole-block spans bypass the buffer in
+ *          both directions.
+ *
+ * @addtogroup block_translation
+ * @{
+ */
+
+#ifndef BLKTRANS_H
+#define BLKTRANS_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @extends BaseBlockDevice
+ *
+ * @brief   Type of a block size translation device.
+ * @note    Accesses are not internally serialized, as for the underlying
+ *          block drivers the caller is expected to serialize the access
+ *          to the device.
+ */
+typedef struct {
+  /**
+   * @brief   Virtual Methods Table.
+   */
+  const struct BaseBlockDeviceVMT *vmt;
+  _base_block_device_data
+  /**
+   * @brief   Pointer to the underlying block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   Exposed logical block size in bytes.
+   */
+  uint32_t              lsize;
+  /**
+   * @brief   Physical block size of the underlying device in bytes.
+   */
+  uint32_t              psize;
+  /**
+   * @brief   Blocks ratio between the two sizes.
+   */
+  uint32_t              factor;
+  /**
+   * @brief   Physical block held in the translation buffer.
+   */
+  uint32_t              cachedblk;
+  /**
+   * @brief   Translation buffer validity flag.
+   */
+  bool                  valid;
+  /**
+   * @brief   Translation buffer modified flag.
+   */
+  bool                  dirty;
+  /**
+   * @brief   Translation buffer, one physical block.
+   * @note    Unused, and can be @p NULL, when the exposed block size is
+   *          larger than the physical one.
+   */
+  uint8_t               *buffer;
+  /**
+   * @brief   Physical transfers saved by the lazy write back.
+   */
+  uint32_t              absorbed;
+} BlockTranslation;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blktransObjectInit(BlockTranslation *btp, BaseBlockDevice *blkp,
+                          uint32_t lsize, uint32_t psize, uint8_t *buffer);
+  bool blktransFlush(BlockTranslation *btp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKTRANS_H */
+
+/** @} */
@@ -0,0 +1,198 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    busarb.c
+ * @brief   Bus arbiter code.
+ *
+ * @addtogroup bus_arbiter
+ * @{
+ */
+
+#include "ch.h"
+#include "busarb.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Removes a ticket from the waiting list, if present.
+ *
+ * @param[in] bap       pointer to an initialized @p bus_arbiter_t structure
+ * @param[in] btp       pointer to the ticket to be removed
+ */
+static void busarb_remove(bus_arbiter_t *bap, bus_arb_ticket_t *btp) {
+  bus_arb_ticket_t **lpp = &bap->queue;
+
+  while (*lpp != NULL) {
+    if (*lpp == btp) {
+      *lpp = btp->next;
+      return;
+    }
+    lpp = &(*lpp)->next;
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p bus_arbiter_t structure.
+ *
+ * @param[out] bap      pointer to the @p bus_arbiter_t structure to be
+ *                      initialized
+ *
+ * @init
+ */
+void busarbObjectInit(bus_arbiter_t *bap) {
+
+  chDbgCheck(bap != NULL);
+
+  bap->owned = false;
+  bap->queue = NULL;
+}
+
+/**
+ * @brief   Requests ownership of the arbitrated bus.
+ * @details If the bus is free then ownership is granted immediately, else
+ *          the calling thread is suspended and the bus is granted, on
+ *          each release, to the waiter with the lowest key. Waiters with
+ *          equal keys are served in arrival order.
+ *
+ * @param[in] bap       pointer to an initialized @p bus_arbiter_t structure
+ * @param[in] key       ordering key, lower keys are granted first, an
+ *                      absolute deadline expressed in system ticks yields
+ *                      earliest-deadline-first ordering
+ * @param[in] timeout   the number of ticks before the operation times out,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if the bus has been granted.
+ * @retval MSG_TIMEOUT  if the bus could not be granted within the
+ *                      specified timeout.
+ *
+ * @api
+ */
+msg_t busarbAcquireTimeout(bus_arbiter_t *bap, uint32_t key,
+                           sysinterval_t timeout) {
+  bus_arb_ticket_t ticket;
+  bus_arb_ticket_t **lpp;
+  msg_t msg;
+
+  chDbgCheck(bap != NULL);
+
+  chSysLock();
+
+  if (!bap->owned) {
+    bap->owned = true;
+    chSysUnlock();
+    return MSG_OK;
+  }
+
+  if (timeout == TIME_IMMEDIATE) {
+    chSysUnlock();
+    return MSG_TIMEOUT;
+  }
+
+  /* Inserting the ticket keeping the list ordered by key, FIFO within
+     the same key.*/
+  ticket.key    = key;
+  ticket.thread = NULL;
+  lpp = &bap->queue;
+  while ((*lpp != NULL) && ((*lpp)->key <= key)) {
+    lpp = &(*lpp)->next;
+  }
+  ticket.next = *lpp;
+  *lpp = &ticket;
+
+  msg = chThdSuspendTimeoutS(&ticket.thread, timeout);
+  if (msg != MSG_OK) {
+    /* On timeout the ticket is still queued and must be removed.*/
+    busarb_remove(bap, &ticket);
+  }
+
+  chSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Requests ownership of the arbitrated bus.
+ * @details The calling thread waits until the bus is granted.
+ *
+ * @param[in] bap       pointer to an initialized @p bus_arbiter_t structure
+ * @param[in] key       ordering key, lower keys are granted first
+ *
+ * @api
+ */
+void busarbAcquire(bus_arbiter_t *bap, uint32_t key) {
+
+  (void) busarbAcquireTimeout(bap, key, TIME_INFINITE);
+}
+
+/**
+ * @brief   Releases ownership of the arbitrated bus.
+ * @details If threads are waiting then the bus is granted to the waiter
+ *          with the lowest key, else the bus becomes free.
+ * @pre     The bus must be owned by the calling thread.
+ *
+ * @param[in] bap       pointer to an initialized @p bus_arbiter_t structure
+ *
+ * @api
+ */
+void busarbRelease(bus_arbiter_t *bap) {
+  bus_arb_ticket_t *btp;
+
+  chDbgCheck(bap != NULL);
+
+  chSysLock();
+
+  chDbgAssert(bap->owned, "not owned");
+
+  btp = bap->queue;
+  if (btp != NULL) {
+    /* Ownership is passed directly to the first waiter.*/
+    bap->queue = btp->next;
+    chThdResumeS(&btp->thread, MSG_OK);
+  }
+  else {
+    bap->owned = false;
+  }
+
+  chSysUnlock();
+}
+
+/** @} */
@@ -0,0 +1,110 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    busarb.h
+ * @brief   Bus arbiter structures and macros.
+ * @details This module implements an arbitrated ownership layer meant to
+ *          be used above the bus acquire/release APIs of shared-bus
+ *          drivers such as SPI and I2C. Contending threads request the
+ *          bus with an ordering key, when the bus is released it is
+ *          granted to the waiter with the lowest key rather than in FIFO
+ *          or thread-priority order. Passing a static urgency value as
+ *          the key yields priority arbitration, passing the absolute
+ *          deadline of the transaction yields earliest-deadline-first
+ *          arbitration, bounding the bus-access latency of time-critical
+ *          threads regardless of their scheduling priority.
+ *
+ * @addtogroup bus_arbiter
+ * @{
+ */
+
+#ifndef BUSARB_H
+#define BUSARB_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a bus arbitration ticket.
+ * @details The ticket lives on the stack of the requesting thread for the
+ *          duration of the wait.
+ */
+typedef struct bus_arb_ticket {
+  /**
+   * @brief   Ordering key, lower keys are granted first.
+   */
+  uint32_t              key;
+  /**
+   * @brief   Reference to the suspended requesting thread.
+   */
+  thread_reference_t    thread;
+  /**
+   * @brief   Next ticket in the waiting list.
+   */
+  struct bus_arb_ticket *next;
+} bus_arb_ticket_t;
+
+/**
+ * @brief   Type of a bus arbiter structure.
+ */
+typedef struct {
+  /**
+   * @brief   Set while the bus is owned by a thread.
+   */
+  bool                  owned;
+  /**
+   * @brief   List of the waiting tickets ordered by key.
+   */
+  bus_arb_ticket_t      *queue;
+} bus_arbiter_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void busarbObjectInit(bus_arbiter_t *bap);
+  msg_t busarbAcquireTimeout(bus_arbiter_t *bap, uint32_t key,
+                             sysinterval_t timeout);
+  void busarbAcquire(bus_arbiter_t *bap, uint32_t key);
+  void busarbRelease(bus_arbiter_t *bap);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUSARB_H */
+
+/** @} */
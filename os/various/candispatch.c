@@ -0,0 +1,154 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    candispatch.c
+ * @brief   CAN RX dispatcher code.
+ *
+ * @addtogroup can_dispatcher
+ * @{
+ */
+
+#include "hal.h"
+#include "ch.h"
+#include "candispatch.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p can_dispatcher_t structure.
+ * @details The FIFOs table associates each filter match index with the
+ *          objects FIFO of the consuming thread, it must match the order
+ *          of the configured filter banks. The FIFO objects must be
+ *          @p CANRxFrame sized.
+ *
+ * @param[out] cdp      pointer to the @p can_dispatcher_t structure to be
+ *                      initialized
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] fifos     table of destination FIFOs indexed by filter match
+ *                      index, @p NULL entries fall back to the default
+ *                      FIFO
+ * @param[in] n         number of entries in the FIFOs table
+ * @param[in] deffifo   FIFO receiving the frames with a match index
+ *                      outside the table or @p NULL to drop them
+ *
+ * @init
+ */
+void canDispatcherObjectInit(can_dispatcher_t *cdp,
+                             CANDriver *canp,
+                             objects_fifo_t * const fifos[],
+                             size_t n,
+                             objects_fifo_t *deffifo) {
+
+  chDbgCheck((cdp != NULL) && (canp != NULL) && (fifos != NULL) && (n > 0U));
+
+  cdp->cd_canp    = canp;
+  cdp->cd_fifos   = fifos;
+  cdp->cd_n       = n;
+  cdp->cd_default = deffifo;
+  cdp->cd_dropped = 0;
+}
+
+/**
+ * @brief   Drains the RX hardware and routes the frames.
+ * @details All pending frames are fetched and copied into an object of
+ *          the FIFO selected by the filter match index, consumers are
+ *          woken directly. Frames without a destination or arriving when
+ *          the destination FIFO has no free objects are counted in
+ *          @p cd_dropped and discarded.
+ *
+ * @param[in] cdp       pointer to an initialized @p can_dispatcher_t
+ *                      structure
+ *
+ * @iclass
+ */
+void canDispatcherRxI(can_dispatcher_t *cdp) {
+
+  chDbgCheckClassI();
+
+  while (canTryReceiveI(cdp->cd_canp, CAN_ANY_MAILBOX,
+                        &cdp->cd_frame) == false) {
+    objects_fifo_t *ofp;
+    CANRxFrame *objp;
+
+    /* Selecting the destination FIFO by filter match index.*/
+    if ((size_t)cdp->cd_frame.FMI < cdp->cd_n) {
+      ofp = cdp->cd_fifos[cdp->cd_frame.FMI];
+    }
+    else {
+      ofp = NULL;
+    }
+    if (ofp == NULL) {
+      ofp = cdp->cd_default;
+    }
+    if (ofp == NULL) {
+      cdp->cd_dropped++;
+      continue;
+    }
+
+    /* Copying the frame into a FIFO object, the consumer returns it
+       with chFifoReturnObject() after use.*/
+    objp = (CANRxFrame *)chFifoTakeObjectI(ofp);
+    if (objp == NULL) {
+      cdp->cd_dropped++;
+      continue;
+    }
+    *objp = cdp->cd_frame;
+    chFifoSendObjectI(ofp, objp);
+  }
+}
+
+/**
+ * @brief   Drains the RX hardware and routes the frames, ISR context.
+ * @details This function is meant to be called from the CAN @p rxfull_cb
+ *          callback, it wraps @p canDispatcherRxI() in the ISR critical
+ *          zone.
+ *
+ * @param[in] cdp       pointer to an initialized @p can_dispatcher_t
+ *                      structure
+ *
+ * @special
+ */
+void canDispatcherRxFromIsr(can_dispatcher_t *cdp) {
+
+  chSysLockFromISR();
+  canDispatcherRxI(cdp);
+  chSysUnlockFromISR();
+}
+
+/** @} */
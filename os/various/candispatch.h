@@ -0,0 +1,119 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    candispatch.h
+ * @brief   CAN RX dispatcher structures and macros.
+ * @details This module routes received CAN frames to per-consumer objects
+ *          FIFOs indexed by the hardware filter match index, directly
+ *          from the RX interrupt. Each consumer thread waits on its own
+ *          FIFO, no intermediate dispatcher thread and no extra wakeup
+ *          are left in the frame delivery path.
+ *
+ * @addtogroup can_dispatcher
+ * @{
+ */
+
+#ifndef CANDISPATCH_H
+#define CANDISPATCH_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !HAL_USE_CAN
+#error "CAN dispatcher requires HAL_USE_CAN"
+#endif
+
+#if !CAN_ENFORCE_USE_CALLBACKS
+#error "CAN dispatcher requires CAN_ENFORCE_USE_CALLBACKS"
+#endif
+
+#if !CH_CFG_USE_OBJ_FIFOS
+#error "CAN dispatcher requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a CAN dispatcher structure.
+ */
+typedef struct {
+  /**
+   * @brief   Associated CAN driver.
+   */
+  CANDriver             *cd_canp;
+  /**
+   * @brief   Table of destination FIFOs indexed by filter match index,
+   *          @p NULL entries fall back to the default FIFO.
+   */
+  objects_fifo_t        * const *cd_fifos;
+  /**
+   * @brief   Number of entries in the FIFOs table.
+   */
+  size_t                cd_n;
+  /**
+   * @brief   Default FIFO for unmatched indexes or @p NULL to drop.
+   */
+  objects_fifo_t        *cd_default;
+  /**
+   * @brief   Frames dropped because no destination or no free objects.
+   */
+  uint32_t              cd_dropped;
+  /**
+   * @brief   Receive scratch frame.
+   */
+  CANRxFrame            cd_frame;
+} can_dispatcher_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void canDispatcherObjectInit(can_dispatcher_t *cdp,
+                               CANDriver *canp,
+                               objects_fifo_t * const fifos[],
+                               size_t n,
+                               objects_fifo_t *deffifo);
+  void canDispatcherRxI(can_dispatcher_t *cdp);
+  void canDispatcherRxFromIsr(can_dispatcher_t *cdp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CANDISPATCH_H */
+
+/** @} */
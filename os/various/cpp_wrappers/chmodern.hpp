@@ -0,0 +1,272 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    chmodern.hpp
+ * @brief   Zero-overhead C++ wrapper classes and definitions.
+ * @details Header-only companion of @p ch.hpp providing a thin layer
+ *          without virtual dispatch, every method resolves to the direct
+ *          C call and the classes add no data members beyond what the C
+ *          API requires. It can be used stand-alone or together with the
+ *          classic wrappers, nothing in this file needs @p ch.cpp.
+ *
+ * @addtogroup cpp_library
+ * @{
+ */
+
+#include <ch.h>
+
+#ifndef _CHMODERN_HPP_
+#define _CHMODERN_HPP_
+
+namespace chibios_rt {
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::StaticThread                                               *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Statically allocated thread template class.
+   * @details Unlike @p BaseStaticThread there is no virtual @p main()
+   *          method, the entry point is passed to @p start() as any
+   *          entity convertible to a plain function pointer, including
+   *          capture-less lambdas. The only storage is the working area
+   *          itself and the thread pointer.
+   *
+   * @param N                 the working area size for the thread
+   */
+  template <size_t N>
+  class StaticThread {
+    THD_WORKING_AREA(wa, N);
+    thread_t *tp = nullptr;
+
+  public:
+    /**
+     * @brief   StaticThread constructor.
+     *
+     * @init
+     */
+    StaticThread(void) {
+
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    StaticThread(const StaticThread &) = delete;
+    StaticThread &operator=(const StaticThread &) = delete;
+
+    /**
+     * @brief   Creates and starts the thread.
+     * @pre     The thread must not be already started.
+     *
+     * @param[in] prio          thread priority
+     * @param[in] func          thread function, a capture-less lambda
+     *                          converts implicitly
+     * @param[in] arg           thread function argument
+     * @return                  The thread pointer.
+     *
+     * @api
+     */
+    thread_t *start(tprio_t prio, tfunc_t func, void *arg = nullptr) {
+
+      tp = chThdCreateStatic(wa, sizeof(wa), prio, func, arg);
+      return tp;
+    }
+
+    /**
+     * @brief   Blocks until the thread terminates.
+     * @pre     The thread must have been started and the option
+     *          @p CH_CFG_USE_WAITEXIT must be enabled.
+     *
+     * @return                  The thread exit message.
+     *
+     * @api
+     */
+#if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
+    msg_t wait(void) {
+
+      return chThdWait(tp);
+    }
+#endif
+
+    /**
+     * @brief   Returns the thread pointer.
+     * @note    @p nullptr before the thread is started.
+     *
+     * @return                  The thread pointer.
+     *
+     * @xclass
+     */
+    thread_t *getThreadX(void) const {
+
+      return tp;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::SysLockGuard                                               *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Scoped kernel lock.
+   * @details The critical zone is entered on construction and left on
+   *          destruction, the compiler inlines both into the exact
+   *          @p chSysLock() / @p chSysUnlock() pair so early returns and
+   *          nested scopes cannot leave the zone unbalanced.
+   */
+  class SysLockGuard {
+  public:
+    /**
+     * @brief   Enters the kernel lock mode.
+     *
+     * @special
+     */
+    SysLockGuard(void) {
+
+      chSysLock();
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    SysLockGuard(const SysLockGuard &) = delete;
+    SysLockGuard &operator=(const SysLockGuard &) = delete;
+
+    /**
+     * @brief   Leaves the kernel lock mode.
+     *
+     * @special
+     */
+    ~SysLockGuard(void) {
+
+      chSysUnlock();
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::SysLockGuardFromIsr                                        *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Scoped kernel lock for interrupt handlers.
+   * @details Same as @p SysLockGuard but using the ISR-specific enter and
+   *          leave functions, to be instantiated exclusively inside
+   *          interrupt handlers around I-class calls.
+   */
+  class SysLockGuardFromIsr {
+  public:
+    /**
+     * @brief   Enters the kernel lock mode from within an ISR.
+     *
+     * @special
+     */
+    SysLockGuardFromIsr(void) {
+
+      chSysLockFromISR();
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    SysLockGuardFromIsr(const SysLockGuardFromIsr &) = delete;
+    SysLockGuardFromIsr &operator=(const SysLockGuardFromIsr &) = delete;
+
+    /**
+     * @brief   Leaves the kernel lock mode from within an ISR.
+     *
+     * @special
+     */
+    ~SysLockGuardFromIsr(void) {
+
+      chSysUnlockFromISR();
+    }
+  };
+
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::MutexGuard                                                 *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Scoped mutex ownership.
+   * @details The referenced mutex is taken on construction and released
+   *          on destruction. It operates directly on a @p mutex_t so it
+   *          can guard mutexes shared with C code.
+   */
+  class MutexGuard {
+    mutex_t &mtx;
+
+  public:
+    /**
+     * @brief   Locks the mutex.
+     *
+     * @param[in] m             the mutex to be guarded
+     *
+     * @api
+     */
+    MutexGuard(mutex_t &m) : mtx(m) {
+
+      chMtxLock(&mtx);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    MutexGuard(const MutexGuard &) = delete;
+    MutexGuard &operator=(const MutexGuard &) = delete;
+
+    /**
+     * @brief   Unlocks the mutex.
+     *
+     * @api
+     */
+    ~MutexGuard(void) {
+
+      chMtxUnlock(&mtx);
+    }
+  };
+#endif /* CH_CFG_USE_MUTEXES == TRUE */
+
+#if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::EventBit                                                   *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Compile-time checked event mask.
+   * @details Equivalent of the @p EVENT_MASK() macro with the bit
+   *          position validated at compile time, an out of range position
+   *          is a build error rather than a silently truncated mask. The
+   *          implicit conversion makes instances usable wherever an
+   *          @p eventmask_t is expected and combining bits with the OR
+   *          operator folds to a constant.
+   *
+   * @param P                 the event bit position
+   */
+  template <unsigned P>
+  struct EventBit {
+    static_assert(P < (sizeof (eventmask_t) * 8U),
+                  "event bit position out of range");
+
+    /**
+     * @brief   The event mask value.
+     */
+    static constexpr eventmask_t mask = EVENT_MASK(P);
+
+    /**
+     * @brief   Conversion to the plain mask type.
+     *
+     * @return                  The event mask value.
+     */
+    constexpr operator eventmask_t(void) const {
+
+      return mask;
+    }
+  };
+#endif /* CH_CFG_USE_EVENTS == TRUE */
+}
+
+#endif /* _CHMODERN_HPP_ */
+
+/** @} */
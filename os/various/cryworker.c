@@ -0,0 +1,234 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cryworker.c
+ * @brief   Crypto worker thread code.
+ *
+ * @addtogroup crypto_worker
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "cryworker.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Executes a single cipher operation.
+ *
+ * @param[in] cwp       pointer to an initialized @p cry_worker_t structure
+ * @param[in] cop       pointer to the operation descriptor
+ */
+static void cry_worker_execute(cry_worker_t *cwp, cry_operation_t *cop) {
+  CRYDriver *cryp = cwp->cw_cryp;
+
+  switch (cop->op) {
+  case CRY_OP_ENCRYPT_ECB:
+    cop->result = cryEncryptAES_ECB(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out);
+    break;
+  case CRY_OP_DECRYPT_ECB:
+    cop->result = cryDecryptAES_ECB(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out);
+    break;
+  case CRY_OP_ENCRYPT_CBC:
+    cop->result = cryEncryptAES_CBC(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_DECRYPT_CBC:
+    cop->result = cryDecryptAES_CBC(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_ENCRYPT_CFB:
+    cop->result = cryEncryptAES_CFB(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_DECRYPT_CFB:
+    cop->result = cryDecryptAES_CFB(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_ENCRYPT_CTR:
+    cop->result = cryEncryptAES_CTR(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_DECRYPT_CTR:
+    cop->result = cryDecryptAES_CTR(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv);
+    break;
+  case CRY_OP_ENCRYPT_GCM:
+    cop->result = cryEncryptAES_GCM(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv,
+                                    cop->aadsize, cop->aad, cop->authtag);
+    break;
+  case CRY_OP_DECRYPT_GCM:
+    cop->result = cryDecryptAES_GCM(cryp, cop->key_id, cop->size,
+                                    cop->in, cop->out, cop->iv,
+                                    cop->aadsize, cop->aad, cop->authtag);
+    break;
+  default:
+    cop->result = CRY_ERR_INV_ALGO;
+    break;
+  }
+
+  if (cop->callback != NULL) {
+    cop->callback(cop);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p cry_worker_t structure.
+ *
+ * @param[out] cwp      pointer to the @p cry_worker_t structure to be
+ *                      initialized
+ * @param[in] cryp      pointer to the cryptographic driver to be served,
+ *                      it must be already started
+ *
+ * @init
+ */
+void cryWorkerObjectInit(cry_worker_t *cwp, CRYDriver *cryp) {
+
+  chDbgCheck((cwp != NULL) && (cryp != NULL));
+
+  cwp->cw_cryp = cryp;
+  chSemObjectInit(&cwp->cw_sem, (cnt_t)0);
+  cwp->cw_head = NULL;
+  cwp->cw_tail = NULL;
+}
+
+/**
+ * @brief   Submits an operation to the worker queue.
+ * @details The function returns immediately, the operation is executed
+ *          by the worker thread in submission order.
+ * @post    The descriptor and the referenced buffers are owned by the
+ *          worker until the completion callback has been invoked.
+ *
+ * @param[in] cwp       pointer to an initialized @p cry_worker_t structure
+ * @param[in] cop       pointer to the operation descriptor
+ *
+ * @iclass
+ */
+void cryWorkerSubmitI(cry_worker_t *cwp, cry_operation_t *cop) {
+
+  chDbgCheckClassI();
+  chDbgCheck((cwp != NULL) && (cop != NULL));
+
+  cop->next = NULL;
+  if (cwp->cw_head == NULL) {
+    cwp->cw_head = cop;
+  }
+  else {
+    cwp->cw_tail->next = cop;
+  }
+  cwp->cw_tail = cop;
+  chSemSignalI(&cwp->cw_sem);
+}
+
+/**
+ * @brief   Submits an operation to the worker queue.
+ * @details The function returns immediately, the operation is executed
+ *          by the worker thread in submission order.
+ * @post    The descriptor and the referenced buffers are owned by the
+ *          worker until the completion callback has been invoked.
+ *
+ * @param[in] cwp       pointer to an initialized @p cry_worker_t structure
+ * @param[in] cop       pointer to the operation descriptor
+ *
+ * @api
+ */
+void cryWorkerSubmit(cry_worker_t *cwp, cry_operation_t *cop) {
+
+  chSysLock();
+  cryWorkerSubmitI(cwp, cop);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Requests the termination of a worker thread.
+ * @details The worker completes the operation in progress, if any, then
+ *          exits without executing the still queued operations. The
+ *          caller should wait for the actual termination using
+ *          @p chThdWait().
+ *
+ * @param[in] cwp       pointer to an initialized @p cry_worker_t structure
+ * @param[in] tp        pointer to the worker thread
+ *
+ * @api
+ */
+void cryWorkerTerminate(cry_worker_t *cwp, thread_t *tp) {
+
+  chThdTerminate(tp);
+  chSemSignal(&cwp->cw_sem);
+}
+
+/**
+ * @brief   Crypto worker thread function.
+ * @details The thread waits on the operation queue and executes the
+ *          queued operations in order, it is meant to be spawned by the
+ *          application with @p chThdCreateStatic() or similar, the
+ *          argument must point to an initialized @p cry_worker_t
+ *          structure.
+ *
+ * @param[in] p         pointer to an initialized @p cry_worker_t structure
+ */
+THD_FUNCTION(cryWorkerThread, p) {
+  cry_worker_t *cwp = p;
+
+  while (true) {
+    cry_operation_t *cop;
+
+    (void) chSemWait(&cwp->cw_sem);
+    if (chThdShouldTerminateX()) {
+      break;
+    }
+
+    chSysLock();
+    cop = cwp->cw_head;
+    cwp->cw_head = cop->next;
+    if (cwp->cw_head == NULL) {
+      cwp->cw_tail = NULL;
+    }
+    chSysUnlock();
+
+    cry_worker_execute(cwp, cop);
+  }
+}
+
+/** @} */
@@ -0,0 +1,193 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cryworker.h
+ * @brief   Crypto worker thread structures and macros.
+ * @details This module implements an asynchronous front end for the
+ *          synchronous cryptographic driver API. Cipher operations are
+ *          submitted to a per-driver queue without blocking, a dedicated
+ *          worker thread executes them in order using the @p cry*AES_xxx()
+ *          functions and invokes a completion callback after each one.
+ *          The submitting thread can prepare the next record while the
+ *          crypto engine processes the previous one.
+ *
+ * @addtogroup crypto_worker
+ * @{
+ */
+
+#ifndef CRYWORKER_H
+#define CRYWORKER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !HAL_USE_CRY
+#error "crypto workers require HAL_USE_CRY"
+#endif
+
+#if !CH_CFG_USE_SEMAPHORES
+#error "crypto workers require CH_CFG_USE_SEMAPHORES"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a queued cipher operation.
+ */
+typedef enum {
+  CRY_OP_ENCRYPT_ECB = 0,               /**< AES-ECB encryption.            */
+  CRY_OP_DECRYPT_ECB = 1,               /**< AES-ECB decryption.            */
+  CRY_OP_ENCRYPT_CBC = 2,               /**< AES-CBC encryption.            */
+  CRY_OP_DECRYPT_CBC = 3,               /**< AES-CBC decryption.            */
+  CRY_OP_ENCRYPT_CFB = 4,               /**< AES-CFB encryption.            */
+  CRY_OP_DECRYPT_CFB = 5,               /**< AES-CFB decryption.            */
+  CRY_OP_ENCRYPT_CTR = 6,               /**< AES-CTR encryption.            */
+  CRY_OP_DECRYPT_CTR = 7,               /**< AES-CTR decryption.            */
+  CRY_OP_ENCRYPT_GCM = 8,               /**< AES-GCM encryption.            */
+  CRY_OP_DECRYPT_GCM = 9                /**< AES-GCM decryption.            */
+} cryoptype_t;
+
+/**
+ * @brief   Type of a queued cipher operation descriptor.
+ */
+typedef struct cry_operation cry_operation_t;
+
+/**
+ * @brief   Type of an operation completion callback.
+ * @details The callback is invoked from the worker thread context after
+ *          the operation result has been stored in the descriptor.
+ *
+ * @param[in] cop       pointer to the completed operation descriptor
+ */
+typedef void (*cryopcallback_t)(cry_operation_t *cop);
+
+/**
+ * @brief   Queued cipher operation descriptor.
+ * @details The descriptor and all the referenced buffers are owned by the
+ *          worker from submission until the completion callback has been
+ *          invoked, they must not be modified or reused in this interval.
+ */
+struct cry_operation {
+  /**
+   * @brief   Type of the operation.
+   */
+  cryoptype_t           op;
+  /**
+   * @brief   Identifier of the key to be used, see @p cryLoadTransientKey().
+   */
+  crykey_t              key_id;
+  /**
+   * @brief   Size of the text buffers in bytes.
+   */
+  size_t                size;
+  /**
+   * @brief   Input buffer.
+   */
+  const uint8_t         *in;
+  /**
+   * @brief   Output buffer.
+   */
+  uint8_t               *out;
+  /**
+   * @brief   Initialization vector, ignored for ECB operations.
+   */
+  const uint8_t         *iv;
+  /**
+   * @brief   Size of the additional authentication data, GCM only.
+   */
+  size_t                aadsize;
+  /**
+   * @brief   Additional authentication data, GCM only.
+   */
+  const uint8_t         *aad;
+  /**
+   * @brief   Authentication tag buffer, GCM only.
+   */
+  uint8_t               *authtag;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  cryopcallback_t       callback;
+  /**
+   * @brief   Operation result, @p CRY_NOERROR on success.
+   */
+  cryerror_t            result;
+  /**
+   * @brief   Next operation in the queue, managed by the worker.
+   */
+  cry_operation_t       *next;
+};
+
+/**
+ * @brief   Type of a crypto worker structure.
+ */
+typedef struct {
+  /**
+   * @brief   Associated cryptographic driver.
+   */
+  CRYDriver             *cw_cryp;
+  /**
+   * @brief   Counter semaphore tracking the queued operations.
+   */
+  semaphore_t           cw_sem;
+  /**
+   * @brief   Head of the queued operations list.
+   */
+  cry_operation_t       *cw_head;
+  /**
+   * @brief   Tail of the queued operations list.
+   */
+  cry_operation_t       *cw_tail;
+} cry_worker_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void cryWorkerObjectInit(cry_worker_t *cwp, CRYDriver *cryp);
+  void cryWorkerSubmitI(cry_worker_t *cwp, cry_operation_t *cop);
+  void cryWorkerSubmit(cry_worker_t *cwp, cry_operation_t *cop);
+  void cryWorkerTerminate(cry_worker_t *cwp, thread_t *tp);
+  THD_FUNCTION(cryWorkerThread, p);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYWORKER_H */
+
+/** @} */
@@ -45,12 +45,59 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/*
+ * Advances the absolute deadline by whole intervals until it falls in the
+ * future and returns the delay to it. Re-arming on the absolute grid keeps
+ * the period phase-locked regardless of callback latency; deadlines that
+ * are already in the past are skipped, not compressed, and accounted in
+ * the skipped ticks counter.
+ */
+static sysinterval_t next_deadline(systime_t *nextp,
+                                   sysinterval_t interval,
+                                   uint32_t *skippedp) {
+  systime_t now = chVTGetSystemTimeX();
+  sysinterval_t delta;
+
+  for (;;) {
+    *nextp = chTimeAddX(*nextp, interval);
+    delta = chTimeDiffX(now, *nextp);
+    if ((delta > (sysinterval_t)0) && (delta <= interval))
+      return delta;
+    (*skippedp)++;
+  }
+}
+
 static void tmrcb(void *p) {
   event_timer_t *etp = p;
+  sysinterval_t delta;
 
   chSysLockFromISR();
   chEvtBroadcastI(&etp->et_es);
-  chVTDoSetI(&etp->et_vt, etp->et_interval, tmrcb, etp);
+  delta = next_deadline(&etp->et_next, (sysinterval_t)etp->et_interval,
+                        &etp->et_skipped);
+  chVTDoSetI(&etp->et_vt, delta, tmrcb, etp);
+  chSysUnlockFromISR();
+}
+
+static void mtrcb(void *p) {
+  event_multicaster_t *emp = p;
+  sysinterval_t delta;
+  unsigned i;
+
+  chSysLockFromISR();
+
+  /* Serving the rate groups for this base tick.*/
+  for (i = 0; i < emp->em_n; i++) {
+    event_timer_group_t *egp = &emp->em_groups[i];
+
+    if (--egp->eg_cnt == 0U) {
+      egp->eg_cnt = egp->eg_divider;
+      chEvtBroadcastI(&egp->eg_es);
+    }
+  }
+
+  delta = next_deadline(&emp->em_next, emp->em_interval, &emp->em_skipped);
+  chVTDoSetI(&emp->em_vt, delta, mtrcb, emp);
   chSysUnlockFromISR();
 }
 
@@ -69,6 +116,7 @@ void evtObjectInit(event_timer_t *etp, systime_t time) {
   chEvtObjectInit(&etp->et_es);
   chVTObjectInit(&etp->et_vt);
   etp->et_interval = time;
+  etp->et_skipped  = 0;
 }
 
 /**
@@ -79,7 +127,70 @@ void evtObjectInit(event_timer_t *etp, systime_t time) {
  */
 void evtStart(event_timer_t *etp) {
 
-  chVTSet(&etp->et_vt, etp->et_interval, tmrcb, etp);
+  chSysLock();
+  if (!chVTIsArmedI(&etp->et_vt)) {
+    etp->et_next    = chTimeAddX(chVTGetSystemTimeX(),
+                                 (sysinterval_t)etp->et_interval);
+    etp->et_skipped = 0;
+    chVTDoSetI(&etp->et_vt, (sysinterval_t)etp->et_interval, tmrcb, etp);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Initializes an @p event_multicaster_t structure.
+ * @pre     The @p eg_divider field of each group must be set to the number
+ *          of base ticks between two broadcasts of the group source, one
+ *          for every base tick.
+ *
+ * @param[out] emp      the @p event_multicaster_t structure to be
+ *                      initialized
+ * @param[in] interval  the base interval in system ticks
+ * @param[in] groups    array of the rate groups to be served
+ * @param[in] n         number of rate groups
+ */
+void evtMulticasterObjectInit(event_multicaster_t *emp,
+                              sysinterval_t interval,
+                              event_timer_group_t groups[],
+                              unsigned n) {
+  unsigned i;
+
+  chDbgCheck((emp != NULL) && (groups != NULL) && (n > 0U));
+
+  chVTObjectInit(&emp->em_vt);
+  emp->em_interval = interval;
+  emp->em_skipped  = 0;
+  emp->em_groups   = groups;
+  emp->em_n        = n;
+  for (i = 0; i < n; i++) {
+    chDbgCheck(groups[i].eg_divider > 0U);
+
+    chEvtObjectInit(&groups[i].eg_es);
+    groups[i].eg_cnt = groups[i].eg_divider;
+  }
+}
+
+/**
+ * @brief   Starts the multicaster.
+ * @details If the multicaster was already running then the function has no
+ *          effect. The group countdowns restart from their dividers so the
+ *          divided rates keep a fixed phase relative to the start time.
+ *
+ * @param[in] emp       pointer to an initialized @p event_multicaster_t
+ *                      structure.
+ */
+void evtMulticasterStart(event_multicaster_t *emp) {
+  unsigned i;
+
+  chSysLock();
+  if (!chVTIsArmedI(&emp->em_vt)) {
+    for (i = 0; i < emp->em_n; i++)
+      emp->em_groups[i].eg_cnt = emp->em_groups[i].eg_divider;
+    emp->em_next    = chTimeAddX(chVTGetSystemTimeX(), emp->em_interval);
+    emp->em_skipped = 0;
+    chVTDoSetI(&emp->em_vt, emp->em_interval, mtrcb, emp);
+  }
+  chSysUnlock();
 }
 
 /** @} */
@@ -55,8 +55,36 @@ typedef struct {
   virtual_timer_t       et_vt;
   event_source_t        et_es;
   systime_t             et_interval;
+  systime_t             et_next;
+  uint32_t              et_skipped;
 } event_timer_t;
 
+/**
+ * @brief   Type of a multicaster rate group.
+ * @note    The @p eg_divider field must be initialized by the user before
+ *          calling @p evtMulticasterObjectInit(), the group source is
+ *          broadcast every divider-th base tick.
+ */
+typedef struct {
+  event_source_t        eg_es;
+  uint32_t              eg_divider;
+  uint32_t              eg_cnt;
+} event_timer_group_t;
+
+/**
+ * @brief   Type of a periodic event multicaster structure.
+ * @details A single phase-locked timer broadcasting multiple event sources
+ *          at integer divisions of the base rate.
+ */
+typedef struct {
+  virtual_timer_t       em_vt;
+  sysinterval_t         em_interval;
+  systime_t             em_next;
+  uint32_t              em_skipped;
+  event_timer_group_t   *em_groups;
+  unsigned              em_n;
+} event_multicaster_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -70,6 +98,11 @@ extern "C" {
 #endif
   void evtObjectInit(event_timer_t *etp, systime_t time);
   void evtStart(event_timer_t *etp);
+  void evtMulticasterObjectInit(event_multicaster_t *emp,
+                                sysinterval_t interval,
+                                event_timer_group_t groups[],
+                                unsigned n);
+  void evtMulticasterStart(event_multicaster_t *emp);
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +122,33 @@ static inline void evtStop(event_timer_t *etp) {
   chVTReset(&etp->et_vt);
 }
 
+/**
+ * @brief   Stops the multicaster.
+ * @details If the multicaster was already stopped then the function has no
+ *          effect.
+ *
+ * @param[in] emp       pointer to an initialized @p event_multicaster_t
+ *                      structure.
+ */
+static inline void evtMulticasterStop(event_multicaster_t *emp) {
+
+  chVTReset(&emp->em_vt);
+}
+
+/**
+ * @brief   Returns the event source of a multicaster rate group.
+ *
+ * @param[in] emp       pointer to an initialized @p event_multicaster_t
+ *                      structure.
+ * @param[in] i         group index
+ * @return              The pointer to the group @p event_source_t.
+ */
+static inline event_source_t *evtGetGroupSourceX(event_multicaster_t *emp,
+                                                 unsigned i) {
+
+  return &emp->em_groups[i].eg_es;
+}
+
 #endif /* EVTIMER_H */
 
 /** @} */
@@ -1,6 +1,7 @@
 # FATFS files.
 FATFSSRC = $(CHIBIOS)/os/various/fatfs_bindings/fatfs_diskio.c \
            $(CHIBIOS)/os/various/fatfs_bindings/fatfs_syscall.c \
+           $(CHIBIOS)/os/various/fatfs_bindings/fatfs_worker.c \
            $(CHIBIOS)/ext/fatfs/src/ff.c \
            $(CHIBIOS)/ext/fatfs/src/ffunicode.c
 
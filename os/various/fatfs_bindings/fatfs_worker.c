@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_worker.c
+ * @brief   FatFS worker thread code.
+ *
+ * @addtogroup fatfs_worker
+ * @{
+ */
+
+#include "ch.h"
+#include "ff.h"
+#include "fatfs_worker.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Executes a single file operation request.
+ *
+ * @param[in] frp       pointer to the request descriptor
+ */
+static void fatfs_worker_execute(fatfs_request_t *frp) {
+
+  frp->count = 0;
+  switch (frp->op) {
+  case FATFS_OP_OPEN:
+    frp->result = f_open(frp->fp, frp->path, frp->mode);
+    break;
+  case FATFS_OP_READ:
+    frp->result = f_read(frp->fp, frp->rbuf, frp->bytes, &frp->count);
+    break;
+  case FATFS_OP_WRITE:
+    frp->result = f_write(frp->fp, frp->wbuf, frp->bytes, &frp->count);
+    break;
+  case FATFS_OP_SYNC:
+    frp->result = f_sync(frp->fp);
+    break;
+  case FATFS_OP_CLOSE:
+    frp->result = f_close(frp->fp);
+    break;
+  default:
+    frp->result = FR_INVALID_PARAMETER;
+    break;
+  }
+
+  if (frp->callback != NULL) {
+    frp->callback(frp);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p fatfs_worker_t structure.
+ *
+ * @param[out] fwp      pointer to the @p fatfs_worker_t structure to be
+ *                      initialized
+ *
+ * @init
+ */
+void fatfsWorkerObjectInit(fatfs_worker_t *fwp) {
+
+  chDbgCheck(fwp != NULL);
+
+  chSemObjectInit(&fwp->fw_sem, (cnt_t)0);
+  fwp->fw_head = NULL;
+  fwp->fw_tail = NULL;
+}
+
+/**
+ * @brief   Submits a request to the worker queue.
+ * @details The function returns immediately, the request is executed by
+ *          the worker thread in submission order.
+ * @post    The descriptor is owned by the worker until its completion
+ *          callback has been invoked.
+ *
+ * @param[in] fwp       pointer to an initialized @p fatfs_worker_t structure
+ * @param[in] frp       pointer to the request descriptor
+ *
+ * @iclass
+ */
+void fatfsWorkerSubmitI(fatfs_worker_t *fwp, fatfs_request_t *frp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((fwp != NULL) && (frp != NULL));
+
+  frp->next = NULL;
+  if (fwp->fw_head == NULL) {
+    fwp->fw_head = frp;
+  }
+  else {
+    fwp->fw_tail->next = frp;
+  }
+  fwp->fw_tail = frp;
+  chSemSignalI(&fwp->fw_sem);
+}
+
+/**
+ * @brief   Submits a request to the worker queue.
+ * @details The function returns immediately, the request is executed by
+ *          the worker thread in submission order.
+ * @post    The descriptor is owned by the worker until its completion
+ *          callback has been invoked.
+ *
+ * @param[in] fwp       pointer to an initialized @p fatfs_worker_t structure
+ * @param[in] frp       pointer to the request descriptor
+ *
+ * @api
+ */
+void fatfsWorkerSubmit(fatfs_worker_t *fwp, fatfs_request_t *frp) {
+
+  chSysLock();
+  fatfsWorkerSubmitI(fwp, frp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Requests the termination of a worker thread.
+ * @details The worker completes the request in progress, if any, then
+ *          exits without executing the still queued requests. The caller
+ *          should wait for the actual termination using @p chThdWait().
+ *
+ * @param[in] fwp       pointer to an initialized @p fatfs_worker_t structure
+ * @param[in] tp        pointer to the worker thread
+ *
+ * @api
+ */
+void fatfsWorkerTerminate(fatfs_worker_t *fwp, thread_t *tp) {
+
+  chThdTerminate(tp);
+  chSemSignal(&fwp->fw_sem);
+}
+
+/**
+ * @brief   FatFS worker thread function.
+ * @details The thread waits on the request queue and executes the queued
+ *          requests in order, it is meant to be spawned by the
+ *          application with @p chThdCreateStatic() or similar, the
+ *          argument must point to an initialized @p fatfs_worker_t
+ *          structure.
+ *
+ * @param[in] p         pointer to an initialized @p fatfs_worker_t structure
+ */
+THD_FUNCTION(fatfsWorkerThread, p) {
+  fatfs_worker_t *fwp = p;
+
+  while (true) {
+    fatfs_request_t *frp;
+
+    (void) chSemWait(&fwp->fw_sem);
+    if (chThdShouldTerminateX()) {
+      break;
+    }
+
+    chSysLock();
+    frp = fwp->fw_head;
+    fwp->fw_head = frp->next;
+    if (fwp->fw_head == NULL) {
+      fwp->fw_tail = NULL;
+    }
+    chSysUnlock();
+
+    fatfs_worker_execute(frp);
+  }
+}
+
+/** @} */
@@ -0,0 +1,180 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_worker.h
+ * @brief   FatFS worker thread structures and macros.
+ * @details This module implements an asynchronous front end for the FatFS
+ *          file API. Requests are submitted to a queue without blocking,
+ *          a dedicated worker thread executes them in order and invokes a
+ *          completion callback after each one, so threads with latency
+ *          requirements never wait on card operations directly. With
+ *          @p FF_FS_REENTRANT enabled FatFS serializes accesses per
+ *          volume, instantiating one worker per volume therefore keeps
+ *          the volumes independent: a slow operation on one card does
+ *          not stall requests queued for another.
+ * @pre     This header requires @p ff.h to be included first.
+ *
+ * @addtogroup fatfs_worker
+ * @{
+ */
+
+#ifndef FATFS_WORKER_H
+#define FATFS_WORKER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !CH_CFG_USE_SEMAPHORES
+#error "FatFS workers require CH_CFG_USE_SEMAPHORES"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a file operation request code.
+ */
+typedef enum {
+  FATFS_OP_OPEN = 0,
+  FATFS_OP_READ = 1,
+  FATFS_OP_WRITE = 2,
+  FATFS_OP_SYNC = 3,
+  FATFS_OP_CLOSE = 4
+} fatfsop_t;
+
+/**
+ * @brief   Type of a queued file operation request descriptor.
+ */
+typedef struct fatfs_request fatfs_request_t;
+
+/**
+ * @brief   Type of a request completion callback.
+ * @details The callback is invoked from the worker thread context after
+ *          the request result has been stored in the descriptor.
+ *
+ * @param[in] frp       pointer to the completed request descriptor
+ */
+typedef void (*fatfsreqcallback_t)(fatfs_request_t *frp);
+
+/**
+ * @brief   Queued file operation request descriptor.
+ * @details The descriptor is owned by the worker from submission until the
+ *          completion callback has been invoked, it must not be modified
+ *          or reused in this interval. The same ownership rule applies to
+ *          the file object and the data buffer it references.
+ */
+struct fatfs_request {
+  /**
+   * @brief   Requested file operation.
+   */
+  fatfsop_t             op;
+  /**
+   * @brief   File object the operation is applied to.
+   */
+  FIL                   *fp;
+  /**
+   * @brief   File path, only used by @p FATFS_OP_OPEN.
+   */
+  const TCHAR           *path;
+  /**
+   * @brief   Open mode flags, only used by @p FATFS_OP_OPEN.
+   */
+  BYTE                  mode;
+  /**
+   * @brief   Data source buffer, only used by @p FATFS_OP_WRITE.
+   */
+  const void            *wbuf;
+  /**
+   * @brief   Data destination buffer, only used by @p FATFS_OP_READ.
+   */
+  void                  *rbuf;
+  /**
+   * @brief   Number of bytes to be transferred.
+   */
+  UINT                  bytes;
+  /**
+   * @brief   Number of bytes actually transferred.
+   */
+  UINT                  count;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  fatfsreqcallback_t    callback;
+  /**
+   * @brief   Operation result.
+   */
+  FRESULT               result;
+  /**
+   * @brief   Next request in the queue, managed by the worker.
+   */
+  fatfs_request_t       *next;
+};
+
+/**
+ * @brief   Type of a FatFS worker structure.
+ */
+typedef struct {
+  /**
+   * @brief   Counter semaphore tracking the queued requests.
+   */
+  semaphore_t           fw_sem;
+  /**
+   * @brief   Head of the queued requests list.
+   */
+  fatfs_request_t       *fw_head;
+  /**
+   * @brief   Tail of the queued requests list.
+   */
+  fatfs_request_t       *fw_tail;
+} fatfs_worker_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void fatfsWorkerObjectInit(fatfs_worker_t *fwp);
+  void fatfsWorkerSubmitI(fatfs_worker_t *fwp, fatfs_request_t *frp);
+  void fatfsWorkerSubmit(fatfs_worker_t *fwp, fatfs_request_t *frp);
+  void fatfsWorkerTerminate(fatfs_worker_t *fwp, thread_t *tp);
+  THD_FUNCTION(fatfsWorkerThread, p);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FATFS_WORKER_H */
+
+/** @} */
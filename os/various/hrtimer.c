@@ -0,0 +1,293 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hrtimer.c
+ * @brief   High resolution timers code.
+ *
+ * @addtogroup hr_timers
+ * @{
+ */
+
+#include "hal.h"
+#include "hrtimer.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Half of the system timer counter range.
+ * @details Deadlines are considered expired when their distance in the
+ *          past is within this window, it makes the comparisons immune
+ *          to the counter wrapping.
+ */
+#define HRT_TIME_HALF               ((systime_t)((systime_t)-1) >> 1)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Alarm channel serving the module.
+ */
+static unsigned hrt_alarm;
+
+/**
+ * @brief   List of the armed timers, by increasing deadline.
+ */
+static hrt_timer_t *hrt_list;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns @p true if a deadline is due.
+ *
+ * @param[in] deadline  deadline to be evaluated
+ * @param[in] now       current counter value
+ *
+ * @notapi
+ */
+static bool hrt_is_due(systime_t deadline, systime_t now) {
+
+  return (bool)((systime_t)(now - deadline) <= HRT_TIME_HALF);
+}
+
+static void hrt_serve(unsigned alarm);
+
+/**
+ * @brief   Programs the alarm channel on the first pending deadline.
+ * @details Deadlines too close to the counter are anticipated by
+ *          @p HRT_MIN_DELTA so the compare event cannot be missed. With
+ *          an empty list the channel is stopped.
+ *
+ * @param[in] now       current counter value
+ *
+ * @notapi
+ */
+static void hrt_reprogram(systime_t now) {
+  systime_t t;
+
+  if (hrt_list == NULL) {
+    if (stIsAlarmActiveN(hrt_alarm)) {
+      stStopAlarmN(hrt_alarm);
+    }
+    return;
+  }
+
+  t = hrt_list->deadline;
+  if ((systime_t)(t - now) < (systime_t)HRT_MIN_DELTA) {
+    t = now + (systime_t)HRT_MIN_DELTA;
+  }
+
+  if (stIsAlarmActiveN(hrt_alarm)) {
+    stSetAlarmN(hrt_alarm, t);
+  }
+  else {
+    stStartAlarmN(hrt_alarm, t, hrt_serve);
+  }
+}
+
+/**
+ * @brief   Serves the alarm interrupt.
+ * @details All the expired timers are removed from the list and their
+ *          callbacks invoked, then the channel is programmed on the next
+ *          pending deadline.
+ *
+ * @param[in] alarm     alarm channel number
+ *
+ * @notapi
+ */
+static void hrt_serve(unsigned alarm) {
+
+  (void)alarm;
+
+  osalSysLockFromISR();
+
+  while (hrt_list != NULL) {
+    systime_t now = stGetCounter();
+    hrt_timer_t *htp = hrt_list;
+    hrtfunc_t func;
+
+    if (!hrt_is_due(htp->deadline, now)) {
+      break;
+    }
+
+    /* The timer is disarmed before invoking the callback so it can be
+       restarted from the callback itself.*/
+    hrt_list  = htp->next;
+    func      = htp->func;
+    htp->func = NULL;
+    func(htp->par);
+  }
+
+  hrt_reprogram(stGetCounter());
+
+  osalSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   High resolution timers initialization.
+ *
+ * @param[in] alarm     additional alarm channel to be used, must be
+ *                      greater than zero
+ *
+ * @init
+ */
+void hrtInit(unsigned alarm) {
+
+  osalDbgCheck((alarm > 0U) && (alarm < (unsigned)ST_LLD_NUM_ALARMS));
+
+  hrt_alarm = alarm;
+  hrt_list  = NULL;
+}
+
+/**
+ * @brief   Initializes a timer object.
+ *
+ * @param[out] htp      pointer to the @p hrt_timer_t object
+ *
+ * @init
+ */
+void hrtObjectInit(hrt_timer_t *htp) {
+
+  htp->func = NULL;
+}
+
+/**
+ * @brief   Arms a one-shot timer.
+ * @details The deadline is expressed as a delay in system timer counter
+ *          units, the @p HRT_US2TICKS() macro converts from
+ *          microseconds. The callback is invoked in ISR context.
+ *
+ * @param[in] htp       pointer to the @p hrt_timer_t object
+ * @param[in] delay     delay in system timer counter units
+ * @param[in] func      callback function
+ * @param[in] par       callback argument
+ *
+ * @iclass
+ */
+void hrtStartI(hrt_timer_t *htp, systime_t delay,
+               hrtfunc_t func, void *par) {
+  systime_t now = stGetCounter();
+  hrt_timer_t **pp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((htp != NULL) && (func != NULL) &&
+               (delay <= HRT_TIME_HALF));
+  osalDbgAssert(htp->func == NULL, "already armed");
+
+  htp->deadline = now + delay;
+  htp->func     = func;
+  htp->par      = par;
+
+  /* Ordered insertion, the distances from the current counter value are
+     compared so the ordering is immune to the counter wrapping.*/
+  pp = &hrt_list;
+  while ((*pp != NULL) &&
+         ((systime_t)((*pp)->deadline - now) <= delay)) {
+    pp = &(*pp)->next;
+  }
+  htp->next = *pp;
+  *pp = htp;
+
+  if (hrt_list == htp) {
+    hrt_reprogram(now);
+  }
+}
+
+/**
+ * @brief   Arms a one-shot timer.
+ *
+ * @param[in] htp       pointer to the @p hrt_timer_t object
+ * @param[in] delay     delay in system timer counter units
+ * @param[in] func      callback function
+ * @param[in] par       callback argument
+ *
+ * @api
+ */
+void hrtStart(hrt_timer_t *htp, systime_t delay,
+              hrtfunc_t func, void *par) {
+
+  osalSysLock();
+  hrtStartI(htp, delay, func, par);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Disarms a timer.
+ * @note    Disarming a timer which is not armed is allowed and has no
+ *          effect.
+ *
+ * @param[in] htp       pointer to the @p hrt_timer_t object
+ *
+ * @iclass
+ */
+void hrtStopI(hrt_timer_t *htp) {
+  hrt_timer_t **pp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(htp != NULL);
+
+  if (htp->func == NULL) {
+    return;
+  }
+
+  pp = &hrt_list;
+  while (*pp != NULL) {
+    if (*pp == htp) {
+      *pp = htp->next;
+      htp->func = NULL;
+      if (pp == &hrt_list) {
+        hrt_reprogram(stGetCounter());
+      }
+      return;
+    }
+    pp = &(*pp)->next;
+  }
+}
+
+/**
+ * @brief   Disarms a timer.
+ * @note    Disarming a timer which is not armed is allowed and has no
+ *          effect.
+ *
+ * @param[in] htp       pointer to the @p hrt_timer_t object
+ *
+ * @api
+ */
+void hrtStop(hrt_timer_t *htp) {
+
+  osalSysLock();
+  hrtStopI(htp);
+  osalSysUnlock();
+}
+
+/** @} */
@@ -0,0 +1,156 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hrtimer.h
+ * @brief   High resolution timers structures and macros.
+ * @details This module implements a class of one-shot timers multiplexed
+ *          on an additional alarm channel of the system timer, the
+ *          deadlines are expressed directly in system timer counter
+ *          units and the callbacks are served from the compare interrupt
+ *          without going through the virtual timers list, so the only
+ *          latency is the interrupt one. It provides precise timing for
+ *          the few timers that need it without raising the kernel tick
+ *          frequency globally.
+ *
+ * @addtogroup hr_timers
+ * @{
+ */
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Minimum distance of a programmed alarm from the counter.
+ * @details Deadlines closer than this are anticipated, it covers the
+ *          time needed to program the compare channel.
+ */
+#if !defined(HRT_MIN_DELTA) || defined(__DOXYGEN__)
+#define HRT_MIN_DELTA               2
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if OSAL_ST_MODE != OSAL_ST_MODE_FREERUNNING
+#error "high resolution timers require the free running system timer"
+#endif
+
+#if ST_LLD_NUM_ALARMS <= 1
+#error "high resolution timers require an additional ST alarm channel"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a high resolution timer structure.
+ */
+typedef struct hrt_timer hrt_timer_t;
+
+/**
+ * @brief   Type of a high resolution timer callback.
+ * @note    It is invoked in ISR context.
+ */
+typedef void (*hrtfunc_t)(void *par);
+
+/**
+ * @brief   High resolution timer structure.
+ */
+struct hrt_timer {
+  /**
+   * @brief   Next timer in the pending list.
+   */
+  hrt_timer_t           *next;
+  /**
+   * @brief   Absolute deadline in system timer counter units.
+   */
+  systime_t             deadline;
+  /**
+   * @brief   Timer callback function.
+   */
+  hrtfunc_t             func;
+  /**
+   * @brief   Timer callback argument.
+   */
+  void                  *par;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Microseconds to system timer counter units.
+ * @note    The result is rounded upward to the next counter period, with
+ *          the system timer running at 1MHz the mapping is exact.
+ */
+#define HRT_US2TICKS(us)                                                    \
+  ((systime_t)((((uint64_t)(us) * (uint64_t)OSAL_ST_FREQUENCY) +            \
+                999999ULL) / 1000000ULL))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void hrtInit(unsigned alarm);
+  void hrtObjectInit(hrt_timer_t *htp);
+  void hrtStartI(hrt_timer_t *htp, systime_t delay,
+                 hrtfunc_t func, void *par);
+  void hrtStart(hrt_timer_t *htp, systime_t delay,
+                hrtfunc_t func, void *par);
+  void hrtStopI(hrt_timer_t *htp);
+  void hrtStop(hrt_timer_t *htp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns @p true if the timer is armed.
+ *
+ * @param[in] htp       pointer to the @p hrt_timer_t object
+ * @return              The timer state.
+ *
+ * @iclass
+ */
+static inline bool hrtIsArmedI(const hrt_timer_t *htp) {
+
+  return (bool)(htp->func != NULL);
+}
+
+#endif /* HRTIMER_H */
+
+/** @} */
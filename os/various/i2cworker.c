@@ -0,0 +1,210 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    i2cworker.c
+ * @brief   I2C worker thread code.
+ *
+ * @addtogroup i2c_worker
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "i2cworker.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Executes a single transaction.
+ *
+ * @param[in] iwp       pointer to an initialized @p i2c_worker_t structure
+ * @param[in] itp       pointer to the transaction descriptor
+ */
+static void i2c_worker_execute(i2c_worker_t *iwp, i2c_transaction_t *itp) {
+  I2CDriver *i2cp = iwp->iw_i2cp;
+
+#if I2C_USE_MUTUAL_EXCLUSION
+  i2cAcquireBus(i2cp);
+#endif
+  if (itp->txbytes > 0U) {
+    itp->result = i2cMasterTransmitTimeout(i2cp, itp->addr,
+                                           itp->txbuf, itp->txbytes,
+                                           itp->rxbuf, itp->rxbytes,
+                                           itp->timeout);
+  }
+  else {
+    itp->result = i2cMasterReceiveTimeout(i2cp, itp->addr,
+                                          itp->rxbuf, itp->rxbytes,
+                                          itp->timeout);
+  }
+  if (itp->result == MSG_OK) {
+    itp->errors = I2C_NO_ERROR;
+  }
+  else {
+    itp->errors = i2cGetErrors(i2cp);
+  }
+#if I2C_USE_MUTUAL_EXCLUSION
+  i2cReleaseBus(i2cp);
+#endif
+
+  if (itp->callback != NULL) {
+    itp->callback(itp);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p i2c_worker_t structure.
+ *
+ * @param[out] iwp      pointer to the @p i2c_worker_t structure to be
+ *                      initialized
+ * @param[in] i2cp      pointer to the I2C driver to be served, it must be
+ *                      already started
+ *
+ * @init
+ */
+void i2cWorkerObjectInit(i2c_worker_t *iwp, I2CDriver *i2cp) {
+
+  chDbgCheck((iwp != NULL) && (i2cp != NULL));
+
+  iwp->iw_i2cp = i2cp;
+  chSemObjectInit(&iwp->iw_sem, (cnt_t)0);
+  iwp->iw_head = NULL;
+  iwp->iw_tail = NULL;
+}
+
+/**
+ * @brief   Submits a transaction to the worker queue.
+ * @details The function returns immediately, the transaction is executed
+ *          by the worker thread in submission order.
+ * @post    The descriptor is owned by the worker until its completion
+ *          callback has been invoked.
+ *
+ * @param[in] iwp       pointer to an initialized @p i2c_worker_t structure
+ * @param[in] itp       pointer to the transaction descriptor
+ *
+ * @iclass
+ */
+void i2cWorkerSubmitI(i2c_worker_t *iwp, i2c_transaction_t *itp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((iwp != NULL) && (itp != NULL));
+
+  itp->next = NULL;
+  if (iwp->iw_head == NULL) {
+    iwp->iw_head = itp;
+  }
+  else {
+    iwp->iw_tail->next = itp;
+  }
+  iwp->iw_tail = itp;
+  chSemSignalI(&iwp->iw_sem);
+}
+
+/**
+ * @brief   Submits a transaction to the worker queue.
+ * @details The function returns immediately, the transaction is executed
+ *          by the worker thread in submission order.
+ * @post    The descriptor is owned by the worker until its completion
+ *          callback has been invoked.
+ *
+ * @param[in] iwp       pointer to an initialized @p i2c_worker_t structure
+ * @param[in] itp       pointer to the transaction descriptor
+ *
+ * @api
+ */
+void i2cWorkerSubmit(i2c_worker_t *iwp, i2c_transaction_t *itp) {
+
+  chSysLock();
+  i2cWorkerSubmitI(iwp, itp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Requests the termination of a worker thread.
+ * @details The worker completes the transaction in progress, if any, then
+ *          exits without executing the still queued transactions. The
+ *          caller should wait for the actual termination using
+ *          @p chThdWait().
+ *
+ * @param[in] iwp       pointer to an initialized @p i2c_worker_t structure
+ * @param[in] tp        pointer to the worker thread
+ *
+ * @api
+ */
+void i2cWorkerTerminate(i2c_worker_t *iwp, thread_t *tp) {
+
+  chThdTerminate(tp);
+  chSemSignal(&iwp->iw_sem);
+}
+
+/**
+ * @brief   I2C worker thread function.
+ * @details The thread waits on the transaction queue and executes the
+ *          queued transactions in order, it is meant to be spawned by the
+ *          application with @p chThdCreateStatic() or similar, the
+ *          argument must point to an initialized @p i2c_worker_t
+ *          structure.
+ *
+ * @param[in] p         pointer to an initialized @p i2c_worker_t structure
+ */
+THD_FUNCTION(i2cWorkerThread, p) {
+  i2c_worker_t *iwp = p;
+
+  while (true) {
+    i2c_transaction_t *itp;
+
+    (void) chSemWait(&iwp->iw_sem);
+    if (chThdShouldTerminateX()) {
+      break;
+    }
+
+    chSysLock();
+    itp = iwp->iw_head;
+    iwp->iw_head = itp->next;
+    if (iwp->iw_head == NULL) {
+      iwp->iw_tail = NULL;
+    }
+    chSysUnlock();
+
+    i2c_worker_execute(iwp, itp);
+  }
+}
+
+/** @} */
@@ -0,0 +1,170 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    i2cworker.h
+ * @brief   I2C worker thread structures and macros.
+ * @details This module implements an asynchronous front end for the
+ *          synchronous I2C driver API. Transactions are submitted to a
+ *          per-driver queue without blocking, a dedicated worker thread
+ *          executes them in order using @p i2cMasterTransmitTimeout() and
+ *          @p i2cMasterReceiveTimeout() and invokes a completion callback
+ *          after each one. The submitting thread can issue a whole batch
+ *          of transfers up front and perform unrelated work while the
+ *          bus traffic proceeds.
+ *
+ * @addtogroup i2c_worker
+ * @{
+ */
+
+#ifndef I2CWORKER_H
+#define I2CWORKER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !HAL_USE_I2C
+#error "I2C workers require HAL_USE_I2C"
+#endif
+
+#if !CH_CFG_USE_SEMAPHORES
+#error "I2C workers require CH_CFG_USE_SEMAPHORES"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a queued I2C transaction descriptor.
+ */
+typedef struct i2c_transaction i2c_transaction_t;
+
+/**
+ * @brief   Type of a transaction completion callback.
+ * @details The callback is invoked from the worker thread context after
+ *          the transaction result has been stored in the descriptor.
+ *
+ * @param[in] itp       pointer to the completed transaction descriptor
+ */
+typedef void (*i2ctxncallback_t)(i2c_transaction_t *itp);
+
+/**
+ * @brief   Queued I2C transaction descriptor.
+ * @details The descriptor is owned by the worker from submission until the
+ *          completion callback has been invoked, it must not be modified
+ *          or reused in this interval.
+ */
+struct i2c_transaction {
+  /**
+   * @brief   Slave device address without the R/W bit.
+   */
+  i2caddr_t             addr;
+  /**
+   * @brief   Transmit buffer or @p NULL for a receive-only transaction.
+   */
+  const uint8_t         *txbuf;
+  /**
+   * @brief   Number of bytes to be transmitted.
+   */
+  size_t                txbytes;
+  /**
+   * @brief   Receive buffer or @p NULL for a transmit-only transaction.
+   */
+  uint8_t               *rxbuf;
+  /**
+   * @brief   Number of bytes to be received.
+   */
+  size_t                rxbytes;
+  /**
+   * @brief   Timeout applied to the transaction.
+   */
+  sysinterval_t         timeout;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  i2ctxncallback_t      callback;
+  /**
+   * @brief   Transaction result, @p MSG_OK, @p MSG_RESET or @p MSG_TIMEOUT.
+   */
+  msg_t                 result;
+  /**
+   * @brief   Error flags sampled after a failed transaction.
+   */
+  i2cflags_t            errors;
+  /**
+   * @brief   Next transaction in the queue, managed by the worker.
+   */
+  i2c_transaction_t     *next;
+};
+
+/**
+ * @brief   Type of an I2C worker structure.
+ */
+typedef struct {
+  /**
+   * @brief   Associated I2C driver.
+   */
+  I2CDriver             *iw_i2cp;
+  /**
+   * @brief   Counter semaphore tracking the queued transactions.
+   */
+  semaphore_t           iw_sem;
+  /**
+   * @brief   Head of the queued transactions list.
+   */
+  i2c_transaction_t     *iw_head;
+  /**
+   * @brief   Tail of the queued transactions list.
+   */
+  i2c_transaction_t     *iw_tail;
+} i2c_worker_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2cWorkerObjectInit(i2c_worker_t *iwp, I2CDriver *i2cp);
+  void i2cWorkerSubmitI(i2c_worker_t *iwp, i2c_transaction_t *itp);
+  void i2cWorkerSubmit(i2c_worker_t *iwp, i2c_transaction_t *itp);
+  void i2cWorkerTerminate(i2c_worker_t *iwp, thread_t *tp);
+  THD_FUNCTION(i2cWorkerThread, p);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2CWORKER_H */
+
+/** @} */
@@ -0,0 +1,200 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    iosel.c
+ * @brief   I/O sources selector code.
+ *
+ * @addtogroup io_selector
+ * @{
+ */
+
+#include "ch.h"
+#include "iosel.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Claims a slot for the calling thread.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be claimed
+ */
+static void iosel_claim_slot(io_selector_t *isp, unsigned slot) {
+
+  chDbgCheck(slot < IOSEL_MAX_SOURCES);
+  chDbgAssert((isp->is_thread == NULL) || (isp->is_thread == chThdGetSelfX()),
+              "selector bound to another thread");
+  chDbgAssert((isp->is_mask & EVENT_MASK(slot)) == (eventmask_t)0,
+              "slot already registered");
+
+  isp->is_thread = chThdGetSelfX();
+  isp->is_mask |= EVENT_MASK(slot);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p io_selector_t structure.
+ *
+ * @param[out] isp      pointer to the @p io_selector_t structure to be
+ *                      initialized
+ */
+void ioselObjectInit(io_selector_t *isp) {
+  unsigned i;
+
+  isp->is_thread = NULL;
+  isp->is_mask = (eventmask_t)0;
+  for (i = 0; i < (unsigned)IOSEL_MAX_SOURCES; i++) {
+    isp->is_probes[i] = NULL;
+    isp->is_args[i] = NULL;
+  }
+}
+
+/**
+ * @brief   Registers an event source on a selector slot.
+ * @details The slot becomes ready when the event source is broadcast with
+ *          at least one of the specified flags, the pending flags can be
+ *          retrieved using @p ioselGetAndClearFlags(). Works with any
+ *          @p event_source_t, channel event sources, CAN driver sources
+ *          and so on.
+ * @note    Registration binds the selector to the calling thread, all the
+ *          registrations and the waits must be performed by the same
+ *          thread.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be assigned
+ * @param[in] esp       pointer to the @p event_source_t to be registered
+ * @param[in] flags     mask of the event flags to be notified, use
+ *                      @p (eventflags_t)-1 for any flag
+ */
+void ioselAddEventSource(io_selector_t *isp, unsigned slot,
+                         event_source_t *esp, eventflags_t flags) {
+
+  iosel_claim_slot(isp, slot);
+  chEvtRegisterMaskWithFlags(esp, &isp->is_els[slot],
+                             EVENT_MASK(slot), flags);
+}
+
+/**
+ * @brief   Registers a polled probe on a selector slot.
+ * @details The probe is evaluated on entry to @p ioselWaitAnyTimeout(),
+ *          suitable for sources without a notification path, for example
+ *          mailboxes. Because polled slots are only re-evaluated when the
+ *          selector is entered, they should be paired with a finite wait
+ *          timeout or with an @p ioselSignalI() call from the producer
+ *          side.
+ * @note    Registration binds the selector to the calling thread, all the
+ *          registrations and the waits must be performed by the same
+ *          thread.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be assigned
+ * @param[in] probe     function returning @p true when the source is ready
+ * @param[in] arg       argument passed to the probe function
+ */
+void ioselAddProbe(io_selector_t *isp, unsigned slot,
+                   iosel_probe_t probe, void *arg) {
+
+  chDbgCheck(probe != NULL);
+
+  iosel_claim_slot(isp, slot);
+  isp->is_probes[slot] = probe;
+  isp->is_args[slot] = arg;
+}
+
+/**
+ * @brief   Registers a signaled slot.
+ * @details The slot becomes ready when the producer side invokes
+ *          @p ioselSignal() or @p ioselSignalI() on it, suitable for
+ *          gluing queue notification callbacks, semaphores or ISRs into
+ *          the selector.
+ * @note    Registration binds the selector to the calling thread, all the
+ *          registrations and the waits must be performed by the same
+ *          thread.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be assigned
+ */
+void ioselAddSignal(io_selector_t *isp, unsigned slot) {
+
+  iosel_claim_slot(isp, slot);
+}
+
+/**
+ * @brief   Waits for any of the registered sources to become ready.
+ * @details The polled probes are evaluated first, if none is ready then
+ *          the thread sleeps until a registered event fires or the timeout
+ *          expires. Events accumulated while the thread was busy are
+ *          returned immediately.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout, not recommended
+ *                        when polled probes are registered.
+ *                      .
+ * @return              The mask of the ready slots, slot @p n is reported
+ *                      as bit @p EVENT_MASK(n).
+ * @retval 0            if the operation has timed out.
+ */
+eventmask_t ioselWaitAnyTimeout(io_selector_t *isp, sysinterval_t timeout) {
+  eventmask_t ready = (eventmask_t)0;
+  unsigned i;
+
+  chDbgAssert(isp->is_thread == chThdGetSelfX(), "not the bound thread");
+
+  /* Evaluating the polled probes first.*/
+  for (i = 0; i < (unsigned)IOSEL_MAX_SOURCES; i++) {
+    if ((isp->is_probes[i] != NULL) && isp->is_probes[i](isp->is_args[i])) {
+      ready |= EVENT_MASK(i);
+    }
+  }
+
+  /* If a probe is ready then pending events are collected without
+     sleeping, else waiting for events.*/
+  if (ready != (eventmask_t)0) {
+    ready |= chEvtGetAndClearEvents(isp->is_mask);
+  }
+  else {
+    ready = chEvtWaitAnyTimeout(isp->is_mask, timeout);
+  }
+
+  return ready;
+}
+
+/** @} */
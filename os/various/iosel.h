@@ -0,0 +1,196 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    iosel.h
+ * @brief   I/O sources selector structures and macros.
+ * @details This module multiplexes heterogeneous notification sources,
+ *          event sources, queue notification callbacks, mailbox or
+ *          semaphore posters, into a single wait point: one thread blocks
+ *          in @p ioselWaitAnyTimeout() and receives a bitmap of the ready
+ *          sources. Each source occupies a slot, slot @p n is reported as
+ *          bit @p EVENT_MASK(n) in the returned mask.
+ *
+ * @addtogroup io_selector
+ * @{
+ */
+
+#ifndef IOSEL_H
+#define IOSEL_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of slots in a selector.
+ */
+#if !defined(IOSEL_MAX_SOURCES) || defined(__DOXYGEN__)
+#define IOSEL_MAX_SOURCES           8
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !CH_CFG_USE_EVENTS
+#error "I/O Selectors require CH_CFG_USE_EVENTS"
+#endif
+
+#if !CH_CFG_USE_EVENTS_TIMEOUT
+#error "I/O Selectors require CH_CFG_USE_EVENTS_TIMEOUT"
+#endif
+
+#if (IOSEL_MAX_SOURCES < 1) || (IOSEL_MAX_SOURCES > 32)
+#error "invalid IOSEL_MAX_SOURCES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a polled source probe function.
+ * @details The probe is evaluated on entry to @p ioselWaitAnyTimeout(),
+ *          it must return @p true if the source is ready. It is called
+ *          outside any critical zone.
+ *
+ * @param[in] arg       argument registered together with the probe
+ */
+typedef bool (*iosel_probe_t)(void *arg);
+
+/**
+ * @brief   Type of an I/O selector structure.
+ */
+typedef struct {
+  /**
+   * @brief   Thread bound to the selector or @p NULL.
+   */
+  thread_t              *is_thread;
+  /**
+   * @brief   Mask of the registered slots.
+   */
+  eventmask_t           is_mask;
+  /**
+   * @brief   Per-slot event listeners, used by event source slots.
+   */
+  event_listener_t      is_els[IOSEL_MAX_SOURCES];
+  /**
+   * @brief   Per-slot probe functions or @p NULL.
+   */
+  iosel_probe_t         is_probes[IOSEL_MAX_SOURCES];
+  /**
+   * @brief   Per-slot probe arguments.
+   */
+  void                  *is_args[IOSEL_MAX_SOURCES];
+} io_selector_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ioselObjectInit(io_selector_t *isp);
+  void ioselAddEventSource(io_selector_t *isp, unsigned slot,
+                           event_source_t *esp, eventflags_t flags);
+  void ioselAddProbe(io_selector_t *isp, unsigned slot,
+                     iosel_probe_t probe, void *arg);
+  void ioselAddSignal(io_selector_t *isp, unsigned slot);
+  eventmask_t ioselWaitAnyTimeout(io_selector_t *isp, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Signals a slot from ISR context.
+ * @details The bound thread is woken up, if waiting, and the slot is
+ *          reported in the returned ready mask.
+ * @pre     The slot must have been registered with @p ioselAddSignal()
+ *          and the selector must have been waited upon at least once.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be signaled
+ *
+ * @iclass
+ */
+static inline void ioselSignalI(io_selector_t *isp, unsigned slot) {
+
+  chDbgCheck(slot < IOSEL_MAX_SOURCES);
+
+  if (isp->is_thread != NULL) {
+    chEvtSignalI(isp->is_thread, EVENT_MASK(slot));
+  }
+}
+
+/**
+ * @brief   Signals a slot.
+ * @details The bound thread is woken up, if waiting, and the slot is
+ *          reported in the returned ready mask.
+ * @pre     The slot must have been registered with @p ioselAddSignal()
+ *          and the selector must have been waited upon at least once.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be signaled
+ *
+ * @api
+ */
+static inline void ioselSignal(io_selector_t *isp, unsigned slot) {
+
+  chSysLock();
+  ioselSignalI(isp, slot);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns and clears the event flags pending on a slot.
+ * @details Meant to be used on event source slots after the slot has been
+ *          reported ready, for example in order to inspect the channel
+ *          condition flags.
+ *
+ * @param[in] isp       pointer to an initialized @p io_selector_t structure
+ * @param[in] slot      slot to be queried
+ * @return              The pending event flags.
+ *
+ * @api
+ */
+static inline eventflags_t ioselGetAndClearFlags(io_selector_t *isp,
+                                                 unsigned slot) {
+
+  chDbgCheck(slot < IOSEL_MAX_SOURCES);
+
+  return chEvtGetAndClearFlags(&isp->is_els[slot]);
+}
+
+#endif /* IOSEL_H */
+
+/** @} */
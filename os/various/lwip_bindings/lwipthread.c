@@ -81,6 +81,19 @@
 
 #define PERIODIC_TIMER_ID       1
 #define FRAME_RECEIVED_ID       2
+#define FRAME_TX_PENDING_ID     4
+
+#if LWIP_MAC_ZERO_COPY_RX
+#if !MAC_USE_ZERO_COPY
+#error "LWIP_MAC_ZERO_COPY_RX requires MAC_USE_ZERO_COPY"
+#endif
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "LWIP_MAC_ZERO_COPY_RX requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+#if ETH_PAD_SIZE
+#error "LWIP_MAC_ZERO_COPY_RX is not compatible with ETH_PAD_SIZE"
+#endif
+#endif /* LWIP_MAC_ZERO_COPY_RX */
 
 /*
  * Suspension point for initialization procedure.
@@ -92,6 +105,100 @@ thread_reference_t lwip_trp = NULL;
  */
 static THD_WORKING_AREA(wa_lwip_thread, LWIP_THREAD_STACK_SIZE);
 
+#if LWIP_MAC_TX_HANDOFF || LWIP_MAC_ZERO_COPY_RX
+static thread_t *mac_service_thread;
+#endif
+
+#if LWIP_MAC_ZERO_COPY_RX
+/*
+ * Zero-copy receive pbuf wrapper, the custom pbuf references the MAC
+ * buffer in place and keeps the receive descriptor until freed.
+ */
+typedef struct zc_rx_pbuf {
+  struct pbuf_custom    pc;
+  MACReceiveDescriptor  rd;
+  struct zc_rx_pbuf     *next;
+} zc_rx_pbuf_t;
+
+static zc_rx_pbuf_t zc_rx_pool[LWIP_MAC_ZERO_COPY_RX_SLOTS];
+static zc_rx_pbuf_t *zc_rx_free_list;
+
+/*
+ * Custom pbuf free function, returns the receive descriptor to the DMA
+ * ring and the wrapper to the free list. It can be invoked from any
+ * lwIP thread context.
+ */
+static void zc_rx_pbuf_free(struct pbuf *p) {
+  zc_rx_pbuf_t *zp = (zc_rx_pbuf_t *)p;
+  bool empty;
+
+  macReleaseReceiveDescriptor(&zp->rd);
+
+  chSysLock();
+  empty = (zc_rx_free_list == NULL);
+  zp->next = zc_rx_free_list;
+  zc_rx_free_list = zp;
+  if (empty) {
+    /* The pool was exhausted and reception could have stalled with
+       frames waiting in the DMA ring, waking up the MAC service thread
+       so the ring is drained immediately.*/
+    chEvtSignalI(mac_service_thread, FRAME_RECEIVED_ID);
+    chSchRescheduleS();
+  }
+  chSysUnlock();
+}
+#endif /* LWIP_MAC_ZERO_COPY_RX */
+
+#if LWIP_TX_NOCOPY
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "LWIP_TX_NOCOPY requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+/*
+ * Zero-copy transmit pbuf wrapper, the custom pbuf references the
+ * caller's constant payload in place and carries the completion
+ * callback fired when the stack releases it.
+ */
+typedef struct zc_tx_pbuf {
+  struct pbuf_custom    pc;
+  lwip_tx_done_t        done;
+  void                  *arg;
+  struct zc_tx_pbuf     *next;
+} zc_tx_pbuf_t;
+
+static zc_tx_pbuf_t zc_tx_pool[LWIP_TX_NOCOPY_SLOTS];
+static zc_tx_pbuf_t *zc_tx_free_list;
+
+/*
+ * Custom pbuf free function, fires the completion callback and returns
+ * the wrapper to the free list. It can be invoked from any lwIP thread
+ * context.
+ */
+static void zc_tx_pbuf_free(struct pbuf *p) {
+  zc_tx_pbuf_t *zp = (zc_tx_pbuf_t *)p;
+
+  if (zp->done != NULL)
+    zp->done(zp->arg);
+
+  chSysLock();
+  zp->next = zc_tx_free_list;
+  zc_tx_free_list = zp;
+  chSysUnlock();
+}
+#endif /* LWIP_TX_NOCOPY */
+
+#if LWIP_MAC_TX_HANDOFF
+/*
+ * Lock-free single-producer single-consumer hand-off ring, the producer
+ * is the tcpip_thread in low_level_output(), the consumer is the MAC
+ * service thread. One extra slot distinguishes the full condition from
+ * the empty one.
+ */
+static struct pbuf * volatile tx_ring[LWIP_MAC_TX_HANDOFF_SLOTS + 1];
+static volatile unsigned tx_ring_wr;
+static volatile unsigned tx_ring_rd;
+#endif /* LWIP_MAC_TX_HANDOFF */
+
 /*
  * Initialization.
  */
@@ -106,6 +213,30 @@ static void low_level_init(struct netif *netif) {
   /* don't set NETIF_FLAG_ETHARP if this device is not an Ethernet one */
   netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
 
+#if LWIP_MAC_ZERO_COPY_RX
+  /* Linking the zero-copy wrappers into the free list.*/
+  {
+    int i;
+
+    for (i = 0; i < LWIP_MAC_ZERO_COPY_RX_SLOTS - 1; i++)
+      zc_rx_pool[i].next = &zc_rx_pool[i + 1];
+    zc_rx_pool[LWIP_MAC_ZERO_COPY_RX_SLOTS - 1].next = NULL;
+    zc_rx_free_list = &zc_rx_pool[0];
+  }
+#endif
+
+#if LWIP_TX_NOCOPY
+  /* Linking the zero-copy transmit wrappers into the free list.*/
+  {
+    int i;
+
+    for (i = 0; i < LWIP_TX_NOCOPY_SLOTS - 1; i++)
+      zc_tx_pool[i].next = &zc_tx_pool[i + 1];
+    zc_tx_pool[LWIP_TX_NOCOPY_SLOTS - 1].next = NULL;
+    zc_tx_free_list = &zc_tx_pool[0];
+  }
+#endif
+
   /* Do whatever else is needed to initialize interface. */
 }
 
@@ -124,7 +255,7 @@ static void low_level_init(struct netif *netif) {
  *       to become available since the stack doesn't retry to send a packet
  *       dropped because of memory failure (except for the TCP timers).
  */
-static err_t low_level_output(struct netif *netif, struct pbuf *p) {
+static err_t low_level_transmit(struct netif *netif, struct pbuf *p) {
   struct pbuf *q;
   MACTransmitDescriptor td;
 
@@ -161,6 +292,43 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p) {
   return ERR_OK;
 }
 
+#if LWIP_MAC_TX_HANDOFF
+/*
+ * Posts the frame to the hand-off ring and signals the MAC service
+ * thread, the actual copy into the transmit descriptors is performed
+ * there. When the ring is full a free slot is awaited up to
+ * LWIP_SEND_TIMEOUT, mirroring the descriptor wait of the direct path.
+ */
+static err_t low_level_output(struct netif *netif, struct pbuf *p) {
+  unsigned wr, next;
+  systime_t start;
+
+  (void)netif;
+
+  wr = tx_ring_wr;
+  next = (wr + 1U) % (unsigned)(LWIP_MAC_TX_HANDOFF_SLOTS + 1);
+  start = chVTGetSystemTime();
+  while (next == tx_ring_rd) {
+    if (chVTTimeElapsedSinceX(start) > TIME_MS2I(LWIP_SEND_TIMEOUT)) {
+      macStatsIncrement(tx_ring_full);
+      return ERR_TIMEOUT;
+    }
+    chThdSleepMilliseconds(1);
+  }
+
+  /* The frame is referenced on behalf of the MAC service thread, the
+     matching free is performed there after transmission.*/
+  pbuf_ref(p);
+  tx_ring[wr] = p;
+  tx_ring_wr = next;
+  chEvtSignal(mac_service_thread, FRAME_TX_PENDING_ID);
+
+  return ERR_OK;
+}
+#else /* !LWIP_MAC_TX_HANDOFF */
+#define low_level_output low_level_transmit
+#endif /* !LWIP_MAC_TX_HANDOFF */
+
 /*
  * Receives a frame.
  * Allocates a pbuf and transfers the bytes of the incoming
@@ -170,6 +338,76 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p) {
  * @return a pbuf filled with the received packet (including MAC header)
  *         NULL on memory error
  */
+#if LWIP_MAC_ZERO_COPY_RX
+static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
+  zc_rx_pbuf_t *zp;
+  const uint8_t *buf;
+  size_t size;
+
+  (void)netif;
+
+  osalDbgAssert(pbuf != NULL, "invalid null pointer");
+
+  /* Taking a wrapper from the free list first, if none is available the
+     frame is left in the ring until a pbuf is freed.*/
+  chSysLock();
+  zp = zc_rx_free_list;
+  if (zp != NULL)
+    zc_rx_free_list = zp->next;
+  chSysUnlock();
+  if (zp == NULL) {
+    macStatsIncrement(rx_pool_exhausted);
+    return false;
+  }
+
+  if (macWaitReceiveDescriptor(&ETHD1, &zp->rd, TIME_IMMEDIATE) != MSG_OK) {
+    chSysLock();
+    zp->next = zc_rx_free_list;
+    zc_rx_free_list = zp;
+    chSysUnlock();
+    return false;
+  }
+
+  buf = macGetNextReceiveBuffer(&zp->rd, &size);
+  if ((buf == NULL) || (size < (size_t)zp->rd.size)) {
+    /* The frame spans multiple MAC buffers, it cannot be referenced as a
+       single in-place pbuf and is dropped, the MAC buffers should be
+       sized to hold a whole frame.*/
+    macReleaseReceiveDescriptor(&zp->rd);
+    chSysLock();
+    zp->next = zc_rx_free_list;
+    zc_rx_free_list = zp;
+    chSysUnlock();
+    *pbuf = NULL;
+    macStatsIncrement(rx_overruns);
+    LINK_STATS_INC(link.lenerr);
+    LINK_STATS_INC(link.drop);
+    MIB2_STATS_NETIF_INC(netif, ifindiscards);
+    return true;
+  }
+
+  /* The pbuf references the MAC buffer in place, the descriptor is
+     released by the custom free function when lwIP frees the pbuf.*/
+  zp->pc.custom_free_function = zc_rx_pbuf_free;
+  *pbuf = pbuf_alloced_custom(PBUF_RAW, (u16_t)zp->rd.size, PBUF_REF,
+                              &zp->pc, (void *)(uintptr_t)buf, (u16_t)size);
+
+  MIB2_STATS_NETIF_ADD(netif, ifinoctets, (*pbuf)->tot_len);
+
+  if (*(uint8_t *)((*pbuf)->payload) & 1) {
+    /* broadcast or multicast packet*/
+    MIB2_STATS_NETIF_INC(netif, ifinnucastpkts);
+  }
+  else {
+    /* unicast packet*/
+    MIB2_STATS_NETIF_INC(netif, ifinucastpkts);
+  }
+
+  LINK_STATS_INC(link.recv);
+
+  return true;
+}
+#else /* !LWIP_MAC_ZERO_COPY_RX */
 static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
   MACReceiveDescriptor rd;
   struct pbuf *q;
@@ -220,13 +458,16 @@ static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
   }
   else {
     macReleaseReceiveDescriptor(&rd);     // Drop packet
+    macStatsIncrement(rx_pool_exhausted);
+    macStatsIncrement(rx_overruns);
     LINK_STATS_INC(link.memerr);
     LINK_STATS_INC(link.drop);
     MIB2_STATS_NETIF_INC(netif, ifindiscards);
   }
-  
+
   return true;
 }
+#endif /* !LWIP_MAC_ZERO_COPY_RX */
 
 /*
  * Called at the beginning of the program to set up the
@@ -283,6 +524,13 @@ static THD_FUNCTION(lwip_thread, p) {
 
   chRegSetThreadName(LWIP_THREAD_NAME);
 
+  /* Placement point for multi-core ports.*/
+  LWIP_THREAD_AFFINITY_HOOK(chThdGetSelfX());
+
+#if LWIP_MAC_TX_HANDOFF || LWIP_MAC_ZERO_COPY_RX
+  mac_service_thread = chThdGetSelfX();
+#endif
+
   /* Initializes the thing.*/
   tcpip_init(NULL, NULL);
 
@@ -382,6 +630,19 @@ static THD_FUNCTION(lwip_thread, p) {
       }
     }
     
+#if LWIP_MAC_TX_HANDOFF
+    if (mask & FRAME_TX_PENDING_ID) {
+      while (tx_ring_rd != tx_ring_wr) {
+        struct pbuf *p = tx_ring[tx_ring_rd];
+
+        tx_ring_rd = (tx_ring_rd + 1U) %
+                     (unsigned)(LWIP_MAC_TX_HANDOFF_SLOTS + 1);
+        (void) low_level_transmit(&thisif, p);
+        pbuf_free(p);
+      }
+    }
+#endif
+
     if (mask & FRAME_RECEIVED_ID) {
       struct pbuf *p;
       while (low_level_input(&thisif, &p)) {
@@ -425,4 +686,50 @@ void lwipInit(const lwipthread_opts_t *opts) {
   chSysUnlock();
 }
 
+#if LWIP_TX_NOCOPY || defined(__DOXYGEN__)
+/**
+ * @brief   Wraps a constant payload into a zero-copy transmit pbuf.
+ * @details The returned pbuf references the payload in place, nothing is
+ *          copied into pbuf RAM. On transmission the payload is gathered
+ *          into the MAC transmit descriptors together with the protocol
+ *          headers prepended by the stack. The wrapper is recycled and
+ *          the completion callback fired when the stack frees the pbuf:
+ *          after the descriptor write for UDP and raw sends, after the
+ *          acknowledge for TCP segments queued with references.
+ * @note    The payload must remain valid and unmodified until the
+ *          completion callback has fired, this matters for flash-resident
+ *          content when the flash window can be unmapped around updates.
+ * @note    The caller owns one reference on the returned pbuf and hands
+ *          it over with the usual lwIP rules, for example
+ *          @p udp_sendto() does not consume the reference while
+ *          @p netif->linkoutput() callers do.
+ *
+ * @param[in] data      pointer to the constant payload
+ * @param[in] size      size in bytes of the payload
+ * @param[in] done      completion callback or @p NULL
+ * @param[in] arg       callback argument
+ * @return              The wrapped pbuf.
+ * @retval NULL         if all the wrappers are in use.
+ */
+struct pbuf *lwipWrapConstPbuf(const void *data, u16_t size,
+                               lwip_tx_done_t done, void *arg) {
+  zc_tx_pbuf_t *zp;
+
+  chSysLock();
+  zp = zc_tx_free_list;
+  if (zp != NULL)
+    zc_tx_free_list = zp->next;
+  chSysUnlock();
+  if (zp == NULL)
+    return NULL;
+
+  zp->done = done;
+  zp->arg  = arg;
+  zp->pc.custom_free_function = zc_tx_pbuf_free;
+
+  return pbuf_alloced_custom(PBUF_RAW, size, PBUF_ROM, &zp->pc,
+                             (void *)(uintptr_t)data, size);
+}
+#endif /* LWIP_TX_NOCOPY */
+
 /** @} */
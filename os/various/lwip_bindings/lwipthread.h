@@ -145,6 +145,84 @@
 #define LWIP_ETHADDR_5                      0x46
 #endif
 
+/**
+ * @brief   Enables the zero-copy receive path.
+ * @details Received frames are wrapped into custom pbufs referencing the
+ *          MAC receive buffers and processed in place, the receive
+ *          descriptor is returned to the DMA ring when the pbuf is
+ *          freed, removing the per-frame copy from the receive path.
+ * @note    It requires @p MAC_USE_ZERO_COPY in the HAL configuration and
+ *          @p LWIP_SUPPORT_CUSTOM_PBUF in the lwIP configuration, the
+ *          MAC buffers must be large enough to hold a whole frame.
+ */
+#if !defined(LWIP_MAC_ZERO_COPY_RX) || defined(__DOXYGEN__)
+#define LWIP_MAC_ZERO_COPY_RX               0
+#endif
+
+/**
+ * @brief   Number of zero-copy receive pbuf wrappers.
+ * @note    It should match the length of the MAC receive ring, a frame
+ *          is dropped when no wrapper is available.
+ */
+#if !defined(LWIP_MAC_ZERO_COPY_RX_SLOTS) || defined(__DOXYGEN__)
+#define LWIP_MAC_ZERO_COPY_RX_SLOTS         4
+#endif
+
+/**
+ * @brief   Enables the transmit hand-off queue.
+ * @details Outgoing frames are posted by the tcpip_thread to a lock-free
+ *          hand-off ring and copied into the MAC transmit descriptors by
+ *          the MAC service thread, the tcpip_thread never blocks waiting
+ *          for room in the transmit ring and the MAC service work is kept
+ *          off the stack processing context.
+ */
+#if !defined(LWIP_MAC_TX_HANDOFF) || defined(__DOXYGEN__)
+#define LWIP_MAC_TX_HANDOFF                 0
+#endif
+
+/**
+ * @brief   Depth of the transmit hand-off ring.
+ * @note    When the ring is full the tcpip_thread falls back to waiting,
+ *          polling for a free slot up to @p LWIP_SEND_TIMEOUT.
+ */
+#if !defined(LWIP_MAC_TX_HANDOFF_SLOTS) || defined(__DOXYGEN__)
+#define LWIP_MAC_TX_HANDOFF_SLOTS           4
+#endif
+
+/**
+ * @brief   Enables the zero-copy transmit wrapper API.
+ * @details Flash-resident constant payloads can be wrapped into custom
+ *          read-only pbufs through @p lwipWrapConstPbuf() and sent
+ *          without being copied into pbuf RAM, the payload is gathered
+ *          into the MAC transmit descriptors straight from its original
+ *          location. A completion callback carried by the wrapper fires
+ *          when the stack releases the payload.
+ * @note    It requires @p LWIP_SUPPORT_CUSTOM_PBUF in the lwIP
+ *          configuration.
+ */
+#if !defined(LWIP_TX_NOCOPY) || defined(__DOXYGEN__)
+#define LWIP_TX_NOCOPY                      0
+#endif
+
+/**
+ * @brief   Number of zero-copy transmit pbuf wrappers.
+ * @note    It bounds the number of in-flight constant payloads, for TCP
+ *          a wrapper stays in use until the segment is acknowledged.
+ */
+#if !defined(LWIP_TX_NOCOPY_SLOTS) || defined(__DOXYGEN__)
+#define LWIP_TX_NOCOPY_SLOTS                8
+#endif
+
+/**
+ * @brief   Placement hook for the MAC service thread.
+ * @details Invoked by the MAC service thread on itself before entering the
+ *          service loop, multi-core ports can use it to bind or migrate
+ *          the thread to the instance serving the network hardware.
+ */
+#if !defined(LWIP_THREAD_AFFINITY_HOOK) || defined(__DOXYGEN__)
+#define LWIP_THREAD_AFFINITY_HOOK(tp)
+#endif
+
 /**
  * @brief   Interface name byte 0.
  */
@@ -234,10 +312,25 @@ typedef struct lwipthread_opts {
 #endif
 } lwipthread_opts_t;
 
+#if LWIP_TX_NOCOPY || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a zero-copy transmit completion callback.
+ * @details Invoked when the stack has released the wrapped payload, for
+ *          UDP and raw sends after the frame has been gathered into the
+ *          transmit descriptors, for TCP after the segment has been
+ *          acknowledged. It can be invoked from the tcpip_thread context.
+ */
+typedef void (*lwip_tx_done_t)(void *arg);
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
   void lwipInit(const lwipthread_opts_t *opts);
+#if LWIP_TX_NOCOPY
+  struct pbuf *lwipWrapConstPbuf(const void *data, u16_t size,
+                                 lwip_tx_done_t done, void *arg);
+#endif
 #ifdef __cplusplus
 }
 #endif
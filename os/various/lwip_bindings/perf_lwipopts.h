@@ -0,0 +1,177 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    perf_lwipopts.h
+ * @brief   Performance-oriented lwIP settings profile.
+ * @details Optional profile to be included from the project lwipopts.h,
+ *          after static_lwipopts.h. It maps the MAC hardware checksum
+ *          offload onto the lwIP CHECKSUM_GEN_x/CHECKSUM_CHECK_x options
+ *          and sizes the TCP windows and pbuf pools against the MAC ring
+ *          geometry. Every setting can be overridden by defining it before
+ *          including this file.
+ *
+ * @addtogroup perf_lwipopts
+ * @{
+ */
+
+#ifndef PERF_LWIPOPTS_H
+#define PERF_LWIPOPTS_H
+
+/**
+ * @brief   Hardware checksum offload level of the MAC.
+ * @details It must match the checksum offload mode configured in the MAC
+ *          driver, for STM32 devices the value of
+ *          @p STM32_MAC_IP_CHECKSUM_OFFLOAD:
+ *          - 0 No hardware assistance, all checksums in software.
+ *          - 1 IP header checksums generated and verified in hardware.
+ *          - 3 IP header and payload checksums, including the
+ *              pseudo-header, generated and verified in hardware.
+ *          .
+ * @note    Mode 2 (payload checksum without pseudo-header) is not usable
+ *          with lwIP because the stack cannot pre-insert the pseudo-header
+ *          sum, it is rejected at compile time.
+ */
+#if !defined(PERF_LWIP_HW_CHECKSUM)
+#define PERF_LWIP_HW_CHECKSUM           0
+#endif
+
+/**
+ * @brief   Depth of the MAC receive ring.
+ * @details It should match the MAC driver setting, for STM32 devices the
+ *          value of @p STM32_MAC_RECEIVE_BUFFERS.
+ */
+#if !defined(PERF_LWIP_MAC_RX_RING)
+#define PERF_LWIP_MAC_RX_RING           4
+#endif
+
+/**
+ * @brief   Depth of the MAC transmit ring.
+ * @details It should match the MAC driver setting, for STM32 devices the
+ *          value of @p STM32_MAC_TRANSMIT_BUFFERS.
+ */
+#if !defined(PERF_LWIP_MAC_TX_RING)
+#define PERF_LWIP_MAC_TX_RING           2
+#endif
+
+#if PERF_LWIP_HW_CHECKSUM == 2
+#error "checksum offload mode 2 is not usable with lwIP, use 0, 1 or 3"
+#endif
+
+/* Checksums already generated and verified by the MAC are not computed
+   again in software, frames failing the hardware verification are dropped
+   by the low level driver and never reach the stack.*/
+#if PERF_LWIP_HW_CHECKSUM >= 1
+#if !defined(CHECKSUM_GEN_IP)
+#define CHECKSUM_GEN_IP                 0
+#endif
+#if !defined(CHECKSUM_CHECK_IP)
+#define CHECKSUM_CHECK_IP               0
+#endif
+#endif
+
+#if PERF_LWIP_HW_CHECKSUM == 3
+#if !defined(CHECKSUM_GEN_TCP)
+#define CHECKSUM_GEN_TCP                0
+#endif
+#if !defined(CHECKSUM_GEN_UDP)
+#define CHECKSUM_GEN_UDP                0
+#endif
+#if !defined(CHECKSUM_GEN_ICMP)
+#define CHECKSUM_GEN_ICMP               0
+#endif
+#if !defined(CHECKSUM_CHECK_TCP)
+#define CHECKSUM_CHECK_TCP              0
+#endif
+#if !defined(CHECKSUM_CHECK_UDP)
+#define CHECKSUM_CHECK_UDP              0
+#endif
+#if !defined(CHECKSUM_CHECK_ICMP)
+#define CHECKSUM_CHECK_ICMP             0
+#endif
+#endif
+
+/* Full Ethernet segment size, path MTU discovery is not needed on a LAN
+   and smaller segments waste ring slots.*/
+#if !defined(TCP_MSS)
+#define TCP_MSS                         1460
+#endif
+
+/* Receive window of four full segments, enough to keep the pipe filled
+   on a 100 Mb link without wasting RAM on buffering the stack cannot
+   drain anyway.*/
+#if !defined(TCP_WND)
+#define TCP_WND                         (4 * TCP_MSS)
+#endif
+
+/* Send buffer matching the receive window of the typical peer.*/
+#if !defined(TCP_SND_BUF)
+#define TCP_SND_BUF                     (4 * TCP_MSS)
+#endif
+
+/* lwIP requires at least twice TCP_SND_BUF expressed in segments, small
+   writes consume one queue entry each so some extra slack is left.*/
+#if !defined(TCP_SND_QUEUELEN)
+#define TCP_SND_QUEUELEN                (4 * (TCP_SND_BUF / TCP_MSS))
+#endif
+
+#if !defined(MEMP_NUM_TCP_SEG)
+#define MEMP_NUM_TCP_SEG                TCP_SND_QUEUELEN
+#endif
+
+/* Each pool pbuf holds a whole frame so a received frame never spans
+   pbufs, the value matches the usual MAC buffer size of 1522 bytes
+   rounded up to the alignment.*/
+#if !defined(PBUF_POOL_BUFSIZE)
+#define PBUF_POOL_BUFSIZE               1524
+#endif
+
+/* Enough pool pbufs to drain a full receive ring while a window worth of
+   segments is still queued in the stack.*/
+#if !defined(PBUF_POOL_SIZE)
+#define PBUF_POOL_SIZE                  ((2 * PERF_LWIP_MAC_RX_RING) +      \
+                                         (TCP_WND / TCP_MSS))
+#endif
+
+/* Heap sized for a full send buffer in PBUF_RAM pbufs plus one frame per
+   transmit ring slot in flight.*/
+#if !defined(MEM_SIZE)
+#define MEM_SIZE                        (TCP_SND_BUF +                      \
+                                         ((PERF_LWIP_MAC_TX_RING + 2) *     \
+                                          PBUF_POOL_BUFSIZE))
+#endif
+
+/* Mailboxes deep enough that the driver thread never blocks posting a
+   burst of received frames.*/
+#if !defined(TCPIP_MBOX_SIZE)
+#define TCPIP_MBOX_SIZE                 PBUF_POOL_SIZE
+#endif
+#if !defined(DEFAULT_RAW_RECVMBOX_SIZE)
+#define DEFAULT_RAW_RECVMBOX_SIZE       PBUF_POOL_SIZE
+#endif
+#if !defined(DEFAULT_UDP_RECVMBOX_SIZE)
+#define DEFAULT_UDP_RECVMBOX_SIZE       PBUF_POOL_SIZE
+#endif
+#if !defined(DEFAULT_TCP_RECVMBOX_SIZE)
+#define DEFAULT_TCP_RECVMBOX_SIZE       PBUF_POOL_SIZE
+#endif
+#if !defined(DEFAULT_ACCEPTMBOX_SIZE)
+#define DEFAULT_ACCEPTMBOX_SIZE         4
+#endif
+
+#endif  /* PERF_LWIPOPTS_H */
+
+/** @} */
@@ -0,0 +1,275 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    profiler.c
+ * @brief   Sampling profiler code.
+ *
+ * @addtogroup profiler
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "profiler.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Bound GPT unit, NULL if not bound.
+ */
+static GPTDriver *prof_gptp;
+
+/**
+ * @brief   GPT configuration used while sampling.
+ */
+static const GPTConfig *prof_cfgp;
+
+/**
+ * @brief   Sampling activity flag.
+ */
+static bool prof_running;
+
+/**
+ * @brief   Samples ring, written from the GPT callback only.
+ */
+static profiler_sample_t prof_ring[PROFILER_RING_SIZE];
+
+/**
+ * @brief   Free-running write index, producer side.
+ */
+static volatile uint32_t prof_wr;
+
+/**
+ * @brief   Free-running read index, consumer side.
+ */
+static volatile uint32_t prof_rd;
+
+/**
+ * @brief   Total number of taken samples.
+ */
+static volatile uint32_t prof_samples;
+
+/**
+ * @brief   Number of samples lost because the ring was full.
+ */
+static volatile uint32_t prof_dropped;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Captures the program counter of the preempted context.
+ * @details On ARM Cortex-M ports the PC is read from the hardware-stacked
+ *          exception frame on the process stack. Samples taken while
+ *          another interrupt was preempted are still attributed to the
+ *          last preempted thread context, an acceptable approximation
+ *          for a statistical profiler.
+ *
+ * @notapi
+ */
+static inline uint32_t prof_capture_pc(void) {
+#if defined(PORT_ARCHITECTURE_ARM) && !defined(__DOXYGEN__)
+  uint32_t psp;
+
+  __asm volatile ("mrs     %0, PSP" : "=r" (psp) : : "memory");
+  return ((uint32_t *)psp)[6];
+#else
+  return 0U;
+#endif
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   GPT periodic callback, the sampling point.
+ * @details Pushing a sample is a pair of plain stores and an index
+ *          increment, the ring is single-producer/single-consumer so no
+ *          locking is involved.
+ * @note    This function must be referenced by the @p callback field of
+ *          the GPT configuration passed to @p profilerBind(), it is not
+ *          meant to be called directly.
+ *
+ * @param[in] gptp      pointer to the @p GPTDriver object
+ *
+ * @special
+ */
+void profilerGPTCallback(GPTDriver *gptp) {
+
+  (void)gptp;
+
+  prof_samples++;
+  if ((prof_wr - prof_rd) >= (uint32_t)PROFILER_RING_SIZE) {
+    prof_dropped++;
+    return;
+  }
+  prof_ring[prof_wr & ((uint32_t)PROFILER_RING_SIZE - 1U)].pc = prof_capture_pc();
+  prof_ring[prof_wr & ((uint32_t)PROFILER_RING_SIZE - 1U)].tp = chThdGetSelfX();
+  prof_wr++;
+}
+
+/**
+ * @brief   Binds the profiler to a GPT unit.
+ * @details The unit must not be used for other purposes while the
+ *          profiler is bound, it is started and stopped by
+ *          @p profilerStart() and @p profilerStop().
+ *
+ * @param[in] gptp      pointer to the @p GPTDriver object
+ * @param[in] cfgp      pointer to the GPT configuration to be used, the
+ *                      @p callback field must point to
+ *                      @p profilerGPTCallback()
+ *
+ * @api
+ */
+void profilerBind(GPTDriver *gptp, const GPTConfig *cfgp) {
+
+  osalDbgCheck((gptp != NULL) && (cfgp != NULL) &&
+               (cfgp->frequency > 0U) &&
+               (cfgp->callback == profilerGPTCallback));
+  osalDbgAssert(!prof_running, "sampling in progress");
+
+  prof_gptp = gptp;
+  prof_cfgp = cfgp;
+}
+
+/**
+ * @brief   Starts sampling at the specified rate.
+ * @details The ring and the counters are reset, the bound GPT unit is
+ *          started in continuous mode.
+ *
+ * @param[in] rate      sampling rate in hertz
+ * @return              The operation status.
+ * @retval true         if sampling has been started.
+ * @retval false        if no GPT unit is bound, sampling is already in
+ *                      progress or the rate is not achievable.
+ *
+ * @api
+ */
+bool profilerStart(uint32_t rate) {
+  gptcnt_t interval;
+
+  if ((prof_gptp == NULL) || prof_running ||
+      (rate == 0U) || (rate > prof_cfgp->frequency)) {
+    return false;
+  }
+
+  interval = (gptcnt_t)(prof_cfgp->frequency / rate);
+
+  /* Resetting ring and counters before generating samples.*/
+  prof_wr      = 0U;
+  prof_rd      = 0U;
+  prof_samples = 0U;
+  prof_dropped = 0U;
+
+  gptStart(prof_gptp, prof_cfgp);
+  gptStartContinuous(prof_gptp, interval);
+  prof_running = true;
+
+  return true;
+}
+
+/**
+ * @brief   Stops sampling.
+ * @details The bound GPT unit is stopped, samples already in the ring
+ *          remain available to @p profilerFetch().
+ *
+ * @api
+ */
+void profilerStop(void) {
+
+  if (!prof_running) {
+    return;
+  }
+
+  gptStopTimer(prof_gptp);
+  gptStop(prof_gptp);
+  prof_running = false;
+}
+
+/**
+ * @brief   Returns the sampling activity state.
+ *
+ * @return              The activity state.
+ *
+ * @api
+ */
+bool profilerIsRunning(void) {
+
+  return prof_running;
+}
+
+/**
+ * @brief   Fetches samples from the ring.
+ * @details The consumer side of the lock-free ring, meant to be called
+ *          from a single thread.
+ *
+ * @param[out] sp       pointer to the destination samples array
+ * @param[in] n         maximum number of samples to be fetched
+ * @return              The number of fetched samples.
+ *
+ * @api
+ */
+size_t profilerFetch(profiler_sample_t *sp, size_t n) {
+  size_t fetched = 0U;
+
+  osalDbgCheck((sp != NULL) && (n > 0U));
+
+  while ((fetched < n) && (prof_rd != prof_wr)) {
+    *sp++ = prof_ring[prof_rd & ((uint32_t)PROFILER_RING_SIZE - 1U)];
+    prof_rd++;
+    fetched++;
+  }
+
+  return fetched;
+}
+
+/**
+ * @brief   Returns the sampling counters.
+ *
+ * @param[out] samplesp total number of taken samples, can be NULL
+ * @param[out] droppedp number of samples lost on ring overflow, can be
+ *                      NULL
+ *
+ * @api
+ */
+void profilerGetCounters(uint32_t *samplesp, uint32_t *droppedp) {
+
+  if (samplesp != NULL) {
+    *samplesp = prof_samples;
+  }
+  if (droppedp != NULL) {
+    *droppedp = prof_dropped;
+  }
+}
+
+/** @} */
@@ -0,0 +1,110 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    profiler.h
+ * @brief   Sampling profiler structures and macros.
+ * @details This module implements a statistical sampling profiler built
+ *          on a GPT unit. A periodic callback, running above all thread
+ *          priorities, captures the program counter of the preempted
+ *          context together with the current thread pointer and pushes
+ *          the pair into a lock-free ring. A consumer thread, typically
+ *          the shell "prof" command, drains the ring and aggregates the
+ *          samples into per-PC buckets. The sampling overhead is a few
+ *          tens of cycles per tick so production units can be profiled
+ *          while running their real workload.
+ *
+ * @addtogroup profiler
+ * @{
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of samples in the lock-free ring.
+ * @note    It must be a power of two.
+ */
+#if !defined(PROFILER_RING_SIZE) || defined(__DOXYGEN__)
+#define PROFILER_RING_SIZE          256
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !HAL_USE_GPT
+#error "sampling profiler requires HAL_USE_GPT"
+#endif
+
+#if (PROFILER_RING_SIZE & (PROFILER_RING_SIZE - 1)) != 0
+#error "PROFILER_RING_SIZE must be a power of two"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a profiler sample.
+ */
+typedef struct {
+  /**
+   * @brief   Program counter of the preempted context.
+   */
+  uint32_t              pc;
+  /**
+   * @brief   Thread running when the sample was taken.
+   */
+  thread_t              *tp;
+} profiler_sample_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void profilerGPTCallback(GPTDriver *gptp);
+  void profilerBind(GPTDriver *gptp, const GPTConfig *cfgp);
+  bool profilerStart(uint32_t rate);
+  void profilerStop(void);
+  bool profilerIsRunning(void);
+  size_t profilerFetch(profiler_sample_t *sp, size_t n);
+  void profilerGetCounters(uint32_t *samplesp, uint32_t *droppedp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROFILER_H */
+
+/** @} */
@@ -0,0 +1,243 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    pwrgov.c
+ * @brief   Power Governor code.
+ *
+ * @addtogroup power_governor
+ * @{
+ */
+
+#include "ch.h"
+#include "pwrgov.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the accumulated idle cycles.
+ * @details The kernel idle ledger is preferred when available because it
+ *          can be corrected for the idle window in progress and works
+ *          without the idle thread, else the idle thread consumed cycles
+ *          are used.
+ *
+ * @param[in] now       current realtime counter value
+ * @return              The accumulated idle cycles.
+ */
+static rtcnt_t pwrgov_get_idle(rtcnt_t now) {
+#if CH_CFG_USE_IDLE_CYCLES == TRUE
+  rttime_t idle = chSysGetIdleCyclesX();
+
+  /* The window in progress, if the sampling interrupted the idle loop,
+     is not in the ledger yet.*/
+  if (ch.rlist.current->prio == IDLEPRIO) {
+    idle += (rttime_t)(rtcnt_t)(now - ch.idle_start);
+  }
+
+  return (rtcnt_t)idle;
+#else
+  (void)now;
+
+  return chSysGetIdleTimeX();
+#endif
+}
+
+/**
+ * @brief   Counts the ready threads, idle thread excluded.
+ * @note    The current thread, if not idle, is counted as ready.
+ *
+ * @return              The number of ready threads.
+ */
+static cnt_t pwrgov_ready_count(void) {
+  cnt_t n = (cnt_t)0;
+
+#if CH_CFG_OPTIMIZE_SCHED_BITMAP == TRUE
+  unsigned i;
+
+  for (i = (unsigned)IDLEPRIO + 1U; i < (unsigned)CH_SCH_PRIO_LEVELS; i++) {
+    thread_t *tp = ch.rlist.fifos[i].next;
+
+    while (tp != (thread_t *)&ch.rlist.fifos[i]) {
+      n++;
+      tp = tp->queue.next;
+    }
+  }
+#else
+  thread_t *tp = ch.rlist.queue.next;
+
+  while (tp != (thread_t *)&ch.rlist.queue) {
+    if (tp->prio > IDLEPRIO) {
+      n++;
+    }
+    tp = tp->queue.next;
+  }
+#endif
+
+  if (ch.rlist.current->prio > IDLEPRIO) {
+    n++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Governor sampling timer callback.
+ * @details Closes the current window, evaluates the policy and restarts
+ *          the timer.
+ */
+static void pwrgov_tmrcb(void *p) {
+  pwrgov_t *pgp = p;
+  const pwrgov_config_t *cfg = pgp->pg_config;
+  rtcnt_t cnt, idle, span, idlespan;
+  uint8_t load;
+
+  chSysLockFromISR();
+
+  /* Closing the measurement window, the idle ratio is derived from the
+     cycles consumed by the idle thread.*/
+  cnt = chSysGetRealtimeCounterX();
+  idle = pwrgov_get_idle(cnt);
+  span = cnt - pgp->pg_last_cnt;
+  idlespan = idle - pgp->pg_last_idle;
+  if (idlespan > span) {
+    idlespan = span;
+  }
+  pgp->pg_last_cnt = cnt;
+  pgp->pg_last_idle = idle;
+  load = (uint8_t)(((uint64_t)(span - idlespan) * 100U) / (uint64_t)span);
+  pgp->pg_load = load;
+  pgp->pg_depth = pwrgov_ready_count();
+
+  /* Policy evaluation, a backlog in the ready list forces the busy
+     verdict regardless of the idle ratio of the closed window.*/
+  if ((load >= cfg->pg_up_threshold) || (pgp->pg_depth > (cnt_t)1)) {
+    pgp->pg_down_streak = (uint8_t)0;
+    if (!pgp->pg_high) {
+      pgp->pg_up_streak++;
+      if (pgp->pg_up_streak >= cfg->pg_up_windows) {
+        pgp->pg_up_streak = (uint8_t)0;
+        pgp->pg_high = true;
+        if (cfg->pg_up_cb != NULL) {
+          cfg->pg_up_cb(cfg->pg_arg);
+        }
+      }
+    }
+  }
+  else if (load <= cfg->pg_down_threshold) {
+    pgp->pg_up_streak = (uint8_t)0;
+    if (pgp->pg_high) {
+      pgp->pg_down_streak++;
+      if (pgp->pg_down_streak >= cfg->pg_down_windows) {
+        pgp->pg_down_streak = (uint8_t)0;
+        pgp->pg_high = false;
+        if (cfg->pg_down_cb != NULL) {
+          cfg->pg_down_cb(cfg->pg_arg);
+        }
+      }
+    }
+  }
+  else {
+    /* Inside the hysteresis band, the streaks are restarted.*/
+    pgp->pg_up_streak = (uint8_t)0;
+    pgp->pg_down_streak = (uint8_t)0;
+  }
+
+  chVTDoSetI(&pgp->pg_vt, cfg->pg_interval, pwrgov_tmrcb, pgp);
+  chSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p pwrgov_t structure.
+ *
+ * @param[out] pgp      the @p pwrgov_t structure to be initialized
+ */
+void pwrgovObjectInit(pwrgov_t *pgp) {
+
+  pgp->pg_config = NULL;
+  chVTObjectInit(&pgp->pg_vt);
+  pgp->pg_load = (uint8_t)0;
+  pgp->pg_depth = (cnt_t)0;
+}
+
+/**
+ * @brief   Starts the governor.
+ * @details The first window opens when this function is invoked, the first
+ *          policy decision is taken one interval later.
+ * @pre     The governor must be in the stopped state.
+ * @note    The governor assumes that the system is initially running at
+ *          the scaled down performance level, the scale up callback is
+ *          invoked before the scale down one.
+ *
+ * @param[in] pgp       pointer to an initialized @p pwrgov_t structure
+ * @param[in] config    pointer to the governor configuration
+ */
+void pwrgovStart(pwrgov_t *pgp, const pwrgov_config_t *config) {
+
+  chDbgCheck((pgp != NULL) && (config != NULL) &&
+             (config->pg_down_threshold < config->pg_up_threshold));
+  chDbgAssert(pgp->pg_config == NULL, "already started");
+
+  chSysLock();
+  pgp->pg_config = config;
+  pgp->pg_last_cnt = chSysGetRealtimeCounterX();
+  pgp->pg_last_idle = pwrgov_get_idle(pgp->pg_last_cnt);
+  pgp->pg_up_streak = (uint8_t)0;
+  pgp->pg_down_streak = (uint8_t)0;
+  pgp->pg_high = false;
+  chVTDoSetI(&pgp->pg_vt, config->pg_interval, pwrgov_tmrcb, pgp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stops the governor.
+ * @details No callbacks are invoked after this function returns, the
+ *          current performance level is left unchanged.
+ *
+ * @param[in] pgp       pointer to an initialized @p pwrgov_t structure
+ */
+void pwrgovStop(pwrgov_t *pgp) {
+
+  chDbgCheck(pgp != NULL);
+
+  chSysLock();
+  chVTResetI(&pgp->pg_vt);
+  pgp->pg_config = NULL;
+  chSysUnlock();
+}
+
+/** @} */
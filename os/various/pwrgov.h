@@ -0,0 +1,198 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    pwrgov.h
+ * @brief   Power Governor structures and macros.
+ *
+ * @addtogroup power_governor
+ * @{
+ */
+
+#ifndef PWRGOV_H
+#define PWRGOV_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !CH_CFG_USE_THREAD_CYCLES && !CH_CFG_USE_IDLE_CYCLES
+#error "Power Governor requires CH_CFG_USE_THREAD_CYCLES or CH_CFG_USE_IDLE_CYCLES"
+#endif
+
+#if CH_CFG_NO_IDLE_THREAD && !CH_CFG_USE_IDLE_CYCLES
+#error "Power Governor without the idle thread requires CH_CFG_USE_IDLE_CYCLES"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a power scaling callback.
+ * @note    Callbacks are invoked from the governor timer callback, this
+ *          means ISR context, only I-class functions are allowed. Slow
+ *          clock tree manipulations should be deferred to a thread using
+ *          an event or a semaphore.
+ */
+typedef void (*pwrgov_scale_t)(void *arg);
+
+/**
+ * @brief   Type of a power governor configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Sampling window length in system ticks.
+   */
+  sysinterval_t         pg_interval;
+  /**
+   * @brief   Load percentage above which a scale up is requested.
+   */
+  uint8_t               pg_up_threshold;
+  /**
+   * @brief   Load percentage below which a scale down is requested.
+   * @note    It must be lower than @p pg_up_threshold, the gap between the
+   *          two thresholds is the first hysteresis band.
+   */
+  uint8_t               pg_down_threshold;
+  /**
+   * @brief   Consecutive busy windows required before scaling up.
+   */
+  uint8_t               pg_up_windows;
+  /**
+   * @brief   Consecutive quiet windows required before scaling down.
+   */
+  uint8_t               pg_down_windows;
+  /**
+   * @brief   Scale up callback.
+   */
+  pwrgov_scale_t        pg_up_cb;
+  /**
+   * @brief   Scale down callback.
+   */
+  pwrgov_scale_t        pg_down_cb;
+  /**
+   * @brief   Opaque parameter passed to the callbacks.
+   */
+  void                  *pg_arg;
+} pwrgov_config_t;
+
+/**
+ * @brief   Type of a power governor structure.
+ */
+typedef struct {
+  /**
+   * @brief   Associated configuration, @p NULL when stopped.
+   */
+  const pwrgov_config_t *pg_config;
+  /**
+   * @brief   Sampling virtual timer.
+   */
+  virtual_timer_t       pg_vt;
+  /**
+   * @brief   Realtime counter value at the previous sample.
+   */
+  rtcnt_t               pg_last_cnt;
+  /**
+   * @brief   Idle thread cycles at the previous sample.
+   */
+  rtcnt_t               pg_last_idle;
+  /**
+   * @brief   Consecutive windows above the scale up threshold.
+   */
+  uint8_t               pg_up_streak;
+  /**
+   * @brief   Consecutive windows below the scale down threshold.
+   */
+  uint8_t               pg_down_streak;
+  /**
+   * @brief   True while running at the scaled up performance level.
+   */
+  bool                  pg_high;
+  /**
+   * @brief   Load percentage measured over the last window.
+   */
+  uint8_t               pg_load;
+  /**
+   * @brief   Ready threads count at the last sample, idle excluded.
+   */
+  cnt_t                 pg_depth;
+} pwrgov_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void pwrgovObjectInit(pwrgov_t *pgp);
+  void pwrgovStart(pwrgov_t *pgp, const pwrgov_config_t *config);
+  void pwrgovStop(pwrgov_t *pgp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the load percentage measured over the last window.
+ *
+ * @param[in] pgp       pointer to an initialized @p pwrgov_t structure
+ * @return              The load percentage in the 0..100 range.
+ *
+ * @xclass
+ */
+static inline uint8_t pwrgovGetLoadX(pwrgov_t *pgp) {
+
+  return pgp->pg_load;
+}
+
+/**
+ * @brief   Returns the run-queue depth at the last sample.
+ * @details The returned value is the number of ready threads observed at
+ *          the end of the last window, the idle thread is not counted.
+ *
+ * @param[in] pgp       pointer to an initialized @p pwrgov_t structure
+ * @return              The number of ready threads.
+ *
+ * @xclass
+ */
+static inline cnt_t pwrgovGetQueueDepthX(pwrgov_t *pgp) {
+
+  return pgp->pg_depth;
+}
+
+#endif /* PWRGOV_H */
+
+/** @} */
@@ -458,6 +458,10 @@ bool shellGetLine(ShellConfig *scfg, char *line, unsigned size, ShellHistory *sh
   bool escape = false;
   bool bracket = false;
 #endif
+#if SHELL_USE_BUFFERED_INPUT == TRUE
+  uint8_t ibuf[SHELL_INPUT_BUFFER_SIZE];
+  size_t ifill = 0, inext = 0;
+#endif
 
 #if SHELL_USE_HISTORY != TRUE
   (void) shp;
@@ -466,8 +470,22 @@ bool shellGetLine(ShellConfig *scfg, char *line, unsigned size, ShellHistory *sh
   while (true) {
     char c;
 
+#if SHELL_USE_BUFFERED_INPUT == TRUE
+    if (inext >= ifill) {
+      /* Blocking on the first character then draining whatever else is
+         already buffered in the channel without waiting, so a burst
+         received over a slow link costs one wakeup, not one per byte.*/
+      if (streamRead(chp, &ibuf[0], 1) == 0)
+        return true;
+      ifill = 1U + chnReadTimeout((BaseChannel *)chp, &ibuf[1],
+                                  sizeof ibuf - 1U, TIME_IMMEDIATE);
+      inext = 0;
+    }
+    c = (char)ibuf[inext++];
+#else
     if (streamRead(chp, (uint8_t *)&c, 1) == 0)
       return true;
+#endif
 #if SHELL_USE_ESC_SEQ == TRUE
     if (c == 27) {
       escape = true;
@@ -581,8 +599,23 @@ bool shellGetLine(ShellConfig *scfg, char *line, unsigned size, ShellHistory *sh
     if (c < 0x20)
       continue;
     if (p < line + size - 1) {
+#if SHELL_USE_BUFFERED_INPUT == TRUE
+      char *echop = p;
+
+      *p++ = (char)c;
+      /* Consuming the printable run already received, control characters
+         are left in the buffer for the normal handling above, the echo
+         goes back with a single write.*/
+      while ((inext < ifill) &&
+             (ibuf[inext] >= 0x20U) && (ibuf[inext] < 0x7FU) &&
+             (p < line + size - 1)) {
+        *p++ = (char)ibuf[inext++];
+      }
+      streamWrite(chp, (const uint8_t *)echop, (size_t)(p - echop));
+#else
       streamPut(chp, c);
       *p++ = (char)c;
+#endif
     }
   }
 }
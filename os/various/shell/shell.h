@@ -92,6 +92,28 @@
 #define SHELL_USE_ESC_SEQ           FALSE
 #endif
 
+/**
+ * @brief   Enable batched input processing
+ * @details When enabled the shell drains all the characters already
+ *          buffered in the input channel with a single read and processes
+ *          them as a batch, echoing printable runs with one write instead
+ *          of one stream round trip per character. This reduces thread
+ *          wakeups and echo latency dramatically on slow or remote links.
+ * @note    Requires the shell stream to be a @p BaseChannel (all the
+ *          serial-like drivers are), plain @p BaseSequentialStream
+ *          objects cannot be polled without blocking.
+ */
+#if !defined(SHELL_USE_BUFFERED_INPUT) || defined(__DOXYGEN__)
+#define SHELL_USE_BUFFERED_INPUT    FALSE
+#endif
+
+/**
+ * @brief   Batched input chunk size
+ */
+#if !defined(SHELL_INPUT_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define SHELL_INPUT_BUFFER_SIZE     64
+#endif
+
 /**
  * @brief   Prompt string
  */
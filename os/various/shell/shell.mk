@@ -1,6 +1,7 @@
 # RT Shell files.
 SHELLSRC = $(CHIBIOS)/os/various/shell/shell.c \
-           $(CHIBIOS)/os/various/shell/shell_cmd.c
+           $(CHIBIOS)/os/various/shell/shell_cmd.c \
+           $(CHIBIOS)/os/various/shell/shell_bin.c
 
 SHELLINC = $(CHIBIOS)/os/various/shell
 
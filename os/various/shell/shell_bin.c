@@ -0,0 +1,301 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    shell_bin.c
+ * @brief   Binary protocol shell code.
+ *
+ * @addtogroup SHELL
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "shell.h"
+#include "shell_bin.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*
+ * Little-endian field encoders, the explicit byte stores make the wire
+ * format independent of the target endianness and alignment.
+ */
+static uint8_t *put8(uint8_t *p, uint8_t v) {
+
+  *p++ = v;
+  return p;
+}
+
+static uint8_t *put16(uint8_t *p, uint16_t v) {
+
+  *p++ = (uint8_t)v;
+  *p++ = (uint8_t)(v >> 8);
+  return p;
+}
+
+static uint8_t *put32(uint8_t *p, uint32_t v) {
+
+  p = put16(p, (uint16_t)v);
+  p = put16(p, (uint16_t)(v >> 16));
+  return p;
+}
+
+static uint8_t *put64(uint8_t *p, uint64_t v) {
+
+  p = put32(p, (uint32_t)v);
+  p = put32(p, (uint32_t)(v >> 32));
+  return p;
+}
+
+/*
+ * Appends a NUL-terminated string, always consuming the terminator.
+ */
+static uint8_t *putstr(uint8_t *p, const char *s) {
+
+  while (*s != '\0')
+    *p++ = (uint8_t)*s++;
+  *p++ = 0U;
+  return p;
+}
+
+/*
+ * Built-in: system identification, three NUL-terminated strings (kernel
+ * version, port description, platform name) followed by the system tick
+ * frequency as a 32 bits value.
+ */
+static size_t bin_info(uint8_t *resp) {
+  uint8_t *p = resp;
+
+  p = putstr(p, CH_KERNEL_VERSION);
+#ifdef PORT_INFO
+  p = putstr(p, PORT_INFO);
+#else
+  p = putstr(p, "");
+#endif
+#ifdef PLATFORM_NAME
+  p = putstr(p, PLATFORM_NAME);
+#else
+  p = putstr(p, "");
+#endif
+  p = put32(p, (uint32_t)CH_CFG_ST_FREQUENCY);
+
+  return (size_t)(p - resp);
+}
+
+#if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/*
+ * Built-in: registry snapshot, a 16 bits total thread count, a 16 bits
+ * reported record count, then one fixed-size record per reported thread:
+ * NUL-padded name, 32 bits priority, 8 bits state, 64 bits consumed
+ * cycles (zero when thread cycles accounting is disabled).
+ */
+static size_t bin_threads(uint8_t *resp, uint8_t *status) {
+  static thread_snapshot_t snap[SHELL_BIN_MAX_THREADS];
+  uint8_t *p = resp;
+  size_t total, n, i;
+
+  total = chRegSnapshotThreads(snap, SHELL_BIN_MAX_THREADS);
+  n = total;
+  if (n > (size_t)SHELL_BIN_MAX_THREADS) {
+    n = (size_t)SHELL_BIN_MAX_THREADS;
+    *status = SHELL_BIN_STS_TRUNCATED;
+  }
+
+  p = put16(p, (uint16_t)total);
+  p = put16(p, (uint16_t)n);
+  for (i = 0; i < n; i++) {
+    const char *name = snap[i].name == NULL ? "" : snap[i].name;
+    size_t j;
+
+    for (j = 0; j < SHELL_BIN_NAME_SIZE; j++) {
+      *p++ = (uint8_t)name[j];
+      if (name[j] == '\0') {
+        while (++j < SHELL_BIN_NAME_SIZE)
+          *p++ = 0U;
+        break;
+      }
+    }
+    p = put32(p, (uint32_t)snap[i].prio);
+    p = put8(p, (uint8_t)snap[i].state);
+#if CH_CFG_USE_THREAD_CYCLES == TRUE
+    p = put64(p, (uint64_t)snap[i].cycles);
+#else
+    p = put64(p, 0U);
+#endif
+  }
+
+  return (size_t)(p - resp);
+}
+#endif /* CH_CFG_USE_REGISTRY == TRUE */
+
+/*
+ * Reads exactly n bytes, false on stream end or reset.
+ */
+static bool read_exact(BaseSequentialStream *chp, uint8_t *bp, size_t n) {
+
+  while (n > 0U) {
+    size_t r = streamRead(chp, bp, n);
+    if (r == 0U)
+      return false;
+    bp += r;
+    n -= r;
+  }
+  return true;
+}
+
+/*
+ * Sends a complete response frame with a single write.
+ */
+static void send_response(BaseSequentialStream *chp, uint8_t *frame,
+                          uint8_t id, uint8_t status, size_t n) {
+  uint8_t cks = 0;
+  size_t i;
+
+  frame[0] = SHELL_BIN_SOF;
+  frame[1] = id;
+  frame[2] = status;
+  frame[3] = (uint8_t)n;
+  frame[4] = (uint8_t)(n >> 8);
+  for (i = 1; i < n + 5U; i++)
+    cks += frame[i];
+  frame[n + 5U] = (uint8_t)(0U - cks);
+
+  streamWrite(chp, frame, n + 6U);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Binary shell thread function.
+ * @details Serves length-prefixed request frames on the configured
+ *          stream until the stream is reset, see @p shell_bin.h for the
+ *          frame layout. Built-in commands cover ping, system
+ *          identification and registry snapshots, application commands
+ *          are resolved through the table in the configuration using
+ *          identifiers from @p SHELL_BIN_CMD_USER_BASE upwards.
+ * @note    The frame buffers are static in order to keep the working
+ *          area requirement small, a single binary shell instance is
+ *          supported.
+ *
+ * @param[in] p         pointer to a @p ShellBinConfig object
+ */
+THD_FUNCTION(shellBinThread, p) {
+  ShellBinConfig *scfg = p;
+  BaseSequentialStream *chp = scfg->sbc_channel;
+  static uint8_t req[SHELL_BIN_MAX_PAYLOAD];
+  static uint8_t frame[SHELL_BIN_MAX_PAYLOAD + 6U];
+
+  while (true) {
+    uint8_t hdr[4], cks, status;
+    uint8_t *resp = frame + 5;
+    size_t len, n, i;
+
+    /* Hunting for the start byte then reading the fixed header part,
+       identifier plus payload length.*/
+    do {
+      if (!read_exact(chp, &hdr[0], 1))
+        shellExit(MSG_OK);
+    } while (hdr[0] != SHELL_BIN_SOF);
+    if (!read_exact(chp, &hdr[1], 3))
+      shellExit(MSG_OK);
+    len = (size_t)hdr[2] | ((size_t)hdr[3] << 8);
+
+    /* Oversized requests cannot be buffered, the payload is consumed
+       in order to stay synchronized then rejected.*/
+    if (len > sizeof req) {
+      uint8_t scratch;
+
+      for (i = 0; i < len + 1U; i++) {
+        if (!read_exact(chp, &scratch, 1))
+          shellExit(MSG_OK);
+      }
+      send_response(chp, frame, hdr[1], SHELL_BIN_STS_BAD_FRAME, 0);
+      continue;
+    }
+
+    if (!read_exact(chp, req, len) || !read_exact(chp, &cks, 1))
+      shellExit(MSG_OK);
+
+    /* The checksum covers everything after the start byte.*/
+    cks += hdr[1] + hdr[2] + hdr[3];
+    for (i = 0; i < len; i++)
+      cks += req[i];
+    if (cks != 0U) {
+      send_response(chp, frame, hdr[1], SHELL_BIN_STS_BAD_FRAME, 0);
+      continue;
+    }
+
+    /* Command dispatching, built-ins first then the application
+       table.*/
+    status = SHELL_BIN_STS_OK;
+    switch (hdr[1]) {
+    case SHELL_BIN_CMD_PING:
+      n = len;
+      memcpy(resp, req, len);
+      break;
+    case SHELL_BIN_CMD_INFO:
+      n = bin_info(resp);
+      break;
+#if CH_CFG_USE_REGISTRY == TRUE
+    case SHELL_BIN_CMD_THREADS:
+      n = bin_threads(resp, &status);
+      break;
+#endif
+    default:
+      n = 0;
+      status = SHELL_BIN_STS_UNKNOWN;
+      if (scfg->sbc_commands != NULL) {
+        const ShellBinCommand *sbcp = scfg->sbc_commands;
+
+        while (sbcp->sbc_function != NULL) {
+          if (sbcp->sbc_id == hdr[1]) {
+            n = sbcp->sbc_function(req, len, resp, SHELL_BIN_MAX_PAYLOAD);
+            status = SHELL_BIN_STS_OK;
+            break;
+          }
+          sbcp++;
+        }
+      }
+      break;
+    }
+
+    send_response(chp, frame, hdr[1], status, n);
+  }
+}
+
+/** @} */
@@ -0,0 +1,156 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    shell_bin.h
+ * @brief   Binary protocol shell header.
+ * @details Machine-oriented counterpart of the text shell meant for
+ *          telemetry collection, requests and responses are
+ *          length-prefixed frames on the same stream type used by the
+ *          text shell and commands are addressed by numeric identifier,
+ *          so no formatted output has to be generated on the target nor
+ *          parsed on the host.
+ *
+ *          Frame layout, all multi-byte fields little-endian:
+ *          - Request:  SOF(0xF5) ID LEN16 PAYLOAD[LEN] CKS
+ *          - Response: SOF(0xF5) ID STATUS LEN16 PAYLOAD[LEN] CKS
+ *          .
+ *          CKS is the two's complement of the 8-bit sum of all the bytes
+ *          following the SOF, so summing them with CKS yields zero.
+ *
+ * @addtogroup SHELL
+ * @{
+ */
+
+#ifndef SHELL_BIN_H
+#define SHELL_BIN_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Frame start byte.
+ */
+#define SHELL_BIN_SOF               0xF5U
+
+/**
+ * @name    Response status codes
+ * @{
+ */
+#define SHELL_BIN_STS_OK            0x00U
+#define SHELL_BIN_STS_UNKNOWN       0x01U
+#define SHELL_BIN_STS_TRUNCATED     0x02U
+#define SHELL_BIN_STS_BAD_FRAME     0x03U
+/** @} */
+
+/**
+ * @name    Built-in command identifiers
+ * @details Identifiers below 0x40 are reserved for built-in commands,
+ *          application tables must use identifiers from 0x40 upwards.
+ * @{
+ */
+#define SHELL_BIN_CMD_PING          0x01U
+#define SHELL_BIN_CMD_INFO          0x02U
+#define SHELL_BIN_CMD_THREADS       0x03U
+#define SHELL_BIN_CMD_USER_BASE     0x40U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum payload size of a request or response frame.
+ */
+#if !defined(SHELL_BIN_MAX_PAYLOAD) || defined(__DOXYGEN__)
+#define SHELL_BIN_MAX_PAYLOAD       512
+#endif
+
+/**
+ * @brief   Maximum threads reported by the threads snapshot command.
+ */
+#if !defined(SHELL_BIN_MAX_THREADS) || defined(__DOXYGEN__)
+#define SHELL_BIN_MAX_THREADS       16
+#endif
+
+/**
+ * @brief   Thread name field width in the threads snapshot records.
+ */
+#define SHELL_BIN_NAME_SIZE         16
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/* Each thread record is the name field plus priority (4), state (1) and
+   cycles (8), the snapshot response must fit in a single frame.*/
+#if SHELL_BIN_MAX_PAYLOAD < (4 + (SHELL_BIN_MAX_THREADS *                   \
+                                  (SHELL_BIN_NAME_SIZE + 13)))
+#error "SHELL_BIN_MAX_PAYLOAD too small for SHELL_BIN_MAX_THREADS"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Binary command handler function type.
+ * @details The handler receives the request payload and writes the
+ *          response payload into the provided buffer.
+ *
+ * @param[in] req       request payload
+ * @param[in] reqn      request payload size
+ * @param[out] resp     response payload buffer
+ * @param[in] respmax   response payload buffer size
+ * @return              The response payload size.
+ */
+typedef size_t (*shellbincmd_t)(const uint8_t *req, size_t reqn,
+                                uint8_t *resp, size_t respmax);
+
+/**
+ * @brief   Binary command entry type.
+ */
+typedef struct {
+  uint8_t               sbc_id;             /**< @brief Command identifier. */
+  shellbincmd_t         sbc_function;       /**< @brief Command function.   */
+} ShellBinCommand;
+
+/**
+ * @brief   Binary shell descriptor type.
+ */
+typedef struct {
+  BaseSequentialStream  *sbc_channel;       /**< @brief I/O channel
+                                                 associated to the shell.   */
+  const ShellBinCommand *sbc_commands;      /**< @brief Application commands
+                                                 table or @p NULL.          */
+} ShellBinConfig;
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  THD_FUNCTION(shellBinThread, p);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHELL_BIN_H */
+
+/** @} */
@@ -35,6 +35,13 @@
 #include "oslib_test_root.h"
 #endif
 
+#if ((SHELL_CMD_PROF_ENABLED == TRUE) && (HAL_USE_GPT == TRUE)) ||          \
+    defined(__DOXYGEN__)
+#include <stdlib.h>
+
+#include "profiler.h"
+#endif
+
 /*===========================================================================*/
 /* Module local definitions.                                                 */
 /*===========================================================================*/
@@ -154,7 +161,7 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
     shellUsage(chp, "threads");
     return;
   }
-  chprintf(chp, "stklimit    stack     addr refs prio     state         name\r\n" SHELL_NEWLINE_STR);
+  chprintf(chp, "stklimit    stack stkunused     addr refs prio     state         name\r\n" SHELL_NEWLINE_STR);
   tp = chRegFirstThread();
   do {
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
@@ -162,8 +169,14 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
 #else
     uint32_t stklimit = 0U;
 #endif
-    chprintf(chp, "%08lx %08lx %08lx %4lu %4lu %9s %12s" SHELL_NEWLINE_STR,
-             stklimit, (uint32_t)tp->ctx.sp, (uint32_t)tp,
+#if (CH_DBG_FILL_THREADS == TRUE) &&                                        \
+    ((CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE))
+    uint32_t stkunused = (uint32_t)chThdGetFreeStackX(tp);
+#else
+    uint32_t stkunused = 0U;
+#endif
+    chprintf(chp, "%08lx %08lx %9lu %08lx %4lu %4lu %9s %12s" SHELL_NEWLINE_STR,
+             stklimit, (uint32_t)tp->ctx.sp, stkunused, (uint32_t)tp,
              (uint32_t)tp->refs - 1, (uint32_t)tp->prio, states[tp->state],
              tp->name == NULL ? "" : tp->name);
     tp = chRegNextThread(tp);
@@ -171,6 +184,236 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
 }
 #endif
 
+#if ((SHELL_CMD_QUEUES_ENABLED == TRUE) &&                                  \
+     ((CH_CFG_USE_MAILBOX_STATS == TRUE) || (HAL_QUEUES_STATS == TRUE))) || \
+    defined(__DOXYGEN__)
+static void cmd_queues(BaseSequentialStream *chp, int argc, char *argv[]) {
+
+  (void)argv;
+  if (argc > 0) {
+    shellUsage(chp, "queues");
+    return;
+  }
+#if CH_CFG_USE_MAILBOX_STATS == TRUE
+  {
+    mailbox_t *mbp;
+
+    chprintf(chp, "mailbox      size  peak" SHELL_NEWLINE_STR);
+    mbp = chMBGetNextX(NULL);
+    while (mbp != NULL) {
+      chprintf(chp, "%08lx %8lu %5lu" SHELL_NEWLINE_STR,
+               (uint32_t)mbp, (uint32_t)chMBGetSizeI(mbp),
+               (uint32_t)chMBGetHighWatermarkX(mbp));
+      mbp = chMBGetNextX(mbp);
+    }
+  }
+#endif
+#if HAL_QUEUES_STATS == TRUE
+  {
+    io_queue_t *qp;
+
+    chprintf(chp, "queue        size  peak" SHELL_NEWLINE_STR);
+    qp = qGetNextX(NULL);
+    while (qp != NULL) {
+      chprintf(chp, "%08lx %8lu %5lu" SHELL_NEWLINE_STR,
+               (uint32_t)qp, (uint32_t)qSizeX(qp),
+               (uint32_t)qGetHighWatermarkX(qp));
+      qp = qGetNextX(qp);
+    }
+  }
+#endif
+}
+#endif
+
+#if ((SHELL_CMD_MAC_ENABLED == TRUE) && (HAL_USE_MAC == TRUE) &&            \
+     (MAC_USE_STATS == TRUE)) || defined(__DOXYGEN__)
+static void cmd_mac(BaseSequentialStream *chp, int argc, char *argv[]) {
+  mac_stats_t stats;
+
+  if (argc > 1) {
+    shellUsage(chp, "mac [reset]");
+    return;
+  }
+  if (argc == 1) {
+    if (strcmp(argv[0], "reset") != 0) {
+      shellUsage(chp, "mac [reset]");
+      return;
+    }
+    macResetStats();
+    return;
+  }
+  macGetStats(&stats);
+  chprintf(chp, "rx frames        : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.rx_frames);
+  chprintf(chp, "rx wakeups       : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.rx_wakeups);
+  chprintf(chp, "rx batch max     : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.rx_batch_max);
+  chprintf(chp, "rx overruns      : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.rx_overruns);
+  chprintf(chp, "rx pool exhausted: %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.rx_pool_exhausted);
+  chprintf(chp, "tx frames        : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.tx_frames);
+  chprintf(chp, "tx desc unavail  : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.tx_desc_unavail);
+  chprintf(chp, "tx ring full     : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.tx_ring_full);
+}
+#endif
+
+#if ((SHELL_CMD_SDC_ENABLED == TRUE) && (HAL_USE_SDC == TRUE) &&            \
+     (SDC_USE_STATS == TRUE)) || defined(__DOXYGEN__)
+static void sdc_print_measurement(BaseSequentialStream *chp, const char *name,
+                                  const sdc_time_measurement_t *tmp) {
+
+  chprintf(chp, "%s: n %lu last %lu best %lu worst %lu total %lu" SHELL_NEWLINE_STR,
+           name, (unsigned long)tmp->n, (unsigned long)tmp->last,
+           (unsigned long)tmp->best, (unsigned long)tmp->worst,
+           (unsigned long)tmp->cumulative);
+}
+
+static void cmd_sdc(BaseSequentialStream *chp, int argc, char *argv[]) {
+  sdc_stats_t stats;
+
+  if (argc > 1) {
+    shellUsage(chp, "sdc [reset]");
+    return;
+  }
+  if (argc == 1) {
+    if (strcmp(argv[0], "reset") != 0) {
+      shellUsage(chp, "sdc [reset]");
+      return;
+    }
+    sdcResetStats();
+    return;
+  }
+  sdcGetStats(&stats);
+  chprintf(chp, "times in system ticks" SHELL_NEWLINE_STR);
+  sdc_print_measurement(chp, "read ", &stats.read);
+  sdc_print_measurement(chp, "write", &stats.write);
+  sdc_print_measurement(chp, "busy ", &stats.busy);
+  chprintf(chp, "busy polls  : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.busy_polls);
+  chprintf(chp, "read errors : %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.read_errors);
+  chprintf(chp, "write errors: %lu" SHELL_NEWLINE_STR,
+           (unsigned long)stats.write_errors);
+}
+#endif
+
+#if ((SHELL_CMD_PROF_ENABLED == TRUE) && (HAL_USE_GPT == TRUE)) ||          \
+    defined(__DOXYGEN__)
+static struct {
+  uint32_t pc;
+  uint32_t hits;
+} prof_buckets[SHELL_CMD_PROF_BUCKETS];
+
+static struct {
+  thread_t *tp;
+  uint32_t hits;
+} prof_threads[8];
+
+static uint32_t prof_lost;
+
+static void prof_clear(void) {
+
+  memset(prof_buckets, 0, sizeof prof_buckets);
+  memset(prof_threads, 0, sizeof prof_threads);
+  prof_lost = 0;
+}
+
+/* Drains the profiler ring merging the samples into the PC buckets and
+   the per-thread counters, open addressing keyed on the PC value.*/
+static void prof_aggregate(void) {
+  profiler_sample_t samples[16];
+  size_t n;
+
+  while ((n = profilerFetch(samples, 16)) > 0U) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+      unsigned j, probes;
+
+      j = (unsigned)(samples[i].pc >> 2) % SHELL_CMD_PROF_BUCKETS;
+      for (probes = 0; probes < SHELL_CMD_PROF_BUCKETS; probes++) {
+        if (prof_buckets[j].hits == 0U) {
+          prof_buckets[j].pc = samples[i].pc;
+        }
+        if (prof_buckets[j].pc == samples[i].pc) {
+          prof_buckets[j].hits++;
+          break;
+        }
+        j = (j + 1U) % SHELL_CMD_PROF_BUCKETS;
+      }
+      if (probes == SHELL_CMD_PROF_BUCKETS) {
+        prof_lost++;
+      }
+
+      j = (unsigned)((uint32_t)samples[i].tp >> 3) % 8U;
+      for (probes = 0; probes < 8U; probes++) {
+        if (prof_threads[j].hits == 0U) {
+          prof_threads[j].tp = samples[i].tp;
+        }
+        if (prof_threads[j].tp == samples[i].tp) {
+          prof_threads[j].hits++;
+          break;
+        }
+        j = (j + 1U) % 8U;
+      }
+    }
+  }
+}
+
+static void cmd_prof(BaseSequentialStream *chp, int argc, char *argv[]) {
+  uint32_t samples, dropped;
+  unsigned i;
+
+  if (argc == 2) {
+    if (strcmp(argv[0], "start") == 0) {
+      uint32_t rate = (uint32_t)atol(argv[1]);
+
+      prof_clear();
+      if (!profilerStart(rate)) {
+        chprintf(chp, "failed, no GPT bound or rate not achievable" SHELL_NEWLINE_STR);
+      }
+      return;
+    }
+  }
+  else if (argc == 1) {
+    if (strcmp(argv[0], "stop") == 0) {
+      profilerStop();
+      return;
+    }
+    if (strcmp(argv[0], "report") == 0) {
+      prof_aggregate();
+      profilerGetCounters(&samples, &dropped);
+      chprintf(chp, "samples: %lu dropped: %lu unbucketed: %lu" SHELL_NEWLINE_STR,
+               (unsigned long)samples, (unsigned long)dropped,
+               (unsigned long)prof_lost);
+      for (i = 0; i < 8U; i++) {
+        if (prof_threads[i].hits > 0U) {
+          const char *name = prof_threads[i].tp->name;
+          chprintf(chp, "thread %08lx %-12s %lu" SHELL_NEWLINE_STR,
+                   (unsigned long)prof_threads[i].tp,
+                   name == NULL ? "" : name,
+                   (unsigned long)prof_threads[i].hits);
+        }
+      }
+      for (i = 0; i < SHELL_CMD_PROF_BUCKETS; i++) {
+        if (prof_buckets[i].hits > 0U) {
+          chprintf(chp, "pc %08lx %lu" SHELL_NEWLINE_STR,
+                   (unsigned long)prof_buckets[i].pc,
+                   (unsigned long)prof_buckets[i].hits);
+        }
+      }
+      return;
+    }
+  }
+  shellUsage(chp, "prof start <rate_hz>|stop|report");
+}
+#endif
+
 #if (SHELL_CMD_TEST_ENABLED == TRUE) || defined(__DOXYGEN__)
 static THD_FUNCTION(test_rt, arg) {
   BaseSequentialStream *chp = (BaseSequentialStream *)arg;
@@ -238,6 +481,21 @@ const ShellCommand shell_local_commands[] = {
 #if SHELL_CMD_THREADS_ENABLED == TRUE
   {"threads", cmd_threads},
 #endif
+#if (SHELL_CMD_QUEUES_ENABLED == TRUE) &&                                   \
+    ((CH_CFG_USE_MAILBOX_STATS == TRUE) || (HAL_QUEUES_STATS == TRUE))
+  {"queues", cmd_queues},
+#endif
+#if (SHELL_CMD_MAC_ENABLED == TRUE) && (HAL_USE_MAC == TRUE) &&             \
+    (MAC_USE_STATS == TRUE)
+  {"mac", cmd_mac},
+#endif
+#if (SHELL_CMD_SDC_ENABLED == TRUE) && (HAL_USE_SDC == TRUE) &&             \
+    (SDC_USE_STATS == TRUE)
+  {"sdc", cmd_sdc},
+#endif
+#if (SHELL_CMD_PROF_ENABLED == TRUE) && (HAL_USE_GPT == TRUE)
+  {"prof", cmd_prof},
+#endif
 #if SHELL_CMD_TEST_ENABLED == TRUE
   {"test", cmd_test},
 #endif
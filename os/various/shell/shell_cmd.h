@@ -57,6 +57,26 @@
 #define SHELL_CMD_THREADS_ENABLED           TRUE
 #endif
 
+#if !defined(SHELL_CMD_QUEUES_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_QUEUES_ENABLED            TRUE
+#endif
+
+#if !defined(SHELL_CMD_MAC_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_MAC_ENABLED               TRUE
+#endif
+
+#if !defined(SHELL_CMD_SDC_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_SDC_ENABLED               TRUE
+#endif
+
+#if !defined(SHELL_CMD_PROF_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_PROF_ENABLED              FALSE
+#endif
+
+#if !defined(SHELL_CMD_PROF_BUCKETS) || defined(__DOXYGEN__)
+#define SHELL_CMD_PROF_BUCKETS              32
+#endif
+
 #if !defined(SHELL_CMD_TEST_ENABLED) || defined(__DOXYGEN__)
 #define SHELL_CMD_TEST_ENABLED              TRUE
 #endif
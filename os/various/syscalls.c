@@ -61,10 +61,15 @@
 #include <sys/types.h>
 
 #include "ch.h"
+#include "syscalls.h"
 #if defined(STDOUT_SD) || defined(STDIN_SD)
 #include "hal.h"
 #endif
 
+#if (SYSCALLS_USE_THREAD_HEAPS == TRUE) && (CH_CFG_USE_HEAP == FALSE)
+#error "SYSCALLS_USE_THREAD_HEAPS requires CH_CFG_USE_HEAP"
+#endif
+
 /***************************************************************************/
 
 __attribute__((used))
@@ -154,6 +159,85 @@ caddr_t _sbrk_r(struct _reent *r, int incr)
 
 /***************************************************************************/
 
+#if (SYSCALLS_USE_THREAD_HEAPS == TRUE) || defined(__DOXYGEN__)
+/*
+ * Newlib allocator entry points implemented on memory heaps, the hidden
+ * newlib malloc lock is never taken. Each thread allocates from its
+ * registered arena or from the default heap, the owning heap is stored
+ * in the block header so blocks can be freed from any thread.
+ * The syscalls_heap thread field is provided by the chconf.h glue
+ * macros, see syscalls.h.
+ */
+
+void syscallsSetThreadHeap(struct memory_heap *heapp)
+{
+  chThdGetSelfX()->syscalls_heap = (void *)heapp;
+}
+
+__attribute__((used))
+void *_malloc_r(struct _reent *r, size_t size)
+{
+  void *p;
+
+  p = chHeapAlloc((memory_heap_t *)chThdGetSelfX()->syscalls_heap, size);
+  if (p == NULL)
+    __errno_r(r) = ENOMEM;
+  return p;
+}
+
+__attribute__((used))
+void _free_r(struct _reent *r, void *p)
+{
+  (void)r;
+
+  if (p != NULL)
+    chHeapFree(p);
+}
+
+__attribute__((used))
+void *_realloc_r(struct _reent *r, void *p, size_t size)
+{
+  void *newp;
+  size_t oldsize;
+
+  if (p == NULL)
+    return _malloc_r(r, size);
+  if (size == 0) {
+    chHeapFree(p);
+    return NULL;
+  }
+
+  oldsize = chHeapGetSize(p);
+  if (size <= oldsize)
+    return p;
+
+  newp = _malloc_r(r, size);
+  if (newp != NULL) {
+    memcpy(newp, p, oldsize);
+    chHeapFree(p);
+  }
+  return newp;
+}
+
+__attribute__((used))
+void *_calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+  void *p;
+
+  if ((size != 0) && (nmemb > ((size_t)-1) / size)) {
+    __errno_r(r) = ENOMEM;
+    return NULL;
+  }
+
+  p = _malloc_r(r, nmemb * size);
+  if (p != NULL)
+    memset(p, 0, nmemb * size);
+  return p;
+}
+#endif /* SYSCALLS_USE_THREAD_HEAPS == TRUE */
+
+/***************************************************************************/
+
 __attribute__((used))
 int _fstat_r(struct _reent *r, int file, struct stat * st)
 {
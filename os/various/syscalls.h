@@ -0,0 +1,114 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    syscalls.h
+ * @brief   Newlib binding options and kernel hook glue.
+ * @details Optional extensions of @p syscalls.c. The thread fields and
+ *          hook bodies below must be wired into @p chconf.h when the
+ *          corresponding option is enabled, for example:
+ *          @code
+ *          #if !defined(_FROM_ASM_)
+ *          #include "syscalls.h"
+ *          #endif
+ *
+ *          #define CH_CFG_THREAD_EXTRA_FIELDS                              \
+ *            SYSCALLS_REENT_EXTRA_FIELDS                                   \
+ *            SYSCALLS_HEAP_EXTRA_FIELDS
+ *
+ *          #define CH_CFG_THREAD_INIT_HOOK(tp) {                           \
+ *            SYSCALLS_REENT_INIT_HOOK(tp);                                 \
+ *            SYSCALLS_HEAP_INIT_HOOK(tp);                                  \
+ *          }
+ *
+ *          #define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                  \
+ *            SYSCALLS_REENT_SWITCH_HOOK(ntp, otp);                         \
+ *          }
+ *          @endcode
+ */
+
+#ifndef SYSCALLS_H
+#define SYSCALLS_H
+
+#include <reent.h>
+
+/**
+ * @brief   Per-thread newlib reentrancy support.
+ * @details When enabled each thread carries its own @p struct @p _reent
+ *          and the context switch hook retargets @p _impure_ptr, so the
+ *          printf-family state, @p errno and the other hidden newlib
+ *          structures are no longer shared between threads. The glue
+ *          macros @p SYSCALLS_REENT_EXTRA_FIELDS,
+ *          @p SYSCALLS_REENT_INIT_HOOK() and
+ *          @p SYSCALLS_REENT_SWITCH_HOOK() must be wired into the
+ *          matching @p chconf.h hooks.
+ */
+#if !defined(SYSCALLS_USE_REENT) || defined(__DOXYGEN__)
+#define SYSCALLS_USE_REENT          FALSE
+#endif
+
+/**
+ * @brief   Per-thread malloc arenas support.
+ * @details When enabled the newlib allocator entry points
+ *          (@p _malloc_r() and related) are implemented on memory heaps
+ *          instead of @p _sbrk_r(), bypassing the newlib malloc lock
+ *          entirely. Each thread allocates from the arena registered
+ *          with @p syscallsSetThreadHeap() or from the default heap when
+ *          none is registered, freeing works from any thread because the
+ *          owning heap is recorded in the block header. The glue macros
+ *          @p SYSCALLS_HEAP_EXTRA_FIELDS and
+ *          @p SYSCALLS_HEAP_INIT_HOOK() must be wired into the matching
+ *          @p chconf.h hooks.
+ */
+#if !defined(SYSCALLS_USE_THREAD_HEAPS) || defined(__DOXYGEN__)
+#define SYSCALLS_USE_THREAD_HEAPS   FALSE
+#endif
+
+/**
+ * @name    Kernel hook glue macros
+ * @details To be expanded inside the @p chconf.h hook definitions, only
+ *          the macros of the enabled options need to be wired in.
+ * @{
+ */
+#define SYSCALLS_REENT_EXTRA_FIELDS                                         \
+  struct _reent               syscalls_reent;
+
+#define SYSCALLS_REENT_INIT_HOOK(tp)                                        \
+  _REENT_INIT_PTR(&(tp)->syscalls_reent)
+
+#define SYSCALLS_REENT_SWITCH_HOOK(ntp, otp)                                \
+  _impure_ptr = &(ntp)->syscalls_reent
+
+#define SYSCALLS_HEAP_EXTRA_FIELDS                                          \
+  void                        *syscalls_heap;
+
+#define SYSCALLS_HEAP_INIT_HOOK(tp)                                         \
+  (tp)->syscalls_heap = NULL
+/** @} */
+
+#if !defined(_FROM_ASM_)
+struct memory_heap;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void syscallsSetThreadHeap(struct memory_heap *heapp);
+#ifdef __cplusplus
+}
+#endif
+#endif /* !defined(_FROM_ASM_) */
+
+#endif /* SYSCALLS_H */
@@ -0,0 +1,160 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    wdgsup.c
+ * @brief   Watchdog supervisor code.
+ *
+ * @addtogroup wdg_supervisor
+ * @{
+ */
+
+#include "hal.h"
+#include "wdgsup.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p wdg_supervisor_t structure.
+ * @details All slots are initially disabled, the hardware watchdog is fed
+ *          unconditionally until the first slot is enabled.
+ *
+ * @param[out] wsp      pointer to the @p wdg_supervisor_t structure to be
+ *                      initialized
+ * @param[in] wdgp      pointer to the watchdog driver to be fed, it must
+ *                      be already started
+ *
+ * @init
+ */
+void wdgSupObjectInit(wdg_supervisor_t *wsp, WDGDriver *wdgp) {
+  unsigned slot;
+
+  osalDbgCheck((wsp != NULL) && (wdgp != NULL));
+
+  wsp->ws_wdgp = wdgp;
+  for (slot = 0U; slot < (unsigned)WDG_SUP_MAX_SLOTS; slot++) {
+    wsp->ws_slots[slot].interval = (sysinterval_t)0;
+  }
+}
+
+/**
+ * @brief   Enables a supervision slot.
+ * @details The slot counts as live immediately, its owner must check in
+ *          within the specified interval from now.
+ * @note    The interval must be shorter than the hardware watchdog
+ *          timeout by at least the period of the feeding loop, else the
+ *          watchdog can bite before the stale slot is noticed.
+ *
+ * @param[in] wsp       pointer to an initialized @p wdg_supervisor_t
+ *                      structure
+ * @param[in] slot      index of the slot
+ * @param[in] interval  maximum interval between check-ins
+ *
+ * @api
+ */
+void wdgSupEnableSlot(wdg_supervisor_t *wsp, unsigned slot,
+                      sysinterval_t interval) {
+
+  osalDbgCheck((wsp != NULL) && (slot < (unsigned)WDG_SUP_MAX_SLOTS) &&
+               (interval != (sysinterval_t)0));
+
+  osalSysLock();
+  wsp->ws_slots[slot].last = osalOsGetSystemTimeX();
+  wsp->ws_slots[slot].interval = interval;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Disables a supervision slot.
+ * @details The slot is no more considered when deciding whether to feed
+ *          the hardware watchdog.
+ *
+ * @param[in] wsp       pointer to an initialized @p wdg_supervisor_t
+ *                      structure
+ * @param[in] slot      index of the slot
+ *
+ * @api
+ */
+void wdgSupDisableSlot(wdg_supervisor_t *wsp, unsigned slot) {
+
+  osalDbgCheck((wsp != NULL) && (slot < (unsigned)WDG_SUP_MAX_SLOTS));
+
+  osalSysLock();
+  wsp->ws_slots[slot].interval = (sysinterval_t)0;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Feeds the hardware watchdog if all enabled slots are live.
+ * @details This function is meant to be called periodically, from a
+ *          dedicated thread or a virtual timer, with a period shorter
+ *          than the hardware watchdog timeout. When a slot misses its
+ *          check-in interval the watchdog is no more fed and the system
+ *          is reset by the hardware.
+ *
+ * @param[in] wsp       pointer to an initialized @p wdg_supervisor_t
+ *                      structure
+ * @return              The supervision status.
+ * @retval true         if the hardware watchdog has been fed.
+ * @retval false        if a stale slot prevented feeding the watchdog.
+ *
+ * @api
+ */
+bool wdgSupFeed(wdg_supervisor_t *wsp) {
+  systime_t now;
+  unsigned slot;
+
+  osalDbgCheck(wsp != NULL);
+
+  now = osalOsGetSystemTimeX();
+  for (slot = 0U; slot < (unsigned)WDG_SUP_MAX_SLOTS; slot++) {
+    sysinterval_t interval = wsp->ws_slots[slot].interval;
+
+    if (interval != (sysinterval_t)0) {
+      if (osalTimeDiffX(wsp->ws_slots[slot].last, now) > interval) {
+        return false;
+      }
+    }
+  }
+
+  wdgReset(wsp->ws_wdgp);
+
+  return true;
+}
+
+/** @} */
@@ -0,0 +1,133 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    wdgsup.h
+ * @brief   Watchdog supervisor structures and macros.
+ * @details This module implements a multi-source supervision layer above
+ *          the watchdog driver. Each supervised activity owns a software
+ *          slot with an individual check-in interval, the activity marks
+ *          itself live by storing a timestamp in its slot, a lock-free
+ *          operation. The hardware watchdog is fed only when all the
+ *          enabled slots have checked in within their interval, so a
+ *          single stuck activity leads to a reset even while the other
+ *          activities keep running.
+ *
+ * @addtogroup wdg_supervisor
+ * @{
+ */
+
+#ifndef WDGSUP_H
+#define WDGSUP_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of supervision slots.
+ */
+#if !defined(WDG_SUP_MAX_SLOTS) || defined(__DOXYGEN__)
+#define WDG_SUP_MAX_SLOTS           8
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if !HAL_USE_WDG
+#error "watchdog supervisor requires HAL_USE_WDG"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a supervision slot.
+ */
+typedef struct {
+  /**
+   * @brief   Maximum interval between check-ins, zero if the slot is
+   *          disabled.
+   */
+  sysinterval_t         interval;
+  /**
+   * @brief   System time of the last check-in.
+   */
+  volatile systime_t    last;
+} wdg_sup_slot_t;
+
+/**
+ * @brief   Type of a watchdog supervisor structure.
+ */
+typedef struct {
+  /**
+   * @brief   Supervised hardware watchdog, it must be already started.
+   */
+  WDGDriver             *ws_wdgp;
+  /**
+   * @brief   Supervision slots.
+   */
+  wdg_sup_slot_t        ws_slots[WDG_SUP_MAX_SLOTS];
+} wdg_supervisor_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Marks a slot as live.
+ * @details The check-in reduces to a timestamp store so it can be placed
+ *          in the fast path of the supervised loop. No locking is
+ *          required, each slot is written by its owner only.
+ * @note    The function can be called from any context.
+ *
+ * @param[in] wsp       pointer to an initialized @p wdg_supervisor_t
+ *                      structure
+ * @param[in] slot      index of the slot
+ *
+ * @special
+ */
+#define wdgSupCheckIn(wsp, slot)                                            \
+  ((wsp)->ws_slots[slot].last = osalOsGetSystemTimeX())
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void wdgSupObjectInit(wdg_supervisor_t *wsp, WDGDriver *wdgp);
+  void wdgSupEnableSlot(wdg_supervisor_t *wsp, unsigned slot,
+                        sysinterval_t interval);
+  void wdgSupDisableSlot(wdg_supervisor_t *wsp, unsigned slot);
+  bool wdgSupFeed(wdg_supervisor_t *wsp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WDGSUP_H */
+
+/** @} */
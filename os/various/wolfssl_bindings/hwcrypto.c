@@ -0,0 +1,184 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+/*
+ * **** This file incorporates work covered by the following copyright and ****
+ * **** permission notice:                                                 ****
+ *
+ * Copyright (C) 2006-2017 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ *
+ */
+
+/*
+ * Record-layer crypto offload onto the HAL crypto driver (SAMA CRYPTOv1,
+ * STM32 CRYPv1, ...). wolfSSL's ATOMIC_USER callbacks hand the bulk
+ * AES-CBC work of every TLS record to this module, which routes it to a
+ * CRYDriver; the record HMAC stays in software since it is cheap
+ * compared with the block cipher. Build wolfSSL with ATOMIC_USER defined
+ * in user_settings.h and enable HAL_USE_CRY to use it.
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "wolfssl_chibios.h"
+#include "wolfssl/wolfcrypt/hmac.h"
+#include "wolfssl/wolfcrypt/aes.h"
+#include <string.h>
+
+#if defined(ATOMIC_USER) && (HAL_USE_CRY == TRUE)
+
+static CRYDriver *wolfssl_cryp;
+
+/* Loads the session key into the shared transient key slot and keeps the
+   CBC chaining state in the per-direction context, the engine is shared
+   between connections so the key is reloaded before every operation. */
+static int hw_aes_cbc(wolfssl_hwctx *c, int encrypt, unsigned char *out,
+                      const unsigned char *in, unsigned int sz)
+{
+    cryerror_t err;
+
+    err = cryLoadTransientKey(wolfssl_cryp, cry_algo_aes, c->key_len, c->key);
+    if (err != CRY_NOERROR)
+        return -1;
+
+    if (encrypt) {
+        err = cryEncryptAES_CBC(wolfssl_cryp, 0, sz, in, out, c->iv);
+        if (err == CRY_NOERROR)
+            memcpy(c->iv, out + sz - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    } else {
+        err = cryDecryptAES_CBC(wolfssl_cryp, 0, sz, in, out, c->iv);
+        if (err == CRY_NOERROR)
+            memcpy(c->iv, in + sz - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    }
+    return (err == CRY_NOERROR) ? 0 : -1;
+}
+
+/* Captures the write (own == 1) or read (own == 0) key material on the
+   first record of the connection. */
+static void hw_key_setup(wolfssl_hwctx *c, WOLFSSL *ssl, int own)
+{
+    const unsigned char *key, *iv;
+    int client = (wolfSSL_GetSide(ssl) == WOLFSSL_CLIENT_END);
+
+    c->key_len = (unsigned int)wolfSSL_GetKeySize(ssl);
+    if (client == own) {
+        key = wolfSSL_GetClientWriteKey(ssl);
+        iv  = wolfSSL_GetClientWriteIV(ssl);
+    } else {
+        key = wolfSSL_GetServerWriteKey(ssl);
+        iv  = wolfSSL_GetServerWriteIV(ssl);
+    }
+    memcpy(c->key, key, c->key_len);
+    memcpy(c->iv, iv, AES_BLOCK_SIZE);
+    c->key_setup = 1;
+}
+
+static int hw_mac_encrypt_cb(WOLFSSL *ssl, unsigned char *macOut,
+        const unsigned char *macIn, unsigned int macInSz, int macContent,
+        int macVerify, unsigned char *encOut, const unsigned char *encIn,
+        unsigned int encSz, void *ctx)
+{
+    wolfssl_hwctx *c = (wolfssl_hwctx *)ctx;
+    Hmac hmac;
+    unsigned char inner[WOLFSSL_TLS_HMAC_INNER_SZ];
+    int ret;
+
+    /* Only AES-CBC suites are routed to the engine. */
+    if (wolfSSL_GetBulkCipher(ssl) != wolfssl_aes)
+        return -1;
+
+    /* Record HMAC in software. */
+    wolfSSL_SetTlsHmacInner(ssl, inner, macInSz, macContent, macVerify);
+    ret = wc_HmacSetKey(&hmac, wolfSSL_GetHmacType(ssl),
+                        wolfSSL_GetMacSecret(ssl, macVerify),
+                        wolfSSL_GetHmacSize(ssl));
+    if (ret == 0)
+        ret = wc_HmacUpdate(&hmac, inner, sizeof(inner));
+    if (ret == 0)
+        ret = wc_HmacUpdate(&hmac, macIn, macInSz);
+    if (ret == 0)
+        ret = wc_HmacFinal(&hmac, macOut);
+    if (ret != 0)
+        return ret;
+
+    if (!c->key_setup)
+        hw_key_setup(c, ssl, 1);
+
+    return hw_aes_cbc(c, 1, encOut, encIn, encSz);
+}
+
+static int hw_decrypt_verify_cb(WOLFSSL *ssl, unsigned char *decOut,
+        const unsigned char *decIn, unsigned int decSz, int content,
+        int verify, unsigned int *padSz, void *ctx)
+{
+    wolfssl_hwctx *c = (wolfssl_hwctx *)ctx;
+    unsigned int pad = 0, padByte = 0;
+    (void)content;
+    (void)verify;
+
+    if (wolfSSL_GetBulkCipher(ssl) != wolfssl_aes)
+        return -1;
+
+    if (!c->key_setup)
+        hw_key_setup(c, ssl, 0);
+
+    if (hw_aes_cbc(c, 0, decOut, decIn, decSz) != 0)
+        return -1;
+
+    if (wolfSSL_GetCipherType(ssl) == WOLFSSL_AES) {
+        pad = decOut[decSz - 1];
+        padByte = 1;
+    }
+    *padSz = (unsigned int)wolfSSL_GetHmacSize(ssl) + pad + padByte;
+    return 0;
+}
+
+void wolfssl_hwcrypto_init(struct CRYDriver *cryp)
+{
+    wolfssl_cryp = cryp;
+}
+
+void wolfssl_hwcrypto_attach_ctx(WOLFSSL_CTX *ctx)
+{
+    wolfSSL_CTX_SetMacEncryptCb(ctx, hw_mac_encrypt_cb);
+    wolfSSL_CTX_SetDecryptVerifyCb(ctx, hw_decrypt_verify_cb);
+}
+
+void wolfssl_hwcrypto_attach(WOLFSSL *ssl, wolfssl_hwctx *enc,
+                             wolfssl_hwctx *dec)
+{
+    memset(enc, 0, sizeof(*enc));
+    memset(dec, 0, sizeof(*dec));
+    wolfSSL_SetMacEncryptCtx(ssl, enc);
+    wolfSSL_SetDecryptVerifyCtx(ssl, dec);
+}
+
+#endif /* defined(ATOMIC_USER) && (HAL_USE_CRY == TRUE) */
@@ -41,6 +41,14 @@
 #define HAVE_ONE_TIME_AUTH
 #define WOLFSSL_DH_CONST
 		
+/* HW crypto offload */
+/* Routes the record-layer AES-CBC work to the HAL crypto driver, see
+   hwcrypto.c. Requires HAL_USE_CRY. */
+//#define ATOMIC_USER
+
+/* Session memory pool, see wolfssl_chibios.h */
+//#define WOLFSSL_CHIBIOS_MEMPOOL_SIZE (24 * 1024)
+
 /* HW RNG support */
 
 unsigned int chibios_rand_generate(void);
@@ -48,6 +48,36 @@
 #include <string.h>
 static int wolfssl_is_initialized = 0;
 
+#if WOLFSSL_CHIBIOS_MEMPOOL_SIZE > 0
+/* Dedicated pool for the wolfSSL session objects, lazily initialized on
+ * the first allocation (wolfSSL runs SINGLE_THREADED so there is no
+ * race). The TLSF strategy is used when available, long-lived servers
+ * churning sessions then suffer neither fragmentation of the pool nor
+ * of the default heap. */
+static memory_heap_t wolfssl_mempool;
+static uint8_t wolfssl_mempool_buf[WOLFSSL_CHIBIOS_MEMPOOL_SIZE]
+               __attribute__((aligned(CH_HEAP_ALIGNMENT)));
+
+static memory_heap_t *wolfssl_heap_get(void)
+{
+    static int pool_initialized = 0;
+
+    if (!pool_initialized) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+        chHeapObjectInitTLSF(&wolfssl_mempool, wolfssl_mempool_buf,
+                             sizeof(wolfssl_mempool_buf));
+#else
+        chHeapObjectInit(&wolfssl_mempool, wolfssl_mempool_buf,
+                         sizeof(wolfssl_mempool_buf));
+#endif
+        pool_initialized = 1;
+    }
+    return &wolfssl_mempool;
+}
+#else
+#define wolfssl_heap_get() NULL
+#endif
+
 sslconn *sslconn_accept(sslconn *sk)
 {
   sslconn *new;
@@ -57,7 +87,7 @@ sslconn *sslconn_accept(sslconn *sk)
   if (err != ERR_OK) {
       return NULL;
   }
-  new = chHeapAlloc(NULL, sizeof(sslconn));
+  new = chibios_alloc(NULL, sizeof(sslconn));
   if (!new)
       return NULL;
   new->conn = newconn;
@@ -72,7 +102,7 @@ sslconn *sslconn_accept(sslconn *sk)
     return new;
   } else {
     wolfSSL_free(new->ssl);
-    chHeapFree(new);
+    chibios_free(new);
     return NULL;
   }
 }
@@ -85,7 +115,7 @@ sslconn *sslconn_new(enum netconn_type t, WOLFSSL_METHOD* method)
         wolfssl_is_initialized++;
     }
 
-    sk = chHeapAlloc(NULL, sizeof(sslconn));
+    sk = chibios_alloc(NULL, sizeof(sslconn));
     if (!sk)
         return NULL;
     memset(sk, 0, sizeof(sslconn));
@@ -102,7 +132,7 @@ sslconn *sslconn_new(enum netconn_type t, WOLFSSL_METHOD* method)
 error:
     if (sk->ctx)
         wolfSSL_CTX_free(sk->ctx);
-    chHeapFree(sk);
+    chibios_free(sk);
     return NULL;
 }
 
@@ -110,7 +140,7 @@ void sslconn_close(sslconn *sk)
 {
     netconn_delete(sk->conn);
     wolfSSL_free(sk->ssl);
-    chHeapFree(sk);
+    chibios_free(sk);
 }
 
 
@@ -208,7 +238,7 @@ void *chHeapRealloc (void *addr, uint32_t size)
     void *ptr;
 
     if(addr == NULL) {
-        return chHeapAlloc(NULL, size);
+        return chHeapAlloc(wolfssl_heap_get(), size);
     }
 
     /* previous allocated segment is preceded by an heap_header */
@@ -227,7 +257,7 @@ void *chHeapRealloc (void *addr, uint32_t size)
         return addr;
     }
 
-    ptr = chHeapAlloc(NULL, size);
+    ptr = chHeapAlloc(wolfssl_heap_get(), size);
     if(ptr == NULL) {
         return NULL;
     }
@@ -241,7 +271,8 @@ void *chHeapRealloc (void *addr, uint32_t size)
 
 void *chibios_alloc(void *heap, int size)
 {
-    return chHeapAlloc(heap, size);
+    (void)heap;
+    return chHeapAlloc(wolfssl_heap_get(), size);
 }
 
 void chibios_free(void *ptr)
@@ -47,6 +47,16 @@
 #define XMALLOC(s,h,t) chibios_alloc(h,s)
 #define XFREE(p,h,t)   chibios_free(p)
 
+/* Size in bytes of the dedicated session memory pool backing the wolfSSL
+ * allocator, sized for the session/handshake objects of the expected
+ * number of concurrent connections. When zero (the default) allocations
+ * fall back to the default heap; when set, TLS churn no longer
+ * fragments the system heap (the pool uses the TLSF strategy when
+ * CH_CFG_USE_HEAP_TLSF is enabled). */
+#ifndef WOLFSSL_CHIBIOS_MEMPOOL_SIZE
+#define WOLFSSL_CHIBIOS_MEMPOOL_SIZE 0
+#endif
+
 struct sslconn {
     WOLFSSL_CTX *ctx;
     WOLFSSL *ssl;
@@ -66,4 +76,22 @@ void *chibios_alloc(void *heap, int size);
 void chibios_free(void *ptr);
 word32 LowResTimer(void);
 
+/* Record-layer crypto offload onto the HAL crypto driver, see
+ * hwcrypto.c. Requires ATOMIC_USER in user_settings.h and HAL_USE_CRY. */
+#ifdef ATOMIC_USER
+struct CRYDriver;
+
+typedef struct wolfssl_hwctx {
+    int key_setup;
+    unsigned int key_len;
+    unsigned char key[32];
+    unsigned char iv[16];
+} wolfssl_hwctx;
+
+void wolfssl_hwcrypto_init(struct CRYDriver *cryp);
+void wolfssl_hwcrypto_attach_ctx(WOLFSSL_CTX *ctx);
+void wolfssl_hwcrypto_attach(WOLFSSL *ssl, wolfssl_hwctx *enc,
+                             wolfssl_hwctx *dec);
+#endif
+
 #endif
@@ -0,0 +1,364 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cry_test_root.h"
+
+/**
+ * @file    cry_test_sequence_009.c
+ * @brief   Test Sequence 009 code.
+ *
+ * @page cry_test_sequence_009 [9] AES Throughput
+ *
+ * File: @ref cry_test_sequence_009.c
+ *
+ * <h2>Description</h2>
+ * AES throughput benchmarks. The ECB, CBC and CTR paths are measured
+ * for all the key sizes on fixed 640 bytes workloads, the scores are
+ * expressed in KB/S so the cycles per byte can be derived from the CPU
+ * clock. The last case repeats the encryption measures using the DMA
+ * transfer mode so the two engine transfer modes can be compared.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cry_test_009_001
+ * - @subpage cry_test_009_002
+ * - @subpage cry_test_009_003
+ * - @subpage cry_test_009_004
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+static const CRYConfig configBench_Polling = {
+    TRANSFER_POLLING,
+    AES_CFBS_128       //cfbs
+};
+
+static const CRYConfig configBench_DMA = {
+    TRANSFER_DMA,
+    AES_CFBS_128       //cfbs
+};
+
+/* Type of an AES function without initialization vector (ECB).*/
+typedef cryerror_t (*aes_ecb_fn_t)(CRYDriver *cryp, crykey_t key_id,
+                                   size_t size, const uint8_t *in,
+                                   uint8_t *out);
+
+/* Type of an AES function taking an initialization vector (CBC, CTR).*/
+typedef cryerror_t (*aes_iv_fn_t)(CRYDriver *cryp, crykey_t key_id,
+                                  size_t size, const uint8_t *in,
+                                  uint8_t *out, const uint8_t *iv);
+
+static systime_t bench_wait_tick(void) {
+
+  osalThreadSleepMilliseconds(1);
+  return osalOsGetSystemTimeX();
+}
+
+/* Measures one cipher path in a one-second window, the score is
+   returned in KB/S.*/
+static uint32_t bench_aes(aes_ecb_fn_t ecbfn, aes_iv_fn_t ivfn) {
+  systime_t start, end;
+  uint32_t n;
+
+  n = 0;
+  start = bench_wait_tick();
+  end = osalTimeAddX(start, OSAL_MS2I(1000));
+  do {
+    if (ecbfn != NULL) {
+      (void) ecbfn(&CRYD1, 0, TEST_DATA_BYTE_LEN,
+                   (const uint8_t*) msg_clear, (uint8_t*) msg_encrypted);
+    }
+    else {
+      (void) ivfn(&CRYD1, 0, TEST_DATA_BYTE_LEN,
+                  (const uint8_t*) msg_clear, (uint8_t*) msg_encrypted,
+                  (const uint8_t*) test_vectors);
+    }
+    n++;
+  } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+
+  return (n * TEST_DATA_BYTE_LEN) / 1024U;
+}
+
+static void bench_key(uint32_t size) {
+  cryerror_t ret;
+
+  ret = cryLoadTransientKey(&CRYD1, (cryalgorithm_t) cry_algo_aes, size,
+                            (uint8_t *) test_keys);
+  test_assert(ret == CRY_NOERROR, "failed load transient key");
+}
+
+static void bench_print(const char *label, uint32_t score) {
+
+  test_print_score(label, score, "KB/S");
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cry_test_009_001 [9.1] AES ECB throughput
+ *
+ * <h2>Description</h2>
+ * Measuring AES ECB encryption and decryption throughput in polling
+ * mode with the three key sizes.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.1.1] Measuring with the key of 16 byte size.
+ * - [9.1.2] Measuring with the key of 24 byte size.
+ * - [9.1.3] Measuring with the key of 32 byte size.
+ * .
+ */
+
+static void cry_test_009_001_setup(void) {
+  memcpy((char*) msg_clear, test_plain_data, TEST_DATA_BYTE_LEN);
+  cryStart(&CRYD1, &configBench_Polling);
+}
+
+static void cry_test_009_001_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_001_execute(void) {
+
+  /* [9.1.1] Measuring with the key of 16 byte size.*/
+  test_set_step(1);
+  {
+    bench_key(16);
+    bench_print("cry.ecb128.enc", bench_aes(cryEncryptAES_ECB, NULL));
+    bench_print("cry.ecb128.dec", bench_aes(cryDecryptAES_ECB, NULL));
+  }
+
+  /* [9.1.2] Measuring with the key of 24 byte size.*/
+  test_set_step(2);
+  {
+    bench_key(24);
+    bench_print("cry.ecb192.enc", bench_aes(cryEncryptAES_ECB, NULL));
+    bench_print("cry.ecb192.dec", bench_aes(cryDecryptAES_ECB, NULL));
+  }
+
+  /* [9.1.3] Measuring with the key of 32 byte size.*/
+  test_set_step(3);
+  {
+    bench_key(32);
+    bench_print("cry.ecb256.enc", bench_aes(cryEncryptAES_ECB, NULL));
+    bench_print("cry.ecb256.dec", bench_aes(cryDecryptAES_ECB, NULL));
+  }
+}
+
+static const testcase_t cry_test_009_001 = {
+  "AES ECB throughput",
+  cry_test_009_001_setup,
+  cry_test_009_001_teardown,
+  cry_test_009_001_execute
+};
+
+/**
+ * @page cry_test_009_002 [9.2] AES CBC throughput
+ *
+ * <h2>Description</h2>
+ * Measuring AES CBC encryption and decryption throughput in polling
+ * mode with the three key sizes.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.2.1] Measuring with the key of 16 byte size.
+ * - [9.2.2] Measuring with the key of 24 byte size.
+ * - [9.2.3] Measuring with the key of 32 byte size.
+ * .
+ */
+
+static void cry_test_009_002_setup(void) {
+  memcpy((char*) msg_clear, test_plain_data, TEST_DATA_BYTE_LEN);
+  cryStart(&CRYD1, &configBench_Polling);
+}
+
+static void cry_test_009_002_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_002_execute(void) {
+
+  /* [9.2.1] Measuring with the key of 16 byte size.*/
+  test_set_step(1);
+  {
+    bench_key(16);
+    bench_print("cry.cbc128.enc", bench_aes(NULL, cryEncryptAES_CBC));
+    bench_print("cry.cbc128.dec", bench_aes(NULL, cryDecryptAES_CBC));
+  }
+
+  /* [9.2.2] Measuring with the key of 24 byte size.*/
+  test_set_step(2);
+  {
+    bench_key(24);
+    bench_print("cry.cbc192.enc", bench_aes(NULL, cryEncryptAES_CBC));
+    bench_print("cry.cbc192.dec", bench_aes(NULL, cryDecryptAES_CBC));
+  }
+
+  /* [9.2.3] Measuring with the key of 32 byte size.*/
+  test_set_step(3);
+  {
+    bench_key(32);
+    bench_print("cry.cbc256.enc", bench_aes(NULL, cryEncryptAES_CBC));
+    bench_print("cry.cbc256.dec", bench_aes(NULL, cryDecryptAES_CBC));
+  }
+}
+
+static const testcase_t cry_test_009_002 = {
+  "AES CBC throughput",
+  cry_test_009_002_setup,
+  cry_test_009_002_teardown,
+  cry_test_009_002_execute
+};
+
+/**
+ * @page cry_test_009_003 [9.3] AES CTR throughput
+ *
+ * <h2>Description</h2>
+ * Measuring AES CTR encryption and decryption throughput in polling
+ * mode with the three key sizes.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.3.1] Measuring with the key of 16 byte size.
+ * - [9.3.2] Measuring with the key of 24 byte size.
+ * - [9.3.3] Measuring with the key of 32 byte size.
+ * .
+ */
+
+static void cry_test_009_003_setup(void) {
+  memcpy((char*) msg_clear, test_plain_data, TEST_DATA_BYTE_LEN);
+  cryStart(&CRYD1, &configBench_Polling);
+}
+
+static void cry_test_009_003_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_003_execute(void) {
+
+  /* [9.3.1] Measuring with the key of 16 byte size.*/
+  test_set_step(1);
+  {
+    bench_key(16);
+    bench_print("cry.ctr128.enc", bench_aes(NULL, cryEncryptAES_CTR));
+    bench_print("cry.ctr128.dec", bench_aes(NULL, cryDecryptAES_CTR));
+  }
+
+  /* [9.3.2] Measuring with the key of 24 byte size.*/
+  test_set_step(2);
+  {
+    bench_key(24);
+    bench_print("cry.ctr192.enc", bench_aes(NULL, cryEncryptAES_CTR));
+    bench_print("cry.ctr192.dec", bench_aes(NULL, cryDecryptAES_CTR));
+  }
+
+  /* [9.3.3] Measuring with the key of 32 byte size.*/
+  test_set_step(3);
+  {
+    bench_key(32);
+    bench_print("cry.ctr256.enc", bench_aes(NULL, cryEncryptAES_CTR));
+    bench_print("cry.ctr256.dec", bench_aes(NULL, cryDecryptAES_CTR));
+  }
+}
+
+static const testcase_t cry_test_009_003 = {
+  "AES CTR throughput",
+  cry_test_009_003_setup,
+  cry_test_009_003_teardown,
+  cry_test_009_003_execute
+};
+
+/**
+ * @page cry_test_009_004 [9.4] AES DMA throughput
+ *
+ * <h2>Description</h2>
+ * Measuring AES ECB, CBC and CTR encryption throughput with a 16 byte
+ * key using the DMA transfer mode, to be compared with the polling
+ * scores of the previous cases.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.4.1] Measuring the ECB encryption throughput.
+ * - [9.4.2] Measuring the CBC encryption throughput.
+ * - [9.4.3] Measuring the CTR encryption throughput.
+ * .
+ */
+
+static void cry_test_009_004_setup(void) {
+  memcpy((char*) msg_clear, test_plain_data, TEST_DATA_BYTE_LEN);
+  cryStart(&CRYD1, &configBench_DMA);
+}
+
+static void cry_test_009_004_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_004_execute(void) {
+
+  /* [9.4.1] Measuring the ECB encryption throughput.*/
+  test_set_step(1);
+  {
+    bench_key(16);
+    bench_print("cry.dma.ecb128.enc", bench_aes(cryEncryptAES_ECB, NULL));
+  }
+
+  /* [9.4.2] Measuring the CBC encryption throughput.*/
+  test_set_step(2);
+  {
+    bench_key(16);
+    bench_print("cry.dma.cbc128.enc", bench_aes(NULL, cryEncryptAES_CBC));
+  }
+
+  /* [9.4.3] Measuring the CTR encryption throughput.*/
+  test_set_step(3);
+  {
+    bench_key(16);
+    bench_print("cry.dma.ctr128.enc", bench_aes(NULL, cryEncryptAES_CTR));
+  }
+}
+
+static const testcase_t cry_test_009_004 = {
+  "AES DMA throughput",
+  cry_test_009_004_setup,
+  cry_test_009_004_teardown,
+  cry_test_009_004_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cry_test_sequence_009_array[] = {
+  &cry_test_009_001,
+  &cry_test_009_002,
+  &cry_test_009_003,
+  &cry_test_009_004,
+  NULL
+};
+
+/**
+ * @brief   AES Throughput.
+ */
+const testsequence_t cry_test_sequence_009 = {
+  "AES Throughput",
+  cry_test_sequence_009_array
+};
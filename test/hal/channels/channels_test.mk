@@ -0,0 +1,7 @@
+# List of all the ChibiOS/HAL channels test files.
+TESTSRC += ${CHIBIOS}/test/hal/channels/source/test/cht_test_root.c \
+           ${CHIBIOS}/test/hal/channels/source/test/cht_test_sequence_001.c \
+           ${CHIBIOS}/test/hal/channels/source/test/cht_test_sequence_002.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/hal/channels/source/test
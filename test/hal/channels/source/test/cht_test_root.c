@@ -0,0 +1,67 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for ChibiOS HAL channel implementations. The suite is
+ * parametric, the application provides any @p BaseChannel derived
+ * object wired in loopback and the suite verifies the channel
+ * semantics, timeout behavior and partial transfer returns, then
+ * measures the throughput of the byte, bulk and vectored paths. It
+ * applies unmodified to serial, serial over USB and simulator channels.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage cht_test_sequence_001
+ * - @subpage cht_test_sequence_002
+ * .
+ */
+
+/**
+ * @file    cht_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "cht_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const cht_test_suite_array[] = {
+  &cht_test_sequence_001,
+  &cht_test_sequence_002,
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t cht_test_suite = {
+  "ChibiOS/HAL Channels Test Suite",
+  cht_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+#endif /* !defined(__DOXYGEN__) */
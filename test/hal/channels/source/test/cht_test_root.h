@@ -0,0 +1,60 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cht_test_root.h
+ * @brief   Test Suite root structures header.
+ */
+
+#ifndef CHT_TEST_ROOT_H
+#define CHT_TEST_ROOT_H
+
+#include "ch_test.h"
+
+#include "cht_test_sequence_001.h"
+#include "cht_test_sequence_002.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+extern const testsuite_t cht_test_suite;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Shared definitions.                                                       */
+/*===========================================================================*/
+
+#define TEST_SUITE_NAME "ChibiOS/HAL Channels Test Suite"
+
+/**
+ * @brief   Channel under test, it must be provided by the test
+ *          application wired in loopback: everything written to the
+ *          channel must be readable back from it.
+ */
+extern BaseChannel *cht_channel;
+
+#endif /* !defined(__DOXYGEN__) */
+
+#endif /* CHT_TEST_ROOT_H */
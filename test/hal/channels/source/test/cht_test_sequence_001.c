@@ -0,0 +1,279 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cht_test_root.h"
+
+/**
+ * @file    cht_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page cht_test_sequence_001 [1] Conformance
+ *
+ * File: @ref cht_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * This sequence verifies that the channel under test conforms to the
+ * @p BaseChannel semantics: timeout returns on an empty channel,
+ * partial transfer returns, data integrity through the loopback and
+ * the equivalence of the vectored operations with their linear
+ * counterparts.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cht_test_001_001
+ * - @subpage cht_test_001_002
+ * - @subpage cht_test_001_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define CHT_PATTERN_SIZE        64
+
+static uint8_t cht_txbuf[CHT_PATTERN_SIZE];
+static uint8_t cht_rxbuf[CHT_PATTERN_SIZE];
+
+/* Fills the transmit buffer with a known pattern.*/
+static void cht_fill_pattern(void) {
+  unsigned i;
+
+  for (i = 0; i < CHT_PATTERN_SIZE; i++) {
+    cht_txbuf[i] = (uint8_t)(i ^ 0x55U);
+    cht_rxbuf[i] = (uint8_t)0;
+  }
+}
+
+/* Discards any data pending in the loopback.*/
+static void cht_drain(void) {
+
+  while (chnGetTimeout(cht_channel, TIME_MS2I(10)) >= MSG_OK) {
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cht_test_001_001 [1.1] Timeout behavior on an empty channel
+ *
+ * <h2>Description</h2>
+ * Read operations are attempted on a drained channel, all of them must
+ * return with a timeout indication and no data.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] The channel is drained, a chnGetTimeout() with immediate
+ *   timeout must return MSG_TIMEOUT.
+ * - [1.1.2] A chnReadTimeout() on the empty channel must return zero
+ *   after the timeout expires.
+ * - [1.1.3] A chnPutTimeout() must succeed because the channel has
+ *   room, the byte is drained back.
+ * .
+ */
+
+static void cht_test_001_001_setup(void) {
+  cht_drain();
+}
+
+static void cht_test_001_001_execute(void) {
+
+  /* [1.1.1] The channel is drained, a chnGetTimeout() with immediate
+     timeout must return MSG_TIMEOUT.*/
+  test_set_step(1);
+  {
+    msg_t msg = chnGetTimeout(cht_channel, TIME_IMMEDIATE);
+    test_assert(msg == MSG_TIMEOUT, "unexpected data or error");
+  }
+
+  /* [1.1.2] A chnReadTimeout() on the empty channel must return zero
+     after the timeout expires.*/
+  test_set_step(2);
+  {
+    size_t n = chnReadTimeout(cht_channel, cht_rxbuf,
+                              CHT_PATTERN_SIZE, TIME_MS2I(10));
+    test_assert(n == 0U, "unexpected data");
+  }
+
+  /* [1.1.3] A chnPutTimeout() must succeed because the channel has
+     room, the byte is drained back.*/
+  test_set_step(3);
+  {
+    msg_t msg = chnPutTimeout(cht_channel, 0xAAU, TIME_MS2I(100));
+    test_assert(msg == MSG_OK, "put failed");
+    msg = chnGetTimeout(cht_channel, TIME_MS2I(1000));
+    test_assert(msg == 0xAA, "loopback data mismatch");
+  }
+}
+
+static const testcase_t cht_test_001_001 = {
+  "Timeout behavior on an empty channel",
+  cht_test_001_001_setup,
+  NULL,
+  cht_test_001_001_execute
+};
+
+/**
+ * @page cht_test_001_002 [1.2] Loopback integrity and partial reads
+ *
+ * <h2>Description</h2>
+ * A pattern is written through the bulk API and read back, then a read
+ * larger than the available data is verified to return only the
+ * available bytes.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] The pattern is written, the write must report the full
+ *   size.
+ * - [1.2.2] The pattern is read back and compared.
+ * - [1.2.3] Half a pattern is written, a full size read must return
+ *   only the available bytes within the timeout.
+ * .
+ */
+
+static void cht_test_001_002_setup(void) {
+  cht_fill_pattern();
+  cht_drain();
+}
+
+static void cht_test_001_002_execute(void) {
+
+  /* [1.2.1] The pattern is written, the write must report the full
+     size.*/
+  test_set_step(1);
+  {
+    size_t n = chnWriteTimeout(cht_channel, cht_txbuf,
+                               CHT_PATTERN_SIZE, TIME_MS2I(1000));
+    test_assert(n == CHT_PATTERN_SIZE, "write incomplete");
+  }
+
+  /* [1.2.2] The pattern is read back and compared.*/
+  test_set_step(2);
+  {
+    unsigned i;
+    size_t n = chnReadTimeout(cht_channel, cht_rxbuf,
+                              CHT_PATTERN_SIZE, TIME_MS2I(1000));
+    test_assert(n == CHT_PATTERN_SIZE, "read incomplete");
+    for (i = 0; i < CHT_PATTERN_SIZE; i++) {
+      test_assert(cht_rxbuf[i] == cht_txbuf[i], "data mismatch");
+    }
+  }
+
+  /* [1.2.3] Half a pattern is written, a full size read must return
+     only the available bytes within the timeout.*/
+  test_set_step(3);
+  {
+    size_t n = chnWriteTimeout(cht_channel, cht_txbuf,
+                               CHT_PATTERN_SIZE / 2U, TIME_MS2I(1000));
+    test_assert(n == CHT_PATTERN_SIZE / 2U, "write incomplete");
+    n = chnReadTimeout(cht_channel, cht_rxbuf,
+                       CHT_PATTERN_SIZE, TIME_MS2I(100));
+    test_assert(n == CHT_PATTERN_SIZE / 2U, "partial read mismatch");
+  }
+}
+
+static const testcase_t cht_test_001_002 = {
+  "Loopback integrity and partial reads",
+  cht_test_001_002_setup,
+  NULL,
+  cht_test_001_002_execute
+};
+
+/**
+ * @page cht_test_001_003 [1.3] Vectored operations equivalence
+ *
+ * <h2>Description</h2>
+ * The pattern is written as four segments through streamWriteV() and
+ * read back as four segments through streamReadV(), the transferred
+ * sizes and the data must match the linear operations.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] The pattern is written as four segments, the returned size
+ *   must be the sum of the segments.
+ * - [1.3.2] The pattern is read back as four segments and compared.
+ * .
+ */
+
+static void cht_test_001_003_setup(void) {
+  cht_fill_pattern();
+  cht_drain();
+}
+
+static void cht_test_001_003_execute(void) {
+
+  /* [1.3.1] The pattern is written as four segments, the returned size
+     must be the sum of the segments.*/
+  test_set_step(1);
+  {
+    stm_iovec_t iov[4];
+    unsigned i;
+    size_t n;
+
+    for (i = 0; i < 4; i++) {
+      iov[i].base = &cht_txbuf[i * (CHT_PATTERN_SIZE / 4U)];
+      iov[i].len  = CHT_PATTERN_SIZE / 4U;
+    }
+    n = streamWriteV(cht_channel, iov, 4);
+    test_assert(n == CHT_PATTERN_SIZE, "vectored write incomplete");
+  }
+
+  /* [1.3.2] The pattern is read back as four segments and compared.*/
+  test_set_step(2);
+  {
+    stm_iovec_t iov[4];
+    unsigned i;
+    size_t n;
+
+    for (i = 0; i < 4; i++) {
+      iov[i].base = &cht_rxbuf[i * (CHT_PATTERN_SIZE / 4U)];
+      iov[i].len  = CHT_PATTERN_SIZE / 4U;
+    }
+    n = streamReadV(cht_channel, iov, 4);
+    test_assert(n == CHT_PATTERN_SIZE, "vectored read incomplete");
+    for (i = 0; i < CHT_PATTERN_SIZE; i++) {
+      test_assert(cht_rxbuf[i] == cht_txbuf[i], "data mismatch");
+    }
+  }
+}
+
+static const testcase_t cht_test_001_003 = {
+  "Vectored operations equivalence",
+  cht_test_001_003_setup,
+  NULL,
+  cht_test_001_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cht_test_sequence_001_array[] = {
+  &cht_test_001_001,
+  &cht_test_001_002,
+  &cht_test_001_003,
+  NULL
+};
+
+/**
+ * @brief   Conformance.
+ */
+const testsequence_t cht_test_sequence_001 = {
+  "Conformance",
+  cht_test_sequence_001_array
+};
@@ -0,0 +1,240 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cht_test_root.h"
+
+/**
+ * @file    cht_test_sequence_002.c
+ * @brief   Test Sequence 002 code.
+ *
+ * @page cht_test_sequence_002 [2] Benchmarks
+ *
+ * File: @ref cht_test_sequence_002.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures the channel under test through the loopback:
+ * the throughput of the byte, bulk and vectored write paths, with a
+ * background thread draining the returned data, and the single byte
+ * round trip rate. Scores are in bytes or round trips per second so
+ * the paths and the implementations can be compared directly.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cht_test_002_001
+ * - @subpage cht_test_002_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define CHT_BENCH_BLOCK         64
+
+static uint8_t cht_bench_buf[CHT_BENCH_BLOCK];
+static uint8_t cht_drain_buf[CHT_BENCH_BLOCK];
+
+static THD_WORKING_AREA(cht_drain_wa, 256);
+static thread_t *cht_drain_tp;
+
+/* Drain thread, it discards everything returned by the loopback.*/
+static THD_FUNCTION(cht_drain_thread, arg) {
+
+  (void)arg;
+
+  chRegSetThreadName("cht_drain");
+
+  while (chThdShouldTerminateX() == false) {
+    (void) chnReadTimeout(cht_channel, cht_drain_buf,
+                          sizeof cht_drain_buf, TIME_MS2I(10));
+  }
+}
+
+static systime_t cht_wait_tick(void) {
+
+  osalThreadSleepMilliseconds(1);
+  return osalOsGetSystemTimeX();
+}
+
+static void cht_drain_start(void) {
+
+  cht_drain_tp = chThdCreateStatic(cht_drain_wa, sizeof cht_drain_wa,
+                                   chThdGetPriorityX() + 1,
+                                   cht_drain_thread, NULL);
+}
+
+static void cht_drain_stop(void) {
+
+  chThdTerminate(cht_drain_tp);
+  chThdWait(cht_drain_tp);
+  cht_drain_tp = NULL;
+}
+
+static void cht_print_score(const char *label, uint32_t n,
+                            const char *unit) {
+
+  test_print_score(label, n, unit);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cht_test_002_001 [2.1] Write path throughput
+ *
+ * <h2>Description</h2>
+ * The byte, bulk and vectored write paths are exercised for one second
+ * each while the drain thread discards the looped back data, the
+ * written bytes per second are printed for each path.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.1.1] Measuring the single byte path, chnPutTimeout().
+ * - [2.1.2] Measuring the bulk path, chnWriteTimeout().
+ * - [2.1.3] Measuring the vectored path, streamWriteV() with four
+ *   segments.
+ * .
+ */
+
+static void cht_test_002_001_setup(void) {
+  cht_drain_start();
+}
+
+static void cht_test_002_001_teardown(void) {
+  cht_drain_stop();
+}
+
+static void cht_test_002_001_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [2.1.1] Measuring the single byte path, chnPutTimeout().*/
+  test_set_step(1);
+  {
+    n = 0;
+    start = cht_wait_tick();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      if (chnPutTimeout(cht_channel, (uint8_t)n, TIME_MS2I(100)) == MSG_OK)
+        n++;
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    cht_print_score("cht.byte_path", n, "bytes/S");
+  }
+
+  /* [2.1.2] Measuring the bulk path, chnWriteTimeout().*/
+  test_set_step(2);
+  {
+    n = 0;
+    start = cht_wait_tick();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      n += (uint32_t)chnWriteTimeout(cht_channel, cht_bench_buf,
+                                     CHT_BENCH_BLOCK, TIME_MS2I(100));
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    cht_print_score("cht.bulk_path", n, "bytes/S");
+  }
+
+  /* [2.1.3] Measuring the vectored path, streamWriteV() with four
+     segments.*/
+  test_set_step(3);
+  {
+    stm_iovec_t iov[4];
+    unsigned i;
+
+    for (i = 0; i < 4; i++) {
+      iov[i].base = &cht_bench_buf[i * (CHT_BENCH_BLOCK / 4U)];
+      iov[i].len  = CHT_BENCH_BLOCK / 4U;
+    }
+    n = 0;
+    start = cht_wait_tick();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      n += (uint32_t)streamWriteV(cht_channel, iov, 4);
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    cht_print_score("cht.vectored_path", n, "bytes/S");
+  }
+}
+
+static const testcase_t cht_test_002_001 = {
+  "Write path throughput",
+  cht_test_002_001_setup,
+  cht_test_002_001_teardown,
+  cht_test_002_001_execute
+};
+
+/**
+ * @page cht_test_002_002 [2.2] Round trip latency
+ *
+ * <h2>Description</h2>
+ * A single byte is written and read back in a tight loop for one
+ * second, the number of round trips per second is the inverse of the
+ * average single byte latency through the whole channel stack.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.2.1] Byte round trips are repeated continuously in a one-second
+ *   time window.
+ * .
+ */
+
+static void cht_test_002_002_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [2.2.1] Byte round trips are repeated continuously in a one-second
+     time window.*/
+  test_set_step(1);
+  {
+    n = 0;
+    start = cht_wait_tick();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      if (chnPutTimeout(cht_channel, 0x5AU, TIME_MS2I(100)) != MSG_OK)
+        break;
+      if (chnGetTimeout(cht_channel, TIME_MS2I(100)) < MSG_OK)
+        break;
+      n++;
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    cht_print_score("cht.round_trip", n, "rt/S");
+  }
+}
+
+static const testcase_t cht_test_002_002 = {
+  "Round trip latency",
+  NULL,
+  NULL,
+  cht_test_002_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cht_test_sequence_002_array[] = {
+  &cht_test_002_001,
+  &cht_test_002_002,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t cht_test_sequence_002 = {
+  "Benchmarks",
+  cht_test_sequence_002_array
+};
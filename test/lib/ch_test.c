@@ -192,6 +192,37 @@ void test_println(const char *msgp) {
   streamWrite(test_chp, (const uint8_t *)"\r\n", 2);
 }
 
+/**
+ * @brief   Prints a benchmark score.
+ * @details The score is printed as a human readable line followed by a
+ *          machine readable record in the form
+ *          @verbatim #CSV,<name>,<value>,<unit> @endverbatim
+ *          so benchmark results can be extracted from captured test
+ *          reports and compared across runs, see tools/benchdiff.py.
+ *          The name must not contain commas.
+ *
+ * @param[in] name      the benchmark name
+ * @param[in] value     the measured value
+ * @param[in] unit      the unit of the measure
+ *
+ * @api
+ */
+void test_print_score(const char *name, uint32_t value, const char *unit) {
+
+  test_print("--- ");
+  test_print(name);
+  test_print(" : ");
+  test_printn(value);
+  test_print(" ");
+  test_println(unit);
+  test_print("#CSV,");
+  test_print(name);
+  test_print(",");
+  test_printn(value);
+  test_print(",");
+  test_println(unit);
+}
+
 /**
  * @brief   Emits a token into the tokens buffer.
  *
@@ -199,6 +199,7 @@ extern "C" {
   void test_printn(uint32_t n);
   void test_print(const char *msgp);
   void test_println(const char *msgp);
+  void test_print_score(const char *name, uint32_t value, const char *unit);
   void test_emit_token(char token);
   void test_emit_token_i(char token);
   msg_t test_execute(BaseSequentialStream *stream, const testsuite_t *tsp);
@@ -1,7 +1,8 @@
 # List of all the ChibiOS/HAL MFS test files.
 TESTSRC += ${CHIBIOS}/test/mfs/source/test/mfs_test_root.c \
            ${CHIBIOS}/test/mfs/source/test/mfs_test_sequence_001.c \
-           ${CHIBIOS}/test/mfs/source/test/mfs_test_sequence_002.c
+           ${CHIBIOS}/test/mfs/source/test/mfs_test_sequence_002.c \
+           ${CHIBIOS}/test/mfs/source/test/mfs_test_sequence_003.c
 
 # Required include directories
 TESTINC += ${CHIBIOS}/test/mfs/source/test
@@ -0,0 +1,347 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_003.c
+ * @brief   Test Sequence 003 code.
+ *
+ * @page mfs_test_sequence_003 [3] Benchmarks
+ *
+ * File: @ref mfs_test_sequence_003.c
+ *
+ * <h2>Description</h2>
+ * This sequence benchmarks the managed storage on the underlying flash,
+ * it measures the mount time at growing record populations, the write
+ * amplification at various record sizes and the pauses introduced by
+ * the garbage collector, both in monolithic and incremental mode. Times
+ * are expressed in system ticks, the absolute values depend on the
+ * flash device but their evolution across releases makes regressions
+ * visible.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_003_001
+ * - @subpage mfs_test_003_002
+ * - @subpage mfs_test_003_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "mfs.h"
+
+#define BENCH_MOUNT_REPETITIONS     10
+#define BENCH_WA_RECORDS            8
+#define BENCH_GC_OVERWRITES         16
+#define BENCH_GC_RECORD_SIZE        256
+
+/* Writes records 1..n of the specified size, the buffer content is not
+   relevant for the measures.*/
+static void bench_populate(unsigned n, size_t size) {
+  unsigned i;
+
+  for (i = 1; i <= n; i++) {
+    mfs_error_t err = mfsWriteRecord(&mfs1, (mfs_id_t)i, size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record write failure");
+  }
+}
+
+/* Overwrites record 1 repeatedly so that garbage accumulates in the
+   current bank.*/
+static void bench_make_garbage(void) {
+  unsigned i;
+
+  for (i = 0; i < BENCH_GC_OVERWRITES; i++) {
+    mfs_error_t err = mfsWriteRecord(&mfs1, 1, BENCH_GC_RECORD_SIZE,
+                                     mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record write failure");
+  }
+}
+
+static void bench_print_time(const char *label, systime_t ticks) {
+
+  test_print_score(label, (uint32_t)ticks, "ticks");
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_003_001 [3.1] Mount time versus record count
+ *
+ * <h2>Description</h2>
+ * The partition is populated with a growing number of records, at each
+ * population the storage is mounted and unmounted repeatedly and the
+ * cumulated mount time is printed. The measure covers the record scan
+ * and the index rebuild performed by mfsStart().
+ *
+ * <h2>Test Steps</h2>
+ * - [3.1.1] The partition is erased and mounted.
+ * - [3.1.2] Measuring mount time with 8 records.
+ * - [3.1.3] Measuring mount time with 16 records.
+ * - [3.1.4] Measuring mount time with 32 records.
+ * .
+ */
+
+static void mfs_test_003_001_setup(void) {
+  mfsObjectInit(&mfs1);
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_003_001_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+/* Populates up to the specified record count then measures repeated
+   mounts, returns the cumulated time.*/
+static systime_t bench_mount(unsigned nrecords) {
+  systime_t start, elapsed;
+  unsigned i;
+
+  bench_populate(nrecords, 32);
+  mfsStop(&mfs1);
+
+  start = osalOsGetSystemTimeX();
+  for (i = 0; i < BENCH_MOUNT_REPETITIONS; i++) {
+    mfs_error_t err;
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount failure");
+    if (i < BENCH_MOUNT_REPETITIONS - 1) {
+      mfsStop(&mfs1);
+    }
+  }
+  elapsed = (systime_t)(osalOsGetSystemTimeX() - start);
+
+  return elapsed;
+}
+
+static void mfs_test_003_001_execute(void) {
+
+  /* [3.1.1] The partition is erased and mounted.*/
+  test_set_step(1);
+  {
+    mfs_error_t err = mfsErase(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "erase failure");
+  }
+
+  /* [3.1.2] Measuring mount time with 8 records.*/
+  test_set_step(2);
+  {
+    bench_print_time("mfs.mount_8", bench_mount(8));
+  }
+
+  /* [3.1.3] Measuring mount time with 16 records.*/
+  test_set_step(3);
+  {
+    bench_print_time("mfs.mount_16", bench_mount(16));
+  }
+
+  /* [3.1.4] Measuring mount time with 32 records.*/
+  test_set_step(4);
+  {
+    bench_print_time("mfs.mount_32", bench_mount(32));
+  }
+}
+
+static const testcase_t mfs_test_003_001 = {
+  "Mount time versus record count",
+  mfs_test_003_001_setup,
+  mfs_test_003_001_teardown,
+  mfs_test_003_001_execute
+};
+
+/**
+ * @page mfs_test_003_002 [3.2] Write amplification per record size
+ *
+ * <h2>Description</h2>
+ * Batches of records are written at various record sizes, after each
+ * batch the consumed bank space is compared with the written payload.
+ * The printed ratio, multiplied by 100, exposes the metadata and
+ * alignment overhead per record size.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.2.1] Measuring amplification with 16 bytes records.
+ * - [3.2.2] Measuring amplification with 64 bytes records.
+ * - [3.2.3] Measuring amplification with 256 bytes records.
+ * .
+ */
+
+static void mfs_test_003_002_setup(void) {
+  mfsObjectInit(&mfs1);
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_003_002_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+/* Erases the partition, writes a batch of records of the specified
+   size then prints the space consumed for 100 payload bytes.*/
+static void bench_amplification(const char *label, size_t size) {
+  flash_offset_t used;
+  mfs_error_t err;
+
+  err = mfsErase(&mfs1);
+  test_assert(err == MFS_NO_ERROR, "erase failure");
+
+  used = mfs1.used_space;
+  bench_populate(BENCH_WA_RECORDS, size);
+
+  test_print_score(label,
+                   (uint32_t)(((mfs1.used_space - used) * 100U) /
+                              ((flash_offset_t)size * BENCH_WA_RECORDS)),
+                   "x100");
+}
+
+static void mfs_test_003_002_execute(void) {
+
+  /* [3.2.1] Measuring amplification with 16 bytes records.*/
+  test_set_step(1);
+  {
+    bench_amplification("mfs.wa_16", 16);
+  }
+
+  /* [3.2.2] Measuring amplification with 64 bytes records.*/
+  test_set_step(2);
+  {
+    bench_amplification("mfs.wa_64", 64);
+  }
+
+  /* [3.2.3] Measuring amplification with 256 bytes records.*/
+  test_set_step(3);
+  {
+    bench_amplification("mfs.wa_256", 256);
+  }
+}
+
+static const testcase_t mfs_test_003_002 = {
+  "Write amplification per record size",
+  mfs_test_003_002_setup,
+  mfs_test_003_002_teardown,
+  mfs_test_003_002_execute
+};
+
+/**
+ * @page mfs_test_003_003 [3.3] Garbage collection pauses
+ *
+ * <h2>Description</h2>
+ * Garbage is accumulated by overwriting a record repeatedly, then the
+ * duration of a monolithic garbage collection is measured. The exercise
+ * is repeated using single incremental steps, recording the longest
+ * individual call, which is the worst pause the incremental mode can
+ * introduce in the caller.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] The partition is erased and garbage is accumulated.
+ * - [3.3.2] Measuring a monolithic garbage collection.
+ * - [3.3.3] Garbage is accumulated again.
+ * - [3.3.4] Measuring the longest single incremental step.
+ * .
+ */
+
+static void mfs_test_003_003_setup(void) {
+  mfsObjectInit(&mfs1);
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_003_003_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_003_003_execute(void) {
+
+  /* [3.3.1] The partition is erased and garbage is accumulated.*/
+  test_set_step(1);
+  {
+    mfs_error_t err = mfsErase(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "erase failure");
+    bench_make_garbage();
+  }
+
+  /* [3.3.2] Measuring a monolithic garbage collection.*/
+  test_set_step(2);
+  {
+    systime_t start;
+    mfs_error_t err;
+
+    start = osalOsGetSystemTimeX();
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "collection failure");
+    bench_print_time("mfs.gc_monolithic",
+                     (systime_t)(osalOsGetSystemTimeX() - start));
+  }
+
+  /* [3.3.3] Garbage is accumulated again.*/
+  test_set_step(3);
+  {
+    bench_make_garbage();
+  }
+
+  /* [3.3.4] Measuring the longest single incremental step.*/
+  test_set_step(4);
+  {
+    systime_t worst = (systime_t)0;
+    mfs_error_t err;
+
+    do {
+      systime_t start, elapsed;
+
+      start = osalOsGetSystemTimeX();
+      err = mfsPerformGarbageCollectionSteps(&mfs1, 1);
+      elapsed = (systime_t)(osalOsGetSystemTimeX() - start);
+      if (elapsed > worst) {
+        worst = elapsed;
+      }
+    } while (err == MFS_WARN_GC);
+    test_assert(err == MFS_NO_ERROR, "collection failure");
+    bench_print_time("mfs.gc_step_worst", worst);
+  }
+}
+
+static const testcase_t mfs_test_003_003 = {
+  "Garbage collection pauses",
+  mfs_test_003_003_setup,
+  mfs_test_003_003_teardown,
+  mfs_test_003_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_003_array[] = {
+  &mfs_test_003_001,
+  &mfs_test_003_002,
+  &mfs_test_003_003,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t mfs_test_sequence_003 = {
+  "Benchmarks",
+  mfs_test_sequence_003_array
+};
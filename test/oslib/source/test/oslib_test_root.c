@@ -25,6 +25,8 @@
  * - @subpage oslib_test_sequence_002
  * - @subpage oslib_test_sequence_003
  * - @subpage oslib_test_sequence_004
+ * - @subpage oslib_test_sequence_005
+ * - @subpage oslib_test_sequence_006
  * .
  */
 
@@ -57,6 +59,10 @@ const testsequence_t * const oslib_test_suite_array[] = {
 #endif
 #if ((CH_CFG_USE_FACTORY == TRUE) && (CH_CFG_USE_MEMPOOLS == TRUE) && (CH_CFG_USE_HEAP == TRUE)) || defined(__DOXYGEN__)
   &oslib_test_sequence_004,
+#endif
+  &oslib_test_sequence_005,
+#if (CH_CFG_USE_MAILBOXES_LOCKFREE) || defined(__DOXYGEN__)
+  &oslib_test_sequence_006,
 #endif
   NULL
 };
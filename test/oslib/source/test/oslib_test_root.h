@@ -28,6 +28,8 @@
 #include "oslib_test_sequence_002.h"
 #include "oslib_test_sequence_003.h"
 #include "oslib_test_sequence_004.h"
+#include "oslib_test_sequence_005.h"
+#include "oslib_test_sequence_006.h"
 
 #if !defined(__DOXYGEN__)
 
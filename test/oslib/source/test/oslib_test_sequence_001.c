@@ -39,6 +39,7 @@
  * - @subpage oslib_test_001_001
  * - @subpage oslib_test_001_002
  * - @subpage oslib_test_001_003
+ * - @subpage oslib_test_001_004
  * .
  */
 
@@ -391,6 +392,109 @@ static const testcase_t oslib_test_001_003 = {
   oslib_test_001_003_execute
 };
 
+/**
+ * @page oslib_test_001_004 [1.4] Mailbox burst transfers
+ *
+ * <h2>Description</h2>
+ * The mailbox burst API is tested for partial transfers, FIFO ordering
+ * and behavior across the buffer wrap point.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] Posting a burst larger than the mailbox, only MB_SIZE
+ *   messages must be accepted.
+ * - [1.4.2] Posting a burst on the full mailbox with an immediate
+ *   timeout, no messages must be accepted.
+ * - [1.4.3] Fetching a burst larger than the mailbox, the posted
+ *   messages must be returned in FIFO order.
+ * - [1.4.4] Fetching a burst from the empty mailbox with an immediate
+ *   timeout, no messages must be returned.
+ * - [1.4.5] Posting and fetching a burst across the buffer wrap point,
+ *   the ordering must be preserved.
+ * .
+ */
+
+static void oslib_test_001_004_setup(void) {
+  chMBObjectInit(&mb1, mb_buffer, MB_SIZE);
+}
+
+static void oslib_test_001_004_teardown(void) {
+  chMBReset(&mb1);
+}
+
+static void oslib_test_001_004_execute(void) {
+  msg_t burst[MB_SIZE + 2];
+  size_t n;
+  unsigned i;
+
+  /* [1.4.1] Posting a burst larger than the mailbox, only MB_SIZE
+     messages must be accepted.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < MB_SIZE + 2; i++) {
+      burst[i] = 'A' + (msg_t)i;
+    }
+    n = chMBPostBurstTimeout(&mb1, burst, MB_SIZE + 2, TIME_IMMEDIATE);
+    test_assert(n == MB_SIZE, "wrong posted count");
+    test_assert_lock(chMBGetFreeCountI(&mb1) == 0, "not full");
+  }
+
+  /* [1.4.2] Posting a burst on the full mailbox with an immediate
+     timeout, no messages must be accepted.*/
+  test_set_step(2);
+  {
+    n = chMBPostBurstTimeout(&mb1, burst, MB_SIZE, TIME_IMMEDIATE);
+    test_assert(n == 0, "messages posted on full mailbox");
+  }
+
+  /* [1.4.3] Fetching a burst larger than the mailbox, the posted
+     messages must be returned in FIFO order.*/
+  test_set_step(3);
+  {
+    n = chMBFetchBurstTimeout(&mb1, burst, MB_SIZE + 2, TIME_IMMEDIATE);
+    test_assert(n == MB_SIZE, "wrong fetched count");
+    for (i = 0; i < MB_SIZE; i++) {
+      test_emit_token(burst[i]);
+    }
+    test_assert_sequence("ABCD", "wrong get sequence");
+  }
+
+  /* [1.4.4] Fetching a burst from the empty mailbox with an immediate
+     timeout, no messages must be returned.*/
+  test_set_step(4);
+  {
+    n = chMBFetchBurstTimeout(&mb1, burst, MB_SIZE, TIME_IMMEDIATE);
+    test_assert(n == 0, "messages fetched from empty mailbox");
+  }
+
+  /* [1.4.5] Posting and fetching a burst across the buffer wrap point,
+     the ordering must be preserved.*/
+  test_set_step(5);
+  {
+    n = chMBPostBurstTimeout(&mb1, burst, 2, TIME_IMMEDIATE);
+    test_assert(n == 2, "wrong posted count");
+    n = chMBFetchBurstTimeout(&mb1, burst, 2, TIME_IMMEDIATE);
+    test_assert(n == 2, "wrong fetched count");
+    for (i = 0; i < MB_SIZE; i++) {
+      burst[i] = 'A' + (msg_t)i;
+    }
+    n = chMBPostBurstTimeout(&mb1, burst, MB_SIZE, TIME_IMMEDIATE);
+    test_assert(n == MB_SIZE, "wrong posted count");
+    n = chMBFetchBurstTimeout(&mb1, burst, MB_SIZE, TIME_IMMEDIATE);
+    test_assert(n == MB_SIZE, "wrong fetched count");
+    for (i = 0; i < MB_SIZE; i++) {
+      test_emit_token(burst[i]);
+    }
+    test_assert_sequence("ABCD", "wrong get sequence");
+  }
+}
+
+static const testcase_t oslib_test_001_004 = {
+  "Mailbox burst transfers",
+  oslib_test_001_004_setup,
+  oslib_test_001_004_teardown,
+  oslib_test_001_004_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -402,6 +506,7 @@ const testcase_t * const oslib_test_sequence_001_array[] = {
   &oslib_test_001_001,
   &oslib_test_001_002,
   &oslib_test_001_003,
+  &oslib_test_001_004,
   NULL
 };
 
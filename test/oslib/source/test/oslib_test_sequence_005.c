@@ -0,0 +1,589 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "oslib_test_root.h"
+
+/**
+ * @file    oslib_test_sequence_005.c
+ * @brief   Test Sequence 005 code.
+ *
+ * @page oslib_test_sequence_005 [5] Benchmarks
+ *
+ * File: @ref oslib_test_sequence_005.c
+ *
+ * <h2>Description</h2>
+ * This module implements a series of benchmarks for the OS library
+ * modules. The benchmarks use fixed workloads so the numbers are
+ * directly comparable between successive releases and across targets,
+ * they allow to discover performance regressions in the allocators and
+ * in the queuing primitives.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage oslib_test_005_001
+ * - @subpage oslib_test_005_002
+ * - @subpage oslib_test_005_003
+ * - @subpage oslib_test_005_004
+ * - @subpage oslib_test_005_005
+ * - @subpage oslib_test_005_006
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define BENCH_MB_SIZE       16
+#define BENCH_POOL_OBJECTS  16
+#define BENCH_HEAP_SIZE     2048
+#define BENCH_ALLOC_SIZE    32
+#define BENCH_PIPE_SIZE     128
+
+#if CH_CFG_USE_MAILBOXES || defined(__DOXYGEN__)
+static msg_t bench_mb_buffer[BENCH_MB_SIZE];
+static MAILBOX_DECL(bench_mb, bench_mb_buffer, BENCH_MB_SIZE);
+#endif
+
+#if CH_CFG_USE_MEMPOOLS || defined(__DOXYGEN__)
+static memory_pool_t bench_pool;
+static stkalign_t bench_pool_buffer[BENCH_POOL_OBJECTS][4];
+#endif
+
+#if CH_CFG_USE_HEAP || defined(__DOXYGEN__)
+static memory_heap_t bench_heap;
+static uint8_t bench_heap_buffer[BENCH_HEAP_SIZE];
+#endif
+
+#if CH_CFG_USE_PIPES || defined(__DOXYGEN__)
+static uint8_t bench_pipe_buffer[BENCH_PIPE_SIZE];
+static PIPE_DECL(bench_pipe, bench_pipe_buffer, BENCH_PIPE_SIZE);
+static uint8_t bench_pipe_data[64];
+#endif
+
+#if CH_CFG_USE_OBJ_FIFOS || defined(__DOXYGEN__)
+static objects_fifo_t bench_fifo;
+static stkalign_t bench_fifo_buffer[BENCH_POOL_OBJECTS][4];
+static msg_t bench_fifo_msgs[BENCH_POOL_OBJECTS];
+#endif
+
+/* Local copy of the tick synchronization helper used by the RT
+   benchmarks, it makes the sequence self-contained.*/
+static systime_t bench_wait_tick(void) {
+
+  chThdSleep(1);
+  return chVTGetSystemTimeX();
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+#if (CH_CFG_USE_MAILBOXES) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_001 [5.1] Mailboxes post/fetch performance
+ *
+ * <h2>Description</h2>
+ * Four messages are posted with @p chMBPostTimeout() and fetched back
+ * with @p chMBFetchTimeout() into a continuous loop, no blocking
+ * happens because the mailbox is never full nor empty at the wrong
+ * time.<br> The performance is calculated by measuring the number of
+ * iterations after a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MAILBOXES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.1.1] Four messages are posted then fetched back. The operation
+ *   is repeated continuously in a one-second time window.
+ * - [5.1.2] The score is printed.
+ * .
+ */
+
+static void oslib_test_005_001_setup(void) {
+  chMBObjectInit(&bench_mb, bench_mb_buffer, BENCH_MB_SIZE);
+}
+
+static void oslib_test_005_001_execute(void) {
+  uint32_t n;
+
+  /* [5.1.1] Four messages are posted then fetched back. The operation
+     is repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    systime_t start, end;
+    msg_t msg;
+
+    n = 0;
+    start = bench_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      (void)chMBPostTimeout(&bench_mb, (msg_t)1, TIME_IMMEDIATE);
+      (void)chMBPostTimeout(&bench_mb, (msg_t)2, TIME_IMMEDIATE);
+      (void)chMBPostTimeout(&bench_mb, (msg_t)3, TIME_IMMEDIATE);
+      (void)chMBPostTimeout(&bench_mb, (msg_t)4, TIME_IMMEDIATE);
+      (void)chMBFetchTimeout(&bench_mb, &msg, TIME_IMMEDIATE);
+      (void)chMBFetchTimeout(&bench_mb, &msg, TIME_IMMEDIATE);
+      (void)chMBFetchTimeout(&bench_mb, &msg, TIME_IMMEDIATE);
+      (void)chMBFetchTimeout(&bench_mb, &msg, TIME_IMMEDIATE);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+
+  /* [5.1.2] The score is printed.*/
+  test_set_step(2);
+  {
+    test_print_score("oslib.mailbox_post_fetch", n * 4, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_001 = {
+  "Mailboxes post/fetch performance",
+  oslib_test_005_001_setup,
+  NULL,
+  oslib_test_005_001_execute
+};
+#endif /* CH_CFG_USE_MAILBOXES */
+
+#if (CH_CFG_USE_MEMPOOLS) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_002 [5.2] Memory Pools alloc/free performance
+ *
+ * <h2>Description</h2>
+ * Four objects are allocated with @p chPoolAlloc() and released with
+ * @p chPoolFree() into a continuous loop, the pool is preloaded and
+ * never exhausted.<br> The performance is calculated by measuring the
+ * number of iterations after a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MEMPOOLS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.2.1] Four objects are allocated then released. The operation is
+ *   repeated continuously in a one-second time window.
+ * - [5.2.2] The score is printed.
+ * .
+ */
+
+static void oslib_test_005_002_setup(void) {
+  chPoolObjectInit(&bench_pool, sizeof (bench_pool_buffer[0]), NULL);
+  chPoolLoadArray(&bench_pool, bench_pool_buffer, BENCH_POOL_OBJECTS);
+}
+
+static void oslib_test_005_002_execute(void) {
+  uint32_t n;
+
+  /* [5.2.1] Four objects are allocated then released. The operation is
+     repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    systime_t start, end;
+    void *p1, *p2, *p3, *p4;
+
+    n = 0;
+    start = bench_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      p1 = chPoolAlloc(&bench_pool);
+      p2 = chPoolAlloc(&bench_pool);
+      p3 = chPoolAlloc(&bench_pool);
+      p4 = chPoolAlloc(&bench_pool);
+      chPoolFree(&bench_pool, p4);
+      chPoolFree(&bench_pool, p3);
+      chPoolFree(&bench_pool, p2);
+      chPoolFree(&bench_pool, p1);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+
+  /* [5.2.2] The score is printed.*/
+  test_set_step(2);
+  {
+    test_print_score("oslib.pool_alloc_free", n * 4, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_002 = {
+  "Memory Pools alloc/free performance",
+  oslib_test_005_002_setup,
+  NULL,
+  oslib_test_005_002_execute
+};
+#endif /* CH_CFG_USE_MEMPOOLS */
+
+#if (CH_CFG_USE_HEAP) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_003 [5.3] Heap alloc/free performance, empty heap
+ *
+ * <h2>Description</h2>
+ * A fixed size block is allocated with @p chHeapAlloc() and released
+ * with @p chHeapFree() into a continuous loop, the private heap
+ * contains a single free block so the allocator always succeeds on the
+ * first fit.<br> The performance is calculated by measuring the number
+ * of iterations after a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_HEAP
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.3.1] A block is allocated then released. The operation is
+ *   repeated continuously in a one-second time window.
+ * - [5.3.2] The score is printed.
+ * .
+ */
+
+static void oslib_test_005_003_setup(void) {
+  chHeapObjectInit(&bench_heap, bench_heap_buffer, BENCH_HEAP_SIZE);
+}
+
+static void oslib_test_005_003_execute(void) {
+  uint32_t n;
+
+  /* [5.3.1] A block is allocated then released. The operation is
+     repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    systime_t start, end;
+    void *p;
+
+    n = 0;
+    start = bench_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      p = chHeapAlloc(&bench_heap, BENCH_ALLOC_SIZE);
+      chHeapFree(p);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+
+  /* [5.3.2] The score is printed.*/
+  test_set_step(2);
+  {
+    test_print_score("oslib.heap_alloc_free_empty", n, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_003 = {
+  "Heap alloc/free performance, empty heap",
+  oslib_test_005_003_setup,
+  NULL,
+  oslib_test_005_003_execute
+};
+#endif /* CH_CFG_USE_HEAP */
+
+#if (CH_CFG_USE_HEAP) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_004 [5.4] Heap alloc/free performance, fragmented heap
+ *
+ * <h2>Description</h2>
+ * The private heap is artificially fragmented by allocating sixteen
+ * blocks and releasing every other one, then a fixed size block is
+ * allocated and released into a continuous loop. The measure exposes
+ * the free list walking cost of the allocator under fragmentation.<br>
+ * The performance is calculated by measuring the number of iterations
+ * after a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_HEAP
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.4.1] The heap is fragmented, sixteen blocks are allocated then
+ *   every other one is released leaving eight non-contiguous holes.
+ * - [5.4.2] A block is allocated then released. The operation is
+ *   repeated continuously in a one-second time window.
+ * - [5.4.3] The surviving blocks are released.
+ * - [5.4.4] The score is printed.
+ * .
+ */
+
+static void oslib_test_005_004_setup(void) {
+  chHeapObjectInit(&bench_heap, bench_heap_buffer, BENCH_HEAP_SIZE);
+}
+
+static void oslib_test_005_004_execute(void) {
+  void *blocks[16];
+  uint32_t n;
+  unsigned i;
+
+  /* [5.4.1] The heap is fragmented, sixteen blocks are allocated then
+     every other one is released leaving eight non-contiguous holes.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < 16; i++) {
+      blocks[i] = chHeapAlloc(&bench_heap, BENCH_ALLOC_SIZE);
+      test_assert(blocks[i] != NULL, "allocation failed");
+    }
+    for (i = 1; i < 16; i += 2) {
+      chHeapFree(blocks[i]);
+    }
+  }
+
+  /* [5.4.2] A block is allocated then released. The operation is
+     repeated continuously in a one-second time window.*/
+  test_set_step(2);
+  {
+    systime_t start, end;
+    void *p;
+
+    n = 0;
+    start = bench_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      p = chHeapAlloc(&bench_heap, BENCH_ALLOC_SIZE);
+      chHeapFree(p);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+
+  /* [5.4.3] The surviving blocks are released.*/
+  test_set_step(3);
+  {
+    for (i = 0; i < 16; i += 2) {
+      chHeapFree(blocks[i]);
+    }
+  }
+
+  /* [5.4.4] The score is printed.*/
+  test_set_step(4);
+  {
+    test_print_score("oslib.heap_alloc_free_fragmented", n, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_004 = {
+  "Heap alloc/free performance, fragmented heap",
+  oslib_test_005_004_setup,
+  NULL,
+  oslib_test_005_004_execute
+};
+#endif /* CH_CFG_USE_HEAP */
+
+#if (CH_CFG_USE_PIPES) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_005 [5.5] Pipes write/read performance
+ *
+ * <h2>Description</h2>
+ * Blocks of 4, 16 and 64 bytes are written with @p chPipeWriteTimeout()
+ * and read back with @p chPipeReadTimeout() into continuous loops, one
+ * one-second time window is measured for each size so the per-byte and
+ * per-call costs can be separated.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_PIPES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.5.1] 4 bytes blocks are written and read back continuously in a
+ *   one-second time window, the score is printed.
+ * - [5.5.2] 16 bytes blocks are written and read back continuously in
+ *   a one-second time window, the score is printed.
+ * - [5.5.3] 64 bytes blocks are written and read back continuously in
+ *   a one-second time window, the score is printed.
+ * .
+ */
+
+static void oslib_test_005_005_setup(void) {
+  chPipeObjectInit(&bench_pipe, bench_pipe_buffer, BENCH_PIPE_SIZE);
+}
+
+static uint32_t pipe_bench(size_t size) {
+  systime_t start, end;
+  uint32_t n;
+
+  n = 0;
+  start = bench_wait_tick();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    (void)chPipeWriteTimeout(&bench_pipe, bench_pipe_data,
+                             size, TIME_IMMEDIATE);
+    (void)chPipeReadTimeout(&bench_pipe, bench_pipe_data,
+                            size, TIME_IMMEDIATE);
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+static void oslib_test_005_005_execute(void) {
+  uint32_t n;
+
+  /* [5.5.1] 4 bytes blocks are written and read back continuously in a
+     one-second time window, the score is printed.*/
+  test_set_step(1);
+  {
+    n = pipe_bench(4);
+    test_print_score("oslib.pipe_4", n, "ops/S");
+  }
+
+  /* [5.5.2] 16 bytes blocks are written and read back continuously in
+     a one-second time window, the score is printed.*/
+  test_set_step(2);
+  {
+    n = pipe_bench(16);
+    test_print_score("oslib.pipe_16", n, "ops/S");
+  }
+
+  /* [5.5.3] 64 bytes blocks are written and read back continuously in
+     a one-second time window, the score is printed.*/
+  test_set_step(3);
+  {
+    n = pipe_bench(64);
+    test_print_score("oslib.pipe_64", n, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_005 = {
+  "Pipes write/read performance",
+  oslib_test_005_005_setup,
+  NULL,
+  oslib_test_005_005_execute
+};
+#endif /* CH_CFG_USE_PIPES */
+
+#if (CH_CFG_USE_OBJ_FIFOS) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_005_006 [5.6] Objects FIFO round trip performance
+ *
+ * <h2>Description</h2>
+ * An object is taken from the FIFO free list, sent with
+ * @p chFifoSendObject(), received back and returned into a continuous
+ * loop, covering the full producer/consumer round trip in a single
+ * thread.<br> The performance is calculated by measuring the number of
+ * iterations after a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_OBJ_FIFOS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.6.1] An object is taken, sent, received and returned. The
+ *   operation is repeated continuously in a one-second time window.
+ * - [5.6.2] The score is printed.
+ * .
+ */
+
+static void oslib_test_005_006_setup(void) {
+  chFifoObjectInit(&bench_fifo, sizeof (bench_fifo_buffer[0]),
+                   BENCH_POOL_OBJECTS, PORT_NATURAL_ALIGN,
+                   bench_fifo_buffer, bench_fifo_msgs);
+}
+
+static void oslib_test_005_006_execute(void) {
+  uint32_t n;
+
+  /* [5.6.1] An object is taken, sent, received and returned. The
+     operation is repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    systime_t start, end;
+    void *p;
+
+    n = 0;
+    start = bench_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      p = chFifoTakeObjectTimeout(&bench_fifo, TIME_IMMEDIATE);
+      chFifoSendObject(&bench_fifo, p);
+      (void)chFifoReceiveObjectTimeout(&bench_fifo, &p, TIME_IMMEDIATE);
+      chFifoReturnObject(&bench_fifo, p);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+
+  /* [5.6.2] The score is printed.*/
+  test_set_step(2);
+  {
+    test_print_score("oslib.fifo_round_trip", n, "ops/S");
+  }
+}
+
+static const testcase_t oslib_test_005_006 = {
+  "Objects FIFO round trip performance",
+  oslib_test_005_006_setup,
+  NULL,
+  oslib_test_005_006_execute
+};
+#endif /* CH_CFG_USE_OBJ_FIFOS */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const oslib_test_sequence_005_array[] = {
+#if (CH_CFG_USE_MAILBOXES) || defined(__DOXYGEN__)
+  &oslib_test_005_001,
+#endif
+#if (CH_CFG_USE_MEMPOOLS) || defined(__DOXYGEN__)
+  &oslib_test_005_002,
+#endif
+#if (CH_CFG_USE_HEAP) || defined(__DOXYGEN__)
+  &oslib_test_005_003,
+#endif
+#if (CH_CFG_USE_HEAP) || defined(__DOXYGEN__)
+  &oslib_test_005_004,
+#endif
+#if (CH_CFG_USE_PIPES) || defined(__DOXYGEN__)
+  &oslib_test_005_005,
+#endif
+#if (CH_CFG_USE_OBJ_FIFOS) || defined(__DOXYGEN__)
+  &oslib_test_005_006,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t oslib_test_sequence_005 = {
+  "Benchmarks",
+  oslib_test_sequence_005_array
+};
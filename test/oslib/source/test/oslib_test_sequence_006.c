@@ -0,0 +1,220 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "oslib_test_root.h"
+
+/**
+ * @file    oslib_test_sequence_006.c
+ * @brief   Test Sequence 006 code.
+ *
+ * @page oslib_test_sequence_006 [6] Lock-free Mailboxes
+ *
+ * File: @ref oslib_test_sequence_006.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the ChibiOS library functionalities related to
+ * lock-free mailboxes.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MAILBOXES_LOCKFREE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage oslib_test_006_001
+ * - @subpage oslib_test_006_002
+ * .
+ */
+
+#if (CH_CFG_USE_MAILBOXES_LOCKFREE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define ALLOWED_DELAY TIME_MS2I(2)
+
+#define LFMB_SIZE 4
+
+static lf_mbslot_t lfmb_buffer[LFMB_SIZE];
+static lf_mailbox_t lfmb1;
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page oslib_test_006_001 [6.1] Non-blocking posts and fetches
+ *
+ * <h2>Description</h2>
+ * The X-class variants are exercised from a single context, the test
+ * expects FIFO ordering, a full indication on the post in excess and
+ * an empty indication on the fetch in excess, over multiple buffer
+ * laps.
+ *
+ * <h2>Test Steps</h2>
+ * - [6.1.1] Filling the mailbox, all posts must succeed, the post in
+ *   excess must fail.
+ * - [6.1.2] Draining the mailbox, the messages must be fetched in FIFO
+ *   order, the fetch in excess must fail.
+ * - [6.1.3] Repeating the cycle to verify the slot sequence across a
+ *   buffer lap.
+ * .
+ */
+
+static void oslib_test_006_001_setup(void) {
+  chLFMBObjectInit(&lfmb1, lfmb_buffer, LFMB_SIZE);
+}
+
+static void oslib_test_006_001_execute(void) {
+  msg_t msg1, msg2;
+  unsigned i;
+
+  /* [6.1.1] Filling the mailbox, all posts must succeed, the post in
+     excess must fail.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < LFMB_SIZE; i++) {
+      msg1 = chLFMBPostX(&lfmb1, 'B' + (msg_t)i);
+      test_assert(msg1 == MSG_OK, "wrong post status");
+    }
+    msg1 = chLFMBPostX(&lfmb1, 'Z');
+    test_assert(msg1 == MSG_TIMEOUT, "post not failed on full");
+  }
+
+  /* [6.1.2] Draining the mailbox, the messages must be fetched in FIFO
+     order, the fetch in excess must fail.*/
+  test_set_step(2);
+  {
+    for (i = 0; i < LFMB_SIZE; i++) {
+      msg1 = chLFMBFetchX(&lfmb1, &msg2);
+      test_assert(msg1 == MSG_OK, "wrong fetch status");
+      test_assert(msg2 == 'B' + (msg_t)i, "wrong message");
+    }
+    msg1 = chLFMBFetchX(&lfmb1, &msg2);
+    test_assert(msg1 == MSG_TIMEOUT, "fetch not failed on empty");
+  }
+
+  /* [6.1.3] Repeating the cycle to verify the slot sequence across a
+     buffer lap.*/
+  test_set_step(3);
+  {
+    for (i = 0; i < LFMB_SIZE * 2; i++) {
+      msg1 = chLFMBPostX(&lfmb1, (msg_t)i);
+      test_assert(msg1 == MSG_OK, "wrong post status");
+      msg1 = chLFMBFetchX(&lfmb1, &msg2);
+      test_assert(msg1 == MSG_OK, "wrong fetch status");
+      test_assert(msg2 == (msg_t)i, "wrong message");
+    }
+  }
+}
+
+static const testcase_t oslib_test_006_001 = {
+  "Non-blocking posts and fetches",
+  oslib_test_006_001_setup,
+  NULL,
+  oslib_test_006_001_execute
+};
+
+/**
+ * @page oslib_test_006_002 [6.2] Blocking variants timeouts
+ *
+ * <h2>Description</h2>
+ * The blocking variants are exercised on full and empty mailboxes, the
+ * test expects the timeouts to expire within the allowed windows.
+ *
+ * <h2>Test Steps</h2>
+ * - [6.2.1] Filling the mailbox then posting with a 100mS timeout, the
+ *   operation must time out within the expected window.
+ * - [6.2.2] Draining the mailbox then fetching with a 100mS timeout,
+ *   the operation must time out within the expected window.
+ * .
+ */
+
+static void oslib_test_006_002_setup(void) {
+  chLFMBObjectInit(&lfmb1, lfmb_buffer, LFMB_SIZE);
+}
+
+static void oslib_test_006_002_execute(void) {
+  msg_t msg1, msg2;
+  systime_t time;
+  unsigned i;
+
+  /* [6.2.1] Filling the mailbox then posting with a 100mS timeout, the
+     operation must time out within the expected window.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < LFMB_SIZE; i++) {
+      msg1 = chLFMBPostTimeout(&lfmb1, (msg_t)i, TIME_INFINITE);
+      test_assert(msg1 == MSG_OK, "wrong post status");
+    }
+    time = chVTGetSystemTime();
+    msg1 = chLFMBPostTimeout(&lfmb1, 'Z', TIME_MS2I(100));
+    test_assert(msg1 == MSG_TIMEOUT, "post not timed out");
+    test_assert_time_window(chTimeAddX(time, TIME_MS2I(100)),
+                            chTimeAddX(time, TIME_MS2I(100) + ALLOWED_DELAY),
+                            "out of time window");
+  }
+
+  /* [6.2.2] Draining the mailbox then fetching with a 100mS timeout,
+     the operation must time out within the expected window.*/
+  test_set_step(2);
+  {
+    for (i = 0; i < LFMB_SIZE; i++) {
+      msg1 = chLFMBFetchTimeout(&lfmb1, &msg2, TIME_INFINITE);
+      test_assert(msg1 == MSG_OK, "wrong fetch status");
+      test_assert(msg2 == (msg_t)i, "wrong message");
+    }
+    time = chVTGetSystemTime();
+    msg1 = chLFMBFetchTimeout(&lfmb1, &msg2, TIME_MS2I(100));
+    test_assert(msg1 == MSG_TIMEOUT, "fetch not timed out");
+    test_assert_time_window(chTimeAddX(time, TIME_MS2I(100)),
+                            chTimeAddX(time, TIME_MS2I(100) + ALLOWED_DELAY),
+                            "out of time window");
+  }
+}
+
+static const testcase_t oslib_test_006_002 = {
+  "Blocking variants timeouts",
+  oslib_test_006_002_setup,
+  NULL,
+  oslib_test_006_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const oslib_test_sequence_006_array[] = {
+  &oslib_test_006_001,
+  &oslib_test_006_002,
+  NULL
+};
+
+/**
+ * @brief   Lock-free Mailboxes.
+ */
+const testsequence_t oslib_test_sequence_006 = {
+  "Lock-free Mailboxes",
+  oslib_test_sequence_006_array
+};
+
+#endif /* CH_CFG_USE_MAILBOXES_LOCKFREE */
@@ -0,0 +1,6 @@
+# List of the ChibiOS/RT kernel micro-benchmark files.
+TESTSRC += ${CHIBIOS}/test/rt/source/bmk/rt_bmk.c \
+           ${CHIBIOS}/test/rt/source/bmk/rt_port_bmk.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/rt/source/bmk
@@ -0,0 +1,345 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    rt_bmk.c
+ * @brief   Kernel micro-benchmarks code.
+ *
+ * @addtogroup rt_bmk
+ * @details This module implements a set of cycle-accurate kernel
+ *          micro-benchmarks based on the time measurement subsystem. Unlike
+ *          the benchmarks in the test suite, which express throughput over
+ *          a fixed time window, these measurements are taken with the
+ *          realtime counter around single kernel operations and are meant
+ *          to track regressions across releases on real boards.
+ *          Results are emitted on the specified stream as comma-separated
+ *          records in the form:
+ *
+ *          RTBMK,&lt;name&gt;,&lt;param&gt;,&lt;n&gt;,&lt;best&gt;,&lt;avg&gt;,&lt;worst&gt;
+ *
+ *          where the measurements are expressed in realtime counter cycles.
+ * @{
+ */
+
+#include "hal.h"
+#include "rt_bmk.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*
+ * Working area size of benchmark threads.
+ */
+#define BMK_WA_SIZE MEM_ALIGN_NEXT(THD_WORKING_AREA_SIZE(128),              \
+                                   PORT_WORKING_AREA_ALIGN)
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*
+ * Buffer holding the working areas of the benchmark threads, the last
+ * area is reserved for the context switch helper thread.
+ */
+static ALIGNED_VAR(PORT_WORKING_AREA_ALIGN)
+  uint8_t bmk_buffer[BMK_WA_SIZE * (RT_BMK_MAX_DEPTH + 1)];
+
+/*
+ * Pointers to the spawned benchmark threads.
+ */
+static thread_t *bmk_threads[RT_BMK_MAX_DEPTH];
+
+/*
+ * Background and probe virtual timers.
+ */
+static virtual_timer_t bmk_timers[RT_BMK_MAX_TIMERS];
+static virtual_timer_t bmk_probe;
+
+/*
+ * Reference used by the context switch helper thread.
+ */
+static thread_reference_t bmk_ref;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*
+ * Prints a string on the benchmark stream, shared with the port-level
+ * benchmark module.
+ */
+void rt_bmk_print(BaseSequentialStream *chp, const char *msgp) {
+
+  while (*msgp != '\0') {
+    streamPut(chp, (uint8_t)*msgp++);
+  }
+}
+
+/*
+ * Prints a decimal unsigned number on the benchmark stream, shared with
+ * the port-level benchmark module.
+ */
+void rt_bmk_printn(BaseSequentialStream *chp, uint32_t n) {
+  char buf[16], *p;
+
+  if (n == 0U) {
+    streamPut(chp, (uint8_t)'0');
+  }
+  else {
+    p = buf;
+    while (n != 0U) {
+      *p++ = (char)('0' + (n % 10U));
+      n /= 10U;
+    }
+    while (p > buf) {
+      streamPut(chp, (uint8_t)*--p);
+    }
+  }
+}
+
+/*
+ * Emits a measurement record on the benchmark stream.
+ */
+static void bmk_emit(BaseSequentialStream *chp, const char *name,
+                     uint32_t param, const time_measurement_t *tmp) {
+
+  rt_bmk_print(chp, "RTBMK,");
+  rt_bmk_print(chp, name);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, param);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->n);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->best);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)(tmp->cumulative / (rttime_t)tmp->n));
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->worst);
+  rt_bmk_print(chp, "\r\n");
+}
+
+/*
+ * Benchmark thread, exits immediately.
+ */
+static THD_FUNCTION(bmk_minimal_thread, p) {
+
+  (void)p;
+}
+
+/*
+ * Context switch helper thread, suspends itself in a loop.
+ */
+static THD_FUNCTION(bmk_switch_thread, p) {
+
+  (void)p;
+  while (!chThdShouldTerminateX()) {
+    chSysLock();
+    (void) chThdSuspendS(&bmk_ref);
+    chSysUnlock();
+  }
+}
+
+/*
+ * Empty virtual timer callback.
+ */
+static void bmk_tmo(void *p) {
+
+  (void)p;
+}
+
+/*
+ * Measures the ready list insertion cost at increasing ready list depths.
+ * Threads are created suspended with descending priorities then made ready
+ * one by one, the i-th insertion is performed with i higher priority
+ * threads already in the ready list which is the worst case for the
+ * priority-ordered scan.
+ */
+static void bmk_sched_ready(BaseSequentialStream *chp) {
+  static time_measurement_t tm[RT_BMK_MAX_DEPTH];
+  tprio_t base = chThdGetPriorityX() - (tprio_t)1;
+  unsigned i, round;
+
+  for (i = 0U; i < RT_BMK_MAX_DEPTH; i++) {
+    chTMObjectInit(&tm[i]);
+  }
+
+  for (round = 0U; round < (RT_BMK_ITERATIONS / 10U); round++) {
+    for (i = 0U; i < RT_BMK_MAX_DEPTH; i++) {
+      thread_descriptor_t td = {
+        "bmk_ready",
+        (stkalign_t *)&bmk_buffer[BMK_WA_SIZE * i],
+        (stkalign_t *)&bmk_buffer[BMK_WA_SIZE * (i + 1U)],
+        base - (tprio_t)i,
+        bmk_minimal_thread,
+        NULL
+      };
+
+      bmk_threads[i] = chThdCreateSuspended(&td);
+      chSysLock();
+      chTMStartMeasurementX(&tm[i]);
+      (void) chThdStartI(bmk_threads[i]);
+      chTMStopMeasurementX(&tm[i]);
+      chSysUnlock();
+    }
+
+    /* The threads exit as soon as they are scheduled.*/
+    for (i = 0U; i < RT_BMK_MAX_DEPTH; i++) {
+      (void) chThdWait(bmk_threads[i]);
+    }
+  }
+
+  for (i = 0U; i < RT_BMK_MAX_DEPTH; i++) {
+    bmk_emit(chp, "sched_ready", (uint32_t)i, &tm[i]);
+  }
+}
+
+/*
+ * Measures the timer arming cost with an increasing number of timers
+ * already active.
+ */
+static void bmk_vt_set(BaseSequentialStream *chp) {
+  static const unsigned counts[] = {0U, RT_BMK_MAX_TIMERS / 4U,
+                                    RT_BMK_MAX_TIMERS};
+  unsigned i, j, k;
+
+  for (i = 0U; i < (sizeof counts / sizeof counts[0]); i++) {
+    static time_measurement_t tm;
+    unsigned n = counts[i];
+
+    /* Arming the background timers with spread deadlines far enough not
+       to expire during the measurement.*/
+    for (j = 0U; j < n; j++) {
+      chVTSet(&bmk_timers[j], (sysinterval_t)(0x4000U + (j * 97U)),
+              bmk_tmo, NULL);
+    }
+
+    chTMObjectInit(&tm);
+    for (k = 0U; k < RT_BMK_ITERATIONS; k++) {
+      chSysLock();
+      chTMStartMeasurementX(&tm);
+      chVTDoSetI(&bmk_probe, (sysinterval_t)(0x1000U + ((k * 37U) & 0x3FFU)),
+                 bmk_tmo, NULL);
+      chTMStopMeasurementX(&tm);
+      chVTDoResetI(&bmk_probe);
+      chSysUnlock();
+    }
+
+    for (j = 0U; j < n; j++) {
+      chVTReset(&bmk_timers[j]);
+    }
+
+    bmk_emit(chp, "vt_set", (uint32_t)n, &tm);
+  }
+}
+
+/*
+ * Measures the full context switch round trip by resuming a higher
+ * priority thread which immediately suspends itself again, each sample
+ * includes two context switches.
+ */
+static void bmk_ctx_switch(BaseSequentialStream *chp) {
+  static time_measurement_t tm;
+  thread_descriptor_t td = {
+    "bmk_switch",
+    (stkalign_t *)&bmk_buffer[BMK_WA_SIZE * RT_BMK_MAX_DEPTH],
+    (stkalign_t *)&bmk_buffer[BMK_WA_SIZE * (RT_BMK_MAX_DEPTH + 1U)],
+    chThdGetPriorityX() + (tprio_t)1,
+    bmk_switch_thread,
+    NULL
+  };
+  thread_t *tp;
+  unsigned k;
+
+  bmk_ref = NULL;
+  tp = chThdCreate(&td);
+
+  chTMObjectInit(&tm);
+  for (k = 0U; k < RT_BMK_ITERATIONS; k++) {
+    chSysLock();
+    chTMStartMeasurementX(&tm);
+    chThdResumeS(&bmk_ref, MSG_OK);
+    chTMStopMeasurementX(&tm);
+    chSysUnlock();
+  }
+
+  chThdTerminate(tp);
+  chThdResume(&bmk_ref, MSG_OK);
+  (void) chThdWait(tp);
+
+  bmk_emit(chp, "ctx_rtrip", 2U, &tm);
+}
+
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+/*
+ * Measures an uncontended mutex lock/unlock pair.
+ */
+static void bmk_mutex(BaseSequentialStream *chp) {
+  static time_measurement_t tm;
+  static mutex_t mtx;
+  unsigned k;
+
+  chMtxObjectInit(&mtx);
+  chTMObjectInit(&tm);
+  for (k = 0U; k < RT_BMK_ITERATIONS; k++) {
+    chTMStartMeasurementX(&tm);
+    chMtxLock(&mtx);
+    chMtxUnlock(&mtx);
+    chTMStopMeasurementX(&tm);
+  }
+
+  bmk_emit(chp, "mutex_pair", 0U, &tm);
+}
+#endif /* CH_CFG_USE_MUTEXES == TRUE */
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Executes the kernel micro-benchmarks.
+ * @details All the measurements are emitted on the specified stream as
+ *          machine-readable CSV records expressed in realtime counter
+ *          cycles.
+ * @pre     The invoking thread priority must leave at least
+ *          @p RT_BMK_MAX_DEPTH free priority levels below itself and one
+ *          free level above itself.
+ * @note    Measurements are affected by interrupts occurring during the
+ *          sampled operations, the best field is the most stable indicator.
+ *
+ * @param[in] chp       pointer to the stream used for the report
+ *
+ * @api
+ */
+void rt_bmk_execute(BaseSequentialStream *chp) {
+
+  rt_bmk_print(chp, "RTBMK,begin,");
+  rt_bmk_print(chp, CH_KERNEL_VERSION);
+  rt_bmk_print(chp, ",");
+  rt_bmk_print(chp, PORT_INFO);
+  rt_bmk_print(chp, "\r\n");
+
+  bmk_sched_ready(chp);
+  bmk_vt_set(chp);
+  bmk_ctx_switch(chp);
+#if CH_CFG_USE_MUTEXES == TRUE
+  bmk_mutex(chp);
+#endif
+
+  rt_bmk_print(chp, "RTBMK,end\r\n");
+}
+
+/** @} */
@@ -0,0 +1,97 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    rt_bmk.h
+ * @brief   Kernel micro-benchmarks header.
+ *
+ * @addtogroup rt_bmk
+ * @{
+ */
+
+#ifndef RT_BMK_H
+#define RT_BMK_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of samples taken for each measurement.
+ */
+#if !defined(RT_BMK_ITERATIONS) || defined(__DOXYGEN__)
+#define RT_BMK_ITERATIONS                   1000
+#endif
+
+/**
+ * @brief   Maximum ready list depth exercised by the scheduler benchmark.
+ */
+#if !defined(RT_BMK_MAX_DEPTH) || defined(__DOXYGEN__)
+#define RT_BMK_MAX_DEPTH                    8
+#endif
+
+/**
+ * @brief   Maximum number of background timers armed by the timers benchmark.
+ */
+#if !defined(RT_BMK_MAX_TIMERS) || defined(__DOXYGEN__)
+#define RT_BMK_MAX_TIMERS                   32
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_TM == FALSE
+#error "rt_bmk requires CH_CFG_USE_TM"
+#endif
+
+#if CH_CFG_USE_WAITEXIT == FALSE
+#error "rt_bmk requires CH_CFG_USE_WAITEXIT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void rt_bmk_print(BaseSequentialStream *chp, const char *msgp);
+  void rt_bmk_printn(BaseSequentialStream *chp, uint32_t n);
+  void rt_bmk_execute(BaseSequentialStream *chp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* RT_BMK_H */
+
+/** @} */
@@ -0,0 +1,189 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    rt_port_bmk.c
+ * @brief   Port-level micro-benchmarks code.
+ *
+ * @addtogroup rt_port_bmk
+ * @details This module decomposes the context switch latency into its
+ *          port-level phases using the realtime counter. Results are
+ *          emitted on the specified stream as comma-separated records in
+ *          the form:
+ *
+ *          PORTBMK,&lt;name&gt;,&lt;n&gt;,&lt;best&gt;,&lt;avg&gt;,&lt;worst&gt;
+ *
+ *          where the measurements are expressed in realtime counter
+ *          cycles. The emitted phases are:
+ *          - switch_body, the pure register save/restore cost measured by
+ *            switching the current thread context onto itself, no
+ *            scheduler activity is included.
+ *          - yield_rtrip, a full yield round trip between two threads at
+ *            the same priority, each sample contains two ready-queue
+ *            insertions, two scheduler picks and two switch bodies. The
+ *            pick cost can so be derived as half the round trip minus the
+ *            switch body.
+ *
+ *          On ports compiled with @p PORT_IRQ_INSTRUMENTATION the last
+ *          and worst-case IRQ epilogue durations are also reported as a
+ *          PORTBMK,irq_epilogue record.
+ * @{
+ */
+
+#include "hal.h"
+#include "rt_port_bmk.h"
+
+#if (PORT_SUPPORTS_RT == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*
+ * Working area of the yield benchmark partner thread.
+ */
+static THD_WORKING_AREA(pbmk_wa, 128);
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*
+ * Emits a measurement record on the benchmark stream.
+ */
+static void pbmk_emit(BaseSequentialStream *chp, const char *name,
+                      const time_measurement_t *tmp) {
+
+  rt_bmk_print(chp, "PORTBMK,");
+  rt_bmk_print(chp, name);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->n);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->best);
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)(tmp->cumulative / (rttime_t)tmp->n));
+  streamPut(chp, (uint8_t)',');
+  rt_bmk_printn(chp, (uint32_t)tmp->worst);
+  rt_bmk_print(chp, "\r\n");
+}
+
+/*
+ * Yield benchmark partner thread, returns the CPU in a loop.
+ */
+static THD_FUNCTION(pbmk_yield_thread, p) {
+
+  (void)p;
+  while (!chThdShouldTerminateX()) {
+    chThdYield();
+  }
+}
+
+/*
+ * Measures the pure context save/restore cost by switching the current
+ * thread context onto itself, the scheduler is not involved.
+ */
+static void pbmk_switch_body(BaseSequentialStream *chp) {
+  static time_measurement_t tm;
+  unsigned k;
+
+  chTMObjectInit(&tm);
+  for (k = 0U; k < RT_BMK_ITERATIONS; k++) {
+    chSysLock();
+    chTMStartMeasurementX(&tm);
+    port_switch(chThdGetSelfX(), chThdGetSelfX());
+    chTMStopMeasurementX(&tm);
+    chSysUnlock();
+  }
+
+  pbmk_emit(chp, "switch_body", &tm);
+}
+
+/*
+ * Measures a full yield round trip between two threads at the same
+ * priority, each sample includes two complete context switches.
+ */
+static void pbmk_yield_rtrip(BaseSequentialStream *chp) {
+  static time_measurement_t tm;
+  thread_t *tp;
+  unsigned k;
+
+  tp = chThdCreateStatic(pbmk_wa, sizeof pbmk_wa, chThdGetPriorityX(),
+                         pbmk_yield_thread, NULL);
+
+  chTMObjectInit(&tm);
+  for (k = 0U; k < RT_BMK_ITERATIONS; k++) {
+    chTMStartMeasurementX(&tm);
+    chThdYield();
+    chTMStopMeasurementX(&tm);
+  }
+
+  chThdTerminate(tp);
+  chThdYield();
+  (void) chThdWait(tp);
+
+  pbmk_emit(chp, "yield_rtrip", &tm);
+}
+
+#endif /* PORT_SUPPORTS_RT == TRUE */
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Executes the port-level micro-benchmarks.
+ * @details All the measurements are emitted on the specified stream as
+ *          machine-readable CSV records expressed in realtime counter
+ *          cycles, the begin record carries the architecture and core
+ *          variant names so reports from different ports can be compared.
+ * @pre     The invoking thread priority must leave one free priority
+ *          level above itself.
+ * @note    On ports without a realtime counter only a record marking the
+ *          port as unsupported is emitted.
+ *
+ * @param[in] chp       pointer to the stream used for the report
+ *
+ * @api
+ */
+void rt_port_bmk_execute(BaseSequentialStream *chp) {
+
+  rt_bmk_print(chp, "PORTBMK,begin,");
+  rt_bmk_print(chp, PORT_ARCHITECTURE_NAME);
+  rt_bmk_print(chp, ",");
+  rt_bmk_print(chp, PORT_CORE_VARIANT_NAME);
+  rt_bmk_print(chp, ",");
+  rt_bmk_print(chp, PORT_INFO);
+  rt_bmk_print(chp, "\r\n");
+
+#if PORT_SUPPORTS_RT == TRUE
+  pbmk_switch_body(chp);
+  pbmk_yield_rtrip(chp);
+
+#if defined(PORT_IRQ_INSTRUMENTATION) && (PORT_IRQ_INSTRUMENTATION == TRUE)
+  rt_bmk_print(chp, "PORTBMK,irq_epilogue,");
+  rt_bmk_printn(chp, (uint32_t)port_get_irq_epilogue_last());
+  rt_bmk_print(chp, ",");
+  rt_bmk_printn(chp, (uint32_t)port_get_irq_epilogue_worst());
+  rt_bmk_print(chp, "\r\n");
+#endif
+#else /* PORT_SUPPORTS_RT == FALSE */
+  rt_bmk_print(chp, "PORTBMK,unsupported\r\n");
+#endif /* PORT_SUPPORTS_RT == FALSE */
+
+  rt_bmk_print(chp, "PORTBMK,end\r\n");
+}
+
+/** @} */
@@ -31,6 +31,9 @@
  * - @subpage rt_test_sequence_008
  * - @subpage rt_test_sequence_009
  * - @subpage rt_test_sequence_010
+ * - @subpage rt_test_sequence_011
+ * - @subpage rt_test_sequence_012
+ * - @subpage rt_test_sequence_013
  * .
  */
 
@@ -72,6 +75,13 @@ const testsequence_t * const rt_test_suite_array[] = {
   &rt_test_sequence_009,
 #endif
   &rt_test_sequence_010,
+  &rt_test_sequence_011,
+#if (CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+  &rt_test_sequence_012,
+#endif
+#if (CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+  &rt_test_sequence_013,
+#endif
   NULL
 };
 
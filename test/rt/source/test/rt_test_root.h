@@ -34,6 +34,9 @@
 #include "rt_test_sequence_008.h"
 #include "rt_test_sequence_009.h"
 #include "rt_test_sequence_010.h"
+#include "rt_test_sequence_011.h"
+#include "rt_test_sequence_012.h"
+#include "rt_test_sequence_013.h"
 
 #if !defined(__DOXYGEN__)
 
@@ -42,6 +42,7 @@
  * - @subpage rt_test_005_004
  * - @subpage rt_test_005_005
  * - @subpage rt_test_005_006
+ * - @subpage rt_test_005_007
  * .
  */
 
@@ -488,6 +489,69 @@ static const testcase_t rt_test_005_006 = {
   rt_test_005_006_execute
 };
 
+/**
+ * @page rt_test_005_007 [5.7] Testing chSemSignalN() functionality
+ *
+ * <h2>Description</h2>
+ * Four threads are enqueued to a semaphore then awakened in two batches
+ * using chSemSignalN(). The test expects each call to wake exactly the
+ * specified number of threads within a single rescheduling point.
+ *
+ * <h2>Test Steps</h2>
+ * - [5.7.1] Four threads are created with decreasing priority levels,
+ *   all higher than the tester. Threads enqueue on a semaphore
+ *   initialized to zero.
+ * - [5.7.2] The semaphore is signaled by two, the first two threads
+ *   must terminate and the counter must still account for two waiters.
+ * - [5.7.3] The semaphore is signaled by two again, the remaining
+ *   threads must terminate and the counter must return to zero.
+ * .
+ */
+
+static void rt_test_005_007_setup(void) {
+  chSemObjectInit(&sem1, 0);
+}
+
+static void rt_test_005_007_execute(void) {
+
+  /* [5.7.1] Four threads are created with decreasing priority levels,
+     all higher than the tester. Threads enqueue on a semaphore
+     initialized to zero.*/
+  test_set_step(1);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()+4, thread1, "A");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, chThdGetPriorityX()+3, thread1, "B");
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, chThdGetPriorityX()+2, thread1, "C");
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, chThdGetPriorityX()+1, thread1, "D");
+  }
+
+  /* [5.7.2] The semaphore is signaled by two, the first two threads
+     must terminate and the counter must still account for two waiters.*/
+  test_set_step(2);
+  {
+    chSemSignalN(&sem1, 2);
+    test_assert_sequence("AB", "invalid sequence");
+    test_assert_lock(chSemGetCounterI(&sem1) == -2, "invalid counter");
+  }
+
+  /* [5.7.3] The semaphore is signaled by two again, the remaining
+     threads must terminate and the counter must return to zero.*/
+  test_set_step(3);
+  {
+    chSemSignalN(&sem1, 2);
+    test_wait_threads();
+    test_assert_sequence("CD", "invalid sequence");
+    test_assert_lock(chSemGetCounterI(&sem1) == 0, "invalid counter");
+  }
+}
+
+static const testcase_t rt_test_005_007 = {
+  "Testing chSemSignalN() functionality",
+  rt_test_005_007_setup,
+  NULL,
+  rt_test_005_007_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -502,6 +566,7 @@ const testcase_t * const rt_test_sequence_005_array[] = {
   &rt_test_005_004,
   &rt_test_005_005,
   &rt_test_005_006,
+  &rt_test_005_007,
   NULL
 };
 
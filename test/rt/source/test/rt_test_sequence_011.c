@@ -0,0 +1,262 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "rt_test_root.h"
+
+/**
+ * @file    rt_test_sequence_011.c
+ * @brief   Test Sequence 011 code.
+ *
+ * @page rt_test_sequence_011 [11] Virtual Timers
+ *
+ * File: @ref rt_test_sequence_011.c
+ *
+ * <h2>Description</h2>
+ * This module implements the test sequence for the virtual timers
+ * re-arm functionality.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage rt_test_011_001
+ * - @subpage rt_test_011_002
+ * - @subpage rt_test_011_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "ch.h"
+
+static virtual_timer_t vt1, vt2;
+static volatile unsigned fired;
+static volatile systime_t fired_time;
+
+static void vt_cb(void *p) {
+
+  (void)p;
+  fired++;
+  fired_time = chVTGetSystemTimeX();
+}
+
+static void vt_cb_token(void *p) {
+
+  test_emit_token_i(*(char *)p);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page rt_test_011_001 [11.1] Re-arming an armed timer
+ *
+ * <h2>Description</h2>
+ * A timer is armed with a long delay then immediately re-armed with a
+ * shorter one, the test expects a single callback invocation at the
+ * re-armed deadline.
+ *
+ * <h2>Test Steps</h2>
+ * - [11.1.1] Arming the timer with a 100mS delay, the timer must
+ *   result armed.
+ * - [11.1.2] Re-arming the timer with a 20mS delay then waiting 50mS,
+ *   the callback must have fired exactly once within the expected time
+ *   window and the timer must result disarmed.
+ * .
+ */
+
+static void rt_test_011_001_setup(void) {
+  chVTObjectInit(&vt1);
+  fired = 0;
+}
+
+static void rt_test_011_001_teardown(void) {
+  chVTReset(&vt1);
+}
+
+static void rt_test_011_001_execute(void) {
+  systime_t time;
+
+  /* [11.1.1] Arming the timer with a 100mS delay, the timer must
+     result armed.*/
+  test_set_step(1);
+  {
+    chVTSet(&vt1, TIME_MS2I(100), vt_cb, NULL);
+    test_assert(chVTIsArmed(&vt1) == true, "timer not armed");
+  }
+
+  /* [11.1.2] Re-arming the timer with a 20mS delay then waiting 50mS,
+     the callback must have fired exactly once within the expected time
+     window and the timer must result disarmed.*/
+  test_set_step(2);
+  {
+    time = chVTGetSystemTime();
+    chVTRearm(&vt1, TIME_MS2I(20));
+    chThdSleepMilliseconds(50);
+    test_assert(fired == 1, "invalid number of callbacks");
+    test_assert(chVTIsArmed(&vt1) == false, "timer still armed");
+    test_assert_time_window(chTimeAddX(time, TIME_MS2I(20)),
+                            chTimeAddX(time, TIME_MS2I(20) + ALLOWED_DELAY),
+                            "callback out of time window");
+  }
+}
+
+static const testcase_t rt_test_011_001 = {
+  "Re-arming an armed timer",
+  rt_test_011_001_setup,
+  rt_test_011_001_teardown,
+  rt_test_011_001_execute
+};
+
+/**
+ * @page rt_test_011_002 [11.2] Repeatedly re-arming a lone timer
+ *
+ * <h2>Description</h2>
+ * The retransmit pattern is simulated, a single armed timer is
+ * repeatedly re-armed before expiration. The test expects a single
+ * callback invocation relative to the last re-arm operation. This
+ * case exercises the tickless path where the timer being re-armed is
+ * the only one keeping the alarm active.
+ *
+ * <h2>Test Steps</h2>
+ * - [11.2.1] Arming the timer with a 20mS delay then re-arming it five
+ *   times at 5mS intervals.
+ * - [11.2.2] Waiting 50mS, the callback must have fired exactly once
+ *   within the time window relative to the last re-arm.
+ * .
+ */
+
+static void rt_test_011_002_setup(void) {
+  chVTObjectInit(&vt1);
+  fired = 0;
+}
+
+static void rt_test_011_002_teardown(void) {
+  chVTReset(&vt1);
+}
+
+static void rt_test_011_002_execute(void) {
+  systime_t time;
+  unsigned i;
+
+  /* [11.2.1] Arming the timer with a 20mS delay then re-arming it five
+     times at 5mS intervals.*/
+  test_set_step(1);
+  {
+    time = chVTGetSystemTime();
+    chVTSet(&vt1, TIME_MS2I(20), vt_cb, NULL);
+    for (i = 0; i < 5; i++) {
+      chThdSleepMilliseconds(5);
+      time = chVTGetSystemTime();
+      chVTRearm(&vt1, TIME_MS2I(20));
+    }
+  }
+
+  /* [11.2.2] Waiting 50mS, the callback must have fired exactly once
+     within the time window relative to the last re-arm.*/
+  test_set_step(2);
+  {
+    chThdSleepMilliseconds(50);
+    test_assert(fired == 1, "invalid number of callbacks");
+    test_assert_time_window(chTimeAddX(time, TIME_MS2I(20)),
+                            chTimeAddX(time, TIME_MS2I(20) + ALLOWED_DELAY),
+                            "callback out of time window");
+  }
+}
+
+static const testcase_t rt_test_011_002 = {
+  "Repeatedly re-arming a lone timer",
+  rt_test_011_002_setup,
+  rt_test_011_002_teardown,
+  rt_test_011_002_execute
+};
+
+/**
+ * @page rt_test_011_003 [11.3] Re-arming with other timers armed
+ *
+ * <h2>Description</h2>
+ * A timer is re-armed to a deadline closer than another already armed
+ * timer, the test expects both callbacks to fire in deadline order.
+ *
+ * <h2>Test Steps</h2>
+ * - [11.3.1] Arming a second timer with a 60mS delay and the first
+ *   timer with a 100mS delay.
+ * - [11.3.2] Re-arming the first timer with a 20mS delay then waiting
+ *   100mS, the callbacks must fire in "AB" order.
+ * .
+ */
+
+static void rt_test_011_003_setup(void) {
+  chVTObjectInit(&vt1);
+  chVTObjectInit(&vt2);
+}
+
+static void rt_test_011_003_teardown(void) {
+  chVTReset(&vt1);
+  chVTReset(&vt2);
+}
+
+static void rt_test_011_003_execute(void) {
+
+  /* [11.3.1] Arming a second timer with a 60mS delay and the first
+     timer with a 100mS delay.*/
+  test_set_step(1);
+  {
+    chVTSet(&vt2, TIME_MS2I(60), vt_cb_token, "B");
+    chVTSet(&vt1, TIME_MS2I(100), vt_cb_token, "A");
+  }
+
+  /* [11.3.2] Re-arming the first timer with a 20mS delay then waiting
+     100mS, the callbacks must fire in "AB" order.*/
+  test_set_step(2);
+  {
+    chVTRearm(&vt1, TIME_MS2I(20));
+    chThdSleepMilliseconds(100);
+    test_assert_sequence("AB", "invalid callbacks order");
+    test_assert(chVTIsArmed(&vt1) == false, "timer still armed");
+    test_assert(chVTIsArmed(&vt2) == false, "timer still armed");
+  }
+}
+
+static const testcase_t rt_test_011_003 = {
+  "Re-arming with other timers armed",
+  rt_test_011_003_setup,
+  rt_test_011_003_teardown,
+  rt_test_011_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const rt_test_sequence_011_array[] = {
+  &rt_test_011_001,
+  &rt_test_011_002,
+  &rt_test_011_003,
+  NULL
+};
+
+/**
+ * @brief   Virtual Timers.
+ */
+const testsequence_t rt_test_sequence_011 = {
+  "Virtual Timers",
+  rt_test_sequence_011_array
+};
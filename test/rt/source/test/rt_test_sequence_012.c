@@ -0,0 +1,272 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "rt_test_root.h"
+
+/**
+ * @file    rt_test_sequence_012.c
+ * @brief   Test Sequence 012 code.
+ *
+ * @page rt_test_sequence_012 [12] Readers-Writer Locks
+ *
+ * File: @ref rt_test_sequence_012.c
+ *
+ * <h2>Description</h2>
+ * This module implements the test sequence for the readers-writer
+ * locks subsystem.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_RWLOCKS
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage rt_test_012_001
+ * - @subpage rt_test_012_002
+ * - @subpage rt_test_012_003
+ * .
+ */
+
+#if (CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "ch.h"
+
+static rwlock_t rw1;
+
+static THD_FUNCTION(rw_reader, p) {
+
+  chRWReadLock(&rw1);
+  test_emit_token(*(char *)p);
+  chRWReadUnlock(&rw1);
+}
+
+static THD_FUNCTION(rw_writer, p) {
+
+  chRWWriteLock(&rw1);
+  test_emit_token(*(char *)p);
+  chRWWriteUnlock(&rw1);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page rt_test_012_001 [12.1] Concurrent readers
+ *
+ * <h2>Description</h2>
+ * A reader thread acquires the lock while the testing thread already
+ * holds it for reading, the test expects the reader to not be blocked.
+ *
+ * <h2>Test Steps</h2>
+ * - [12.1.1] Acquiring the lock for reading.
+ * - [12.1.2] Starting a higher priority reader thread, it must
+ *   complete without waiting for the testing thread to release the
+ *   lock.
+ * - [12.1.3] Releasing the lock.
+ * .
+ */
+
+static void rt_test_012_001_setup(void) {
+  chRWObjectInit(&rw1);
+}
+
+static void rt_test_012_001_execute(void) {
+  tprio_t prio = chThdGetPriorityX();
+
+  /* [12.1.1] Acquiring the lock for reading.*/
+  test_set_step(1);
+  {
+    chRWReadLock(&rw1);
+    test_assert(chRWIsWriteLockedX(&rw1) == false, "write locked");
+  }
+
+  /* [12.1.2] Starting a higher priority reader thread, it must
+     complete without waiting for the testing thread to release the
+     lock.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, rw_reader, "A");
+    test_assert_sequence("A", "reader was blocked");
+  }
+
+  /* [12.1.3] Releasing the lock.*/
+  test_set_step(3);
+  {
+    chRWReadUnlock(&rw1);
+    test_wait_threads();
+  }
+}
+
+static const testcase_t rt_test_012_001 = {
+  "Concurrent readers",
+  rt_test_012_001_setup,
+  NULL,
+  rt_test_012_001_execute
+};
+
+/**
+ * @page rt_test_012_002 [12.2] Writer exclusion and precedence
+ *
+ * <h2>Description</h2>
+ * A writer thread blocks on a lock held for reading, then a reader
+ * thread with even higher priority attempts to enter. The test
+ * expects the reader to be held back while the writer is waiting and
+ * the writer to be served first when the lock is released.
+ *
+ * <h2>Test Steps</h2>
+ * - [12.2.1] Acquiring the lock for reading.
+ * - [12.2.2] Starting a writer thread, it must block.
+ * - [12.2.3] Starting a reader thread with higher priority than the
+ *   writer, it must block behind the waiting writer.
+ * - [12.2.4] Releasing the lock, the writer must be served first then
+ *   the reader, the expected token sequence is "BC".
+ * .
+ */
+
+static void rt_test_012_002_setup(void) {
+  chRWObjectInit(&rw1);
+}
+
+static void rt_test_012_002_execute(void) {
+  tprio_t prio = chThdGetPriorityX();
+
+  /* [12.2.1] Acquiring the lock for reading.*/
+  test_set_step(1);
+  {
+    chRWReadLock(&rw1);
+  }
+
+  /* [12.2.2] Starting a writer thread, it must block.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, rw_writer, "B");
+    test_assert_sequence("", "writer not blocked");
+  }
+
+  /* [12.2.3] Starting a reader thread with higher priority than the
+     writer, it must block behind the waiting writer.*/
+  test_set_step(3);
+  {
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio+2, rw_reader, "C");
+    test_assert_sequence("", "reader not blocked");
+  }
+
+  /* [12.2.4] Releasing the lock, the writer must be served first then
+     the reader, the expected token sequence is "BC".*/
+  test_set_step(4);
+  {
+    chRWReadUnlock(&rw1);
+    test_wait_threads();
+    test_assert_sequence("BC", "invalid sequence");
+  }
+}
+
+static const testcase_t rt_test_012_002 = {
+  "Writer exclusion and precedence",
+  rt_test_012_002_setup,
+  NULL,
+  rt_test_012_002_execute
+};
+
+/**
+ * @page rt_test_012_003 [12.3] Priority inheritance on a blocked writer
+ *
+ * <h2>Description</h2>
+ * A higher priority writer blocks on a lock held for reading by the
+ * testing thread, the test expects the reader to be boosted to the
+ * writer priority until the lock is released.
+ *
+ * <h2>Test Steps</h2>
+ * - [12.3.1] Acquiring the lock for reading and reading the initial
+ *   priority.
+ * - [12.3.2] Starting a writer thread with higher priority, after it
+ *   blocks the testing thread priority must result boosted.
+ * - [12.3.3] Releasing the lock, the priority must return to the
+ *   initial value.
+ * .
+ */
+
+static void rt_test_012_003_setup(void) {
+  chRWObjectInit(&rw1);
+}
+
+static void rt_test_012_003_execute(void) {
+  tprio_t prio = chThdGetPriorityX();
+
+  /* [12.3.1] Acquiring the lock for reading and reading the initial
+     priority.*/
+  test_set_step(1);
+  {
+    chRWReadLock(&rw1);
+    test_assert(chThdGetPriorityX() == prio, "initial priority wrong");
+  }
+
+  /* [12.3.2] Starting a writer thread with higher priority, after it
+     blocks the testing thread priority must result boosted.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, rw_writer, "B");
+    test_assert(chThdGetPriorityX() == prio+1, "priority not boosted");
+  }
+
+  /* [12.3.3] Releasing the lock, the priority must return to the
+     initial value.*/
+  test_set_step(3);
+  {
+    chRWReadUnlock(&rw1);
+    test_wait_threads();
+    test_assert(chThdGetPriorityX() == prio, "priority not restored");
+    test_assert_sequence("B", "writer did not run");
+  }
+}
+
+static const testcase_t rt_test_012_003 = {
+  "Priority inheritance on a blocked writer",
+  rt_test_012_003_setup,
+  NULL,
+  rt_test_012_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const rt_test_sequence_012_array[] = {
+  &rt_test_012_001,
+  &rt_test_012_002,
+  &rt_test_012_003,
+  NULL
+};
+
+/**
+ * @brief   Readers-Writer Locks.
+ */
+const testsequence_t rt_test_sequence_012 = {
+  "Readers-Writer Locks",
+  rt_test_sequence_012_array
+};
+
+#endif /* CH_CFG_USE_RWLOCKS */
@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "rt_test_root.h"
+
+/**
+ * @file    rt_test_sequence_013.c
+ * @brief   Test Sequence 013 code.
+ *
+ * @page rt_test_sequence_013 [13] EDF Scheduling
+ *
+ * File: @ref rt_test_sequence_013.c
+ *
+ * <h2>Description</h2>
+ * This module implements the test sequence for the Earliest Deadline
+ * First scheduling band.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_EDF
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage rt_test_013_001
+ * - @subpage rt_test_013_002
+ * .
+ */
+
+#if (CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "ch.h"
+
+#if CH_CFG_USE_SEMAPHORES
+static semaphore_t sem1;
+
+static THD_FUNCTION(edf_thread, p) {
+  struct edf_param {
+    sysinterval_t deadline;
+    char token;
+  } *ep = p;
+
+  chThdSetDeadline(ep->deadline);
+  chSemWait(&sem1);
+  test_emit_token(ep->token);
+  chThdSetDeadline(TIME_INFINITE);
+}
+#endif
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page rt_test_013_001 [13.1] Entering and leaving the deadline band
+ *
+ * <h2>Description</h2>
+ * The testing thread declares a deadline then leaves the band, the
+ * test expects the thread priority to be placed at the band level and
+ * then restored.
+ *
+ * <h2>Test Steps</h2>
+ * - [13.1.1] Declaring a deadline, the effective priority must become
+ *   EDFPRIO.
+ * - [13.1.2] Leaving the band, the initial priority must be restored.
+ * .
+ */
+
+static void rt_test_013_001_execute(void) {
+  tprio_t prio = chThdGetPriorityX();
+
+  /* [13.1.1] Declaring a deadline, the effective priority must become
+     EDFPRIO.*/
+  test_set_step(1);
+  {
+    chThdSetDeadline(TIME_MS2I(100));
+    test_assert(chThdGetPriorityX() == EDFPRIO, "not in the band");
+  }
+
+  /* [13.1.2] Leaving the band, the initial priority must be restored.*/
+  test_set_step(2);
+  {
+    chThdSetDeadline(TIME_INFINITE);
+    test_assert(chThdGetPriorityX() == prio, "priority not restored");
+  }
+}
+
+static const testcase_t rt_test_013_001 = {
+  "Entering and leaving the deadline band",
+  NULL,
+  NULL,
+  rt_test_013_001_execute
+};
+
+#if (CH_CFG_USE_SEMAPHORES) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_013_002 [13.2] Earliest deadline served first
+ *
+ * <h2>Description</h2>
+ * Two threads enter the band with different deadlines and block on a
+ * semaphore, both are then made ready within a single critical zone.
+ * The test expects the thread with the earliest absolute deadline to
+ * run first regardless of the release order.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_SEMAPHORES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [13.2.1] Starting a thread with a far deadline then a thread with
+ *   a near deadline, both block on the semaphore inside the band.
+ * - [13.2.2] Releasing both threads with chSemSignalN(), the expected
+ *   token sequence is "BA", earliest deadline first.
+ * .
+ */
+
+static void rt_test_013_002_setup(void) {
+  chSemObjectInit(&sem1, 0);
+}
+
+static void rt_test_013_002_execute(void) {
+  static struct {
+    sysinterval_t deadline;
+    char token;
+  } p1, p2;
+  tprio_t prio = chThdGetPriorityX();
+
+  /* [13.2.1] Starting a thread with a far deadline then a thread with
+     a near deadline, both block on the semaphore inside the band.*/
+  test_set_step(1);
+  {
+    p1.deadline = TIME_MS2I(500);
+    p1.token    = 'A';
+    p2.deadline = TIME_MS2I(100);
+    p2.token    = 'B';
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio-1, edf_thread, &p1);
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio-2, edf_thread, &p2);
+    chThdSleepMilliseconds(10);
+  }
+
+  /* [13.2.2] Releasing both threads with chSemSignalN(), the expected
+     token sequence is "BA", earliest deadline first.*/
+  test_set_step(2);
+  {
+    chSemSignalN(&sem1, 2);
+    test_wait_threads();
+    test_assert_sequence("BA", "invalid deadline order");
+  }
+}
+
+static const testcase_t rt_test_013_002 = {
+  "Earliest deadline served first",
+  rt_test_013_002_setup,
+  NULL,
+  rt_test_013_002_execute
+};
+#endif /* CH_CFG_USE_SEMAPHORES */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const rt_test_sequence_013_array[] = {
+  &rt_test_013_001,
+#if (CH_CFG_USE_SEMAPHORES) || defined(__DOXYGEN__)
+  &rt_test_013_002,
+#endif
+  NULL
+};
+
+/**
+ * @brief   EDF Scheduling.
+ */
+const testsequence_t rt_test_sequence_013 = {
+  "EDF Scheduling",
+  rt_test_sequence_013_array
+};
+
+#endif /* CH_CFG_USE_EDF */
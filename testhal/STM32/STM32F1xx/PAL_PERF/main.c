@@ -0,0 +1,171 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+
+/*
+ * Pads driven by the benchmark: one LED line plus a narrow bus, both
+ * are reprogrammed as push-pull outputs, adjust for the target board.
+ */
+#define PERF_PORT               GPIOC
+#define PERF_PAD                12U
+#define PERF_BUS_PORT           GPIOC
+#define PERF_BUS_MASK           0x0FU
+#define PERF_BUS_OFFSET         6U
+
+#define PERF_LINE               PAL_LINE(PERF_PORT, PERF_PAD)
+
+/*
+ * Iterations per measured operation, must be a multiple of the unroll
+ * factor used in the measurement macro.
+ */
+#define PERF_ITERATIONS         1024U
+
+#define cls(chp)  chprintf(chp, "\033[2J\033[1;1H")
+
+static BaseSequentialStream *chp = (BaseSequentialStream *)&SD2;
+
+/*
+ * Bus descriptor used by the bus access measurements, non-const because
+ * the checked palWriteBus() path takes a non-const pointer.
+ */
+static IOBus bus = {PERF_BUS_PORT, PERF_BUS_MASK, PERF_BUS_OFFSET};
+
+/*
+ * Cycles consumed by the measurement loop itself, subtracted from every
+ * measurement.
+ */
+static rtcnt_t overhead;
+
+/*
+ * Prints one result line, cycles per operation with two decimals.
+ */
+static void report(const char *name, rtcnt_t t) {
+  uint32_t centicycles;
+
+  if (t > overhead)
+    t -= overhead;
+  else
+    t = 0;
+  centicycles = (uint32_t)(((uint64_t)t * 100U) / PERF_ITERATIONS);
+  chprintf(chp, "  %-28s: %3u.%02u cycles\r\n", name,
+           centicycles / 100U, centicycles % 100U);
+}
+
+/*
+ * Measures PERF_ITERATIONS repetitions of op under system lock, eight
+ * repetitions per loop iteration so the loop bookkeeping is amortized
+ * and subtracted through the calibrated overhead.
+ */
+#define MEASURE(name, op) {                                                 \
+  rtcnt_t t;                                                                \
+  unsigned i;                                                               \
+  chSysLock();                                                              \
+  t = chSysGetRealtimeCounterX();                                           \
+  for (i = 0; i < PERF_ITERATIONS / 8U; i++) {                              \
+    op; op; op; op; op; op; op; op;                                         \
+  }                                                                         \
+  t = chSysGetRealtimeCounterX() - t;                                       \
+  chSysUnlock();                                                            \
+  report(name, t);                                                          \
+}
+
+/*
+ * Same loop with a volatile dummy store as body, its cost is recorded
+ * as overhead. The volatile access keeps the calibration loop alive at
+ * any optimization level and its single store is representative of the
+ * loop body floor.
+ */
+static volatile uint32_t dummy;
+
+static void calibrate(void) {
+  rtcnt_t t;
+  unsigned i;
+
+  chSysLock();
+  t = chSysGetRealtimeCounterX();
+  for (i = 0; i < PERF_ITERATIONS / 8U; i++) {
+    dummy = 0; dummy = 0; dummy = 0; dummy = 0;
+    dummy = 0; dummy = 0; dummy = 0; dummy = 0;
+  }
+  t = chSysGetRealtimeCounterX() - t;
+  chSysUnlock();
+  overhead = t;
+}
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  /*
+   * Activates the serial driver 2 using the driver default configuration.
+   */
+  sdStart(&SD2, NULL);
+
+  /*
+   * Benchmark pads setup.
+   */
+  palSetLineMode(PERF_LINE, PAL_MODE_OUTPUT_PUSHPULL);
+  palSetGroupMode(PERF_BUS_PORT, PERF_BUS_MASK, PERF_BUS_OFFSET,
+                  PAL_MODE_OUTPUT_PUSHPULL);
+
+  cls(chp);
+  chprintf(chp, "\r\n*** ChibiOS/HAL PAL performance test\r\n");
+  chprintf(chp, "*** Core clock: %u Hz\r\n", (uint32_t)STM32_SYSCLK);
+  chprintf(chp, "*** Iterations per operation: %u\r\n\r\n",
+           (unsigned)PERF_ITERATIONS);
+
+  calibrate();
+  chprintf(chp, "  (loop overhead: %u cycles, subtracted)\r\n\r\n",
+           (uint32_t)overhead);
+
+  MEASURE("palSetPad()", palSetPad(PERF_PORT, PERF_PAD));
+  MEASURE("palClearPad()", palClearPad(PERF_PORT, PERF_PAD));
+  MEASURE("palTogglePad()", palTogglePad(PERF_PORT, PERF_PAD));
+  MEASURE("palSetLine()", palSetLine(PERF_LINE));
+  MEASURE("palClearLine()", palClearLine(PERF_LINE));
+  MEASURE("palToggleLine()", palToggleLine(PERF_LINE));
+  MEASURE("palReadPad()", (void)palReadPad(PERF_PORT, PERF_PAD));
+  MEASURE("palReadLine()", (void)palReadLine(PERF_LINE));
+  MEASURE("palWritePort()",
+          palWritePort(PERF_BUS_PORT, 0x05U << PERF_BUS_OFFSET));
+  MEASURE("palWriteGroup()",
+          palWriteGroup(PERF_BUS_PORT, PERF_BUS_MASK,
+                        PERF_BUS_OFFSET, 0x05U));
+  MEASURE("palWriteBus()", palWriteBus(&bus, 0x05U));
+  MEASURE("palWriteBusX()", palWriteBusX(&bus, 0x05U));
+  MEASURE("palReadBusX()", (void)palReadBusX(&bus));
+
+  chprintf(chp, "\r\nDone.\r\n");
+
+  while (true) {
+    chThdSleepMilliseconds(500);
+  }
+  return 0;
+}
@@ -0,0 +1,322 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+
+/*
+ * Number of frames used for the latency measurement.
+ */
+#define LATENCY_FRAMES          500
+
+/*
+ * Duration of the sustained rate measurement.
+ */
+#define RATE_TEST_SECONDS       5
+
+/*
+ * Size of the software TX queue and of the bursts used to exercise it.
+ */
+#define TX_QUEUE_SLOTS          16
+#define TX_BURSTS               100
+
+/*
+ * Frames per burst, larger than the hardware mailboxes plus the software
+ * queue so the queue-full path is exercised too.
+ */
+#define BURST_FRAMES            (TX_QUEUE_SLOTS + 8)
+
+#define cls(chp)  chprintf(chp, "\033[2J\033[1;1H")
+
+static BaseSequentialStream *chp = (BaseSequentialStream *)&SD2;
+
+/*
+ * Internal loopback mode, 500KBaud, automatic wakeup, automatic recover
+ * from abort mode.
+ * See section 22.7.7 on the STM32 reference manual.
+ */
+static const CANConfig cancfg = {
+  CAN_MCR_ABOM | CAN_MCR_AWUM | CAN_MCR_TXFP,
+  CAN_BTR_LBKM | CAN_BTR_SJW(0) | CAN_BTR_TS2(1) |
+  CAN_BTR_TS1(8) | CAN_BTR_BRP(6)
+};
+
+/*
+ * Software TX queue storage.
+ */
+static can_tx_slot_t tx_slots[TX_QUEUE_SLOTS];
+
+/*
+ * ISR-to-canReceive() latency measurement, the measurement is started in
+ * the RX callback (ISR context) and stopped by the receiver thread after
+ * canReceive() returns. Only one measurement is in flight at any time.
+ */
+static time_measurement_t tm_latency;
+static ucnt_t tm_latency_hist[CH_TM_HISTOGRAM_BUCKETS];
+static volatile bool tm_latency_busy;
+
+/*
+ * Received frames counter for the sustained rate measurement.
+ */
+static volatile uint32_t rx_frames;
+
+/*
+ * Observed software TX queue depths.
+ */
+static uint32_t txq_max_depth;
+static uint32_t txq_rejected;
+
+/*
+ * RX callback, invoked in ISR context when a receive mailbox becomes
+ * non-empty.
+ */
+static void rxfull_cb(CANDriver *canp, uint32_t flags) {
+
+  (void)canp;
+  (void)flags;
+
+  if (!tm_latency_busy) {
+    tm_latency_busy = true;
+    chTMStartMeasurementX(&tm_latency);
+  }
+}
+
+/*
+ * Returns the current depth of the software TX queue.
+ */
+static uint32_t txq_depth(CANDriver *canp) {
+  uint32_t n = 0;
+  can_tx_slot_t *ctsp;
+
+  chSysLock();
+  ctsp = canp->txhead;
+  while (ctsp != NULL) {
+    n++;
+    ctsp = ctsp->next;
+  }
+  chSysUnlock();
+
+  return n;
+}
+
+/*
+ * Receiver thread, empties the receive mailboxes and closes the pending
+ * latency measurement.
+ */
+static THD_WORKING_AREA(can_rx_wa, 256);
+static THD_FUNCTION(can_rx, p) {
+  CANRxFrame rxmsg;
+
+  (void)p;
+  chRegSetThreadName("receiver");
+  while (true) {
+    if (canReceive(&CAND1, CAN_ANY_MAILBOX, &rxmsg, TIME_MS2I(100)) != MSG_OK)
+      continue;
+    if (tm_latency_busy) {
+      chTMStopMeasurementX(&tm_latency);
+      tm_latency_busy = false;
+    }
+    rx_frames++;
+  }
+}
+
+/*
+ * Prints the non-empty buckets of a log2 histogram, bucket i counts the
+ * measurements m so that 2^i <= m < 2^(i+1) realtime counter cycles.
+ */
+static void print_histogram(const ucnt_t hist[CH_TM_HISTOGRAM_BUCKETS]) {
+  unsigned i;
+
+  for (i = 0; i < CH_TM_HISTOGRAM_BUCKETS; i++) {
+    if (hist[i] != 0) {
+      chprintf(chp, "  [2^%-2u .. 2^%-2u): %u\r\n",
+               i, i + 1U, (uint32_t)hist[i]);
+    }
+  }
+}
+
+/*
+ * Phase 1: latency distribution, one frame every 10ms so every
+ * measurement observes an idle system plus the ISR-to-thread path.
+ */
+static void test_latency(void) {
+  CANTxFrame txmsg;
+  unsigned i;
+
+  chprintf(chp, "*** Latency: ISR to canReceive(), %u frames\r\n",
+           (unsigned)LATENCY_FRAMES);
+
+  txmsg.IDE = CAN_IDE_EXT;
+  txmsg.EID = 0x01234567;
+  txmsg.RTR = CAN_RTR_DATA;
+  txmsg.DLC = 8;
+  txmsg.data32[0] = 0x55AA55AA;
+  txmsg.data32[1] = 0x00FF00FF;
+
+  for (i = 0; i < LATENCY_FRAMES; i++) {
+    canTransmit(&CAND1, CAN_ANY_MAILBOX, &txmsg, TIME_MS2I(100));
+    chThdSleepMilliseconds(10);
+  }
+
+  chprintf(chp, "  samples : %u\r\n", (uint32_t)tm_latency.n);
+  chprintf(chp, "  best    : %u cycles\r\n", (uint32_t)tm_latency.best);
+  chprintf(chp, "  worst   : %u cycles\r\n", (uint32_t)tm_latency.worst);
+  chprintf(chp, "  average : %u cycles\r\n",
+           (uint32_t)(tm_latency.cumulative / (rttime_t)tm_latency.n));
+  chprintf(chp, "  (%u cycles per microsecond)\r\n",
+           (uint32_t)(STM32_SYSCLK / 1000000U));
+  print_histogram(tm_latency_hist);
+}
+
+/*
+ * Phase 2: maximum sustainable frame rate, frames are pumped back to back
+ * for a fixed time, the receiver counts what actually got through the
+ * loopback.
+ */
+static void test_rate(void) {
+  CANTxFrame txmsg;
+  systime_t start, end;
+  uint32_t sent = 0;
+
+  chprintf(chp, "*** Sustained rate: %u seconds of back to back frames\r\n",
+           (unsigned)RATE_TEST_SECONDS);
+
+  txmsg.IDE = CAN_IDE_EXT;
+  txmsg.EID = 0x01234567;
+  txmsg.RTR = CAN_RTR_DATA;
+  txmsg.DLC = 8;
+
+  rx_frames = 0;
+  start = chVTGetSystemTime();
+  end = chTimeAddX(start, TIME_S2I(RATE_TEST_SECONDS));
+  while (chVTIsSystemTimeWithin(start, end)) {
+    txmsg.data32[0] = sent;
+    if (canTransmit(&CAND1, CAN_ANY_MAILBOX, &txmsg, TIME_MS2I(100)) == MSG_OK)
+      sent++;
+  }
+
+  /* Letting the receiver drain the last frames.*/
+  chThdSleepMilliseconds(100);
+
+  chprintf(chp, "  sent    : %u frames\r\n", sent);
+  chprintf(chp, "  received: %u frames\r\n", rx_frames);
+  chprintf(chp, "  rate    : %u frames/s\r\n",
+           rx_frames / (uint32_t)RATE_TEST_SECONDS);
+}
+
+/*
+ * Phase 3: software TX queue behavior, bursts larger than the hardware
+ * mailboxes are submitted atomically, the queue depth after each burst
+ * and the rejections on queue-full are recorded.
+ */
+static void test_tx_queue(void) {
+  CANTxFrame txmsg;
+  unsigned burst, i;
+
+  chprintf(chp, "*** TX queue: %u bursts of %u frames, %u slots\r\n",
+           (unsigned)TX_BURSTS, (unsigned)BURST_FRAMES,
+           (unsigned)TX_QUEUE_SLOTS);
+
+  txmsg.IDE = CAN_IDE_EXT;
+  txmsg.RTR = CAN_RTR_DATA;
+  txmsg.DLC = 8;
+
+  txq_max_depth = 0;
+  txq_rejected  = 0;
+  for (burst = 0; burst < TX_BURSTS; burst++) {
+    uint32_t depth;
+
+    /* Lower EID first so the burst also exercises the priority sorting
+       of the software queue.*/
+    chSysLock();
+    for (i = 0; i < BURST_FRAMES; i++) {
+      txmsg.EID = 0x100U + (uint32_t)i;
+      txmsg.data32[0] = (burst << 16) | i;
+      if (canTryTransmitI(&CAND1, CAN_ANY_MAILBOX, &txmsg))
+        txq_rejected++;
+    }
+    chSysUnlock();
+
+    depth = txq_depth(&CAND1);
+    if (depth > txq_max_depth)
+      txq_max_depth = depth;
+
+    /* Waiting for the queue to drain before the next burst.*/
+    while (txq_depth(&CAND1) > 0)
+      chThdSleepMilliseconds(1);
+    chThdSleepMilliseconds(2);
+  }
+
+  chprintf(chp, "  max depth: %u frames\r\n", txq_max_depth);
+  chprintf(chp, "  rejected : %u frames (queue full)\r\n", txq_rejected);
+}
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  /*
+   * Activates the serial driver 2 using the driver default configuration.
+   */
+  sdStart(&SD2, NULL);
+
+  /*
+   * Activates the CAN driver 1 in loopback mode, the latency measurement
+   * is started from the RX callback.
+   */
+  chTMObjectInitHist(&tm_latency, tm_latency_hist);
+  CAND1.rxfull_cb = rxfull_cb;
+  canStart(&CAND1, &cancfg);
+  canSetTxQueue(&CAND1, tx_slots, TX_QUEUE_SLOTS);
+
+  /*
+   * Starting the receiver thread.
+   */
+  chThdCreateStatic(can_rx_wa, sizeof(can_rx_wa), NORMALPRIO + 7,
+                    can_rx, NULL);
+
+  /*
+   * Runs the measurements in sequence then stops.
+   */
+  cls(chp);
+  chprintf(chp, "\r\n*** ChibiOS/HAL CAN performance test\r\n");
+  chprintf(chp, "*** Core clock: %u Hz\r\n\r\n", (uint32_t)STM32_SYSCLK);
+
+  test_latency();
+  chprintf(chp, "\r\n");
+  test_rate();
+  chprintf(chp, "\r\n");
+  test_tx_queue();
+
+  chprintf(chp, "\r\nDone.\r\n");
+
+  while (true) {
+    chThdSleepMilliseconds(500);
+  }
+  return 0;
+}
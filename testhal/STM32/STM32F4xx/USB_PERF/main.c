@@ -0,0 +1,269 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "shell.h"
+#include "chprintf.h"
+
+#include "usbcfg.h"
+
+/*===========================================================================*/
+/* Command line related.                                                     */
+/*===========================================================================*/
+
+#define SHELL_WA_SIZE   THD_WORKING_AREA_SIZE(2048)
+
+/* Pattern buffer used by the throughput tests, one full bulk transfer
+   worth of data per write call.*/
+static uint8_t pattern[512];
+
+/*
+ * Device-to-host throughput, streams the pattern buffer until any
+ * character is received then reports the achieved rate. On the host
+ * side measure with:
+ *   dd if=/dev/ttyACMx of=/dev/null bs=512 count=100000
+ * or just let the command count for itself and press a key to stop.
+ */
+static void cmd_txperf(BaseSequentialStream *chp, int argc, char *argv[]) {
+  uint32_t n;
+  systime_t start;
+  sysinterval_t elapsed;
+
+  (void)argv;
+  if (argc > 0) {
+    chprintf(chp, "Usage: txperf\r\n");
+    return;
+  }
+
+  n = 0;
+  start = chVTGetSystemTime();
+  while (chnGetTimeout((BaseChannel *)chp, TIME_IMMEDIATE) == Q_TIMEOUT) {
+    chnWrite((BaseChannel *)chp, pattern, sizeof pattern);
+    n += sizeof pattern;
+  }
+  elapsed = chVTTimeElapsedSinceX(start);
+
+  chprintf(chp, "\r\n\nsent    : %u bytes\r\n", n);
+  chprintf(chp, "elapsed : %u ms\r\n", (uint32_t)TIME_I2MS(elapsed));
+  if (TIME_I2MS(elapsed) > 0U) {
+    chprintf(chp, "rate    : %u KB/s\r\n",
+             (uint32_t)(((uint64_t)n * 1000U) /
+                        ((uint64_t)TIME_I2MS(elapsed) * 1024U)));
+  }
+}
+
+/*
+ * Host-to-device throughput, counts incoming bytes until the stream
+ * pauses for one second then reports the achieved rate. On the host
+ * side measure with:
+ *   dd if=/dev/zero of=/dev/ttyACMx bs=512 count=100000
+ */
+static void cmd_rxperf(BaseSequentialStream *chp, int argc, char *argv[]) {
+  static uint8_t buf[512];
+  uint32_t n;
+  size_t r;
+  systime_t start, stop;
+
+  (void)argv;
+  if (argc > 0) {
+    chprintf(chp, "Usage: rxperf\r\n");
+    return;
+  }
+
+  chprintf(chp, "waiting for data...\r\n");
+  r = chnReadTimeout((BaseChannel *)chp, buf, sizeof buf, TIME_INFINITE);
+  n = (uint32_t)r;
+  start = chVTGetSystemTime();
+  stop = start;
+  while (true) {
+    r = chnReadTimeout((BaseChannel *)chp, buf, sizeof buf, TIME_S2I(1));
+    if (r == 0U) {
+      break;
+    }
+    n += (uint32_t)r;
+    stop = chVTGetSystemTime();
+  }
+
+  chprintf(chp, "\r\nreceived: %u bytes\r\n", n);
+  chprintf(chp, "elapsed : %u ms\r\n",
+           (uint32_t)TIME_I2MS(chTimeDiffX(start, stop)));
+  if (TIME_I2MS(chTimeDiffX(start, stop)) > 0U) {
+    chprintf(chp, "rate    : %u KB/s\r\n",
+             (uint32_t)(((uint64_t)n * 1000U) /
+                        ((uint64_t)TIME_I2MS(chTimeDiffX(start, stop)) *
+                         1024U)));
+  }
+}
+
+/*
+ * Round-trip latency, echoes every received byte immediately so the
+ * host can time single-byte round trips, a Ctrl-D (0x04) terminates
+ * the command. Flushing after each byte forces one short packet per
+ * byte, exposing the per-transfer driver overhead.
+ */
+static void cmd_echo(BaseSequentialStream *chp, int argc, char *argv[]) {
+  msg_t b;
+
+  (void)argv;
+  if (argc > 0) {
+    chprintf(chp, "Usage: echo\r\n");
+    return;
+  }
+
+  chprintf(chp, "echoing, Ctrl-D to stop\r\n");
+  while (true) {
+    b = chnGetTimeout((BaseChannel *)chp, TIME_INFINITE);
+    if ((b < MSG_OK) || (b == 0x04)) {
+      break;
+    }
+    chnPutTimeout((BaseChannel *)chp, (uint8_t)b, TIME_INFINITE);
+    obqFlush(&((SerialUSBDriver *)chp)->obqueue);
+  }
+  chprintf(chp, "\r\nstopped\r\n");
+}
+
+static const ShellCommand commands[] = {
+  {"txperf", cmd_txperf},
+  {"rxperf", cmd_rxperf},
+  {"echo", cmd_echo},
+  {NULL, NULL}
+};
+
+static const ShellConfig shell_cfg1 = {
+  (BaseSequentialStream *)&SDU1,
+  commands
+};
+
+static const ShellConfig shell_cfg2 = {
+  (BaseSequentialStream *)&SDU2,
+  commands
+};
+
+/*===========================================================================*/
+/* Generic code.                                                             */
+/*===========================================================================*/
+
+/*
+ * Red LED blinker thread, times are in milliseconds.
+ */
+static THD_WORKING_AREA(waThread1, 128);
+static THD_FUNCTION(Thread1, arg) {
+
+  (void)arg;
+  chRegSetThreadName("blinker");
+  while (true) {
+    systime_t time = serusbcfg1.usbp->state == USB_ACTIVE ? 250 : 500;
+    palClearLine(LINE_LED);
+    chThdSleepMilliseconds(time);
+    palSetLine(LINE_LED);
+    chThdSleepMilliseconds(time);
+  }
+}
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+  thread_t *shelltp1 = NULL;
+  thread_t *shelltp2 = NULL;
+  event_listener_t shell_el;
+  unsigned i;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  /*
+   * Pattern buffer initialization.
+   */
+  for (i = 0; i < sizeof pattern; i++) {
+    pattern[i] = (uint8_t)i;
+  }
+
+  /*
+   * Initializes two serial-over-USB CDC drivers.
+   */
+  sduObjectInit(&SDU1);
+  sduStart(&SDU1, &serusbcfg1);
+  sduObjectInit(&SDU2);
+  sduStart(&SDU2, &serusbcfg2);
+
+  /*
+   * Activates the USB driver and then the USB bus pull-up on D+.
+   * Note, a delay is inserted in order to not have to disconnect the cable
+   * after a reset.
+   */
+  usbDisconnectBus(serusbcfg1.usbp);
+  chThdSleepMilliseconds(1500);
+  usbStart(serusbcfg1.usbp, &usbcfg);
+  usbConnectBus(serusbcfg1.usbp);
+
+  /*
+   * Shell manager initialization.
+   * Event zero is shell exit.
+   */
+  shellInit();
+  chEvtRegister(&shell_terminated, &shell_el, 0);
+
+  /*
+   * Creates the blinker thread.
+   */
+  chThdCreateStatic(waThread1, sizeof(waThread1), NORMALPRIO, Thread1, NULL);
+
+  /*
+   * Normal main() thread activity, managing two shells.
+   */
+  while (true) {
+    if (SDU1.config->usbp->state == USB_ACTIVE) {
+      /* Starting shells.*/
+      if (shelltp1 == NULL) {
+        shelltp1 = chThdCreateFromHeap(NULL, SHELL_WA_SIZE,
+                                       "shell1", NORMALPRIO + 1,
+                                       shellThread, (void *)&shell_cfg1);
+      }
+      if (shelltp2 == NULL) {
+        shelltp2 = chThdCreateFromHeap(NULL, SHELL_WA_SIZE,
+                                       "shell2", NORMALPRIO + 1,
+                                       shellThread, (void *)&shell_cfg2);
+      }
+
+      /* Waiting for an exit event then freeing terminated shells.*/
+      chEvtWaitAny(EVENT_MASK(0));
+      if (chThdTerminatedX(shelltp1)) {
+        chThdRelease(shelltp1);
+        shelltp1 = NULL;
+      }
+      if (chThdTerminatedX(shelltp2)) {
+        chThdRelease(shelltp2);
+        shelltp2 = NULL;
+      }
+    }
+    else {
+      chThdSleepMilliseconds(1000);
+    }
+  }
+}
@@ -0,0 +1,383 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    latency.c
+ * @brief   Interrupt latency measurement test code.
+ *
+ * @addtogroup LATENCY
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+
+#include "chprintf.h"
+#include "latency.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+#define LAT_MODE_IDLE                   0
+#define LAT_MODE_ONESHOT                1
+#define LAT_MODE_PERIODIC               2
+
+#define LAT_LOAD_IDLE                   0
+#define LAT_LOAD_CPU                    1
+#define LAT_LOAD_KERNEL                 2
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*
+ * Accumulator for min/avg/max statistics, units are timer ticks.
+ */
+typedef struct {
+  gptcnt_t              min;
+  gptcnt_t              max;
+  uint32_t              sum;
+  uint32_t              n;
+} lat_stats_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static const latency_config_t *config;
+
+/* Current ISR serving mode.*/
+static volatile unsigned lat_mode;
+
+/* Reference of the measuring thread waiting for the one-shot ISR.*/
+static thread_reference_t lat_waiter;
+
+/* Time base value sampled before programming the one-shot timer.*/
+static volatile gptcnt_t oneshot_start;
+
+/* Entry latency of the last one-shot interrupt.*/
+static volatile gptcnt_t oneshot_entry;
+
+/* Time base value sampled inside the last one-shot ISR.*/
+static volatile gptcnt_t oneshot_isr_time;
+
+/* Periodic mode bookkeeping.*/
+static volatile gptcnt_t periodic_last;
+static volatile gptcnt_t periodic_worst;
+static volatile bool periodic_armed;
+
+/*
+ * Load threads working areas and handles.
+ */
+static THD_WORKING_AREA(lat_load_wa[2], LATENCY_CFG_STACK_SIZE);
+static thread_t *lat_load_threads[2];
+
+/*
+ * Mailboxes for the kernel load mix.
+ */
+static mailbox_t lat_mb[2];
+static msg_t lat_mb_buf[2][2];
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void lat_stats_reset(lat_stats_t *sp) {
+
+  sp->min = (gptcnt_t)-1;
+  sp->max = 0;
+  sp->sum = 0;
+  sp->n   = 0;
+}
+
+static void lat_stats_update(lat_stats_t *sp, gptcnt_t x) {
+
+  if (x < sp->min)
+    sp->min = x;
+  if (x > sp->max)
+    sp->max = x;
+  sp->sum += (uint32_t)x;
+  sp->n++;
+}
+
+/*
+ * Prints one statistics line, values are printed in timer ticks and the
+ * worst case also in nanoseconds derived from the timer frequency.
+ */
+static void lat_stats_print(const char *name, const lat_stats_t *sp) {
+  uint32_t ns;
+
+  ns = (uint32_t)(((uint64_t)sp->max * 1000000000ULL) /
+                  (uint64_t)config->gptcfg1p->frequency);
+  chprintf(config->out, "%s min/avg/max %u/%u/%u ticks (max %u nS)\r\n",
+           name, (unsigned)sp->min,
+           (unsigned)(sp->sum / sp->n), (unsigned)sp->max,
+           (unsigned)ns);
+}
+
+/*
+ * CPU load thread, it burns cycles inside critical sections so the
+ * stimulus interrupt finds the system masked with a known duty cycle.
+ */
+static THD_FUNCTION(lat_cpu_load_thread, arg) {
+  static volatile unsigned x = 0;
+  unsigned r;
+
+  (void)arg;
+
+  chRegSetThreadName("lat_cpu_load");
+
+  while (chThdShouldTerminateX() == false) {
+    chSysLock();
+    r = LATENCY_CFG_CS_LOOPS;
+    while (r--)
+      x++;
+    chSysUnlock();
+    x++;
+  }
+}
+
+/*
+ * Kernel load threads, a pair ping-pongs messages through mailboxes
+ * generating a continuous stream of context switches and kernel locks.
+ */
+static THD_FUNCTION(lat_kernel_load_thread, arg) {
+  unsigned me = (unsigned)arg;
+  msg_t msg;
+
+  chRegSetThreadName("lat_kernel_load");
+
+  while (chThdShouldTerminateX() == false) {
+    (void) chMBPostTimeout(&lat_mb[me ^ 1U], (msg_t)me, TIME_MS2I(10));
+    (void) chMBFetchTimeout(&lat_mb[me], &msg, TIME_MS2I(10));
+  }
+}
+
+/*
+ * Starts the load threads for the specified mix.
+ */
+static void lat_load_start(unsigned load) {
+  unsigned i;
+
+  switch (load) {
+  case LAT_LOAD_CPU:
+    lat_load_threads[0] = chThdCreateStatic(lat_load_wa[0],
+                                            sizeof lat_load_wa[0],
+                                            LATENCY_CFG_LOAD_PRIORITY,
+                                            lat_cpu_load_thread, NULL);
+    break;
+  case LAT_LOAD_KERNEL:
+    for (i = 0; i < 2; i++) {
+      chMBObjectInit(&lat_mb[i], lat_mb_buf[i], 2);
+      lat_load_threads[i] = chThdCreateStatic(lat_load_wa[i],
+                                              sizeof lat_load_wa[i],
+                                              LATENCY_CFG_LOAD_PRIORITY,
+                                              lat_kernel_load_thread,
+                                              (void *)i);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/*
+ * Stops and reclaims the load threads.
+ */
+static void lat_load_stop(void) {
+  unsigned i;
+
+  for (i = 0; i < 2; i++) {
+    if (lat_load_threads[i] != NULL) {
+      chThdTerminate(lat_load_threads[i]);
+      chThdWait(lat_load_threads[i]);
+      lat_load_threads[i] = NULL;
+    }
+  }
+}
+
+/*
+ * Runs all the measurements for one load mix and prints the report.
+ */
+static void lat_measure(const char *name) {
+  lat_stats_t entry_stats, wakeup_stats;
+  unsigned i;
+
+  chprintf(config->out, "Load mix: %s\r\n", name);
+
+  /* One-shot samples, each one provides the ISR entry latency and the
+     ISR to thread wakeup time.*/
+  lat_stats_reset(&entry_stats);
+  lat_stats_reset(&wakeup_stats);
+  lat_mode = LAT_MODE_ONESHOT;
+  for (i = 0; i < LATENCY_CFG_ITERATIONS; i++) {
+    gptcnt_t wakeup_time;
+
+    chSysLock();
+    oneshot_start = gptGetCounterX(config->gpt2p);
+    gptStartOneShotI(config->gpt1p, (gptcnt_t)LATENCY_CFG_ONESHOT_DELAY);
+    (void) chThdSuspendS(&lat_waiter);
+    wakeup_time = gptGetCounterX(config->gpt2p);
+    chSysUnlock();
+
+    lat_stats_update(&entry_stats, oneshot_entry);
+    lat_stats_update(&wakeup_stats,
+                     (gptcnt_t)(wakeup_time - oneshot_isr_time));
+  }
+
+  /* Periodic stimulus, the ISR measures the distance between successive
+     interrupts, the worst observed excess over the nominal interval is
+     the longest time the interrupt has been kept waiting by masked
+     sections and higher priority activity.*/
+  chSysLock();
+  periodic_armed = false;
+  periodic_worst = 0;
+  lat_mode = LAT_MODE_PERIODIC;
+  gptStartContinuousI(config->gpt1p,
+                      (gptcnt_t)LATENCY_CFG_PERIODIC_INTERVAL);
+  chSysUnlock();
+  chThdSleepMilliseconds(LATENCY_CFG_WINDOW_MS);
+  chSysLock();
+  gptStopTimerI(config->gpt1p);
+  lat_mode = LAT_MODE_IDLE;
+  chSysUnlock();
+
+  lat_stats_print("ISR entry latency  :", &entry_stats);
+  lat_stats_print("Thread wakeup time :", &wakeup_stats);
+  chprintf(config->out, "Worst masked delay : %u ticks (%u nS)\r\n\r\n",
+           (unsigned)periodic_worst,
+           (unsigned)(((uint64_t)periodic_worst * 1000000000ULL) /
+                      (uint64_t)config->gptcfg1p->frequency));
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Stimulus GPT callback.
+ */
+void latency_gpt1_cb(GPTDriver *gptp) {
+  gptcnt_t now;
+
+  (void)gptp;
+
+  chSysLockFromISR();
+  now = gptGetCounterX(config->gpt2p);
+  switch (lat_mode) {
+  case LAT_MODE_ONESHOT:
+    oneshot_isr_time = now;
+    oneshot_entry = (gptcnt_t)((gptcnt_t)(now - oneshot_start) -
+                               (gptcnt_t)LATENCY_CFG_ONESHOT_DELAY);
+    chThdResumeI(&lat_waiter, MSG_OK);
+    break;
+  case LAT_MODE_PERIODIC:
+    if (periodic_armed) {
+      gptcnt_t delta = (gptcnt_t)(now - periodic_last);
+
+      if (delta > (gptcnt_t)LATENCY_CFG_PERIODIC_INTERVAL) {
+        delta = (gptcnt_t)(delta - (gptcnt_t)LATENCY_CFG_PERIODIC_INTERVAL);
+        if (delta > periodic_worst)
+          periodic_worst = delta;
+      }
+    }
+    periodic_last = now;
+    periodic_armed = true;
+    break;
+  default:
+    break;
+  }
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Time base GPT callback.
+ * @note    The time base timer is free running and only read, the
+ *          callback is never expected to matter but GPT configurations
+ *          require one.
+ */
+void latency_gpt2_cb(GPTDriver *gptp) {
+
+  (void)gptp;
+}
+
+/**
+ * @brief   Latency measurement execution.
+ *
+ * @param[in] cfg       pointer to the test configuration structure
+ *
+ * @api
+ */
+void latency_execute(const latency_config_t *cfg) {
+
+  /* Global configuration pointer.*/
+  config = cfg;
+
+  /* Starting timers, the time base is left free running on its full
+     counter range.*/
+  gptStart(cfg->gpt1p, cfg->gptcfg1p);
+  gptStart(cfg->gpt2p, cfg->gptcfg2p);
+  gptStartContinuous(cfg->gpt2p, (gptcnt_t)-1);
+
+  /* Printing environment information.*/
+  chprintf(cfg->out, "");
+  chprintf(cfg->out, "\r\n*** ChibiOS/RT IRQ latency measurement test\r\n***\r\n");
+  chprintf(cfg->out, "*** Kernel:       %s\r\n", CH_KERNEL_VERSION);
+  chprintf(cfg->out, "*** Compiled:     %s\r\n", __DATE__ " - " __TIME__);
+#ifdef PORT_COMPILER_NAME
+  chprintf(cfg->out, "*** Compiler:     %s\r\n", PORT_COMPILER_NAME);
+#endif
+  chprintf(cfg->out, "*** Architecture: %s\r\n", PORT_ARCHITECTURE_NAME);
+#ifdef PORT_CORE_VARIANT_NAME
+  chprintf(cfg->out, "*** Core Variant: %s\r\n", PORT_CORE_VARIANT_NAME);
+#endif
+  chprintf(cfg->out, "*** System Clock: %d\r\n", cfg->sysclk);
+#ifdef PORT_INFO
+  chprintf(cfg->out, "*** Port Info:    %s\r\n", PORT_INFO);
+#endif
+#ifdef PLATFORM_NAME
+  chprintf(cfg->out, "*** Platform:     %s\r\n", PLATFORM_NAME);
+#endif
+#ifdef BOARD_NAME
+  chprintf(cfg->out, "*** Test Board:   %s\r\n", BOARD_NAME);
+#endif
+  chprintf(cfg->out, "***\r\n");
+  chprintf(cfg->out, "*** Iterations:   %d\r\n", LATENCY_CFG_ITERATIONS);
+  chprintf(cfg->out, "*** Timer Freq:   %d\r\n", cfg->gptcfg1p->frequency);
+  chprintf(cfg->out, "*** Interval:     %d ticks\r\n",
+           LATENCY_CFG_PERIODIC_INTERVAL);
+  chprintf(cfg->out, "*** Window:       %d mS\r\n\r\n", LATENCY_CFG_WINDOW_MS);
+
+  /* Measurements under each load mix.*/
+  lat_measure("idle");
+  lat_load_start(LAT_LOAD_CPU);
+  lat_measure("cpu");
+  lat_load_stop();
+  lat_load_start(LAT_LOAD_KERNEL);
+  lat_measure("kernel");
+  lat_load_stop();
+
+  gptStopTimer(cfg->gpt2p);
+
+  chprintf(cfg->out, "Test Complete\r\n");
+}
+
+/** @} */
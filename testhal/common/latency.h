@@ -0,0 +1,162 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    latency.h
+ * @brief   Interrupt latency measurement test header.
+ * @details Portable companion of the IRQ Storm stress test, it is driven
+ *          by the same pair of GPT units and characterizes, under
+ *          selectable load mixes, the ISR entry latency, the ISR to
+ *          thread wakeup time and the worst case delay suffered by a
+ *          periodic interrupt. Targets only have to provide the
+ *          configuration structure and a main calling
+ *          @p latency_execute(), see the IRQ_STORM applications for the
+ *          wiring.
+ *
+ * @addtogroup LATENCY
+ * @{
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Number of one-shot latency samples per load mix.
+ */
+#if !defined(LATENCY_CFG_ITERATIONS) || defined(__DOXYGEN__)
+#define LATENCY_CFG_ITERATIONS              1000
+#endif
+
+/**
+ * @brief   Programmed one-shot delay in timer ticks.
+ */
+#if !defined(LATENCY_CFG_ONESHOT_DELAY) || defined(__DOXYGEN__)
+#define LATENCY_CFG_ONESHOT_DELAY           100
+#endif
+
+/**
+ * @brief   Periodic stimulus interval in timer ticks.
+ */
+#if !defined(LATENCY_CFG_PERIODIC_INTERVAL) || defined(__DOXYGEN__)
+#define LATENCY_CFG_PERIODIC_INTERVAL       500
+#endif
+
+/**
+ * @brief   Duration of the periodic observation window in milliseconds.
+ */
+#if !defined(LATENCY_CFG_WINDOW_MS) || defined(__DOXYGEN__)
+#define LATENCY_CFG_WINDOW_MS               1000
+#endif
+
+/**
+ * @brief   Priority of the background load threads.
+ */
+#if !defined(LATENCY_CFG_LOAD_PRIORITY) || defined(__DOXYGEN__)
+#define LATENCY_CFG_LOAD_PRIORITY           (tprio_t)(NORMALPRIO-20)
+#endif
+
+/**
+ * @brief   Busy loops executed inside a critical section by the CPU
+ *          load thread, it determines the length of the contended
+ *          masked windows.
+ */
+#if !defined(LATENCY_CFG_CS_LOOPS) || defined(__DOXYGEN__)
+#define LATENCY_CFG_CS_LOOPS                64
+#endif
+
+/**
+ * @brief   Stack size for the load threads.
+ */
+#if !defined(LATENCY_CFG_STACK_SIZE) || defined(__DOXYGEN__)
+#define LATENCY_CFG_STACK_SIZE              128
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+typedef struct {
+  /**
+   * @brief   Stream for output.
+   */
+  BaseSequentialStream  *out;
+  /**
+   * @brief   Stimulus GPT driver, its configuration must point to
+   *          @p latency_gpt1_cb().
+   */
+  GPTDriver             *gpt1p;
+  /**
+   * @brief   Time base GPT driver, its configuration must point to
+   *          @p latency_gpt2_cb(). It is kept free running and only
+   *          read, both timers must run at the same frequency.
+   */
+  GPTDriver             *gpt2p;
+  /**
+   * @brief   GPT1 configuration.
+   */
+  const GPTConfig       *gptcfg1p;
+  /**
+   * @brief   GPT2 configuration.
+   */
+  const GPTConfig       *gptcfg2p;
+  /**
+   * @brief   System clock.
+   */
+  uint32_t              sysclk;
+} latency_config_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void latency_gpt1_cb(GPTDriver *gptp);
+  void latency_gpt2_cb(GPTDriver *gptp);
+  void latency_execute(const latency_config_t *cfg);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* LATENCY_H */
+
+/** @} */
@@ -0,0 +1,124 @@
+#!/usr/bin/env python
+# ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compares benchmark scores extracted from two captured test reports.
+
+The benchmark sequences of the test suites emit, next to each human
+readable score, a machine readable record line:
+
+    #CSV,<name>,<value>,<unit>
+
+This tool extracts those records from two captured test outputs (for
+instance serial logs of two firmware releases running on the same
+board) and prints a comparison table, flagging the measures that
+regressed beyond a threshold. Units ending in "/S" are rates where
+higher is better, all other units (ticks, x100, ...) are costs where
+lower is better.
+
+Usage:
+    benchdiff.py [-t percent] reference.log candidate.log
+
+The exit code is non-zero if at least one regression beyond the
+threshold is detected, so the tool can gate automated release jobs.
+"""
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+
+def load_scores(path):
+    """Returns an ordered list of (name, value, unit) from a report."""
+    scores = []
+    with open(path, "r") as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("#CSV,"):
+                continue
+            fields = line.split(",")
+            if len(fields) != 4:
+                print("warning: malformed record in %s: %s" % (path, line),
+                      file=sys.stderr)
+                continue
+            try:
+                scores.append((fields[1], int(fields[2]), fields[3]))
+            except ValueError:
+                print("warning: non numeric value in %s: %s" % (path, line),
+                      file=sys.stderr)
+    return scores
+
+
+def higher_is_better(unit):
+    return unit.endswith("/S")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="diff benchmark scores of two captured test reports")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="regression threshold in percent (default 5)")
+    parser.add_argument("reference", help="reference run report")
+    parser.add_argument("candidate", help="candidate run report")
+    args = parser.parse_args()
+
+    ref = load_scores(args.reference)
+    cand = {name: (value, unit) for name, value, unit in
+            load_scores(args.candidate)}
+
+    if not ref:
+        print("error: no benchmark records in %s" % args.reference,
+              file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print("%-36s %12s %12s %8s" % ("benchmark", "reference", "candidate",
+                                   "delta%"))
+    for name, ref_value, unit in ref:
+        if name not in cand:
+            print("%-36s %12d %12s" % (name, ref_value, "missing"))
+            regressions += 1
+            continue
+        cand_value, cand_unit = cand.pop(name)
+        if cand_unit != unit:
+            print("%-36s unit mismatch: %s vs %s" % (name, unit, cand_unit))
+            regressions += 1
+            continue
+        if ref_value != 0:
+            delta = 100.0 * (cand_value - ref_value) / ref_value
+        else:
+            delta = 0.0
+        if higher_is_better(unit):
+            regressed = delta < -args.threshold
+        else:
+            regressed = delta > args.threshold
+        flag = "  REGRESSION" if regressed else ""
+        print("%-36s %12d %12d %+7.1f%%%s" % (name, ref_value, cand_value,
+                                              delta, flag))
+        if regressed:
+            regressions += 1
+
+    for name in cand:
+        print("%-36s %12s %12d" % (name, "new", cand[name][0]))
+
+    if regressions > 0:
+        print("\n%d regression(s) beyond %.1f%% threshold" %
+              (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())